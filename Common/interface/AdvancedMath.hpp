@@ -629,6 +629,95 @@ inline BoxVisibility GetBoxVisibility(const ViewFrustumExt&      ViewFrustumExt,
     return BoxVisibility::Intersecting;
 }
 
+
+/// Axis-aligned bounding boxes stored in structure-of-arrays layout.
+
+/// Each member points to an array with one element per box.
+struct BoundBoxesSoA
+{
+    const float* MinX = nullptr;
+    const float* MinY = nullptr;
+    const float* MinZ = nullptr;
+    const float* MaxX = nullptr;
+    const float* MaxY = nullptr;
+    const float* MaxZ = nullptr;
+};
+
+/// Oriented bounding boxes stored in structure-of-arrays layout.
+
+/// Each pointer references an array with one element per box.
+/// AxisX[i], AxisY[i] and AxisZ[i] are the components of the i-th box axis
+/// (see OrientedBoundingBox::Axes), and HalfExtents[i] is the half extent along this axis.
+struct OrientedBoundingBoxesSoA
+{
+    const float* CenterX = nullptr;
+    const float* CenterY = nullptr;
+    const float* CenterZ = nullptr;
+
+    const float* AxisX[3] = {};
+    const float* AxisY[3] = {};
+    const float* AxisZ[3] = {};
+
+    const float* HalfExtents[3] = {};
+};
+
+/// Tests the visibility of multiple bounding boxes against the view frustum.
+
+/// \param[in]  Frustum      - View frustum.
+/// \param[in]  Boxes        - Bounding boxes in structure-of-arrays layout.
+/// \param[in]  NumBoxes     - The number of boxes.
+/// \param[out] pVisibility  - An optional array of NumBoxes elements that receives the visibility of each box.
+/// \param[out] pVisibleMask - An optional array of (NumBoxes + 31) / 32 elements that receives the visibility bit mask.
+///                            Bit i is set if box i is not BoxVisibility::Invisible.
+/// \param[in]  PlaneFlags   - Frustum planes to test the boxes against.
+///
+/// The boxes are processed with SSE, AVX2 or NEON instructions when available.
+/// The results are the same as the results of GetBoxVisibility() called for each box.
+void GetBoxesVisibility(const ViewFrustum&   Frustum,
+                        const BoundBoxesSoA& Boxes,
+                        size_t               NumBoxes,
+                        BoxVisibility*       pVisibility,
+                        Uint32*              pVisibleMask,
+                        FRUSTUM_PLANE_FLAGS  PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM);
+
+/// Tests the visibility of multiple oriented bounding boxes against the view frustum.
+
+/// See GetBoxesVisibility() for axis-aligned boxes for the description of the parameters.
+void GetBoxesVisibility(const ViewFrustum&              Frustum,
+                        const OrientedBoundingBoxesSoA& Boxes,
+                        size_t                          NumBoxes,
+                        BoxVisibility*                  pVisibility,
+                        Uint32*                         pVisibleMask,
+                        FRUSTUM_PLANE_FLAGS             PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM);
+
+struct IThreadPool;
+
+/// Tests the visibility of multiple bounding boxes using the thread pool.
+
+/// The boxes are split into ranges of at least MinBoxesPerTask boxes that are processed
+/// by the thread pool tasks and the calling thread. The function returns when all boxes
+/// have been processed. If the number of boxes is too small or pThreadPool is null,
+/// the boxes are processed in the calling thread.
+///
+/// Splitting the work only pays off for very large arrays (hundreds of thousands of boxes).
+void GetBoxesVisibilityParallel(IThreadPool*         pThreadPool,
+                                const ViewFrustum&   Frustum,
+                                const BoundBoxesSoA& Boxes,
+                                size_t               NumBoxes,
+                                BoxVisibility*       pVisibility,
+                                Uint32*              pVisibleMask,
+                                FRUSTUM_PLANE_FLAGS  PlaneFlags      = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM,
+                                size_t               MinBoxesPerTask = 32768);
+
+void GetBoxesVisibilityParallel(IThreadPool*                    pThreadPool,
+                                const ViewFrustum&              Frustum,
+                                const OrientedBoundingBoxesSoA& Boxes,
+                                size_t                          NumBoxes,
+                                BoxVisibility*                  pVisibility,
+                                Uint32*                         pVisibleMask,
+                                FRUSTUM_PLANE_FLAGS             PlaneFlags      = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM,
+                                size_t                          MinBoxesPerTask = 32768);
+
 inline float GetPointToBoxDistanceSqr(const BoundBox& BB, const float3& Pos)
 {
     VERIFY_EXPR(BB.Max.x >= BB.Min.x &&
@@ -36,6 +36,8 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 
 #include "../../Primitives/interface/DefineRefMacro.h"
 
+struct IThreadPool;
+
 /// Image difference information
 struct ImageDiffInfo
 {
@@ -100,6 +102,30 @@ struct ComputeImageDifferenceAttribs
 
     /// Scale factor for the difference image
     float Scale DEFAULT_INITIALIZER(1.f);
+
+    /// The x coordinate of the top-left corner of the region to compare.
+    Uint32 RegionX DEFAULT_INITIALIZER(0);
+
+    /// The y coordinate of the top-left corner of the region to compare.
+    Uint32 RegionY DEFAULT_INITIALIZER(0);
+
+    /// The width of the region to compare.
+    /// If 0, the region extends to the right edge of the image.
+    Uint32 RegionWidth DEFAULT_INITIALIZER(0);
+
+    /// The height of the region to compare.
+    /// If 0, the region extends to the bottom edge of the image.
+    Uint32 RegionHeight DEFAULT_INITIALIZER(0);
+
+    /// An optional single-channel 8-bit mask that has the same dimensions as the images.
+    /// Pixels for which the mask value is zero are ignored.
+    const void* pMask DEFAULT_INITIALIZER(nullptr);
+
+    /// Row stride of the mask data, in bytes
+    Uint32 MaskStride DEFAULT_INITIALIZER(0);
+
+    /// An optional thread pool to process row bands in parallel.
+    struct IThreadPool* pThreadPool DEFAULT_INITIALIZER(nullptr);
 };
 typedef struct ComputeImageDifferenceAttribs ComputeImageDifferenceAttribs;
 
@@ -115,6 +141,10 @@ typedef struct ComputeImageDifferenceAttribs ComputeImageDifferenceAttribs;
 /// The root mean square difference is calculated as the square root of
 /// the average of the squares of all differences, not counting pixels that
 /// are equal.
+///
+/// Only pixels inside the region defined by RegionX, RegionY, RegionWidth and RegionHeight
+/// that are not rejected by the mask are compared. Ignored pixels are written to the
+/// difference image as if they were equal.
 void DILIGENT_GLOBAL_FUNCTION(ComputeImageDifference)(const ComputeImageDifferenceAttribs REF Attribs, ImageDiffInfo REF ImageDiff);
 
 
@@ -0,0 +1,63 @@
+/*
+ *  Copyright 2019-2025 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Compression and decompression of data blocks in the LZ4 block format
+
+#include <cstddef>
+
+namespace Diligent
+{
+
+/// Returns the maximum size of the compressed data for the source data of the given size.
+size_t LZ4CompressBound(size_t SrcSize);
+
+/// Compresses the data block using the LZ4 block format.
+
+/// \param [in]  pSrc        - Source data.
+/// \param [in]  SrcSize     - Source data size, in bytes.
+/// \param [out] pDst        - Destination buffer.
+/// \param [in]  DstCapacity - Destination buffer size, in bytes.
+///
+/// \return     The size of the compressed data, or zero if it does not fit into the destination buffer.
+///             Compression always succeeds if DstCapacity is at least LZ4CompressBound(SrcSize).
+size_t LZ4CompressBlock(const void* pSrc, size_t SrcSize, void* pDst, size_t DstCapacity);
+
+/// Decompresses the data block in the LZ4 block format.
+
+/// \param [in]  pSrc    - Compressed data.
+/// \param [in]  SrcSize - Compressed data size, in bytes.
+/// \param [out] pDst    - Destination buffer.
+/// \param [in]  DstSize - Expected decompressed data size, in bytes.
+///
+/// \return     true if the block has been decompressed successfully, and false otherwise.
+///             The function never reads or writes outside of the source and destination buffers,
+///             and fails if the block is malformed or does not decompress to exactly DstSize bytes.
+bool LZ4DecompressBlock(const void* pSrc, size_t SrcSize, void* pDst, size_t DstSize);
+
+} // namespace Diligent
@@ -19,6 +19,8 @@
 
 #include <unordered_map>
 #include <mutex>
+#include <shared_mutex>
+#include <vector>
 #include <memory>
 #include <algorithm>
 #include <atomic>
@@ -47,13 +49,15 @@ struct _StrongPtrHelper<std::shared_ptr<T>>
 };
 
 template <typename T>
-auto _LockWeakPtr(RefCntWeakPtr<T>& pWeakPtr)
+auto _LockWeakPtr(const RefCntWeakPtr<T>& pWeakPtr)
 {
-    return pWeakPtr.Lock();
+    // RefCntWeakPtr::Lock() releases the weak pointer if the object has expired.
+    // Lock a copy so that multiple threads can safely lock the same pointer.
+    return RefCntWeakPtr<T>{pWeakPtr}.Lock();
 }
 
 template <typename T>
-auto _LockWeakPtr(std::weak_ptr<T>& pWeakPtr)
+auto _LockWeakPtr(const std::weak_ptr<T>& pWeakPtr)
 {
     return pWeakPtr.lock();
 }
@@ -107,6 +111,10 @@ auto _IsWeakPtrExpired(std::weak_ptr<T>& pWeakPtr)
 ///
 /// It is guaranteed, that the Object will only be initialized once, even if multiple threads call Get() simultaneously.
 ///
+/// The registry is split into shards by the key hash. Each shard is protected by its own reader-writer lock,
+/// so that looking up an existing object only takes a shared lock on one shard. Expired entries are purged
+/// incrementally when new entries are added to the shard.
+///
 template <typename KeyType,
           typename StrongPtrType,
           typename KeyHasher = std::hash<KeyType>,
@@ -116,8 +124,16 @@ class ObjectsRegistry
 public:
     using WeakPtrType = typename _StrongPtrHelper<StrongPtrType>::WeakPtrType;
 
-    explicit ObjectsRegistry(Uint32 NumRequestsToPurge = 1024) noexcept :
-        m_NumRequestsToPurge{NumRequestsToPurge}
+    static constexpr Uint32 DefaultNumShards = 16;
+
+    /// \param [in] NumRequestsToPurge - The number of entries added to a shard over which
+    ///                                  all entries of the shard are checked for expiration.
+    ///                                  Each addition checks 1/NumRequestsToPurge of the shard's hash buckets.
+    /// \param [in] NumShards          - The number of shards.
+    explicit ObjectsRegistry(Uint32 NumRequestsToPurge = 1024,
+                             Uint32 NumShards          = DefaultNumShards) :
+        m_NumRequestsToPurge{std::max(NumRequestsToPurge, 1u)},
+        m_Shards(std::max(NumShards, 1u))
     {}
 
     /// Finds the object in the registry and returns strong pointer to it (std::shared_ptr or RefCntAutoPtr).
@@ -132,84 +148,115 @@ public:
     /// CreateObject function may throw in case of an error.
     ///
     /// It is guaranteed, that the Object will only be initialized once, even if multiple threads call Get() simultaneously.
-    /// However, if another thread runs an overloaded Get() without the initializer function with the same key, it may
-    /// remove the entry from the registry, and the object will be initialized multiple times.
-    /// This is OK as only one object will be added to the registry.
     template <typename CreateObjectType>
     StrongPtrType Get(const KeyType&     Key,
                       CreateObjectType&& CreateObject // May throw
                       ) noexcept(false)
     {
-        // Get the Object wrapper. Since this is a shared pointer, it may not be destroyed
-        // while we keep one, even if it is popped from the registry by another thread.
-        std::shared_ptr<ObjectWrapper> pObjectWrpr;
+        Shard& KeyShard = GetShard(Key);
+
+        // Fast path: the object exists and is alive
         {
-            std::lock_guard<std::mutex> Guard{m_CacheMtx};
+            SharedLock Guard{KeyShard.Mtx};
 
-            auto it = m_Cache.find(Key);
-            if (it == m_Cache.end())
+            auto it = KeyShard.Cache.find(Key);
+            if (it != KeyShard.Cache.end())
             {
-                it = m_Cache.emplace(Key, std::make_shared<ObjectWrapper>()).first;
+                if (auto pObject = it->second->Lock())
+                    return pObject;
             }
-            pObjectWrpr = it->second;
         }
 
-        StrongPtrType pObject;
-        try
-        {
-            pObject = pObjectWrpr->Get(std::forward<CreateObjectType>(CreateObject));
-        }
-        catch (...)
+        while (true)
         {
-            std::lock_guard<std::mutex> Guard{m_CacheMtx};
-
-            auto it = m_Cache.find(Key);
-            if (it != m_Cache.end())
+            // Get the Object wrapper. Since this is a shared pointer, it may not be destroyed
+            // while we keep one, even if it is popped from the registry by another thread.
+            std::shared_ptr<ObjectWrapper> pObjectWrpr;
             {
-                pObject = it->second->Lock();
-                if (pObject)
+                ExclusiveLock Guard{KeyShard.Mtx};
+
+                auto it = KeyShard.Cache.find(Key);
+                if (it == KeyShard.Cache.end())
                 {
-                    // The object was created by another thread while we were waiting for the lock
-                    return pObject;
+                    it = KeyShard.Cache.emplace(Key, std::make_shared<ObjectWrapper>()).first;
                 }
-                else
+                else if (it->second->IsExpired())
                 {
-                    m_Cache.erase(it);
+                    // Wrappers are never reinitialized, so replace the expired one
+                    it->second = std::make_shared<ObjectWrapper>();
                 }
+                pObjectWrpr = it->second;
+
+                // Note that the incremental purge never removes our entry as it has not expired
+                KeyShard.PurgeIncremental(m_NumRequestsToPurge);
             }
 
-            throw;
-        }
+            bool          ObjectCreated = false;
+            StrongPtrType pObject;
+            try
+            {
+                pObject = pObjectWrpr->Get(CreateObject, ObjectCreated);
+            }
+            catch (...)
+            {
+                ExclusiveLock Guard{KeyShard.Mtx};
 
-        {
-            std::lock_guard<std::mutex> Guard{m_CacheMtx};
+                auto it = KeyShard.Cache.find(Key);
+                if (it != KeyShard.Cache.end())
+                {
+                    if (auto pOtherObject = it->second->Lock())
+                    {
+                        // The object was created by another thread while we were waiting for the lock
+                        return pOtherObject;
+                    }
+                    else if (it->second == pObjectWrpr)
+                    {
+                        // Note that another thread may be initializing the wrapper now.
+                        // It will add it back to the registry.
+                        KeyShard.Cache.erase(it);
+                    }
+                }
+
+                throw;
+            }
+
+            if (!ObjectCreated)
+            {
+                if (pObject)
+                    return pObject;
 
-            auto it = m_Cache.find(Key);
+                // The object was initialized by another thread and has expired, or the initializer
+                // returned null. Try again with a new wrapper.
+                continue;
+            }
+
+            ExclusiveLock Guard{KeyShard.Mtx};
+
+            auto it = KeyShard.Cache.find(Key);
             if (pObject)
             {
-                if (it == m_Cache.end())
+                if (it == KeyShard.Cache.end())
                 {
-                    // The wrapper was removed from the cache by another thread while we were waiting
-                    // for the lock - add it back.
-                    m_Cache.emplace(Key, pObjectWrpr);
+                    // The wrapper was removed from the registry by another thread while we were
+                    // creating the object - add it back.
+                    KeyShard.Cache.emplace(Key, pObjectWrpr);
                 }
-            }
-            else
-            {
-                if (it != m_Cache.end())
+                else if (it->second != pObjectWrpr)
                 {
-                    pObject = it->second->Lock();
-                    // Note that the object may have been created by another thread while we were waiting for the lock
-                    if (!pObject)
-                        m_Cache.erase(it);
+                    // Another thread added a new wrapper. If it already holds an object, return
+                    // it to make sure that all threads get the same object.
+                    if (auto pOtherObject = it->second->Lock())
+                        return pOtherObject;
+                    it->second = pObjectWrpr;
                 }
             }
+            else if (it != KeyShard.Cache.end() && it->second == pObjectWrpr)
+            {
+                KeyShard.Cache.erase(it);
+            }
 
-            if (m_NumRequestsSinceLastPurge.fetch_add(1) + 1 >= m_NumRequestsToPurge)
-                PurgeUnguarded();
+            return pObject;
         }
-
-        return pObject;
     }
 
     /// Finds the object in the registry and returns a strong pointer to it (std::shared_ptr or RefCntAutoPtr).
@@ -221,45 +268,58 @@ public:
     /// or empty pointer otherwise.
     StrongPtrType Get(const KeyType& Key)
     {
-        std::lock_guard<std::mutex> Guard{m_CacheMtx};
+        Shard& KeyShard = GetShard(Key);
+
+        {
+            SharedLock Guard{KeyShard.Mtx};
 
-        if (m_NumRequestsSinceLastPurge.fetch_add(1) + 1 >= m_NumRequestsToPurge)
-            PurgeUnguarded();
+            auto it = KeyShard.Cache.find(Key);
+            if (it == KeyShard.Cache.end())
+                return {};
+
+            if (auto pObject = it->second->Lock())
+                return pObject;
+
+            // Do not remove the entry if the object is being created by another thread
+            if (!it->second->IsExpired())
+                return {};
+        }
 
-        auto it = m_Cache.find(Key);
-        if (it != m_Cache.end())
         {
-            auto pObject = it->second->Lock();
-            if (!pObject)
-            {
-                // Note that we may remove the entry from the cache while another thread is creating the object.
-                // This is OK as it will be added back to the cache.
-                m_Cache.erase(it);
-            }
+            ExclusiveLock Guard{KeyShard.Mtx};
 
-            return pObject;
+            auto it = KeyShard.Cache.find(Key);
+            if (it != KeyShard.Cache.end() && it->second->IsExpired())
+                KeyShard.Cache.erase(it);
         }
 
         return {};
     }
 
-    /// Removes all expired pointers from the cache
+    /// Removes all expired pointers from the cache.
+    /// Shards are processed one at a time, so that the registry remains accessible.
     void Purge()
     {
-        std::lock_guard<std::mutex> Guard{m_CacheMtx};
-        PurgeUnguarded();
+        for (Shard& S : m_Shards)
+        {
+            ExclusiveLock Guard{S.Mtx};
+            S.Purge();
+        }
     }
 
     /// Processes each element in the cache with the specified handler.
     template <typename HandlerType>
     void ProcessElements(HandlerType&& Handler)
     {
-        std::lock_guard<std::mutex> Guard{m_CacheMtx};
-        for (auto& Entry : m_Cache)
+        for (Shard& S : m_Shards)
         {
-            if (auto pObject = Entry.second->Lock())
+            SharedLock Guard{S.Mtx};
+            for (auto& Entry : S.Cache)
             {
-                Handler(Entry.first, *pObject);
+                if (auto pObject = Entry.second->Lock())
+                {
+                    Handler(Entry.first, *pObject);
+                }
             }
         }
     }
@@ -267,72 +327,121 @@ public:
     /// Removes all objects from the cache.
     void Clear()
     {
-        std::lock_guard<std::mutex> Guard{m_CacheMtx};
-        m_Cache.clear();
-        m_NumRequestsSinceLastPurge.store(0);
+        for (Shard& S : m_Shards)
+        {
+            ExclusiveLock Guard{S.Mtx};
+            S.Cache.clear();
+            S.PurgeBucket = 0;
+        }
     }
 
 private:
     class ObjectWrapper
     {
     public:
-        template <typename CreateObjectType>
-        const StrongPtrType Get(CreateObjectType&& CreateObject) noexcept(false)
+        // Returns the object if the wrapper has been initialized and the object is alive.
+        StrongPtrType Lock()
         {
-            StrongPtrType pObject;
-
-            std::lock_guard<std::mutex> Guard{m_CreateObjectMtx};
-            pObject = _LockWeakPtr(m_wpObject);
-            if (!pObject)
-            {
-                pObject    = CreateObject(); // May throw
-                m_wpObject = pObject;
-            }
-
-            return pObject;
+            // m_wpObject is never modified after the wrapper has been initialized
+            return m_IsInitialized.load(std::memory_order_acquire) ? _LockWeakPtr(m_wpObject) : StrongPtrType{};
         }
 
-        StrongPtrType Lock()
+        // Returns true if the wrapper has been initialized and the object has expired.
+        // Expired wrappers are never reinitialized.
+        bool IsExpired()
         {
-            return _LockWeakPtr(m_wpObject);
+            return m_IsInitialized.load(std::memory_order_acquire) && _IsWeakPtrExpired(m_wpObject);
         }
 
-        bool IsExpired()
+        template <typename CreateObjectType>
+        StrongPtrType Get(CreateObjectType&& CreateObject, bool& ObjectCreated) noexcept(false)
         {
-            return _IsWeakPtrExpired(m_wpObject);
+            std::lock_guard<std::mutex> Guard{m_CreateObjectMtx};
+            if (m_IsInitialized.load(std::memory_order_relaxed))
+                return _LockWeakPtr(m_wpObject);
+
+            StrongPtrType pObject = CreateObject(); // May throw
+            m_wpObject            = pObject;
+            m_IsInitialized.store(true, std::memory_order_release);
+            ObjectCreated = true;
+
+            return pObject;
         }
 
     private:
-        std::mutex  m_CreateObjectMtx;
-        WeakPtrType m_wpObject;
+        std::mutex        m_CreateObjectMtx;
+        WeakPtrType       m_wpObject;
+        std::atomic<bool> m_IsInitialized{false};
     };
 
-    void PurgeUnguarded()
+    using CacheType     = std::unordered_map<KeyType, std::shared_ptr<ObjectWrapper>, KeyHasher, KeyEqual>;
+    using SharedLock    = std::shared_lock<std::shared_timed_mutex>;
+    using ExclusiveLock = std::lock_guard<std::shared_timed_mutex>;
+
+    struct Shard
     {
-        for (auto it = m_Cache.begin(); it != m_Cache.end();)
+        std::shared_timed_mutex Mtx;
+        CacheType               Cache;
+
+        // The next hash bucket to check for expired entries
+        size_t PurgeBucket = 0;
+
+        // Removes all expired entries. The lock must be held exclusively.
+        void Purge()
         {
-            if (it->second->IsExpired())
+            for (auto it = Cache.begin(); it != Cache.end();)
             {
-                it = m_Cache.erase(it);
+                if (it->second->IsExpired())
+                {
+                    it = Cache.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
             }
-            else
+        }
+
+        // Removes expired entries from the next 1/NumRequestsToPurge of the hash buckets.
+        // The lock must be held exclusively.
+        void PurgeIncremental(Uint32 NumRequestsToPurge)
+        {
+            const size_t BucketCount = Cache.bucket_count();
+            for (size_t NumBuckets = (BucketCount + NumRequestsToPurge - 1) / NumRequestsToPurge; NumBuckets > 0; --NumBuckets)
             {
-                ++it;
+                // The bucket count changes when the map is rehashed
+                const size_t Bucket = PurgeBucket++ % BucketCount;
+                for (auto it = Cache.begin(Bucket); it != Cache.end(Bucket);)
+                {
+                    if (it->second->IsExpired())
+                    {
+                        // Local iterators can't be used to erase elements. Erasing does not
+                        // rehash the map, so restart from the beginning of the same bucket.
+                        Cache.erase(Cache.find(it->first));
+                        it = Cache.begin(Bucket);
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
             }
+            PurgeBucket %= BucketCount;
         }
+    };
 
-        m_NumRequestsSinceLastPurge.store(0);
+    Shard& GetShard(const KeyType& Key)
+    {
+        // Mix the hash bits so that the shard index is not correlated with the bucket
+        // index in the shard's hash map.
+        const Uint64 Hash = static_cast<Uint64>(KeyHasher{}(Key)) * Uint64{0x9E3779B97F4A7C15};
+        return m_Shards[static_cast<size_t>(Hash >> 32) % m_Shards.size()];
     }
 
 private:
-    using CacheType = std::unordered_map<KeyType, std::shared_ptr<ObjectWrapper>, KeyHasher, KeyEqual>;
-
     const Uint32 m_NumRequestsToPurge;
 
-    std::atomic<Uint32> m_NumRequestsSinceLastPurge{0};
-
-    std::mutex m_CacheMtx;
-    CacheType  m_Cache;
+    std::vector<Shard> m_Shards;
 };
 
 } // namespace Diligent
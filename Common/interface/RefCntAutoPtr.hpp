@@ -420,17 +420,12 @@ public:
         RefCntAutoPtr<T> spObj;
         if (m_pRefCounters)
         {
-            // Try to obtain a pointer to the owner object.
-            // spOwner is only used to keep the object
-            // alive while obtaining strong reference from
-            // the raw pointer m_pObject
-            RefCntAutoPtr<IObject> spOwner;
-            m_pRefCounters->QueryObject(&spOwner);
-            if (spOwner)
+            // The object shares the reference counters with its owner, so the strong
+            // reference acquired from the counters keeps both alive and can be
+            // attached to the raw pointer m_pObject.
+            if (m_pRefCounters->TryAddStrongRef())
             {
-                // If owner is alive, we can use our RAW pointer to
-                // create strong reference
-                spObj = m_pObject;
+                spObj.Attach(m_pObject);
             }
             else
             {
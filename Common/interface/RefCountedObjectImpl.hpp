@@ -44,6 +44,19 @@ namespace Diligent
 
 // This class controls the lifetime of a refcounted object
 // NB: RefCountersImpl can't be final, see https://github.com/DiligentGraphics/DiligentCore/issues/704.
+//
+// The reference counters do not use locks:
+// - Once the strong reference counter has dropped to zero, it is never incremented again:
+//   weak-to-strong promotion (QueryObject(), TryAddStrongRef()) only increments the counter
+//   if it is not zero using a compare-and-swap loop. The thread that decrements the counter
+//   to zero is thus the only thread that may ever destroy the object.
+// - All strong references collectively hold one extra weak reference that is released
+//   after the object has been destroyed. The reference counters object is destroyed by
+//   the thread that releases the last weak reference, so it stays alive while the object
+//   is being destroyed, even if the object's destructor releases weak references to itself:
+//
+//      A ==sp==> B ---wp---> A
+//
 class RefCountersImpl : public IReferenceCounters
 {
 public:
@@ -60,13 +73,14 @@ public:
         VERIFY(m_ObjectState.load() == ObjectState::Alive, "Attempting to decrement strong reference counter for an object that is not alive");
         VERIFY(m_ObjectWrapperBuffer[0] != 0 && m_ObjectWrapperBuffer[1] != 0, "Object wrapper is not initialized");
 
-        // Decrement strong reference counter without acquiring the lock.
         const ReferenceCounterValueType RefCount = m_NumStrongReferences.fetch_add(-1) - 1;
         VERIFY(RefCount >= 0, "Inconsistent call to ReleaseStrongRef()");
         if (RefCount == 0)
         {
+            // The counter is never incremented from zero, so no other thread can
+            // obtain a reference to the object or get to this point.
             PreObjectDestroy();
-            TryDestroyObject();
+            DestroyObject();
         }
 
         return RefCount;
@@ -79,131 +93,73 @@ public:
 
     inline virtual ReferenceCounterValueType AddWeakRef() override final
     {
-        return m_NumWeakReferences.fetch_add(+1) + 1;
+        return GetWeakRefCount(m_NumWeakReferences.fetch_add(+1) + 1);
     }
 
     inline virtual ReferenceCounterValueType ReleaseWeakRef() override final
     {
-        // The method must be serialized!
-        std::unique_lock<Threading::SpinLock> Guard{m_Lock};
+        // The object state must be read before decrementing the counter: once the counter
+        // is decremented, another thread may destroy the reference counters object.
+        const bool ObjectDestroyed = m_ObjectState.load() == ObjectState::Destroyed;
 
-        // It is essentially important to check the number of weak references
-        // while holding the lock. Otherwise reference counters object
-        // may be destroyed twice if ReleaseStrongRef() is executed by other
-        // thread.
         const ReferenceCounterValueType NumWeakReferences = m_NumWeakReferences.fetch_add(-1) - 1;
         VERIFY(NumWeakReferences >= 0, "Inconsistent call to ReleaseWeakRef()");
-
-        // There are two special case when we must not destroy the ref counters object even
-        // when NumWeakReferences == 0 && m_NumStrongReferences == 0 :
-        //
-        //             This thread             |    Another thread - ReleaseStrongRef()
-        //                                     |
-        // 1. Lock the object                  |
-        //                                     |
-        // 2. Decrement m_NumWeakReferences,   |   1. Decrement m_NumStrongReferences,
-        //    m_NumWeakReferences==0           |      RefCount == 0
-        //                                     |
-        //                                     |   2. Start waiting for the lock to destroy
-        //                                     |      the object, m_ObjectState != ObjectState::Destroyed
-        // 3. Do not destroy reference         |
-        //    counters, unlock                 |
-        //                                     |   3. Acquire the lock,
-        //                                     |      destroy the object,
-        //                                     |      read m_NumWeakReferences==0
-        //                                     |      destroy the reference counters
-        //
-
-        // If an exception is thrown during the object construction and there is a weak pointer to the object itself,
-        // we may get to this point, but should not destroy the reference counters, because it will be destroyed by MakeNewRCObj
-        // Consider this example:
-        //
-        //   A ==sp==> B ---wp---> A
-        //
-        //   MakeNewRCObj::operator()
-        //    try
-        //    {
-        //     A.ctor()
-        //       B.ctor()
-        //        wp.ctor m_NumWeakReferences==1
-        //        throw
-        //        wp.dtor m_NumWeakReferences==0, destroy this
-        //    }
-        //    catch(...)
-        //    {
-        //       Destroy ref counters second time
-        //    }
-        //
-        if (NumWeakReferences == 0 && /*m_NumStrongReferences == 0 &&*/ m_ObjectState.load() == ObjectState::Destroyed)
+        if (NumWeakReferences == 0)
         {
-            VERIFY_EXPR(m_NumStrongReferences.load() == 0);
+            // The weak reference held by the strong references has been released, which
+            // only happens after the object has been destroyed. No other thread may access
+            // the reference counters object anymore.
+            VERIFY_EXPR(m_NumStrongReferences.load() == 0 && m_ObjectState.load() == ObjectState::Destroyed);
             VERIFY(m_ObjectWrapperBuffer[0] == 0 && m_ObjectWrapperBuffer[1] == 0, "Object wrapper must be null");
-            // m_ObjectState is set to ObjectState::Destroyed under the lock. If the state is not Destroyed,
-            // ReleaseStrongRef() will take care of it.
-            // Access to Object wrapper and decrementing m_NumWeakReferences is atomic. Since we acquired the lock,
-            // no other thread can access either of them.
-            // Access to m_NumStrongReferences is NOT PROTECTED by lock.
-
-            // There are no more references to the ref counters object and the object itself
-            // is already destroyed.
-            // We can safely unlock it and destroy.
-            // If we do not unlock it, this->m_LockFlag will expire,
-            // which will cause Lock.~LockHelper() to crash.
-            Guard.unlock();
             SelfDestroy();
+            return 0;
         }
-        return NumWeakReferences;
+        return ObjectDestroyed ? NumWeakReferences : NumWeakReferences - 1;
     }
 
-    inline virtual void QueryObject(struct IObject** ppObject) override final
+    /// Increments the strong reference counter if it is not zero.
+
+    /// \return     true if the counter has been incremented, and false otherwise.
+    ///
+    /// \remarks    If the method returns true, the object is alive and the caller owns
+    ///             a strong reference to it that must be released by calling Release()
+    ///             for the object or any other object that shares these reference counters.
+    inline bool TryAddStrongRef()
     {
         if (m_ObjectState.load() != ObjectState::Alive)
-            return; // Early exit
-
-        // It is essential to INCREMENT REF COUNTER while HOLDING THE LOCK to make sure that
-        // StrongRefCnt > 1 guarantees that the object is alive.
-
-        // If other thread started deleting the object in ReleaseStrongRef(), then m_NumStrongReferences==0
-        // We must make sure only one thread is allowed to increment the counter to guarantee that if StrongRefCnt > 1,
-        // there is at least one real strong reference left. Otherwise the following scenario may occur:
-        //
-        //                                      m_NumStrongReferences == 1
-        //
-        //    Thread 1 - ReleaseStrongRef()    |    Thread 2 - QueryObject()       |    Thread 3 - QueryObject()
-        //                                     |                                   |
-        //  - Decrement m_NumStrongReferences  | -Increment m_NumStrongReferences  | -Increment m_NumStrongReferences
-        //  - Read RefCount == 0               | -Read StrongRefCnt==1             | -Read StrongRefCnt==2
-        //    Destroy the object               |                                   | -Return reference to the soon
-        //                                     |                                   |  to expire object
-        //
-        Threading::SpinLockGuard Guard{m_Lock};
-
-        const ReferenceCounterValueType StrongRefCnt = m_NumStrongReferences.fetch_add(+1) + 1;
-
-        // Checking if m_ObjectState == ObjectState::Alive only is not reliable:
-        //
-        //           This thread                    |          Another thread
-        //                                          |
-        //   1. Acquire the lock                    |
-        //                                          |    1. Decrement m_NumStrongReferences
-        //   2. Increment m_NumStrongReferences     |    2. Test RefCount==0
-        //   3. Read StrongRefCnt == 1              |    3. Start destroying the object
-        //      m_ObjectState == ObjectState::Alive |
-        //   4. DO NOT return the reference to      |    4. Wait for the lock, m_ObjectState == ObjectState::Alive
-        //      the object                          |
-        //   5. Decrement m_NumStrongReferences     |
-        //                                          |    5. Destroy the object
-
-        if (m_ObjectState == ObjectState::Alive && StrongRefCnt > 1)
+            return false; // Early exit
+
+        ReferenceCounterValueType NumStrongRefs = m_NumStrongReferences.load();
+        do
         {
-            VERIFY(m_ObjectWrapperBuffer[0] != 0 && m_ObjectWrapperBuffer[1] != 0, "Object wrapper is not initialized");
-            // QueryInterface() must not lock the object, or a deadlock happens.
-            // The only other two methods that lock the object are ReleaseStrongRef()
-            // and ReleaseWeakRef(), which are never called by QueryInterface()
-            ObjectWrapperBase* pWrapper = reinterpret_cast<ObjectWrapperBase*>(m_ObjectWrapperBuffer);
-            pWrapper->QueryInterface(IID_Unknown, ppObject);
+            // Zero strong references means that the object is being destroyed
+            if (NumStrongRefs == 0)
+                return false;
+        } while (!m_NumStrongReferences.compare_exchange_weak(NumStrongRefs, NumStrongRefs + 1));
+
+        return true;
+    }
+
+    inline virtual void QueryObject(struct IObject** ppObject) override final
+    {
+        if (!TryAddStrongRef())
+            return;
+
+        // The strong reference acquired above keeps the object alive
+        VERIFY(m_ObjectWrapperBuffer[0] != 0 && m_ObjectWrapperBuffer[1] != 0, "Object wrapper is not initialized");
+        ObjectWrapperBase* pWrapper = reinterpret_cast<ObjectWrapperBase*>(m_ObjectWrapperBuffer);
+        pWrapper->QueryInterface(IID_Unknown, ppObject);
+
+        if (*ppObject != nullptr)
+        {
+            // The returned pointer holds its own strong reference, so the counter can't drop to zero here
+            m_NumStrongReferences.fetch_add(-1);
+        }
+        else
+        {
+            UNEXPECTED("Querying IID_Unknown interface is expected to always succeed");
+            ReleaseStrongRef();
         }
-        m_NumStrongReferences.fetch_add(-1);
     }
 
     inline virtual ReferenceCounterValueType GetNumStrongRefs() const override final
@@ -213,7 +169,7 @@ public:
 
     inline virtual ReferenceCounterValueType GetNumWeakRefs() const override final
     {
-        return m_NumWeakReferences.load();
+        return GetWeakRefCount(m_NumWeakReferences.load());
     }
 
 private:
@@ -273,180 +229,39 @@ private:
         m_ObjectState.store(ObjectState::Alive);
     }
 
-    void TryDestroyObject()
+    // Converts the internal weak reference counter value to the number of weak references
+    // by excluding the weak reference held by the strong references.
+    // The value may be off by one while the object is being destroyed.
+    ReferenceCounterValueType GetWeakRefCount(ReferenceCounterValueType NumWeakReferences) const
     {
-        // Since RefCount==0, there are no more strong references and the only place
-        // where strong ref counter can be incremented is from QueryObject().
-
-        // If several threads were allowed to get to this point, there would
-        // be serious risk that <this> had already been destroyed and m_LockFlag expired.
-        // Consider the following scenario:
-        //                                      |
-        //             This thread              |             Another thread
-        //                                      |
-        //                      m_NumStrongReferences == 1
-        //                      m_NumWeakReferences == 1
-        //                                      |
-        // 1. Decrement m_NumStrongReferences   |
-        //    Read RefCount==0, no lock acquired|
-        //                                      |   1. Run QueryObject()
-        //                                      |      - acquire the lock
-        //                                      |      - increment m_NumStrongReferences
-        //                                      |      - release the lock
-        //                                      |
-        //                                      |   2. Run ReleaseWeakRef()
-        //                                      |      - decrement m_NumWeakReferences
-        //                                      |
-        //                                      |   3. Run ReleaseStrongRef()
-        //                                      |      - decrement m_NumStrongReferences
-        //                                      |      - read RefCount==0
-        //
-        //         Both threads will get to this point. The first one will destroy <this>
-        //         The second one will read expired m_LockFlag
-
-        //  IT IS CRUCIALLY IMPORTANT TO ASSURE THAT ONLY ONE THREAD WILL EVER
-        //  EXECUTE THIS CODE
-
-        // The solution is to atomically increment strong ref counter in QueryObject().
-        // There are two possible scenarios depending on who first increments the counter:
-
-
-        //                                                     Scenario I
-        //
-        //             This thread              |     Another thread - QueryObject()        |  One more thread - QueryObject()
-        //                                      |                                           |
-        //                        m_NumStrongReferences == 1                                |
-        //                                      |                                           |
-        //                                      |   1. Acquire the lock                     |
-        // 1. Decrement mlNumStrongReferences   |                                           |   1. Wait for the lock
-        // 2. Read RefCount==0                  |   2. Increment m_NumStrongReferences      |
-        // 3. Start destroying the object       |   3. Read StrongRefCnt == 1               |
-        // 4. Wait for the lock                 |   4. DO NOT return the reference          |
-        //                                      |      to the object                        |
-        //                                      |   5. Decrement m_NumStrongReferences      |
-        // _  _  _  _  _  _  _  _  _  _  _  _  _|   6. Release the lock _  _  _  _  _  _  _ |_  _  _  _  _  _  _  _  _  _  _  _  _  _
-        //                                      |                                           |   2. Acquire the lock
-        //                                      |                                           |   3. Increment m_NumStrongReferences
-        //                                      |                                           |   4. Read StrongRefCnt == 1
-        //                                      |                                           |   5. DO NOT return the reference
-        //                                      |                                           |      to the object
-        //                                      |                                           |   6. Decrement m_NumStrongReferences
-        //  _  _  _  _  _  _  _  _  _  _  _  _  | _  _  _  _  _  _  _  _  _  _  _  _  _  _  | _ 7. Release the lock _  _  _  _  _  _
-        // 5. Acquire the lock                  |                                           |
-        //   - m_NumStrongReferences==0         |                                           |
-        // 6. DESTROY the object                |                                           |
-        //                                      |                                           |
-
-        //  QueryObject() MUST BE SERIALIZED for this to work properly!
-
-
-        //                                   Scenario II
-        //
-        //             This thread              |     Another thread - QueryObject()
-        //                                      |
-        //                       m_NumStrongReferences == 1
-        //                                      |
-        //                                      |   1. Acquire the lock
-        //                                      |   2. Increment m_NumStrongReferences
-        // 1. Decrement m_NumStrongReferences   |
-        // 2. Read RefCount>0                   |
-        // 3. DO NOT destroy the object         |   3. Read StrongRefCnt > 1 (while m_NumStrongReferences == 1)
-        //                                      |   4. Return the reference to the object
-        //                                      |       - Increment m_NumStrongReferences
-        //                                      |   5. Decrement m_NumStrongReferences
-
-#ifdef DILIGENT_DEBUG
-        {
-            ReferenceCounterValueType NumStrongRefs = m_NumStrongReferences.load();
-            VERIFY(NumStrongRefs == 0 || NumStrongRefs == 1, "Num strong references (", NumStrongRefs, ") is expected to be 0 or 1");
-        }
-#endif
-
-        // Acquire the lock.
-        std::unique_lock<Threading::SpinLock> Guard{m_Lock};
+        return m_ObjectState.load() != ObjectState::Destroyed ? NumWeakReferences - 1 : NumWeakReferences;
+    }
 
-        // QueryObject() first acquires the lock, and only then increments and
-        // decrements the ref counter. If it reads 1 after incrementing the counter,
-        // it does not return the reference to the object and decrements the counter.
-        // If we acquired the lock, QueryObject() will not start until we are done
+    void DestroyObject()
+    {
         VERIFY_EXPR(m_NumStrongReferences.load() == 0 && m_ObjectState.load() == ObjectState::Alive);
+        VERIFY(m_ObjectWrapperBuffer[0] != 0 && m_ObjectWrapperBuffer[1] != 0, "Object wrapper is not initialized");
 
-        // Extra caution
-        if (m_NumStrongReferences.load() == 0 && m_ObjectState.load() == ObjectState::Alive)
-        {
-            VERIFY(m_ObjectWrapperBuffer[0] != 0 && m_ObjectWrapperBuffer[1] != 0, "Object wrapper is not initialized");
-            // We cannot destroy the object while reference counters are locked as this will
-            // cause a deadlock in cases like this:
-            //
-            //    A ==sp==> B ---wp---> A
-            //
-            //    RefCounters_A.Lock();
-            //    delete A{
-            //      A.~dtor(){
-            //          B.~dtor(){
-            //              wpA.ReleaseWeakRef(){
-            //                  RefCounters_A.Lock(); // Deadlock
-            //
-
-            // So we copy the object wrapper and destroy the object after unlocking the
-            // reference counters
-            alignas(ObjectWrapper<IObjectStub, IMemoryAllocator>) size_t ObjectWrapperBufferCopy[ObjectWrapperBufferSize];
-            memcpy(ObjectWrapperBufferCopy, m_ObjectWrapperBuffer, sizeof(m_ObjectWrapperBuffer));
-            memset(m_ObjectWrapperBuffer, 0, sizeof(m_ObjectWrapperBuffer));
-
-            ObjectWrapperBase* pWrapper = reinterpret_cast<ObjectWrapperBase*>(ObjectWrapperBufferCopy);
-
-            // In a multithreaded environment, reference counters object may
-            // be destroyed at any time while m_pObject->~dtor() is running.
-            // NOTE: m_pObject may not be the only object referencing m_pRefCounters.
-            //       All objects that are owned by m_pObject will point to the same
-            //       reference counters object.
-
-            // Note that this is the only place where m_ObjectState is
-            // modified after the ref counters object has been created
-            m_ObjectState.store(ObjectState::Destroyed);
-            // The object is now detached from the reference counters, and it is if
-            // it was destroyed since no one can obtain access to it.
-
-
-            // It is essentially important to check the number of weak references
-            // while the object is locked. Otherwise reference counters object
-            // may be destroyed twice if ReleaseWeakRef() is executed by other thread:
-            //
-            //             This thread             |    Another thread - ReleaseWeakRef()
-            //                                     |
-            // 1. Decrement m_NumStrongReferences, |
-            //    m_NumStrongReferences==0,        |
-            //    acquire the lock, destroy        |
-            //    the obj, release the lock        |
-            //    m_NumWeakReferences == 1         |
-            //                                     |   1. Acquire the lock,
-            //                                     |      decrement m_NumWeakReferences,
-            //                                     |      m_NumWeakReferences == 0,
-            //                                     |      m_ObjectState == ObjectState::Destroyed
-            //                                     |
-            // 2. Read m_NumWeakReferences == 0    |
-            // 3. Destroy the ref counters obj     |   2. Destroy the ref counters obj
-            //
-            const bool bDestroyThis = m_NumWeakReferences.load() == 0;
-            // ReleaseWeakRef() decrements m_NumWeakReferences, and checks it for
-            // zero only after acquiring the lock. So if m_NumWeakReferences==0, no
-            // weak reference-related code may be running
-
-
-            // We must explicitly unlock the object now to avoid deadlocks. Also,
-            // if this is deleted, this->m_LockFlag will expire, which will cause
-            // Lock.~LockHelper() to crash
-            Guard.unlock();
-
-            // Destroy referenced object
-            pWrapper->DestroyObject();
-
-            // Note that <this> may be destroyed here already,
-            // see comments in ~ControlledObjectType()
-            if (bDestroyThis)
-                SelfDestroy();
-        }
+        // Copy the object wrapper and clear it to catch attempts to access the object while it is being destroyed
+        alignas(ObjectWrapper<IObjectStub, IMemoryAllocator>) size_t ObjectWrapperBufferCopy[ObjectWrapperBufferSize];
+        memcpy(ObjectWrapperBufferCopy, m_ObjectWrapperBuffer, sizeof(m_ObjectWrapperBuffer));
+        memset(m_ObjectWrapperBuffer, 0, sizeof(m_ObjectWrapperBuffer));
+
+        ObjectWrapperBase* pWrapper = reinterpret_cast<ObjectWrapperBase*>(ObjectWrapperBufferCopy);
+
+        // NOTE: m_pObject may not be the only object referencing the reference counters.
+        //       All objects that are owned by m_pObject point to the same reference counters object,
+        //       and may release weak references to it while m_pObject->~dtor() is running.
+        //       The weak reference held by the strong references keeps the counters alive.
+        pWrapper->DestroyObject();
+
+        // Note that this is the only place where m_ObjectState is
+        // modified after the object has been attached
+        m_ObjectState.store(ObjectState::Destroyed);
+
+        // Release the weak reference held by the strong references.
+        // This destroys the reference counters if there are no other weak references.
+        ReleaseWeakRef();
     }
 
     // Make the method virtual to ensure that the object is destroyed in the same module
@@ -458,7 +273,7 @@ private:
 
     virtual ~RefCountersImpl()
     {
-        VERIFY(m_NumStrongReferences.load() == 0 && m_NumWeakReferences.load() == 0,
+        VERIFY(m_NumStrongReferences.load() == 0 && GetWeakRefCount(m_NumWeakReferences.load()) == 0,
                "There exist outstanding references to the object being destroyed");
     }
 
@@ -482,9 +297,9 @@ private:
     alignas(ObjectWrapper<IObjectStub, IMemoryAllocator>) size_t m_ObjectWrapperBuffer[ObjectWrapperBufferSize]{};
 
     std::atomic<ReferenceCounterValueType> m_NumStrongReferences{0};
-    std::atomic<ReferenceCounterValueType> m_NumWeakReferences{0};
 
-    Threading::SpinLock m_Lock;
+    // The number of weak references plus one weak reference held by all strong references
+    std::atomic<ReferenceCounterValueType> m_NumWeakReferences{1};
 
     enum class ObjectState : Int32
     {
@@ -516,22 +331,10 @@ public:
     // through the pointer to the base class
     virtual ~RefCountedObject()
     {
-        // WARNING! m_pRefCounters may be expired in scenarios like this:
-        //
-        //    A ==sp==> B ---wp---> A
-        //
-        //    RefCounters_A.ReleaseStrongRef(){ // NumStrongRef == 0, NumWeakRef == 1
-        //      bDestroyThis = (m_NumWeakReferences == 0) == false;
-        //      delete A{
-        //        A.~dtor(){
-        //            B.~dtor(){
-        //                wpA.ReleaseWeakRef(){ // NumStrongRef == 0, NumWeakRef == 0, m_pObject==nullptr
-        //                    delete RefCounters_A;
-        //        ...
-        //        VERIFY( m_pRefCounters->GetNumStrongRefs() == 0 // Access violation!
-
-        // This also may happen if one thread is executing ReleaseStrongRef(), while
-        // another one is simultaneously running ReleaseWeakRef().
+        // The reference counters are kept alive while the object is being destroyed (see
+        // RefCountersImpl::DestroyObject()). Note however that m_pRefCounters is null for objects
+        // allocated on the stack, and that objects created with an owner share the owner's counters,
+        // so the number of strong references is not necessarily zero here.
 
         //VERIFY( m_pRefCounters->GetNumStrongRefs() == 0,
         //        "There remain strong references to the object being destroyed" );
@@ -31,9 +31,11 @@
 
 #include "ThreadPool.h"
 
+#include <algorithm>
 #include <atomic>
 #include <functional>
 #include <thread>
+#include <vector>
 
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
 
@@ -226,4 +228,59 @@ RefCntAutoPtr<IAsyncTask> EnqueueAsyncWork(IThreadPool* pThreadPool,
     return EnqueueAsyncWork(pThreadPool, nullptr, 0, std::move(Handler), fPriority);
 }
 
+/// Splits the range [0, NumItems) into chunks and processes them in parallel using the thread pool.
+
+/// \param [in] pThreadPool     - Thread pool to use. If null, the whole range is processed in the calling thread.
+/// \param [in] NumItems        - The number of items in the range.
+/// \param [in] MinItemsPerTask - The minimum number of items processed by one task.
+/// \param [in] Handler         - Function that processes items [Start, End). It is called as Handler(Start, End)
+///                               and must be safe to call concurrently for non-overlapping ranges.
+///
+/// The calling thread processes the first chunk and then either runs the tasks that have not been
+/// started by the pool yet or waits for them, so the function returns when the entire range has been processed.
+template <typename HandlerType>
+void ProcessRangeInParallel(IThreadPool* pThreadPool, Uint32 NumItems, Uint32 MinItemsPerTask, HandlerType&& Handler)
+{
+    // Limit the number of tasks to keep the scheduling overhead low
+    constexpr Uint32 MaxTasks = 64;
+
+    MinItemsPerTask       = std::max(MinItemsPerTask, 1u);
+    const Uint32 NumTasks = pThreadPool != nullptr ? std::min(NumItems / MinItemsPerTask, MaxTasks) : 0;
+    if (NumTasks <= 1)
+    {
+        Handler(0u, NumItems);
+        return;
+    }
+
+    const Uint32 ChunkSize = (NumItems + NumTasks - 1) / NumTasks;
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> Tasks;
+    Tasks.reserve(NumTasks);
+    for (Uint32 Start = ChunkSize; Start < NumItems; Start += ChunkSize)
+    {
+        const Uint32 End = std::min(Start + ChunkSize, NumItems);
+        Tasks.emplace_back(EnqueueAsyncWork(pThreadPool,
+                                            [&Handler, Start, End](Uint32 /*ThreadId*/) {
+                                                Handler(Start, End);
+                                                return ASYNC_TASK_STATUS_COMPLETE;
+                                            }));
+    }
+
+    Handler(0u, std::min(ChunkSize, NumItems));
+
+    for (size_t t = 0; t < Tasks.size(); ++t)
+    {
+        // Process the tasks that have not been started yet in this thread
+        if (pThreadPool->RemoveTask(Tasks[t]))
+        {
+            const Uint32 Start = static_cast<Uint32>(t + 1) * ChunkSize;
+            Handler(Start, std::min(Start + ChunkSize, NumItems));
+        }
+        else
+        {
+            Tasks[t]->WaitForCompletion();
+        }
+    }
+}
+
 } // namespace Diligent
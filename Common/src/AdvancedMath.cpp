@@ -0,0 +1,450 @@
+/*
+ *  Copyright 2019-2025 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "AdvancedMath.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "Intrinsics.hpp"
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+struct FrustumPlanesSoA
+{
+    explicit FrustumPlanesSoA(const ViewFrustum& _Frustum, FRUSTUM_PLANE_FLAGS _PlaneFlags) :
+        Frustum{_Frustum},
+        PlaneFlags{_PlaneFlags}
+    {
+        for (Uint32 plane_idx = 0; plane_idx < ViewFrustum::NUM_PLANES; ++plane_idx)
+        {
+            if ((PlaneFlags & (1 << plane_idx)) == 0)
+                continue;
+
+            const Plane3D& Plane = Frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(plane_idx));
+
+            Normals[NumPlanes]    = Plane.Normal;
+            AbsNormals[NumPlanes] = abs(Plane.Normal);
+            Distances[NumPlanes]  = Plane.Distance;
+            ++NumPlanes;
+        }
+    }
+
+    const ViewFrustum&        Frustum;
+    const FRUSTUM_PLANE_FLAGS PlaneFlags;
+
+    Uint32 NumPlanes = 0;
+    float3 Normals[ViewFrustum::NUM_PLANES];
+    float3 AbsNormals[ViewFrustum::NUM_PLANES];
+    float  Distances[ViewFrustum::NUM_PLANES];
+};
+
+BoxVisibility GetBoxVisibilityScalar(const FrustumPlanesSoA& Planes, const BoundBoxesSoA& Boxes, size_t i)
+{
+    BoundBox Box{
+        float3{Boxes.MinX[i], Boxes.MinY[i], Boxes.MinZ[i]},
+        float3{Boxes.MaxX[i], Boxes.MaxY[i], Boxes.MaxZ[i]},
+    };
+    return GetBoxVisibility(Planes.Frustum, Box, Planes.PlaneFlags);
+}
+
+BoxVisibility GetBoxVisibilityScalar(const FrustumPlanesSoA& Planes, const OrientedBoundingBoxesSoA& Boxes, size_t i)
+{
+    OrientedBoundingBox Box;
+    Box.Center = float3{Boxes.CenterX[i], Boxes.CenterY[i], Boxes.CenterZ[i]};
+    for (Uint32 a = 0; a < 3; ++a)
+    {
+        Box.Axes[a]        = float3{Boxes.AxisX[a][i], Boxes.AxisY[a][i], Boxes.AxisZ[a][i]};
+        Box.HalfExtents[a] = Boxes.HalfExtents[a][i];
+    }
+    return GetBoxVisibility(Planes.Frustum, Box, Planes.PlaneFlags);
+}
+
+#if DILIGENT_AVX2_ENABLED
+struct SIMDOpsAVX2
+{
+    using Vec  = __m256;
+    using Mask = __m256;
+
+    static constexpr Uint32 Width = 8;
+
+    static Vec  Load(const float* p) { return _mm256_loadu_ps(p); }
+    static Vec  Set(float f) { return _mm256_set1_ps(f); }
+    static Vec  Add(Vec a, Vec b) { return _mm256_add_ps(a, b); }
+    static Vec  Sub(Vec a, Vec b) { return _mm256_sub_ps(a, b); }
+    static Vec  Mul(Vec a, Vec b) { return _mm256_mul_ps(a, b); }
+    static Vec  Abs(Vec a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a); }
+    static Vec  Neg(Vec a) { return _mm256_xor_ps(_mm256_set1_ps(-0.f), a); }
+    static Mask Less(Vec a, Vec b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static Mask Greater(Vec a, Vec b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static Mask And(Mask a, Mask b) { return _mm256_and_ps(a, b); }
+    static Mask Or(Mask a, Mask b) { return _mm256_or_ps(a, b); }
+    static Mask False() { return _mm256_setzero_ps(); }
+    static Mask True() { return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+    static Uint32 MoveMask(Mask m) { return static_cast<Uint32>(_mm256_movemask_ps(m)); }
+};
+#endif
+
+#if DILIGENT_SSE2_SUPPORTED
+struct SIMDOpsSSE2
+{
+    using Vec  = __m128;
+    using Mask = __m128;
+
+    static constexpr Uint32 Width = 4;
+
+    static Vec  Load(const float* p) { return _mm_loadu_ps(p); }
+    static Vec  Set(float f) { return _mm_set1_ps(f); }
+    static Vec  Add(Vec a, Vec b) { return _mm_add_ps(a, b); }
+    static Vec  Sub(Vec a, Vec b) { return _mm_sub_ps(a, b); }
+    static Vec  Mul(Vec a, Vec b) { return _mm_mul_ps(a, b); }
+    static Vec  Abs(Vec a) { return _mm_andnot_ps(_mm_set1_ps(-0.f), a); }
+    static Vec  Neg(Vec a) { return _mm_xor_ps(_mm_set1_ps(-0.f), a); }
+    static Mask Less(Vec a, Vec b) { return _mm_cmplt_ps(a, b); }
+    static Mask Greater(Vec a, Vec b) { return _mm_cmpgt_ps(a, b); }
+    static Mask And(Mask a, Mask b) { return _mm_and_ps(a, b); }
+    static Mask Or(Mask a, Mask b) { return _mm_or_ps(a, b); }
+    static Mask False() { return _mm_setzero_ps(); }
+    static Mask True() { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+    static Uint32 MoveMask(Mask m) { return static_cast<Uint32>(_mm_movemask_ps(m)); }
+};
+#endif
+
+#if DILIGENT_NEON_SUPPORTED
+struct SIMDOpsNEON
+{
+    using Vec  = float32x4_t;
+    using Mask = uint32x4_t;
+
+    static constexpr Uint32 Width = 4;
+
+    static Vec  Load(const float* p) { return vld1q_f32(p); }
+    static Vec  Set(float f) { return vdupq_n_f32(f); }
+    static Vec  Add(Vec a, Vec b) { return vaddq_f32(a, b); }
+    static Vec  Sub(Vec a, Vec b) { return vsubq_f32(a, b); }
+    static Vec  Mul(Vec a, Vec b) { return vmulq_f32(a, b); }
+    static Vec  Abs(Vec a) { return vabsq_f32(a); }
+    static Vec  Neg(Vec a) { return vnegq_f32(a); }
+    static Mask Less(Vec a, Vec b) { return vcltq_f32(a, b); }
+    static Mask Greater(Vec a, Vec b) { return vcgtq_f32(a, b); }
+    static Mask And(Mask a, Mask b) { return vandq_u32(a, b); }
+    static Mask Or(Mask a, Mask b) { return vorrq_u32(a, b); }
+    static Mask False() { return vdupq_n_u32(0); }
+    static Mask True() { return vdupq_n_u32(~0u); }
+    static Uint32 MoveMask(Mask m)
+    {
+        static const uint32_t LaneBits[4] = {1, 2, 4, 8};
+
+        const uint32x4_t Bits = vandq_u32(m, vld1q_u32(LaneBits));
+        const uint32x2_t Or2  = vorr_u32(vget_low_u32(Bits), vget_high_u32(Bits));
+        return vget_lane_u32(Or2, 0) | vget_lane_u32(Or2, 1);
+    }
+};
+#endif
+
+#if DILIGENT_AVX2_ENABLED
+using SIMDOps = SIMDOpsAVX2;
+#    define SIMD_BOX_VISIBILITY_SUPPORTED 1
+#elif DILIGENT_SSE2_SUPPORTED
+using SIMDOps = SIMDOpsSSE2;
+#    define SIMD_BOX_VISIBILITY_SUPPORTED 1
+#elif DILIGENT_NEON_SUPPORTED
+using SIMDOps = SIMDOpsNEON;
+#    define SIMD_BOX_VISIBILITY_SUPPORTED 1
+#endif
+
+#if SIMD_BOX_VISIBILITY_SUPPORTED
+
+// Computes the Invisible and FullyVisible lane masks for the boxes starting at index i.
+// The operations are performed in the same order as in GetBoxVisibilityAgainstPlane()
+// so that the results match the scalar version.
+template <typename Ops>
+void GetBoxesVisibilityMasks(const FrustumPlanesSoA& Planes, const BoundBoxesSoA& Boxes, size_t i, Uint32& InvisibleBits, Uint32& FullyVisibleBits)
+{
+    using Vec  = typename Ops::Vec;
+    using Mask = typename Ops::Mask;
+
+    const Vec MinX = Ops::Load(Boxes.MinX + i);
+    const Vec MinY = Ops::Load(Boxes.MinY + i);
+    const Vec MinZ = Ops::Load(Boxes.MinZ + i);
+    const Vec MaxX = Ops::Load(Boxes.MaxX + i);
+    const Vec MaxY = Ops::Load(Boxes.MaxY + i);
+    const Vec MaxZ = Ops::Load(Boxes.MaxZ + i);
+
+    const Vec SumX  = Ops::Add(MaxX, MinX);
+    const Vec SumY  = Ops::Add(MaxY, MinY);
+    const Vec SumZ  = Ops::Add(MaxZ, MinZ);
+    const Vec SizeX = Ops::Sub(MaxX, MinX);
+    const Vec SizeY = Ops::Sub(MaxY, MinY);
+    const Vec SizeZ = Ops::Sub(MaxZ, MinZ);
+    const Vec Half  = Ops::Set(0.5f);
+
+    Mask Invisible    = Ops::False();
+    Mask FullyVisible = Ops::True();
+    for (Uint32 p = 0; p < Planes.NumPlanes; ++p)
+    {
+        const float3& N  = Planes.Normals[p];
+        const float3& AN = Planes.AbsNormals[p];
+
+        // DistanceToCenter = dot(Box.Max + Box.Min, Plane.Normal) * 0.5f + Plane.Distance
+        Vec DistanceToCenter = Ops::Add(Ops::Add(Ops::Mul(SumX, Ops::Set(N.x)), Ops::Mul(SumY, Ops::Set(N.y))), Ops::Mul(SumZ, Ops::Set(N.z)));
+        DistanceToCenter     = Ops::Add(Ops::Mul(DistanceToCenter, Half), Ops::Set(Planes.Distances[p]));
+
+        // ProjHalfLen = dot(Box.Max - Box.Min, abs(Plane.Normal)) * 0.5f
+        Vec ProjHalfLen = Ops::Add(Ops::Add(Ops::Mul(SizeX, Ops::Set(AN.x)), Ops::Mul(SizeY, Ops::Set(AN.y))), Ops::Mul(SizeZ, Ops::Set(AN.z)));
+        ProjHalfLen     = Ops::Mul(ProjHalfLen, Half);
+
+        Invisible    = Ops::Or(Invisible, Ops::Less(DistanceToCenter, Ops::Neg(ProjHalfLen)));
+        FullyVisible = Ops::And(FullyVisible, Ops::Greater(DistanceToCenter, ProjHalfLen));
+    }
+
+    InvisibleBits    = Ops::MoveMask(Invisible);
+    FullyVisibleBits = Ops::MoveMask(FullyVisible);
+}
+
+template <typename Ops>
+void GetBoxesVisibilityMasks(const FrustumPlanesSoA& Planes, const OrientedBoundingBoxesSoA& Boxes, size_t i, Uint32& InvisibleBits, Uint32& FullyVisibleBits)
+{
+    using Vec  = typename Ops::Vec;
+    using Mask = typename Ops::Mask;
+
+    const Vec CenterX = Ops::Load(Boxes.CenterX + i);
+    const Vec CenterY = Ops::Load(Boxes.CenterY + i);
+    const Vec CenterZ = Ops::Load(Boxes.CenterZ + i);
+
+    Vec AxisX[3];
+    Vec AxisY[3];
+    Vec AxisZ[3];
+    Vec HalfExtents[3];
+    for (Uint32 a = 0; a < 3; ++a)
+    {
+        AxisX[a]       = Ops::Load(Boxes.AxisX[a] + i);
+        AxisY[a]       = Ops::Load(Boxes.AxisY[a] + i);
+        AxisZ[a]       = Ops::Load(Boxes.AxisZ[a] + i);
+        HalfExtents[a] = Ops::Load(Boxes.HalfExtents[a] + i);
+    }
+
+    Mask Invisible    = Ops::False();
+    Mask FullyVisible = Ops::True();
+    for (Uint32 p = 0; p < Planes.NumPlanes; ++p)
+    {
+        const Vec Nx = Ops::Set(Planes.Normals[p].x);
+        const Vec Ny = Ops::Set(Planes.Normals[p].y);
+        const Vec Nz = Ops::Set(Planes.Normals[p].z);
+
+        // Distance = dot(Box.Center, Plane.Normal) + Plane.Distance
+        Vec Distance = Ops::Add(Ops::Add(Ops::Mul(CenterX, Nx), Ops::Mul(CenterY, Ny)), Ops::Mul(CenterZ, Nz));
+        Distance     = Ops::Add(Distance, Ops::Set(Planes.Distances[p]));
+
+        // ProjHalfExtents = sum(abs(dot(Box.Axes[a], Plane.Normal)) * Box.HalfExtents[a])
+        Vec ProjHalfExtents[3];
+        for (Uint32 a = 0; a < 3; ++a)
+        {
+            const Vec AxisProj = Ops::Add(Ops::Add(Ops::Mul(AxisX[a], Nx), Ops::Mul(AxisY[a], Ny)), Ops::Mul(AxisZ[a], Nz));
+            ProjHalfExtents[a] = Ops::Mul(Ops::Abs(AxisProj), HalfExtents[a]);
+        }
+        const Vec ProjHalfLen = Ops::Add(Ops::Add(ProjHalfExtents[0], ProjHalfExtents[1]), ProjHalfExtents[2]);
+
+        Invisible    = Ops::Or(Invisible, Ops::Less(Distance, Ops::Neg(ProjHalfLen)));
+        FullyVisible = Ops::And(FullyVisible, Ops::Greater(Distance, ProjHalfLen));
+    }
+
+    InvisibleBits    = Ops::MoveMask(Invisible);
+    FullyVisibleBits = Ops::MoveMask(FullyVisible);
+}
+#endif
+
+// Processes boxes in the range [Start, End). Start must be a multiple of 32 so that
+// every visibility mask word is written by a single range.
+template <typename BoxesSoAType>
+void GetBoxesVisibilityRange(const FrustumPlanesSoA& Planes,
+                             const BoxesSoAType&     Boxes,
+                             size_t                  Start,
+                             size_t                  End,
+                             BoxVisibility*          pVisibility,
+                             Uint32*                 pVisibleMask)
+{
+    VERIFY_EXPR(Start % 32 == 0 && Start <= End);
+
+    if (pVisibleMask != nullptr)
+    {
+        const size_t FirstWord = Start / 32;
+        const size_t EndWord   = (End + 31) / 32;
+        std::memset(pVisibleMask + FirstWord, 0, (EndWord - FirstWord) * sizeof(Uint32));
+    }
+
+    size_t i = Start;
+
+#if SIMD_BOX_VISIBILITY_SUPPORTED
+    constexpr Uint32 Width    = SIMDOps::Width;
+    constexpr Uint32 LaneMask = (1u << Width) - 1u;
+    static_assert(32 % Width == 0, "SIMD width must divide 32");
+    for (; i + Width <= End; i += Width)
+    {
+        Uint32 InvisibleBits    = 0;
+        Uint32 FullyVisibleBits = 0;
+        GetBoxesVisibilityMasks<SIMDOps>(Planes, Boxes, i, InvisibleBits, FullyVisibleBits);
+
+        if (pVisibility != nullptr)
+        {
+            for (Uint32 lane = 0; lane < Width; ++lane)
+            {
+                const Uint32 Bit = 1u << lane;
+                pVisibility[i + lane] =
+                    (InvisibleBits & Bit) != 0    ? BoxVisibility::Invisible :
+                    (FullyVisibleBits & Bit) != 0 ? BoxVisibility::FullyVisible :
+                                                    BoxVisibility::Intersecting;
+            }
+        }
+
+        if (pVisibleMask != nullptr)
+            pVisibleMask[i / 32] |= (~InvisibleBits & LaneMask) << (i % 32);
+    }
+#endif
+
+    for (; i < End; ++i)
+    {
+        const BoxVisibility Visibility = GetBoxVisibilityScalar(Planes, Boxes, i);
+        if (pVisibility != nullptr)
+            pVisibility[i] = Visibility;
+        if (pVisibleMask != nullptr && Visibility != BoxVisibility::Invisible)
+            pVisibleMask[i / 32] |= 1u << (i % 32);
+    }
+}
+
+template <typename BoxesSoAType>
+void GetBoxesVisibilityImpl(IThreadPool*        pThreadPool,
+                            const ViewFrustum&  Frustum,
+                            const BoxesSoAType& Boxes,
+                            size_t              NumBoxes,
+                            BoxVisibility*      pVisibility,
+                            Uint32*             pVisibleMask,
+                            FRUSTUM_PLANE_FLAGS PlaneFlags,
+                            size_t              MinBoxesPerTask)
+{
+    if (NumBoxes == 0 || (pVisibility == nullptr && pVisibleMask == nullptr))
+        return;
+
+    const FrustumPlanesSoA Planes{Frustum, PlaneFlags};
+
+    // Limit the number of tasks to keep the scheduling overhead low for very large arrays
+    constexpr size_t MaxTasks = 64;
+
+    MinBoxesPerTask       = std::max(MinBoxesPerTask, size_t{1});
+    const size_t NumTasks = pThreadPool != nullptr ? std::min(NumBoxes / MinBoxesPerTask, MaxTasks) : 0;
+    if (NumTasks <= 1)
+    {
+        GetBoxesVisibilityRange(Planes, Boxes, 0, NumBoxes, pVisibility, pVisibleMask);
+        return;
+    }
+
+    // Range size must be a multiple of 32, see GetBoxesVisibilityRange()
+    const size_t RangeSize = ((NumBoxes + NumTasks - 1) / NumTasks + 31) & ~size_t{31};
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> Tasks;
+    Tasks.reserve(NumTasks);
+    for (size_t Start = RangeSize; Start < NumBoxes; Start += RangeSize)
+    {
+        const size_t End = std::min(Start + RangeSize, NumBoxes);
+        Tasks.emplace_back(EnqueueAsyncWork(pThreadPool,
+                                            [&Planes, &Boxes, Start, End, pVisibility, pVisibleMask](Uint32 /*ThreadId*/) {
+                                                GetBoxesVisibilityRange(Planes, Boxes, Start, End, pVisibility, pVisibleMask);
+                                                return ASYNC_TASK_STATUS_COMPLETE;
+                                            }));
+    }
+
+    GetBoxesVisibilityRange(Planes, Boxes, 0, std::min(RangeSize, NumBoxes), pVisibility, pVisibleMask);
+
+    for (size_t t = 0; t < Tasks.size(); ++t)
+    {
+        // Process the tasks that have not been started yet in this thread
+        // instead of waiting for a worker thread to pick them up.
+        if (pThreadPool->RemoveTask(Tasks[t]))
+        {
+            const size_t Start = (t + 1) * RangeSize;
+            GetBoxesVisibilityRange(Planes, Boxes, Start, std::min(Start + RangeSize, NumBoxes), pVisibility, pVisibleMask);
+        }
+        else
+        {
+            Tasks[t]->WaitForCompletion();
+        }
+    }
+}
+
+} // namespace
+
+void GetBoxesVisibility(const ViewFrustum&   Frustum,
+                        const BoundBoxesSoA& Boxes,
+                        size_t               NumBoxes,
+                        BoxVisibility*       pVisibility,
+                        Uint32*              pVisibleMask,
+                        FRUSTUM_PLANE_FLAGS  PlaneFlags)
+{
+    GetBoxesVisibilityImpl(nullptr, Frustum, Boxes, NumBoxes, pVisibility, pVisibleMask, PlaneFlags, 0);
+}
+
+void GetBoxesVisibility(const ViewFrustum&              Frustum,
+                        const OrientedBoundingBoxesSoA& Boxes,
+                        size_t                          NumBoxes,
+                        BoxVisibility*                  pVisibility,
+                        Uint32*                         pVisibleMask,
+                        FRUSTUM_PLANE_FLAGS             PlaneFlags)
+{
+    GetBoxesVisibilityImpl(nullptr, Frustum, Boxes, NumBoxes, pVisibility, pVisibleMask, PlaneFlags, 0);
+}
+
+void GetBoxesVisibilityParallel(IThreadPool*         pThreadPool,
+                                const ViewFrustum&   Frustum,
+                                const BoundBoxesSoA& Boxes,
+                                size_t               NumBoxes,
+                                BoxVisibility*       pVisibility,
+                                Uint32*              pVisibleMask,
+                                FRUSTUM_PLANE_FLAGS  PlaneFlags,
+                                size_t               MinBoxesPerTask)
+{
+    GetBoxesVisibilityImpl(pThreadPool, Frustum, Boxes, NumBoxes, pVisibility, pVisibleMask, PlaneFlags, MinBoxesPerTask);
+}
+
+void GetBoxesVisibilityParallel(IThreadPool*                    pThreadPool,
+                                const ViewFrustum&              Frustum,
+                                const OrientedBoundingBoxesSoA& Boxes,
+                                size_t                          NumBoxes,
+                                BoxVisibility*                  pVisibility,
+                                Uint32*                         pVisibleMask,
+                                FRUSTUM_PLANE_FLAGS             PlaneFlags,
+                                size_t                          MinBoxesPerTask)
+{
+    GetBoxesVisibilityImpl(pThreadPool, Frustum, Boxes, NumBoxes, pVisibility, pVisibleMask, PlaneFlags, MinBoxesPerTask);
+}
+
+} // namespace Diligent
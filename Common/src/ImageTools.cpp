@@ -27,13 +27,239 @@
 #include "ImageTools.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
+#include <mutex>
+#include <vector>
 
 #include "DebugUtilities.hpp"
+#include "ThreadPool.hpp"
+#include "Intrinsics.hpp"
 
 namespace Diligent
 {
 
+namespace
+{
+
+struct ImageDiffStats
+{
+    Uint32 NumDiffPixels               = 0;
+    Uint32 NumDiffPixelsAboveThreshold = 0;
+    Uint32 MaxDiff                     = 0;
+    Uint64 SumDiff                     = 0;
+    Uint64 SumSqDiff                   = 0;
+
+    void AddPixel(Uint32 PixelDiff, Uint32 Threshold)
+    {
+        if (PixelDiff != 0)
+        {
+            ++NumDiffPixels;
+            SumDiff += PixelDiff;
+            SumSqDiff += PixelDiff * PixelDiff;
+            MaxDiff = std::max(MaxDiff, PixelDiff);
+
+            if (PixelDiff > Threshold)
+                ++NumDiffPixelsAboveThreshold;
+        }
+    }
+
+    void Merge(const ImageDiffStats& Other)
+    {
+        NumDiffPixels += Other.NumDiffPixels;
+        NumDiffPixelsAboveThreshold += Other.NumDiffPixelsAboveThreshold;
+        MaxDiff = std::max(MaxDiff, Other.MaxDiff);
+        SumDiff += Other.SumDiff;
+        SumSqDiff += Other.SumSqDiff;
+    }
+};
+
+// Computes absolute differences of NumBytes bytes
+void ComputeAbsDiff(const Uint8* pSrc1, const Uint8* pSrc2, Uint8* pDst, size_t NumBytes)
+{
+    size_t i = 0;
+#if DILIGENT_SSE2_SUPPORTED
+    for (; i + 16 <= NumBytes; i += 16)
+    {
+        const __m128i mmSrc1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc1 + i));
+        const __m128i mmSrc2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc2 + i));
+        // |a - b| = sat(a - b) | sat(b - a)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), _mm_or_si128(_mm_subs_epu8(mmSrc1, mmSrc2), _mm_subs_epu8(mmSrc2, mmSrc1)));
+    }
+#elif DILIGENT_NEON_SUPPORTED
+    for (; i + 16 <= NumBytes; i += 16)
+    {
+        vst1q_u8(pDst + i, vabdq_u8(vld1q_u8(pSrc1 + i), vld1q_u8(pSrc2 + i)));
+    }
+#endif
+    for (; i < NumBytes; ++i)
+    {
+        pDst[i] = static_cast<Uint8>(std::abs(static_cast<int>(pSrc1[i]) - static_cast<int>(pSrc2[i])));
+    }
+}
+
+// Computes absolute differences of the first NumChannels channels of images with different layouts
+void ComputeAbsDiff(const Uint8* pSrc1,
+                    Uint32       NumChannels1,
+                    const Uint8* pSrc2,
+                    Uint32       NumChannels2,
+                    Uint8*       pDst,
+                    Uint32       NumChannels,
+                    Uint32       NumPixels)
+{
+    for (Uint32 px = 0; px < NumPixels; ++px)
+    {
+        for (Uint32 ch = 0; ch < NumChannels; ++ch)
+        {
+            pDst[px * NumChannels + ch] = static_cast<Uint8>(
+                std::abs(static_cast<int>(pSrc1[px * NumChannels1 + ch]) -
+                         static_cast<int>(pSrc2[px * NumChannels2 + ch])));
+        }
+    }
+}
+
+// Zeroes the differences of the pixels for which the mask value is zero
+void ApplyMask(Uint8* pDiff, const Uint8* pMask, Uint32 NumChannels, Uint32 NumPixels)
+{
+    Uint32 px = 0;
+#if DILIGENT_SSE2_SUPPORTED
+    if (NumChannels == 4)
+    {
+        const __m128i mmZero = _mm_setzero_si128();
+        for (; px + 4 <= NumPixels; px += 4)
+        {
+            int Mask4 = 0;
+            std::memcpy(&Mask4, pMask + px, sizeof(Mask4));
+
+            // Expand 0xFF for every rejected pixel to all its four channels
+            __m128i mmRejected = _mm_cmpeq_epi8(_mm_cvtsi32_si128(Mask4), mmZero);
+            mmRejected         = _mm_unpacklo_epi8(mmRejected, mmRejected);
+            mmRejected         = _mm_unpacklo_epi16(mmRejected, mmRejected);
+
+            __m128i* pDiff4 = reinterpret_cast<__m128i*>(pDiff + px * 4);
+            _mm_storeu_si128(pDiff4, _mm_andnot_si128(mmRejected, _mm_loadu_si128(pDiff4)));
+        }
+    }
+#endif
+    for (; px < NumPixels; ++px)
+    {
+        if (pMask[px] == 0)
+            std::memset(pDiff + px * NumChannels, 0, NumChannels);
+    }
+}
+
+// Accumulates the differences of 4-channel pixels
+void AccumulatePixelDiffs4(const Uint8* pDiff, Uint32 NumPixels, Uint32 Threshold, ImageDiffStats& Stats)
+{
+    Uint32 px = 0;
+#if DILIGENT_SSE2_SUPPORTED
+    const __m128i mmZero      = _mm_setzero_si128();
+    const __m128i mmByteMask  = _mm_set1_epi32(0xFF);
+    const __m128i mmThreshold = _mm_set1_epi32(static_cast<int>(std::min(Threshold, 255u)));
+    __m128i       mmMaxDiff   = _mm_setzero_si128();
+    while (px + 4 <= NumPixels)
+    {
+        // Limit the batch size so that 32-bit sums of squares can't overflow
+        const Uint32 BatchEnd = px + std::min((NumPixels - px) & ~3u, 65536u);
+
+        __m128i mmNumDiff  = _mm_setzero_si128();
+        __m128i mmNumAbove = _mm_setzero_si128();
+        __m128i mmSum      = _mm_setzero_si128();
+        __m128i mmSumSq    = _mm_setzero_si128();
+        for (; px < BatchEnd; px += 4)
+        {
+            __m128i mmPixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pDiff + px * 4));
+            // Maximum channel difference of every pixel in the low byte of each 32-bit lane
+            mmPixels = _mm_max_epu8(mmPixels, _mm_srli_epi32(mmPixels, 8));
+            mmPixels = _mm_max_epu8(mmPixels, _mm_srli_epi32(mmPixels, 16));
+            mmPixels = _mm_and_si128(mmPixels, mmByteMask);
+
+            mmMaxDiff = _mm_max_epi16(mmMaxDiff, mmPixels);
+            mmSum     = _mm_add_epi32(mmSum, mmPixels);
+            mmSumSq   = _mm_add_epi32(mmSumSq, _mm_madd_epi16(mmPixels, mmPixels));
+            // Comparison masks are -1, so subtracting them increments the counters
+            mmNumDiff  = _mm_sub_epi32(mmNumDiff, _mm_cmpgt_epi32(mmPixels, mmZero));
+            mmNumAbove = _mm_sub_epi32(mmNumAbove, _mm_cmpgt_epi32(mmPixels, mmThreshold));
+        }
+
+        alignas(16) Uint32 NumDiff[4];
+        alignas(16) Uint32 NumAbove[4];
+        alignas(16) Uint32 Sum[4];
+        alignas(16) Uint32 SumSq[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(NumDiff), mmNumDiff);
+        _mm_store_si128(reinterpret_cast<__m128i*>(NumAbove), mmNumAbove);
+        _mm_store_si128(reinterpret_cast<__m128i*>(Sum), mmSum);
+        _mm_store_si128(reinterpret_cast<__m128i*>(SumSq), mmSumSq);
+        for (size_t i = 0; i < 4; ++i)
+        {
+            Stats.NumDiffPixels += NumDiff[i];
+            Stats.NumDiffPixelsAboveThreshold += NumAbove[i];
+            Stats.SumDiff += Sum[i];
+            Stats.SumSqDiff += SumSq[i];
+        }
+    }
+
+    alignas(16) Uint32 MaxDiff[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(MaxDiff), mmMaxDiff);
+    Stats.MaxDiff = std::max({Stats.MaxDiff, MaxDiff[0], MaxDiff[1], MaxDiff[2], MaxDiff[3]});
+#endif
+
+    for (; px < NumPixels; ++px)
+    {
+        const Uint8* pPixel = pDiff + px * 4;
+        Stats.AddPixel(std::max({pPixel[0], pPixel[1], pPixel[2], pPixel[3]}), Threshold);
+    }
+}
+
+void AccumulatePixelDiffs(const Uint8* pDiff, Uint32 NumChannels, Uint32 NumPixels, Uint32 Threshold, ImageDiffStats& Stats)
+{
+    if (NumChannels == 4)
+    {
+        AccumulatePixelDiffs4(pDiff, NumPixels, Threshold, Stats);
+        return;
+    }
+
+    for (Uint32 px = 0; px < NumPixels; ++px)
+    {
+        Uint32 PixelDiff = 0;
+        for (Uint32 ch = 0; ch < NumChannels; ++ch)
+            PixelDiff = std::max(PixelDiff, static_cast<Uint32>(pDiff[px * NumChannels + ch]));
+        Stats.AddPixel(PixelDiff, Threshold);
+    }
+}
+
+// Writes one row of the difference image
+void WriteDiffRow(const Uint8*                  pDiff,
+                  Uint32                        NumSrcChannels,
+                  Uint8*                        pDst,
+                  Uint32                        NumDstChannels,
+                  Uint32                        NumPixels,
+                  const std::array<Uint8, 256>& ScaleLUT,
+                  bool                          IdentityScale)
+{
+    if (NumSrcChannels == NumDstChannels && IdentityScale)
+    {
+        std::memcpy(pDst, pDiff, size_t{NumPixels} * NumSrcChannels);
+        return;
+    }
+
+    const Uint32 NumCopyChannels = std::min(NumSrcChannels, NumDstChannels);
+    for (Uint32 px = 0; px < NumPixels; ++px)
+    {
+        const Uint8* pSrcPixel = pDiff + px * NumSrcChannels;
+        Uint8*       pDstPixel = pDst + px * NumDstChannels;
+
+        Uint32 ch = 0;
+        for (; ch < NumCopyChannels; ++ch)
+            pDstPixel[ch] = ScaleLUT[pSrcPixel[ch]];
+        for (; ch < NumDstChannels; ++ch)
+            pDstPixel[ch] = ch == 3 ? 255 : 0;
+    }
+}
+
+} // namespace
+
 void ComputeImageDifference(const ComputeImageDifferenceAttribs& Attribs,
                             ImageDiffInfo&                       Diff)
 {
@@ -79,55 +305,96 @@ void ComputeImageDifference(const ComputeImageDifferenceAttribs& Attribs,
         }
     }
 
-    for (Uint32 row = 0; row < Attribs.Height; ++row)
+    if (Attribs.RegionX > Attribs.Width || Attribs.RegionY > Attribs.Height)
+    {
+        UNEXPECTED("Region origin (", Attribs.RegionX, ", ", Attribs.RegionY, ") is outside of the image (", Attribs.Width, "x", Attribs.Height, ")");
+        return;
+    }
+    const Uint32 RegionWidth  = Attribs.RegionWidth != 0 ? Attribs.RegionWidth : Attribs.Width - Attribs.RegionX;
+    const Uint32 RegionHeight = Attribs.RegionHeight != 0 ? Attribs.RegionHeight : Attribs.Height - Attribs.RegionY;
+    if (RegionWidth > Attribs.Width - Attribs.RegionX || RegionHeight > Attribs.Height - Attribs.RegionY)
+    {
+        UNEXPECTED("Region (", Attribs.RegionX, ", ", Attribs.RegionY, ") - (", Attribs.RegionX + RegionWidth, ", ", Attribs.RegionY + RegionHeight,
+                   ") exceeds the image dimensions (", Attribs.Width, "x", Attribs.Height, ")");
+        return;
+    }
+
+    if (Attribs.pMask != nullptr && Attribs.MaskStride < Attribs.Width)
     {
-        const Uint8* pRow1    = reinterpret_cast<const Uint8*>(Attribs.pImage1) + row * Attribs.Stride1;
-        const Uint8* pRow2    = reinterpret_cast<const Uint8*>(Attribs.pImage2) + row * Attribs.Stride2;
-        Uint8*       pDiffRow = Attribs.pDiffImage != nullptr ? reinterpret_cast<Uint8*>(Attribs.pDiffImage) + row * Attribs.DiffStride : nullptr;
+        UNEXPECTED("MaskStride is too small. It must be at least ", Attribs.Width, " bytes long.");
+        return;
+    }
+
+    std::array<Uint8, 256> ScaleLUT;
+    for (Uint32 d = 0; d < ScaleLUT.size(); ++d)
+        ScaleLUT[d] = static_cast<Uint8>(std::min(d * Attribs.Scale, 255.f));
+    const bool IdentityScale = Attribs.Scale == 1.f;
 
-        for (Uint32 col = 0; col < Attribs.Width; ++col)
+    // Rows outside of the region only need to be processed to clear the difference image
+    const Uint32 FirstRow = Attribs.pDiffImage != nullptr ? 0 : Attribs.RegionY;
+    const Uint32 NumRows  = Attribs.pDiffImage != nullptr ? Attribs.Height : RegionHeight;
+
+    ImageDiffStats TotalStats;
+    std::mutex     StatsMtx;
+
+    auto ProcessRows = [&](Uint32 StartRow, Uint32 EndRow) {
+        ImageDiffStats BandStats;
+
+        // Differences outside of the region are always zero
+        std::vector<Uint8> DiffRow(size_t{Attribs.Width} * NumSrcChannels);
+        Uint8* const       pRegionDiff = DiffRow.data() + size_t{Attribs.RegionX} * NumSrcChannels;
+
+        for (Uint32 row = FirstRow + StartRow; row < FirstRow + EndRow; ++row)
         {
-            Uint32 PixelDiff = 0;
-            for (Uint32 ch = 0; ch < NumSrcChannels; ++ch)
+            const Uint8* pMaskRow = Attribs.pMask != nullptr ?
+                reinterpret_cast<const Uint8*>(Attribs.pMask) + size_t{row} * Attribs.MaskStride + Attribs.RegionX :
+                nullptr;
+
+            bool CompareRow = row >= Attribs.RegionY && row < Attribs.RegionY + RegionHeight;
+            if (CompareRow && pMaskRow != nullptr)
+                CompareRow = std::any_of(pMaskRow, pMaskRow + RegionWidth, [](Uint8 m) { return m != 0; });
+
+            if (CompareRow)
             {
-                const Uint32 ChannelDiff = static_cast<Uint32>(
-                    std::abs(static_cast<int>(pRow1[col * Attribs.NumChannels1 + ch]) -
-                             static_cast<int>(pRow2[col * Attribs.NumChannels2 + ch])));
-                PixelDiff = std::max(PixelDiff, ChannelDiff);
-
-                if (pDiffRow != nullptr && ch < NumDiffChannels)
-                {
-                    pDiffRow[col * NumDiffChannels + ch] = static_cast<Uint8>(std::min(ChannelDiff * Attribs.Scale, 255.f));
-                }
-            }
+                const Uint8* pRow1 = reinterpret_cast<const Uint8*>(Attribs.pImage1) + size_t{row} * Attribs.Stride1 + size_t{Attribs.RegionX} * Attribs.NumChannels1;
+                const Uint8* pRow2 = reinterpret_cast<const Uint8*>(Attribs.pImage2) + size_t{row} * Attribs.Stride2 + size_t{Attribs.RegionX} * Attribs.NumChannels2;
+                if (Attribs.NumChannels1 == Attribs.NumChannels2)
+                    ComputeAbsDiff(pRow1, pRow2, pRegionDiff, size_t{RegionWidth} * NumSrcChannels);
+                else
+                    ComputeAbsDiff(pRow1, Attribs.NumChannels1, pRow2, Attribs.NumChannels2, pRegionDiff, NumSrcChannels, RegionWidth);
+
+                if (pMaskRow != nullptr)
+                    ApplyMask(pRegionDiff, pMaskRow, NumSrcChannels, RegionWidth);
 
-            if (pDiffRow != nullptr)
+                AccumulatePixelDiffs(pRegionDiff, NumSrcChannels, RegionWidth, Attribs.Threshold, BandStats);
+            }
+            else if (Attribs.pDiffImage != nullptr)
             {
-                for (Uint32 ch = NumSrcChannels; ch < NumDiffChannels; ++ch)
-                {
-                    pDiffRow[col * NumDiffChannels + ch] = ch == 3 ? 255 : 0;
-                }
+                std::memset(pRegionDiff, 0, size_t{RegionWidth} * NumSrcChannels);
             }
 
-            if (PixelDiff != 0)
+            if (Attribs.pDiffImage != nullptr)
             {
-                ++Diff.NumDiffPixels;
-                Diff.AvgDiff += static_cast<float>(PixelDiff);
-                Diff.RmsDiff += static_cast<float>(PixelDiff * PixelDiff);
-                Diff.MaxDiff = std::max(Diff.MaxDiff, PixelDiff);
-
-                if (PixelDiff > Attribs.Threshold)
-                {
-                    ++Diff.NumDiffPixelsAboveThreshold;
-                }
+                Uint8* pDiffRow = reinterpret_cast<Uint8*>(Attribs.pDiffImage) + size_t{row} * Attribs.DiffStride;
+                WriteDiffRow(DiffRow.data(), NumSrcChannels, pDiffRow, NumDiffChannels, Attribs.Width, ScaleLUT, IdentityScale);
             }
         }
-    }
 
-    if (Diff.NumDiffPixels > 0)
+        std::lock_guard<std::mutex> Lock{StatsMtx};
+        TotalStats.Merge(BandStats);
+    };
+
+    // Let every task process at least ~64K pixels to keep the scheduling overhead low
+    constexpr Uint32 MinPixelsPerTask = 65536;
+    ProcessRangeInParallel(Attribs.pThreadPool, NumRows, MinPixelsPerTask / std::max(Attribs.Width, 1u), ProcessRows);
+
+    Diff.NumDiffPixels               = TotalStats.NumDiffPixels;
+    Diff.NumDiffPixelsAboveThreshold = TotalStats.NumDiffPixelsAboveThreshold;
+    Diff.MaxDiff                     = TotalStats.MaxDiff;
+    if (TotalStats.NumDiffPixels > 0)
     {
-        Diff.AvgDiff /= static_cast<float>(Diff.NumDiffPixels);
-        Diff.RmsDiff = std::sqrt(Diff.RmsDiff / static_cast<float>(Diff.NumDiffPixels));
+        Diff.AvgDiff = static_cast<float>(static_cast<double>(TotalStats.SumDiff) / TotalStats.NumDiffPixels);
+        Diff.RmsDiff = static_cast<float>(std::sqrt(static_cast<double>(TotalStats.SumSqDiff) / TotalStats.NumDiffPixels));
     }
 }
 
@@ -0,0 +1,278 @@
+/*
+ *  Copyright 2019-2025 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "LZ4Codec.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "BasicTypes.h"
+#include "DebugUtilities.hpp"
+
+// LZ4 block format (https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md):
+//
+// | Sequence 0 | Sequence 1 | ... | Last sequence |
+//
+//     | Sequence | = | Token | Literal length ext | Literals | Offset | Match length ext |
+//
+// The token contains the literal length in the high 4 bits and the match length minus 4
+// in the low 4 bits. The value of 15 indicates that the length continues in the
+// following bytes (255 means that one more byte follows). The offset is a 16-bit little-endian
+// distance back to the match source. The last sequence contains the literals only.
+
+namespace Diligent
+{
+
+namespace
+{
+
+constexpr size_t MinMatch     = 4;
+constexpr size_t LastLiterals = 5;  // The last 5 bytes are always literals
+constexpr size_t MFLimit      = 12; // The last match must start at least 12 bytes before the end of the block
+constexpr size_t MaxOffset    = 65535;
+constexpr Uint32 HashLog      = 12;
+
+Uint32 Read32(const Uint8* p)
+{
+    Uint32 Val;
+    memcpy(&Val, p, sizeof(Val));
+    return Val;
+}
+
+Uint32 HashSequence(Uint32 Sequence)
+{
+    return (Sequence * 2654435761u) >> (32 - HashLog);
+}
+
+// Returns the number of bytes required to encode the length extension.
+size_t GetLengthExtSize(size_t Length)
+{
+    return Length >= 15 ? (Length - 15) / 255 + 1 : 0;
+}
+
+Uint8* WriteLengthExt(Uint8* pDst, size_t Length)
+{
+    VERIFY_EXPR(Length >= 15);
+    for (Length -= 15; Length >= 255; Length -= 255)
+        *(pDst++) = 255;
+    *(pDst++) = static_cast<Uint8>(Length);
+    return pDst;
+}
+
+bool ReadLengthExt(const Uint8*& pSrc, const Uint8* pSrcEnd, size_t& Length)
+{
+    Uint8 Byte = 255;
+    while (Byte == 255)
+    {
+        if (pSrc >= pSrcEnd)
+            return false;
+        Byte = *(pSrc++);
+        Length += Byte;
+    }
+    return true;
+}
+
+// Writes the sequence with the given literals and the optional match.
+// Returns null if the sequence does not fit into the destination buffer.
+Uint8* WriteSequence(Uint8*       pDst,
+                     const Uint8* pDstEnd,
+                     const Uint8* pLiterals,
+                     size_t       LiteralLen,
+                     size_t       Offset,
+                     size_t       MatchLen)
+{
+    const size_t RequiredSize =
+        1 + GetLengthExtSize(LiteralLen) + LiteralLen +
+        (MatchLen > 0 ? 2 + GetLengthExtSize(MatchLen - MinMatch) : 0);
+    if (RequiredSize > static_cast<size_t>(pDstEnd - pDst))
+        return nullptr;
+
+    Uint8& Token = *(pDst++);
+    Token        = static_cast<Uint8>(std::min(LiteralLen, size_t{15}) << 4);
+    if (LiteralLen >= 15)
+        pDst = WriteLengthExt(pDst, LiteralLen);
+
+    memcpy(pDst, pLiterals, LiteralLen);
+    pDst += LiteralLen;
+
+    if (MatchLen > 0)
+    {
+        VERIFY_EXPR(Offset > 0 && Offset <= MaxOffset && MatchLen >= MinMatch);
+        *(pDst++) = static_cast<Uint8>(Offset & 0xFF);
+        *(pDst++) = static_cast<Uint8>(Offset >> 8);
+
+        Token |= static_cast<Uint8>(std::min(MatchLen - MinMatch, size_t{15}));
+        if (MatchLen - MinMatch >= 15)
+            pDst = WriteLengthExt(pDst, MatchLen - MinMatch);
+    }
+
+    return pDst;
+}
+
+} // namespace
+
+size_t LZ4CompressBound(size_t SrcSize)
+{
+    return SrcSize + SrcSize / 255 + 16;
+}
+
+size_t LZ4CompressBlock(const void* pSrc, size_t SrcSize, void* pDst, size_t DstCapacity)
+{
+    if ((pSrc == nullptr && SrcSize != 0) || pDst == nullptr)
+    {
+        DEV_ERROR("Source and destination buffers must not be null");
+        return 0;
+    }
+
+    const Uint8* const pSrcStart = static_cast<const Uint8*>(pSrc);
+    const Uint8* const pSrcEnd   = pSrcStart + SrcSize;
+    Uint8* const       pDstStart = static_cast<Uint8*>(pDst);
+    const Uint8* const pDstEnd   = pDstStart + DstCapacity;
+
+    const Uint8* pAnchor = pSrcStart;
+    Uint8*       pOut    = pDstStart;
+
+    if (SrcSize > MFLimit)
+    {
+        const Uint8* const pMatchLimit = pSrcEnd - LastLiterals;
+        const Uint8* const pLastMatch  = pSrcEnd - MFLimit;
+
+        // Positions of the last occurrence of each hashed 4-byte sequence
+        Uint32 HashTable[1u << HashLog] = {};
+
+        const Uint8* pIn = pSrcStart;
+        while (pIn <= pLastMatch)
+        {
+            const Uint32 Sequence = Read32(pIn);
+            Uint32&      Entry    = HashTable[HashSequence(Sequence)];
+            const Uint8* pRef     = pSrcStart + Entry;
+            Entry                 = static_cast<Uint32>(pIn - pSrcStart);
+
+            if (pRef >= pIn || static_cast<size_t>(pIn - pRef) > MaxOffset || Read32(pRef) != Sequence)
+            {
+                ++pIn;
+                continue;
+            }
+
+            // Extend the match backwards
+            while (pIn > pAnchor && pRef > pSrcStart && pIn[-1] == pRef[-1])
+            {
+                --pIn;
+                --pRef;
+            }
+
+            // Extend the match forward
+            size_t MatchLen = MinMatch;
+            while (pIn + MatchLen < pMatchLimit && pIn[MatchLen] == pRef[MatchLen])
+                ++MatchLen;
+
+            pOut = WriteSequence(pOut, pDstEnd, pAnchor, static_cast<size_t>(pIn - pAnchor), static_cast<size_t>(pIn - pRef), MatchLen);
+            if (pOut == nullptr)
+                return 0;
+
+            pIn += MatchLen;
+            pAnchor = pIn;
+        }
+    }
+
+    // The last sequence contains the remaining literals only
+    pOut = WriteSequence(pOut, pDstEnd, pAnchor, static_cast<size_t>(pSrcEnd - pAnchor), 0, 0);
+    if (pOut == nullptr)
+        return 0;
+
+    return static_cast<size_t>(pOut - pDstStart);
+}
+
+bool LZ4DecompressBlock(const void* pSrc, size_t SrcSize, void* pDst, size_t DstSize)
+{
+    if (pSrc == nullptr || (pDst == nullptr && DstSize != 0))
+    {
+        DEV_ERROR("Source and destination buffers must not be null");
+        return false;
+    }
+
+    const Uint8*       pIn       = static_cast<const Uint8*>(pSrc);
+    const Uint8* const pSrcEnd   = pIn + SrcSize;
+    Uint8* const       pDstStart = static_cast<Uint8*>(pDst);
+    Uint8*             pOut      = pDstStart;
+    const Uint8* const pDstEnd   = pDstStart + DstSize;
+
+    for (;;)
+    {
+        if (pIn >= pSrcEnd)
+            return false;
+
+        const Uint8 Token = *(pIn++);
+
+        size_t LiteralLen = Token >> 4;
+        if (LiteralLen == 15 && !ReadLengthExt(pIn, pSrcEnd, LiteralLen))
+            return false;
+
+        if (LiteralLen > static_cast<size_t>(pSrcEnd - pIn) || LiteralLen > static_cast<size_t>(pDstEnd - pOut))
+            return false;
+
+        memcpy(pOut, pIn, LiteralLen);
+        pIn += LiteralLen;
+        pOut += LiteralLen;
+
+        // The last sequence has no match
+        if (pIn == pSrcEnd)
+            break;
+
+        if (pSrcEnd - pIn < 2)
+            return false;
+        const size_t Offset = static_cast<size_t>(pIn[0]) | (static_cast<size_t>(pIn[1]) << 8);
+        pIn += 2;
+        if (Offset == 0 || Offset > static_cast<size_t>(pOut - pDstStart))
+            return false;
+
+        size_t MatchLen = Token & 0x0F;
+        if (MatchLen == 15 && !ReadLengthExt(pIn, pSrcEnd, MatchLen))
+            return false;
+        MatchLen += MinMatch;
+
+        if (MatchLen > static_cast<size_t>(pDstEnd - pOut))
+            return false;
+
+        const Uint8* pMatch = pOut - Offset;
+        if (Offset >= MatchLen)
+        {
+            memcpy(pOut, pMatch, MatchLen);
+            pOut += MatchLen;
+        }
+        else
+        {
+            // Overlapping copy replicates the pattern
+            for (size_t i = 0; i < MatchLen; ++i)
+                *(pOut++) = *(pMatch++);
+        }
+    }
+
+    return pOut == pDstEnd;
+}
+
+} // namespace Diligent
@@ -90,6 +90,10 @@ public:
     /// Implementation of IArchiver::GetPipelineResourceSignature().
     virtual IPipelineResourceSignature* DILIGENT_CALL_TYPE GetPipelineResourceSignature(const char* PRSName) override final;
 
+    /// Implementation of IArchiver::SetShaderCompression().
+    virtual void DILIGENT_CALL_TYPE SetShaderCompression(ARCHIVE_SHADER_COMPRESSION Compression,
+                                                         Uint32                     BlockSize) override final;
+
 private:
     bool AddRenderPass(IRenderPass* pRP);
 
@@ -117,6 +121,8 @@ private:
 
     std::mutex     m_PipelinesMtx;
     PSOHashMapType m_Pipelines;
+
+    DeviceObjectArchive::SerializeAttribs m_SerializeAttribs;
 };
 
 } // namespace Diligent
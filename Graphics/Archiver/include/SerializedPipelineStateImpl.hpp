@@ -111,7 +111,6 @@ public:
         struct ShaderInfo
         {
             SerializedData Data;
-            size_t         Hash  = 0;
             SHADER_TYPE    Stage = SHADER_TYPE_UNKNOWN;
         };
         std::array<std::vector<ShaderInfo>, DeviceDataCount> Shaders;
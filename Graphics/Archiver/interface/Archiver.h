@@ -85,6 +85,20 @@ DILIGENT_TYPED_ENUM(ARCHIVE_DEVICE_DATA_FLAGS, Uint32)
 DEFINE_FLAG_ENUM_OPERATORS(ARCHIVE_DEVICE_DATA_FLAGS)
 
 
+/// Archive shader data compression.
+DILIGENT_TYPED_ENUM(ARCHIVE_SHADER_COMPRESSION, Uint32)
+{
+    /// Shader data is stored uncompressed.
+    ARCHIVE_SHADER_COMPRESSION_NONE = 0u,
+
+    /// Shader data is packed into blocks that are compressed using the LZ4 block format.
+    /// The blocks are decompressed on demand when shaders are unpacked from the archive.
+    ARCHIVE_SHADER_COMPRESSION_LZ4,
+
+    ARCHIVE_SHADER_COMPRESSION_COUNT
+};
+
+
 /// Render state object archiver interface
 DILIGENT_BEGIN_INTERFACE(IArchiver, IObject)
 {
@@ -95,6 +109,13 @@ DILIGENT_BEGIN_INTERFACE(IArchiver, IObject)
 
     /// \note
     ///     The method is *not* thread-safe and **must not** be called from multiple threads simultaneously.
+    ///
+    /// \note
+    ///     Identical shader byte code is stored in the archive only once.
+    ///     If the serialization device has a shader compilation thread pool (see
+    ///     SerializationDeviceCreateInfo::pAsyncShaderCompilationThreadPool), the method uses it
+    ///     to hash the byte code and to serialize the data for different device types in parallel.
+    ///     The result does not depend on the thread pool or the order in which the objects were added.
     VIRTUAL Bool METHOD(SerializeToBlob)(THIS_
                                          Uint32      ContentVersion,
                                          IDataBlob** ppBlob) PURE;
@@ -195,6 +216,25 @@ DILIGENT_BEGIN_INTERFACE(IArchiver, IObject)
     ///             so the application **must not** call Release() unless it also explicitly calls AddRef().
     VIRTUAL IPipelineResourceSignature* METHOD(GetPipelineResourceSignature)(THIS_
                                                                              const char* PRSName) PURE;
+
+    /// Sets the shader data compression used by SerializeToBlob() and SerializeToStream().
+
+    /// \param [in] Compression - Shader data compression.
+    /// \param [in] BlockSize   - The minimum size of the block that consecutive shaders are packed into
+    ///                           before compression. Larger blocks compress better, but more data needs
+    ///                           to be decompressed to unpack a single shader. If zero, every shader is
+    ///                           compressed individually.
+    ///
+    /// \note
+    ///     By default, shader data is not compressed.
+    ///     Shader blocks are compressed in parallel using the shader compilation thread pool
+    ///     of the serialization device, if it has one.
+    ///
+    ///     The method is *not* thread-safe and **must not** be called simultaneously with SerializeToBlob()
+    ///     or SerializeToStream().
+    VIRTUAL void METHOD(SetShaderCompression)(THIS_
+                                              ARCHIVE_SHADER_COMPRESSION Compression,
+                                              Uint32                     BlockSize DEFAULT_VALUE(65536)) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -210,6 +250,7 @@ DILIGENT_END_INTERFACE
 #    define IArchiver_GetShader(This, ...)                    CALL_IFACE_METHOD(Archiver, GetShader,                    This, __VA_ARGS__)
 #    define IArchiver_GetPipelineState(This, ...)             CALL_IFACE_METHOD(Archiver, GetPipelineState,             This, __VA_ARGS__)
 #    define IArchiver_GetPipelineResourceSignature(This, ...) CALL_IFACE_METHOD(Archiver, GetPipelineResourceSignature, This, __VA_ARGS__)
+#    define IArchiver_SetShaderCompression(This, ...)         CALL_IFACE_METHOD(Archiver, SetShaderCompression,         This, __VA_ARGS__)
 
 #endif
 
@@ -227,6 +227,8 @@ struct SerializationDeviceCreateInfo
     SerializationDeviceMtlInfo Metal;
 
     /// An optional thread pool for asynchronous shader and pipeline state compilation.
+
+    /// The thread pool is also used by IArchiver::SerializeToBlob() to process the archive data in parallel.
     IThreadPool* pAsyncShaderCompilationThreadPool DEFAULT_INITIALIZER(nullptr);
 
     /// The maximum number of threads that can be used to compile shaders.
@@ -253,6 +255,50 @@ struct SerializationDeviceCreateInfo
 typedef struct SerializationDeviceCreateInfo SerializationDeviceCreateInfo;
 
 
+/// Type of a named resource stored in an archive
+DILIGENT_TYPED_ENUM(ARCHIVE_RESOURCE_TYPE, Uint8)
+{
+    /// Undefined resource type.
+    ARCHIVE_RESOURCE_TYPE_UNDEFINED = 0,
+
+    /// Standalone shader.
+    ARCHIVE_RESOURCE_TYPE_SHADER,
+
+    /// Pipeline resource signature.
+    ARCHIVE_RESOURCE_TYPE_RESOURCE_SIGNATURE,
+
+    /// Pipeline state of any type (graphics, compute, tile or ray tracing).
+    ARCHIVE_RESOURCE_TYPE_PIPELINE_STATE,
+
+    /// Render pass.
+    ARCHIVE_RESOURCE_TYPE_RENDER_PASS,
+
+    ARCHIVE_RESOURCE_TYPE_COUNT
+};
+
+
+/// Identifies a named resource stored in an archive
+struct ArchiveResourceInfo
+{
+    /// Resource type.
+    ARCHIVE_RESOURCE_TYPE Type DEFAULT_INITIALIZER(ARCHIVE_RESOURCE_TYPE_UNDEFINED);
+
+    /// Resource name.
+    const Char*           Name DEFAULT_INITIALIZER(nullptr);
+
+#if DILIGENT_CPP_INTERFACE
+    constexpr ArchiveResourceInfo() noexcept {}
+
+    constexpr ArchiveResourceInfo(ARCHIVE_RESOURCE_TYPE _Type,
+                                  const Char*           _Name) noexcept :
+        Type{_Type},
+        Name{_Name}
+    {}
+#endif
+};
+typedef struct ArchiveResourceInfo ArchiveResourceInfo;
+
+
 /// Archiver factory interface
 DILIGENT_BEGIN_INTERFACE(IArchiverFactory, IObject)
 {
@@ -311,6 +357,24 @@ DILIGENT_BEGIN_INTERFACE(IArchiverFactory, IObject)
                                           IDataBlob**               ppDstArchive) CONST PURE;
 
 
+    /// Removes named resources from the archive and writes a new archive to the stream.
+
+    /// \param [in]  pSrcArchive   - Source archive from which the resources will be removed.
+    /// \param [in]  pResources    - An array of resources to remove, see Diligent::ArchiveResourceInfo.
+    /// \param [in]  NumResources  - The number of elements in `pResources` array.
+    /// \param [out] ppDstArchive  - Memory address where a pointer to the new archive will be written.
+    /// \return     `true` if the resources were successfully removed, and `false` otherwise.
+    ///
+    /// \remarks   Resources that are not present in the archive are ignored.
+    ///            Shaders that are no longer referenced by any resource are removed
+    ///            from the archive, and identical shaders are merged.
+    VIRTUAL Bool METHOD(RemoveResources)(THIS_
+                                         const IDataBlob*           pSrcArchive,
+                                         const ArchiveResourceInfo* pResources,
+                                         Uint32                     NumResources,
+                                         IDataBlob**                ppDstArchive) CONST PURE;
+
+
     /// Merges multiple archives into one.
 
     /// \param [in]  ppSrcArchives   - An array of pointers to the source archives.
@@ -364,6 +428,7 @@ DILIGENT_END_INTERFACE
 #    define IArchiverFactory_CreateDefaultShaderSourceStreamFactory(This, ...)  CALL_IFACE_METHOD(ArchiverFactory, CreateDefaultShaderSourceStreamFactory, This, __VA_ARGS__)
 #    define IArchiverFactory_RemoveDeviceData(This, ...)                        CALL_IFACE_METHOD(ArchiverFactory, RemoveDeviceData,                       This, __VA_ARGS__)
 #    define IArchiverFactory_AppendDeviceData(This, ...)                        CALL_IFACE_METHOD(ArchiverFactory, AppendDeviceData,                       This, __VA_ARGS__)
+#    define IArchiverFactory_RemoveResources(This, ...)                         CALL_IFACE_METHOD(ArchiverFactory, RemoveResources,                        This, __VA_ARGS__)
 #    define IArchiverFactory_MergeArchives(This, ...)                           CALL_IFACE_METHOD(ArchiverFactory, MergeArchives,                          This, __VA_ARGS__)
 #    define IArchiverFactory_PrintArchiveContent(This, ...)                     CALL_IFACE_METHOD(ArchiverFactory, PrintArchiveContent,                    This, __VA_ARGS__)
 #    define IArchiverFactory_SetMessageCallback(This, ...)                      CALL_IFACE_METHOD(ArchiverFactory, SetMessageCallback,                     This, __VA_ARGS__)
@@ -132,6 +132,12 @@ public:
         const IDataBlob*          pDeviceArchive,
         IDataBlob**               ppDstArchive) const override final;
 
+    virtual Bool DILIGENT_CALL_TYPE RemoveResources(
+        const IDataBlob*           pSrcArchive,
+        const ArchiveResourceInfo* pResources,
+        Uint32                     NumResources,
+        IDataBlob**                ppDstArchive) const override final;
+
     virtual Bool DILIGENT_CALL_TYPE MergeArchives(
         const IDataBlob* ppSrcArchives[],
         Uint32           NumSrcArchives,
@@ -294,6 +300,83 @@ Bool ArchiverFactoryImpl::AppendDeviceData(const IDataBlob*          pSrcArchive
     }
 }
 
+Bool ArchiverFactoryImpl::RemoveResources(const IDataBlob*           pSrcArchive,
+                                          const ArchiveResourceInfo* pResources,
+                                          Uint32                     NumResources,
+                                          IDataBlob**                ppDstArchive) const
+{
+    if (pSrcArchive == nullptr)
+    {
+        DEV_ERROR("pSrcArchive must not be null");
+        return false;
+    }
+    if (pResources == nullptr && NumResources != 0)
+    {
+        DEV_ERROR("pResources must not be null when NumResources is not zero");
+        return false;
+    }
+    if (ppDstArchive == nullptr)
+    {
+        DEV_ERROR("ppDstArchive must not be null");
+        return false;
+    }
+    DEV_CHECK_ERR(*ppDstArchive == nullptr, "*ppDstArchive must be null");
+
+    try
+    {
+        using ResourceType = DeviceObjectArchive::ResourceType;
+
+        DeviceObjectArchive ObjectArchive{DeviceObjectArchive::CreateInfo{pSrcArchive}};
+
+        static_assert(ARCHIVE_RESOURCE_TYPE_COUNT == 5, "Please handle the new resource type below");
+        for (Uint32 i = 0; i < NumResources; ++i)
+        {
+            const ArchiveResourceInfo& Res = pResources[i];
+            if (Res.Name == nullptr)
+            {
+                DEV_ERROR("Name of resource ", i, " must not be null");
+                return false;
+            }
+
+            switch (Res.Type)
+            {
+                case ARCHIVE_RESOURCE_TYPE_SHADER:
+                    ObjectArchive.RemoveResource(ResourceType::StandaloneShader, Res.Name);
+                    break;
+
+                case ARCHIVE_RESOURCE_TYPE_RESOURCE_SIGNATURE:
+                    ObjectArchive.RemoveResource(ResourceType::ResourceSignature, Res.Name);
+                    break;
+
+                case ARCHIVE_RESOURCE_TYPE_PIPELINE_STATE:
+                    // Pipeline names are unique across all pipeline types
+                    ObjectArchive.RemoveResource(ResourceType::GraphicsPipeline, Res.Name);
+                    ObjectArchive.RemoveResource(ResourceType::ComputePipeline, Res.Name);
+                    ObjectArchive.RemoveResource(ResourceType::RayTracingPipeline, Res.Name);
+                    ObjectArchive.RemoveResource(ResourceType::TilePipeline, Res.Name);
+                    break;
+
+                case ARCHIVE_RESOURCE_TYPE_RENDER_PASS:
+                    ObjectArchive.RemoveResource(ResourceType::RenderPass, Res.Name);
+                    break;
+
+                default:
+                    DEV_ERROR("Unexpected type (", Uint32{Res.Type}, ") of resource '", Res.Name, "'");
+                    return false;
+            }
+        }
+
+        ObjectArchive.CompactShaders();
+
+        ObjectArchive.Serialize(ppDstArchive);
+        return *ppDstArchive != nullptr;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
 Bool ArchiverFactoryImpl::MergeArchives(
     const IDataBlob* ppSrcArchives[],
     Uint32           NumSrcArchives,
@@ -28,8 +28,13 @@
 #include "Archiver_Inc.hpp"
 
 #include <vector>
+#include <algorithm>
+#include <cstring>
+
+#include "xxhash.h"
 
 #include "PSOSerializer.hpp"
+#include "ThreadPool.hpp"
 
 namespace Diligent
 {
@@ -69,6 +74,62 @@ ArchiverImpl::~ArchiverImpl()
 {
 }
 
+namespace
+{
+
+// 128-bit content hash of shader byte code
+struct BytecodeHash
+{
+    Uint64 LowPart  = 0;
+    Uint64 HighPart = 0;
+
+    constexpr bool operator==(const BytecodeHash& RHS) const noexcept
+    {
+        return LowPart == RHS.LowPart && HighPart == RHS.HighPart;
+    }
+
+    struct Hasher
+    {
+        size_t operator()(const BytecodeHash& Hash) const noexcept
+        {
+            return static_cast<size_t>(Hash.LowPart ^ Hash.HighPart);
+        }
+    };
+};
+
+BytecodeHash ComputeBytecodeHash(const SerializedData& Bytecode)
+{
+    const XXH128_hash_t Hash = XXH3_128bits(Bytecode.Ptr(), Bytecode.Size());
+    return BytecodeHash{Hash.low64, Hash.high64};
+}
+
+// Returns the map elements sorted by name, so that the objects are added to the archive in a deterministic order
+template <typename MapType, typename KeyLessType>
+std::vector<const typename MapType::value_type*> SortObjects(const MapType& Objects, KeyLessType&& KeyLess)
+{
+    std::vector<const typename MapType::value_type*> Sorted;
+    Sorted.reserve(Objects.size());
+    for (const auto& it : Objects)
+        Sorted.emplace_back(&it);
+
+    std::sort(Sorted.begin(), Sorted.end(),
+              [&KeyLess](const typename MapType::value_type* pLHS, const typename MapType::value_type* pRHS) {
+                  return KeyLess(pLHS->first, pRHS->first);
+              });
+    return Sorted;
+}
+
+template <typename MapType>
+std::vector<const typename MapType::value_type*> SortObjectsByName(const MapType& Objects)
+{
+    return SortObjects(Objects,
+                       [](const HashMapStringKey& LHS, const HashMapStringKey& RHS) {
+                           return strcmp(LHS.GetStr(), RHS.GetStr()) < 0;
+                       });
+}
+
+} // namespace
+
 Bool ArchiverImpl::SerializeToBlob(Uint32 ContentVersion, IDataBlob** ppBlob)
 {
     DEV_CHECK_ERR(ppBlob != nullptr, "ppBlob must not be null");
@@ -77,15 +138,43 @@ Bool ArchiverImpl::SerializeToBlob(Uint32 ContentVersion, IDataBlob** ppBlob)
 
     DeviceObjectArchive Archive{ContentVersion};
 
-    // A hash map that maps shader byte code to the index in the archive, for each device type
-    std::array<std::unordered_map<size_t, Uint32>, static_cast<size_t>(DeviceType::Count)> BytecodeHashToIdx;
+    // Shader byte code is hashed and device data is serialized in parallel, if the thread pool is available
+    IThreadPool* pThreadPool = m_pSerializationDevice->GetShaderCompilationThreadPool();
 
-    // Add pipelines and patched shaders
-    for (const auto& pso_it : m_Pipelines)
+    // Shader byte code that needs to be added to the archive for one device type
+    struct DeviceBytecode
     {
-        const char*                  Name    = pso_it.first.GetName();
-        const ResourceType           ResType = pso_it.first.GetType();
-        SerializedPipelineStateImpl& SrcPSO  = *pso_it.second;
+        struct PipelineShaders
+        {
+            ResourceData&                                                     DstData;
+            const std::vector<SerializedPipelineStateImpl::Data::ShaderInfo>& Shaders;
+        };
+        std::vector<PipelineShaders> Pipelines;
+
+        struct StandaloneShader
+        {
+            ResourceData&  DstData;
+            SerializedData Bytecode;
+        };
+        std::vector<StandaloneShader> Shaders;
+
+        // Offset of the first shader of this device in the AllBytecode array
+        size_t FirstBytecode = 0;
+    };
+    std::array<DeviceBytecode, static_cast<size_t>(DeviceType::Count)> DevicesBytecode;
+
+    // Add pipelines
+    const auto SortedPipelines = SortObjects(m_Pipelines,
+                                             [](const NamedResourceKey& LHS, const NamedResourceKey& RHS) {
+                                                 return LHS.GetType() != RHS.GetType() ?
+                                                     LHS.GetType() < RHS.GetType() :
+                                                     strcmp(LHS.GetName(), RHS.GetName()) < 0;
+                                             });
+    for (const auto* pso_it : SortedPipelines)
+    {
+        const char*                  Name    = pso_it->first.GetName();
+        const ResourceType           ResType = pso_it->first.GetType();
+        SerializedPipelineStateImpl& SrcPSO  = *pso_it->second;
 
         const PIPELINE_STATE_STATUS PSOStatus = SrcPSO.GetStatus(/*WaitForCompletion = */ true);
         if (PSOStatus != PIPELINE_STATE_STATUS_READY)
@@ -117,50 +206,19 @@ Bool ArchiverImpl::SerializeToBlob(Uint32 ContentVersion, IDataBlob** ppBlob)
         // NB: since the Archive object is temporary, we do not need to copy the data
         DstData.Common = SerializedData{SrcData.Common.Ptr(), SrcData.Common.Size()};
 
-        // Add shaders for each device type, if present
+        // Patched shaders for each device type are added below
         for (size_t device_type = 0; device_type < SrcData.Shaders.size(); ++device_type)
         {
-            const auto& SrcShaders = SrcData.Shaders[device_type];
-            if (SrcShaders.empty())
-                continue; // No shaders for this device type
-
-            auto& DstShaders = Archive.GetDeviceShaders(static_cast<DeviceType>(device_type));
-
-            std::vector<Uint32> ShaderIndices;
-            ShaderIndices.reserve(SrcShaders.size());
-            for (const SerializedPipelineStateImpl::Data::ShaderInfo& SrcShader : SrcShaders)
-            {
-                VERIFY_EXPR(SrcShader.Data);
-
-                auto it_inserted = BytecodeHashToIdx[device_type].emplace(SrcShader.Hash, StaticCast<Uint32>(DstShaders.size()));
-                if (it_inserted.second)
-                {
-                    // New byte code - add it
-                    DstShaders.emplace_back(SrcShader.Data.Ptr(), SrcShader.Data.Size());
-                }
-                ShaderIndices.emplace_back(it_inserted.first->second);
-            }
-
-            DeviceObjectArchive::ShaderIndexArray Indices{ShaderIndices.data(), StaticCast<Uint32>(ShaderIndices.size())};
-
-            // For pipelines, device-specific data is the shader indices
-            SerializedData& SerializedIndices = DstData.DeviceSpecific[device_type];
-
-            Serializer<SerializerMode::Measure> MeasureSer;
-            PSOSerializer<SerializerMode::Measure>::SerializeShaderIndices(MeasureSer, Indices, nullptr);
-            SerializedIndices = MeasureSer.AllocateData(GetRawAllocator());
-
-            Serializer<SerializerMode::Write> Ser{SerializedIndices};
-            PSOSerializer<SerializerMode::Write>::SerializeShaderIndices(Ser, Indices, nullptr);
-            VERIFY_EXPR(Ser.IsEnded());
+            if (!SrcData.Shaders[device_type].empty())
+                DevicesBytecode[device_type].Pipelines.emplace_back(DeviceBytecode::PipelineShaders{DstData, SrcData.Shaders[device_type]});
         }
     }
 
     // Add resource signatures
-    for (const auto& sign_it : m_Signatures)
+    for (const auto* sign_it : SortObjectsByName(m_Signatures))
     {
-        const char*                            Name    = sign_it.first.GetStr();
-        const SerializedResourceSignatureImpl& SrcSign = *sign_it.second;
+        const char*                            Name    = sign_it->first.GetStr();
+        const SerializedResourceSignatureImpl& SrcSign = *sign_it->second;
         VERIFY_EXPR(SafeStrEqual(Name, SrcSign.GetDesc().Name));
         const SerializedData& SrcCommonData = SrcSign.GetCommonData();
 
@@ -176,10 +234,10 @@ Bool ArchiverImpl::SerializeToBlob(Uint32 ContentVersion, IDataBlob** ppBlob)
     }
 
     // Add render passes
-    for (const auto& rp_it : m_RenderPasses)
+    for (const auto* rp_it : SortObjectsByName(m_RenderPasses))
     {
-        const char*                     Name  = rp_it.first.GetStr();
-        const SerializedRenderPassImpl& SrcRP = *rp_it.second;
+        const char*                     Name  = rp_it->first.GetStr();
+        const SerializedRenderPassImpl& SrcRP = *rp_it->second;
         VERIFY_EXPR(SafeStrEqual(Name, SrcRP.GetDesc().Name));
         const SerializedData& SrcData = SrcRP.GetCommonData();
 
@@ -188,10 +246,10 @@ Bool ArchiverImpl::SerializeToBlob(Uint32 ContentVersion, IDataBlob** ppBlob)
     }
 
     // Add standalone shaders
-    for (const auto& shader_it : m_Shaders)
+    for (const auto* shader_it : SortObjectsByName(m_Shaders))
     {
-        const char*           Name      = shader_it.first.GetStr();
-        SerializedShaderImpl& SrcShader = *shader_it.second;
+        const char*           Name      = shader_it->first.GetStr();
+        SerializedShaderImpl& SrcShader = *shader_it->second;
         {
             const SHADER_STATUS Status = SrcShader.GetStatus(/*WaitForCompletion = */ true);
             if (Status != SHADER_STATUS_READY)
@@ -210,20 +268,94 @@ Bool ArchiverImpl::SerializeToBlob(Uint32 ContentVersion, IDataBlob** ppBlob)
         for (size_t device_type = 0; device_type < static_cast<size_t>(DeviceType::Count); ++device_type)
         {
             SerializedData DeviceData = SrcShader.GetDeviceData(static_cast<DeviceType>(device_type));
-            if (!DeviceData)
-                continue;
+            if (DeviceData)
+                DevicesBytecode[device_type].Shaders.emplace_back(DeviceBytecode::StandaloneShader{DstData, std::move(DeviceData)});
+        }
+    }
+
+    // Hash all shader byte code in parallel
+    std::vector<const SerializedData*> AllBytecode;
+    for (DeviceBytecode& Device : DevicesBytecode)
+    {
+        Device.FirstBytecode = AllBytecode.size();
+        for (const DeviceBytecode::PipelineShaders& Pipeline : Device.Pipelines)
+        {
+            for (const SerializedPipelineStateImpl::Data::ShaderInfo& SrcShader : Pipeline.Shaders)
+            {
+                VERIFY_EXPR(SrcShader.Data);
+                AllBytecode.emplace_back(&SrcShader.Data);
+            }
+        }
+        for (const DeviceBytecode::StandaloneShader& Shader : Device.Shaders)
+            AllBytecode.emplace_back(&Shader.Bytecode);
+    }
+
+    std::vector<BytecodeHash> BytecodeHashes(AllBytecode.size());
+    ProcessRangeInParallel(pThreadPool, StaticCast<Uint32>(AllBytecode.size()), 16,
+                           [&](Uint32 Start, Uint32 End) {
+                               for (Uint32 i = Start; i < End; ++i)
+                                   BytecodeHashes[i] = ComputeBytecodeHash(*AllBytecode[i]);
+                           });
+
+    // Deduplicates the byte code and serializes shader indices for one device type
+    auto SerializeDeviceShaders = [&](size_t device_type) {
+        DeviceBytecode& Device = DevicesBytecode[device_type];
+        if (Device.Pipelines.empty() && Device.Shaders.empty())
+            return;
+
+        std::vector<SerializedData>& DstShaders = Archive.GetDeviceShaders(static_cast<DeviceType>(device_type));
 
-            auto& DstShaders  = Archive.GetDeviceShaders(static_cast<DeviceType>(device_type));
-            auto  it_inserted = BytecodeHashToIdx[device_type].emplace(DeviceData.GetHash(), StaticCast<Uint32>(DstShaders.size()));
-            if (it_inserted.second)
+        // Indices of the shaders in DstShaders with the given hash. Byte code is compared on
+        // collision, so that different shaders are never merged.
+        std::unordered_map<BytecodeHash, std::vector<Uint32>, BytecodeHash::Hasher> HashToIndices;
+
+        size_t BytecodeIdx = Device.FirstBytecode;
+
+        auto FindOrAddBytecode = [&](SerializedData&& Bytecode) {
+            std::vector<Uint32>& Candidates = HashToIndices[BytecodeHashes[BytecodeIdx++]];
+            for (Uint32 Idx : Candidates)
+            {
+                if (DstShaders[Idx] == Bytecode)
+                    return Idx;
+            }
+
+            // New byte code - add it
+            const Uint32 Idx = StaticCast<Uint32>(DstShaders.size());
+            DstShaders.emplace_back(std::move(Bytecode));
+            Candidates.push_back(Idx);
+            return Idx;
+        };
+
+        for (const DeviceBytecode::PipelineShaders& Pipeline : Device.Pipelines)
+        {
+            std::vector<Uint32> ShaderIndices;
+            ShaderIndices.reserve(Pipeline.Shaders.size());
+            for (const SerializedPipelineStateImpl::Data::ShaderInfo& SrcShader : Pipeline.Shaders)
             {
-                // New byte code
-                DstShaders.emplace_back(std::move(DeviceData));
+                // NB: since the Archive object is temporary, we do not need to copy the data
+                ShaderIndices.emplace_back(FindOrAddBytecode(SerializedData{SrcShader.Data.Ptr(), SrcShader.Data.Size()}));
             }
-            const Uint32 Index = it_inserted.first->second;
+
+            DeviceObjectArchive::ShaderIndexArray Indices{ShaderIndices.data(), StaticCast<Uint32>(ShaderIndices.size())};
+
+            // For pipelines, device-specific data is the shader indices
+            SerializedData& SerializedIndices = Pipeline.DstData.DeviceSpecific[device_type];
+
+            Serializer<SerializerMode::Measure> MeasureSer;
+            PSOSerializer<SerializerMode::Measure>::SerializeShaderIndices(MeasureSer, Indices, nullptr);
+            SerializedIndices = MeasureSer.AllocateData(GetRawAllocator());
+
+            Serializer<SerializerMode::Write> Ser{SerializedIndices};
+            PSOSerializer<SerializerMode::Write>::SerializeShaderIndices(Ser, Indices, nullptr);
+            VERIFY_EXPR(Ser.IsEnded());
+        }
+
+        for (DeviceBytecode::StandaloneShader& Shader : Device.Shaders)
+        {
+            const Uint32 Index = FindOrAddBytecode(std::move(Shader.Bytecode));
 
             // For shaders, device-specific data is the serialized shader bytecode index
-            SerializedData& SerializedIndex = DstData.DeviceSpecific[device_type];
+            SerializedData& SerializedIndex = Shader.DstData.DeviceSpecific[device_type];
 
             Serializer<SerializerMode::Measure> MeasureSer;
             MeasureSer(Index);
@@ -233,14 +365,26 @@ Bool ArchiverImpl::SerializeToBlob(Uint32 ContentVersion, IDataBlob** ppBlob)
             Ser(Index);
             VERIFY_EXPR(Ser.IsEnded());
         }
-    }
+    };
 
-    Archive.Serialize(ppBlob);
+    // GetDeviceShaders() requires the compressed shaders to be released. Do this before
+    // the parallel region, as releasing them modifies the shaders of all device types.
+    Archive.ReleaseCompressedShaders();
+
+    // Every device type only writes its own shader list and device-specific data, so devices are processed in parallel
+    ProcessRangeInParallel(pThreadPool, static_cast<Uint32>(DeviceType::Count), 1,
+                           [&](Uint32 Start, Uint32 End) {
+                               for (Uint32 device_type = Start; device_type < End; ++device_type)
+                                   SerializeDeviceShaders(device_type);
+                           });
+
+    DeviceObjectArchive::SerializeAttribs SerializeAttribs = m_SerializeAttribs;
+    SerializeAttribs.pThreadPool                           = pThreadPool;
+    Archive.Serialize(ppBlob, SerializeAttribs);
 
     return *ppBlob != nullptr;
 }
 
-
 Bool ArchiverImpl::SerializeToStream(Uint32 ContentVersion, IFileStream* pStream)
 {
     DEV_CHECK_ERR(pStream != nullptr, "pStream must not be null");
@@ -372,6 +516,8 @@ void ArchiverImpl::Reset()
         std::lock_guard<std::mutex> Guard{m_ShadersMtx};
         m_Shaders.clear();
     }
+
+    m_SerializeAttribs = {};
 }
 
 IShader* ArchiverImpl::GetShader(const char* Name)
@@ -431,4 +577,25 @@ IPipelineResourceSignature* ArchiverImpl::GetPipelineResourceSignature(const cha
     return it != m_Signatures.end() ? it->second.RawPtr() : nullptr;
 }
 
+void ArchiverImpl::SetShaderCompression(ARCHIVE_SHADER_COMPRESSION Compression,
+                                        Uint32                     BlockSize)
+{
+    static_assert(ARCHIVE_SHADER_COMPRESSION_COUNT == 2, "Please handle the new compression mode below");
+    switch (Compression)
+    {
+        case ARCHIVE_SHADER_COMPRESSION_NONE:
+            m_SerializeAttribs.Compression = DeviceObjectArchive::ShaderCompression::None;
+            break;
+
+        case ARCHIVE_SHADER_COMPRESSION_LZ4:
+            m_SerializeAttribs.Compression = DeviceObjectArchive::ShaderCompression::LZ4;
+            break;
+
+        default:
+            DEV_ERROR("Unknown shader compression: ", static_cast<Uint32>(Compression));
+            return;
+    }
+    m_SerializeAttribs.ShaderBlockSize = BlockSize;
+}
+
 } // namespace Diligent
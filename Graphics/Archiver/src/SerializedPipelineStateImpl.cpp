@@ -447,10 +447,9 @@ void SerializedPipelineStateImpl::SerializeShaderCreateInfo(DeviceType
     Data::ShaderInfo ShaderData;
     ShaderData.Data  = SerializedShaderImpl::SerializeCreateInfo(CI);
     ShaderData.Stage = CI.Desc.ShaderType;
-    ShaderData.Hash  = ShaderData.Data.GetHash();
 #ifdef DILIGENT_DEBUG
     for (const SerializedPipelineStateImpl::Data::ShaderInfo& Data : m_Data.Shaders[static_cast<size_t>(Type)])
-        VERIFY(Data.Hash != ShaderData.Hash, "Shader with the same hash is already in the list.");
+        VERIFY(Data.Data != ShaderData.Data, "The same shader is already in the list.");
 #endif
     m_Data.Shaders[static_cast<size_t>(Type)].emplace_back(std::move(ShaderData));
 }
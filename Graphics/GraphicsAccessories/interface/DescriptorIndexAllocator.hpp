@@ -0,0 +1,186 @@
+/*
+ *  Copyright 2019-2025 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of Diligent::DescriptorIndexAllocator class
+
+#include <mutex>
+#include <vector>
+#include <deque>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Allocates stable indices in a bindless resource array (for example, a shader resource
+/// variable that uses PIPELINE_RESOURCE_FLAG_UPDATE_AFTER_BIND flag).
+///
+/// An index that is released may still be accessed by the GPU, so it is not reused until
+/// the fence value passed to Release() has been completed. The class is thread-safe.
+///
+///     Uint32 Idx = IdxAllocator.Allocate();
+///     pVar->SetArray(&pView, Idx, 1, SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE);
+///     ...
+///     IdxAllocator.Release(Idx, NextFenceValue);
+///     ...
+///     IdxAllocator.ReleaseCompleted(pFence->GetCompletedValue());
+///
+class DescriptorIndexAllocator
+{
+public:
+    static constexpr Uint32 InvalidIndex = ~Uint32{0};
+
+    explicit DescriptorIndexAllocator(Uint32 Capacity) :
+        m_Capacity{Capacity},
+        m_IsAllocated(Capacity)
+    {}
+
+    // clang-format off
+    DescriptorIndexAllocator           (const DescriptorIndexAllocator&) = delete;
+    DescriptorIndexAllocator& operator=(const DescriptorIndexAllocator&) = delete;
+    DescriptorIndexAllocator           (DescriptorIndexAllocator&&)      = delete;
+    DescriptorIndexAllocator& operator=(DescriptorIndexAllocator&&)      = delete;
+    // clang-format on
+
+    ~DescriptorIndexAllocator()
+    {
+        DEV_CHECK_ERR(GetAllocatedCount() == 0, GetAllocatedCount(), " descriptor index(es) have not been released");
+    }
+
+    /// Allocates an index. Returns InvalidIndex if all indices are in use.
+    Uint32 Allocate()
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        Uint32 Index = InvalidIndex;
+        if (!m_FreeIndices.empty())
+        {
+            Index = m_FreeIndices.back();
+            m_FreeIndices.pop_back();
+        }
+        else if (m_NextUnusedIndex < m_Capacity)
+        {
+            Index = m_NextUnusedIndex++;
+        }
+        else
+        {
+            return InvalidIndex;
+        }
+
+        VERIFY(!m_IsAllocated[Index], "Index ", Index, " is already allocated");
+        m_IsAllocated[Index] = true;
+        ++m_AllocatedCount;
+        return Index;
+    }
+
+    /// Releases the index. The index will be reused after the fence value
+    /// has been completed, see ReleaseCompleted().
+    ///
+    /// \note Fence values must not decrease between calls.
+    void Release(Uint32 Index, Uint64 FenceValue)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        VERIFY(Index < m_NextUnusedIndex, "Index ", Index, " has never been allocated");
+        VERIFY(m_AllocatedCount > 0, "There are no allocated indices");
+        const bool IsAllocated = Index < m_Capacity && m_IsAllocated[Index];
+        VERIFY(IsAllocated, "Index ", Index, " has already been released");
+        if (!IsAllocated)
+            return;
+        DEV_CHECK_ERR(m_StaleIndices.empty() || m_StaleIndices.back().FenceValue <= FenceValue,
+                      "Fence value (", FenceValue, ") is less than the fence value of the previously released index (",
+                      m_StaleIndices.back().FenceValue, ")");
+
+        m_IsAllocated[Index] = false;
+        m_StaleIndices.emplace_back(FenceValue, Index);
+        --m_AllocatedCount;
+    }
+
+    /// Makes all indices released with fence values less than or equal to
+    /// CompletedFenceValue available for allocation.
+    void ReleaseCompleted(Uint64 CompletedFenceValue)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        while (!m_StaleIndices.empty() && m_StaleIndices.front().FenceValue <= CompletedFenceValue)
+        {
+            m_FreeIndices.push_back(m_StaleIndices.front().Index);
+            m_StaleIndices.pop_front();
+        }
+    }
+
+    Uint32 GetCapacity() const
+    {
+        return m_Capacity;
+    }
+
+    /// Returns the number of indices that have been allocated and not yet released.
+    Uint32 GetAllocatedCount() const
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return m_AllocatedCount;
+    }
+
+    /// Returns the number of released indices that are waiting for the GPU.
+    size_t GetStaleCount() const
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return m_StaleIndices.size();
+    }
+
+private:
+    struct StaleIndex
+    {
+        StaleIndex(Uint64 _FenceValue, Uint32 _Index) noexcept :
+            FenceValue{_FenceValue},
+            Index{_Index}
+        {}
+
+        Uint64 FenceValue;
+        Uint32 Index;
+    };
+
+    const Uint32 m_Capacity;
+
+    mutable std::mutex m_Mtx;
+
+    // Indices in range [m_NextUnusedIndex, m_Capacity) have never been allocated
+    Uint32 m_NextUnusedIndex = 0;
+    Uint32 m_AllocatedCount  = 0;
+
+    // Flags of the indices that are currently allocated, used to detect double release
+    std::vector<bool> m_IsAllocated;
+
+    std::vector<Uint32>    m_FreeIndices;
+    std::deque<StaleIndex> m_StaleIndices;
+};
+
+} // namespace Diligent
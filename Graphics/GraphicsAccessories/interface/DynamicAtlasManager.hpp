@@ -33,6 +33,7 @@
 
 #include <map>
 #include <unordered_map>
+#include <vector>
 
 #include "../../../Primitives/interface/BasicTypes.h"
 #include "../../../Common/interface/HashUtils.hpp"
@@ -47,11 +48,26 @@ namespace Diligent
 /// Region structure, which contains the x and y coordinates of the top-left
 /// corner, as well as the width and height of the region.
 ///
+/// The atlas supports two packing modes, see DynamicAtlasManager::PackingMode.
+///
 /// \warning The class is not thread-safe. All operations on the atlas must be
 ///          must be protected by a mutex or other synchronization mechanism.
 class DynamicAtlasManager
 {
 public:
+    /// Packing mode
+    enum class PackingMode : Uint8
+    {
+        /// Free regions are recursively split to allocate new regions and are merged back
+        /// when the regions are freed, so that all freed space is reused.
+        Tree = 0,
+
+        /// Regions are placed as low as possible on top of the skyline formed by the
+        /// allocated regions. Allocation is cheaper than in the tree mode, but the space
+        /// freed underneath other regions can only be reclaimed by Defragment().
+        Skyline
+    };
+
     /// Structure representing a rectangular region in the atlas.
     struct Region
     {
@@ -114,7 +130,17 @@ public:
         };
     };
 
-    DynamicAtlasManager(Uint32 Width, Uint32 Height);
+    /// Region move performed by Defragment()
+    struct RegionMove
+    {
+        /// The region that was freed
+        Region Src;
+
+        /// The region that was allocated instead
+        Region Dst;
+    };
+
+    DynamicAtlasManager(Uint32 Width, Uint32 Height, PackingMode Mode = PackingMode::Tree);
     ~DynamicAtlasManager();
 
     // clang-format off
@@ -141,13 +167,44 @@ public:
     void Free(Region&& R);
 
 
+    /// Incrementally defragments the atlas.
+
+    /// \param MaxMoves - The maximum number of regions to move.
+    /// \param Moves    - Vector to which the performed moves are appended.
+    /// \return           The number of performed moves. Zero indicates that no region
+    ///                   can be moved any lower.
+    ///
+    /// The method moves the regions closest to the top of the atlas to lower
+    /// locations. For every move, the source region is freed and the destination region
+    /// is allocated, so the caller must replace the source region with the destination.
+    ///
+    /// The destination of a move never overlaps the source of any later move, but it may
+    /// overlap the sources of earlier moves. The moves must thus be applied in the order
+    /// they are returned. In skyline mode, the destination may also overlap the source
+    /// of the same move.
+    Uint32 Defragment(Uint32 MaxMoves, std::vector<RegionMove>& Moves);
+
+
     /// Returns the number of free regions in the atlas.
+    ///
+    /// In skyline mode, this is the number of skyline segments below the top of the atlas.
     Uint32 GetFreeRegionCount() const
     {
+        if (m_Mode == PackingMode::Skyline)
+        {
+            Uint32 Count = 0;
+            for (const SkylineSegment& Seg : m_Skyline)
+                Count += Seg.y < m_Height ? 1 : 0;
+            return Count;
+        }
+
         VERIFY_EXPR(m_FreeRegionsByWidth.size() == m_FreeRegionsByHeight.size());
         return static_cast<Uint32>(m_FreeRegionsByWidth.size());
     }
 
+    /// Returns the packing mode.
+    PackingMode GetPackingMode() const { return m_Mode; }
+
     /// Returns the atlas width.
     Uint32 GetWidth() const { return m_Width; }
 
@@ -206,8 +263,17 @@ private:
     void DbgRecursiveVerifyConsistency(const Node& N, Uint32& Area) const;
 #endif
 
-    const Uint32 m_Width;
-    const Uint32 m_Height;
+    Region AllocateSkyline(Uint32 Width, Uint32 Height);
+    void   FreeSkyline(const Region& R);
+    void   SetSkylineHeight(Uint32 x, Uint32 Width, Uint32 Height);
+    bool   FindSkylinePosition(Uint32 Width, Uint32 Height, Uint32& x, Uint32& y) const;
+    Uint32 DefragmentSkyline(Uint32 MaxMoves, std::vector<RegionMove>& Moves);
+
+    std::vector<Region> GetDefragmentationCandidates() const;
+
+    const Uint32      m_Width;
+    const Uint32      m_Height;
+    const PackingMode m_Mode;
 
     Uint64 m_TotalFreeArea = 0;
 
@@ -267,8 +333,19 @@ private:
     std::map<Region, Node*, WidthFirstCompare> m_FreeRegionsByWidth;
     // Free regions ordered by height->width->y->x
     std::map<Region, Node*, HeightFirstCompare> m_FreeRegionsByHeight;
-    // Allocated regions
+    // Allocated regions. In skyline mode, node pointers are null.
     std::unordered_map<Region, Node*, Region::Hasher> m_AllocatedRegions;
+
+    // Horizontal segment of the skyline. Everything above y is free.
+    struct SkylineSegment
+    {
+        Uint32 x;
+        Uint32 y;
+        Uint32 width;
+    };
+    // Skyline segments sorted by x that cover the entire atlas width.
+    // Adjacent segments always have different heights.
+    std::vector<SkylineSegment> m_Skyline;
 };
 
 } // namespace Diligent
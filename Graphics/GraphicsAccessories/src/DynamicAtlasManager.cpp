@@ -28,6 +28,7 @@
 #include "DynamicAtlasManager.hpp"
 
 #include <climits>
+#include <algorithm>
 
 #include "AdvancedMath.hpp"
 
@@ -110,13 +111,22 @@ void DynamicAtlasManager::Node::MergeChildren()
 }
 
 
-DynamicAtlasManager::DynamicAtlasManager(Uint32 Width, Uint32 Height) :
+DynamicAtlasManager::DynamicAtlasManager(Uint32 Width, Uint32 Height, PackingMode Mode) :
     m_Width{Width},
     m_Height{Height},
+    m_Mode{Mode},
     m_TotalFreeArea{Uint64{Width} * Uint64{Height}}
 {
-    m_Root->R = Region{0, 0, Width, Height};
-    RegisterNode(*m_Root);
+    if (m_Mode == PackingMode::Skyline)
+    {
+        m_Root.reset();
+        m_Skyline.push_back({0, 0, Width});
+    }
+    else
+    {
+        m_Root->R = Region{0, 0, Width, Height};
+        RegisterNode(*m_Root);
+    }
 }
 
 
@@ -135,9 +145,15 @@ DynamicAtlasManager::~DynamicAtlasManager()
     }
     else
     {
+        // Skyline mode or moved-from object
+#if DILIGENT_DEBUG
+        if (!m_Skyline.empty())
+            DbgVerifyConsistency();
+#endif
+
         VERIFY_EXPR(m_FreeRegionsByWidth.empty());
         VERIFY_EXPR(m_FreeRegionsByHeight.empty());
-        VERIFY_EXPR(m_AllocatedRegions.empty());
+        DEV_CHECK_ERR(m_AllocatedRegions.empty(), "There must be no allocated regions");
     }
 }
 
@@ -184,6 +200,9 @@ void DynamicAtlasManager::UnregisterNode(const Node& N)
 
 DynamicAtlasManager::Region DynamicAtlasManager::Allocate(Uint32 Width, Uint32 Height)
 {
+    if (m_Mode == PackingMode::Skyline)
+        return AllocateSkyline(Width, Height);
+
     auto it_w = m_FreeRegionsByWidth.lower_bound(Region{0, 0, Width, 0});
     while (it_w != m_FreeRegionsByWidth.end() && it_w->first.height < Height)
         ++it_w;
@@ -340,6 +359,22 @@ void DynamicAtlasManager::Free(Region&& R)
         return;
     }
 
+    if (m_Mode == PackingMode::Skyline)
+    {
+        VERIFY_EXPR(node_it->second == nullptr);
+        m_AllocatedRegions.erase(node_it);
+        FreeSkyline(R);
+
+        m_TotalFreeArea += Uint64{R.width} * Uint64{R.height};
+
+#if DILIGENT_DEBUG
+        DbgVerifyConsistency();
+#endif
+
+        R = InvalidRegion;
+        return;
+    }
+
     VERIFY_EXPR(node_it->first == R && node_it->second->R == R);
     Node* N = node_it->second;
     VERIFY_EXPR(N->IsAllocated && !N->HasChildren());
@@ -370,6 +405,267 @@ void DynamicAtlasManager::Free(Region&& R)
 }
 
 
+void DynamicAtlasManager::SetSkylineHeight(Uint32 x, Uint32 Width, Uint32 Height)
+{
+    VERIFY_EXPR(Width > 0 && x + Width <= m_Width);
+    const Uint32 End = x + Width;
+
+    // Find the segments [First, Last) that overlap [x, End)
+    auto First = std::upper_bound(m_Skyline.begin(), m_Skyline.end(), x,
+                                  [](Uint32 _x, const SkylineSegment& Seg) {
+                                      return _x < Seg.x + Seg.width;
+                                  });
+    auto Last  = std::lower_bound(First, m_Skyline.end(), End,
+                                 [](const SkylineSegment& Seg, Uint32 _End) {
+                                     return Seg.x < _End;
+                                 });
+    VERIFY_EXPR(First < Last);
+
+    const SkylineSegment Head = *First;
+    const SkylineSegment Tail = *(Last - 1);
+
+    // The overlapped segments are replaced with up to three new segments
+    SkylineSegment NewSegments[3];
+    size_t         NumNewSegments = 0;
+    if (Head.x < x)
+        NewSegments[NumNewSegments++] = {Head.x, Head.y, x - Head.x};
+    NewSegments[NumNewSegments++] = {x, Height, Width};
+    if (Tail.x + Tail.width > End)
+        NewSegments[NumNewSegments++] = {End, Tail.y, Tail.x + Tail.width - End};
+
+    const size_t Pos            = static_cast<size_t>(First - m_Skyline.begin());
+    const size_t NumOldSegments = static_cast<size_t>(Last - First);
+    if (NumOldSegments > NumNewSegments)
+        m_Skyline.erase(m_Skyline.begin() + Pos + NumNewSegments, m_Skyline.begin() + Pos + NumOldSegments);
+    else if (NumOldSegments < NumNewSegments)
+        m_Skyline.insert(m_Skyline.begin() + Pos + NumOldSegments, NumNewSegments - NumOldSegments, SkylineSegment{});
+    std::copy(NewSegments, NewSegments + NumNewSegments, m_Skyline.begin() + Pos);
+
+    // Merge adjacent segments of the same height
+    for (size_t i = Pos > 0 ? Pos - 1 : 0; i + 1 < m_Skyline.size() && i <= Pos + NumNewSegments;)
+    {
+        if (m_Skyline[i].y == m_Skyline[i + 1].y)
+        {
+            m_Skyline[i].width += m_Skyline[i + 1].width;
+            m_Skyline.erase(m_Skyline.begin() + i + 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+
+bool DynamicAtlasManager::FindSkylinePosition(Uint32 Width, Uint32 Height, Uint32& x, Uint32& y) const
+{
+    if (Width == 0 || Height == 0 || Width > m_Width || Height > m_Height)
+        return false;
+
+    // Bottom-left placement: the region is placed as low as possible and,
+    // among equally low locations, as far left as possible.
+    size_t BestSegment = m_Skyline.size();
+    Uint32 BestY       = m_Height - Height + 1;
+    for (size_t i = 0; i < m_Skyline.size() && m_Skyline[i].x + Width <= m_Width; ++i)
+    {
+        // The region rests on the highest segment it spans
+        Uint32 SegY = m_Skyline[i].y;
+        for (size_t j = i + 1; j < m_Skyline.size() && m_Skyline[j].x < m_Skyline[i].x + Width && SegY < BestY; ++j)
+            SegY = std::max(SegY, m_Skyline[j].y);
+
+        if (SegY < BestY)
+        {
+            BestSegment = i;
+            BestY       = SegY;
+        }
+    }
+    if (BestSegment == m_Skyline.size())
+        return false;
+
+    x = m_Skyline[BestSegment].x;
+    y = BestY;
+    return true;
+}
+
+
+DynamicAtlasManager::Region DynamicAtlasManager::AllocateSkyline(Uint32 Width, Uint32 Height)
+{
+    Region R{0, 0, Width, Height};
+    if (!FindSkylinePosition(Width, Height, R.x, R.y))
+        return Region{};
+
+    SetSkylineHeight(R.x, R.width, R.y + R.height);
+    m_AllocatedRegions.emplace(R, nullptr);
+
+    VERIFY_EXPR(m_TotalFreeArea >= Uint64{R.width} * Uint64{R.height});
+    m_TotalFreeArea -= Uint64{R.width} * Uint64{R.height};
+
+#if DILIGENT_DEBUG
+    DbgVerifyConsistency();
+#endif
+
+    return R;
+}
+
+
+void DynamicAtlasManager::FreeSkyline(const Region& R)
+{
+    const Uint32 End = R.x + R.width;
+    const Uint32 Top = R.y + R.height;
+
+    // If there are other regions above the freed region in every column it spans,
+    // the skyline does not change. The space will be reclaimed when these regions
+    // are freed or moved by Defragment().
+    bool IsCovered = true;
+    for (const SkylineSegment& Seg : m_Skyline)
+    {
+        if (Seg.x >= End)
+            break;
+        if (Seg.x + Seg.width > R.x && Seg.y <= Top)
+        {
+            VERIFY(Seg.y == Top, "Skyline is below the top of an allocated region");
+            IsCovered = false;
+            break;
+        }
+    }
+    if (IsCovered)
+        return;
+
+    // Recompute the skyline in the columns spanned by the freed region from the remaining regions
+    std::vector<Region> Regions;
+    std::vector<Uint32> Bounds{R.x, End};
+    for (const auto& it : m_AllocatedRegions)
+    {
+        const Region& A = it.first;
+        if (A.x < End && A.x + A.width > R.x)
+        {
+            Regions.push_back(A);
+            if (A.x > R.x)
+                Bounds.push_back(A.x);
+            if (A.x + A.width < End)
+                Bounds.push_back(A.x + A.width);
+        }
+    }
+    std::sort(Bounds.begin(), Bounds.end());
+    Bounds.erase(std::unique(Bounds.begin(), Bounds.end()), Bounds.end());
+
+    // Every region that overlaps an interval between two consecutive bounds covers it entirely
+    for (size_t i = 0; i + 1 < Bounds.size(); ++i)
+    {
+        Uint32 Height = 0;
+        for (const Region& A : Regions)
+        {
+            if (A.x <= Bounds[i] && A.x + A.width >= Bounds[i + 1])
+                Height = std::max(Height, A.y + A.height);
+        }
+        SetSkylineHeight(Bounds[i], Bounds[i + 1] - Bounds[i], Height);
+    }
+}
+
+
+std::vector<DynamicAtlasManager::Region> DynamicAtlasManager::GetDefragmentationCandidates() const
+{
+    // Process the regions closest to the top of the atlas first
+    std::vector<Region> Candidates;
+    Candidates.reserve(m_AllocatedRegions.size());
+    for (const auto& it : m_AllocatedRegions)
+        Candidates.push_back(it.first);
+    std::sort(Candidates.begin(), Candidates.end(),
+              [](const Region& R0, const Region& R1) {
+                  const Uint32 Top0 = R0.y + R0.height;
+                  const Uint32 Top1 = R1.y + R1.height;
+                  if (Top0 != Top1)
+                      return Top0 > Top1;
+                  if (R0.x != R1.x)
+                      return R0.x < R1.x;
+                  if (R0.y != R1.y)
+                      return R0.y < R1.y;
+                  return R0.width < R1.width;
+              });
+    return Candidates;
+}
+
+
+Uint32 DynamicAtlasManager::Defragment(Uint32 MaxMoves, std::vector<RegionMove>& Moves)
+{
+    if (m_Mode == PackingMode::Skyline)
+        return DefragmentSkyline(MaxMoves, Moves);
+
+    std::vector<Region> Candidates = GetDefragmentationCandidates();
+
+    Uint32 NumMoves = 0;
+    for (Region& Src : Candidates)
+    {
+        if (NumMoves >= MaxMoves)
+            break;
+
+        // Allocate the new region while the source region is still allocated, so that
+        // the destination never overlaps the source of this or any later move.
+        // Freed space is merged in the tree, so no space is lost this way.
+        Region Dst = Allocate(Src.width, Src.height);
+        if (Dst.IsEmpty())
+            continue;
+
+        if (Dst.y + Dst.height < Src.y + Src.height)
+        {
+            Moves.push_back({Src, Dst});
+            Free(std::move(Src));
+            ++NumMoves;
+        }
+        else
+        {
+            Free(std::move(Dst));
+        }
+    }
+
+    return NumMoves;
+}
+
+
+Uint32 DynamicAtlasManager::DefragmentSkyline(Uint32 MaxMoves, std::vector<RegionMove>& Moves)
+{
+    const std::vector<Region> Candidates = GetDefragmentationCandidates();
+
+    std::vector<SkylineSegment> PrevSkyline;
+
+    Uint32 NumMoves = 0;
+    for (const Region& Src : Candidates)
+    {
+        if (NumMoves >= MaxMoves)
+            break;
+
+        // Remove the source region before looking for the new location. If the region is the
+        // topmost one in its columns, the skyline drops to the regions underneath, so that
+        // the holes below it can be reclaimed. The destination may overlap the source, but
+        // never the sources of later moves, which are still allocated.
+        PrevSkyline = m_Skyline;
+        m_AllocatedRegions.erase(Src);
+        FreeSkyline(Src);
+
+        Region Dst{0, 0, Src.width, Src.height};
+        if (FindSkylinePosition(Dst.width, Dst.height, Dst.x, Dst.y) && Dst.y + Dst.height < Src.y + Src.height)
+        {
+            SetSkylineHeight(Dst.x, Dst.width, Dst.y + Dst.height);
+            m_AllocatedRegions.emplace(Dst, nullptr);
+            Moves.push_back({Src, Dst});
+            ++NumMoves;
+        }
+        else
+        {
+            // The region can't be moved any lower - put it back
+            m_Skyline.swap(PrevSkyline);
+            m_AllocatedRegions.emplace(Src, nullptr);
+        }
+    }
+
+#if DILIGENT_DEBUG
+    DbgVerifyConsistency();
+#endif
+
+    return NumMoves;
+}
+
+
 #if DILIGENT_DEBUG
 
 void DynamicAtlasManager::DbgVerifyRegion(const Region& R) const
@@ -419,6 +715,30 @@ void DynamicAtlasManager::DbgRecursiveVerifyConsistency(const Node& N, Uint32& A
 
 void DynamicAtlasManager::DbgVerifyConsistency() const
 {
+    if (m_Mode == PackingMode::Skyline)
+    {
+        VERIFY(!m_Skyline.empty() && m_Skyline.front().x == 0, "Skyline must start at the left atlas boundary");
+        Uint64 FreeArea = 0;
+        for (size_t i = 0; i < m_Skyline.size(); ++i)
+        {
+            const SkylineSegment& Seg = m_Skyline[i];
+            VERIFY(Seg.width > 0, "Skyline segment must not be empty");
+            VERIFY(Seg.y <= m_Height, "Skyline segment height (", Seg.y, ") exceeds atlas height (", m_Height, ").");
+            VERIFY(i + 1 == m_Skyline.size() || m_Skyline[i + 1].x == Seg.x + Seg.width, "Skyline segments must be contiguous");
+            VERIFY(i + 1 == m_Skyline.size() || m_Skyline[i + 1].y != Seg.y, "Adjacent skyline segments must have different heights");
+            FreeArea += Uint64{Seg.width} * Uint64{m_Height - Seg.y};
+        }
+        VERIFY(m_Skyline.back().x + m_Skyline.back().width == m_Width, "Skyline must end at the right atlas boundary");
+
+        Uint64 AllocatedArea = 0;
+        for (const auto& it : m_AllocatedRegions)
+            AllocatedArea += Uint64{it.first.width} * Uint64{it.first.height};
+        VERIFY_EXPR(AllocatedArea + m_TotalFreeArea == Uint64{m_Width} * Uint64{m_Height});
+        // Free area below the skyline is not accounted for
+        VERIFY_EXPR(FreeArea <= m_TotalFreeArea);
+        return;
+    }
+
     VERIFY_EXPR(m_FreeRegionsByWidth.size() == m_FreeRegionsByHeight.size());
     Uint32 Area = 0;
 
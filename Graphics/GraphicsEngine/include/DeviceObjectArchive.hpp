@@ -32,6 +32,8 @@
 #include <array>
 #include <vector>
 #include <unordered_map>
+#include <memory>
+#include <mutex>
 
 #include "GraphicsTypes.h"
 #include "FileStream.h"
@@ -52,6 +54,9 @@
 //
 //     |  Shader Data  | =  |  OpenGL shaders | D3D11 shaders | ...  | Metal-iOS shaders |
 //
+//         | Device shaders | = | Compression | Num shaders | Shader 0 | Shader 1 | ... |                      (uncompressed)
+//         | Device shaders | = | Compression | Num shaders | Num blocks | Block index | Block 0 | Block 1 | ... | (compressed)
+//
 // The header contains general information such as:
 // - Magic number
 // - Archive version
@@ -75,10 +80,22 @@
 //                                                                 |               |
 //                                                                 V               V
 // | GL Shader 0 | GL Shader 1 |  ... | D3D11 Shader 0 | D3D11 Shader 1 | D3D11 Shader 2 | ...
+//
+//
+// Compressed shaders are packed into blocks that are compressed independently. The block index
+// stores the block, the offset within the uncompressed block and the size of every shader, so that
+// only the blocks that contain the requested shaders need to be decompressed:
+//
+// | Block index | = | Shader 0 location | Shader 1 location | ... |       | Block I | = | Uncompressed size | Compressed data |
+//                      {Block, Offset, Size}
+//
+// A block whose compressed data size is equal to the uncompressed size is stored uncompressed.
 
 namespace Diligent
 {
 
+struct IThreadPool;
+
 /// Device object archive object.
 class DeviceObjectArchive
 {
@@ -127,8 +144,22 @@ public:
         Count
     };
 
+    // Shader data compression.
+    enum class ShaderCompression : Uint32
+    {
+        None = 0,
+        LZ4,
+        Count
+    };
+
     static constexpr Uint32 HeaderMagicNumber = 0xDE00000A;
-    static constexpr Uint32 ArchiveVersion    = 8;
+    static constexpr Uint32 ArchiveVersion    = 9;
+
+    // The oldest archive version that can be read. Version 8 archives do not support shader compression.
+    static constexpr Uint32 MinSupportedArchiveVersion = 8;
+
+    // The default minimum size of the compressed shader block.
+    static constexpr Uint32 DefaultShaderBlockSize = 64 << 10;
 
     struct ArchiveHeader
     {
@@ -242,10 +273,36 @@ public:
     void AppendDeviceData(const DeviceObjectArchive& Src, DeviceType Dev) noexcept(false);
     void Merge(const DeviceObjectArchive& Src) noexcept(false);
 
+    /// Removes the named resource from the archive. Shaders referenced by the resource
+    /// are not removed; call CompactShaders() to release them.
+    void RemoveResource(ResourceType Type, const char* Name) noexcept;
+
+    /// Removes shaders that are not referenced by any resource, merges identical
+    /// shaders and updates the shader indices of all resources accordingly.
+    void CompactShaders() noexcept(false);
+
+    struct SerializeAttribs
+    {
+        /// Shader data compression.
+        ShaderCompression Compression = ShaderCompression::None;
+
+        /// The minimum size of the block that consecutive shaders are packed into before compression.
+        /// Larger blocks compress better, but require decompressing more data to unpack a single shader.
+        /// If zero, every shader is compressed individually.
+        Uint32 ShaderBlockSize = DefaultShaderBlockSize;
+
+        /// Optional thread pool to compress shader blocks in parallel.
+        IThreadPool* pThreadPool = nullptr;
+    };
+
     bool Deserialize(const CreateInfo& CI) noexcept;
     void Serialize(IFileStream* pStream) const;
+
+    /// Serializes the archive using the shader compression of the archive it was deserialized from.
     void Serialize(IDataBlob** ppDataBlob) const;
 
+    void Serialize(IDataBlob** ppDataBlob, const SerializeAttribs& Attribs) const;
+
     std::string ToString() const;
 
     template <typename ReourceDataType>
@@ -280,19 +337,39 @@ public:
         return m_NamedResources[NamedResourceKey{Type, Name, MakeCopy}];
     }
 
-    auto& GetDeviceShaders(DeviceType Type) noexcept
+    /// Returns the shaders of the given device type for modification.
+    /// The method does not modify the archive, and may be called concurrently for different
+    /// device types. If the archive stores shaders compressed, ReleaseCompressedShaders()
+    /// must be called first.
+    std::vector<SerializedData>& GetDeviceShaders(DeviceType Type) noexcept
     {
+        DEV_CHECK_ERR(!m_CompressedShaders[static_cast<size_t>(Type)].Blocks,
+                      "Compressed shaders must be released with ReleaseCompressedShaders() before they can be modified");
         return m_DeviceShaders[static_cast<size_t>(Type)];
     }
 
-    const SerializedData& GetSerializedShader(DeviceType Type, size_t Idx) const noexcept
+    /// Decompresses all shaders, moves the decompressed data to the archive and releases
+    /// the compressed shader index. Must be called before the shader arrays are modified.
+    /// Does nothing if the archive stores no compressed shaders.
+    /// The method is not thread-safe.
+    void ReleaseCompressedShaders() noexcept(false);
+
+    /// Returns the serialized shader data. If the archive stores shaders compressed,
+    /// the block that contains the shader is decompressed on first access.
+    /// The method is thread-safe.
+    const SerializedData& GetSerializedShader(DeviceType Type, size_t Idx) const noexcept;
+
+    /// Decompresses the blocks that contain the given shaders, if the archive stores shaders compressed.
+    /// The blocks are decompressed in parallel using the thread pool, if it is not null.
+    /// The method is thread-safe.
+    void DecompressShaders(DeviceType    Type,
+                           const Uint32* pIndices,
+                           Uint32        NumIndices,
+                           IThreadPool*  pThreadPool = nullptr) const noexcept;
+
+    ShaderCompression GetShaderCompression() const
     {
-        const auto& DeviceShaders = m_DeviceShaders[static_cast<size_t>(Type)];
-        if (Idx < DeviceShaders.size())
-            return DeviceShaders[Idx];
-
-        static const SerializedData NullData;
-        return NullData;
+        return m_ShaderCompression;
     }
 
     const auto& GetNamedResources() const
@@ -302,12 +379,54 @@ public:
 
     void Clear() noexcept;
 
+private:
+    void DecompressShaderBlock(size_t Dev, Uint32 BlockIdx) const noexcept;
+
+    void DecompressAllShaders(IThreadPool* pThreadPool = nullptr) const noexcept;
+
 private:
     // Named resources
     std::unordered_map<NamedResourceKey, ResourceData, NamedResourceKey::Hasher> m_NamedResources;
 
-    // Shaders
-    std::array<std::vector<SerializedData>, static_cast<size_t>(DeviceType::Count)> m_DeviceShaders;
+    // Shaders. Compressed shaders are empty until the block that contains them is decompressed.
+    mutable std::array<std::vector<SerializedData>, static_cast<size_t>(DeviceType::Count)> m_DeviceShaders;
+
+    // Location of the shader in the uncompressed block
+    struct CompressedShaderLocation
+    {
+        Uint32 Block  = 0;
+        Uint32 Offset = 0;
+        Uint32 Size   = 0;
+    };
+
+    struct CompressedShaderBlock
+    {
+        // Compressed data that references the archive data blob
+        SerializedData Data;
+        Uint32         UncompressedSize = 0;
+
+        // The range of shaders in the block
+        Uint32 FirstShader = 0;
+        Uint32 NumShaders  = 0;
+
+        SerializedData DecompressedData;
+        std::once_flag DecompressFlag;
+    };
+
+    struct CompressedDeviceShaders
+    {
+        std::unique_ptr<CompressedShaderBlock[]> Blocks;
+        Uint32                                   NumBlocks = 0;
+
+        std::vector<CompressedShaderLocation> Locations;
+    };
+    std::array<CompressedDeviceShaders, static_cast<size_t>(DeviceType::Count)> m_CompressedShaders;
+
+    // Decompressed shader data that is still referenced by the shaders after
+    // the compressed shader index has been released.
+    std::vector<SerializedData> m_DecompressedShaderData;
+
+    ShaderCompression m_ShaderCompression = ShaderCompression::None;
 
     // Strong reference to the original data blob.
     // Resources will not make copies and reference this data.
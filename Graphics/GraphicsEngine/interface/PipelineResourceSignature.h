@@ -129,7 +129,25 @@ DILIGENT_TYPED_ENUM(PIPELINE_RESOURCE_FLAGS, Uint8)
     /// \note This flag is only valid in Vulkan.
     PIPELINE_RESOURCE_FLAG_GENERAL_INPUT_ATTACHMENT = 1u << 4,
 
-    PIPELINE_RESOURCE_FLAG_LAST               = PIPELINE_RESOURCE_FLAG_GENERAL_INPUT_ATTACHMENT
+    /// Indicates that the resource is placed into an update-after-bind descriptor set.
+    /// Applies to mutable SRV, UAV, constant buffer and sampler resources.
+    ///
+    /// Descriptors of update-after-bind resources may be updated after the SRB has been
+    /// committed and while command buffers that use it are pending execution, and array
+    /// elements that are not accessed by the shader do not need to be initialized.
+    /// This allows using a single large resource array as a global descriptor heap that
+    /// is bound once per frame, while shaders select resources by index (e.g. read from
+    /// a constant buffer). Use SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE to update
+    /// array elements of an SRB that is in use. The application is responsible for not
+    /// overwriting elements that may still be accessed by the GPU.
+    ///
+    /// Buffer resources that use this flag must also use PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS.
+    /// The flag requires ShaderResourceRuntimeArrays device feature.
+    ///
+    /// \note This flag is only used in Vulkan and is ignored by other backends.
+    PIPELINE_RESOURCE_FLAG_UPDATE_AFTER_BIND  = 1u << 5,
+
+    PIPELINE_RESOURCE_FLAG_LAST               = PIPELINE_RESOURCE_FLAG_UPDATE_AFTER_BIND
 };
 DEFINE_FLAG_ENUM_OPERATORS(PIPELINE_RESOURCE_FLAGS);
 
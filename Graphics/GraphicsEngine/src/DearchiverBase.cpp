@@ -431,6 +431,23 @@ bool DearchiverBase::UnpackPSOShaders(ArchiveData&             Archive,
 
     ShaderCacheData& ShaderCache = Archive.CachedShaders[static_cast<size_t>(DevType)];
 
+    // Decompress the blocks that contain the shaders that are not in the cache yet in parallel.
+    // The blocks are otherwise decompressed one by one when the shaders are accessed below.
+    if (pObjArchive->GetShaderCompression() != DeviceObjectArchive::ShaderCompression::None)
+    {
+        std::vector<Uint32> UncachedIndices;
+        {
+            std::unique_lock<std::mutex> ReadLock{ShaderCache.Mtx};
+            for (Uint32 i = 0; i < ShaderIndices.Count; ++i)
+            {
+                const Uint32 Idx = ShaderIndices.pIndices[i];
+                if (Idx >= ShaderCache.Shaders.size() || !ShaderCache.Shaders[Idx])
+                    UncachedIndices.push_back(Idx);
+            }
+        }
+        pObjArchive->DecompressShaders(DevType, UncachedIndices.data(), static_cast<Uint32>(UncachedIndices.size()), pDevice->GetShaderCompilationThreadPool());
+    }
+
     PSO.Shaders.resize(ShaderIndices.Count);
     for (Uint32 i = 0; i < ShaderIndices.Count; ++i)
     {
@@ -27,12 +27,16 @@
 #include "DeviceObjectArchive.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <sstream>
 
 #include "Shader.h"
 #include "EngineMemory.h"
 #include "DataBlobImpl.hpp"
 #include "PSOSerializer.hpp"
+#include "LZ4Codec.hpp"
+#include "ThreadPool.hpp"
+#include "Align.hpp"
 
 namespace Diligent
 {
@@ -154,9 +158,12 @@ DeviceObjectArchive::DeviceObjectArchive(Uint32 ContentVersion) noexcept :
 void DeviceObjectArchive::Clear() noexcept
 {
     m_NamedResources.clear();
-    m_DeviceShaders = {};
+    m_DeviceShaders     = {};
+    m_CompressedShaders = {};
+    m_DecompressedShaderData.clear();
     m_pArchiveData.Release();
-    m_ContentVersion = 0;
+    m_ContentVersion    = 0;
+    m_ShaderCompression = ShaderCompression::None;
 }
 
 
@@ -181,10 +188,11 @@ bool DeviceObjectArchive::Deserialize(const CreateInfo& CI) noexcept
         DataBlobImpl::MakeCopy(CI.pData) :
         const_cast<IDataBlob*>(CI.pData); // Need to remove const for AddRef/Release
 
+    // Resources and compressed shader blocks reference the data, so read it from the blob the archive keeps alive
     Serializer<SerializerMode::Read> Reader{
         SerializedData{
-            const_cast<void*>(CI.pData->GetConstDataPtr()),
-            CI.pData->GetSize(),
+            const_cast<void*>(m_pArchiveData->GetConstDataPtr()),
+            m_pArchiveData->GetSize(),
         },
     };
     ArchiveSerializer<SerializerMode::Read> ArchiveReader{Reader};
@@ -198,7 +206,8 @@ bool DeviceObjectArchive::Deserialize(const CreateInfo& CI) noexcept
 
     CHECK_ARCHIVE(ArchiveReader.Ser(Header.Version), "Failed to read device object archive version.");
 
-    CHECK_ARCHIVE(Header.Version == ArchiveVersion, "Unsupported device object archive version: ", Header.Version, ". Expected version: ", Uint32{ArchiveVersion});
+    CHECK_ARCHIVE(Header.Version >= MinSupportedArchiveVersion && Header.Version <= ArchiveVersion,
+                  "Unsupported device object archive version: ", Header.Version, ". Supported versions: ", Uint32{MinSupportedArchiveVersion}, " to ", Uint32{ArchiveVersion});
 
     CHECK_ARCHIVE(ArchiveReader.Ser(Header.APIVersion), "Failed to read Diligent API version.");
 
@@ -227,9 +236,74 @@ bool DeviceObjectArchive::Deserialize(const CreateInfo& CI) noexcept
         CHECK_ARCHIVE(ArchiveReader.SerializeResourceData(ResData), "Failed to read data of resource '", Name, "'.");
     }
 
-    for (std::vector<SerializedData>& Shaders : m_DeviceShaders)
+    for (size_t dev = 0; dev < m_DeviceShaders.size(); ++dev)
     {
-        CHECK_ARCHIVE(ArchiveReader.SerializeShaders(Shaders), "Failed to read shader data from the device object archive.");
+        std::vector<SerializedData>& Shaders = m_DeviceShaders[dev];
+
+        // Version 8 archives do not support shader compression
+        ShaderCompression Compression = ShaderCompression::None;
+        if (Header.Version > 8)
+        {
+            CHECK_ARCHIVE(Reader(Compression), "Failed to read shader compression.");
+            CHECK_ARCHIVE(Compression < ShaderCompression::Count, "Unknown shader compression: ", static_cast<Uint32>(Compression), '.');
+        }
+
+        if (Compression == ShaderCompression::None)
+        {
+            CHECK_ARCHIVE(ArchiveReader.SerializeShaders(Shaders), "Failed to read shader data from the device object archive.");
+            continue;
+        }
+
+        m_ShaderCompression = Compression;
+
+        CompressedDeviceShaders& Compressed = m_CompressedShaders[dev];
+
+        Uint32 NumShaders = 0;
+        CHECK_ARCHIVE(Reader(NumShaders, Compressed.NumBlocks), "Failed to read the number of compressed shaders.");
+
+        // Every shader location takes three Uint32 values, and every block takes at least its uncompressed
+        // and compressed sizes. Check the counts before allocating memory for them.
+        constexpr Uint64 MinSerializedLocationSize = sizeof(Uint32) * 3;
+        constexpr Uint64 MinSerializedBlockSize    = sizeof(Uint32) * 2;
+        CHECK_ARCHIVE(NumShaders * MinSerializedLocationSize + Compressed.NumBlocks * MinSerializedBlockSize <= Reader.GetRemainingSize(),
+                      "The number of compressed shaders (", NumShaders, ") and blocks (", Compressed.NumBlocks,
+                      ") exceeds the remaining archive data size. Archive file may be corrupted or invalid.");
+
+        Compressed.Blocks = std::make_unique<CompressedShaderBlock[]>(Compressed.NumBlocks);
+        Compressed.Locations.resize(NumShaders);
+
+        // Read the block index. Shaders are packed into consecutive blocks.
+        for (Uint32 i = 0; i < NumShaders; ++i)
+        {
+            CompressedShaderLocation& Loc = Compressed.Locations[i];
+            CHECK_ARCHIVE(Reader(Loc.Block, Loc.Offset, Loc.Size), "Failed to read the location of compressed shader ", i, '.');
+
+            const Uint32 FirstBlock = i > 0 ? Compressed.Locations[i - 1].Block : 0;
+            CHECK_ARCHIVE(Loc.Block < Compressed.NumBlocks && Loc.Block >= FirstBlock && Loc.Block <= FirstBlock + 1,
+                          "Invalid block index ", Loc.Block, " of compressed shader ", i, ". Archive file may be corrupted or invalid.");
+
+            CompressedShaderBlock& Block = Compressed.Blocks[Loc.Block];
+            if (Block.NumShaders == 0)
+                Block.FirstShader = i;
+            ++Block.NumShaders;
+        }
+
+        for (Uint32 b = 0; b < Compressed.NumBlocks; ++b)
+        {
+            CompressedShaderBlock& Block = Compressed.Blocks[b];
+            CHECK_ARCHIVE(Reader(Block.UncompressedSize) && Reader.Serialize(Block.Data), "Failed to read compressed shader block ", b, '.');
+            CHECK_ARCHIVE(Block.Data.Size() <= Block.UncompressedSize, "Invalid size of compressed shader block ", b, ". Archive file may be corrupted or invalid.");
+        }
+
+        for (Uint32 i = 0; i < NumShaders; ++i)
+        {
+            const CompressedShaderLocation& Loc = Compressed.Locations[i];
+            CHECK_ARCHIVE(Uint64{Loc.Offset} + Loc.Size <= Compressed.Blocks[Loc.Block].UncompressedSize,
+                          "Compressed shader ", i, " is out of the block bounds. Archive file may be corrupted or invalid.");
+        }
+
+        // Shaders are decompressed on first access
+        Shaders.resize(NumShaders);
     }
 #undef CHECK_ARCHIVE
 
@@ -237,6 +311,13 @@ bool DeviceObjectArchive::Deserialize(const CreateInfo& CI) noexcept
 }
 
 void DeviceObjectArchive::Serialize(IDataBlob** ppDataBlob) const
+{
+    SerializeAttribs Attribs;
+    Attribs.Compression = m_ShaderCompression;
+    Serialize(ppDataBlob, Attribs);
+}
+
+void DeviceObjectArchive::Serialize(IDataBlob** ppDataBlob, const SerializeAttribs& Attribs) const
 {
     if (ppDataBlob == nullptr)
     {
@@ -244,8 +325,75 @@ void DeviceObjectArchive::Serialize(IDataBlob** ppDataBlob) const
         return;
     }
     DEV_CHECK_ERR(*ppDataBlob == nullptr, "Data blob object must be null");
+    DEV_CHECK_ERR(Attribs.Compression < ShaderCompression::Count, "Unknown shader compression");
+
+    DecompressAllShaders(Attribs.pThreadPool);
+
+    struct DeviceShaderBlocks
+    {
+        std::vector<CompressedShaderLocation> Locations;
+        std::vector<Uint32>                   FirstShaders;
+        std::vector<Uint32>                   UncompressedSizes;
+        std::vector<SerializedData>           Blocks;
+    };
+    std::array<DeviceShaderBlocks, static_cast<size_t>(DeviceType::Count)> CompressedShaders;
+
+    // Compress shaders before measuring the archive size
+    for (size_t dev = 0; dev < m_DeviceShaders.size() && Attribs.Compression != ShaderCompression::None; ++dev)
+    {
+        const std::vector<SerializedData>& Shaders = m_DeviceShaders[dev];
+        DeviceShaderBlocks&                Dst     = CompressedShaders[dev];
+
+        // Pack consecutive shaders into blocks of at least ShaderBlockSize bytes
+        for (Uint32 i = 0; i < Shaders.size(); ++i)
+        {
+            if (Dst.UncompressedSizes.empty() || Dst.UncompressedSizes.back() >= Attribs.ShaderBlockSize)
+            {
+                Dst.FirstShaders.push_back(i);
+                Dst.UncompressedSizes.push_back(0);
+            }
+
+            CompressedShaderLocation Loc;
+            Loc.Block  = static_cast<Uint32>(Dst.UncompressedSizes.size() - 1);
+            Loc.Offset = AlignUp(Dst.UncompressedSizes.back(), Uint32{8});
+            Loc.Size   = StaticCast<Uint32>(Shaders[i].Size());
+            Dst.Locations.push_back(Loc);
+
+            Dst.UncompressedSizes.back() = Loc.Offset + Loc.Size;
+        }
 
-    auto SerializeThis = [this](auto& Ser) {
+        const Uint32 NumBlocks = static_cast<Uint32>(Dst.UncompressedSizes.size());
+        Dst.Blocks.resize(NumBlocks);
+        ProcessRangeInParallel(Attribs.pThreadPool, NumBlocks, 1,
+                               [&](Uint32 StartBlock, Uint32 EndBlock) {
+                                   std::vector<Uint8> Uncompressed;
+                                   std::vector<Uint8> Compressed;
+                                   for (Uint32 b = StartBlock; b < EndBlock; ++b)
+                                   {
+                                       Uncompressed.assign(Dst.UncompressedSizes[b], Uint8{0});
+                                       const Uint32 EndShader = b + 1 < NumBlocks ? Dst.FirstShaders[b + 1] : static_cast<Uint32>(Shaders.size());
+                                       for (Uint32 i = Dst.FirstShaders[b]; i < EndShader; ++i)
+                                       {
+                                           if (Shaders[i])
+                                               memcpy(&Uncompressed[Dst.Locations[i].Offset], Shaders[i].Ptr(), Shaders[i].Size());
+                                       }
+
+                                       Compressed.resize(LZ4CompressBound(Uncompressed.size()));
+                                       size_t CompressedSize = LZ4CompressBlock(Uncompressed.data(), Uncompressed.size(), Compressed.data(), Compressed.size());
+
+                                       // Store the block uncompressed if compression does not reduce its size
+                                       const std::vector<Uint8>& BlockData = (CompressedSize != 0 && CompressedSize < Uncompressed.size()) ? Compressed : Uncompressed;
+                                       if (&BlockData == &Uncompressed)
+                                           CompressedSize = Uncompressed.size();
+
+                                       Dst.Blocks[b] = SerializedData{CompressedSize, GetRawAllocator()};
+                                       if (CompressedSize > 0)
+                                           memcpy(Dst.Blocks[b].Ptr(), BlockData.data(), CompressedSize);
+                                   }
+                               });
+    }
+
+    auto SerializeThis = [this, &Attribs, &CompressedShaders](auto& Ser) {
         constexpr auto SerMode    = std::remove_reference<decltype(Ser)>::type::GetMode();
         const auto     ArchiveSer = ArchiveSerializer<SerMode>{Ser};
 
@@ -271,10 +419,37 @@ void DeviceObjectArchive::Serialize(IDataBlob** ppDataBlob) const
             VERIFY(res, "Failed to serialize resource data");
         }
 
-        for (const std::vector<SerializedData>& Shaders : m_DeviceShaders)
+        for (size_t dev = 0; dev < m_DeviceShaders.size(); ++dev)
         {
-            res = ArchiveSer.SerializeShaders(Shaders);
-            VERIFY(res, "Failed to serialize shaders");
+            const DeviceShaderBlocks& Compressed  = CompressedShaders[dev];
+            const ShaderCompression   Compression = !Compressed.Blocks.empty() ? Attribs.Compression : ShaderCompression::None;
+
+            res = Ser(Compression);
+            VERIFY(res, "Failed to serialize shader compression");
+
+            if (Compression == ShaderCompression::None)
+            {
+                res = ArchiveSer.SerializeShaders(m_DeviceShaders[dev]);
+                VERIFY(res, "Failed to serialize shaders");
+                continue;
+            }
+
+            const Uint32 NumShaders = static_cast<Uint32>(Compressed.Locations.size());
+            const Uint32 NumBlocks  = static_cast<Uint32>(Compressed.Blocks.size());
+            res                     = Ser(NumShaders, NumBlocks);
+            VERIFY(res, "Failed to serialize the number of compressed shaders");
+
+            for (const CompressedShaderLocation& Loc : Compressed.Locations)
+            {
+                res = Ser(Loc.Block, Loc.Offset, Loc.Size);
+                VERIFY(res, "Failed to serialize compressed shader location");
+            }
+
+            for (Uint32 b = 0; b < NumBlocks; ++b)
+            {
+                res = Ser(Compressed.UncompressedSizes[b]) && Ser.Serialize(Compressed.Blocks[b]);
+                VERIFY(res, "Failed to serialize compressed shader block");
+            }
         }
     };
 
@@ -365,6 +540,8 @@ const SerializedData& DeviceObjectArchive::GetDeviceSpecificData(ResourceType Ty
 
 std::string DeviceObjectArchive::ToString() const
 {
+    DecompressAllShaders();
+
     std::stringstream Output;
     Output << "Archive contents:\n";
 
@@ -525,6 +702,8 @@ std::string DeviceObjectArchive::ToString() const
 
 void DeviceObjectArchive::RemoveDeviceData(DeviceType Dev) noexcept(false)
 {
+    ReleaseCompressedShaders();
+
     for (auto& res_it : m_NamedResources)
         res_it.second.DeviceSpecific[static_cast<size_t>(Dev)] = {};
 
@@ -533,6 +712,11 @@ void DeviceObjectArchive::RemoveDeviceData(DeviceType Dev) noexcept(false)
 
 void DeviceObjectArchive::AppendDeviceData(const DeviceObjectArchive& Src, DeviceType Dev) noexcept(false)
 {
+    ReleaseCompressedShaders();
+    Src.DecompressAllShaders();
+    if (Src.m_ShaderCompression != ShaderCompression::None)
+        m_ShaderCompression = Src.m_ShaderCompression;
+
     IMemoryAllocator& Allocator = GetRawAllocator();
     for (auto& dst_res_it : m_NamedResources)
     {
@@ -557,6 +741,80 @@ void DeviceObjectArchive::AppendDeviceData(const DeviceObjectArchive& Src, Devic
         DstShaders.emplace_back(SrcShader.MakeCopy(Allocator));
 }
 
+namespace
+{
+
+bool ResourceHasShaderIndices(DeviceObjectArchive::ResourceType Type)
+{
+    using ResourceType = DeviceObjectArchive::ResourceType;
+    return (Type == ResourceType::StandaloneShader ||
+            Type == ResourceType::GraphicsPipeline ||
+            Type == ResourceType::ComputePipeline ||
+            Type == ResourceType::RayTracingPipeline ||
+            Type == ResourceType::TilePipeline);
+}
+
+// Reads the indices of the shaders in the archive's shader array that are referenced
+// by the device-specific data of a standalone shader or a pipeline.
+std::vector<Uint32> ReadShaderIndices(DeviceObjectArchive::ResourceType Type,
+                                      const SerializedData&             DeviceData,
+                                      DynamicLinearAllocator&           DynAllocator) noexcept(false)
+{
+    Serializer<SerializerMode::Read> Ser{DeviceData};
+    if (Type == DeviceObjectArchive::ResourceType::StandaloneShader)
+    {
+        // For shaders, device-specific data is the serialized shader bytecode index
+        Uint32 ShaderIndex = 0;
+        if (!Ser(ShaderIndex))
+            LOG_ERROR_AND_THROW("Failed to deserialize standalone shader index. Archive file may be corrupted or invalid.");
+        VERIFY(Ser.IsEnded(), "No other data besides the shader index is expected");
+        return {ShaderIndex};
+    }
+    else
+    {
+        // For pipelines, device-specific data is the shader index array
+        DeviceObjectArchive::ShaderIndexArray ShaderIndices;
+        if (!PSOSerializer<SerializerMode::Read>::SerializeShaderIndices(Ser, ShaderIndices, &DynAllocator))
+            LOG_ERROR_AND_THROW("Failed to deserialize PSO shader indices. Archive file may be corrupted or invalid.");
+        VERIFY(Ser.IsEnded(), "No other data besides shader indices is expected");
+        return {ShaderIndices.pIndices, ShaderIndices.pIndices + ShaderIndices.Count};
+    }
+}
+
+template <SerializerMode Mode>
+void SerializeShaderIndices(Serializer<Mode>&                 Ser,
+                            DeviceObjectArchive::ResourceType Type,
+                            const std::vector<Uint32>&        ShaderIndices)
+{
+    if (Type == DeviceObjectArchive::ResourceType::StandaloneShader)
+    {
+        VERIFY(ShaderIndices.size() == 1, "Standalone shader must reference exactly one shader");
+        Ser(ShaderIndices[0]);
+    }
+    else
+    {
+        PSOSerializer<Mode>::SerializeShaderIndices(Ser, DeviceObjectArchive::ShaderIndexArray{ShaderIndices.data(), static_cast<Uint32>(ShaderIndices.size())}, nullptr);
+    }
+}
+
+SerializedData WriteShaderIndices(DeviceObjectArchive::ResourceType Type,
+                                  const std::vector<Uint32>&        ShaderIndices,
+                                  IMemoryAllocator&                 Allocator) noexcept(false)
+{
+    Serializer<SerializerMode::Measure> MeasureSer;
+    SerializeShaderIndices(MeasureSer, Type, ShaderIndices);
+
+    SerializedData DeviceData = MeasureSer.AllocateData(Allocator);
+
+    Serializer<SerializerMode::Write> Ser{DeviceData};
+    SerializeShaderIndices(Ser, Type, ShaderIndices);
+    VERIFY_EXPR(Ser.IsEnded());
+
+    return DeviceData;
+}
+
+} // namespace
+
 void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src) noexcept(false)
 {
     if (m_ContentVersion != Src.m_ContentVersion)
@@ -564,6 +822,11 @@ void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src) noexcept(false)
 
     static_assert(static_cast<size_t>(ResourceType::Count) == 8, "Did you add a new resource type? You may need to handle it here.");
 
+    ReleaseCompressedShaders();
+    Src.DecompressAllShaders();
+    if (Src.m_ShaderCompression != ShaderCompression::None)
+        m_ShaderCompression = Src.m_ShaderCompression;
+
     IMemoryAllocator&      Allocator = GetRawAllocator();
     DynamicLinearAllocator DynAllocator{Allocator, 512};
 
@@ -597,15 +860,8 @@ void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src) noexcept(false)
             continue;
         }
 
-        const auto IsStandaloneShader = (ResType == ResourceType::StandaloneShader);
-        const bool IsPipeline =
-            (ResType == ResourceType::GraphicsPipeline ||
-             ResType == ResourceType::ComputePipeline ||
-             ResType == ResourceType::RayTracingPipeline ||
-             ResType == ResourceType::TilePipeline);
-
         // Update shader indices
-        if (IsStandaloneShader || IsPipeline)
+        if (ResourceHasShaderIndices(ResType))
         {
             for (size_t i = 0; i < static_cast<size_t>(DeviceType::Count); ++i)
             {
@@ -615,52 +871,209 @@ void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src) noexcept(false)
                 if (!DeviceData)
                     continue;
 
-                if (IsStandaloneShader)
-                {
-                    // For shaders, device-specific data is the serialized shader bytecode index
-                    Uint32 ShaderIndex = 0;
-                    {
-                        Serializer<SerializerMode::Read> Ser{DeviceData};
-                        if (!Ser(ShaderIndex))
-                            LOG_ERROR_AND_THROW("Failed to deserialize standalone shader index. Archive file may be corrupted or invalid.");
-                        VERIFY(Ser.IsEnded(), "No other data besides the shader index is expected");
-                    }
+                std::vector<Uint32> ShaderIndices = ReadShaderIndices(ResType, DeviceData, DynAllocator);
+                for (Uint32& Idx : ShaderIndices)
+                    Idx += BaseIdx;
 
-                    ShaderIndex += BaseIdx;
+                DeviceData = WriteShaderIndices(ResType, ShaderIndices, Allocator);
+            }
+        }
+    }
+}
 
-                    {
-                        Serializer<SerializerMode::Write> Ser{DeviceData};
-                        Ser(ShaderIndex);
-                        VERIFY_EXPR(Ser.IsEnded());
-                    }
-                }
-                else if (IsPipeline)
-                {
-                    // For pipelines, device-specific data is the shader index array
-                    ShaderIndexArray ShaderIndices;
-                    {
-                        Serializer<SerializerMode::Read> Ser{DeviceData};
-                        if (!PSOSerializer<SerializerMode::Read>::SerializeShaderIndices(Ser, ShaderIndices, &DynAllocator))
-                            LOG_ERROR_AND_THROW("Failed to deserialize PSO shader indices. Archive file may be corrupted or invalid.");
-                        VERIFY(Ser.IsEnded(), "No other data besides shader indices is expected");
-                    }
+void DeviceObjectArchive::RemoveResource(ResourceType Type, const char* Name) noexcept
+{
+    m_NamedResources.erase(NamedResourceKey{Type, Name});
+}
 
-                    std::vector<Uint32> NewIndices{ShaderIndices.pIndices, ShaderIndices.pIndices + ShaderIndices.Count};
-                    for (Uint32& Idx : NewIndices)
-                        Idx += BaseIdx;
+void DeviceObjectArchive::CompactShaders() noexcept(false)
+{
+    ReleaseCompressedShaders();
 
-                    {
-                        Serializer<SerializerMode::Write> Ser{DeviceData};
-                        PSOSerializer<SerializerMode::Write>::SerializeShaderIndices(Ser, ShaderIndexArray{NewIndices.data(), ShaderIndices.Count}, nullptr);
-                        VERIFY_EXPR(Ser.IsEnded());
-                    }
-                }
-                else
+    IMemoryAllocator&      Allocator = GetRawAllocator();
+    DynamicLinearAllocator DynAllocator{Allocator, 512};
+
+    for (size_t dev = 0; dev < m_DeviceShaders.size(); ++dev)
+    {
+        std::vector<SerializedData>& Shaders = m_DeviceShaders[dev];
+        if (Shaders.empty())
+            continue;
+
+        // Mark shaders that are referenced by any resource
+        std::vector<bool> IsShaderUsed(Shaders.size(), false);
+        for (const auto& res_it : m_NamedResources)
+        {
+            const ResourceType    ResType    = res_it.first.GetType();
+            const SerializedData& DeviceData = res_it.second.DeviceSpecific[dev];
+            if (!DeviceData || !ResourceHasShaderIndices(ResType))
+                continue;
+
+            for (Uint32 Idx : ReadShaderIndices(ResType, DeviceData, DynAllocator))
+            {
+                if (Idx >= Shaders.size())
+                    LOG_ERROR_AND_THROW("Shader index ", Idx, " is out of range. Archive file may be corrupted or invalid.");
+                IsShaderUsed[Idx] = true;
+            }
+        }
+
+        // Keep used shaders only and merge identical ones
+        std::vector<SerializedData>                     CompactedShaders;
+        std::vector<Uint32>                             NewIndices(Shaders.size(), ~0u);
+        std::unordered_map<size_t, std::vector<Uint32>> HashToCompactedIndices;
+        for (size_t Idx = 0; Idx < Shaders.size(); ++Idx)
+        {
+            if (!IsShaderUsed[Idx])
+                continue;
+
+            std::vector<Uint32>& Candidates = HashToCompactedIndices[Shaders[Idx].GetHash()];
+            for (Uint32 CompactedIdx : Candidates)
+            {
+                if (CompactedShaders[CompactedIdx] == Shaders[Idx])
                 {
-                    UNEXPECTED("Unexpected resource type");
+                    NewIndices[Idx] = CompactedIdx;
+                    break;
                 }
             }
+            if (NewIndices[Idx] == ~0u)
+            {
+                NewIndices[Idx] = static_cast<Uint32>(CompactedShaders.size());
+                Candidates.push_back(NewIndices[Idx]);
+                CompactedShaders.emplace_back(std::move(Shaders[Idx]));
+            }
+        }
+
+        if (CompactedShaders.size() == Shaders.size())
+        {
+            // All shaders are used and unique, so the indices are not changed
+            Shaders = std::move(CompactedShaders);
+            continue;
+        }
+        Shaders = std::move(CompactedShaders);
+
+        for (auto& res_it : m_NamedResources)
+        {
+            const ResourceType ResType    = res_it.first.GetType();
+            SerializedData&    DeviceData = res_it.second.DeviceSpecific[dev];
+            if (!DeviceData || !ResourceHasShaderIndices(ResType))
+                continue;
+
+            std::vector<Uint32> ShaderIndices = ReadShaderIndices(ResType, DeviceData, DynAllocator);
+            for (Uint32& Idx : ShaderIndices)
+                Idx = NewIndices[Idx];
+
+            DeviceData = WriteShaderIndices(ResType, ShaderIndices, Allocator);
+        }
+    }
+}
+
+const SerializedData& DeviceObjectArchive::GetSerializedShader(DeviceType Type, size_t Idx) const noexcept
+{
+    const size_t                       Dev           = static_cast<size_t>(Type);
+    const std::vector<SerializedData>& DeviceShaders = m_DeviceShaders[Dev];
+    if (Idx < DeviceShaders.size())
+    {
+        const CompressedDeviceShaders& Compressed = m_CompressedShaders[Dev];
+        if (Compressed.Blocks)
+            DecompressShaderBlock(Dev, Compressed.Locations[Idx].Block);
+        return DeviceShaders[Idx];
+    }
+
+    static const SerializedData NullData;
+    return NullData;
+}
+
+void DeviceObjectArchive::DecompressShaderBlock(size_t Dev, Uint32 BlockIdx) const noexcept
+{
+    const CompressedDeviceShaders& Compressed = m_CompressedShaders[Dev];
+    VERIFY_EXPR(BlockIdx < Compressed.NumBlocks);
+    CompressedShaderBlock& Block = Compressed.Blocks[BlockIdx];
+
+    // Shader data views are written once while holding the flag, so concurrent readers
+    // of the shaders in this block see them after call_once returns.
+    std::call_once(Block.DecompressFlag, [&]() {
+        const Uint8* pBlockData = Block.Data.Ptr<const Uint8>();
+        if (Block.Data.Size() != Block.UncompressedSize)
+        {
+            Block.DecompressedData = SerializedData{Block.UncompressedSize, GetRawAllocator()};
+            if (!LZ4DecompressBlock(Block.Data.Ptr(), Block.Data.Size(), Block.DecompressedData.Ptr(), Block.UncompressedSize))
+            {
+                LOG_ERROR_MESSAGE("Failed to decompress ", ArchiveDeviceTypeToString(static_cast<Uint32>(Dev)), " shader block ", BlockIdx,
+                                  ". Archive file may be corrupted or invalid.");
+                Block.DecompressedData.Free();
+                return;
+            }
+            pBlockData = Block.DecompressedData.Ptr<const Uint8>();
+        }
+
+        std::vector<SerializedData>& Shaders = m_DeviceShaders[Dev];
+        for (Uint32 i = Block.FirstShader; i < Block.FirstShader + Block.NumShaders; ++i)
+        {
+            const CompressedShaderLocation& Loc = Compressed.Locations[i];
+            Shaders[i]                          = SerializedData{const_cast<Uint8*>(pBlockData) + Loc.Offset, Loc.Size};
+        }
+    });
+}
+
+void DeviceObjectArchive::DecompressShaders(DeviceType    Type,
+                                            const Uint32* pIndices,
+                                            Uint32        NumIndices,
+                                            IThreadPool*  pThreadPool) const noexcept
+{
+    const size_t                   Dev        = static_cast<size_t>(Type);
+    const CompressedDeviceShaders& Compressed = m_CompressedShaders[Dev];
+    if (!Compressed.Blocks || pIndices == nullptr)
+        return;
+
+    std::vector<Uint32> Blocks;
+    Blocks.reserve(NumIndices);
+    for (Uint32 i = 0; i < NumIndices; ++i)
+    {
+        if (pIndices[i] < Compressed.Locations.size())
+            Blocks.push_back(Compressed.Locations[pIndices[i]].Block);
+    }
+    std::sort(Blocks.begin(), Blocks.end());
+    Blocks.erase(std::unique(Blocks.begin(), Blocks.end()), Blocks.end());
+
+    ProcessRangeInParallel(pThreadPool, static_cast<Uint32>(Blocks.size()), 1,
+                           [&](Uint32 Start, Uint32 End) {
+                               for (Uint32 i = Start; i < End; ++i)
+                                   DecompressShaderBlock(Dev, Blocks[i]);
+                           });
+}
+
+void DeviceObjectArchive::DecompressAllShaders(IThreadPool* pThreadPool) const noexcept
+{
+    for (size_t dev = 0; dev < m_CompressedShaders.size(); ++dev)
+    {
+        const CompressedDeviceShaders& Compressed = m_CompressedShaders[dev];
+        if (!Compressed.Blocks)
+            continue;
+
+        ProcessRangeInParallel(pThreadPool, Compressed.NumBlocks, 1,
+                               [&](Uint32 StartBlock, Uint32 EndBlock) {
+                                   for (Uint32 b = StartBlock; b < EndBlock; ++b)
+                                       DecompressShaderBlock(dev, b);
+                               });
+    }
+}
+
+void DeviceObjectArchive::ReleaseCompressedShaders() noexcept(false)
+{
+    if (std::none_of(m_CompressedShaders.begin(), m_CompressedShaders.end(),
+                     [](const CompressedDeviceShaders& Compressed) { return Compressed.Blocks != nullptr; }))
+        return;
+
+    DecompressAllShaders();
+
+    for (CompressedDeviceShaders& Compressed : m_CompressedShaders)
+    {
+        for (Uint32 b = 0; b < Compressed.NumBlocks; ++b)
+        {
+            SerializedData& DecompressedData = Compressed.Blocks[b].DecompressedData;
+            if (DecompressedData)
+                m_DecompressedShaderData.emplace_back(std::move(DecompressedData));
         }
+        Compressed = CompressedDeviceShaders{};
     }
 }
 
@@ -121,6 +121,29 @@ void ValidatePipelineResourceSignatureDesc(const PipelineResourceSignatureDesc&
             LOG_PRS_ERROR_AND_THROW("Incorrect Desc.Resources[", i, "].Flags (RUNTIME_ARRAY). The flag can only be used if ShaderResourceRuntimeArrays device feature is enabled.");
         }
 
+        if ((Res.Flags & PIPELINE_RESOURCE_FLAG_UPDATE_AFTER_BIND) != 0)
+        {
+            if (Features.ShaderResourceRuntimeArrays == DEVICE_FEATURE_STATE_DISABLED)
+            {
+                LOG_PRS_ERROR_AND_THROW("Incorrect Desc.Resources[", i, "].Flags (UPDATE_AFTER_BIND). The flag can only be used if ShaderResourceRuntimeArrays device feature is enabled.");
+            }
+
+            if (Res.VarType != SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE)
+            {
+                LOG_PRS_ERROR_AND_THROW("Desc.Resources[", i, "].Flags contain UPDATE_AFTER_BIND flag, but the variable type is ",
+                                        GetShaderVariableTypeLiteralName(Res.VarType), ". Only mutable resources can be updated after bind.");
+            }
+
+            if ((Res.ResourceType == SHADER_RESOURCE_TYPE_CONSTANT_BUFFER ||
+                 Res.ResourceType == SHADER_RESOURCE_TYPE_BUFFER_SRV ||
+                 Res.ResourceType == SHADER_RESOURCE_TYPE_BUFFER_UAV) &&
+                (Res.Flags & PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS) == 0)
+            {
+                LOG_PRS_ERROR_AND_THROW("Desc.Resources[", i, "].Flags contain UPDATE_AFTER_BIND flag, but not NO_DYNAMIC_BUFFERS flag. "
+                                        "Dynamic buffers can't be used with update-after-bind resources.");
+            }
+        }
+
         if (Res.ResourceType == SHADER_RESOURCE_TYPE_ACCEL_STRUCT && Features.RayTracing == DEVICE_FEATURE_STATE_DISABLED)
         {
             LOG_PRS_ERROR_AND_THROW("Incorrect Desc.Resources[", i, "].ResourceType (ACCEL_STRUCT): ray tracing is not supported by device.");
@@ -34,8 +34,12 @@
 #include <deque>
 #include <mutex>
 #include <atomic>
+#include <array>
+#include <memory>
+#include <thread>
 
 #include "VulkanUtilities/ObjectWrappers.hpp"
+#include "UniqueIdentifier.hpp"
 
 namespace Diligent
 {
@@ -138,7 +142,8 @@ public:
                           std::string                       PoolName,
                           std::vector<VkDescriptorPoolSize> PoolSizes,
                           uint32_t                          MaxSets,
-                          bool                              AllowFreeing) noexcept;
+                          bool                              AllowFreeing,
+                          bool                              UpdateAfterBind = false) noexcept;
     ~DescriptorPoolManager();
 
     DescriptorPoolManager             (const DescriptorPoolManager&) = delete;
@@ -161,7 +166,9 @@ public:
 #endif
 
 protected:
-    VulkanUtilities::DescriptorPoolWrapper CreateDescriptorPool(const char* DebugName) const;
+    // Creates a new pool. Must be called with m_Mutex locked.
+    // Returns null pool if the total descriptor count limit would be exceeded.
+    VulkanUtilities::DescriptorPoolWrapper CreateDescriptorPool(const char* DebugName);
 
     RenderDeviceVkImpl& m_DeviceVkImpl;
     const std::string   m_PoolName;
@@ -169,10 +176,19 @@ protected:
     const std::vector<VkDescriptorPoolSize> m_PoolSizes;
     const uint32_t                          m_MaxSets;
     const bool                              m_AllowFreeing;
+    const bool                              m_UpdateAfterBind;
+
+    // The total number of descriptors in all pools created by the manager is limited by
+    // maxUpdateAfterBindDescriptorsInAllPools for update-after-bind pools (0 means no limit).
+    const Uint64 m_MaxDescriptorsInAllPools;
 
     std::mutex                                         m_Mutex;
     std::deque<VulkanUtilities::DescriptorPoolWrapper> m_Pools;
 
+    // The total number of descriptors in all pools created by the manager, protected by m_Mutex.
+    // Pools are never destroyed before the manager, so the number never decreases.
+    Uint64 m_NumDescriptorsInAllPools = 0;
+
 private:
     void FreePool(VulkanUtilities::DescriptorPoolWrapper&& Pool);
 
@@ -183,7 +199,28 @@ private:
 
 
 // The class allocates descriptor sets from the main descriptor pool.
-// Descriptors sets can be released and returned to the pool
+// Descriptors sets can be released and returned to the pool.
+//
+// Every thread that allocates descriptor sets takes a pool from the shared list and
+// allocates from it until the pool is exhausted. The exhausted pool is then returned
+// to the shared list, and the thread takes another one. This way threads that create
+// SRBs concurrently do not contend for the global mutex on every allocation.
+// Descriptor sets are freed through the release queue from any thread, so access to
+// every pool is still synchronized by a per-pool mutex.
+// When a thread exits, its pool is returned to the shared list and its cache is removed.
+// Pools of threads that have not allocated descriptor sets for MaxThreadIdleFrames frames
+// are returned to the shared list by ReleaseIdleThreadPools().
+//      ______________________________________
+//     |                                      |
+//     |        DescriptorSetAllocator        |
+//     |                                      |
+//     |   | Pool[0] | Pool[1] | ...          |       shared list
+//     |______________________________________|
+//          |        A           |       A
+//          |        |           |       |
+//          V        |           V       |
+//      Thread 0 Pool[N]     Thread 1 Pool[M]         thread caches
+//
 class DescriptorSetAllocator : public DescriptorPoolManager
 {
 public:
@@ -192,7 +229,8 @@ public:
                            std::string                       PoolName,
                            std::vector<VkDescriptorPoolSize> PoolSizes,
                            uint32_t                          MaxSets,
-                           bool                              AllowFreeing) noexcept :
+                           bool                              AllowFreeing,
+                           bool                              UpdateAfterBind = false) noexcept :
         // clang-format off
         DescriptorPoolManager
         {
@@ -200,7 +238,8 @@ public:
             std::move(PoolName),
             std::move(PoolSizes),
             MaxSets,
-            AllowFreeing
+            AllowFreeing,
+            UpdateAfterBind
         }
     // clang-format on
     {
@@ -220,9 +259,84 @@ public:
     }
 #endif
 
+    // The number of frames after which the pool of a thread that does not allocate descriptor sets is reclaimed
+    static constexpr Uint32 MaxThreadIdleFrames = 16;
+
+    // Called once per frame. Returns pools of the threads that have not allocated
+    // descriptor sets for more than MaxIdleFrames frames to the shared list.
+    void ReleaseIdleThreadPools(Uint32 MaxIdleFrames = MaxThreadIdleFrames);
+
+    struct ThreadAllocationStats
+    {
+        std::thread::id ThreadId;
+
+        // The total number of descriptor sets allocated by the thread
+        Uint64 NumAllocatedSets = 0;
+
+        // The number of times the thread took a pool from the shared list or created a new one
+        Uint32 NumAcquiredPools = 0;
+
+        // Whether the thread currently owns a pool
+        bool OwnsPool = false;
+    };
+    // Returns allocation statistics for every running thread that has allocated descriptor sets
+    std::vector<ThreadAllocationStats> GetThreadAllocationStats();
+
 private:
+    struct ThreadCache
+    {
+        ThreadCache(DescriptorSetAllocator& Allocator, std::thread::id _ThreadId) noexcept :
+            AllocatorId{Allocator.m_UniqueId.GetID()},
+            ThreadId{_ThreadId},
+            pAllocator{&Allocator}
+        {}
+
+        const UniqueIdentifier AllocatorId;
+        const std::thread::id  ThreadId;
+
+        // The cache is shared between the allocator and the thread-local table of the owning thread,
+        // either of which may be destroyed first. The allocator is reset to null when the cache is
+        // detached from it by the allocator destructor or by the owning thread on exit.
+        std::mutex              DetachMtx;
+        DescriptorSetAllocator* pAllocator;
+
+        // The pool the thread currently allocates from. The pool is not in the
+        // shared list while it is owned by the thread.
+        // Protected by PoolMtx. The pool is only replaced with m_Mutex also locked, so
+        // m_Mutex must always be locked before PoolMtx.
+        std::mutex                             PoolMtx;
+        VulkanUtilities::DescriptorPoolWrapper Pool;
+
+        // The frame number at the time of the last allocation, see m_FrameNumber
+        std::atomic<Uint64> LastAllocationFrame{0};
+
+        std::atomic<Uint64> NumAllocatedSets{0};
+        std::atomic<Uint32> NumAcquiredPools{0};
+    };
+
+    ThreadCache& GetThreadCache();
+
+    // Called by the owning thread on exit with Cache.DetachMtx locked
+    void ReleaseThreadCache(ThreadCache& Cache);
+
+    std::mutex& GetPoolMutex(VkDescriptorPool vkPool);
+
     void FreeDescriptorSet(VkDescriptorSet Set, VkDescriptorPool Pool, Uint64 QueueMask);
 
+    // Identifies the allocator in thread-local cache lookup tables
+    UniqueIdHelper<DescriptorSetAllocator> m_UniqueId;
+
+    // Caches of running threads, protected by m_Mutex
+    std::vector<std::shared_ptr<ThreadCache>> m_ThreadCaches;
+
+    // The number of ReleaseIdleThreadPools() calls
+    std::atomic<Uint64> m_FrameNumber{0};
+
+    // Descriptor pools are externally synchronized, meaning that the application must not allocate
+    // and/or free descriptor sets from the same pool in multiple threads simultaneously (13.2.3).
+    // Pools are mapped to mutexes by their handles.
+    std::array<std::mutex, 32> m_PoolMutexes;
+
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic<Int32> m_AllocatedSetCounter;
 #endif
@@ -565,6 +565,9 @@ private:
     /// Memory to store dynamic buffer offsets for descriptor sets.
     std::vector<Uint32> m_DynamicBufferOffsets;
 
+    /// Memory to store descriptor infos written to dynamic descriptor sets with update templates.
+    std::vector<ShaderResourceCacheVk::DescriptorTemplateData> m_DescriptorTemplateData;
+
     /// Temporary array used by CommitDescriptorSets
     std::array<VkDescriptorSet, (MAX_RESOURCE_SIGNATURES * MAX_DESCR_SET_PER_SIGNATURE)> m_DescriptorSets = {};
 
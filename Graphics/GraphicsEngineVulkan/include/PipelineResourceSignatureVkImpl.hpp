@@ -130,9 +130,11 @@ public:
     // Make the base class method visible
     using TPipelineResourceSignatureBase::CopyStaticResources;
 
-    // Commits dynamic resources from ResourceCache to vkDynamicDescriptorSet
-    void CommitDynamicResources(const ShaderResourceCacheVk& ResourceCache,
-                                VkDescriptorSet              vkDynamicDescriptorSet) const;
+    // Commits dynamic resources from ResourceCache to vkDynamicDescriptorSet.
+    // TemplateData is the scratch memory used when the set is updated with the descriptor update template.
+    void CommitDynamicResources(const ShaderResourceCacheVk&                                ResourceCache,
+                                VkDescriptorSet                                             vkDynamicDescriptorSet,
+                                std::vector<ShaderResourceCacheVk::DescriptorTemplateData>& TemplateData) const;
 
 #ifdef DILIGENT_DEVELOPMENT
     /// Verifies committed resource using the SPIRV resource attributes from the PSO.
@@ -177,6 +179,13 @@ private:
     void Destruct();
 
     void CreateSetLayouts(bool IsSerialized);
+    void CreateSetUpdateTemplate(DESCRIPTOR_SET_ID SetId, SHADER_RESOURCE_VARIABLE_TYPE VarType);
+
+    // Writes descriptor infos of all resources of the given variable type to TemplateData.
+    // Returns false if any of the resources is null.
+    bool WriteDescriptorTemplateData(const ShaderResourceCacheVk&                                ResourceCache,
+                                     SHADER_RESOURCE_VARIABLE_TYPE                               VarType,
+                                     std::vector<ShaderResourceCacheVk::DescriptorTemplateData>& TemplateData) const;
 
     static inline CACHE_GROUP       GetResourceCacheGroup(const PipelineResourceDesc& Res);
     static inline DESCRIPTOR_SET_ID VarTypeToDescriptorSetId(SHADER_RESOURCE_VARIABLE_TYPE VarType);
@@ -184,6 +193,13 @@ private:
 private:
     std::array<VulkanUtilities::DescriptorSetLayoutWrapper, DESCRIPTOR_SET_ID_NUM_SETS> m_VkDescrSetLayouts;
 
+    // Descriptor update templates indexed by DESCRIPTOR_SET_ID. The dynamic set template writes all
+    // dynamic resources when the SRB is committed. The static/mutable set template only writes static
+    // resources when they are copied to the SRB; mutable resources are written one at a time when
+    // the application sets them. Null if the device does not support Vulkan 1.1 or there are no
+    // descriptors to write.
+    std::array<VulkanUtilities::DescriptorUpdateTemplateWrapper, DESCRIPTOR_SET_ID_NUM_SETS> m_VkSetUpdateTemplates;
+
     // Descriptor set sizes indexed by the set index in the layout (not DESCRIPTOR_SET_ID!)
     std::array<Uint32, MAX_DESCRIPTOR_SETS> m_DescriptorSetSizes = {~0U, ~0U};
 
@@ -193,6 +209,10 @@ private:
     // The total number storage buffers with dynamic offsets in both descriptor sets,
     // accounting for array size.
     Uint16 m_DynamicStorageBufferCount = 0;
+
+    // Whether the static/mutable descriptor set contains update-after-bind resources
+    // and must be allocated from the update-after-bind descriptor pool.
+    bool m_StaticMutableSetUpdateAfterBind = false;
 };
 
 template <> Uint32 PipelineResourceSignatureVkImpl::GetDescriptorSetIndex<PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_STATIC_MUTABLE>() const;
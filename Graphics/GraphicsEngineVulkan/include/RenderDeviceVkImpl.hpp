@@ -234,11 +234,20 @@ public:
         return m_pDxCompiler.get();
     }
 
+    /// Implementation of IRenderDeviceVk::GetDescriptorSetThreadStats().
+    virtual Uint32 DILIGENT_CALL_TYPE GetDescriptorSetThreadStats(DescriptorSetThreadStatsVk* pStats, Uint32 MaxStats) override final;
+
     DescriptorSetAllocation AllocateDescriptorSet(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, const char* DebugName = "")
     {
         return m_DescriptorSetAllocator.Allocate(CommandQueueMask, SetLayout, DebugName);
     }
-    DescriptorPoolManager& GetDynamicDescriptorPool() { return m_DynamicDescriptorPool; }
+    // Allocates a descriptor set for the layout created with VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT
+    DescriptorSetAllocation AllocateUpdateAfterBindDescriptorSet(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, const char* DebugName = "")
+    {
+        return m_UpdateAfterBindDescriptorSetAllocator.Allocate(CommandQueueMask, SetLayout, DebugName);
+    }
+    DescriptorSetAllocator& GetDescriptorSetAllocator() { return m_DescriptorSetAllocator; }
+    DescriptorPoolManager&  GetDynamicDescriptorPool() { return m_DynamicDescriptorPool; }
 
     std::shared_ptr<const VulkanUtilities::Instance> GetInstance() const { return m_Instance; }
 
@@ -312,6 +321,7 @@ private:
     std::unique_ptr<RenderPassCache>  m_ImplicitRenderPassCache;
 
     DescriptorSetAllocator m_DescriptorSetAllocator;
+    DescriptorSetAllocator m_UpdateAfterBindDescriptorSetAllocator;
     DescriptorPoolManager  m_DynamicDescriptorPool;
 
     // These one-time command pools are used by buffer and texture constructors to
@@ -229,7 +229,9 @@ public:
         {
         }
     };
-    // Sets the resource at the given descriptor set index and offset
+    // Sets the resource at the given descriptor set index and offset.
+    // If the descriptor set has been allocated, the descriptor is also written to it, unless
+    // pLogicalDevice is null, in which case the caller is responsible for updating the set.
     const Resource& SetResource(const VulkanUtilities::LogicalDevice* pLogicalDevice,
                                 Uint32                                DescrSetIndex,
                                 Uint32                                CacheOffset,
@@ -245,6 +247,24 @@ public:
                                 Uint32 CacheOffset,
                                 Uint32 DynamicBufferOffset);
 
+    // Descriptor info record in the packed array consumed by vkUpdateDescriptorSetWithTemplate.
+    // Every resource in the set occupies one record at its cache offset.
+    union DescriptorTemplateData
+    {
+        VkDescriptorImageInfo      ImageInfo;
+        VkDescriptorBufferInfo     BufferInfo;
+        VkBufferView               BufferView;
+        VkAccelerationStructureKHR AccelStruct;
+    };
+
+    // Writes descriptor infos of NumDescriptors resources starting at CacheOffset to the
+    // records pData[CacheOffset] ... pData[CacheOffset + NumDescriptors - 1].
+    // Returns false if any of the resources is null, in which case they can't be written with a template.
+    bool WriteDescriptorTemplateData(Uint32                  DescrSetIndex,
+                                     Uint32                  CacheOffset,
+                                     Uint32                  NumDescriptors,
+                                     DescriptorTemplateData* pData) const;
+
 
     Uint32 GetNumDescriptorSets() const { return m_NumSets; }
     bool   HasDynamicResources() const { return m_NumDynamicBuffers > 0; }
@@ -59,32 +59,34 @@ enum class VulkanHandleTypeId : uint32_t
     Event,
     QueryPool,
     AccelerationStructureKHR,
-    PipelineCache
+    PipelineCache,
+    DescriptorUpdateTemplate
 };
 
 template <typename VulkanObjectType, VulkanHandleTypeId>
 class ObjectWrapper;
 
 #define DEFINE_VULKAN_OBJECT_WRAPPER(Type) ObjectWrapper<Vk##Type, VulkanHandleTypeId::Type>
-using CommandPoolWrapper         = DEFINE_VULKAN_OBJECT_WRAPPER(CommandPool);
-using BufferWrapper              = DEFINE_VULKAN_OBJECT_WRAPPER(Buffer);
-using BufferViewWrapper          = DEFINE_VULKAN_OBJECT_WRAPPER(BufferView);
-using ImageWrapper               = DEFINE_VULKAN_OBJECT_WRAPPER(Image);
-using ImageViewWrapper           = DEFINE_VULKAN_OBJECT_WRAPPER(ImageView);
-using DeviceMemoryWrapper        = DEFINE_VULKAN_OBJECT_WRAPPER(DeviceMemory);
-using FenceWrapper               = DEFINE_VULKAN_OBJECT_WRAPPER(Fence);
-using RenderPassWrapper          = DEFINE_VULKAN_OBJECT_WRAPPER(RenderPass);
-using PipelineWrapper            = DEFINE_VULKAN_OBJECT_WRAPPER(Pipeline);
-using ShaderModuleWrapper        = DEFINE_VULKAN_OBJECT_WRAPPER(ShaderModule);
-using PipelineLayoutWrapper      = DEFINE_VULKAN_OBJECT_WRAPPER(PipelineLayout);
-using SamplerWrapper             = DEFINE_VULKAN_OBJECT_WRAPPER(Sampler);
-using FramebufferWrapper         = DEFINE_VULKAN_OBJECT_WRAPPER(Framebuffer);
-using DescriptorPoolWrapper      = DEFINE_VULKAN_OBJECT_WRAPPER(DescriptorPool);
-using DescriptorSetLayoutWrapper = DEFINE_VULKAN_OBJECT_WRAPPER(DescriptorSetLayout);
-using SemaphoreWrapper           = DEFINE_VULKAN_OBJECT_WRAPPER(Semaphore);
-using QueryPoolWrapper           = DEFINE_VULKAN_OBJECT_WRAPPER(QueryPool);
-using AccelStructWrapper         = DEFINE_VULKAN_OBJECT_WRAPPER(AccelerationStructureKHR);
-using PipelineCacheWrapper       = DEFINE_VULKAN_OBJECT_WRAPPER(PipelineCache);
+using CommandPoolWrapper              = DEFINE_VULKAN_OBJECT_WRAPPER(CommandPool);
+using BufferWrapper                   = DEFINE_VULKAN_OBJECT_WRAPPER(Buffer);
+using BufferViewWrapper               = DEFINE_VULKAN_OBJECT_WRAPPER(BufferView);
+using ImageWrapper                    = DEFINE_VULKAN_OBJECT_WRAPPER(Image);
+using ImageViewWrapper                = DEFINE_VULKAN_OBJECT_WRAPPER(ImageView);
+using DeviceMemoryWrapper             = DEFINE_VULKAN_OBJECT_WRAPPER(DeviceMemory);
+using FenceWrapper                    = DEFINE_VULKAN_OBJECT_WRAPPER(Fence);
+using RenderPassWrapper               = DEFINE_VULKAN_OBJECT_WRAPPER(RenderPass);
+using PipelineWrapper                 = DEFINE_VULKAN_OBJECT_WRAPPER(Pipeline);
+using ShaderModuleWrapper             = DEFINE_VULKAN_OBJECT_WRAPPER(ShaderModule);
+using PipelineLayoutWrapper           = DEFINE_VULKAN_OBJECT_WRAPPER(PipelineLayout);
+using SamplerWrapper                  = DEFINE_VULKAN_OBJECT_WRAPPER(Sampler);
+using FramebufferWrapper              = DEFINE_VULKAN_OBJECT_WRAPPER(Framebuffer);
+using DescriptorPoolWrapper           = DEFINE_VULKAN_OBJECT_WRAPPER(DescriptorPool);
+using DescriptorSetLayoutWrapper      = DEFINE_VULKAN_OBJECT_WRAPPER(DescriptorSetLayout);
+using SemaphoreWrapper                = DEFINE_VULKAN_OBJECT_WRAPPER(Semaphore);
+using QueryPoolWrapper                = DEFINE_VULKAN_OBJECT_WRAPPER(QueryPool);
+using AccelStructWrapper              = DEFINE_VULKAN_OBJECT_WRAPPER(AccelerationStructureKHR);
+using PipelineCacheWrapper            = DEFINE_VULKAN_OBJECT_WRAPPER(PipelineCache);
+using DescriptorUpdateTemplateWrapper = DEFINE_VULKAN_OBJECT_WRAPPER(DescriptorUpdateTemplate);
 #undef DEFINE_VULKAN_OBJECT_WRAPPER
 
 class LogicalDevice : public std::enable_shared_from_this<LogicalDevice>
@@ -162,6 +164,8 @@ public:
 
     PipelineCacheWrapper CreatePipelineCache(const VkPipelineCacheCreateInfo &CI, const char* DebugName = "") const;
 
+    DescriptorUpdateTemplateWrapper CreateDescriptorUpdateTemplate(const VkDescriptorUpdateTemplateCreateInfo& CI, const char* DebugName = "") const;
+
     void ReleaseVulkanObject(CommandPoolWrapper&&  CmdPool) const;
     void ReleaseVulkanObject(BufferWrapper&&       Buffer) const;
     void ReleaseVulkanObject(BufferViewWrapper&&   BufferView) const;
@@ -181,6 +185,7 @@ public:
     void ReleaseVulkanObject(QueryPoolWrapper&&     QueryPool) const;
     void ReleaseVulkanObject(AccelStructWrapper&&   AccelStruct) const;
     void ReleaseVulkanObject(PipelineCacheWrapper&& PSOCache) const;
+    void ReleaseVulkanObject(DescriptorUpdateTemplateWrapper&& DescrUpdateTemplate) const;
 
     void FreeDescriptorSet(VkDescriptorPool Pool, VkDescriptorSet Set) const;
     void FreeCommandBuffer(VkCommandPool Pool, VkCommandBuffer CmdBuffer) const;
@@ -215,6 +220,10 @@ public:
                               uint32_t                    descriptorCopyCount,
                               const VkCopyDescriptorSet*  pDescriptorCopies) const;
 
+    void UpdateDescriptorSetWithTemplate(VkDescriptorSet            descriptorSet,
+                                         VkDescriptorUpdateTemplate descriptorUpdateTemplate,
+                                         const void*                pData) const;
+
     VkResult ResetCommandPool(VkCommandPool           vkCmdPool,
                               VkCommandPoolResetFlags flags = 0) const;
 
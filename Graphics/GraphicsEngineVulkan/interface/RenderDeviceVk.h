@@ -38,6 +38,26 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 static DILIGENT_CONSTEXPR INTERFACE_ID IID_RenderDeviceVk =
     {0xab8cf3a6, 0xd959, 0x41c1, {0xae, 0x0, 0xa5, 0x8a, 0xe9, 0x82, 0xe, 0x6a}};
 
+/// Descriptor set allocation statistics of a thread, see IRenderDeviceVk::GetDescriptorSetThreadStats().
+struct DescriptorSetThreadStatsVk
+{
+    /// Hash of the thread id computed by std::hash<std::thread::id>.
+    Uint64 ThreadIdHash DEFAULT_INITIALIZER(0);
+
+    /// The total number of descriptor sets allocated by the thread.
+    Uint64 NumAllocatedSets DEFAULT_INITIALIZER(0);
+
+    /// The number of times the thread took a descriptor pool from the shared list or created a new one.
+    Uint32 NumAcquiredPools DEFAULT_INITIALIZER(0);
+
+    /// Whether the thread currently owns a descriptor pool.
+
+    /// The pool of a thread that has not allocated descriptor sets for a number of
+    /// frames is returned to the shared list by IRenderDevice::ReleaseStaleResources().
+    Bool OwnsPool DEFAULT_INITIALIZER(False);
+};
+typedef struct DescriptorSetThreadStatsVk DescriptorSetThreadStatsVk;
+
 #define DILIGENT_INTERFACE_NAME IRenderDeviceVk
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -169,6 +189,18 @@ DILIGENT_BEGIN_INTERFACE(IRenderDeviceVk, IRenderDevice)
 
     /// Returns DX compiler interface, or null if the compiler is not loaded.
     VIRTUAL struct IDXCompiler* METHOD(GetDXCompiler)(THIS) CONST PURE;
+
+    /// Returns static/mutable descriptor set allocation statistics of running threads.
+
+    /// \param [out] pStats   - Pointer to the array of MaxStats elements where the statistics
+    ///                         of every running thread that has allocated descriptor sets will
+    ///                         be written. May be null.
+    /// \param [in]  MaxStats - The number of elements in the pStats array.
+    ///
+    /// \return    The number of running threads that have allocated descriptor sets.
+    VIRTUAL Uint32 METHOD(GetDescriptorSetThreadStats)(THIS_
+                                                       DescriptorSetThreadStatsVk* pStats,
+                                                       Uint32                      MaxStats) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -188,6 +220,7 @@ DILIGENT_END_INTERFACE
 #    define IRenderDeviceVk_CreateFenceFromVulkanResource(This, ...)  CALL_IFACE_METHOD(RenderDeviceVk, CreateFenceFromVulkanResource,  This, __VA_ARGS__)
 #    define IRenderDeviceVk_GetDeviceFeaturesVk(This, ...)            CALL_IFACE_METHOD(RenderDeviceVk, GetDeviceFeaturesVk,            This, __VA_ARGS__)
 #    define IRenderDeviceVk_GetDXCompiler(This)                       CALL_IFACE_METHOD(RenderDeviceVk, GetDXCompiler,                  This)
+#    define IRenderDeviceVk_GetDescriptorSetThreadStats(This, ...)    CALL_IFACE_METHOD(RenderDeviceVk, GetDescriptorSetThreadStats,    This, __VA_ARGS__)
 
 // clang-format on
 
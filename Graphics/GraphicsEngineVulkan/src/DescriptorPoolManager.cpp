@@ -28,6 +28,9 @@
 #include "pch.h"
 #include "DescriptorPoolManager.hpp"
 #include "RenderDeviceVkImpl.hpp"
+#include "Cast.hpp"
+
+#include <algorithm>
 
 namespace Diligent
 {
@@ -43,8 +46,20 @@ void DescriptorSetAllocation::Release()
     }
 }
 
-VulkanUtilities::DescriptorPoolWrapper DescriptorPoolManager::CreateDescriptorPool(const char* DebugName) const
+VulkanUtilities::DescriptorPoolWrapper DescriptorPoolManager::CreateDescriptorPool(const char* DebugName)
 {
+    Uint64 NumPoolDescriptors = 0;
+    for (const VkDescriptorPoolSize& Size : m_PoolSizes)
+        NumPoolDescriptors += Size.descriptorCount;
+
+    if (m_MaxDescriptorsInAllPools != 0 && m_NumDescriptorsInAllPools + NumPoolDescriptors > m_MaxDescriptorsInAllPools)
+    {
+        LOG_ERROR_MESSAGE("Unable to create a new pool in ", m_PoolName, ": the total number of descriptors in all pools (",
+                          m_NumDescriptorsInAllPools + NumPoolDescriptors, ") would exceed the device limit (", m_MaxDescriptorsInAllPools, ").");
+        return {};
+    }
+    m_NumDescriptorsInAllPools += NumPoolDescriptors;
+
     VkDescriptorPoolCreateInfo PoolCI = {};
 
     PoolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
@@ -52,7 +67,11 @@ VulkanUtilities::DescriptorPoolWrapper DescriptorPoolManager::CreateDescriptorPo
     // VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT specifies that descriptor sets can
     // return their individual allocations to the pool, i.e. all of vkAllocateDescriptorSets,
     // vkFreeDescriptorSets, and vkResetDescriptorPool are allowed. (13.2.3)
-    PoolCI.flags         = m_AllowFreeing ? VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT : 0;
+    PoolCI.flags = m_AllowFreeing ? VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT : 0;
+    // Descriptor sets with VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT layout
+    // can only be allocated from pools created with VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT.
+    if (m_UpdateAfterBind)
+        PoolCI.flags |= VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
     PoolCI.maxSets       = m_MaxSets;
     PoolCI.poolSizeCount = static_cast<uint32_t>(m_PoolSizes.size());
     PoolCI.pPoolSizes    = m_PoolSizes.data();
@@ -83,13 +102,21 @@ DescriptorPoolManager::DescriptorPoolManager(RenderDeviceVkImpl&               D
                                              std::string                       PoolName,
                                              std::vector<VkDescriptorPoolSize> PoolSizes,
                                              uint32_t                          MaxSets,
-                                             bool                              AllowFreeing) noexcept :
+                                             bool                              AllowFreeing,
+                                             bool                              UpdateAfterBind) noexcept :
     // clang-format off
-    m_DeviceVkImpl{DeviceVkImpl        },
-    m_PoolName    {std::move(PoolName) },
-    m_PoolSizes   (PrunePoolSizes(DeviceVkImpl, std::move(PoolSizes))),
-    m_MaxSets     {MaxSets             },
-    m_AllowFreeing{AllowFreeing        }
+    m_DeviceVkImpl   {DeviceVkImpl        },
+    m_PoolName       {std::move(PoolName) },
+    m_PoolSizes      (PrunePoolSizes(DeviceVkImpl, std::move(PoolSizes))),
+    m_MaxSets        {MaxSets             },
+    m_AllowFreeing   {AllowFreeing        },
+    m_UpdateAfterBind{UpdateAfterBind     },
+    m_MaxDescriptorsInAllPools
+    {
+        UpdateAfterBind ?
+            DeviceVkImpl.GetPhysicalDevice().GetExtProperties().DescriptorIndexing.maxUpdateAfterBindDescriptorsInAllPools :
+            0
+    }
 // clang-format on
 {
 #ifdef DILIGENT_DEVELOPMENT
@@ -193,48 +220,207 @@ static VkDescriptorSet AllocateDescriptorSet(const VulkanUtilities::LogicalDevic
 DescriptorSetAllocator::~DescriptorSetAllocator()
 {
     DEV_CHECK_ERR(m_AllocatedSetCounter == 0, m_AllocatedSetCounter, " descriptor set(s) have not been returned to the allocator. If there are outstanding references to the sets in release queues, the app will crash when DescriptorSetAllocator::FreeDescriptorSet() is called");
+
+    std::vector<std::shared_ptr<ThreadCache>> ThreadCaches;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mutex};
+        ThreadCaches.swap(m_ThreadCaches);
+    }
+
+    // Detach the caches of running threads and return their pools to the shared list.
+    // m_Mutex must not be held while DetachMtx is locked, since an exiting thread
+    // takes m_Mutex with its DetachMtx locked.
+    for (std::shared_ptr<ThreadCache>& pCache : ThreadCaches)
+    {
+        std::lock_guard<std::mutex> DetachLock{pCache->DetachMtx};
+        pCache->pAllocator = nullptr;
+
+        std::lock_guard<std::mutex> Lock{m_Mutex};
+        std::lock_guard<std::mutex> CacheLock{pCache->PoolMtx};
+        if (pCache->Pool)
+            m_Pools.emplace_back(std::move(pCache->Pool));
+    }
 }
 
-DescriptorSetAllocation DescriptorSetAllocator::Allocate(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, const char* DebugName)
+DescriptorSetAllocator::ThreadCache& DescriptorSetAllocator::GetThreadCache()
+{
+    // Thread caches of all allocators used by this thread. Allocators are identified by their
+    // unique ids rather than addresses, so that an entry of a destroyed allocator is never matched.
+    struct ThreadCacheTable
+    {
+        std::vector<std::shared_ptr<ThreadCache>> Caches;
+
+        ~ThreadCacheTable()
+        {
+            // Return pools of the exiting thread to the allocators that are still alive
+            for (std::shared_ptr<ThreadCache>& pCache : Caches)
+            {
+                std::lock_guard<std::mutex> DetachLock{pCache->DetachMtx};
+                if (pCache->pAllocator != nullptr)
+                {
+                    pCache->pAllocator->ReleaseThreadCache(*pCache);
+                    pCache->pAllocator = nullptr;
+                }
+            }
+        }
+    };
+    static thread_local ThreadCacheTable ThreadCaches;
+
+    const UniqueIdentifier AllocatorId = m_UniqueId.GetID();
+    for (const std::shared_ptr<ThreadCache>& pCache : ThreadCaches.Caches)
+    {
+        if (pCache->AllocatorId == AllocatorId)
+            return *pCache;
+    }
+
+    // Prune the caches of destroyed allocators
+    ThreadCaches.Caches.erase(std::remove_if(ThreadCaches.Caches.begin(), ThreadCaches.Caches.end(),
+                                             [](const std::shared_ptr<ThreadCache>& pCache) {
+                                                 std::lock_guard<std::mutex> DetachLock{pCache->DetachMtx};
+                                                 return pCache->pAllocator == nullptr;
+                                             }),
+                              ThreadCaches.Caches.end());
+
+    std::shared_ptr<ThreadCache> pCache = std::make_shared<ThreadCache>(*this, std::this_thread::get_id());
+    {
+        std::lock_guard<std::mutex> Lock{m_Mutex};
+        m_ThreadCaches.emplace_back(pCache);
+    }
+    ThreadCaches.Caches.emplace_back(pCache);
+
+    return *pCache;
+}
+
+void DescriptorSetAllocator::ReleaseThreadCache(ThreadCache& Cache)
 {
-    // Descriptor pools are externally synchronized, meaning that the application must not allocate
-    // and/or free descriptor sets from the same pool in multiple threads simultaneously (13.2.3)
     std::lock_guard<std::mutex> Lock{m_Mutex};
 
+    // Sets allocated from the pool may still be in use, so the pool
+    // goes to the end of the shared list like an exhausted one.
+    {
+        std::lock_guard<std::mutex> CacheLock{Cache.PoolMtx};
+        if (Cache.Pool)
+            m_Pools.emplace_back(std::move(Cache.Pool));
+    }
+
+    auto it = std::find_if(m_ThreadCaches.begin(), m_ThreadCaches.end(),
+                           [&Cache](const std::shared_ptr<ThreadCache>& pCache) { return pCache.get() == &Cache; });
+    if (it != m_ThreadCaches.end())
+        m_ThreadCaches.erase(it);
+}
+
+std::mutex& DescriptorSetAllocator::GetPoolMutex(VkDescriptorPool vkPool)
+{
+    const Uint64 Handle = BitCast<Uint64>(vkPool);
+    return m_PoolMutexes[((Handle >> 4) ^ (Handle >> 12)) % m_PoolMutexes.size()];
+}
+
+DescriptorSetAllocation DescriptorSetAllocator::Allocate(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, const char* DebugName)
+{
     const VulkanUtilities::LogicalDevice& LogicalDevice = m_DeviceVkImpl.GetLogicalDevice();
+
+    ThreadCache& Cache = GetThreadCache();
+    Cache.LastAllocationFrame.store(m_FrameNumber.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    auto TryAllocate = [&](VkDescriptorPool vkPool) {
+        // Descriptor pools are externally synchronized, meaning that the application must not allocate
+        // and/or free descriptor sets from the same pool in multiple threads simultaneously (13.2.3)
+        std::lock_guard<std::mutex> PoolLock{GetPoolMutex(vkPool)};
+        return AllocateDescriptorSet(LogicalDevice, vkPool, SetLayout, DebugName);
+    };
+
+    auto OnAllocated = [&](VkDescriptorSet vkSet) {
+#ifdef DILIGENT_DEVELOPMENT
+        ++m_AllocatedSetCounter;
+#endif
+        Cache.NumAllocatedSets.fetch_add(1, std::memory_order_relaxed);
+        return DescriptorSetAllocation{vkSet, Cache.Pool, CommandQueueMask, *this};
+    };
+
+    // Allocate from the pool owned by this thread without taking the global mutex
+    {
+        std::lock_guard<std::mutex> CacheLock{Cache.PoolMtx};
+        if (Cache.Pool)
+        {
+            VkDescriptorSet vkSet = TryAllocate(Cache.Pool);
+            if (vkSet != VK_NULL_HANDLE)
+                return OnAllocated(vkSet);
+        }
+    }
+
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    std::lock_guard<std::mutex> CacheLock{Cache.PoolMtx};
+
+    // The thread's pool is exhausted - return it to the end of the shared list
+    // (sets allocated from it may be freed later) and take another one.
+    if (Cache.Pool)
+        m_Pools.emplace_back(std::move(Cache.Pool));
+
     // Try all pools starting from the frontmost
     for (auto it = m_Pools.begin(); it != m_Pools.end(); ++it)
     {
-        VkDescriptorSet vkSet = AllocateDescriptorSet(LogicalDevice, *it, SetLayout, DebugName);
+        VkDescriptorSet vkSet = TryAllocate(*it);
         if (vkSet != VK_NULL_HANDLE)
         {
-            VkDescriptorPool vkPool = *it;
-            // Move the pool to the front
-            if (it != m_Pools.begin())
-            {
-                std::swap(*it, m_Pools.front());
-            }
-
-#ifdef DILIGENT_DEVELOPMENT
-            ++m_AllocatedSetCounter;
-#endif
-            return {vkSet, vkPool, CommandQueueMask, *this};
+            Cache.Pool = std::move(*it);
+            m_Pools.erase(it);
+            Cache.NumAcquiredPools.fetch_add(1, std::memory_order_relaxed);
+            return OnAllocated(vkSet);
         }
     }
 
     // Failed to allocate descriptor from existing pools -> create a new one
+    VulkanUtilities::DescriptorPoolWrapper NewPool = CreateDescriptorPool("Descriptor pool");
+    if (!NewPool)
+        return {};
+
     LOG_INFO_MESSAGE("Allocated new descriptor pool");
-    m_Pools.emplace_front(CreateDescriptorPool("Descriptor pool"));
+    Cache.Pool = std::move(NewPool);
+    Cache.NumAcquiredPools.fetch_add(1, std::memory_order_relaxed);
 
-    VulkanUtilities::DescriptorPoolWrapper& NewPool = m_Pools.front();
-    VkDescriptorSet                         vkSet   = AllocateDescriptorSet(LogicalDevice, NewPool, SetLayout, DebugName);
+    VkDescriptorSet vkSet = TryAllocate(Cache.Pool);
     DEV_CHECK_ERR(vkSet != VK_NULL_HANDLE, "Failed to allocate descriptor set");
 
-#ifdef DILIGENT_DEVELOPMENT
-    ++m_AllocatedSetCounter;
-#endif
+    return OnAllocated(vkSet);
+}
+
+void DescriptorSetAllocator::ReleaseIdleThreadPools(Uint32 MaxIdleFrames)
+{
+    const Uint64 FrameNumber = m_FrameNumber.fetch_add(1, std::memory_order_relaxed) + 1;
 
-    return {vkSet, NewPool, CommandQueueMask, *this};
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    for (const std::shared_ptr<ThreadCache>& pCache : m_ThreadCaches)
+    {
+        if (FrameNumber - pCache->LastAllocationFrame.load(std::memory_order_relaxed) <= MaxIdleFrames)
+            continue;
+
+        // The thread may resume allocating at any time, in which case
+        // it will take a pool from the shared list.
+        std::lock_guard<std::mutex> CacheLock{pCache->PoolMtx};
+        if (pCache->Pool)
+            m_Pools.emplace_back(std::move(pCache->Pool));
+    }
+}
+
+std::vector<DescriptorSetAllocator::ThreadAllocationStats> DescriptorSetAllocator::GetThreadAllocationStats()
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    std::vector<ThreadAllocationStats> Stats;
+    Stats.reserve(m_ThreadCaches.size());
+    for (const std::shared_ptr<ThreadCache>& Cache : m_ThreadCaches)
+    {
+        ThreadAllocationStats ThreadStats;
+        ThreadStats.ThreadId         = Cache->ThreadId;
+        ThreadStats.NumAllocatedSets = Cache->NumAllocatedSets.load(std::memory_order_relaxed);
+        ThreadStats.NumAcquiredPools = Cache->NumAcquiredPools.load(std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> CacheLock{Cache->PoolMtx};
+            ThreadStats.OwnsPool = Cache->Pool != VK_NULL_HANDLE;
+        }
+        Stats.push_back(ThreadStats);
+    }
+    return Stats;
 }
 
 void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptorPool Pool, Uint64 QueueMask)
@@ -270,7 +456,7 @@ void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptor
         {
             if (Allocator != nullptr)
             {
-                std::lock_guard<std::mutex> Lock{Allocator->m_Mutex};
+                std::lock_guard<std::mutex> Lock{Allocator->GetPoolMutex(Pool)};
                 Allocator->m_DeviceVkImpl.GetLogicalDevice().FreeDescriptorSet(Pool, Set);
 #ifdef DILIGENT_DEVELOPMENT
                 --Allocator->m_AllocatedSetCounter;
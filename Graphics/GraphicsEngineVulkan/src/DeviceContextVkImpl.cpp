@@ -597,7 +597,7 @@ void DeviceContextVkImpl::CommitShaderResources(IShaderResourceBinding* pShaderR
         vkDynamicDescrSet = AllocateDynamicDescriptorSet(vkLayout, DynamicDescrSetName);
 
         // Write all dynamic resource descriptors
-        pSignature->CommitDynamicResources(ResourceCache, vkDynamicDescrSet);
+        pSignature->CommitDynamicResources(ResourceCache, vkDynamicDescrSet, m_DescriptorTemplateData);
 
         SetInfo.vkSets[DSIndex] = vkDynamicDescrSet;
         ++DSIndex;
@@ -112,6 +112,39 @@ Uint32 FindImmutableSamplerVk(const PipelineResourceDesc&          Res,
     return FindImmutableSampler(Desc.ImmutableSamplers, Desc.NumImmutableSamplers, Res.ShaderStages, Res.Name, SamplerSuffix);
 }
 
+bool IsUpdateAfterBindSupported(DescriptorType DescrType, const VkPhysicalDeviceDescriptorIndexingFeaturesEXT& DescrIndexingFeats)
+{
+    static_assert(static_cast<Uint32>(DescriptorType::Count) == 16, "Please update the switch below to handle the new descriptor type");
+    switch (DescrType)
+    {
+        case DescriptorType::Sampler:
+        case DescriptorType::CombinedImageSampler:
+        case DescriptorType::SeparateImage:
+            return DescrIndexingFeats.descriptorBindingSampledImageUpdateAfterBind != VK_FALSE;
+
+        case DescriptorType::StorageImage:
+            return DescrIndexingFeats.descriptorBindingStorageImageUpdateAfterBind != VK_FALSE;
+
+        case DescriptorType::UniformTexelBuffer:
+            return DescrIndexingFeats.descriptorBindingUniformTexelBufferUpdateAfterBind != VK_FALSE;
+
+        case DescriptorType::StorageTexelBuffer:
+        case DescriptorType::StorageTexelBuffer_ReadOnly:
+            return DescrIndexingFeats.descriptorBindingStorageTexelBufferUpdateAfterBind != VK_FALSE;
+
+        case DescriptorType::UniformBuffer:
+            return DescrIndexingFeats.descriptorBindingUniformBufferUpdateAfterBind != VK_FALSE;
+
+        case DescriptorType::StorageBuffer:
+        case DescriptorType::StorageBuffer_ReadOnly:
+            return DescrIndexingFeats.descriptorBindingStorageBufferUpdateAfterBind != VK_FALSE;
+
+        default:
+            // Dynamic buffers, input attachments and acceleration structures can't be updated after bind
+            return false;
+    }
+}
+
 } // namespace
 
 inline PipelineResourceSignatureVkImpl::CACHE_GROUP PipelineResourceSignatureVkImpl::GetResourceCacheGroup(const PipelineResourceDesc& Res)
@@ -246,6 +279,8 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts(const bool IsSerialized)
     Uint32 StaticCacheOffset = 0;
 
     std::array<std::vector<VkDescriptorSetLayoutBinding>, DESCRIPTOR_SET_ID_NUM_SETS> vkSetLayoutBindings;
+    // Binding flags for every binding in vkSetLayoutBindings
+    std::array<std::vector<VkDescriptorBindingFlagsEXT>, DESCRIPTOR_SET_ID_NUM_SETS> vkSetLayoutBindingFlags;
 
     DynamicLinearAllocator TempAllocator{GetRawAllocator(), 256};
 
@@ -333,6 +368,22 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts(const bool IsSerialized)
         vkSetLayoutBinding.descriptorType     = DescriptorTypeToVkDescriptorType(pAttribs->GetDescriptorType());
         vkSetLayoutBindings[SetId].push_back(vkSetLayoutBinding);
 
+        if ((ResDesc.Flags & PIPELINE_RESOURCE_FLAG_UPDATE_AFTER_BIND) != 0)
+        {
+            VERIFY(ResDesc.VarType == SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, "Only mutable resources can be updated after bind. This error should've been caught by ValidatePipelineResourceSignatureDesc.");
+            if (HasDevice() && !IsUpdateAfterBindSupported(DescrType, GetDevice()->GetLogicalDevice().GetEnabledExtFeatures().DescriptorIndexing))
+            {
+                LOG_ERROR_AND_THROW("Description of pipeline resource signature '", m_Desc.Name, "' is invalid: resource '", ResDesc.Name,
+                                    "' uses UPDATE_AFTER_BIND flag, but this device does not support update-after-bind for descriptors of this type.");
+            }
+            vkSetLayoutBindingFlags[SetId].push_back(VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT);
+            m_StaticMutableSetUpdateAfterBind = true;
+        }
+        else
+        {
+            vkSetLayoutBindingFlags[SetId].push_back(0);
+        }
+
         if (ResDesc.VarType == SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
         {
             VERIFY(pAttribs->DescrSet == 0, "Static resources must always be allocated in descriptor set 0");
@@ -425,6 +476,7 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts(const bool IsSerialized)
         vkSetLayoutBinding.descriptorType     = VK_DESCRIPTOR_TYPE_SAMPLER;
         vkSetLayoutBinding.pImmutableSamplers = TempAllocator.Construct<VkSampler>(pSamplerVk ? pSamplerVk->GetVkSampler() : VK_NULL_HANDLE);
         vkSetLayoutBindings[SetId].push_back(vkSetLayoutBinding);
+        vkSetLayoutBindingFlags[SetId].push_back(0);
     }
 
     Uint32 NumSets = 0;
@@ -452,11 +504,13 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts(const bool IsSerialized)
     (void)NumSets;
 #endif
 
-    VkDescriptorSetLayoutCreateInfo SetLayoutCI = {};
-
-    SetLayoutCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-    SetLayoutCI.pNext = nullptr;
-    SetLayoutCI.flags = 0;
+    if (m_StaticMutableSetUpdateAfterBind &&
+        (BindingCount[CACHE_GROUP_DYN_UB_STAT_VAR] != 0 || BindingCount[CACHE_GROUP_DYN_SB_STAT_VAR] != 0))
+    {
+        // VUID-VkDescriptorSetLayoutCreateInfo-descriptorType-03001
+        LOG_ERROR_AND_THROW("Description of pipeline resource signature '", m_Desc.Name,
+                            "' is invalid: static and mutable buffers must use NO_DYNAMIC_BUFFERS flag when the signature contains update-after-bind resources.");
+    }
 
     if (HasDevice())
     {
@@ -468,14 +522,128 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts(const bool IsSerialized)
             if (vkSetLayoutBinding.empty())
                 continue;
 
+            VkDescriptorSetLayoutCreateInfo SetLayoutCI = {};
+
+            SetLayoutCI.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+            SetLayoutCI.pNext        = nullptr;
+            SetLayoutCI.flags        = 0;
             SetLayoutCI.bindingCount = StaticCast<uint32_t>(vkSetLayoutBinding.size());
             SetLayoutCI.pBindings    = vkSetLayoutBinding.data();
-            m_VkDescrSetLayouts[i]   = LogicalDevice.CreateDescriptorSetLayout(SetLayoutCI);
+
+            VkDescriptorSetLayoutBindingFlagsCreateInfoEXT BindingFlagsCI = {};
+            if (i == DESCRIPTOR_SET_ID_STATIC_MUTABLE && m_StaticMutableSetUpdateAfterBind)
+            {
+                std::vector<VkDescriptorBindingFlagsEXT>& vkBindingFlags = vkSetLayoutBindingFlags[i];
+                VERIFY_EXPR(vkBindingFlags.size() == vkSetLayoutBinding.size());
+                const VkPhysicalDeviceDescriptorIndexingFeaturesEXT& DescrIndexingFeats = LogicalDevice.GetEnabledExtFeatures().DescriptorIndexing;
+
+                VkDescriptorBindingFlagsEXT ExtraFlags = 0;
+                // VUID-VkDescriptorSetLayoutBindingFlagsCreateInfo-descriptorBindingUpdateUnusedWhilePending-03012
+                if (DescrIndexingFeats.descriptorBindingUpdateUnusedWhilePending != VK_FALSE)
+                    ExtraFlags |= VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
+                // VUID-VkDescriptorSetLayoutBindingFlagsCreateInfo-descriptorBindingPartiallyBound-03013
+                if (DescrIndexingFeats.descriptorBindingPartiallyBound != VK_FALSE)
+                    ExtraFlags |= VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT;
+
+                for (VkDescriptorBindingFlagsEXT& Flags : vkBindingFlags)
+                {
+                    if (Flags & VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT)
+                        Flags |= ExtraFlags;
+                }
+
+                BindingFlagsCI.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+                BindingFlagsCI.pNext         = nullptr;
+                BindingFlagsCI.bindingCount  = SetLayoutCI.bindingCount;
+                BindingFlagsCI.pBindingFlags = vkBindingFlags.data();
+
+                SetLayoutCI.pNext = &BindingFlagsCI;
+                SetLayoutCI.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+            }
+
+            m_VkDescrSetLayouts[i] = LogicalDevice.CreateDescriptorSetLayout(SetLayoutCI);
         }
         VERIFY_EXPR(NumSets == GetNumDescriptorSets());
+
+        if (GetDevice()->GetVkVersion() >= VK_API_VERSION_1_1)
+        {
+            if (HasDescriptorSet(DESCRIPTOR_SET_ID_STATIC_MUTABLE) && m_pStaticResCache != nullptr)
+                CreateSetUpdateTemplate(DESCRIPTOR_SET_ID_STATIC_MUTABLE, SHADER_RESOURCE_VARIABLE_TYPE_STATIC);
+            if (HasDescriptorSet(DESCRIPTOR_SET_ID_DYNAMIC))
+                CreateSetUpdateTemplate(DESCRIPTOR_SET_ID_DYNAMIC, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+        }
     }
 }
 
+void PipelineResourceSignatureVkImpl::CreateSetUpdateTemplate(DESCRIPTOR_SET_ID SetId, SHADER_RESOURCE_VARIABLE_TYPE VarType)
+{
+    VERIFY_EXPR(VarTypeToDescriptorSetId(VarType) == SetId);
+
+    // Every resource is written from the record at its SRB cache offset, see
+    // ShaderResourceCacheVk::WriteDescriptorTemplateData().
+    std::vector<VkDescriptorUpdateTemplateEntry> Entries;
+
+    const std::pair<Uint32, Uint32> ResIdxRange = GetResourceIndexRange(VarType);
+    for (Uint32 r = ResIdxRange.first; r < ResIdxRange.second; ++r)
+    {
+        const ResourceAttribs& Attr      = GetResourceAttribs(r);
+        const DescriptorType   DescrType = Attr.GetDescriptorType();
+        // Immutable samplers are permanently bound into the set layout
+        if (DescrType == DescriptorType::Sampler && Attr.IsImmutableSamplerAssigned())
+            continue;
+
+        VkDescriptorUpdateTemplateEntry Entry{};
+        Entry.dstBinding      = Attr.BindingIndex;
+        Entry.dstArrayElement = 0;
+        Entry.descriptorCount = Attr.ArraySize;
+        Entry.descriptorType  = DescriptorTypeToVkDescriptorType(DescrType);
+        Entry.offset          = size_t{Attr.CacheOffset(ResourceCacheContentType::SRB)} * sizeof(ShaderResourceCacheVk::DescriptorTemplateData);
+        Entry.stride          = sizeof(ShaderResourceCacheVk::DescriptorTemplateData);
+        Entries.push_back(Entry);
+    }
+
+    if (Entries.empty())
+        return;
+
+    VkDescriptorUpdateTemplateCreateInfo TemplateCI{};
+    TemplateCI.sType                      = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+    TemplateCI.descriptorUpdateEntryCount = StaticCast<uint32_t>(Entries.size());
+    TemplateCI.pDescriptorUpdateEntries   = Entries.data();
+    TemplateCI.templateType               = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+    TemplateCI.descriptorSetLayout        = m_VkDescrSetLayouts[SetId];
+
+    std::string TemplateName{m_Desc.Name};
+    TemplateName.append(SetId == DESCRIPTOR_SET_ID_DYNAMIC ? " - dynamic set update template" : " - static set update template");
+    m_VkSetUpdateTemplates[SetId] = GetDevice()->GetLogicalDevice().CreateDescriptorUpdateTemplate(TemplateCI, TemplateName.c_str());
+}
+
+bool PipelineResourceSignatureVkImpl::WriteDescriptorTemplateData(const ShaderResourceCacheVk&                                ResourceCache,
+                                                                  SHADER_RESOURCE_VARIABLE_TYPE                               VarType,
+                                                                  std::vector<ShaderResourceCacheVk::DescriptorTemplateData>& TemplateData) const
+{
+    VERIFY_EXPR(ResourceCache.GetContentType() == ResourceCacheContentType::SRB);
+
+    const Uint32 SetIdx = VarTypeToDescriptorSetId(VarType) == DESCRIPTOR_SET_ID_DYNAMIC ?
+        GetDescriptorSetIndex<DESCRIPTOR_SET_ID_DYNAMIC>() :
+        GetDescriptorSetIndex<DESCRIPTOR_SET_ID_STATIC_MUTABLE>();
+
+    const Uint32 SetSize = ResourceCache.GetDescriptorSet(SetIdx).GetSize();
+    if (TemplateData.size() < SetSize)
+        TemplateData.resize(SetSize);
+
+    const std::pair<Uint32, Uint32> ResIdxRange = GetResourceIndexRange(VarType);
+    for (Uint32 r = ResIdxRange.first; r < ResIdxRange.second; ++r)
+    {
+        const ResourceAttribs& Attr = GetResourceAttribs(r);
+        if (Attr.GetDescriptorType() == DescriptorType::Sampler && Attr.IsImmutableSamplerAssigned())
+            continue;
+
+        if (!ResourceCache.WriteDescriptorTemplateData(SetIdx, Attr.CacheOffset(ResourceCacheContentType::SRB), Attr.ArraySize, TemplateData.data()))
+            return false;
+    }
+
+    return true;
+}
+
 PipelineResourceSignatureVkImpl::~PipelineResourceSignatureVkImpl()
 {
     Destruct();
@@ -483,6 +651,12 @@ PipelineResourceSignatureVkImpl::~PipelineResourceSignatureVkImpl()
 
 void PipelineResourceSignatureVkImpl::Destruct()
 {
+    for (VulkanUtilities::DescriptorUpdateTemplateWrapper& Template : m_VkSetUpdateTemplates)
+    {
+        if (Template)
+            GetDevice()->SafeReleaseDeviceObject(std::move(Template), ~0ull);
+    }
+
     for (VulkanUtilities::DescriptorSetLayoutWrapper& Layout : m_VkDescrSetLayouts)
     {
         if (Layout)
@@ -525,7 +699,11 @@ void PipelineResourceSignatureVkImpl::InitSRBResourceCache(ShaderResourceCacheVk
         _DescrSetName.append(" - static/mutable set");
         DescrSetName = _DescrSetName.c_str();
 #endif
-        DescriptorSetAllocation SetAllocation = GetDevice()->AllocateDescriptorSet(~Uint64{0}, vkLayout, DescrSetName);
+        DescriptorSetAllocation SetAllocation = m_StaticMutableSetUpdateAfterBind ?
+            GetDevice()->AllocateUpdateAfterBindDescriptorSet(~Uint64{0}, vkLayout, DescrSetName) :
+            GetDevice()->AllocateDescriptorSet(~Uint64{0}, vkLayout, DescrSetName);
+        if (!SetAllocation)
+            LOG_ERROR_AND_THROW("Failed to allocate static/mutable descriptor set for pipeline resource signature '", m_Desc.Name, "'.");
         ResourceCache.AssignDescriptorSetAllocation(GetDescriptorSetIndex<DESCRIPTOR_SET_ID_STATIC_MUTABLE>(), std::move(SetAllocation));
     }
 }
@@ -546,6 +724,26 @@ void PipelineResourceSignatureVkImpl::CopyStaticResources(ShaderResourceCacheVk&
     const ResourceCacheContentType              SrcCacheType     = SrcResourceCache.GetContentType();
     const ResourceCacheContentType              DstCacheType     = DstResourceCache.GetContentType();
 
+    // When static resources are copied to an SRB, its descriptor set is written with the
+    // update template after all resources have been set in the cache. The template writes every
+    // descriptor, so if any static resource is not initialized, descriptors are written individually.
+    bool UseTemplate = (m_VkSetUpdateTemplates[DESCRIPTOR_SET_ID_STATIC_MUTABLE] &&
+                        DstCacheType == ResourceCacheContentType::SRB &&
+                        DstDescrSet.GetVkDescriptorSet() != VK_NULL_HANDLE);
+    for (Uint32 r = ResIdxRange.first; r < ResIdxRange.second && UseTemplate; ++r)
+    {
+        const ResourceAttribs& Attr = GetResourceAttribs(r);
+        if (Attr.GetDescriptorType() == DescriptorType::Sampler && Attr.IsImmutableSamplerAssigned())
+            continue;
+
+        const Uint32 SrcCacheOffset = Attr.CacheOffset(SrcCacheType);
+        for (Uint32 ArrInd = 0; ArrInd < Attr.ArraySize && UseTemplate; ++ArrInd)
+            UseTemplate = !SrcDescrSet.GetResource(SrcCacheOffset + ArrInd).IsNull();
+    }
+
+    const VulkanUtilities::LogicalDevice& LogicalDevice  = GetDevice()->GetLogicalDevice();
+    const VulkanUtilities::LogicalDevice* pLogicalDevice = UseTemplate ? nullptr : &LogicalDevice;
+
     for (Uint32 r = ResIdxRange.first; r < ResIdxRange.second; ++r)
     {
         const PipelineResourceDesc& ResDesc = GetResourceDesc(r);
@@ -575,7 +773,7 @@ void PipelineResourceSignatureVkImpl::CopyStaticResources(ShaderResourceCacheVk&
             if (pCachedResource != pObject)
             {
                 DEV_CHECK_ERR(pCachedResource == nullptr, "Static resource has already been initialized, and the new resource does not match previously assigned resource");
-                DstResourceCache.SetResource(&GetDevice()->GetLogicalDevice(),
+                DstResourceCache.SetResource(pLogicalDevice,
                                              StaticSetIdx,
                                              DstCacheOffset,
                                              {
@@ -589,6 +787,17 @@ void PipelineResourceSignatureVkImpl::CopyStaticResources(ShaderResourceCacheVk&
         }
     }
 
+    if (UseTemplate)
+    {
+        // Scratch storage is reused by all SRBs created on this thread
+        static thread_local std::vector<ShaderResourceCacheVk::DescriptorTemplateData> TemplateData;
+
+        const bool AllResourcesWritten = WriteDescriptorTemplateData(DstResourceCache, SHADER_RESOURCE_VARIABLE_TYPE_STATIC, TemplateData);
+        VERIFY(AllResourcesWritten, "All static resources are initialized, so template data must be written for each of them");
+        (void)AllResourcesWritten;
+        LogicalDevice.UpdateDescriptorSetWithTemplate(DstDescrSet.GetVkDescriptorSet(), m_VkSetUpdateTemplates[DESCRIPTOR_SET_ID_STATIC_MUTABLE], TemplateData.data());
+    }
+
 #ifdef DILIGENT_DEBUG
     DstResourceCache.DbgVerifyDynamicBuffersCounter();
 #endif
@@ -608,13 +817,28 @@ Uint32 PipelineResourceSignatureVkImpl::GetDescriptorSetIndex<PipelineResourceSi
     return HasDescriptorSet(DESCRIPTOR_SET_ID_STATIC_MUTABLE) ? 1 : 0;
 }
 
-void PipelineResourceSignatureVkImpl::CommitDynamicResources(const ShaderResourceCacheVk& ResourceCache,
-                                                             VkDescriptorSet              vkDynamicDescriptorSet) const
+void PipelineResourceSignatureVkImpl::CommitDynamicResources(const ShaderResourceCacheVk&                                ResourceCache,
+                                                             VkDescriptorSet                                             vkDynamicDescriptorSet,
+                                                             std::vector<ShaderResourceCacheVk::DescriptorTemplateData>& TemplateData) const
 {
     VERIFY(HasDescriptorSet(DESCRIPTOR_SET_ID_DYNAMIC), "This signature does not contain dynamic resources");
     VERIFY_EXPR(vkDynamicDescriptorSet != VK_NULL_HANDLE);
     VERIFY_EXPR(ResourceCache.GetContentType() == ResourceCacheContentType::SRB);
 
+    const Uint32                          DynamicSetIdx = GetDescriptorSetIndex<DESCRIPTOR_SET_ID_DYNAMIC>();
+    const VulkanUtilities::LogicalDevice& LogicalDevice = GetDevice()->GetLogicalDevice();
+
+    if (const VulkanUtilities::DescriptorUpdateTemplateWrapper& Template = m_VkSetUpdateTemplates[DESCRIPTOR_SET_ID_DYNAMIC])
+    {
+        // Descriptor update template writes every array element, so if any resource is null,
+        // fall back to individual descriptor writes that skip null elements.
+        if (WriteDescriptorTemplateData(ResourceCache, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC, TemplateData))
+        {
+            LogicalDevice.UpdateDescriptorSetWithTemplate(vkDynamicDescriptorSet, Template, TemplateData.data());
+            return;
+        }
+    }
+
 #ifdef DILIGENT_DEBUG
     static constexpr size_t ImgUpdateBatchSize          = 4;
     static constexpr size_t BuffUpdateBatchSize         = 2;
@@ -642,9 +866,7 @@ void PipelineResourceSignatureVkImpl::CommitDynamicResources(const ShaderResourc
     auto AccelStructIt   = DescrAccelStructArr.begin();
     auto WriteDescrSetIt = WriteDescrSetArr.begin();
 
-    const Uint32                                DynamicSetIdx  = GetDescriptorSetIndex<DESCRIPTOR_SET_ID_DYNAMIC>();
     const ShaderResourceCacheVk::DescriptorSet& SetResources   = ResourceCache.GetDescriptorSet(DynamicSetIdx);
-    const VulkanUtilities::LogicalDevice&       LogicalDevice  = GetDevice()->GetLogicalDevice();
     const std::pair<Uint32, Uint32>             DynResIdxRange = GetResourceIndexRange(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
 
     constexpr ResourceCacheContentType CacheType = ResourceCacheContentType::SRB;
@@ -828,6 +1050,12 @@ bool PipelineResourceSignatureVkImpl::DvpValidateCommittedResource(const DeviceC
         const ShaderResourceCacheVk::Resource& Res = DescrSetResources.GetResource(CacheOffset + ArrIndex);
         if (Res.IsNull())
         {
+            // Update-after-bind resources are partially bound when the device supports it,
+            // so only the elements accessed by the shader must be valid
+            if ((ResDesc.Flags & PIPELINE_RESOURCE_FLAG_UPDATE_AFTER_BIND) != 0 &&
+                GetDevice()->GetLogicalDevice().GetEnabledExtFeatures().DescriptorIndexing.descriptorBindingPartiallyBound != VK_FALSE)
+                continue;
+
             LOG_ERROR_MESSAGE("No resource is bound to variable '", GetShaderResourcePrintName(SPIRVAttribs, ArrIndex),
                               "' in shader '", ShaderName, "' of PSO '", PSOName, "'");
             BindingsOK = false;
@@ -53,9 +53,93 @@
 #include "EngineMemory.h"
 #include "QueryManagerVk.hpp"
 
+#include <algorithm>
+#include <functional>
+
 namespace Diligent
 {
 
+namespace
+{
+
+// Dynamic buffers, input attachments and acceleration structures can't be used in update-after-bind sets.
+// Pool sizes are clamped to the device update-after-bind limits: a pool never needs to hold more descriptors
+// of one type than a single stage may access, and the total number of descriptors in all update-after-bind
+// pools is limited by maxUpdateAfterBindDescriptorsInAllPools.
+std::vector<VkDescriptorPoolSize> GetUpdateAfterBindPoolSizes(const VulkanDescriptorPoolSize&                        PoolSize,
+                                                              const VkPhysicalDeviceDescriptorIndexingPropertiesEXT& Props)
+{
+    // clang-format off
+    std::vector<VkDescriptorPoolSize> PoolSizes
+    {
+        {VK_DESCRIPTOR_TYPE_SAMPLER,                PoolSize.NumSeparateSamplerDescriptors},
+        {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, PoolSize.NumCombinedSamplerDescriptors},
+        {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,          PoolSize.NumSampledImageDescriptors},
+        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          PoolSize.NumStorageImageDescriptors},
+        {VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER,   PoolSize.NumUniformTexelBufferDescriptors},
+        {VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER,   PoolSize.NumStorageTexelBufferDescriptors},
+        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,         PoolSize.NumUniformBufferDescriptors},
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         PoolSize.NumStorageBufferDescriptors}
+    };
+    // clang-format on
+
+    auto GetPerStageLimit = [&Props](VkDescriptorType Type) -> uint32_t {
+        switch (Type)
+        {
+            case VK_DESCRIPTOR_TYPE_SAMPLER:
+                return Props.maxPerStageDescriptorUpdateAfterBindSamplers;
+
+            case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+                return std::min(Props.maxPerStageDescriptorUpdateAfterBindSamplers, Props.maxPerStageDescriptorUpdateAfterBindSampledImages);
+
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+            case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+                return Props.maxPerStageDescriptorUpdateAfterBindSampledImages;
+
+            case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+            case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+                return Props.maxPerStageDescriptorUpdateAfterBindStorageImages;
+
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+                return Props.maxPerStageDescriptorUpdateAfterBindUniformBuffers;
+
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+                return Props.maxPerStageDescriptorUpdateAfterBindStorageBuffers;
+
+            default:
+                UNEXPECTED("Unexpected descriptor type");
+                return 0;
+        }
+    };
+
+    // Zero limits mean that descriptor indexing is not supported, in which case
+    // update-after-bind sets are never allocated and the sizes are irrelevant.
+    Uint64 TotalDescriptors = 0;
+    for (VkDescriptorPoolSize& Size : PoolSizes)
+    {
+        const uint32_t Limit = GetPerStageLimit(Size.type);
+        if (Limit != 0)
+            Size.descriptorCount = std::min(Size.descriptorCount, Limit);
+        TotalDescriptors += Size.descriptorCount;
+    }
+
+    const uint32_t MaxInAllPools = Props.maxUpdateAfterBindDescriptorsInAllPools;
+    if (MaxInAllPools != 0 && TotalDescriptors > MaxInAllPools)
+    {
+        // Scale all sizes down proportionally so that at least one pool fits into the limit.
+        // The total size of all pools is tracked by the descriptor pool manager.
+        for (VkDescriptorPoolSize& Size : PoolSizes)
+        {
+            const Uint64 Count   = static_cast<Uint64>(Size.descriptorCount) * MaxInAllPools / TotalDescriptors;
+            Size.descriptorCount = std::max(static_cast<uint32_t>(Count), Size.descriptorCount != 0 ? 1u : 0u);
+        }
+    }
+
+    return PoolSizes;
+}
+
+} // namespace
+
 RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*                              pRefCounters,
                                        IMemoryAllocator&                                RawMemAllocator,
                                        IEngineFactory*                                  pEngineFactory,
@@ -107,6 +191,15 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
         EngineCI.MainDescriptorPoolSize.MaxDescriptorSets,
         true
     },
+    m_UpdateAfterBindDescriptorSetAllocator
+    {
+        *this,
+        "Update-after-bind descriptor pool",
+        GetUpdateAfterBindPoolSizes(EngineCI.MainDescriptorPoolSize, m_PhysicalDevice->GetExtProperties().DescriptorIndexing),
+        EngineCI.MainDescriptorPoolSize.MaxDescriptorSets,
+        true,
+        true // Update after bind
+    },
     m_DynamicDescriptorPool
     {
         *this,
@@ -156,7 +249,7 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
         m_ImplicitRenderPassCache = std::make_unique<RenderPassCache>(*this);
     }
 
-    static_assert(sizeof(VulkanDescriptorPoolSize) == sizeof(Uint32) * 11, "Please add new descriptors to m_DescriptorSetAllocator and m_DynamicDescriptorPool constructors");
+    static_assert(sizeof(VulkanDescriptorPoolSize) == sizeof(Uint32) * 11, "Please add new descriptors to m_DescriptorSetAllocator, m_UpdateAfterBindDescriptorSetAllocator and m_DynamicDescriptorPool constructors");
 
     const uint32_t vkVersion = m_PhysicalDevice->GetVkVersion();
     m_DeviceInfo.Type        = RENDER_DEVICE_TYPE_VULKAN;
@@ -225,6 +318,7 @@ RenderDeviceVkImpl::~RenderDeviceVkImpl()
     ReleaseStaleResources(true);
 
     DEV_CHECK_ERR(m_DescriptorSetAllocator.GetAllocatedDescriptorSetCounter() == 0, "All allocated descriptor sets must have been released now.");
+    DEV_CHECK_ERR(m_UpdateAfterBindDescriptorSetAllocator.GetAllocatedDescriptorSetCounter() == 0, "All allocated update-after-bind descriptor sets must have been released now.");
     DEV_CHECK_ERR(m_DynamicDescriptorPool.GetAllocatedPoolCounter() == 0, "All allocated dynamic descriptor pools must have been released now.");
     DEV_CHECK_ERR(m_DynamicMemoryManager.GetMasterBlockCounter() == 0, "All allocated dynamic master blocks must have been returned to the pool.");
 
@@ -462,6 +556,8 @@ void RenderDeviceVkImpl::ReleaseStaleResources(bool ForceRelease)
 {
     m_MemoryMgr.ShrinkMemory();
     PurgeReleaseQueues(ForceRelease);
+    m_DescriptorSetAllocator.ReleaseIdleThreadPools();
+    m_UpdateAfterBindDescriptorSetAllocator.ReleaseIdleThreadPools();
 }
 
 
@@ -837,4 +933,23 @@ void RenderDeviceVkImpl::GetDeviceFeaturesVk(DeviceFeaturesVk& FeaturesVk) const
     FeaturesVk = PhysicalDeviceFeaturesToDeviceFeaturesVk(m_LogicalDevice->GetEnabledExtFeatures());
 }
 
+Uint32 RenderDeviceVkImpl::GetDescriptorSetThreadStats(DescriptorSetThreadStatsVk* pStats, Uint32 MaxStats)
+{
+    const std::vector<DescriptorSetAllocator::ThreadAllocationStats> ThreadStats = m_DescriptorSetAllocator.GetThreadAllocationStats();
+    if (pStats != nullptr)
+    {
+        for (size_t i = 0; i < std::min(ThreadStats.size(), size_t{MaxStats}); ++i)
+        {
+            const DescriptorSetAllocator::ThreadAllocationStats& Src = ThreadStats[i];
+
+            DescriptorSetThreadStatsVk& Dst = pStats[i];
+            Dst.ThreadIdHash                = std::hash<std::thread::id>{}(Src.ThreadId);
+            Dst.NumAllocatedSets            = Src.NumAllocatedSets;
+            Dst.NumAcquiredPools            = Src.NumAcquiredPools;
+            Dst.OwnsPool                    = Src.OwnsPool;
+        }
+    }
+    return static_cast<Uint32>(ThreadStats.size());
+}
+
 } // namespace Diligent
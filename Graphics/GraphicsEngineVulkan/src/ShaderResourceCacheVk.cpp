@@ -329,10 +329,8 @@ const ShaderResourceCacheVk::Resource& ShaderResourceCacheVk::SetResource(
     }
 
     VkDescriptorSet vkSet = DescrSet.GetVkDescriptorSet();
-    if (vkSet != VK_NULL_HANDLE && DstRes.pObject)
+    if (vkSet != VK_NULL_HANDLE && DstRes.pObject && pLogicalDevice != nullptr)
     {
-        VERIFY(pLogicalDevice != nullptr, "Logical device must not be null to write descriptor to a non-null set");
-
         VkWriteDescriptorSet WriteDescrSet;
         WriteDescrSet.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         WriteDescrSet.pNext           = nullptr;
@@ -871,6 +869,70 @@ VkWriteDescriptorSetAccelerationStructureKHR ShaderResourceCacheVk::Resource::Ge
 }
 
 
+bool ShaderResourceCacheVk::WriteDescriptorTemplateData(Uint32                  DescrSetIndex,
+                                                        Uint32                  CacheOffset,
+                                                        Uint32                  NumDescriptors,
+                                                        DescriptorTemplateData* pData) const
+{
+    const DescriptorSet& DescrSet = GetDescriptorSet(DescrSetIndex);
+    VERIFY_EXPR(CacheOffset + NumDescriptors <= DescrSet.GetSize());
+    for (Uint32 Offset = CacheOffset; Offset < CacheOffset + NumDescriptors; ++Offset)
+    {
+        const Resource& Res = DescrSet.GetResource(Offset);
+        VERIFY(!(Res.Type == DescriptorType::Sampler && Res.HasImmutableSampler), "Immutable samplers are part of the set layout and must not be written");
+
+        if (Res.IsNull())
+            return false;
+
+        DescriptorTemplateData& Data = pData[Offset];
+
+        static_assert(static_cast<Uint32>(DescriptorType::Count) == 16, "Please update the switch below to handle the new descriptor type");
+        switch (Res.Type)
+        {
+            case DescriptorType::Sampler:
+                Data.ImageInfo = Res.GetSamplerDescriptorWriteInfo();
+                break;
+
+            case DescriptorType::CombinedImageSampler:
+            case DescriptorType::SeparateImage:
+            case DescriptorType::StorageImage:
+                Data.ImageInfo = Res.GetImageDescriptorWriteInfo();
+                break;
+
+            case DescriptorType::UniformTexelBuffer:
+            case DescriptorType::StorageTexelBuffer:
+            case DescriptorType::StorageTexelBuffer_ReadOnly:
+                Data.BufferView = Res.GetBufferViewWriteInfo();
+                break;
+
+            case DescriptorType::UniformBuffer:
+            case DescriptorType::UniformBufferDynamic:
+                Data.BufferInfo = Res.GetUniformBufferDescriptorWriteInfo();
+                break;
+
+            case DescriptorType::StorageBuffer:
+            case DescriptorType::StorageBuffer_ReadOnly:
+            case DescriptorType::StorageBufferDynamic:
+            case DescriptorType::StorageBufferDynamic_ReadOnly:
+                Data.BufferInfo = Res.GetStorageBufferDescriptorWriteInfo();
+                break;
+
+            case DescriptorType::InputAttachment:
+            case DescriptorType::InputAttachment_General:
+                Data.ImageInfo = Res.GetInputAttachmentDescriptorWriteInfo();
+                break;
+
+            case DescriptorType::AccelerationStructure:
+                Data.AccelStruct = Res.pObject.ConstPtr<TopLevelASVkImpl>()->GetVkTLAS();
+                break;
+
+            default:
+                UNEXPECTED("Unexpected descriptor type");
+        }
+    }
+
+    return true;
+}
 
 Uint32 ShaderResourceCacheVk::GetDynamicBufferOffsets(DeviceContextVkImpl*   pCtx,
                                                       std::vector<uint32_t>& Offsets,
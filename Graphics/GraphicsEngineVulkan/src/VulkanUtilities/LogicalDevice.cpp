@@ -438,6 +438,12 @@ PipelineCacheWrapper LogicalDevice::CreatePipelineCache(const VkPipelineCacheCre
     return CreateVulkanObject<VkPipelineCache, VulkanHandleTypeId::PipelineCache>(vkCreatePipelineCache, CI, DebugName, "pipeline cache");
 }
 
+DescriptorUpdateTemplateWrapper LogicalDevice::CreateDescriptorUpdateTemplate(const VkDescriptorUpdateTemplateCreateInfo& CI, const char* DebugName) const
+{
+    VERIFY_EXPR(CI.sType == VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO);
+    return CreateVulkanObject<VkDescriptorUpdateTemplate, VulkanHandleTypeId::DescriptorUpdateTemplate>(vkCreateDescriptorUpdateTemplate, CI, DebugName, "descriptor update template");
+}
+
 void LogicalDevice::ReleaseVulkanObject(CommandPoolWrapper&& CmdPool) const
 {
     vkDestroyCommandPool(m_VkDevice, CmdPool.m_VkObject, m_VkAllocator);
@@ -556,6 +562,12 @@ void LogicalDevice::ReleaseVulkanObject(PipelineCacheWrapper&& PipeCache) const
     PipeCache.m_VkObject = VK_NULL_HANDLE;
 }
 
+void LogicalDevice::ReleaseVulkanObject(DescriptorUpdateTemplateWrapper&& DescrUpdateTemplate) const
+{
+    vkDestroyDescriptorUpdateTemplate(m_VkDevice, DescrUpdateTemplate.m_VkObject, m_VkAllocator);
+    DescrUpdateTemplate.m_VkObject = VK_NULL_HANDLE;
+}
+
 void LogicalDevice::FreeDescriptorSet(VkDescriptorPool Pool, VkDescriptorSet Set) const
 {
     VERIFY_EXPR(Pool != VK_NULL_HANDLE && Set != VK_NULL_HANDLE);
@@ -698,6 +710,13 @@ void LogicalDevice::UpdateDescriptorSets(uint32_t                    descriptorW
     vkUpdateDescriptorSets(m_VkDevice, descriptorWriteCount, pDescriptorWrites, descriptorCopyCount, pDescriptorCopies);
 }
 
+void LogicalDevice::UpdateDescriptorSetWithTemplate(VkDescriptorSet            descriptorSet,
+                                                    VkDescriptorUpdateTemplate descriptorUpdateTemplate,
+                                                    const void*                pData) const
+{
+    vkUpdateDescriptorSetWithTemplate(m_VkDevice, descriptorSet, descriptorUpdateTemplate, pData);
+}
+
 VkResult LogicalDevice::ResetCommandPool(VkCommandPool           vkCmdPool,
                                          VkCommandPoolResetFlags flags) const
 {
@@ -29,8 +29,12 @@
 /// \file
 /// Definition of the Diligent::ReloadableShader class
 
+#include <string>
+#include <vector>
+
 #include "Shader.h"
 #include "ShaderBase.hpp"
+#include "XXH128Hasher.hpp"
 
 namespace Diligent
 {
@@ -48,10 +52,11 @@ public:
     static constexpr INTERFACE_ID IID_InternalImpl =
         {0x6bfaaabd, 0xfe55, 0x4420, {0xb0, 0xc8, 0x5c, 0x4b, 0x4f, 0x5f, 0x8d, 0x65}};
 
-    ReloadableShader(IReferenceCounters*     pRefCounters,
-                     RenderStateCacheImpl*   pStateCache,
-                     IShader*                pShader,
-                     const ShaderCreateInfo& CreateInfo);
+    ReloadableShader(IReferenceCounters*              pRefCounters,
+                     RenderStateCacheImpl*            pStateCache,
+                     IShader*                         pShader,
+                     const ShaderCreateInfo&          CreateInfo,
+                     IShaderSourceInputStreamFactory* pCompiledSourceFactory);
 
     ~ReloadableShader();
 
@@ -104,17 +109,39 @@ public:
         return m_pShader->GetStatus(WaitForCompletion);
     }
 
-    static void Create(RenderStateCacheImpl*   pStateCache,
-                       IShader*                pShader,
-                       const ShaderCreateInfo& CreateInfo,
-                       IShader**               ppReloadableShader);
+    // pCompiledSourceFactory is the source factory the internal shader was created with.
+    // It is used to record the initial state of the shader source files and may differ
+    // from the factory in CreateInfo if the cache uses a separate reload source.
+    static void Create(RenderStateCacheImpl*            pStateCache,
+                       IShader*                         pShader,
+                       const ShaderCreateInfo&          CreateInfo,
+                       IShaderSourceInputStreamFactory* pCompiledSourceFactory,
+                       IShader**                        ppReloadableShader);
+
+    /// Checks if any of the source files the shader depends on, including all
+    /// resolved includes, has changed since the shader was last (re)created.
+    bool HaveSourcesChanged() const;
 
     bool Reload();
 
+private:
+    void UpdateSourceDependencies(IShaderSourceInputStreamFactory* pSourceFactory);
+
 private:
     RefCntAutoPtr<RenderStateCacheImpl> m_pStateCache;
     RefCntAutoPtr<IShader>              m_pShader;
     ShaderCreateInfoWrapper             m_CreateInfo;
+
+    struct SourceDependency
+    {
+        std::string FilePath;
+        XXH128Hash  Hash;
+    };
+    // Source files the internal shader was compiled from, including resolved includes
+    std::vector<SourceDependency> m_SourceDependencies;
+
+    // False if the dependencies could not be resolved, in which case the shader is always reloaded
+    bool m_SourceDependenciesValid = false;
 };
 
 } // namespace Diligent
@@ -98,7 +98,9 @@ public:
 
     virtual void DILIGENT_CALL_TYPE Reset() override final;
 
-    virtual Uint32 DILIGENT_CALL_TYPE Reload(ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline, void* pUserData) override final;
+    virtual Uint32 DILIGENT_CALL_TYPE Reload(ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline,
+                                             void*                              pUserData,
+                                             RenderStateCacheReloadStats*       pStats) override final;
 
     virtual Uint32 DILIGENT_CALL_TYPE GetContentVersion() const override final
     {
@@ -139,6 +141,7 @@ private:
     const RENDER_DEVICE_TYPE                       m_DeviceType;
     const RenderStateCacheCreateInfo               m_CI;
     RefCntAutoPtr<IShaderSourceInputStreamFactory> m_pReloadSource;
+    RefCntAutoPtr<IThreadPool>                     m_pReloadThreadPool;
     RefCntAutoPtr<ISerializationDevice>            m_pSerializationDevice;
     RefCntAutoPtr<IArchiver>                       m_pArchiver;
     RefCntAutoPtr<IDearchiver>                     m_pDearchiver;
@@ -155,6 +158,9 @@ private:
     std::mutex                                                          m_ReloadablePipelinesMtx;
     std::unordered_map<UniqueIdentifier, RefCntWeakPtr<IPipelineState>> m_ReloadablePipelines;
 
+    // Serializes Reload() calls
+    std::mutex m_ReloadMtx;
+
     Uint32 m_ReloadVersion = 0;
 };
 
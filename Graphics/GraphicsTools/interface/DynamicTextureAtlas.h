@@ -176,6 +176,54 @@ struct IDynamicTextureAtlas : public IObject
     /// \param [in] Height - Region height.
     /// \return            - Allocation alignment.
     virtual Uint32 GetAllocationAlignment(Uint32 Width, Uint32 Height) const = 0;
+
+
+    /// Incrementally defragments the atlas.
+
+    /// \param[in]  pDevice               - A pointer to the render device that will be used to
+    ///                                    create the internal texture and a scratch texture.
+    ///                                    The scratch texture is kept by the atlas and reused
+    ///                                    by the subsequent calls. The device may be null if
+    ///                                    neither texture needs to be (re)created.
+    /// \param[in]  pContext              - A pointer to the device context that will be used to
+    ///                                    copy the contents of the moved suballocations.
+    /// \param[in]  MaxMoves              - The maximum number of suballocations to move.
+    /// \param[out] ppMovedSuballocations - An optional array of at least MaxMoves elements where
+    ///                                    pointers to the moved suballocations will be written.
+    ///                                    The pointers are not AddRef'ed.
+    /// \return     The number of moved suballocations. Zero indicates that no suballocation can
+    ///             be moved any lower, or that the scratch texture could not be created, in which
+    ///             case no suballocations are moved.
+    ///
+    /// The method moves the suballocations closest to the top of each slice to lower locations
+    /// and copies their contents in the texture. The origins and texture coordinate scale/bias
+    /// of the moved suballocations are updated, so an application must refresh any data that
+    /// depends on them.
+    ///
+    /// Mip levels in which the suballocation alignment is smaller than the texture format block
+    /// size are not copied. Suballocations whose alignment is smaller than the block size are
+    /// never moved.
+    ///
+    /// The method is not thread safe and must not be called concurrently with any other
+    /// method of the atlas or with releasing the suballocations.
+    virtual Uint32 Defragment(IRenderDevice*               pDevice,
+                              IDeviceContext*              pContext,
+                              Uint32                       MaxMoves,
+                              ITextureAtlasSuballocation** ppMovedSuballocations = nullptr) = 0;
+};
+
+
+/// Dynamic texture atlas packing mode, see Diligent::DynamicTextureAtlasCreateInfo::Packing.
+enum DYNAMIC_TEXTURE_ATLAS_PACKING : Uint8
+{
+    /// Free space is recursively split to allocate the regions and is merged back
+    /// when the regions are released. All released space is immediately reused.
+    DYNAMIC_TEXTURE_ATLAS_PACKING_TREE = 0,
+
+    /// The regions are placed as low as possible on top of the skyline formed by the
+    /// allocated regions. Allocation is cheaper than with the tree packing, but the space
+    /// released underneath other regions is only reclaimed by IDynamicTextureAtlas::Defragment().
+    DYNAMIC_TEXTURE_ATLAS_PACKING_SKYLINE
 };
 
 
@@ -238,6 +286,9 @@ struct DynamicTextureAtlasCreateInfo
     /// Maximum number of slices in texture array.
     Uint32 MaxSliceCount = 2048;
 
+    /// Packing mode, see Diligent::DYNAMIC_TEXTURE_ATLAS_PACKING.
+    DYNAMIC_TEXTURE_ATLAS_PACKING Packing = DYNAMIC_TEXTURE_ATLAS_PACKING_TREE;
+
     /// Silence allocation errors.
     bool Silent = false;
 };
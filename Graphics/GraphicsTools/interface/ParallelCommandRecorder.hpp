@@ -0,0 +1,160 @@
+/*
+ *  Copyright 2019-2025 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Definition of the Diligent::ParallelCommandRecorder class
+
+#include <vector>
+#include <functional>
+
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/CommandList.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/ThreadPool.h"
+
+namespace Diligent
+{
+
+/// Helper class that splits recording of a list of jobs (e.g. draw calls) between
+/// multiple deferred contexts using a thread pool.
+
+/// The jobs are split into chunks of consecutive jobs. Every chunk is recorded into
+/// its own command list, and the command lists are returned in the order of the jobs,
+/// so that executing them in the immediate context produces the same result as recording
+/// all jobs sequentially.
+///
+/// Every command list starts with the default context state, so the state the jobs rely on
+/// (render targets or render pass, viewports, scissor rects, etc.) must be set for every chunk
+/// by the RecordAttribs::BeginChunk callback. If the jobs are recorded inside a render pass,
+/// BeginChunk must begin the render pass (typically with ATTACHMENT_LOAD_OP_LOAD) and EndChunk must end it.
+///
+/// Resource state transitions are not thread-safe, so the jobs must use RESOURCE_STATE_TRANSITION_MODE_VERIFY
+/// or RESOURCE_STATE_TRANSITION_MODE_NONE modes. The required transitions should be performed in the
+/// immediate context before the jobs are recorded or, when the VERIFY mode is not used, by Execute()
+/// before the command lists are executed.
+///
+/// A typical frame looks like this:
+///
+///     pImmediateCtx->TransitionResourceStates(_countof(Barriers), Barriers);
+///     Recorder.Record(Attribs, CmdLists);
+///     ParallelCommandRecorder::Execute(pImmediateCtx, CmdLists);
+///     ...
+///     Recorder.FinishFrame();
+///
+/// \note In Metal backend, FinishFrame() must be called in the thread that recorded the commands
+///       into the deferred context, so the helper should not be used with a thread pool in this backend.
+class ParallelCommandRecorder
+{
+public:
+    struct CreateInfo
+    {
+        /// Deferred contexts to record commands with.
+        /// At most one thread records commands into every context at a time.
+        IDeviceContext* const* ppDeferredContexts = nullptr;
+
+        /// The number of deferred contexts in ppDeferredContexts array.
+        Uint32 NumDeferredContexts = 0;
+
+        /// Thread pool that runs the recording tasks.
+        /// If null, all jobs are recorded in the calling thread.
+        IThreadPool* pThreadPool = nullptr;
+    };
+
+    explicit ParallelCommandRecorder(const CreateInfo& CI);
+
+    // clang-format off
+    ParallelCommandRecorder           (const ParallelCommandRecorder&) = delete;
+    ParallelCommandRecorder& operator=(const ParallelCommandRecorder&) = delete;
+    ParallelCommandRecorder           (ParallelCommandRecorder&&)      = default;
+    ParallelCommandRecorder& operator=(ParallelCommandRecorder&&)      = delete;
+    // clang-format on
+
+    struct RecordAttribs
+    {
+        /// The number of jobs to record.
+        Uint32 NumJobs = 0;
+
+        /// The maximum number of jobs recorded into one command list.
+        /// If zero, the jobs are split evenly between the contexts.
+        ///
+        /// Smaller chunks improve load balancing between threads, but every
+        /// chunk adds the overhead of a command list and the BeginChunk state setup.
+        Uint32 ChunkSize = 0;
+
+        /// The maximum number of deferred contexts to use.
+        /// If zero, all contexts are used.
+        Uint32 MaxContexts = 0;
+
+        /// The ID of the immediate context where the command lists will be executed,
+        /// see IDeviceContext::Begin().
+        Uint32 ImmediateContextId = 0;
+
+        /// An optional callback that is called before the first job of every chunk.
+        /// It should set the context state that the jobs rely on.
+        std::function<void(IDeviceContext* pCtx)> BeginChunk = nullptr;
+
+        /// Records the job with the given index into the context.
+        std::function<void(IDeviceContext* pCtx, Uint32 JobIndex)> RecordJob = nullptr;
+
+        /// An optional callback that is called after the last job of every chunk.
+        std::function<void(IDeviceContext* pCtx)> EndChunk = nullptr;
+    };
+
+    /// Records the jobs and appends the command lists to the CommandLists vector in the order of the jobs.
+
+    /// The method blocks until all jobs are recorded. The calling thread also records the jobs.
+    void Record(const RecordAttribs& Attribs, std::vector<RefCntAutoPtr<ICommandList>>& CommandLists);
+
+    /// Transitions the resources to the required states and executes the command lists in the immediate context.
+
+    /// \param [in]     pImmediateCtx - Immediate context to execute the command lists in.
+    /// \param [in,out] CommandLists  - Command lists to execute. The vector is cleared after the command lists are executed.
+    /// \param [in]     NumBarriers   - The number of resource state transitions to perform before the command lists are executed.
+    /// \param [in]     pBarriers     - Resource state transitions.
+    static void Execute(IDeviceContext*                           pImmediateCtx,
+                        std::vector<RefCntAutoPtr<ICommandList>>& CommandLists,
+                        Uint32                                    NumBarriers = 0,
+                        const StateTransitionDesc*                pBarriers   = nullptr);
+
+    /// Calls IDeviceContext::FinishFrame() for all deferred contexts that recorded commands since the last call.
+
+    /// The method must be called after all command lists have been executed in the immediate context.
+    void FinishFrame();
+
+    Uint32 GetNumDeferredContexts() const { return static_cast<Uint32>(m_DeferredContexts.size()); }
+
+private:
+    std::vector<RefCntAutoPtr<IDeviceContext>> m_DeferredContexts;
+    RefCntAutoPtr<IThreadPool>                 m_pThreadPool;
+
+    // The number of first contexts that recorded commands since the last FinishFrame()
+    Uint32 m_NumUsedContexts = 0;
+};
+
+} // namespace Diligent
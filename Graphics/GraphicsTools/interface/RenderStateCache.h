@@ -114,6 +114,13 @@ struct RenderStateCacheCreateInfo
     /// shaders. If null, original source factory will be used.
     IShaderSourceInputStreamFactory* pReloadSource DEFAULT_INITIALIZER(nullptr);
 
+    /// Optional thread pool to use when reloading shaders.
+
+    /// If not null, shaders whose sources have changed will be
+    /// recompiled in parallel by the `Reload()` method.
+    /// If null, all shaders are reloaded in the calling thread.
+    IThreadPool* pReloadThreadPool DEFAULT_INITIALIZER(nullptr);
+
 #if DILIGENT_CPP_INTERFACE
     constexpr RenderStateCacheCreateInfo() noexcept
     {}
@@ -125,19 +132,38 @@ struct RenderStateCacheCreateInfo
         RENDER_STATE_CACHE_FILE_HASH_MODE _FileHashMode      = RenderStateCacheCreateInfo{}.FileHashMode,
         bool                              _EnableHotReload   = RenderStateCacheCreateInfo{}.EnableHotReload,
         bool                              _OptimizeGLShaders = RenderStateCacheCreateInfo{}.OptimizeGLShaders,
-        IShaderSourceInputStreamFactory*  _pReloadSource     = RenderStateCacheCreateInfo{}.pReloadSource) noexcept :
+        IShaderSourceInputStreamFactory*  _pReloadSource     = RenderStateCacheCreateInfo{}.pReloadSource,
+        IThreadPool*                      _pReloadThreadPool = RenderStateCacheCreateInfo{}.pReloadThreadPool) noexcept :
         pDevice{_pDevice},
         pArchiverFactory{_pArchiverFactory},
         LogLevel{_LogLevel},
         FileHashMode{_FileHashMode},
         EnableHotReload{_EnableHotReload},
         OptimizeGLShaders{_OptimizeGLShaders},
-        pReloadSource{_pReloadSource}
+        pReloadSource{_pReloadSource},
+        pReloadThreadPool{_pReloadThreadPool}
     {}
 #endif
 };
 typedef struct RenderStateCacheCreateInfo RenderStateCacheCreateInfo;
 
+/// Render state cache reload statistics, see IRenderStateCache::Reload.
+struct RenderStateCacheReloadStats
+{
+    /// The number of shaders whose source files have changed and that were reloaded.
+    Uint32 NumShadersReloaded DEFAULT_INITIALIZER(0);
+
+    /// The number of shaders that were skipped because none of their source files have changed.
+    Uint32 NumShadersSkipped DEFAULT_INITIALIZER(0);
+
+    /// The number of pipeline states that were reloaded because they reference reloaded shaders.
+    Uint32 NumPipelinesReloaded DEFAULT_INITIALIZER(0);
+
+    /// The number of pipeline states that were skipped because none of their shaders were reloaded.
+    Uint32 NumPipelinesSkipped DEFAULT_INITIALIZER(0);
+};
+typedef struct RenderStateCacheReloadStats RenderStateCacheReloadStats;
+
 #include "../../../Primitives/interface/DefineRefMacro.h"
 
 /// Type of the callback function called by the IRenderStateCache::Reload method.
@@ -281,14 +307,24 @@ DILIGENT_BEGIN_INTERFACE(IRenderStateCache, IObject)
     ///                                       to let the application modify graphics pipeline state info before creating new
     ///                                       pipeline.
     /// \param [in]  pUserData              - A pointer to the user-specific data to pass to ReloadGraphicsPipeline callback.
+    /// \param [out] pStats                 - An optional pointer to the structure that receives the number of
+    ///                                       shaders and pipelines that were reloaded and skipped.
     ///
-    /// \return     The total number of render states (shaders and pipelines) that were reloaded.
+    /// \return     The total number of render states (shaders and pipelines) that were reloaded
+    ///             and not found in the cache.
     ///
     /// Reloading is only enabled if the cache was created with the `EnableHotReload` member of
     /// `Diligent::RenderStateCacheCreateInfo` struct set to true.
+    ///
+    /// The cache tracks the source files (including all resolved includes) each shader depends on.
+    /// Only shaders whose source files have changed since the last reload are recompiled.
+    /// If ReloadGraphicsPipeline is null, only pipelines that reference these shaders are recreated.
+    /// Otherwise, the callback may change any pipeline, so all pipelines are recreated and the
+    /// callback is called for every graphics pipeline.
     VIRTUAL Uint32 METHOD(Reload)(THIS_
                                   ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline DEFAULT_VALUE(nullptr), 
-                                  void*                              pUserData              DEFAULT_VALUE(nullptr)) PURE;
+                                  void*                              pUserData              DEFAULT_VALUE(nullptr),
+                                  RenderStateCacheReloadStats*       pStats                 DEFAULT_VALUE(nullptr)) PURE;
 
     /// Returns the content version of the cache data.
 
@@ -30,11 +30,14 @@
 #include <mutex>
 #include <vector>
 #include <deque>
+#include <functional>
+#include <atomic>
 
 #include "../../GraphicsEngine/interface/SwapChain.h"
 #include "../../GraphicsEngine/interface/RenderDevice.h"
 #include "../../GraphicsEngine/interface/DeviceContext.h"
 #include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/ThreadPool.h"
 
 namespace Diligent
 {
@@ -42,8 +45,69 @@ namespace Diligent
 class ScreenCapture
 {
 public:
+    /// Pixels of a captured frame that are passed to the capture handler in asynchronous mode
+    struct CapturedPixels
+    {
+        Uint32         Id     = 0;
+        Uint32         Width  = 0;
+        Uint32         Height = 0;
+        TEXTURE_FORMAT Format = TEX_FORMAT_UNKNOWN;
+
+        /// Tightly packed pixel rows. The data is only valid during the handler call.
+        const void* pData  = nullptr;
+        Uint32      Stride = 0;
+    };
+
+    /// Capture handler type. Handlers run in the thread pool and may be called concurrently
+    /// for different frames.
+    using CaptureHandlerType = std::function<void(const CapturedPixels&)>;
+
+    /// Asynchronous mode attributes
+    struct AsyncModeAttribs
+    {
+        /// Thread pool that runs the capture handlers.
+        IThreadPool* pThreadPool = nullptr;
+
+        /// Handler that processes the captured pixels, for example encodes them
+        /// and writes the result to a file stream.
+        CaptureHandlerType Handler;
+
+        /// The maximum total size of the pooled pixel buffers, in bytes.
+        /// Frames that don't fit into the budget are dropped.
+        size_t MaxInFlightMemory = size_t{512} << 20;
+
+        /// The maximum number of captures waiting for the GPU.
+        /// When the limit is reached, new captures are dropped.
+        Uint32 MaxPendingCaptures = 8;
+    };
+
+    /// Asynchronous mode statistics
+    struct AsyncStats
+    {
+        /// The number of frames passed to the handler
+        Uint32 NumProcessedFrames = 0;
+
+        /// The number of frames that were dropped because of the memory or pending capture limits
+        Uint32 NumDroppedFrames = 0;
+
+        /// The number of frames that are being processed by the handlers
+        Uint32 NumFramesInFlight = 0;
+
+        /// The total size of the pixel buffers, in bytes
+        size_t PixelBuffersSize = 0;
+    };
+
     ScreenCapture(IRenderDevice* pDevice);
 
+    /// Creates the screen capture in asynchronous mode.
+
+    /// In asynchronous mode, ProcessCaptures() must be called once per frame in the thread that owns
+    /// the device context. It copies the pixels of the staging textures that are ready into pooled
+    /// buffers and runs the handler in the thread pool, so that encoding never blocks rendering.
+    ScreenCapture(IRenderDevice* pDevice, const AsyncModeAttribs& Attribs);
+
+    ~ScreenCapture();
+
     void Capture(ISwapChain* pSwapChain, IDeviceContext* pContext, Uint32 FrameId);
 
     struct CaptureInfo
@@ -68,7 +132,19 @@ public:
         return m_PendingTextures.size();
     }
 
+    /// Hands the completed captures over to the thread pool (asynchronous mode only).
+    void ProcessCaptures(IDeviceContext* pContext);
+
+    /// Waits until all pending captures are processed by the handlers (asynchronous mode only).
+    void Flush(IDeviceContext* pContext);
+
+    AsyncStats GetAsyncStats();
+
 private:
+    bool AllocatePixelBuffer(size_t Size, std::vector<Uint8>& Buffer);
+    void ReleasePixelBuffer(std::vector<Uint8>&& Buffer);
+    void WaitForHandlers();
+
     RefCntAutoPtr<IFence>        m_pFence;
     RefCntAutoPtr<IRenderDevice> m_pDevice;
 
@@ -94,6 +170,18 @@ private:
     std::deque<PendingTextureInfo> m_PendingTextures;
 
     Uint64 m_CurrentFenceValue = 1;
+
+    const AsyncModeAttribs m_AsyncMode;
+
+    std::mutex                      m_PixelBuffersMtx;
+    std::vector<std::vector<Uint8>> m_AvailablePixelBuffers;
+    size_t                          m_PixelBuffersSize = 0;
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> m_HandlerTasks;
+
+    std::atomic<Uint32> m_NumProcessedFrames{0};
+    std::atomic<Uint32> m_NumDroppedFrames{0};
+    std::atomic<Uint32> m_NumFramesInFlight{0};
 };
 
 } // namespace Diligent
@@ -58,6 +58,12 @@ struct UploadBufferDesc
 class IUploadBuffer : public IObject
 {
 public:
+    /// Waits until the copy from this buffer has been scheduled.
+
+    /// When the uploader uses a transfer context (see TextureUploaderDesc::pTransferContext) and the
+    /// copy was scheduled by a worker thread, the method waits until the copy has been completed by
+    /// the transfer queue and the destination texture has been made available to the graphics queue
+    /// by ITextureUploader::RenderThreadUpdate().
     virtual void                     WaitForCopyScheduled()                  = 0;
     virtual MappedTextureSubresource GetMappedData(Uint32 Mip, Uint32 Slice) = 0;
     virtual const UploadBufferDesc&  GetDesc() const                         = 0;
@@ -66,6 +72,25 @@ public:
 /// Texture uploader description.
 struct TextureUploaderDesc
 {
+    /// Optional immediate context of a dedicated transfer queue (COMMAND_QUEUE_TYPE_TRANSFER).
+
+    /// When this member is not null, Direct3D12 and Vulkan uploaders record and submit copies
+    /// from upload buffers in this context instead of the context passed to RenderThreadUpdate()
+    /// and ScheduleGPUCopy(), so that texture streaming does not consume graphics queue time.
+    /// The render thread context waits for the copies on the GPU and transitions the destination
+    /// textures back to the graphics queue in batches.
+    ///
+    /// The destination textures must be created with the ImmediateContextMask that includes both
+    /// the transfer context and the render thread context. The uploader only accesses the transfer
+    /// context from the methods that are called by the render thread, and the application must not
+    /// use it at the same time.
+    ///
+    /// The queues are synchronized with general fences, so the transfer context is only used
+    /// when the NativeFence device feature is enabled. Otherwise, the copies are recorded in the
+    /// render thread context.
+    ///
+    /// Other backends ignore this member.
+    IDeviceContext* pTransferContext = nullptr;
 };
 
 
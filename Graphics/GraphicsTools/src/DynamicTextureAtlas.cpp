@@ -31,8 +31,10 @@
 #include <algorithm>
 #include <atomic>
 #include <unordered_map>
+#include <unordered_set>
 #include <map>
 #include <set>
+#include <vector>
 
 #include "DynamicAtlasManager.hpp"
 #include "DynamicTextureArray.hpp"
@@ -125,6 +127,18 @@ public:
         return m_pUserData;
     }
 
+    const DynamicAtlasManager::Region& GetSubregion() const
+    {
+        return m_Subregion;
+    }
+
+    // Called by the parent atlas when the suballocation is moved during defragmentation
+    void SetSubregion(const DynamicAtlasManager::Region& Subregion)
+    {
+        VERIFY_EXPR(!Subregion.IsEmpty());
+        m_Subregion = Subregion;
+    }
+
 private:
     RefCntAutoPtr<DynamicTextureAtlasImpl> m_pParentAtlas;
 
@@ -143,8 +157,8 @@ namespace
 class ThreadSafeAtlasManager
 {
 public:
-    ThreadSafeAtlasManager(const uint2& Dim) noexcept :
-        Mgr{Dim.x, Dim.y}
+    ThreadSafeAtlasManager(const uint2& Dim, DynamicAtlasManager::PackingMode Mode) noexcept :
+        Mgr{Dim.x, Dim.y, Mode}
     {}
 
     // clang-format off
@@ -224,6 +238,14 @@ public:
             return pAtlasMgr->Mgr.IsEmpty();
         }
 
+        Uint32 Defragment(Uint32 MaxMoves, std::vector<DynamicAtlasManager::RegionMove>& Moves)
+        {
+            VERIFY_EXPR(pAtlasMgr != nullptr);
+            VERIFY_EXPR(pAtlasMgr->UseCount > 0);
+            std::lock_guard<std::mutex> Guard{pAtlasMgr->Mtx};
+            return pAtlasMgr->Mgr.Defragment(MaxMoves, Moves);
+        }
+
     private:
         friend class ThreadSafeAtlasManager;
 
@@ -273,8 +295,9 @@ private:
 
 struct SliceBatch
 {
-    SliceBatch(const uint2 AtlasDim) noexcept :
-        m_AtlasDim{AtlasDim}
+    SliceBatch(const uint2 AtlasDim, DynamicAtlasManager::PackingMode Mode) noexcept :
+        m_AtlasDim{AtlasDim},
+        m_Mode{Mode}
     {}
 
     ~SliceBatch()
@@ -318,7 +341,7 @@ struct SliceBatch
         std::lock_guard<std::mutex> Guard{m_Mtx};
 
         VERIFY(m_Slices.find(Slice) == m_Slices.end(), "Slice ", Slice, " already present in the batch.");
-        auto it = m_Slices.emplace(Slice, m_AtlasDim).first;
+        auto it = m_Slices.emplace(std::piecewise_construct, std::forward_as_tuple(Slice), std::forward_as_tuple(m_AtlasDim, m_Mode)).first;
         // NB: Lock() atomically increases the use count of the slice while we hold the mutex.
         return it->second.Lock();
     }
@@ -352,8 +375,21 @@ struct SliceBatch
         return true;
     }
 
+    // Returns the indices of all slices in the batch
+    std::vector<Uint32> GetSlices()
+    {
+        std::lock_guard<std::mutex> Guard{m_Mtx};
+
+        std::vector<Uint32> Slices;
+        Slices.reserve(m_Slices.size());
+        for (const auto& it : m_Slices)
+            Slices.push_back(it.first);
+        return Slices;
+    }
+
 private:
-    const uint2 m_AtlasDim;
+    const uint2                            m_AtlasDim;
+    const DynamicAtlasManager::PackingMode m_Mode;
 
     std::mutex m_Mtx;
     // For every alignment, we keep a list of slice managers sorted by the slice index.
@@ -387,6 +423,7 @@ public:
         m_ExtraSliceFactor{clamp(CreateInfo.GrowthFactor, 1.f, 2.f) - 1.f},
         m_MaxSliceCount   {CreateInfo.Desc.Type == RESOURCE_DIM_TEX_2D_ARRAY ? std::min(CreateInfo.MaxSliceCount, Uint32{2048}) : 1},
         m_Silent          {CreateInfo.Silent},
+        m_PackingMode     {CreateInfo.Packing == DYNAMIC_TEXTURE_ATLAS_PACKING_SKYLINE ? DynamicAtlasManager::PackingMode::Skyline : DynamicAtlasManager::PackingMode::Tree},
         m_SuballocationsAllocator
         {
             DefaultRawMemoryAllocator::GetAllocator(),
@@ -446,6 +483,7 @@ public:
         VERIFY_EXPR(m_UsedArea.load() == 0);
         VERIFY_EXPR(m_AllocationCount.load() == 0);
         VERIFY_EXPR(m_AvailableSlices.size() == m_MaxSliceCount);
+        VERIFY_EXPR(m_Suballocations.empty());
     }
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DynamicTextureAtlas, TBase)
@@ -573,11 +611,22 @@ public:
         };
         // clang-format on
 
+        {
+            std::lock_guard<std::mutex> Guard{m_SuballocationsMtx};
+            m_Suballocations.insert(pSuballocation);
+        }
+
         pSuballocation->QueryInterface(IID_TextureAtlasSuballocation, reinterpret_cast<IObject**>(ppSuballocation));
     }
 
-    void Free(Uint32 Slice, Uint32 Alignment, DynamicAtlasManager::Region&& Subregion, Uint32 Width, Uint32 Height)
+    void Free(TextureAtlasSuballocationImpl* pSuballocation, Uint32 Slice, Uint32 Alignment, DynamicAtlasManager::Region&& Subregion, Uint32 Width, Uint32 Height)
     {
+        {
+            std::lock_guard<std::mutex> Guard{m_SuballocationsMtx};
+            VERIFY(m_Suballocations.find(pSuballocation) != m_Suballocations.end(), "Suballocation is not registered in the atlas");
+            m_Suballocations.erase(pSuballocation);
+        }
+
         const Int64 AllocatedArea = Int64{Width} * Int64{Height};
         const Int64 UsedArea      = (Int64{Subregion.width} * Int64{Alignment}) * (Int64{Subregion.height} * Int64{Alignment});
 
@@ -652,6 +701,11 @@ public:
             return 0;
     }
 
+    virtual Uint32 Defragment(IRenderDevice*               pDevice,
+                              IDeviceContext*              pContext,
+                              Uint32                       MaxMoves,
+                              ITextureAtlasSuballocation** ppMovedSuballocations) override final;
+
     void GetUsageStats(DynamicTextureAtlasUsageStats& Stats) const override final
     {
         if (m_DynamicTexArray)
@@ -711,7 +765,7 @@ private:
         // Get the list of slices for this alignment
         auto BatchIt = m_SliceBatchesByAlignment.find(Alignment);
         if (BatchIt == m_SliceBatchesByAlignment.end() && AtlasWidth != 0 && AtlasHeight != 0)
-            BatchIt = m_SliceBatchesByAlignment.emplace(Alignment, uint2{AtlasWidth, AtlasHeight}).first;
+            BatchIt = m_SliceBatchesByAlignment.emplace(std::piecewise_construct, std::forward_as_tuple(Alignment), std::forward_as_tuple(uint2{AtlasWidth, AtlasHeight}, m_PackingMode)).first;
 
         return BatchIt != m_SliceBatchesByAlignment.end() ? &BatchIt->second : nullptr;
     }
@@ -726,6 +780,8 @@ private:
     const Uint32 m_MaxSliceCount;
     const bool   m_Silent;
 
+    const DynamicAtlasManager::PackingMode m_PackingMode;
+
     std::unique_ptr<DynamicTextureArray> m_DynamicTexArray;
     RefCntAutoPtr<ITexture>              m_pTexture;
 
@@ -745,12 +801,244 @@ private:
     // Keep available slice indices sorted.
     std::mutex       m_AvailableSlicesMtx;
     std::set<Uint32> m_AvailableSlices;
+
+    // All live suballocations. Used to update the suballocations moved by Defragment().
+    std::mutex                                         m_SuballocationsMtx;
+    std::unordered_set<TextureAtlasSuballocationImpl*> m_Suballocations;
+
+    // Scratch texture used by Defragment() to copy the moved regions
+    RefCntAutoPtr<ITexture> m_pDefragScratchTex;
 };
 
 
+Uint32 DynamicTextureAtlasImpl::Defragment(IRenderDevice*               pDevice,
+                                           IDeviceContext*              pContext,
+                                           Uint32                       MaxMoves,
+                                           ITextureAtlasSuballocation** ppMovedSuballocations)
+{
+    if (MaxMoves == 0)
+        return 0;
+
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+
+    // Make sure that the texture exists and is large enough for all slices
+    ITexture* pTexture = Update(pDevice, pContext);
+    if (pTexture == nullptr)
+    {
+        UNEXPECTED("Atlas texture has not been created");
+        return 0;
+    }
+    const TextureDesc& TexDesc = pTexture->GetDesc();
+
+    const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
+    const Uint32                BlockSize  = FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED ? std::max(Uint32{FmtAttribs.BlockWidth}, Uint32{FmtAttribs.BlockHeight}) : 1;
+
+    // Returns the number of mip levels in which the region is block-aligned
+    auto GetNumMipsToCopy = [&](Uint32 Alignment) {
+        Uint32 NumMips = 0;
+        while (NumMips < TexDesc.MipLevels && (Alignment >> NumMips) >= BlockSize)
+            ++NumMips;
+        return NumMips;
+    };
+
+    // The source and destination regions of a move may overlap, so the contents are copied through a scratch texture.
+    // The texture must be ready before any region is moved in the atlas managers, as the moves can't be undone.
+    // It is sized for the largest suballocation that may be moved, kept between the calls and only recreated
+    // when it is too small.
+    {
+        TextureDesc ScratchDesc;
+        ScratchDesc.Name      = "Dynamic texture atlas defragmentation scratch texture";
+        ScratchDesc.Type      = RESOURCE_DIM_TEX_2D;
+        ScratchDesc.Format    = TexDesc.Format;
+        ScratchDesc.Usage     = USAGE_DEFAULT;
+        ScratchDesc.BindFlags = TexDesc.BindFlags;
+        ScratchDesc.MipLevels = 0;
+        {
+            std::lock_guard<std::mutex> Guard{m_SuballocationsMtx};
+            for (const TextureAtlasSuballocationImpl* pSuballocation : m_Suballocations)
+            {
+                const Uint32 Alignment = pSuballocation->GetAlignment();
+                const Uint32 NumMips   = GetNumMipsToCopy(Alignment);
+                if (NumMips == 0)
+                    continue;
+
+                const DynamicAtlasManager::Region& Subregion = pSuballocation->GetSubregion();
+
+                ScratchDesc.Width     = std::max(ScratchDesc.Width, Subregion.width * Alignment);
+                ScratchDesc.Height    = std::max(ScratchDesc.Height, Subregion.height * Alignment);
+                ScratchDesc.MipLevels = std::max(ScratchDesc.MipLevels, NumMips);
+            }
+        }
+        if (ScratchDesc.MipLevels == 0)
+        {
+            // No suballocation can be moved
+            return 0;
+        }
+
+        bool CreateScratchTex = true;
+        if (m_pDefragScratchTex)
+        {
+            const TextureDesc& CurrDesc = m_pDefragScratchTex->GetDesc();
+            CreateScratchTex            = CurrDesc.Width < ScratchDesc.Width || CurrDesc.Height < ScratchDesc.Height || CurrDesc.MipLevels < ScratchDesc.MipLevels;
+            if (CreateScratchTex)
+            {
+                // Grow the texture so that it can be reused by the next calls
+                ScratchDesc.Width     = std::max(ScratchDesc.Width, CurrDesc.Width);
+                ScratchDesc.Height    = std::max(ScratchDesc.Height, CurrDesc.Height);
+                ScratchDesc.MipLevels = std::max(ScratchDesc.MipLevels, CurrDesc.MipLevels);
+            }
+        }
+
+        if (CreateScratchTex)
+        {
+            if (pDevice == nullptr)
+            {
+                LOG_ERROR_MESSAGE("Render device must not be null when the atlas defragmentation scratch texture needs to be created. No suballocations are moved.");
+                return 0;
+            }
+
+            RefCntAutoPtr<ITexture> pScratchTex;
+            pDevice->CreateTexture(ScratchDesc, nullptr, &pScratchTex);
+            if (!pScratchTex)
+            {
+                LOG_ERROR_MESSAGE("Failed to create the scratch texture for atlas defragmentation. No suballocations are moved.");
+                return 0;
+            }
+            m_pDefragScratchTex = std::move(pScratchTex);
+        }
+    }
+    ITexture* const pScratchTex = m_pDefragScratchTex;
+
+    struct SuballocationMove
+    {
+        TextureAtlasSuballocationImpl* pSuballocation;
+        Uint32                         Slice;
+        Uint32                         Alignment;
+        DynamicAtlasManager::Region    Src;
+        DynamicAtlasManager::Region    Dst;
+    };
+    std::vector<SuballocationMove> Moves;
+
+    {
+        std::vector<std::pair<Uint32, SliceBatch*>> Batches;
+        {
+            std::lock_guard<std::mutex> Guard{m_SliceBatchesByAlignmentMtx};
+            for (auto& it : m_SliceBatchesByAlignment)
+            {
+                // Suballocations that can't be copied at block granularity are never moved
+                if (GetNumMipsToCopy(it.first) > 0)
+                    Batches.emplace_back(it.first, &it.second);
+            }
+        }
+        // Process larger allocations first
+        std::sort(Batches.begin(), Batches.end(),
+                  [](const std::pair<Uint32, SliceBatch*>& B0, const std::pair<Uint32, SliceBatch*>& B1) {
+                      return B0.first > B1.first;
+                  });
+
+        std::vector<DynamicAtlasManager::RegionMove> RegionMoves;
+        for (const auto& Batch : Batches)
+        {
+            for (Uint32 Slice : Batch.second->GetSlices())
+            {
+                if (Moves.size() >= MaxMoves)
+                    break;
+
+                if (ThreadSafeAtlasManager::ManagerGuard SliceMgr = Batch.second->LockSlice(Slice))
+                {
+                    RegionMoves.clear();
+                    SliceMgr.Defragment(MaxMoves - static_cast<Uint32>(Moves.size()), RegionMoves);
+                    for (const DynamicAtlasManager::RegionMove& Move : RegionMoves)
+                        Moves.push_back({nullptr, Slice, Batch.first, Move.Src, Move.Dst});
+                }
+            }
+        }
+    }
+    if (Moves.empty())
+        return 0;
+
+    // Find the suballocations that own the source regions
+    {
+        struct SliceRegionHasher
+        {
+            size_t operator()(const std::pair<Uint32, DynamicAtlasManager::Region>& SliceRegion) const
+            {
+                return ComputeHash(SliceRegion.first, DynamicAtlasManager::Region::Hasher{}(SliceRegion.second));
+            }
+        };
+        // Every slice belongs to a single alignment batch, so (slice, region) uniquely identifies the suballocation.
+        // Note that the source region of a move may be the destination of a previous one.
+        std::unordered_map<std::pair<Uint32, DynamicAtlasManager::Region>, TextureAtlasSuballocationImpl*, SliceRegionHasher> SuballocationsByRegion;
+        {
+            std::lock_guard<std::mutex> Guard{m_SuballocationsMtx};
+            SuballocationsByRegion.reserve(m_Suballocations.size());
+            for (TextureAtlasSuballocationImpl* pSuballocation : m_Suballocations)
+                SuballocationsByRegion.emplace(std::make_pair(pSuballocation->GetSlice(), pSuballocation->GetSubregion()), pSuballocation);
+        }
+
+        for (SuballocationMove& Move : Moves)
+        {
+            auto it = SuballocationsByRegion.find(std::make_pair(Move.Slice, Move.Src));
+            VERIFY(it != SuballocationsByRegion.end(), "Unable to find the suballocation of the moved region. This is a bug.");
+            Move.pSuballocation = it->second;
+            SuballocationsByRegion.erase(it);
+            SuballocationsByRegion.emplace(std::make_pair(Move.Slice, Move.Dst), Move.pSuballocation);
+        }
+    }
+
+    CopyTextureAttribs CopyAttribs;
+    CopyAttribs.SrcTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    CopyAttribs.DstTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+
+    Uint32 NumMoves = 0;
+    for (const SuballocationMove& Move : Moves)
+    {
+        const Uint32 NumMips = GetNumMipsToCopy(Move.Alignment);
+        for (Uint32 mip = 0; mip < NumMips; ++mip)
+        {
+            const Uint32 MipAlignment = Move.Alignment >> mip;
+
+            const Box SrcBox{
+                Move.Src.x * MipAlignment,
+                (Move.Src.x + Move.Src.width) * MipAlignment,
+                Move.Src.y * MipAlignment,
+                (Move.Src.y + Move.Src.height) * MipAlignment,
+            };
+            CopyAttribs.pSrcTexture = pTexture;
+            CopyAttribs.SrcMipLevel = mip;
+            CopyAttribs.SrcSlice    = Move.Slice;
+            CopyAttribs.pSrcBox     = &SrcBox;
+            CopyAttribs.pDstTexture = pScratchTex;
+            CopyAttribs.DstMipLevel = mip;
+            CopyAttribs.DstSlice    = 0;
+            CopyAttribs.DstX        = 0;
+            CopyAttribs.DstY        = 0;
+            pContext->CopyTexture(CopyAttribs);
+
+            const Box ScratchBox{0, Move.Src.width * MipAlignment, 0, Move.Src.height * MipAlignment};
+            CopyAttribs.pSrcTexture = pScratchTex;
+            CopyAttribs.SrcSlice    = 0;
+            CopyAttribs.pSrcBox     = &ScratchBox;
+            CopyAttribs.pDstTexture = pTexture;
+            CopyAttribs.DstSlice    = Move.Slice;
+            CopyAttribs.DstX        = Move.Dst.x * MipAlignment;
+            CopyAttribs.DstY        = Move.Dst.y * MipAlignment;
+            pContext->CopyTexture(CopyAttribs);
+        }
+
+        Move.pSuballocation->SetSubregion(Move.Dst);
+        if (ppMovedSuballocations != nullptr)
+            ppMovedSuballocations[NumMoves] = Move.pSuballocation;
+        ++NumMoves;
+    }
+
+    return NumMoves;
+}
+
+
 TextureAtlasSuballocationImpl::~TextureAtlasSuballocationImpl()
 {
-    m_pParentAtlas->Free(m_Slice, m_Alignment, std::move(m_Subregion), m_Size.x, m_Size.y);
+    m_pParentAtlas->Free(this, m_Slice, m_Alignment, std::move(m_Subregion), m_Size.x, m_Size.y);
 }
 
 IDynamicTextureAtlas* TextureAtlasSuballocationImpl::GetAtlas()
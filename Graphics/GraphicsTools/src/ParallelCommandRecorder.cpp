@@ -0,0 +1,152 @@
+/*
+ *  Copyright 2019-2025 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ParallelCommandRecorder.hpp"
+
+#include <atomic>
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+ParallelCommandRecorder::ParallelCommandRecorder(const CreateInfo& CI) :
+    m_pThreadPool{CI.pThreadPool}
+{
+    DEV_CHECK_ERR(CI.NumDeferredContexts > 0, "At least one deferred context is required");
+    DEV_CHECK_ERR(CI.ppDeferredContexts != nullptr, "ppDeferredContexts must not be null");
+
+    m_DeferredContexts.reserve(CI.NumDeferredContexts);
+    for (Uint32 i = 0; i < CI.NumDeferredContexts; ++i)
+    {
+        IDeviceContext* pCtx = CI.ppDeferredContexts[i];
+        DEV_CHECK_ERR(pCtx != nullptr, "Deferred context ", i, " is null");
+        DEV_CHECK_ERR(pCtx->GetDesc().IsDeferred, "Context ", i, " is not a deferred context");
+        m_DeferredContexts.emplace_back(pCtx);
+    }
+}
+
+void ParallelCommandRecorder::Record(const RecordAttribs& Attribs, std::vector<RefCntAutoPtr<ICommandList>>& CommandLists)
+{
+    DEV_CHECK_ERR(Attribs.RecordJob, "RecordJob callback must not be null");
+    if (Attribs.NumJobs == 0)
+        return;
+
+    const Uint32 MaxContexts = Attribs.MaxContexts != 0 ?
+        std::min(Attribs.MaxContexts, GetNumDeferredContexts()) :
+        GetNumDeferredContexts();
+
+    const Uint32 ChunkSize = Attribs.ChunkSize != 0 ?
+        Attribs.ChunkSize :
+        (Attribs.NumJobs + MaxContexts - 1) / MaxContexts;
+
+    const Uint32 NumChunks      = (Attribs.NumJobs + ChunkSize - 1) / ChunkSize;
+    const Uint32 NumContexts    = std::min(MaxContexts, NumChunks);
+    const size_t FirstCmdListId = CommandLists.size();
+    CommandLists.resize(FirstCmdListId + NumChunks);
+
+    // Every context is processed by exactly one thread, and the chunks are distributed between
+    // the contexts dynamically, so that threads that started earlier or record cheaper jobs
+    // take more chunks. The order of command lists is defined by the chunk indices only.
+    std::atomic<Uint32> NextChunk{0};
+    // Flags of the contexts that recorded at least one chunk, written by the thread that processes the context
+    std::vector<Uint8> IsContextUsed(NumContexts, 0);
+
+    auto RecordChunks = [&](Uint32 ctx) {
+        IDeviceContext* pCtx = m_DeferredContexts[ctx];
+        for (Uint32 Chunk = NextChunk.fetch_add(1); Chunk < NumChunks; Chunk = NextChunk.fetch_add(1))
+        {
+            const Uint32 FirstJob = Chunk * ChunkSize;
+            const Uint32 EndJob   = std::min(FirstJob + ChunkSize, Attribs.NumJobs);
+
+            pCtx->Begin(Attribs.ImmediateContextId);
+            if (Attribs.BeginChunk)
+                Attribs.BeginChunk(pCtx);
+            for (Uint32 Job = FirstJob; Job < EndJob; ++Job)
+                Attribs.RecordJob(pCtx, Job);
+            if (Attribs.EndChunk)
+                Attribs.EndChunk(pCtx);
+
+            pCtx->FinishCommandList(CommandLists[FirstCmdListId + Chunk].RawDblPtr());
+            IsContextUsed[ctx] = 1;
+        }
+    };
+
+    // The calling thread records commands into the first context. Contexts whose tasks
+    // have not been started by the pool when all chunks are taken find no work.
+    ProcessRangeInParallel(m_pThreadPool, NumContexts, 1,
+                           [&RecordChunks](Uint32 FirstCtx, Uint32 EndCtx) {
+                               for (Uint32 ctx = FirstCtx; ctx < EndCtx; ++ctx)
+                                   RecordChunks(ctx);
+                           });
+
+    for (Uint32 ctx = NumContexts; ctx > m_NumUsedContexts; --ctx)
+    {
+        if (IsContextUsed[ctx - 1])
+        {
+            m_NumUsedContexts = ctx;
+            break;
+        }
+    }
+
+#ifdef DILIGENT_DEVELOPMENT
+    for (size_t i = FirstCmdListId; i < CommandLists.size(); ++i)
+        DEV_CHECK_ERR(CommandLists[i], "Command list for chunk ", i - FirstCmdListId, " has not been recorded");
+#endif
+}
+
+void ParallelCommandRecorder::Execute(IDeviceContext*                           pImmediateCtx,
+                                      std::vector<RefCntAutoPtr<ICommandList>>& CommandLists,
+                                      Uint32                                    NumBarriers,
+                                      const StateTransitionDesc*                pBarriers)
+{
+    DEV_CHECK_ERR(pImmediateCtx != nullptr, "Immediate context must not be null");
+    DEV_CHECK_ERR(!pImmediateCtx->GetDesc().IsDeferred, "Command lists must be executed in an immediate context");
+
+    if (NumBarriers > 0)
+        pImmediateCtx->TransitionResourceStates(NumBarriers, pBarriers);
+
+    if (!CommandLists.empty())
+    {
+        std::vector<ICommandList*> CmdListPtrs(CommandLists.size());
+        for (size_t i = 0; i < CommandLists.size(); ++i)
+            CmdListPtrs[i] = CommandLists[i];
+        pImmediateCtx->ExecuteCommandLists(static_cast<Uint32>(CmdListPtrs.size()), CmdListPtrs.data());
+        CommandLists.clear();
+    }
+}
+
+void ParallelCommandRecorder::FinishFrame()
+{
+    for (Uint32 ctx = 0; ctx < m_NumUsedContexts; ++ctx)
+        m_DeferredContexts[ctx]->FinishFrame();
+    m_NumUsedContexts = 0;
+}
+
+} // namespace Diligent
@@ -26,16 +26,27 @@
 
 #include "ReloadableShader.hpp"
 #include "RenderStateCacheImpl.hpp"
+#include "DataBlobImpl.hpp"
+#include "ShaderToolsCommon.hpp"
 
 namespace Diligent
 {
 
 constexpr INTERFACE_ID ReloadableShader::IID_InternalImpl;
 
-ReloadableShader::ReloadableShader(IReferenceCounters*     pRefCounters,
-                                   RenderStateCacheImpl*   pStateCache,
-                                   IShader*                pShader,
-                                   const ShaderCreateInfo& CreateInfo) :
+static XXH128Hash ComputeSourceHash(const void* pData, size_t Size)
+{
+    XXH128State Hasher;
+    if (Size != 0)
+        Hasher.UpdateRaw(pData, Size);
+    return Hasher.Digest();
+}
+
+ReloadableShader::ReloadableShader(IReferenceCounters*              pRefCounters,
+                                   RenderStateCacheImpl*            pStateCache,
+                                   IShader*                         pShader,
+                                   const ShaderCreateInfo&          CreateInfo,
+                                   IShaderSourceInputStreamFactory* pCompiledSourceFactory) :
     TBase{pRefCounters},
     m_pStateCache{pStateCache},
     m_pShader{pShader},
@@ -45,6 +56,8 @@ ReloadableShader::ReloadableShader(IReferenceCounters*     pRefCounters,
     {
         LOG_ERROR_AND_THROW("Internal shader object must not be null");
     }
+
+    UpdateSourceDependencies(pCompiledSourceFactory);
 }
 
 ReloadableShader::~ReloadableShader()
@@ -81,8 +94,57 @@ void ReloadableShader::QueryInterface(const INTERFACE_ID& IID, IObject** ppInter
     }
 }
 
+void ReloadableShader::UpdateSourceDependencies(IShaderSourceInputStreamFactory* pSourceFactory)
+{
+    m_SourceDependencies.clear();
+    m_SourceDependenciesValid = true;
+
+    ShaderCreateInfo ShaderCI = m_CreateInfo.Get();
+    if (ShaderCI.Source == nullptr && ShaderCI.FilePath == nullptr)
+    {
+        // The shader is created from byte code and has no source dependencies
+        return;
+    }
+
+    ShaderCI.pShaderSourceStreamFactory = pSourceFactory;
+    m_SourceDependenciesValid           = ProcessShaderIncludes(ShaderCI, [this](const ShaderIncludePreprocessInfo& ProcessInfo) {
+        // Empty file path indicates the source string from the create info, which never changes
+        if (!ProcessInfo.FilePath.empty())
+            m_SourceDependencies.push_back({ProcessInfo.FilePath, ComputeSourceHash(ProcessInfo.Source, ProcessInfo.SourceLength)});
+    });
+}
+
+bool ReloadableShader::HaveSourcesChanged() const
+{
+    if (!m_SourceDependenciesValid)
+        return true;
+
+    IShaderSourceInputStreamFactory* pSourceFactory = m_CreateInfo.Get().pShaderSourceStreamFactory;
+    for (const SourceDependency& Dependency : m_SourceDependencies)
+    {
+        RefCntAutoPtr<IFileStream> pSourceStream;
+        if (pSourceFactory != nullptr)
+            pSourceFactory->CreateInputStream2(Dependency.FilePath.c_str(), CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT, &pSourceStream);
+
+        // If the file can't be opened, report the change so that Reload() logs the error
+        if (!pSourceStream)
+            return true;
+
+        RefCntAutoPtr<DataBlobImpl> pFileData = DataBlobImpl::Create();
+        pSourceStream->ReadBlob(pFileData);
+        if (!(ComputeSourceHash(pFileData->GetConstDataPtr(), pFileData->GetSize()) == Dependency.Hash))
+            return true;
+    }
+
+    return false;
+}
+
 bool ReloadableShader::Reload()
 {
+    // Record the dependencies before compiling the shader so that the files
+    // modified during the compilation are detected by the next reload.
+    UpdateSourceDependencies(m_CreateInfo.Get().pShaderSourceStreamFactory);
+
     RefCntAutoPtr<IShader> pNewShader;
 
     const bool FoundInCache = m_pStateCache->CreateShaderInternal(m_CreateInfo, &pNewShader);
@@ -94,19 +156,22 @@ bool ReloadableShader::Reload()
     {
         const char* Name = m_CreateInfo.Get().Desc.Name;
         LOG_ERROR_MESSAGE("Failed to reload shader '", (Name ? Name : "<unnamed>"), "'.");
+        // Try again next time even if the sources are not modified
+        m_SourceDependenciesValid = false;
     }
     return !FoundInCache;
 }
 
 
-void ReloadableShader::Create(RenderStateCacheImpl*   pStateCache,
-                              IShader*                pShader,
-                              const ShaderCreateInfo& CreateInfo,
-                              IShader**               ppReloadableShader)
+void ReloadableShader::Create(RenderStateCacheImpl*            pStateCache,
+                              IShader*                         pShader,
+                              const ShaderCreateInfo&          CreateInfo,
+                              IShaderSourceInputStreamFactory* pCompiledSourceFactory,
+                              IShader**                        ppReloadableShader)
 {
     try
     {
-        RefCntAutoPtr<ReloadableShader> pReloadableShader{MakeNewRCObj<ReloadableShader>()(pStateCache, pShader, CreateInfo)};
+        RefCntAutoPtr<ReloadableShader> pReloadableShader{MakeNewRCObj<ReloadableShader>()(pStateCache, pShader, CreateInfo, pCompiledSourceFactory)};
         *ppReloadableShader = pReloadableShader.Detach();
     }
     catch (...)
@@ -33,7 +33,9 @@
 #include "AsyncPipelineState.hpp"
 
 #include <array>
+#include <atomic>
 #include <mutex>
+#include <unordered_set>
 #include <vector>
 
 #include "Archiver.h"
@@ -49,6 +51,7 @@
 #include "GraphicsUtilities.h"
 #include "ShaderSourceFactoryUtils.hpp"
 #include "DXCompiler.hpp"
+#include "ThreadPool.hpp"
 
 namespace Diligent
 {
@@ -169,10 +172,11 @@ RenderStateCacheImpl::RenderStateCacheImpl(IReferenceCounters*               pRe
                                            const RenderStateCacheCreateInfo& CreateInfo) :
     TBase{pRefCounters},
     // clang-format off
-    m_pDevice      {CreateInfo.pDevice},
-    m_DeviceType   {CreateInfo.pDevice != nullptr ? CreateInfo.pDevice->GetDeviceInfo().Type : RENDER_DEVICE_TYPE_UNDEFINED},
-    m_CI           {CreateInfo},
-    m_pReloadSource{CreateInfo.pReloadSource}
+    m_pDevice          {CreateInfo.pDevice},
+    m_DeviceType       {CreateInfo.pDevice != nullptr ? CreateInfo.pDevice->GetDeviceInfo().Type : RENDER_DEVICE_TYPE_UNDEFINED},
+    m_CI               {CreateInfo},
+    m_pReloadSource    {CreateInfo.pReloadSource},
+    m_pReloadThreadPool{CreateInfo.pReloadThreadPool}
 // clang-format on
 {
     if (CreateInfo.pDevice == nullptr)
@@ -306,7 +310,7 @@ bool RenderStateCacheImpl::CreateShader(const ShaderCreateInfo& ShaderCI,
                     _ShaderCI.pShaderSourceStreamFactory = m_pReloadSource;
                 }
             }
-            ReloadableShader::Create(this, pShader, _ShaderCI, ppShader);
+            ReloadableShader::Create(this, pShader, _ShaderCI, ShaderCI.pShaderSourceStreamFactory, ppShader);
 
             std::lock_guard<std::mutex> Guard{m_ReloadableShadersMtx};
             m_ReloadableShaders.emplace(pShader->GetUniqueID(), RefCntWeakPtr<IShader>{*ppShader});
@@ -932,63 +936,118 @@ bool RenderStateCacheImpl::CreatePipelineStateInternal(const CreateInfoType& PSO
     return false;
 }
 
-Uint32 RenderStateCacheImpl::Reload(ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline, void* pUserData)
+Uint32 RenderStateCacheImpl::Reload(ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline,
+                                    void*                              pUserData,
+                                    RenderStateCacheReloadStats*       pStats)
 {
+    if (pStats != nullptr)
+        *pStats = {};
+
     if (!m_CI.EnableHotReload)
     {
         DEV_ERROR("This render state cache was not created with hot reload enabled. Set EnableHotReload to true.");
         return 0;
     }
 
-    Uint32 NumStatesReloaded = 0;
+    std::lock_guard<std::mutex> ReloadGuard{m_ReloadMtx};
+
+    RenderStateCacheReloadStats Stats;
+    std::atomic<Uint32>         NumStatesReloaded{0};
 
-    // Reload all shaders first
+    // Collect live shaders. Do not hold the mutex while shaders are reloaded
+    // so that other threads can create new shaders in the meantime.
+    std::vector<RefCntAutoPtr<ReloadableShader>> Shaders;
     {
         std::lock_guard<std::mutex> Guard{m_ReloadableShadersMtx};
+        Shaders.reserve(m_ReloadableShaders.size());
         for (auto shader_it : m_ReloadableShaders)
         {
             if (RefCntAutoPtr<IShader> pShader = shader_it.second.Lock())
             {
                 RefCntAutoPtr<ReloadableShader> pReloadableShader{pShader, ReloadableShader::IID_InternalImpl};
                 if (pReloadableShader)
-                {
-                    if (pReloadableShader->Reload())
-                        ++NumStatesReloaded;
-                }
+                    Shaders.emplace_back(std::move(pReloadableShader));
                 else
-                {
                     UNEXPECTED("Shader object is not a ReloadableShader");
-                }
             }
         }
     }
 
-    // Reload pipelines.
+    // Find shaders whose source files have changed. This only reads the files,
+    // so use larger chunks to keep the scheduling overhead low.
+    std::vector<Uint8> SourcesChanged(Shaders.size());
+    ProcessRangeInParallel(m_pReloadThreadPool, static_cast<Uint32>(Shaders.size()), 16,
+                           [&](Uint32 Start, Uint32 End) {
+                               for (Uint32 i = Start; i < End; ++i)
+                                   SourcesChanged[i] = Shaders[i]->HaveSourcesChanged() ? 1 : 0;
+                           });
+
+    std::vector<ReloadableShader*> ChangedShaders;
+    for (size_t i = 0; i < Shaders.size(); ++i)
+    {
+        if (SourcesChanged[i])
+            ChangedShaders.push_back(Shaders[i]);
+    }
+    Stats.NumShadersReloaded = static_cast<Uint32>(ChangedShaders.size());
+    Stats.NumShadersSkipped  = static_cast<Uint32>(Shaders.size() - ChangedShaders.size());
+
+    // Recompile changed shaders. Compilation time varies a lot between shaders,
+    // so let every task process a single shader.
+    ProcessRangeInParallel(m_pReloadThreadPool, static_cast<Uint32>(ChangedShaders.size()), 1,
+                           [&](Uint32 Start, Uint32 End) {
+                               for (Uint32 i = Start; i < End; ++i)
+                               {
+                                   if (ChangedShaders[i]->Reload())
+                                       NumStatesReloaded.fetch_add(1);
+                               }
+                           });
+
+    // Reload pipelines that reference reloaded shaders. The callback may modify any graphics pipeline,
+    // so when it is provided, all pipelines are reloaded.
     // Note that create info structs reference reloadable shaders, so that when pipelines
     // are re-created, they will automatically use reloaded shaders.
+    std::vector<RefCntAutoPtr<ReloadablePipelineState>> Pipelines;
     {
         std::lock_guard<std::mutex> Guard{m_ReloadablePipelinesMtx};
+        Pipelines.reserve(m_ReloadablePipelines.size());
         for (auto pso_it : m_ReloadablePipelines)
         {
             if (RefCntAutoPtr<IPipelineState> pPSO = pso_it.second.Lock())
             {
                 RefCntAutoPtr<ReloadablePipelineState> pReloadablePSO{pPSO, ReloadablePipelineState::IID_InternalImpl};
-                if (pPSO)
-                {
-                    if (pReloadablePSO->Reload(ReloadGraphicsPipeline, pUserData))
-                        ++NumStatesReloaded;
-                }
+                if (pReloadablePSO)
+                    Pipelines.emplace_back(std::move(pReloadablePSO));
                 else
-                {
                     UNEXPECTED("Pipeline state object is not a ReloadablePipelineState");
-                }
             }
         }
     }
 
+    const bool ReloadAllPipelines = ReloadGraphicsPipeline != nullptr;
+    if (ReloadAllPipelines || !ChangedShaders.empty())
+    {
+        const std::unordered_set<const IShader*> ReloadedShaders{ChangedShaders.begin(), ChangedShaders.end()};
+        for (ReloadablePipelineState* pReloadablePSO : Pipelines)
+        {
+            if (ReloadAllPipelines || pReloadablePSO->UsesAnyShader(ReloadedShaders))
+            {
+                if (pReloadablePSO->Reload(ReloadGraphicsPipeline, pUserData))
+                    NumStatesReloaded.fetch_add(1);
+                ++Stats.NumPipelinesReloaded;
+            }
+        }
+    }
+    Stats.NumPipelinesSkipped = static_cast<Uint32>(Pipelines.size()) - Stats.NumPipelinesReloaded;
+
+    RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_NORMAL, "Reloaded ", Stats.NumShadersReloaded, " shader(s) (", Stats.NumShadersSkipped, " unchanged) and ",
+                           Stats.NumPipelinesReloaded, " pipeline(s) (", Stats.NumPipelinesSkipped, " unaffected).");
+
     ++m_ReloadVersion;
 
-    return NumStatesReloaded;
+    if (pStats != nullptr)
+        *pStats = Stats;
+
+    return NumStatesReloaded.load();
 }
 
 static constexpr char RenderStateCacheFileExtension[] = ".diligentcache";
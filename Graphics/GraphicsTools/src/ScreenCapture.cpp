@@ -27,23 +27,54 @@
 
 #include "ScreenCapture.hpp"
 
+#include <cstring>
+#include <algorithm>
+
+#include "ThreadPool.hpp"
+#include "GraphicsAccessories.hpp"
+
 namespace Diligent
 {
 
 ScreenCapture::ScreenCapture(IRenderDevice* pDevice) :
-    m_pDevice{pDevice}
+    ScreenCapture{pDevice, AsyncModeAttribs{}}
+{
+}
+
+ScreenCapture::ScreenCapture(IRenderDevice* pDevice, const AsyncModeAttribs& Attribs) :
+    m_pDevice{pDevice},
+    m_AsyncMode{Attribs}
 {
+    if (m_AsyncMode.pThreadPool != nullptr)
+    {
+        DEV_CHECK_ERR(m_AsyncMode.Handler, "Capture handler must not be empty in asynchronous mode");
+        DEV_CHECK_ERR(m_AsyncMode.MaxPendingCaptures > 0, "MaxPendingCaptures must not be zero");
+    }
+
     FenceDesc fenceDesc;
     fenceDesc.Name = "Screen capture fence";
     m_pDevice->CreateFence(fenceDesc, &m_pFence);
 }
 
+ScreenCapture::~ScreenCapture()
+{
+    // Handlers use the pixel buffers owned by this object
+    WaitForHandlers();
+}
+
 void ScreenCapture::Capture(ISwapChain* pSwapChain, IDeviceContext* pContext, Uint32 FrameId)
 {
     ITextureView*        pCurrentRTV        = pSwapChain->GetCurrentBackBufferRTV();
     ITexture*            pCurrentBackBuffer = pCurrentRTV->GetTexture();
     const SwapChainDesc& SCDesc             = pSwapChain->GetDesc();
 
+    if (m_AsyncMode.pThreadPool != nullptr && GetNumPendingCaptures() >= m_AsyncMode.MaxPendingCaptures)
+    {
+        // Do not let the number of staging textures grow when the handlers can't keep up
+        m_NumDroppedFrames.fetch_add(1);
+        return;
+    }
+
     RefCntAutoPtr<ITexture> pStagingTexture;
 
     {
@@ -128,4 +159,134 @@ void ScreenCapture::RecycleStagingTexture(RefCntAutoPtr<ITexture>&& pTexture)
     m_AvailableTextures.emplace_back(std::move(pTexture));
 }
 
+bool ScreenCapture::AllocatePixelBuffer(size_t Size, std::vector<Uint8>& Buffer)
+{
+    std::lock_guard<std::mutex> Lock{m_PixelBuffersMtx};
+
+    for (auto it = m_AvailablePixelBuffers.begin(); it != m_AvailablePixelBuffers.end(); ++it)
+    {
+        if (it->size() >= Size)
+        {
+            Buffer = std::move(*it);
+            m_AvailablePixelBuffers.erase(it);
+            return true;
+        }
+    }
+
+    // Free the buffers that are too small (e.g. after the swap chain has been resized)
+    // to make room for the new one
+    while (m_PixelBuffersSize + Size > m_AsyncMode.MaxInFlightMemory && !m_AvailablePixelBuffers.empty())
+    {
+        m_PixelBuffersSize -= m_AvailablePixelBuffers.back().size();
+        m_AvailablePixelBuffers.pop_back();
+    }
+
+    if (m_PixelBuffersSize + Size > m_AsyncMode.MaxInFlightMemory)
+        return false;
+
+    Buffer.resize(Size);
+    m_PixelBuffersSize += Size;
+    return true;
+}
+
+void ScreenCapture::ReleasePixelBuffer(std::vector<Uint8>&& Buffer)
+{
+    std::lock_guard<std::mutex> Lock{m_PixelBuffersMtx};
+    m_AvailablePixelBuffers.emplace_back(std::move(Buffer));
+}
+
+void ScreenCapture::ProcessCaptures(IDeviceContext* pContext)
+{
+    if (m_AsyncMode.pThreadPool == nullptr)
+    {
+        UNEXPECTED("ProcessCaptures() can only be used in asynchronous mode");
+        return;
+    }
+
+    // Release the tasks that have finished
+    m_HandlerTasks.erase(std::remove_if(m_HandlerTasks.begin(), m_HandlerTasks.end(),
+                                        [](const RefCntAutoPtr<IAsyncTask>& pTask) { return pTask->IsFinished(); }),
+                         m_HandlerTasks.end());
+
+    while (CaptureInfo Capture = GetCapture())
+    {
+        const TextureDesc&          TexDesc    = Capture.pTexture->GetDesc();
+        const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
+        const Uint32                RowSize    = TexDesc.Width * Uint32{FmtAttribs.ComponentSize} * Uint32{FmtAttribs.NumComponents};
+
+        std::vector<Uint8> Pixels;
+        if (!AllocatePixelBuffer(size_t{RowSize} * TexDesc.Height, Pixels))
+        {
+            m_NumDroppedFrames.fetch_add(1);
+            RecycleStagingTexture(std::move(Capture.pTexture));
+            continue;
+        }
+
+        // The fence has been signaled, so mapping does not stall
+        MappedTextureSubresource TexData;
+        pContext->MapTextureSubresource(Capture.pTexture, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, TexData);
+        if (TexData.pData == nullptr)
+        {
+            UNEXPECTED("Failed to map the staging texture");
+            ReleasePixelBuffer(std::move(Pixels));
+            m_NumDroppedFrames.fetch_add(1);
+            RecycleStagingTexture(std::move(Capture.pTexture));
+            continue;
+        }
+        for (Uint32 row = 0; row < TexDesc.Height; ++row)
+        {
+            std::memcpy(&Pixels[size_t{row} * RowSize], static_cast<const Uint8*>(TexData.pData) + row * TexData.Stride, RowSize);
+        }
+        pContext->UnmapTextureSubresource(Capture.pTexture, 0, 0);
+
+        CapturedPixels Frame;
+        Frame.Id     = Capture.Id;
+        Frame.Width  = TexDesc.Width;
+        Frame.Height = TexDesc.Height;
+        Frame.Format = TexDesc.Format;
+        Frame.Stride = RowSize;
+        RecycleStagingTexture(std::move(Capture.pTexture));
+
+        m_NumFramesInFlight.fetch_add(1);
+        m_HandlerTasks.emplace_back(
+            EnqueueAsyncWork(m_AsyncMode.pThreadPool,
+                             [this, Frame, Pixels = std::move(Pixels)](Uint32 /*ThreadId*/) mutable {
+                                 Frame.pData = Pixels.data();
+                                 m_AsyncMode.Handler(Frame);
+                                 ReleasePixelBuffer(std::move(Pixels));
+                                 m_NumProcessedFrames.fetch_add(1);
+                                 m_NumFramesInFlight.fetch_sub(1);
+                                 return ASYNC_TASK_STATUS_COMPLETE;
+                             }));
+    }
+}
+
+void ScreenCapture::WaitForHandlers()
+{
+    for (RefCntAutoPtr<IAsyncTask>& pTask : m_HandlerTasks)
+        pTask->WaitForCompletion();
+    m_HandlerTasks.clear();
+}
+
+void ScreenCapture::Flush(IDeviceContext* pContext)
+{
+    pContext->Flush();
+    m_pFence->Wait(m_CurrentFenceValue - 1);
+    ProcessCaptures(pContext);
+    WaitForHandlers();
+}
+
+ScreenCapture::AsyncStats ScreenCapture::GetAsyncStats()
+{
+    AsyncStats Stats;
+    Stats.NumProcessedFrames = m_NumProcessedFrames.load();
+    Stats.NumDroppedFrames   = m_NumDroppedFrames.load();
+    Stats.NumFramesInFlight  = m_NumFramesInFlight.load();
+    {
+        std::lock_guard<std::mutex> Lock{m_PixelBuffersMtx};
+        Stats.PixelBuffersSize = m_PixelBuffersSize;
+    }
+    return Stats;
+}
+
 } // namespace Diligent
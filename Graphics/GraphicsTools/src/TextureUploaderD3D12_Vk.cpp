@@ -29,6 +29,7 @@
 #include <unordered_map>
 #include <deque>
 #include <vector>
+#include <algorithm>
 
 #include "TextureUploaderD3D12_Vk.hpp"
 #include "ThreadSignal.hpp"
@@ -110,6 +111,12 @@ public:
 
     ITexture* GetStagingTexture() { return m_pStagingTexture; }
 
+    void SetStagingTexture(ITexture* pStagingTexture)
+    {
+        VERIFY(!m_pStagingTexture, "Staging texture has already been set");
+        m_pStagingTexture = pStagingTexture;
+    }
+
     bool DbgIsCopyScheduled() const
     {
         return m_CopyScheduledSignal.IsTriggered();
@@ -166,15 +173,47 @@ struct TextureUploaderD3D12_Vk::InternalData
         // clang-format on
     };
 
-    InternalData(IRenderDevice* pDevice)
+    InternalData(IRenderDevice* pDevice, IDeviceContext* pTransferCtx) :
+        m_pDevice{pDevice}
     {
+        if (pTransferCtx != nullptr)
+        {
+            if (pTransferCtx->GetDesc().IsDeferred)
+            {
+                LOG_ERROR_MESSAGE("Texture uploader transfer context must be an immediate context. Copies will be recorded in the render thread context.");
+            }
+            else if (!pDevice->GetDeviceInfo().Features.NativeFence)
+            {
+                // The graphics and transfer queues synchronize through general fences on the GPU
+                LOG_WARNING_MESSAGE("Texture uploader transfer context requires the NativeFence feature. Copies will be recorded in the render thread context.");
+            }
+            else
+            {
+                m_pTransferCtx = pTransferCtx;
+            }
+        }
+
         FenceDesc fenceDesc;
         fenceDesc.Name = "Texture uploader sync fence";
+        // In transfer mode, the graphics queue waits for this fence on the GPU
+        fenceDesc.Type = m_pTransferCtx ? FENCE_TYPE_GENERAL : FENCE_TYPE_CPU_WAIT_ONLY;
         pDevice->CreateFence(fenceDesc, &m_pFence);
+
+        if (m_pTransferCtx)
+        {
+            fenceDesc.Name = "Texture uploader graphics queue fence";
+            pDevice->CreateFence(fenceDesc, &m_pGraphicsFence);
+        }
     }
 
     ~InternalData()
     {
+        if (!m_InFlightBatches.empty())
+        {
+            LOG_WARNING_MESSAGE("TextureUploaderD3D12_Vk: ", m_InFlightBatches.size(), " transfer queue copy batch(es) have not been released. "
+                                                                                       "Threads waiting for these copies may deadlock.");
+        }
+
         for (auto it : m_UploadTexturesCache)
         {
             if (it.second.size())
@@ -261,7 +300,37 @@ struct TextureUploaderD3D12_Vk::InternalData
 
     void Execute(IDeviceContext* pContext, PendingBufferOperation& OperationInfo);
 
+    bool HasTransferContext() const
+    {
+        return m_pTransferCtx != nullptr;
+    }
+
+    // In transfer mode, pRenderCtx must be the render thread context that maps the texture
+    RefCntAutoPtr<ITexture> CreateStagingTexture(const UploadBufferDesc& Desc, IDeviceContext* pRenderCtx);
+
+    // Records the copy operations in the transfer context and submits them to the transfer queue.
+    // Returns the fence value that will be signaled when the copies are complete, or 0 if there are no copies.
+    Uint64 ExecuteCopiesOnTransferQueue(IDeviceContext* pGraphicsCtx, PendingBufferOperation* pOperations, size_t NumOperations);
+
+    // Makes the graphics context wait on the GPU for all copy batches with fence values up to MaxFenceValue,
+    // transitions their destination textures back to the graphics queue and signals the upload buffers.
+    void ReleaseCopies(IDeviceContext* pGraphicsCtx, Uint64 MaxFenceValue);
+
+    // Same as ReleaseCopies(), but only releases the most recently submitted copy batch.
+    // The batches submitted earlier stay in flight.
+    void ReleaseLastCopyBatch(IDeviceContext* pGraphicsCtx);
+
+    Uint64 GetCompletedFenceValue()
+    {
+        // Fences can't be accessed from multiple threads simultaneously even
+        // when protected by mutex
+        return m_pFence->GetCompletedValue();
+    }
+
 private:
+    // The device is kept alive by the uploader
+    IRenderDevice* const m_pDevice;
+
     std::mutex                          m_PendingOperationsMtx;
     std::vector<PendingBufferOperation> m_PendingOperations;
     std::vector<PendingBufferOperation> m_InWorkOperations;
@@ -272,11 +341,36 @@ private:
     RefCntAutoPtr<IFence> m_pFence;
     Uint64                m_NextFenceValue      = 1;
     Uint64                m_CompletedFenceValue = 0;
+
+    // Transfer mode. All members below are only accessed by the render thread.
+    RefCntAutoPtr<IDeviceContext> m_pTransferCtx;
+    // Signaled by the graphics context when the transfer queue must wait for it
+    RefCntAutoPtr<IFence> m_pGraphicsFence;
+    Uint64                m_NextGraphicsFenceValue = 1;
+
+    struct CopyBatch
+    {
+        // Transfer fence value signaled when the copies in the batch are complete
+        Uint64 FenceValue = 0;
+
+        std::vector<RefCntAutoPtr<UploadTexture>> UploadTextures;
+        std::vector<RefCntAutoPtr<ITexture>>      DstTextures;
+    };
+    // Copy batches submitted to the transfer queue that have not been released to the graphics queue yet
+    std::deque<CopyBatch> m_InFlightBatches;
+    // The number of in-flight batches that copy to each destination texture
+    std::unordered_map<ITexture*, Uint32> m_InFlightDstTextures;
+
+    // Releases the destination textures of the batch that are not written by other in-flight batches
+    // and signals its upload buffers. Barriers for the released textures are added to m_Barriers.
+    void ReleaseBatch(CopyBatch& Batch);
+
+    std::vector<StateTransitionDesc> m_Barriers;
 };
 
 TextureUploaderD3D12_Vk::TextureUploaderD3D12_Vk(IReferenceCounters* pRefCounters, IRenderDevice* pDevice, const TextureUploaderDesc Desc) :
     TextureUploaderBase{pRefCounters, pDevice, Desc},
-    m_pInternalData{new InternalData(pDevice)}
+    m_pInternalData{new InternalData(pDevice, Desc.pTransferContext)}
 {
 }
 
@@ -294,8 +388,29 @@ TextureUploaderD3D12_Vk::~TextureUploaderD3D12_Vk()
 
 void TextureUploaderD3D12_Vk::RenderThreadUpdate(IDeviceContext* pContext)
 {
+    if (m_pInternalData->HasTransferContext())
+    {
+        // Release the copies that have been completed by the transfer queue. The graphics
+        // queue never stalls waiting for the copies that are still in flight.
+        m_pInternalData->ReleaseCopies(pContext, m_pInternalData->GetCompletedFenceValue());
+    }
+
     auto& InWorkOperations = m_pInternalData->SwapMapQueues();
-    if (!InWorkOperations.empty())
+    if (!InWorkOperations.empty() && m_pInternalData->HasTransferContext())
+    {
+        for (InternalData::PendingBufferOperation& OperationInfo : InWorkOperations)
+        {
+            if (OperationInfo.operation == InternalData::PendingBufferOperation::Map)
+                m_pInternalData->Execute(pContext, OperationInfo);
+        }
+
+        // Upload buffers will be signaled by one of the next calls to RenderThreadUpdate
+        // when the copies are complete.
+        m_pInternalData->ExecuteCopiesOnTransferQueue(pContext, InWorkOperations.data(), InWorkOperations.size());
+
+        InWorkOperations.clear();
+    }
+    else if (!InWorkOperations.empty())
     {
         Uint32 NumCopyOperations = 0;
         for (InternalData::PendingBufferOperation& OperationInfo : InWorkOperations)
@@ -326,6 +441,132 @@ void TextureUploaderD3D12_Vk::RenderThreadUpdate(IDeviceContext* pContext)
 }
 
 
+Uint64 TextureUploaderD3D12_Vk::InternalData::ExecuteCopiesOnTransferQueue(IDeviceContext*         pGraphicsCtx,
+                                                                           PendingBufferOperation* pOperations,
+                                                                           size_t                  NumOperations)
+{
+    VERIFY_EXPR(m_pTransferCtx);
+
+    CopyBatch Batch;
+    m_Barriers.clear();
+    for (size_t i = 0; i < NumOperations; ++i)
+    {
+        const PendingBufferOperation& OperationInfo = pOperations[i];
+        if (OperationInfo.operation != PendingBufferOperation::Copy)
+            continue;
+
+        Batch.UploadTextures.emplace_back(OperationInfo.pUploadTexture);
+
+        ITexture* pDstTex = OperationInfo.pDstTexture;
+        if (std::find(Batch.DstTextures.begin(), Batch.DstTextures.end(), pDstTex) != Batch.DstTextures.end())
+            continue;
+        Batch.DstTextures.emplace_back(pDstTex);
+
+        // Transfer queues only support copy and common states, so textures in other
+        // states are transitioned by the graphics context before the copies start.
+        const RESOURCE_STATE State = pDstTex->GetState();
+        if (State != RESOURCE_STATE_UNKNOWN &&
+            (State & ~(RESOURCE_STATE_UNDEFINED | RESOURCE_STATE_COMMON | RESOURCE_STATE_COPY_DEST)) != 0)
+        {
+            m_Barriers.emplace_back(pDstTex, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_COPY_DEST, STATE_TRANSITION_FLAG_UPDATE_STATE);
+        }
+    }
+    if (Batch.UploadTextures.empty())
+        return 0;
+
+    if (!m_Barriers.empty())
+    {
+        pGraphicsCtx->TransitionResourceStates(static_cast<Uint32>(m_Barriers.size()), m_Barriers.data());
+        pGraphicsCtx->EnqueueSignal(m_pGraphicsFence, m_NextGraphicsFenceValue);
+        pGraphicsCtx->Flush();
+        m_pTransferCtx->DeviceWaitForFence(m_pGraphicsFence, m_NextGraphicsFenceValue);
+        ++m_NextGraphicsFenceValue;
+    }
+
+    for (size_t i = 0; i < NumOperations; ++i)
+    {
+        if (pOperations[i].operation == PendingBufferOperation::Copy)
+            Execute(m_pTransferCtx, pOperations[i]);
+    }
+
+    // Release the destination textures from the transfer queue. Direct3D12 resources
+    // used by a copy queue decay to the common state anyway.
+    m_Barriers.clear();
+    for (ITexture* pDstTex : Batch.DstTextures)
+    {
+        if (pDstTex->GetState() != RESOURCE_STATE_UNKNOWN)
+            m_Barriers.emplace_back(pDstTex, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_COMMON, STATE_TRANSITION_FLAG_UPDATE_STATE);
+        ++m_InFlightDstTextures[pDstTex];
+    }
+    if (!m_Barriers.empty())
+        m_pTransferCtx->TransitionResourceStates(static_cast<Uint32>(m_Barriers.size()), m_Barriers.data());
+
+    Batch.FenceValue = SignalFence(m_pTransferCtx);
+    m_pTransferCtx->Flush();
+
+    const Uint64 FenceValue = Batch.FenceValue;
+    m_InFlightBatches.emplace_back(std::move(Batch));
+    return FenceValue;
+}
+
+void TextureUploaderD3D12_Vk::InternalData::ReleaseBatch(CopyBatch& Batch)
+{
+    for (ITexture* pDstTex : Batch.DstTextures)
+    {
+        auto it = m_InFlightDstTextures.find(pDstTex);
+        VERIFY_EXPR(it != m_InFlightDstTextures.end() && it->second > 0);
+        // Textures that are still being written by other batches must stay on the transfer queue
+        if (--it->second > 0)
+            continue;
+        m_InFlightDstTextures.erase(it);
+
+        if (pDstTex->GetState() != RESOURCE_STATE_UNKNOWN && (pDstTex->GetDesc().BindFlags & BIND_SHADER_RESOURCE) != 0)
+            m_Barriers.emplace_back(pDstTex, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE);
+    }
+
+    // Upload buffers may be recycled once the copy is signaled. They will be reused only after the
+    // fence has been completed, see FindCachedUploadTexture().
+    for (UploadTexture* pUploadTex : Batch.UploadTextures)
+        pUploadTex->SignalCopyScheduled(Batch.FenceValue);
+}
+
+void TextureUploaderD3D12_Vk::InternalData::ReleaseCopies(IDeviceContext* pGraphicsCtx, Uint64 MaxFenceValue)
+{
+    if (m_InFlightBatches.empty() || m_InFlightBatches.front().FenceValue > MaxFenceValue)
+        return;
+
+    m_Barriers.clear();
+    Uint64 LastFenceValue = 0;
+    while (!m_InFlightBatches.empty() && m_InFlightBatches.front().FenceValue <= MaxFenceValue)
+    {
+        CopyBatch& Batch = m_InFlightBatches.front();
+        LastFenceValue   = Batch.FenceValue;
+        ReleaseBatch(Batch);
+        m_InFlightBatches.pop_front();
+    }
+
+    // Waiting for the last batch also covers all previous ones since they were submitted to the same queue
+    pGraphicsCtx->DeviceWaitForFence(m_pFence, LastFenceValue);
+    if (!m_Barriers.empty())
+        pGraphicsCtx->TransitionResourceStates(static_cast<Uint32>(m_Barriers.size()), m_Barriers.data());
+}
+
+void TextureUploaderD3D12_Vk::InternalData::ReleaseLastCopyBatch(IDeviceContext* pGraphicsCtx)
+{
+    if (m_InFlightBatches.empty())
+        return;
+
+    m_Barriers.clear();
+    CopyBatch&   Batch      = m_InFlightBatches.back();
+    const Uint64 FenceValue = Batch.FenceValue;
+    ReleaseBatch(Batch);
+    m_InFlightBatches.pop_back();
+
+    pGraphicsCtx->DeviceWaitForFence(m_pFence, FenceValue);
+    if (!m_Barriers.empty())
+        pGraphicsCtx->TransitionResourceStates(static_cast<Uint32>(m_Barriers.size()), m_Barriers.data());
+}
+
 void TextureUploaderD3D12_Vk::InternalData::Execute(IDeviceContext*         pContext,
                                                     PendingBufferOperation& OperationInfo)
 {
@@ -336,6 +577,11 @@ void TextureUploaderD3D12_Vk::InternalData::Execute(IDeviceContext*         pCon
     {
         case InternalData::PendingBufferOperation::Map:
         {
+            if (pUploadTex->GetStagingTexture() == nullptr)
+            {
+                // The buffer has been allocated by a worker thread in transfer mode, see AllocateUploadBuffer()
+                pUploadTex->SetStagingTexture(CreateStagingTexture(StagingTexDesc, pContext));
+            }
             for (Uint32 Slice = 0; Slice < StagingTexDesc.ArraySize; ++Slice)
             {
                 for (Uint32 Mip = 0; Mip < StagingTexDesc.MipLevels; ++Mip)
@@ -375,6 +621,37 @@ void TextureUploaderD3D12_Vk::InternalData::Execute(IDeviceContext*         pCon
     }
 }
 
+RefCntAutoPtr<ITexture> TextureUploaderD3D12_Vk::InternalData::CreateStagingTexture(const UploadBufferDesc& Desc, IDeviceContext* pRenderCtx)
+{
+    TextureDesc StagingTexDesc;
+    StagingTexDesc.Type           = Desc.ArraySize == 1 ? RESOURCE_DIM_TEX_2D : RESOURCE_DIM_TEX_2D_ARRAY;
+    StagingTexDesc.Width          = Desc.Width;
+    StagingTexDesc.Height         = Desc.Height;
+    StagingTexDesc.Format         = Desc.Format;
+    StagingTexDesc.MipLevels      = Desc.MipLevels;
+    StagingTexDesc.ArraySize      = Desc.ArraySize;
+    StagingTexDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+    StagingTexDesc.Usage          = USAGE_STAGING;
+    if (m_pTransferCtx)
+    {
+        // Staging textures are mapped in the render thread context and copied in the transfer context
+        VERIFY_EXPR(pRenderCtx != nullptr);
+        const Uint32 RenderCtxId   = pRenderCtx->GetDesc().ContextId;
+        const Uint32 TransferCtxId = m_pTransferCtx->GetDesc().ContextId;
+
+        StagingTexDesc.ImmediateContextMask = (Uint64{1} << RenderCtxId) | (Uint64{1} << TransferCtxId);
+    }
+
+    RefCntAutoPtr<ITexture> pStagingTexture;
+    m_pDevice->CreateTexture(StagingTexDesc, nullptr, &pStagingTexture);
+
+    LOG_INFO_MESSAGE("Created ", Desc.Width, "x", Desc.Height, 'x', Desc.Depth, ' ', Desc.MipLevels, "-mip ",
+                     Desc.ArraySize, "-slice ",
+                     GetTextureFormatAttribs(Desc.Format).Name, " staging texture");
+
+    return pStagingTexture;
+}
+
 void TextureUploaderD3D12_Vk::AllocateUploadBuffer(IDeviceContext*         pContext,
                                                    const UploadBufferDesc& Desc,
                                                    IUploadBuffer**         ppBuffer)
@@ -384,22 +661,12 @@ void TextureUploaderD3D12_Vk::AllocateUploadBuffer(IDeviceContext*         pCont
     // No available buffer found in the cache
     if (!pUploadTexture)
     {
-        TextureDesc StagingTexDesc;
-        StagingTexDesc.Type           = Desc.ArraySize == 1 ? RESOURCE_DIM_TEX_2D : RESOURCE_DIM_TEX_2D_ARRAY;
-        StagingTexDesc.Width          = Desc.Width;
-        StagingTexDesc.Height         = Desc.Height;
-        StagingTexDesc.Format         = Desc.Format;
-        StagingTexDesc.MipLevels      = Desc.MipLevels;
-        StagingTexDesc.ArraySize      = Desc.ArraySize;
-        StagingTexDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
-        StagingTexDesc.Usage          = USAGE_STAGING;
-
+        // In transfer mode, the staging texture must be accessible by the render thread context.
+        // A worker thread does not know this context, so the texture is created when the buffer
+        // is mapped by RenderThreadUpdate().
         RefCntAutoPtr<ITexture> pStagingTexture;
-        m_pDevice->CreateTexture(StagingTexDesc, nullptr, &pStagingTexture);
-
-        LOG_INFO_MESSAGE("Created ", Desc.Width, "x", Desc.Height, 'x', Desc.Depth, ' ', Desc.MipLevels, "-mip ",
-                         Desc.ArraySize, "-slice ",
-                         GetTextureFormatAttribs(Desc.Format).Name, " staging texture");
+        if (pContext != nullptr || !m_pInternalData->HasTransferContext())
+            pStagingTexture = m_pInternalData->CreateStagingTexture(Desc, pContext);
 
         pUploadTexture = MakeNewRCObj<UploadTexture>()(Desc, pStagingTexture);
     }
@@ -437,6 +704,18 @@ void TextureUploaderD3D12_Vk::ScheduleGPUCopy(IDeviceContext* pContext,
                 ArraySlice,
                 MipLevel //
             };
+        if (m_pInternalData->HasTransferContext())
+        {
+            m_pInternalData->ExecuteCopiesOnTransferQueue(pContext, &CopyOp, 1);
+            // The caller may use the texture and recycle the buffer right away, so make the
+            // graphics queue wait for this copy on the GPU instead of waiting for its completion.
+            // Batches submitted by RenderThreadUpdate() stay in flight and are released by it.
+            m_pInternalData->ReleaseLastCopyBatch(pContext);
+            VERIFY_EXPR(pUploadTexture->DbgIsCopyScheduled());
+            m_pInternalData->UpdatedCompletedFenceValue();
+            return;
+        }
+
         m_pInternalData->Execute(pContext, CopyOp);
 
         // The buffer may be recycled immediately after the copy scheduled is signaled,
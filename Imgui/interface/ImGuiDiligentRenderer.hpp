@@ -27,11 +27,16 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include "../../../DiligentCore/Primitives/interface/BasicTypes.h"
 #include "../../../DiligentCore/Common/interface/BasicMath.hpp"
 #include "../../../DiligentCore/Common/interface/RefCntAutoPtr.hpp"
 #include "../../../DiligentCore/Graphics/GraphicsEngine/interface/GraphicsTypes.h"
+#include "../../../DiligentCore/Graphics/GraphicsEngine/interface/DeviceContext.h"
 #include "imgui.h"
 
 struct ImDrawData;
@@ -42,15 +47,77 @@ namespace Diligent
 struct IRenderDevice;
 struct IDeviceContext;
 struct IBuffer;
+struct IFence;
 struct IPipelineState;
 struct ITextureView;
 struct IShaderResourceBinding;
-struct IShaderResourceVariable;
 struct ImGuiDiligentCreateInfo;
 enum TEXTURE_FORMAT : Uint16;
 enum SURFACE_TRANSFORM : Uint32;
 enum IMGUI_COLOR_CONVERSION_MODE : Uint8;
 
+/// ImGui draw command together with the render state it requires.
+struct ImGuiDrawCommand
+{
+    ITextureView* pTextureView = nullptr;
+    Rect          Scissor;
+    Uint64        VtxOffset  = 0;
+    Uint32        NumIndices = 0;
+    Uint32        FirstIndex = 0;
+    Uint32        BaseVertex = 0;
+};
+
+/// Range of draw items that are submitted with the same render state.
+struct ImGuiDrawBatch
+{
+    ITextureView* pTextureView = nullptr;
+    Rect          Scissor;
+    Uint64        VtxOffset = 0;
+    Uint32        FirstItem = 0;
+    Uint32        NumItems  = 0;
+};
+
+/// Splits the draw commands into batches of adjacent commands that share the texture,
+/// the scissor rect and the vertex buffer offset. Within a batch, commands with contiguous
+/// index ranges and the same base vertex are merged into a single draw item.
+/// The previous contents of Batches and Items are discarded.
+void BatchImGuiDrawCommands(const std::vector<ImGuiDrawCommand>& Commands,
+                            std::vector<ImGuiDrawBatch>&         Batches,
+                            std::vector<MultiDrawIndexedItem>&   Items);
+
+/// Space management of a ring buffer whose regions are reused once the GPU reaches
+/// the fence value that was enqueued after the frame that used them.
+/// All offsets and sizes are in elements.
+class ImGuiGeometryRing
+{
+public:
+    /// Empties the ring and sets its capacity.
+    void Reset(Uint32 Capacity);
+
+    /// Allocates a contiguous region. Returns false if the ring does not have enough free space.
+    bool Allocate(Uint32 NumElements, Uint32& Offset);
+
+    /// Marks the end of the frame, whose regions are released when the GPU reaches FenceValue.
+    void FinishFrame(Uint64 FenceValue);
+
+    /// Releases the regions of all frames whose fence values have been reached.
+    void Reclaim(Uint64 CompletedFenceValue);
+
+    /// Returns the capacity of the ring that replaces this ring when it is full and NumElements must be allocated.
+    Uint32 GetGrownCapacity(Uint32 NumElements) const;
+
+    Uint32 GetCapacity() const { return m_Capacity; }
+    Uint64 GetUsedSize() const { return m_Head - m_Tail; }
+
+private:
+    Uint32 m_Capacity = 0;
+    // The counters never wrap, the offset in the buffer is Head % Capacity.
+    Uint64 m_Head = 0;
+    Uint64 m_Tail = 0;
+    // Fence value and ring head at the end of each frame that is still in flight
+    std::deque<std::pair<Uint64, Uint64>> m_InFlight;
+};
+
 class ImGuiDiligentRenderer
 {
 public:
@@ -70,24 +137,86 @@ private:
     void          UpdateTexture(IDeviceContext* pCtx, ImTextureData* tex);
     void          DestroyTexture(ImTextureData* tex);
 
+    IShaderResourceBinding* GetTextureSRB(ITextureView* pTextureView);
+    void                    PurgeTextureSRBs();
+
+    struct GeometryBuffer;
+    bool UploadGeometry(IDeviceContext* pCtx, const ImDrawData* pDrawData, Uint32& FirstVertex, Uint32& FirstIndex);
+    void CreateGeometryBuffer(IDeviceContext* pCtx, GeometryBuffer& Buff);
+    bool AllocateRingSpace(IDeviceContext* pCtx, GeometryBuffer& Buff, Uint32 NumElements, Uint32& Offset);
+    void ShrinkGeometryBuffer(GeometryBuffer& Buff);
+    void DisablePersistentGeometry();
+
 private:
-    RefCntAutoPtr<IRenderDevice>          m_pDevice;
-    RefCntAutoPtr<IBuffer>                m_pVB;
-    RefCntAutoPtr<IBuffer>                m_pIB;
-    RefCntAutoPtr<IBuffer>                m_pVertexConstantBuffer;
-    RefCntAutoPtr<IPipelineState>         m_pPSO;
-    RefCntAutoPtr<IShaderResourceBinding> m_pSRB;
-    IShaderResourceVariable*              m_pTextureVar = nullptr;
+    RefCntAutoPtr<IRenderDevice>  m_pDevice;
+    RefCntAutoPtr<IBuffer>        m_pVertexConstantBuffer;
+    RefCntAutoPtr<IPipelineState> m_pPSO;
+
+    // Vertex or index buffer.
+    // When persistent geometry is used, the buffer is a ring in unified memory that stays mapped
+    // for its lifetime, and the draw lists are written directly into it. Regions of the ring are
+    // reclaimed when the GPU signals the fence enqueued after the frame that used them.
+    // Otherwise, the buffer is a dynamic buffer. On backends where dynamic buffers keep their contents
+    // between frames, each frame appends its geometry with MAP_FLAG_NO_OVERWRITE, and the buffer is
+    // mapped with MAP_FLAG_DISCARD when it is full. Other backends discard the buffer every frame.
+    struct GeometryBuffer
+    {
+        const char* const Name;
+        const BIND_FLAGS  BindFlags;
+        const Uint32      ElementSize;
+        const Uint32      InitialCapacity;
+
+        RefCntAutoPtr<IBuffer> pBuffer;
+
+        Uint32 Capacity  = 0; // In elements
+        Uint32 PeakUsage = 0; // The maximum number of elements used by a frame since the last shrink check
+
+        Uint8* pMappedData = nullptr;
+        bool   Coherent    = true;
+        // Space of the persistent ring
+        ImGuiGeometryRing Ring;
+        // End of the geometry written to the dynamic buffer since the last discard, in elements
+        Uint64 Head = 0;
+
+        GeometryBuffer(const char* _Name, BIND_FLAGS _BindFlags, Uint32 _ElementSize, Uint32 _InitialCapacity) noexcept :
+            Name{_Name},
+            BindFlags{_BindFlags},
+            ElementSize{_ElementSize},
+            InitialCapacity{_InitialCapacity},
+            Capacity{_InitialCapacity}
+        {}
+    };
+    GeometryBuffer m_Vertices;
+    GeometryBuffer m_Indices;
+
+    RefCntAutoPtr<IFence> m_pFence;
+    Uint64                m_FenceValue = 0;
+
+    struct TextureSRBCacheEntry
+    {
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+        Uint64                                LastUsedFrame = 0;
+    };
+    // Shader resource bindings for each texture, so that switching textures
+    // only requires committing another SRB.
+    std::unordered_map<ITextureView*, TextureSRBCacheEntry> m_TextureSRBs;
+
+    // Draw commands since the last user callback, and the batches and draw items they are split into
+    std::vector<ImGuiDrawCommand>     m_DrawCommands;
+    std::vector<ImGuiDrawBatch>       m_DrawBatches;
+    std::vector<MultiDrawIndexedItem> m_DrawItems;
 
     const TEXTURE_FORMAT              m_BackBufferFmt;
     const TEXTURE_FORMAT              m_DepthBufferFmt;
-    Uint32                            m_VertexBufferSize    = 0;
-    Uint32                            m_IndexBufferSize     = 0;
     Uint32                            m_RenderSurfaceWidth  = 0;
     Uint32                            m_RenderSurfaceHeight = 0;
     SURFACE_TRANSFORM                 m_SurfacePreTransform = SURFACE_TRANSFORM_IDENTITY;
     const IMGUI_COLOR_CONVERSION_MODE m_ColorConversionMode;
-    bool                              m_BaseVertexSupported = false;
+    bool                              m_BaseVertexSupported   = false;
+    bool                              m_NativeMultiDraw       = false;
+    bool                              m_PersistentGeometry    = false;
+    bool                              m_AppendDynamicGeometry = false;
+    Uint64                            m_FrameIndex            = 0;
 };
 
 } // namespace Diligent
@@ -491,15 +491,29 @@ fragment PSOut ps_main(VSOut in [[stage_in]],
 ImGuiDiligentRenderer::ImGuiDiligentRenderer(const ImGuiDiligentCreateInfo& CI) :
     // clang-format off
     m_pDevice            {CI.pDevice},
+    m_Vertices           {"Imgui vertex buffer", BIND_VERTEX_BUFFER, sizeof(ImDrawVert), CI.InitialVertexBufferSize},
+    m_Indices            {"Imgui index buffer",  BIND_INDEX_BUFFER,  sizeof(ImDrawIdx),  CI.InitialIndexBufferSize},
     m_BackBufferFmt      {CI.BackBufferFmt},
     m_DepthBufferFmt     {CI.DepthBufferFmt},
-    m_VertexBufferSize   {CI.InitialVertexBufferSize},
-    m_IndexBufferSize    {CI.InitialIndexBufferSize},
     m_ColorConversionMode{CI.ColorConversion}
 // clang-format on
 {
     //Check base vertex support
     m_BaseVertexSupported = m_pDevice->GetAdapterInfo().DrawCommand.CapFlags & DRAW_COMMAND_CAP_FLAG_BASE_VERTEX;
+    m_NativeMultiDraw     = m_pDevice->GetDeviceInfo().Features.NativeMultiDraw == DEVICE_FEATURE_STATE_ENABLED;
+
+    // Vulkan keeps unified memory persistently mapped, so geometry can be written directly into it.
+    // Other backends either do not support unified buffers or map them through the driver.
+    m_PersistentGeometry = (m_pDevice->GetDeviceInfo().Type == RENDER_DEVICE_TYPE_VULKAN &&
+                            (m_pDevice->GetAdapterInfo().Memory.UnifiedMemoryCPUAccess & CPU_ACCESS_WRITE) != 0);
+
+    // D3D11 and OpenGL dynamic buffers keep their contents between frames, so the geometry of consecutive frames
+    // is appended to the buffer with MAP_FLAG_NO_OVERWRITE, and the buffer is only discarded when it is full.
+    // D3D12 and Vulkan dynamic buffers are allocated from the upload heap every frame and must be discarded.
+    // WebGL emulates mapping by uploading the entire buffer, so appending to it is not possible.
+#if !PLATFORM_WEB
+    m_AppendDynamicGeometry = m_pDevice->GetDeviceInfo().Type == RENDER_DEVICE_TYPE_D3D11 || m_pDevice->GetDeviceInfo().IsGLDevice();
+#endif
 
     // Setup back-end capabilities flags
     IMGUI_CHECKVERSION();
@@ -541,11 +555,15 @@ void ImGuiDiligentRenderer::InvalidateDeviceObjects()
         DestroyTexture(tex);
     }
 
-    m_pVB.Release();
-    m_pIB.Release();
+    for (GeometryBuffer* pBuff : {&m_Vertices, &m_Indices})
+    {
+        pBuff->pBuffer.Release();
+        pBuff->pMappedData = nullptr;
+    }
+    m_pFence.Release();
     m_pVertexConstantBuffer.Release();
     m_pPSO.Release();
-    m_pSRB.Release();
+    m_TextureSRBs.clear();
 }
 
 void ImGuiDiligentRenderer::CreateDeviceObjects()
@@ -697,7 +715,7 @@ void ImGuiDiligentRenderer::CreateDeviceObjects()
 
     ShaderResourceVariableDesc Variables[] =
         {
-            {SHADER_TYPE_PIXEL, "Texture", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC} //
+            {SHADER_TYPE_PIXEL, "Texture", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE} //
         };
     PSOCreateInfo.PSODesc.ResourceLayout.Variables    = Variables;
     PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = _countof(Variables);
@@ -725,10 +743,19 @@ void ImGuiDiligentRenderer::CreateDeviceObjects()
     }
     m_pPSO->GetStaticVariableByName(SHADER_TYPE_VERTEX, "Constants")->Set(m_pVertexConstantBuffer);
 
-    m_pSRB.Release();
-    m_pPSO->CreateShaderResourceBinding(&m_pSRB, true);
-    m_pTextureVar = m_pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "Texture");
-    VERIFY_EXPR(m_pTextureVar != nullptr);
+    if (m_PersistentGeometry)
+    {
+        FenceDesc Desc;
+        Desc.Name = "Imgui geometry fence";
+        Desc.Type = FENCE_TYPE_CPU_WAIT_ONLY;
+        m_pDevice->CreateFence(Desc, &m_pFence);
+        m_FenceValue = 0;
+        if (!m_pFence)
+            DisablePersistentGeometry();
+    }
+
+    // Shader resource bindings reference the old pipeline
+    m_TextureSRBs.clear();
 }
 
 float4 ImGuiDiligentRenderer::TransformClipRect(const ImVec2& DisplaySize, const float4& rect) const
@@ -916,6 +943,7 @@ void ImGuiDiligentRenderer::DestroyTexture(ImTextureData* tex)
 {
     if (ITexture* pTexture = static_cast<ITexture*>(tex->BackendUserData))
     {
+        m_TextureSRBs.erase(pTexture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
         pTexture->Release();
     }
 
@@ -924,6 +952,322 @@ void ImGuiDiligentRenderer::DestroyTexture(ImTextureData* tex)
     tex->SetStatus(ImTextureStatus_Destroyed);
 }
 
+IShaderResourceBinding* ImGuiDiligentRenderer::GetTextureSRB(ITextureView* pTextureView)
+{
+    TextureSRBCacheEntry& Entry = m_TextureSRBs[pTextureView];
+    if (!Entry.pSRB)
+    {
+        // The SRB keeps the texture view alive, so the pointer can't be reused
+        // by another view while the entry is in the cache.
+        m_pPSO->CreateShaderResourceBinding(&Entry.pSRB, true);
+        if (!Entry.pSRB)
+        {
+            m_TextureSRBs.erase(pTextureView);
+            return nullptr;
+        }
+        IShaderResourceVariable* pTextureVar = Entry.pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "Texture");
+        VERIFY_EXPR(pTextureVar != nullptr);
+        pTextureVar->Set(pTextureView);
+    }
+    Entry.LastUsedFrame = m_FrameIndex;
+    return Entry.pSRB;
+}
+
+void ImGuiDiligentRenderer::PurgeTextureSRBs()
+{
+    // Release the SRBs of the textures that have not been used recently to
+    // let the application release the textures.
+    static constexpr Uint64 MaxUnusedFrames = 16;
+    for (auto it = m_TextureSRBs.begin(); it != m_TextureSRBs.end();)
+    {
+        if (it->second.LastUsedFrame + MaxUnusedFrames < m_FrameIndex)
+            it = m_TextureSRBs.erase(it);
+        else
+            ++it;
+    }
+}
+
+static void CopyDrawLists(const ImDrawData* pDrawData, ImDrawVert* pVtxDst, ImDrawIdx* pIdxDst)
+{
+    for (const ImDrawList* pCmdList : pDrawData->CmdLists)
+    {
+        memcpy(pVtxDst, pCmdList->VtxBuffer.Data, pCmdList->VtxBuffer.Size * sizeof(ImDrawVert));
+        memcpy(pIdxDst, pCmdList->IdxBuffer.Data, pCmdList->IdxBuffer.Size * sizeof(ImDrawIdx));
+        pVtxDst += pCmdList->VtxBuffer.Size;
+        pIdxDst += pCmdList->IdxBuffer.Size;
+    }
+}
+
+// Number of frames between the checks whether the geometry buffers can shrink
+static constexpr Uint64 GeometryShrinkPeriod = 256;
+
+// Doubles the capacity until it is at least RequiredCapacity
+template <typename T>
+static T GrowCapacity(T Capacity, T RequiredCapacity)
+{
+    Capacity = std::max(Capacity, T{1});
+    while (Capacity < RequiredCapacity)
+        Capacity *= 2;
+    return Capacity;
+}
+
+void ImGuiGeometryRing::Reset(Uint32 Capacity)
+{
+    m_Capacity = Capacity;
+    m_Head     = 0;
+    m_Tail     = 0;
+    m_InFlight.clear();
+}
+
+bool ImGuiGeometryRing::Allocate(Uint32 NumElements, Uint32& Offset)
+{
+    if (m_Capacity == 0 || NumElements > m_Capacity)
+        return false;
+
+    Uint64       Start = m_Head;
+    const Uint64 Pos   = Start % m_Capacity;
+    // The region must be contiguous, so skip the remainder of the buffer if it does not fit
+    if (Pos + NumElements > m_Capacity)
+        Start += m_Capacity - Pos;
+
+    if (Start + NumElements - m_Tail > m_Capacity)
+        return false;
+
+    Offset = static_cast<Uint32>(Start % m_Capacity);
+    m_Head = Start + NumElements;
+    return true;
+}
+
+void ImGuiGeometryRing::FinishFrame(Uint64 FenceValue)
+{
+    m_InFlight.emplace_back(FenceValue, m_Head);
+}
+
+void ImGuiGeometryRing::Reclaim(Uint64 CompletedFenceValue)
+{
+    while (!m_InFlight.empty() && m_InFlight.front().first <= CompletedFenceValue)
+    {
+        m_Tail = m_InFlight.front().second;
+        m_InFlight.pop_front();
+    }
+}
+
+Uint32 ImGuiGeometryRing::GetGrownCapacity(Uint32 NumElements) const
+{
+    // The space of the full ring is still used by the GPU, so the new ring is at least twice as large
+    return GrowCapacity(m_Capacity * 2, NumElements);
+}
+
+void ImGuiDiligentRenderer::CreateGeometryBuffer(IDeviceContext* pCtx, GeometryBuffer& Buff)
+{
+    Buff.pBuffer.Release();
+    Buff.pMappedData = nullptr;
+    Buff.Head        = 0;
+    Buff.Ring.Reset(Buff.Capacity);
+
+    BufferDesc Desc;
+    Desc.Name           = Buff.Name;
+    Desc.BindFlags      = Buff.BindFlags;
+    Desc.Size           = Uint64{Buff.Capacity} * Buff.ElementSize;
+    Desc.Usage          = m_PersistentGeometry ? USAGE_UNIFIED : USAGE_DYNAMIC;
+    Desc.CPUAccessFlags = CPU_ACCESS_WRITE;
+    m_pDevice->CreateBuffer(Desc, nullptr, &Buff.pBuffer);
+    if (!Buff.pBuffer || !m_PersistentGeometry)
+        return;
+
+    // The CPU address of a unified buffer remains valid after the buffer is unmapped,
+    // so the buffer is only mapped once to obtain it.
+    PVoid pData = nullptr;
+    pCtx->MapBuffer(Buff.pBuffer, MAP_WRITE, MAP_FLAG_NONE, pData);
+    pCtx->UnmapBuffer(Buff.pBuffer, MAP_WRITE);
+    if (pData == nullptr)
+    {
+        Buff.pBuffer.Release();
+        return;
+    }
+
+    Buff.pMappedData = static_cast<Uint8*>(pData);
+    Buff.Coherent    = (Buff.pBuffer->GetMemoryProperties() & MEMORY_PROPERTY_HOST_COHERENT) != 0;
+}
+
+bool ImGuiDiligentRenderer::AllocateRingSpace(IDeviceContext* pCtx, GeometryBuffer& Buff, Uint32 NumElements, Uint32& Offset)
+{
+    if (Buff.pBuffer)
+    {
+        if (Buff.Ring.Allocate(NumElements, Offset))
+            return true;
+
+        // The ring is full. Switch to a larger buffer; the old one will be released
+        // once the GPU is done with it.
+        Buff.Capacity = Buff.Ring.GetGrownCapacity(NumElements);
+    }
+    else
+    {
+        Buff.Capacity = GrowCapacity(Buff.Capacity, NumElements);
+    }
+
+    CreateGeometryBuffer(pCtx, Buff);
+    if (Buff.pMappedData == nullptr)
+        return false;
+
+    const bool Allocated = Buff.Ring.Allocate(NumElements, Offset);
+    VERIFY_EXPR(Allocated && Offset == 0);
+    return Allocated;
+}
+
+void ImGuiDiligentRenderer::ShrinkGeometryBuffer(GeometryBuffer& Buff)
+{
+    // The ring also holds the geometry of the frames that are still in flight
+    const Uint64 RequiredCapacity = Uint64{Buff.PeakUsage} * (m_PersistentGeometry ? 4 : 2);
+    Buff.PeakUsage                = 0;
+
+    const Uint64 TargetCapacity = GrowCapacity(Uint64{Buff.InitialCapacity}, RequiredCapacity);
+
+    // Only shrink when the buffer is much larger than necessary so that it does not
+    // get reallocated back and forth when the usage fluctuates.
+    if (Buff.Capacity > TargetCapacity * 2)
+    {
+        Buff.Capacity = static_cast<Uint32>(TargetCapacity);
+        // The buffer will be recreated when it is used next time
+        Buff.pBuffer.Release();
+        Buff.pMappedData = nullptr;
+    }
+}
+
+void ImGuiDiligentRenderer::DisablePersistentGeometry()
+{
+    m_PersistentGeometry = false;
+    for (GeometryBuffer* pBuff : {&m_Vertices, &m_Indices})
+    {
+        pBuff->pBuffer.Release();
+        pBuff->pMappedData = nullptr;
+    }
+    m_pFence.Release();
+}
+
+bool ImGuiDiligentRenderer::UploadGeometry(IDeviceContext* pCtx, const ImDrawData* pDrawData, Uint32& FirstVertex, Uint32& FirstIndex)
+{
+    const Uint32 NumVertices = static_cast<Uint32>(pDrawData->TotalVtxCount);
+    const Uint32 NumIndices  = static_cast<Uint32>(pDrawData->TotalIdxCount);
+
+    if (m_FrameIndex % GeometryShrinkPeriod == 0)
+    {
+        ShrinkGeometryBuffer(m_Vertices);
+        ShrinkGeometryBuffer(m_Indices);
+    }
+    m_Vertices.PeakUsage = std::max(m_Vertices.PeakUsage, NumVertices);
+    m_Indices.PeakUsage  = std::max(m_Indices.PeakUsage, NumIndices);
+
+    if (m_PersistentGeometry && pCtx->GetDesc().IsDeferred)
+    {
+        LOG_WARNING_MESSAGE("Fences can't be signaled by deferred contexts. ImGui renderer falls back to dynamic geometry buffers.");
+        DisablePersistentGeometry();
+    }
+
+    if (m_PersistentGeometry)
+    {
+        // Reclaim the ring space used by the frames the GPU has finished
+        const Uint64 CompletedFenceValue = m_pFence->GetCompletedValue();
+        m_Vertices.Ring.Reclaim(CompletedFenceValue);
+        m_Indices.Ring.Reclaim(CompletedFenceValue);
+
+        if (AllocateRingSpace(pCtx, m_Vertices, NumVertices, FirstVertex) &&
+            AllocateRingSpace(pCtx, m_Indices, NumIndices, FirstIndex))
+        {
+            CopyDrawLists(pDrawData,
+                          reinterpret_cast<ImDrawVert*>(m_Vertices.pMappedData) + FirstVertex,
+                          reinterpret_cast<ImDrawIdx*>(m_Indices.pMappedData) + FirstIndex);
+
+            if (!m_Vertices.Coherent && NumVertices > 0)
+                m_Vertices.pBuffer->FlushMappedRange(Uint64{FirstVertex} * sizeof(ImDrawVert), Uint64{NumVertices} * sizeof(ImDrawVert));
+            if (!m_Indices.Coherent && NumIndices > 0)
+                m_Indices.pBuffer->FlushMappedRange(Uint64{FirstIndex} * sizeof(ImDrawIdx), Uint64{NumIndices} * sizeof(ImDrawIdx));
+
+            return true;
+        }
+
+        LOG_WARNING_MESSAGE("Failed to create unified geometry buffers. ImGui renderer falls back to dynamic geometry buffers.");
+        DisablePersistentGeometry();
+    }
+
+    // Create and grow vertex/index buffers if needed, and find where the geometry is written to
+    MAP_FLAGS VtxMapFlags = MAP_FLAG_DISCARD;
+    MAP_FLAGS IdxMapFlags = MAP_FLAG_DISCARD;
+    for (GeometryBuffer* pBuff : {&m_Vertices, &m_Indices})
+    {
+        const bool   IsVertexBuffer = pBuff == &m_Vertices;
+        const Uint32 NumElements    = IsVertexBuffer ? NumVertices : NumIndices;
+        Uint32&      FirstElement   = IsVertexBuffer ? FirstVertex : FirstIndex;
+        MAP_FLAGS&   MapFlags       = IsVertexBuffer ? VtxMapFlags : IdxMapFlags;
+
+        if (!pBuff->pBuffer || pBuff->Capacity < NumElements)
+        {
+            pBuff->Capacity = GrowCapacity(pBuff->Capacity, NumElements);
+            CreateGeometryBuffer(pCtx, *pBuff);
+        }
+
+        // Append to the geometry of the previous frames if it fits, otherwise discard the buffer
+        FirstElement = 0;
+        if (m_AppendDynamicGeometry && pBuff->Head != 0 && pBuff->Head + NumElements <= pBuff->Capacity)
+        {
+            FirstElement = static_cast<Uint32>(pBuff->Head);
+            MapFlags     = MAP_FLAG_NO_OVERWRITE;
+        }
+        pBuff->Head = Uint64{FirstElement} + NumElements;
+    }
+
+    MapHelper<ImDrawVert> Vertices{pCtx, m_Vertices.pBuffer, MAP_WRITE, VtxMapFlags};
+    MapHelper<ImDrawIdx>  Indices{pCtx, m_Indices.pBuffer, MAP_WRITE, IdxMapFlags};
+    if (!Vertices || !Indices)
+    {
+        // The buffer contents are undefined, so the next frame must discard them
+        m_Vertices.Head = 0;
+        m_Indices.Head  = 0;
+        return false;
+    }
+
+    CopyDrawLists(pDrawData, static_cast<ImDrawVert*>(Vertices) + FirstVertex, static_cast<ImDrawIdx*>(Indices) + FirstIndex);
+    return true;
+}
+
+void BatchImGuiDrawCommands(const std::vector<ImGuiDrawCommand>& Commands,
+                            std::vector<ImGuiDrawBatch>&         Batches,
+                            std::vector<MultiDrawIndexedItem>&   Items)
+{
+    Batches.clear();
+    Items.clear();
+
+    for (const ImGuiDrawCommand& Cmd : Commands)
+    {
+        if (Batches.empty() ||
+            Batches.back().pTextureView != Cmd.pTextureView ||
+            Batches.back().Scissor != Cmd.Scissor ||
+            Batches.back().VtxOffset != Cmd.VtxOffset)
+        {
+            ImGuiDrawBatch Batch;
+            Batch.pTextureView = Cmd.pTextureView;
+            Batch.Scissor      = Cmd.Scissor;
+            Batch.VtxOffset    = Cmd.VtxOffset;
+            Batch.FirstItem    = static_cast<Uint32>(Items.size());
+            Batches.push_back(Batch);
+        }
+
+        // Merge the command with the previous one in the batch if the index ranges are contiguous
+        ImGuiDrawBatch& Batch = Batches.back();
+        if (Batch.NumItems > 0 &&
+            Items.back().BaseVertex == Cmd.BaseVertex &&
+            Items.back().FirstIndexLocation + Items.back().NumIndices == Cmd.FirstIndex)
+        {
+            Items.back().NumIndices += Cmd.NumIndices;
+        }
+        else
+        {
+            Items.push_back({Cmd.NumIndices, Cmd.FirstIndex, Cmd.BaseVertex});
+            ++Batch.NumItems;
+        }
+    }
+}
+
 void ImGuiDiligentRenderer::RenderDrawData(IDeviceContext* pCtx, ImDrawData* pDrawData)
 {
     ScopedDebugGroup DebugGroup{pCtx, "ImGui"};
@@ -944,53 +1288,12 @@ void ImGuiDiligentRenderer::RenderDrawData(IDeviceContext* pCtx, ImDrawData* pDr
     if (pDrawData->DisplaySize.x <= 0.0f || pDrawData->DisplaySize.y <= 0.0f || pDrawData->CmdLists.empty())
         return;
 
-    // Create and grow vertex/index buffers if needed
-    if (!m_pVB || static_cast<int>(m_VertexBufferSize) < pDrawData->TotalVtxCount)
-    {
-        m_pVB.Release();
-        while (static_cast<int>(m_VertexBufferSize) < pDrawData->TotalVtxCount)
-            m_VertexBufferSize *= 2;
-
-        BufferDesc VBDesc;
-        VBDesc.Name           = "Imgui vertex buffer";
-        VBDesc.BindFlags      = BIND_VERTEX_BUFFER;
-        VBDesc.Size           = m_VertexBufferSize * sizeof(ImDrawVert);
-        VBDesc.Usage          = USAGE_DYNAMIC;
-        VBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
-        m_pDevice->CreateBuffer(VBDesc, nullptr, &m_pVB);
-    }
-
-    if (!m_pIB || static_cast<int>(m_IndexBufferSize) < pDrawData->TotalIdxCount)
-    {
-        m_pIB.Release();
-        while (static_cast<int>(m_IndexBufferSize) < pDrawData->TotalIdxCount)
-            m_IndexBufferSize *= 2;
-
-        BufferDesc IBDesc;
-        IBDesc.Name           = "Imgui index buffer";
-        IBDesc.BindFlags      = BIND_INDEX_BUFFER;
-        IBDesc.Size           = m_IndexBufferSize * sizeof(ImDrawIdx);
-        IBDesc.Usage          = USAGE_DYNAMIC;
-        IBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
-        m_pDevice->CreateBuffer(IBDesc, nullptr, &m_pIB);
-    }
+    ++m_FrameIndex;
 
-    {
-        MapHelper<ImDrawVert> Vertices{pCtx, m_pVB, MAP_WRITE, MAP_FLAG_DISCARD};
-        MapHelper<ImDrawIdx>  Indices{pCtx, m_pIB, MAP_WRITE, MAP_FLAG_DISCARD};
-        if (!Vertices || !Indices)
-            return;
-
-        ImDrawVert* pVtxDst = Vertices;
-        ImDrawIdx*  pIdxDst = Indices;
-        for (const ImDrawList* pCmdList : pDrawData->CmdLists)
-        {
-            memcpy(pVtxDst, pCmdList->VtxBuffer.Data, pCmdList->VtxBuffer.Size * sizeof(ImDrawVert));
-            memcpy(pIdxDst, pCmdList->IdxBuffer.Data, pCmdList->IdxBuffer.Size * sizeof(ImDrawIdx));
-            pVtxDst += pCmdList->VtxBuffer.Size;
-            pIdxDst += pCmdList->IdxBuffer.Size;
-        }
-    }
+    Uint32 FirstVertex = 0;
+    Uint32 FirstIndex  = 0;
+    if (!UploadGeometry(pCtx, pDrawData, FirstVertex, FirstIndex))
+        return;
 
     // Setup orthographic projection matrix into our constant buffer
     // Our visible imgui space lies from pDrawData->DisplayPos (top left) to pDrawData->DisplayPos+data_data->DisplaySize (bottom right).
@@ -1060,9 +1363,9 @@ void ImGuiDiligentRenderer::RenderDrawData(IDeviceContext* pCtx, ImDrawData* pDr
     auto SetupRenderState = [&]() //
     {
         // Setup shader and vertex buffers
-        IBuffer* pVBs[] = {m_pVB};
+        IBuffer* pVBs[] = {m_Vertices.pBuffer};
         pCtx->SetVertexBuffers(0, 1, pVBs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
-        pCtx->SetIndexBuffer(m_pIB, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pCtx->SetIndexBuffer(m_Indices.pBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
         pCtx->SetPipelineState(m_pPSO);
 
         const float blend_factor[4] = {0.f, 0.f, 0.f, 0.f};
@@ -1080,12 +1383,71 @@ void ImGuiDiligentRenderer::RenderDrawData(IDeviceContext* pCtx, ImDrawData* pDr
 
     SetupRenderState();
 
+    constexpr VALUE_TYPE IndexType = sizeof(ImDrawIdx) == sizeof(Uint16) ? VT_UINT16 : VT_UINT32;
+
+    // The state that is currently set in the context
+    ITextureView* pLastTextureView = nullptr;
+    Rect          LastScissor;
+    bool          ScissorSet    = false;
+    Uint64        LastVtxOffset = 0; // SetupRenderState() binds the vertex buffer at offset 0
+
+    m_DrawCommands.clear();
+    auto SubmitDrawCommands = [&]() {
+        if (m_DrawCommands.empty())
+            return;
+
+        BatchImGuiDrawCommands(m_DrawCommands, m_DrawBatches, m_DrawItems);
+        m_DrawCommands.clear();
+
+        for (const ImGuiDrawBatch& Batch : m_DrawBatches)
+        {
+            if (!ScissorSet || Batch.Scissor != LastScissor)
+            {
+                pCtx->SetScissorRects(1, &Batch.Scissor, m_RenderSurfaceWidth, m_RenderSurfaceHeight);
+                LastScissor = Batch.Scissor;
+                ScissorSet  = true;
+            }
+
+            // Bind texture
+            if (Batch.pTextureView != pLastTextureView)
+            {
+                IShaderResourceBinding* pSRB = GetTextureSRB(Batch.pTextureView);
+                if (pSRB == nullptr)
+                    continue;
+                pLastTextureView = Batch.pTextureView;
+                pCtx->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            }
+
+            if (Batch.VtxOffset != LastVtxOffset)
+            {
+                IBuffer* pVBs[] = {m_Vertices.pBuffer};
+                pCtx->SetVertexBuffers(0, 1, pVBs, &Batch.VtxOffset, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_NONE);
+                LastVtxOffset = Batch.VtxOffset;
+            }
+
+            const MultiDrawIndexedItem* pItems = &m_DrawItems[Batch.FirstItem];
+            if (Batch.NumItems > 1 && m_NativeMultiDraw)
+            {
+                pCtx->MultiDrawIndexed({Batch.NumItems, pItems, IndexType, DRAW_FLAG_VERIFY_STATES});
+            }
+            else
+            {
+                for (Uint32 i = 0; i < Batch.NumItems; ++i)
+                {
+                    DrawIndexedAttribs DrawAttrs{pItems[i].NumIndices, IndexType, DRAW_FLAG_VERIFY_STATES};
+                    DrawAttrs.FirstIndexLocation = pItems[i].FirstIndexLocation;
+                    DrawAttrs.BaseVertex         = pItems[i].BaseVertex;
+                    pCtx->DrawIndexed(DrawAttrs);
+                }
+            }
+        }
+    };
+
     // Render command lists
     // (Because we merged all buffers into a single one, we maintain our own offset into them)
-    Uint32 GlobalIdxOffset = 0;
-    Uint32 GlobalVtxOffset = 0;
+    Uint32 GlobalIdxOffset = FirstIndex;
+    Uint32 GlobalVtxOffset = FirstVertex;
 
-    ITextureView* pLastTextureView = nullptr;
     for (const ImDrawList* pCmdList : pDrawData->CmdLists)
     {
         for (const ImDrawCmd& Cmd : pCmdList->CmdBuffer)
@@ -1093,12 +1455,23 @@ void ImGuiDiligentRenderer::RenderDrawData(IDeviceContext* pCtx, ImDrawData* pDr
             const ImDrawCmd* pCmd = &Cmd;
             if (pCmd->UserCallback != nullptr)
             {
+                SubmitDrawCommands();
+
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
                 if (pCmd->UserCallback == ImDrawCallback_ResetRenderState)
+                {
                     SetupRenderState();
+                    LastVtxOffset = 0;
+                }
                 else
+                {
                     pCmd->UserCallback(pCmdList, pCmd);
+                    // The callback may have changed any state
+                    LastVtxOffset = ~Uint64{0};
+                }
+                pLastTextureView = nullptr;
+                ScissorSet       = false;
             }
             else
             {
@@ -1129,36 +1502,36 @@ void ImGuiDiligentRenderer::RenderDrawData(IDeviceContext* pCtx, ImDrawData* pDr
                 Scissor.bottom = std::min(Scissor.bottom, static_cast<Int32>(m_RenderSurfaceHeight));
                 if (!Scissor.IsValid())
                     continue;
-                pCtx->SetScissorRects(1, &Scissor, m_RenderSurfaceWidth, m_RenderSurfaceHeight);
-
-                // Bind texture
-                ITextureView* pTextureView = reinterpret_cast<ITextureView*>(pCmd->GetTexID());
-                VERIFY_EXPR(pTextureView);
-                if (pTextureView != pLastTextureView)
-                {
-                    pLastTextureView = pTextureView;
-                    m_pTextureVar->Set(pTextureView);
-                    pCtx->CommitShaderResources(m_pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-                }
 
-                DrawIndexedAttribs DrawAttrs{pCmd->ElemCount, sizeof(ImDrawIdx) == sizeof(Uint16) ? VT_UINT16 : VT_UINT32, DRAW_FLAG_VERIFY_STATES};
-                DrawAttrs.FirstIndexLocation = pCmd->IdxOffset + GlobalIdxOffset;
-                if (m_BaseVertexSupported)
+                ImGuiDrawCommand DrawCmd;
+                DrawCmd.pTextureView = reinterpret_cast<ITextureView*>(pCmd->GetTexID());
+                DrawCmd.Scissor      = Scissor;
+                DrawCmd.NumIndices   = pCmd->ElemCount;
+                DrawCmd.FirstIndex   = pCmd->IdxOffset + GlobalIdxOffset;
+                DrawCmd.BaseVertex   = pCmd->VtxOffset + GlobalVtxOffset;
+                VERIFY_EXPR(DrawCmd.pTextureView);
+                if (!m_BaseVertexSupported)
                 {
-                    DrawAttrs.BaseVertex = pCmd->VtxOffset + GlobalVtxOffset;
+                    DrawCmd.VtxOffset  = sizeof(ImDrawVert) * Uint64{DrawCmd.BaseVertex};
+                    DrawCmd.BaseVertex = 0;
                 }
-                else
-                {
-                    IBuffer* pVBs[]       = {m_pVB};
-                    Uint64   VtxOffsets[] = {sizeof(ImDrawVert) * (size_t{pCmd->VtxOffset} + size_t{GlobalVtxOffset})};
-                    pCtx->SetVertexBuffers(0, 1, pVBs, VtxOffsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_NONE);
-                }
-                pCtx->DrawIndexed(DrawAttrs);
+                m_DrawCommands.push_back(DrawCmd);
             }
         }
         GlobalIdxOffset += pCmdList->IdxBuffer.Size;
         GlobalVtxOffset += pCmdList->VtxBuffer.Size;
     }
+    SubmitDrawCommands();
+
+    if (m_PersistentGeometry)
+    {
+        // The ring space used by this frame can be reused once the GPU reaches the fence value
+        pCtx->EnqueueSignal(m_pFence, ++m_FenceValue);
+        m_Vertices.Ring.FinishFrame(m_FenceValue);
+        m_Indices.Ring.FinishFrame(m_FenceValue);
+    }
+
+    PurgeTextureSRBs();
 }
 
 } // namespace Diligent
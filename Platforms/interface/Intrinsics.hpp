@@ -26,11 +26,31 @@
 
 #pragma once
 
+// DILIGENT_X86_SIMD_SUPPORTED only means that x86 intrinsics headers are available.
+// Instruction sets enabled by the compiler options are indicated by DILIGENT_SSE2_SUPPORTED,
+// DILIGENT_SSSE3_ENABLED and DILIGENT_AVX2_ENABLED.
 #if (defined(_MSC_VER) && ((_M_IX86_FP >= 2) || defined(_M_X64))) || ((defined(__clang__) || defined(__GNUC__)) && (defined(__i386__) || defined(__x86_64__)))
 #    include <immintrin.h>
-#    define DILIGENT_AVX2_SUPPORTED 1
+#    define DILIGENT_X86_SIMD_SUPPORTED 1
 #endif
 
-#if DILIGENT_AVX2_SUPPORTED && defined(__AVX2__)
+#if DILIGENT_X86_SIMD_SUPPORTED && (defined(_MSC_VER) || defined(__SSE2__))
+#    define DILIGENT_SSE2_SUPPORTED 1
+#endif
+
+#if DILIGENT_SSE2_SUPPORTED && (defined(__SSSE3__) || defined(__AVX__))
+#    define DILIGENT_SSSE3_ENABLED 1
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || (defined(_MSC_VER) && defined(_M_ARM64))
+#    include <arm_neon.h>
+#    define DILIGENT_NEON_SUPPORTED 1
+#    if defined(__aarch64__) || defined(_M_ARM64)
+#        define DILIGENT_NEON_A64_SUPPORTED 1
+#    endif
+#endif
+
+// MSVC defines __AVX2__ when compiling with /arch:AVX2 or higher
+#if DILIGENT_X86_SIMD_SUPPORTED && defined(__AVX2__)
 #    define DILIGENT_AVX2_ENABLED 1
 #endif
@@ -0,0 +1,95 @@
+/*
+ *  Copyright 2019-2025 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Compact relocatable binary form of the render state notation.
+///
+/// All objects are stored in a single data block where every pointer is replaced with an offset
+/// from the beginning of the block. The offsets of all pointers are stored in a relocation table,
+/// so that the data can be loaded by copying the block and patching the pointers.
+/// The format depends on the layout of the notation structures and is only valid
+/// for the same pointer size and engine version.
+/// The header stores a hash of the payload, and all pointers, array counts and strings are
+/// checked against the bounds of the data block when the binary is loaded.
+
+#include "RenderStateNotationParser.h"
+#include "DataBlob.h"
+#include "RefCntAutoPtr.hpp"
+#include "DynamicLinearAllocator.hpp"
+#include "XXH128Hasher.hpp"
+
+namespace Diligent
+{
+
+/// A source that the notation was parsed from.
+struct RenderStateNotationSourceInfo
+{
+    /// File path, or null if the notation was parsed from a string.
+    const Char* Path = nullptr;
+
+    /// Hash of the source content.
+    XXH128Hash Hash;
+
+    /// Whether the file was imported by another file.
+    bool IsImport = false;
+};
+
+/// Contents of the render state notation binary.
+struct RenderStateNotationBinaryContents
+{
+    const ShaderCreateInfo*              pShaders            = nullptr;
+    const RenderPassDesc*                pRenderPasses       = nullptr;
+    const PipelineResourceSignatureDesc* pResourceSignatures = nullptr;
+    const PipelineStateNotation* const*  ppPipelineStates    = nullptr;
+    const Char* const*                   ppIgnoredSignatures = nullptr;
+    const RenderStateNotationSourceInfo* pSources            = nullptr;
+
+    Uint32 ShaderCount            = 0;
+    Uint32 RenderPassCount        = 0;
+    Uint32 ResourceSignatureCount = 0;
+    Uint32 PipelineStateCount     = 0;
+    Uint32 IgnoredSignatureCount  = 0;
+    Uint32 SourceCount            = 0;
+};
+
+/// Writes the render state notation to a binary blob.
+RefCntAutoPtr<IDataBlob> WriteRenderStateNotationBinary(const RenderStateNotationBinaryContents& Contents) noexcept(false);
+
+/// Loads the render state notation binary.
+
+/// \param [in] pData     - Binary data produced by WriteRenderStateNotationBinary().
+/// \param [in] DataSize  - Binary data size.
+/// \param [in] Allocator - Allocator that is used to allocate the memory for the objects.
+///                         The objects remain valid for the lifetime of the allocator.
+/// \return     A pointer to the binary contents, or null if the data is not a valid binary.
+const RenderStateNotationBinaryContents* ReadRenderStateNotationBinary(const void*             pData,
+                                                                       size_t                  DataSize,
+                                                                       DynamicLinearAllocator& Allocator);
+
+} // namespace Diligent
@@ -34,6 +34,7 @@
 #include "ObjectBase.hpp"
 #include "DynamicLinearAllocator.hpp"
 #include "HashUtils.hpp"
+#include "XXH128Hasher.hpp"
 
 namespace Diligent
 {
@@ -59,6 +60,13 @@ public:
                                                 IShaderSourceInputStreamFactory* pStreamFactory,
                                                 IShaderSourceInputStreamFactory* pReloadFactory) override final;
 
+    virtual Bool DILIGENT_CALL_TYPE CompileBinary(IDataBlob** ppBinary) const override final;
+
+    virtual Bool DILIGENT_CALL_TYPE ParseBinary(const void*                      pData,
+                                                size_t                           DataSize,
+                                                IShaderSourceInputStreamFactory* pStreamFactory,
+                                                IShaderSourceInputStreamFactory* pReloadFactory) override final;
+
     virtual const PipelineStateNotation* DILIGENT_CALL_TYPE GetPipelineStateByName(const Char* Name, PIPELINE_TYPE PipelineType) const override final;
 
     virtual const PipelineResourceSignatureDesc* DILIGENT_CALL_TYPE GetResourceSignatureByName(const Char* Name) const override final;
@@ -85,7 +93,8 @@ public:
 
 private:
     Bool ParseFileInternal(const Char*                      FilePath,
-                           IShaderSourceInputStreamFactory* pStreamFactory);
+                           IShaderSourceInputStreamFactory* pStreamFactory,
+                           bool                             IsImport);
 
     Bool ParseStringInternal(const Char*                      Source,
                              Uint32                           Length,
@@ -132,6 +141,15 @@ private:
         RefCntAutoPtr<IShaderSourceInputStreamFactory> pFactory;
     };
     std::vector<ReloadInfo> m_ReloadInfo;
+
+    // Sources the states were parsed from, used to validate the compiled binary
+    struct SourceInfo
+    {
+        std::string Path;
+        XXH128Hash  Hash;
+        bool        IsImport = false;
+    };
+    std::vector<SourceInfo> m_Sources;
 };
 
 } // namespace Diligent
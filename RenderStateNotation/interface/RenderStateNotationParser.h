@@ -30,6 +30,7 @@
 
 /// \file
 /// Defines Diligent::IRenderStateNotationParser interface
+#include "../../../DiligentCore/Primitives/interface/DataBlob.h"
 #include "../../../DiligentCore/Graphics/GraphicsEngine/interface/RenderDevice.h"
 
 DILIGENT_BEGIN_NAMESPACE(Diligent)
@@ -437,6 +438,50 @@ DILIGENT_BEGIN_INTERFACE(IRenderStateNotationParser, IObject)
                                      IShaderSourceInputStreamFactory* pStreamFactory,
                                      IShaderSourceInputStreamFactory* pReloadFactory DEFAULT_VALUE(nullptr)) PURE;
 
+    /// Compiles the parsed states into a compact binary form.
+
+    /// \param [out] ppBinary - Address of the memory location where a pointer to the
+    ///                         data blob with the binary will be written.
+    ///
+    /// \return
+    /// - True if the binary was created successfully.
+    /// - False otherwise.
+    ///
+    /// \remarks The binary can be loaded with ParseBinary() by the parser built for the
+    ///          same platform and engine version.
+    ///          The binary contains the hashes of all source files, which allows
+    ///          ParseBinary() to detect if it is out of date.
+    ///
+    /// \remarks This method must be externally synchronized.
+    VIRTUAL Bool METHOD(CompileBinary)(THIS_
+                                       IDataBlob** ppBinary) CONST PURE;
+
+    /// Loads the states from the binary created by CompileBinary().
+
+    /// \param [in] pData          - A pointer to the binary data.
+    /// \param [in] DataSize       - Binary data size.
+    /// \param [in] pStreamFactory - An optional factory that is used to validate the binary.
+    ///                              If not null, the source files are loaded and their content
+    ///                              hashes are compared with the hashes stored in the binary.
+    /// \param [in] pReloadFactory - An optional factory to use for state reloading.
+    ///                              If null, pStreamFactory will be used when Reload() method is called.
+    ///
+    /// \return
+    /// - True if the binary was loaded successfully.
+    /// - False if the binary is invalid or out of date. In this case the source
+    ///   files should be parsed with ParseFile().
+    ///
+    /// \remarks The parser must be empty when this method is called.
+    ///          All objects returned by the parser are identical to the objects
+    ///          of the parser that compiled the binary.
+    ///
+    /// \remarks This method must be externally synchronized.
+    VIRTUAL Bool METHOD(ParseBinary)(THIS_
+                                     const void*                      pData,
+                                     size_t                           DataSize,
+                                     IShaderSourceInputStreamFactory* pStreamFactory,
+                                     IShaderSourceInputStreamFactory* pReloadFactory DEFAULT_VALUE(nullptr)) PURE;
+
     /// Returns the pipeline state notation by its name. If the resource is not found, returns nullptr.
 
     /// \param [in] Name         - Name of the PSO.
@@ -555,6 +600,8 @@ DILIGENT_END_INTERFACE
 // clang-format off
 #    define IRenderStateNotationParser_ParseFile(This, ...)                   CALL_IFACE_METHOD(RenderStateNotationParser, ParseFile,                   This, __VA_ARGS__)
 #    define IRenderStateNotationParser_ParseString(This, ...)                 CALL_IFACE_METHOD(RenderStateNotationParser, ParseString,                 This, __VA_ARGS__)
+#    define IRenderStateNotationParser_CompileBinary(This, ...)               CALL_IFACE_METHOD(RenderStateNotationParser, CompileBinary,               This, __VA_ARGS__)
+#    define IRenderStateNotationParser_ParseBinary(This, ...)                 CALL_IFACE_METHOD(RenderStateNotationParser, ParseBinary,                 This, __VA_ARGS__)
 #    define IRenderStateNotationParser_GetPipelineStateByName(This, ...)      CALL_IFACE_METHOD(RenderStateNotationParser, GetPipelineStateByName,      This, __VA_ARGS__)
 #    define IRenderStateNotationParser_GetResourceSignatureByName(This, ...)  CALL_IFACE_METHOD(RenderStateNotationParser, GetResourceSignatureByName,  This, __VA_ARGS__)
 #    define IRenderStateNotationParser_GetShaderByName(This, ...)             CALL_IFACE_METHOD(RenderStateNotationParser, GetShaderByName,             This, __VA_ARGS__)
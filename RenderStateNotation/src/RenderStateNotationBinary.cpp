@@ -0,0 +1,719 @@
+/*
+ *  Copyright 2019-2025 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "RenderStateNotationBinary.hpp"
+
+#include <vector>
+#include <unordered_map>
+#include <cstring>
+
+#include "DataBlobImpl.hpp"
+#include "Cast.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+constexpr Uint32 BinaryMagic   = 0x4E535244; // "DRSN"
+constexpr Uint32 BinaryVersion = 2;
+
+struct BinaryHeader
+{
+    Uint32 Magic   = BinaryMagic;
+    Uint32 Version = BinaryVersion;
+
+    // Hash of the layout of all structures stored in the binary
+    Uint64 LayoutHash = 0;
+
+    Uint32 RelocationCount = 0;
+    Uint32 DataSize        = 0;
+
+    // Hash of the relocation table and the data block
+    XXH128Hash PayloadHash;
+};
+static_assert(sizeof(BinaryHeader) == 40, "Binary header must not have implicit padding");
+
+XXH128Hash ComputePayloadHash(const void* pPayload, size_t Size)
+{
+    XXH128State Hasher;
+    Hasher.UpdateRaw(pPayload, Size);
+    return Hasher.Digest();
+}
+
+Uint64 ComputeLayoutHash()
+{
+    XXH128State Hasher;
+    Hasher.Update(BinaryVersion,
+                  sizeof(void*),
+                  sizeof(RenderStateNotationBinaryContents),
+                  sizeof(RenderStateNotationSourceInfo),
+                  sizeof(ShaderCreateInfo),
+                  sizeof(ShaderMacro),
+                  sizeof(RenderPassDesc),
+                  sizeof(RenderPassAttachmentDesc),
+                  sizeof(SubpassDesc),
+                  sizeof(AttachmentReference),
+                  sizeof(ShadingRateAttachment),
+                  sizeof(SubpassDependencyDesc),
+                  sizeof(PipelineResourceSignatureDesc),
+                  sizeof(PipelineResourceDesc),
+                  sizeof(ImmutableSamplerDesc),
+                  sizeof(ShaderResourceVariableDesc),
+                  sizeof(LayoutElement),
+                  sizeof(GraphicsPipelineNotation),
+                  sizeof(ComputePipelineNotation),
+                  sizeof(TilePipelineNotation),
+                  sizeof(RayTracingPipelineNotation),
+                  sizeof(RTGeneralShaderGroupNotation),
+                  sizeof(RTTriangleHitShaderGroupNotation),
+                  sizeof(RTProceduralHitShaderGroupNotation));
+    return Hasher.Digest().LowPart;
+}
+
+// Copies the objects into a single data block and replaces all pointers with offsets
+class BinaryWriter
+{
+public:
+    explicit BinaryWriter(const RenderStateNotationBinaryContents& Contents);
+
+    void String(const Char* const& Str, size_t Length = 0);
+    void Bytes(const void* const& pData, size_t Size);
+
+    // Pointers to the objects that are not part of the notation, e.g. IRenderPass
+    template <typename T>
+    void Null(T* const& pField)
+    {
+        VERIFY(pField == nullptr, "Only null pointers to external objects can be stored in the binary");
+        SetNull(&pField);
+    }
+
+    template <typename T, typename CountType>
+    void Array(T* const& pArray, CountType Count)
+    {
+        Objects(&pArray, pArray, static_cast<size_t>(Count));
+    }
+
+    template <typename T>
+    void Objects(const void* pField, const T* pObjects, size_t Count);
+
+    // The source objects are always valid
+    template <typename T>
+    bool CheckObject(const T* pObject) const
+    {
+        VERIFY_EXPR(pObject != nullptr);
+        return true;
+    }
+
+    void InvalidPipelineType(const PipelineStateNotation& Notation)
+    {
+        LOG_ERROR_AND_THROW("Unexpected pipeline type of pipeline '", Notation.PSODesc.Name, "'.");
+    }
+
+    RefCntAutoPtr<IDataBlob> GetBlob() const;
+
+private:
+    size_t Append(const void* pData, size_t Size, size_t Alignment);
+    size_t GetFieldOffset(const void* pField) const;
+    void   SetPointer(const void* pField, size_t Offset);
+    void   SetNull(const void* pField);
+
+    // The object that is currently processed
+    struct ObjectScope
+    {
+        ObjectScope(BinaryWriter& Writer, const void* pSrcObject, size_t Size, size_t DstOffset) :
+            m_Writer{Writer},
+            m_pPrevSrcObject{Writer.m_pSrcObject},
+            m_PrevSrcObjectSize{Writer.m_SrcObjectSize},
+            m_PrevDstOffset{Writer.m_DstObjectOffset}
+        {
+            Writer.m_pSrcObject      = static_cast<const Uint8*>(pSrcObject);
+            Writer.m_SrcObjectSize   = Size;
+            Writer.m_DstObjectOffset = DstOffset;
+        }
+
+        ~ObjectScope()
+        {
+            m_Writer.m_pSrcObject      = m_pPrevSrcObject;
+            m_Writer.m_SrcObjectSize   = m_PrevSrcObjectSize;
+            m_Writer.m_DstObjectOffset = m_PrevDstOffset;
+        }
+
+    private:
+        BinaryWriter& m_Writer;
+        const Uint8*  m_pPrevSrcObject;
+        const size_t  m_PrevSrcObjectSize;
+        const size_t  m_PrevDstOffset;
+    };
+
+private:
+    std::vector<Uint8>  m_Data;
+    std::vector<Uint32> m_Relocations;
+
+    // Identical strings are stored once
+    std::unordered_map<std::string, size_t> m_Strings;
+
+    const Uint8* m_pSrcObject      = nullptr;
+    size_t       m_SrcObjectSize   = 0;
+    size_t       m_DstObjectOffset = 0;
+};
+
+// Every structure that is stored in the binary must either have a ProcessPointers()
+// overload that handles all its pointers, or be declared as plain data below.
+// The same overloads are used to write the binary and to validate the loaded objects.
+template <typename T, typename ProcessorType>
+void ProcessPointers(const T& Object, ProcessorType& Processor) = delete;
+
+#define DECLARE_PLAIN_BINARY_DATA(Type) \
+    template <typename ProcessorType>   \
+    void ProcessPointers(const Type&, ProcessorType&) {}
+
+DECLARE_PLAIN_BINARY_DATA(Uint32)
+DECLARE_PLAIN_BINARY_DATA(RenderPassAttachmentDesc)
+DECLARE_PLAIN_BINARY_DATA(AttachmentReference)
+DECLARE_PLAIN_BINARY_DATA(ShadingRateAttachment)
+DECLARE_PLAIN_BINARY_DATA(SubpassDependencyDesc)
+
+#undef DECLARE_PLAIN_BINARY_DATA
+
+template <typename ProcessorType>
+void ProcessPointers(const Char* const& Str, ProcessorType& Processor)
+{
+    Processor.String(Str);
+}
+
+template <typename ProcessorType>
+void ProcessPointers(const ShaderMacro& Macro, ProcessorType& Processor)
+{
+    Processor.String(Macro.Name);
+    Processor.String(Macro.Definition);
+}
+
+template <typename ProcessorType>
+void ProcessPointers(const ShaderCreateInfo& CI, ProcessorType& Processor)
+{
+    Processor.String(CI.FilePath);
+    Processor.Null(CI.pShaderSourceStreamFactory);
+    Processor.String(CI.Source, CI.Source != nullptr ? CI.SourceLength : 0);
+    Processor.Bytes(CI.ByteCode, CI.ByteCode != nullptr ? CI.ByteCodeSize : 0);
+    Processor.String(CI.EntryPoint);
+    Processor.Array(CI.Macros.Elements, CI.Macros.Count);
+    Processor.String(CI.Desc.Name);
+    Processor.String(CI.Desc.CombinedSamplerSuffix);
+    Processor.String(CI.GLSLExtensions);
+    Processor.String(CI.WebGPUEmulatedArrayIndexSuffix);
+
+    ASSERT_SIZEOF64(ShaderCreateInfo, 152, "Did you add a new member to ShaderCreateInfo? Please handle its pointers here.");
+}
+
+template <typename ProcessorType>
+void ProcessPointers(const SubpassDesc& Subpass, ProcessorType& Processor)
+{
+    Processor.Array(Subpass.pInputAttachments, Subpass.InputAttachmentCount);
+    Processor.Array(Subpass.pRenderTargetAttachments, Subpass.RenderTargetAttachmentCount);
+    Processor.Array(Subpass.pResolveAttachments, Subpass.pResolveAttachments != nullptr ? Subpass.RenderTargetAttachmentCount : 0);
+    Processor.Array(Subpass.pDepthStencilAttachment, 1);
+    Processor.Array(Subpass.pPreserveAttachments, Subpass.PreserveAttachmentCount);
+    Processor.Array(Subpass.pShadingRateAttachment, 1);
+
+    ASSERT_SIZEOF64(SubpassDesc, 72, "Did you add a new member to SubpassDesc? Please handle its pointers here.");
+}
+
+template <typename ProcessorType>
+void ProcessPointers(const RenderPassDesc& Desc, ProcessorType& Processor)
+{
+    Processor.String(Desc.Name);
+    Processor.Array(Desc.pAttachments, Desc.AttachmentCount);
+    Processor.Array(Desc.pSubpasses, Desc.SubpassCount);
+    Processor.Array(Desc.pDependencies, Desc.DependencyCount);
+
+    ASSERT_SIZEOF64(RenderPassDesc, 56, "Did you add a new member to RenderPassDesc? Please handle its pointers here.");
+}
+
+template <typename ProcessorType>
+void ProcessPointers(const ImmutableSamplerDesc& Desc, ProcessorType& Processor)
+{
+    Processor.String(Desc.SamplerOrTextureName);
+    Processor.String(Desc.Desc.Name);
+
+    ASSERT_SIZEOF64(ImmutableSamplerDesc, 72, "Did you add a new member to ImmutableSamplerDesc? Please handle its pointers here.");
+}
+
+template <typename ProcessorType>
+void ProcessPointers(const PipelineResourceDesc& Desc, ProcessorType& Processor)
+{
+    Processor.String(Desc.Name);
+
+    ASSERT_SIZEOF64(PipelineResourceDesc, 24, "Did you add a new member to PipelineResourceDesc? Please handle its pointers here.");
+}
+
+template <typename ProcessorType>
+void ProcessPointers(const PipelineResourceSignatureDesc& Desc, ProcessorType& Processor)
+{
+    Processor.String(Desc.Name);
+    Processor.Array(Desc.Resources, Desc.NumResources);
+    Processor.Array(Desc.ImmutableSamplers, Desc.NumImmutableSamplers);
+    Processor.String(Desc.CombinedSamplerSuffix);
+
+    ASSERT_SIZEOF64(PipelineResourceSignatureDesc, 56, "Did you add a new member to PipelineResourceSignatureDesc? Please handle its pointers here.");
+}
+
+template <typename ProcessorType>
+void ProcessPointers(const ShaderResourceVariableDesc& Desc, ProcessorType& Processor)
+{
+    Processor.String(Desc.Name);
+
+    ASSERT_SIZEOF64(ShaderResourceVariableDesc, 16, "Did you add a new member to ShaderResourceVariableDesc? Please handle its pointers here.");
+}
+
+template <typename ProcessorType>
+void ProcessPointers(const LayoutElement& Elem, ProcessorType& Processor)
+{
+    Processor.String(Elem.HLSLSemantic);
+
+    ASSERT_SIZEOF64(LayoutElement, 40, "Did you add a new member to LayoutElement? Please handle its pointers here.");
+}
+
+template <typename ProcessorType>
+void ProcessPointers(const PipelineStateNotation& Notation, ProcessorType& Processor)
+{
+    const PipelineStateDesc& PSODesc = Notation.PSODesc;
+    Processor.String(PSODesc.Name);
+    Processor.Array(PSODesc.ResourceLayout.Variables, PSODesc.ResourceLayout.NumVariables);
+    Processor.Array(PSODesc.ResourceLayout.ImmutableSamplers, PSODesc.ResourceLayout.NumImmutableSamplers);
+    Processor.Array(Notation.ppResourceSignatureNames, Notation.ResourceSignaturesNameCount);
+
+    ASSERT_SIZEOF64(PipelineStateDesc, 64, "Did you add a new member to PipelineStateDesc? Please handle its pointers here.");
+    ASSERT_SIZEOF64(PipelineStateNotation, 88, "Did you add a new member to PipelineStateNotation? Please handle its pointers here.");
+}
+
+template <typename ProcessorType>
+void ProcessPointers(const GraphicsPipelineNotation& Notation, ProcessorType& Processor)
+{
+    ProcessPointers(static_cast<const PipelineStateNotation&>(Notation), Processor);
+
+    Processor.Array(Notation.Desc.InputLayout.LayoutElements, Notation.Desc.InputLayout.NumElements);
+    Processor.Null(Notation.Desc.pRenderPass);
+    Processor.String(Notation.pRenderPassName);
+    Processor.String(Notation.pVSName);
+    Processor.String(Notation.pPSName);
+    Processor.String(Notation.pDSName);
+    Processor.String(Notation.pHSName);
+    Processor.String(Notation.pGSName);
+    Processor.String(Notation.pASName);
+    Processor.String(Notation.pMSName);
+
+    ASSERT_SIZEOF64(GraphicsPipelineDesc, 192, "Did you add a new member to GraphicsPipelineDesc? Please handle its pointers here.");
+    ASSERT_SIZEOF64(GraphicsPipelineNotation, 344, "Did you add a new member to GraphicsPipelineNotation? Please handle its pointers here.");
+}
+
+template <typename ProcessorType>
+void ProcessPointers(const ComputePipelineNotation& Notation, ProcessorType& Processor)
+{
+    ProcessPointers(static_cast<const PipelineStateNotation&>(Notation), Processor);
+    Processor.String(Notation.pCSName);
+
+    ASSERT_SIZEOF64(ComputePipelineNotation, 96, "Did you add a new member to ComputePipelineNotation? Please handle its pointers here.");
+}
+
+template <typename ProcessorType>
+void ProcessPointers(const TilePipelineNotation& Notation, ProcessorType& Processor)
+{
+    ProcessPointers(static_cast<const PipelineStateNotation&>(Notation), Processor);
+    Processor.String(Notation.pTSName);
+
+    ASSERT_SIZEOF64(TilePipelineNotation, 96, "Did you add a new member to TilePipelineNotation? Please handle its pointers here.");
+}
+
+template <typename ProcessorType>
+void ProcessPointers(const RTGeneralShaderGroupNotation& Group, ProcessorType& Processor)
+{
+    Processor.String(Group.Name);
+    Processor.String(Group.pShaderName);
+
+    ASSERT_SIZEOF64(RTGeneralShaderGroupNotation, 16, "Did you add a new member to RTGeneralShaderGroupNotation? Please handle its pointers here.");
+}
+
+template <typename ProcessorType>
+void ProcessPointers(const RTTriangleHitShaderGroupNotation& Group, ProcessorType& Processor)
+{
+    Processor.String(Group.Name);
+    Processor.String(Group.pClosestHitShaderName);
+    Processor.String(Group.pAnyHitShaderName);
+
+    ASSERT_SIZEOF64(RTTriangleHitShaderGroupNotation, 24, "Did you add a new member to RTTriangleHitShaderGroupNotation? Please handle its pointers here.");
+}
+
+template <typename ProcessorType>
+void ProcessPointers(const RTProceduralHitShaderGroupNotation& Group, ProcessorType& Processor)
+{
+    Processor.String(Group.Name);
+    Processor.String(Group.pIntersectionShaderName);
+    Processor.String(Group.pClosestHitShaderName);
+    Processor.String(Group.pAnyHitShaderName);
+
+    ASSERT_SIZEOF64(RTProceduralHitShaderGroupNotation, 32, "Did you add a new member to RTProceduralHitShaderGroupNotation? Please handle its pointers here.");
+}
+
+template <typename ProcessorType>
+void ProcessPointers(const RayTracingPipelineNotation& Notation, ProcessorType& Processor)
+{
+    ProcessPointers(static_cast<const PipelineStateNotation&>(Notation), Processor);
+    Processor.Array(Notation.pGeneralShaders, Notation.GeneralShaderCount);
+    Processor.Array(Notation.pTriangleHitShaders, Notation.TriangleHitShaderCount);
+    Processor.Array(Notation.pProceduralHitShaders, Notation.ProceduralHitShaderCount);
+    Processor.String(Notation.pShaderRecordName);
+
+    ASSERT_SIZEOF64(RayTracingPipelineNotation, 160, "Did you add a new member to RayTracingPipelineNotation? Please handle its pointers here.");
+}
+
+template <typename ProcessorType>
+void ProcessPointers(const PipelineStateNotation* const& pNotation, ProcessorType& Processor)
+{
+    // The pipeline type must be accessible before the object of the derived type is processed
+    if (!Processor.CheckObject(pNotation))
+        return;
+
+    static_assert(PIPELINE_TYPE_LAST == 4, "Please handle the new pipeline type below.");
+    switch (pNotation->PSODesc.PipelineType)
+    {
+        case PIPELINE_TYPE_GRAPHICS:
+        case PIPELINE_TYPE_MESH:
+            Processor.Objects(&pNotation, static_cast<const GraphicsPipelineNotation*>(pNotation), 1);
+            break;
+
+        case PIPELINE_TYPE_COMPUTE:
+            Processor.Objects(&pNotation, static_cast<const ComputePipelineNotation*>(pNotation), 1);
+            break;
+
+        case PIPELINE_TYPE_TILE:
+            Processor.Objects(&pNotation, static_cast<const TilePipelineNotation*>(pNotation), 1);
+            break;
+
+        case PIPELINE_TYPE_RAY_TRACING:
+            Processor.Objects(&pNotation, static_cast<const RayTracingPipelineNotation*>(pNotation), 1);
+            break;
+
+        default:
+            Processor.InvalidPipelineType(*pNotation);
+    }
+}
+
+template <typename ProcessorType>
+void ProcessPointers(const RenderStateNotationSourceInfo& Source, ProcessorType& Processor)
+{
+    Processor.String(Source.Path);
+}
+
+template <typename ProcessorType>
+void ProcessPointers(const RenderStateNotationBinaryContents& Contents, ProcessorType& Processor)
+{
+    Processor.Array(Contents.pShaders, Contents.ShaderCount);
+    Processor.Array(Contents.pRenderPasses, Contents.RenderPassCount);
+    Processor.Array(Contents.pResourceSignatures, Contents.ResourceSignatureCount);
+    Processor.Array(Contents.ppPipelineStates, Contents.PipelineStateCount);
+    Processor.Array(Contents.ppIgnoredSignatures, Contents.IgnoredSignatureCount);
+    Processor.Array(Contents.pSources, Contents.SourceCount);
+}
+
+BinaryWriter::BinaryWriter(const RenderStateNotationBinaryContents& Contents)
+{
+    // The contents structure is always at the beginning of the data
+    const size_t Offset = Append(&Contents, sizeof(Contents), alignof(RenderStateNotationBinaryContents));
+    VERIFY_EXPR(Offset == 0);
+
+    ObjectScope Scope{*this, &Contents, sizeof(Contents), Offset};
+    ProcessPointers(Contents, *this);
+}
+
+template <typename T>
+void BinaryWriter::Objects(const void* pField, const T* pObjects, size_t Count)
+{
+    if (pObjects == nullptr || Count == 0)
+    {
+        SetNull(pField);
+        return;
+    }
+
+    const size_t Offset = Append(pObjects, sizeof(T) * Count, alignof(T));
+    SetPointer(pField, Offset);
+
+    for (size_t i = 0; i < Count; ++i)
+    {
+        ObjectScope Scope{*this, &pObjects[i], sizeof(T), Offset + sizeof(T) * i};
+        ProcessPointers(pObjects[i], *this);
+    }
+}
+
+void BinaryWriter::String(const Char* const& Str, size_t Length)
+{
+    if (Str == nullptr)
+    {
+        SetNull(&Str);
+        return;
+    }
+
+    std::string Key{Str, Length != 0 ? Length : strlen(Str)};
+
+    auto it = m_Strings.find(Key);
+    if (it == m_Strings.end())
+    {
+        // Always store the terminating null character
+        const size_t Offset = Append(Key.c_str(), Key.length() + 1, 1);
+        it                  = m_Strings.emplace(std::move(Key), Offset).first;
+    }
+    SetPointer(&Str, it->second);
+}
+
+void BinaryWriter::Bytes(const void* const& pData, size_t Size)
+{
+    if (pData == nullptr || Size == 0)
+    {
+        SetNull(&pData);
+        return;
+    }
+
+    SetPointer(&pData, Append(pData, Size, sizeof(Uint32)));
+}
+
+size_t BinaryWriter::Append(const void* pData, size_t Size, size_t Alignment)
+{
+    const size_t Offset = AlignUp(m_Data.size(), Alignment);
+    m_Data.resize(Offset + Size);
+    memcpy(&m_Data[Offset], pData, Size);
+    return Offset;
+}
+
+size_t BinaryWriter::GetFieldOffset(const void* pField) const
+{
+    const Uint8* pFieldBytes = static_cast<const Uint8*>(pField);
+    VERIFY(pFieldBytes >= m_pSrcObject && pFieldBytes + sizeof(void*) <= m_pSrcObject + m_SrcObjectSize,
+           "The field must be a member of the object that is being processed");
+    return m_DstObjectOffset + (pFieldBytes - m_pSrcObject);
+}
+
+void BinaryWriter::SetPointer(const void* pField, size_t Offset)
+{
+    const size_t FieldOffset = GetFieldOffset(pField);
+
+    const uintptr_t Value = Offset;
+    memcpy(&m_Data[FieldOffset], &Value, sizeof(Value));
+    m_Relocations.push_back(StaticCast<Uint32>(FieldOffset));
+}
+
+void BinaryWriter::SetNull(const void* pField)
+{
+    const uintptr_t Value = 0;
+    memcpy(&m_Data[GetFieldOffset(pField)], &Value, sizeof(Value));
+}
+
+RefCntAutoPtr<IDataBlob> BinaryWriter::GetBlob() const
+{
+    BinaryHeader Header;
+    Header.LayoutHash      = ComputeLayoutHash();
+    Header.RelocationCount = StaticCast<Uint32>(m_Relocations.size());
+    Header.DataSize        = StaticCast<Uint32>(m_Data.size());
+
+    const size_t RelocationsSize = m_Relocations.size() * sizeof(Uint32);
+
+    RefCntAutoPtr<DataBlobImpl> pBlob = DataBlobImpl::Create(sizeof(Header) + RelocationsSize + m_Data.size());
+
+    Uint8* pDst = pBlob->GetDataPtr<Uint8>();
+    memcpy(pDst + sizeof(Header), m_Relocations.data(), RelocationsSize);
+    memcpy(pDst + sizeof(Header) + RelocationsSize, m_Data.data(), m_Data.size());
+
+    Header.PayloadHash = ComputePayloadHash(pDst + sizeof(Header), RelocationsSize + m_Data.size());
+    memcpy(pDst, &Header, sizeof(Header));
+
+    return RefCntAutoPtr<IDataBlob>{pBlob};
+}
+
+// Verifies that all pointers of the loaded objects, including the arrays with their element
+// counts and the strings with their terminating null characters, lie within the data block
+class BinaryValidator
+{
+public:
+    BinaryValidator(const void* pData, size_t Size) :
+        m_Begin{reinterpret_cast<uintptr_t>(pData)},
+        m_End{m_Begin + Size}
+    {}
+
+    void String(const Char* const& Str, size_t Length = 0)
+    {
+        if (Str == nullptr || !m_IsValid)
+            return;
+
+        if (!IsInRange(Str, 1, 1, 1))
+        {
+            m_IsValid = false;
+            return;
+        }
+
+        const size_t MaxLength = m_End - reinterpret_cast<uintptr_t>(Str);
+        if (Length != 0)
+            m_IsValid = Length < MaxLength && Str[Length] == '\0';
+        else
+            m_IsValid = memchr(Str, '\0', MaxLength) != nullptr;
+    }
+
+    void Bytes(const void* const& pData, size_t Size)
+    {
+        if (pData != nullptr && m_IsValid)
+            m_IsValid = IsInRange(pData, Size, 1, 1);
+    }
+
+    template <typename T>
+    void Null(T* const& pField)
+    {
+        if (pField != nullptr)
+            m_IsValid = false;
+    }
+
+    template <typename T, typename CountType>
+    void Array(T* const& pArray, CountType Count)
+    {
+        Objects(&pArray, pArray, static_cast<size_t>(Count));
+    }
+
+    template <typename T>
+    void Objects(const void*, const T* pObjects, size_t Count)
+    {
+        if (pObjects == nullptr || !m_IsValid)
+            return;
+
+        if (!IsInRange(pObjects, Count, sizeof(T), alignof(T)))
+        {
+            m_IsValid = false;
+            return;
+        }
+
+        for (size_t i = 0; i < Count && m_IsValid; ++i)
+            ProcessPointers(pObjects[i], *this);
+    }
+
+    template <typename T>
+    bool CheckObject(const T* pObject)
+    {
+        if (m_IsValid)
+            m_IsValid = pObject != nullptr && IsInRange(pObject, 1, sizeof(T), alignof(T));
+        return m_IsValid;
+    }
+
+    void InvalidPipelineType(const PipelineStateNotation&)
+    {
+        m_IsValid = false;
+    }
+
+    bool IsValid() const { return m_IsValid; }
+
+private:
+    bool IsInRange(const void* pData, size_t Count, size_t ElementSize, size_t Alignment) const
+    {
+        const uintptr_t Address = reinterpret_cast<uintptr_t>(pData);
+        if (Address < m_Begin || Address > m_End || (Address - m_Begin) % Alignment != 0)
+            return false;
+        return Count <= (m_End - Address) / ElementSize;
+    }
+
+private:
+    const uintptr_t m_Begin;
+    const uintptr_t m_End;
+
+    bool m_IsValid = true;
+};
+
+} // namespace
+
+RefCntAutoPtr<IDataBlob> WriteRenderStateNotationBinary(const RenderStateNotationBinaryContents& Contents) noexcept(false)
+{
+    BinaryWriter Writer{Contents};
+    return Writer.GetBlob();
+}
+
+const RenderStateNotationBinaryContents* ReadRenderStateNotationBinary(const void*             pData,
+                                                                       size_t                  DataSize,
+                                                                       DynamicLinearAllocator& Allocator)
+{
+    if (pData == nullptr || DataSize < sizeof(BinaryHeader))
+        return nullptr;
+
+    const Uint8* pSrc = static_cast<const Uint8*>(pData);
+
+    BinaryHeader Header;
+    memcpy(&Header, pSrc, sizeof(Header));
+    if (Header.Magic != BinaryMagic || Header.Version != BinaryVersion || Header.LayoutHash != ComputeLayoutHash())
+        return nullptr;
+
+    const size_t RelocationsOffset = sizeof(Header);
+    if (Header.RelocationCount > (DataSize - RelocationsOffset) / sizeof(Uint32))
+        return nullptr;
+
+    const size_t DataOffset = RelocationsOffset + size_t{Header.RelocationCount} * sizeof(Uint32);
+    if (DataSize - DataOffset != Header.DataSize || Header.DataSize < sizeof(RenderStateNotationBinaryContents))
+        return nullptr;
+
+    if (!(ComputePayloadHash(pSrc + RelocationsOffset, DataSize - RelocationsOffset) == Header.PayloadHash))
+        return nullptr;
+
+    // Validate all relocations before allocating any memory
+    for (Uint32 i = 0; i < Header.RelocationCount; ++i)
+    {
+        Uint32 FieldOffset = 0;
+        memcpy(&FieldOffset, pSrc + RelocationsOffset + sizeof(Uint32) * i, sizeof(FieldOffset));
+        if (FieldOffset % alignof(uintptr_t) != 0 || size_t{FieldOffset} + sizeof(uintptr_t) > Header.DataSize)
+            return nullptr;
+
+        uintptr_t Value = 0;
+        memcpy(&Value, pSrc + DataOffset + FieldOffset, sizeof(Value));
+        if (Value >= Header.DataSize)
+            return nullptr;
+    }
+
+    Uint8* pObjects = static_cast<Uint8*>(Allocator.Allocate(Header.DataSize, alignof(std::max_align_t)));
+    memcpy(pObjects, pSrc + DataOffset, Header.DataSize);
+
+    // Pointer fix-ups are the only processing that is required to load the binary
+    for (Uint32 i = 0; i < Header.RelocationCount; ++i)
+    {
+        Uint32 FieldOffset = 0;
+        memcpy(&FieldOffset, pSrc + RelocationsOffset + sizeof(Uint32) * i, sizeof(FieldOffset));
+
+        uintptr_t& Pointer = *reinterpret_cast<uintptr_t*>(pObjects + FieldOffset);
+        Pointer += reinterpret_cast<uintptr_t>(pObjects);
+    }
+
+    const RenderStateNotationBinaryContents* pContents = reinterpret_cast<const RenderStateNotationBinaryContents*>(pObjects);
+
+    BinaryValidator Validator{pObjects, Header.DataSize};
+    ProcessPointers(*pContents, Validator);
+    if (!Validator.IsValid())
+        return nullptr;
+
+    return pContents;
+}
+
+} // namespace Diligent
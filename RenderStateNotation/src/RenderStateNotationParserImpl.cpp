@@ -27,6 +27,7 @@
 #include "pch.h"
 
 #include "RenderStateNotationParserImpl.hpp"
+#include "RenderStateNotationBinary.hpp"
 
 #include <unordered_set>
 #include <functional>
@@ -245,6 +246,13 @@ PIPELINE_TYPE GetPipelineType(const nlohmann::json& Json)
     return PIPELINE_TYPE_INVALID;
 }
 
+XXH128Hash ComputeSourceHash(const void* pData, size_t Size)
+{
+    XXH128State Hasher;
+    Hasher.UpdateRaw(pData, Size);
+    return Hasher.Digest();
+}
+
 } // namespace
 
 void ParseRSNDeviceCreateInfo(const Char* Data, Uint32 Size, SerializationDeviceCreateInfo& Type, DynamicLinearAllocator& Allocator)
@@ -272,7 +280,7 @@ Bool RenderStateNotationParserImpl::ParseFile(const Char*                      F
         return false;
     }
 
-    const Bool res = ParseFileInternal(FilePath, pStreamFactory);
+    const Bool res = ParseFileInternal(FilePath, pStreamFactory, false);
     if (m_CI.EnableReload && res)
     {
         ReloadInfo Info;
@@ -284,7 +292,8 @@ Bool RenderStateNotationParserImpl::ParseFile(const Char*                      F
 }
 
 Bool RenderStateNotationParserImpl::ParseFileInternal(const Char*                      FilePath,
-                                                      IShaderSourceInputStreamFactory* pStreamFactory)
+                                                      IShaderSourceInputStreamFactory* pStreamFactory,
+                                                      bool                             IsImport)
 {
     VERIFY_EXPR(FilePath != nullptr && pStreamFactory != nullptr);
 
@@ -302,6 +311,14 @@ Bool RenderStateNotationParserImpl::ParseFileInternal(const Char*
             RefCntAutoPtr<DataBlobImpl> pFileData = DataBlobImpl::Create();
             pFileStream->ReadBlob(pFileData);
 
+            {
+                SourceInfo Source;
+                Source.Path     = FilePath;
+                Source.Hash     = ComputeSourceHash(pFileData->GetConstDataPtr(), pFileData->GetSize());
+                Source.IsImport = IsImport;
+                m_Sources.emplace_back(std::move(Source));
+            }
+
             if (!ParseStringInternal(pFileData->GetConstDataPtr<char>(), StaticCast<Uint32>(pFileData->GetSize()), pStreamFactory))
                 LOG_ERROR_AND_THROW("Failed to parse file: '", FilePath, "'.");
         }
@@ -325,6 +342,12 @@ Bool RenderStateNotationParserImpl::ParseString(const Char*
         return false;
     }
 
+    {
+        SourceInfo SrcInfo;
+        SrcInfo.Hash = ComputeSourceHash(Source, Length != 0 ? Length : strlen(Source));
+        m_Sources.emplace_back(std::move(SrcInfo));
+    }
+
     const Bool res = ParseStringInternal(Source, Length, pStreamFactory);
     if (m_CI.EnableReload && res)
     {
@@ -360,7 +383,7 @@ Bool RenderStateNotationParserImpl::ParseStringInternal(const Char*
                 VERIFY_EXPR(pStreamFactory != nullptr);
                 auto Path = Import.get<std::string>();
 
-                if (!ParseFileInternal(Path.c_str(), pStreamFactory))
+                if (!ParseFileInternal(Path.c_str(), pStreamFactory, true))
                     LOG_ERROR_AND_THROW("Failed to import file: '", Path, "'.");
             }
 
@@ -580,6 +603,170 @@ Bool RenderStateNotationParserImpl::ParseStringInternal(const Char*
     return true;
 }
 
+Bool RenderStateNotationParserImpl::CompileBinary(IDataBlob** ppBinary) const
+{
+    DEV_CHECK_ERR(ppBinary != nullptr, "ppBinary must not be null");
+    DEV_CHECK_ERR(*ppBinary == nullptr, "Overwriting reference to an existing object may result in memory leaks");
+
+    try
+    {
+        std::vector<const PipelineStateNotation*> PipelineStates;
+        PipelineStates.reserve(m_PipelineStates.size());
+        for (const PipelineStateNotation& Pipeline : m_PipelineStates)
+            PipelineStates.emplace_back(&Pipeline);
+
+        std::vector<const Char*> IgnoredSignatures;
+        IgnoredSignatures.reserve(m_IgnoredSignatures.size());
+        for (const std::string& Signature : m_IgnoredSignatures)
+            IgnoredSignatures.emplace_back(Signature.c_str());
+
+        std::vector<RenderStateNotationSourceInfo> Sources(m_Sources.size());
+        for (size_t i = 0; i < m_Sources.size(); ++i)
+        {
+            Sources[i].Path     = !m_Sources[i].Path.empty() ? m_Sources[i].Path.c_str() : nullptr;
+            Sources[i].Hash     = m_Sources[i].Hash;
+            Sources[i].IsImport = m_Sources[i].IsImport;
+        }
+
+        RenderStateNotationBinaryContents Contents;
+        Contents.pShaders               = m_Shaders.data();
+        Contents.ShaderCount            = StaticCast<Uint32>(m_Shaders.size());
+        Contents.pRenderPasses          = m_RenderPasses.data();
+        Contents.RenderPassCount        = StaticCast<Uint32>(m_RenderPasses.size());
+        Contents.pResourceSignatures    = m_ResourceSignatures.data();
+        Contents.ResourceSignatureCount = StaticCast<Uint32>(m_ResourceSignatures.size());
+        Contents.ppPipelineStates       = PipelineStates.data();
+        Contents.PipelineStateCount     = StaticCast<Uint32>(PipelineStates.size());
+        Contents.ppIgnoredSignatures    = IgnoredSignatures.data();
+        Contents.IgnoredSignatureCount  = StaticCast<Uint32>(IgnoredSignatures.size());
+        Contents.pSources               = Sources.data();
+        Contents.SourceCount            = StaticCast<Uint32>(Sources.size());
+
+        RefCntAutoPtr<IDataBlob> pBinary = WriteRenderStateNotationBinary(Contents);
+        *ppBinary                        = pBinary.Detach();
+        return true;
+    }
+    catch (...)
+    {
+        LOG_ERROR("Failed to compile render state notation binary");
+        return false;
+    }
+}
+
+Bool RenderStateNotationParserImpl::ParseBinary(const void*                      pData,
+                                                size_t                           DataSize,
+                                                IShaderSourceInputStreamFactory* pStreamFactory,
+                                                IShaderSourceInputStreamFactory* pReloadFactory)
+{
+    if (pData == nullptr || DataSize == 0)
+    {
+        DEV_ERROR("Binary data must not be null or empty");
+        return false;
+    }
+
+    if (!m_Sources.empty() || m_ParseInfo.ShaderCount != 0 || m_ParseInfo.RenderPassCount != 0 ||
+        m_ParseInfo.ResourceSignatureCount != 0 || m_ParseInfo.PipelineStateCount != 0)
+    {
+        DEV_ERROR("The parser must be empty when ParseBinary() is called. Call Reset() first.");
+        return false;
+    }
+
+    auto pAllocator = std::make_unique<DynamicLinearAllocator>(DefaultRawMemoryAllocator::GetAllocator());
+
+    const RenderStateNotationBinaryContents* pContents = ReadRenderStateNotationBinary(pData, DataSize, *pAllocator);
+    if (pContents == nullptr)
+    {
+        LOG_INFO_MESSAGE("Render state notation binary is invalid or was created by an incompatible version of the parser");
+        return false;
+    }
+
+    // Verify that the binary is up to date
+    if (pStreamFactory != nullptr)
+    {
+        for (Uint32 i = 0; i < pContents->SourceCount; ++i)
+        {
+            const RenderStateNotationSourceInfo& Source = pContents->pSources[i];
+            if (Source.Path == nullptr)
+                continue;
+
+            RefCntAutoPtr<IFileStream> pFileStream;
+            pStreamFactory->CreateInputStream(Source.Path, &pFileStream);
+            if (!pFileStream)
+            {
+                LOG_INFO_MESSAGE("Render state notation binary is out of date: failed to open source file '", Source.Path, "'");
+                return false;
+            }
+
+            RefCntAutoPtr<DataBlobImpl> pFileData = DataBlobImpl::Create();
+            pFileStream->ReadBlob(pFileData);
+            if (!(ComputeSourceHash(pFileData->GetConstDataPtr(), pFileData->GetSize()) == Source.Hash))
+            {
+                LOG_INFO_MESSAGE("Render state notation binary is out of date: source file '", Source.Path, "' has been modified");
+                return false;
+            }
+        }
+    }
+
+    // All objects now reside in the memory owned by the new allocator
+    m_pAllocator = std::move(pAllocator);
+
+    m_Shaders.assign(pContents->pShaders, pContents->pShaders + pContents->ShaderCount);
+    for (Uint32 i = 0; i < pContents->ShaderCount; ++i)
+        m_ShaderNames.emplace(HashMapStringKey{m_Shaders[i].Desc.Name, false}, i);
+
+    m_RenderPasses.assign(pContents->pRenderPasses, pContents->pRenderPasses + pContents->RenderPassCount);
+    for (Uint32 i = 0; i < pContents->RenderPassCount; ++i)
+        m_RenderPassNames.emplace(HashMapStringKey{m_RenderPasses[i].Name, false}, i);
+
+    m_ResourceSignatures.assign(pContents->pResourceSignatures, pContents->pResourceSignatures + pContents->ResourceSignatureCount);
+    for (Uint32 i = 0; i < pContents->ResourceSignatureCount; ++i)
+        m_ResourceSignatureNames.emplace(HashMapStringKey{m_ResourceSignatures[i].Name, false}, i);
+
+    m_PipelineStates.reserve(pContents->PipelineStateCount);
+    for (Uint32 i = 0; i < pContents->PipelineStateCount; ++i)
+    {
+        const PipelineStateNotation& Pipeline = *pContents->ppPipelineStates[i];
+        m_PipelineStateNames.emplace(std::make_pair(HashMapStringKey{Pipeline.PSODesc.Name, false}, Pipeline.PSODesc.PipelineType), i);
+        m_PipelineStates.emplace_back(Pipeline);
+    }
+
+    for (Uint32 i = 0; i < pContents->IgnoredSignatureCount; ++i)
+        m_IgnoredSignatures.emplace(pContents->ppIgnoredSignatures[i]);
+
+    for (Uint32 i = 0; i < pContents->SourceCount; ++i)
+    {
+        const RenderStateNotationSourceInfo& Source = pContents->pSources[i];
+
+        SourceInfo SrcInfo;
+        if (Source.Path != nullptr)
+        {
+            SrcInfo.Path = Source.Path;
+            // Imported files are skipped by ParseFileInternal() if the parser has already processed them
+            m_Includes.emplace(Source.Path);
+        }
+        SrcInfo.Hash     = Source.Hash;
+        SrcInfo.IsImport = Source.IsImport;
+        m_Sources.emplace_back(std::move(SrcInfo));
+
+        // Only top-level files can be reloaded as the source strings are not stored in the binary
+        IShaderSourceInputStreamFactory* pFactory = pReloadFactory != nullptr ? pReloadFactory : pStreamFactory;
+        if (m_CI.EnableReload && pFactory != nullptr && Source.Path != nullptr && !Source.IsImport)
+        {
+            ReloadInfo Info;
+            Info.Path     = Source.Path;
+            Info.pFactory = pFactory;
+            m_ReloadInfo.emplace_back(std::move(Info));
+        }
+    }
+
+    m_ParseInfo.ResourceSignatureCount = StaticCast<Uint32>(m_ResourceSignatures.size());
+    m_ParseInfo.ShaderCount            = StaticCast<Uint32>(m_Shaders.size());
+    m_ParseInfo.RenderPassCount        = StaticCast<Uint32>(m_RenderPasses.size());
+    m_ParseInfo.PipelineStateCount     = StaticCast<Uint32>(m_PipelineStates.size());
+
+    return true;
+}
+
 const PipelineStateNotation* RenderStateNotationParserImpl::GetPipelineStateByName(const Char* Name, PIPELINE_TYPE PipelineType) const
 {
     auto FindPipeline = [this](const Char* Name, PIPELINE_TYPE PipelineType) -> const PipelineStateNotation* //
@@ -675,6 +862,8 @@ void RenderStateNotationParserImpl::Reset()
     m_RenderPassNames.clear();
     m_PipelineStateNames.clear();
 
+    m_Sources.clear();
+
     m_ParseInfo = {};
 }
 
@@ -697,7 +886,7 @@ bool RenderStateNotationParserImpl::Reload()
     {
         if (!Reload.Path.empty())
         {
-            if (!ParseFileInternal(Reload.Path.c_str(), Reload.pFactory))
+            if (!ParseFileInternal(Reload.Path.c_str(), Reload.pFactory, false))
                 res = false;
         }
         else if (!Reload.Source.empty())
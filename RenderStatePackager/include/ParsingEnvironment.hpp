@@ -45,6 +45,7 @@ struct ParsingEnvironmentCreateInfo
     Uint32                    ThreadCount          = 0;
     Uint32                    ContentVersion       = 0;
     bool                      PrintArchiveContents = false;
+    bool                      IncrementalBuild     = false;
     std::vector<std::string>  ShaderDirs           = {};
     std::vector<std::string>  RenderStateDirs      = {};
     std::vector<std::string>  InputFilePaths       = {};
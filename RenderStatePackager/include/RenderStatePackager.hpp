@@ -27,6 +27,7 @@
 #pragma once
 
 #include <vector>
+#include <map>
 #include <unordered_map>
 
 #include "Archiver.h"
@@ -35,6 +36,8 @@
 #include "SerializationDevice.h"
 #include "RenderStateNotationParser.h"
 #include "HashUtils.hpp"
+#include "XXH128Hasher.hpp"
+#include "ArchiverFactory.h"
 
 namespace Diligent
 {
@@ -47,7 +50,8 @@ public:
                         RefCntAutoPtr<IShaderSourceInputStreamFactory> pRenderStateStreamFactory,
                         RefCntAutoPtr<IThreadPool>                     pThreadPool,
                         ARCHIVE_DEVICE_DATA_FLAGS                      DeviceFlags,
-                        PSO_ARCHIVE_FLAGS                              PSOArchiveFlags);
+                        PSO_ARCHIVE_FLAGS                              PSOArchiveFlags,
+                        const XXH128Hash&                              BuildSettingsHash = {});
 
     // clang-format off
     RenderStatePackager           (const RenderStatePackager&)  = delete;
@@ -60,6 +64,26 @@ public:
 
     bool Execute(IArchiver* pArchiver, const char* DumpPath = nullptr);
 
+    // Enables the incremental build mode. In this mode, Execute() only creates and archives
+    // the objects whose notation, shader sources (including all included files), macros or build
+    // settings changed since the build described by pPrevManifest. The resulting archive must then
+    // be merged with the previous one using MergeWithPreviousBuild().
+    // If pPrevManifest is null or invalid, or if it does not describe pPrevArchive (e.g. the archive
+    // was overwritten by a non-incremental build), all objects are rebuilt.
+    bool EnableIncrementalBuild(const IDataBlob* pPrevManifest, const IDataBlob* pPrevArchive);
+
+    // Returns the manifest of the last executed build that should be passed to
+    // EnableIncrementalBuild() next time. pArchive is the final (merged) archive
+    // the manifest describes.
+    RefCntAutoPtr<IDataBlob> GetBuildManifest(const IDataBlob* pArchive) const;
+
+    // Removes the objects that were rebuilt or deleted from the previous archive and merges
+    // the remaining objects with the new archive produced by Execute().
+    bool MergeWithPreviousBuild(IArchiverFactory* pArchiverFactory,
+                                const IDataBlob*  pPrevArchive,
+                                const IDataBlob*  pNewArchive,
+                                IDataBlob**       ppMergedArchive) const;
+
     void Reset();
 
     const IRenderStateNotationParser* GetParser() const
@@ -69,6 +93,65 @@ public:
 
     static const char* GetShaderFileExtension(ARCHIVE_DEVICE_DATA_FLAGS DeviceFlag, SHADER_SOURCE_LANGUAGE Language, bool UseBytecode);
 
+    struct ObjectTiming
+    {
+        ARCHIVE_RESOURCE_TYPE Type = ARCHIVE_RESOURCE_TYPE_UNDEFINED;
+        std::string           Name;
+
+        // Times in seconds since the start of Execute().
+        // For pipelines, the time includes adding the pipeline to the archive.
+        double StartTime = 0;
+        double EndTime   = 0;
+    };
+
+    // Returns the timings of the objects created by the last call to Execute()
+    const std::vector<ObjectTiming>& GetObjectTimings() const
+    {
+        return m_ObjectTimings;
+    }
+
+private:
+    struct BuildManifest
+    {
+        XXH128Hash BuildSettings;
+        // Hash of the archive produced by the build
+        XXH128Hash Archive;
+
+        std::map<std::string, XXH128Hash> Signatures;
+        std::map<std::string, XXH128Hash> RenderPasses;
+        std::map<std::string, XXH128Hash> Pipelines;
+
+        std::string ToString() const;
+        bool        FromString(const char* Str, size_t Length);
+    };
+
+    // Objects that need to be created by Execute(), indexed the same way as in the parser
+    struct BuildList
+    {
+        std::vector<bool> Shaders;
+        std::vector<bool> RenderPasses;
+        std::vector<bool> Signatures;
+        std::vector<bool> Pipelines;
+
+        // Signatures that are added to the archive explicitly
+        std::vector<bool> ArchivedSignatures;
+    };
+
+    static constexpr Uint32 InvalidObjectIndex = ~0u;
+
+    // Indices of the objects that a pipeline references, in the parser order.
+    // Names that are not defined in the notation are skipped.
+    struct PipelineDependencies
+    {
+        std::vector<Uint32> Shaders;
+        std::vector<Uint32> Signatures;
+        Uint32              RenderPass = InvalidObjectIndex;
+    };
+
+    void                 IndexObjects();
+    PipelineDependencies GetPipelineDependencies(const PipelineStateNotation& DescRSN) const;
+    BuildList            PrepareIncrementalBuild();
+
 private:
     RefCntAutoPtr<ISerializationDevice>            m_pDevice;
     RefCntAutoPtr<IShaderSourceInputStreamFactory> m_pShaderStreamFactory;
@@ -76,15 +159,26 @@ private:
     RefCntAutoPtr<IThreadPool>                     m_pThreadPool;
     RefCntAutoPtr<IRenderStateNotationParser>      m_pRSNParser;
 
-    template <typename T>
-    using TNamedObjectHashMap = std::unordered_map<HashMapStringKey, RefCntAutoPtr<T>>;
+    using TNamedObjectIndexMap = std::unordered_map<HashMapStringKey, Uint32>;
 
-    TNamedObjectHashMap<IShader>                    m_Shaders;
-    TNamedObjectHashMap<IRenderPass>                m_RenderPasses;
-    TNamedObjectHashMap<IPipelineResourceSignature> m_ResourceSignatures;
+    TNamedObjectIndexMap m_ShaderIndices;
+    TNamedObjectIndexMap m_RenderPassIndices;
+    TNamedObjectIndexMap m_SignatureIndices;
 
     const ARCHIVE_DEVICE_DATA_FLAGS m_DeviceFlags;
     const PSO_ARCHIVE_FLAGS         m_PSOArchiveFlags;
+    const XXH128Hash                m_BuildSettingsHash;
+
+    bool          m_IncrementalBuild = false;
+    bool          m_HasPrevManifest  = false;
+    bool          m_ReusePrevBuild   = false;
+    BuildManifest m_PrevManifest;
+    BuildManifest m_Manifest;
+
+    // Objects that must be removed from the previous archive before merging it with the new one
+    std::vector<std::pair<ARCHIVE_RESOURCE_TYPE, std::string>> m_StaleResources;
+
+    std::vector<ObjectTiming> m_ObjectTimings;
 };
 
 } // namespace Diligent
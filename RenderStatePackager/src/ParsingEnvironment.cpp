@@ -80,6 +80,10 @@ bool ParsingEnvironment::Initialize()
 
         DynamicLinearAllocator        Allocator{DefaultRawMemoryAllocator::GetAllocator()};
         SerializationDeviceCreateInfo DeviceCI = {};
+
+        // Settings that affect all objects in the archive
+        XXH128State BuildSettingsHasher;
+        BuildSettingsHasher.Update(m_CreateInfo.ContentVersion);
         if (!m_CreateInfo.ConfigFilePath.empty())
         {
             FileWrapper File{m_CreateInfo.ConfigFilePath.c_str(), EFileAccessMode::Read};
@@ -88,6 +92,7 @@ bool ParsingEnvironment::Initialize()
 
             RefCntAutoPtr<DataBlobImpl> pFileData = DataBlobImpl::Create();
             File->Read(pFileData);
+            BuildSettingsHasher.UpdateRaw(pFileData->GetConstDataPtr(), pFileData->GetSize());
 
             ParseRSNDeviceCreateInfo(pFileData->GetConstDataPtr<char>(), StaticCast<Uint32>(pFileData->GetSize()), DeviceCI, Allocator);
         }
@@ -122,7 +127,7 @@ bool ParsingEnvironment::Initialize()
         ThreadPoolCreateInfo ThreadPoolCI{ThreadCount};
         m_pThreadPool = CreateThreadPool(ThreadPoolCI);
 
-        m_pPackager = std::make_unique<RenderStatePackager>(m_pSerializationDevice, m_pShaderStreamFactory, m_pRenderStateStreamFactory, m_pThreadPool, m_CreateInfo.DeviceFlags, m_CreateInfo.PSOArchiveFlags);
+        m_pPackager = std::make_unique<RenderStatePackager>(m_pSerializationDevice, m_pShaderStreamFactory, m_pRenderStateStreamFactory, m_pThreadPool, m_CreateInfo.DeviceFlags, m_CreateInfo.PSOArchiveFlags, BuildSettingsHasher.Digest());
 
         return true;
     }
@@ -28,6 +28,9 @@
 
 #include <deque>
 #include <sstream>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 
 #include "GraphicsAccessories.hpp"
 #include "BasicMath.hpp"
@@ -36,6 +39,8 @@
 #include "SerializedPipelineState.h"
 #include "FileSystem.hpp"
 #include "FileWrapper.hpp"
+#include "DataBlobImpl.hpp"
+#include "Timer.hpp"
 
 namespace Diligent
 {
@@ -147,8 +152,208 @@ struct BytecodeDumper
     }
 };
 
+constexpr char ManifestHeader[] = "DiligentRenderStatePackagerManifest 2";
+
+std::string HashToString(const XXH128Hash& Hash)
+{
+    char Str[33];
+    snprintf(Str, sizeof(Str), "%016llx%016llx", static_cast<unsigned long long>(Hash.HighPart), static_cast<unsigned long long>(Hash.LowPart));
+    return Str;
+}
+
+bool StringToHash(const std::string& Str, XXH128Hash& Hash)
+{
+    if (Str.length() != 32 || Str.find_first_not_of("0123456789abcdef") != std::string::npos)
+        return false;
+
+    Hash.HighPart = std::strtoull(Str.substr(0, 16).c_str(), nullptr, 16);
+    Hash.LowPart  = std::strtoull(Str.substr(16, 16).c_str(), nullptr, 16);
+    return true;
+}
+
+void UpdateHash(XXH128State& Hasher, const XXH128Hash& Hash)
+{
+    Hasher.Update(Hash.LowPart, Hash.HighPart);
+}
+
+void UpdateName(XXH128State& Hasher, const char* Name)
+{
+    // Hash the terminating null character to separate consecutive names
+    if (Name != nullptr)
+        Hasher.UpdateRaw(Name, strlen(Name) + 1);
+    else
+        Hasher.Update(Uint8{0});
+}
+
+XXH128Hash ComputeBuildSettingsHash(const XXH128Hash& UserSettingsHash, ARCHIVE_DEVICE_DATA_FLAGS DeviceFlags, PSO_ARCHIVE_FLAGS PSOArchiveFlags)
+{
+    XXH128State Hasher;
+    UpdateHash(Hasher, UserSettingsHash);
+    Hasher.Update(DeviceFlags, PSOArchiveFlags);
+    return Hasher.Digest();
+}
+
+// Calls Handler(ARCHIVE_RESOURCE_TYPE Type, const char* Name) for every object referenced by the pipeline.
+// Unused shader stages are reported with null names.
+template <typename HandlerType>
+void ProcessPipelineReferences(const PipelineStateNotation& DescRSN, HandlerType&& Handler)
+{
+    for (Uint32 SignatureID = 0; SignatureID < DescRSN.ResourceSignaturesNameCount; ++SignatureID)
+        Handler(ARCHIVE_RESOURCE_TYPE_RESOURCE_SIGNATURE, DescRSN.ppResourceSignatureNames[SignatureID]);
+
+    static_assert(PIPELINE_TYPE_COUNT == 5, "Did you add a new pipeline type? You may need to handle it here.");
+    switch (DescRSN.PSODesc.PipelineType)
+    {
+        case PIPELINE_TYPE_GRAPHICS:
+        case PIPELINE_TYPE_MESH:
+        {
+            const GraphicsPipelineNotation& PipelineRSN = static_cast<const GraphicsPipelineNotation&>(DescRSN);
+            Handler(ARCHIVE_RESOURCE_TYPE_RENDER_PASS, PipelineRSN.pRenderPassName);
+            for (const char* ShaderName : {PipelineRSN.pVSName, PipelineRSN.pPSName, PipelineRSN.pDSName, PipelineRSN.pHSName,
+                                           PipelineRSN.pGSName, PipelineRSN.pASName, PipelineRSN.pMSName})
+                Handler(ARCHIVE_RESOURCE_TYPE_SHADER, ShaderName);
+            break;
+        }
+
+        case PIPELINE_TYPE_COMPUTE:
+            Handler(ARCHIVE_RESOURCE_TYPE_SHADER, static_cast<const ComputePipelineNotation&>(DescRSN).pCSName);
+            break;
+
+        case PIPELINE_TYPE_TILE:
+            Handler(ARCHIVE_RESOURCE_TYPE_SHADER, static_cast<const TilePipelineNotation&>(DescRSN).pTSName);
+            break;
+
+        case PIPELINE_TYPE_RAY_TRACING:
+        {
+            const RayTracingPipelineNotation& PipelineRSN = static_cast<const RayTracingPipelineNotation&>(DescRSN);
+            for (Uint32 i = 0; i < PipelineRSN.GeneralShaderCount; ++i)
+                Handler(ARCHIVE_RESOURCE_TYPE_SHADER, PipelineRSN.pGeneralShaders[i].pShaderName);
+            for (Uint32 i = 0; i < PipelineRSN.TriangleHitShaderCount; ++i)
+            {
+                Handler(ARCHIVE_RESOURCE_TYPE_SHADER, PipelineRSN.pTriangleHitShaders[i].pClosestHitShaderName);
+                Handler(ARCHIVE_RESOURCE_TYPE_SHADER, PipelineRSN.pTriangleHitShaders[i].pAnyHitShaderName);
+            }
+            for (Uint32 i = 0; i < PipelineRSN.ProceduralHitShaderCount; ++i)
+            {
+                Handler(ARCHIVE_RESOURCE_TYPE_SHADER, PipelineRSN.pProceduralHitShaders[i].pIntersectionShaderName);
+                Handler(ARCHIVE_RESOURCE_TYPE_SHADER, PipelineRSN.pProceduralHitShaders[i].pClosestHitShaderName);
+                Handler(ARCHIVE_RESOURCE_TYPE_SHADER, PipelineRSN.pProceduralHitShaders[i].pAnyHitShaderName);
+            }
+            break;
+        }
+
+        default:
+            UNEXPECTED("Unexpected pipeline type");
+    }
+}
+
+const char* GetObjectTypeString(ARCHIVE_RESOURCE_TYPE Type)
+{
+    static_assert(ARCHIVE_RESOURCE_TYPE_COUNT == 5, "Please handle the new resource type below");
+    switch (Type)
+    {
+        case ARCHIVE_RESOURCE_TYPE_SHADER: return "shader";
+        case ARCHIVE_RESOURCE_TYPE_RESOURCE_SIGNATURE: return "resource signature";
+        case ARCHIVE_RESOURCE_TYPE_PIPELINE_STATE: return "pipeline";
+        case ARCHIVE_RESOURCE_TYPE_RENDER_PASS: return "render pass";
+        default:
+            UNEXPECTED("Unexpected resource type (", static_cast<Uint32>(Type), ")");
+            return "";
+    }
+}
+
+std::string FormatTime(double Seconds)
+{
+    char Str[32];
+    snprintf(Str, sizeof(Str), "%.1f ms", Seconds * 1000.0);
+    return Str;
+}
+
+XXH128Hash ComputeArchiveHash(const IDataBlob* pArchive)
+{
+    XXH128State Hasher;
+    Hasher.UpdateRaw(pArchive->GetConstDataPtr(), pArchive->GetSize());
+    return Hasher.Digest();
+}
+
 } // namespace
 
+std::string RenderStatePackager::BuildManifest::ToString() const
+{
+    std::stringstream Stream;
+    Stream << ManifestHeader << '\n';
+    Stream << "settings " << HashToString(BuildSettings) << '\n';
+    Stream << "archive " << HashToString(Archive) << '\n';
+
+    auto WriteObjects = [&Stream](const char* Type, const std::map<std::string, XXH128Hash>& Objects) {
+        for (const auto& it : Objects)
+            Stream << Type << ' ' << HashToString(it.second) << ' ' << it.first << '\n';
+    };
+    WriteObjects("signature", Signatures);
+    WriteObjects("renderpass", RenderPasses);
+    WriteObjects("pipeline", Pipelines);
+
+    return Stream.str();
+}
+
+bool RenderStatePackager::BuildManifest::FromString(const char* Str, size_t Length)
+{
+    *this = {};
+
+    std::stringstream Stream{std::string{Str, Length}};
+    std::string       Line;
+    if (!std::getline(Stream, Line) || Line != ManifestHeader)
+        return false;
+
+    bool HasSettings = false;
+    bool HasArchive  = false;
+    while (std::getline(Stream, Line))
+    {
+        if (Line.empty())
+            continue;
+
+        // <type> <hash> [<name>]
+        const size_t TypeEnd = Line.find(' ');
+        if (TypeEnd == std::string::npos)
+            return false;
+
+        const std::string Type = Line.substr(0, TypeEnd);
+
+        XXH128Hash Hash;
+        if (!StringToHash(Line.substr(TypeEnd + 1, 32), Hash))
+            return false;
+
+        if (Type == "settings")
+        {
+            BuildSettings = Hash;
+            HasSettings   = true;
+            continue;
+        }
+        if (Type == "archive")
+        {
+            Archive    = Hash;
+            HasArchive = true;
+            continue;
+        }
+
+        const size_t NameStart = TypeEnd + 1 + 32 + 1;
+        if (Line.length() <= NameStart || Line[NameStart - 1] != ' ')
+            return false;
+        std::string Name = Line.substr(NameStart);
+
+        if (Type == "signature")
+            Signatures.emplace(std::move(Name), Hash);
+        else if (Type == "renderpass")
+            RenderPasses.emplace(std::move(Name), Hash);
+        else if (Type == "pipeline")
+            Pipelines.emplace(std::move(Name), Hash);
+        else
+            return false;
+    }
+
+    return HasSettings && HasArchive;
+}
+
 const char* RenderStatePackager::GetShaderFileExtension(ARCHIVE_DEVICE_DATA_FLAGS DeviceFlag, SHADER_SOURCE_LANGUAGE Language, bool UseBytecode)
 {
     static_assert(ARCHIVE_DEVICE_DATA_FLAG_LAST == 1 << 7, "Please handle the new device flag below");
@@ -195,13 +400,15 @@ RenderStatePackager::RenderStatePackager(RefCntAutoPtr<ISerializationDevice>
                                          RefCntAutoPtr<IShaderSourceInputStreamFactory> pRenderStateStreamFactory,
                                          RefCntAutoPtr<IThreadPool>                     pThreadPool,
                                          ARCHIVE_DEVICE_DATA_FLAGS                      DeviceFlags,
-                                         PSO_ARCHIVE_FLAGS                              PSOArchiveFlags) :
+                                         PSO_ARCHIVE_FLAGS                              PSOArchiveFlags,
+                                         const XXH128Hash&                              BuildSettingsHash) :
     m_pDevice{pDevice},
     m_pShaderStreamFactory{pShaderStreamFactory},
     m_pRenderStateStreamFactory{pRenderStateStreamFactory},
     m_pThreadPool{pThreadPool},
     m_DeviceFlags{DeviceFlags & pDevice->GetSupportedDeviceFlags()},
-    m_PSOArchiveFlags{PSOArchiveFlags}
+    m_PSOArchiveFlags{PSOArchiveFlags},
+    m_BuildSettingsHash{ComputeBuildSettingsHash(BuildSettingsHash, m_DeviceFlags, m_PSOArchiveFlags)}
 {
 }
 
@@ -216,6 +423,349 @@ bool RenderStatePackager::ParseFiles(std::vector<std::string> const& DRSNPaths)
     return true;
 }
 
+bool RenderStatePackager::EnableIncrementalBuild(const IDataBlob* pPrevManifest, const IDataBlob* pPrevArchive)
+{
+    m_IncrementalBuild = true;
+    m_HasPrevManifest  = false;
+    m_PrevManifest     = {};
+
+    if (pPrevManifest == nullptr || pPrevArchive == nullptr)
+        return true;
+
+    if (!m_PrevManifest.FromString(pPrevManifest->GetConstDataPtr<char>(), pPrevManifest->GetSize()))
+    {
+        LOG_WARNING_MESSAGE("Previous build manifest is invalid. All objects will be rebuilt.");
+        m_PrevManifest = {};
+        return false;
+    }
+
+    if (!(m_PrevManifest.Archive == ComputeArchiveHash(pPrevArchive)))
+    {
+        // The archive was modified after the manifest was written, e.g. by a non-incremental build
+        LOG_WARNING_MESSAGE("Previous build manifest does not match the previous archive. All objects will be rebuilt.");
+        m_PrevManifest = {};
+        return false;
+    }
+
+    m_HasPrevManifest = true;
+    return true;
+}
+
+RefCntAutoPtr<IDataBlob> RenderStatePackager::GetBuildManifest(const IDataBlob* pArchive) const
+{
+    DEV_CHECK_ERR(pArchive != nullptr, "pArchive must not be null");
+    if (!m_IncrementalBuild || pArchive == nullptr)
+        return {};
+
+    BuildManifest Manifest = m_Manifest;
+    Manifest.Archive       = ComputeArchiveHash(pArchive);
+
+    const std::string ManifestStr = Manifest.ToString();
+    return RefCntAutoPtr<IDataBlob>{DataBlobImpl::Create(ManifestStr.length(), ManifestStr.data())};
+}
+
+void RenderStatePackager::IndexObjects()
+{
+    const RenderStateNotationParserInfo& ParserInfo = m_pRSNParser->GetInfo();
+
+    m_ShaderIndices.clear();
+    for (Uint32 ShaderID = 0; ShaderID < ParserInfo.ShaderCount; ++ShaderID)
+        m_ShaderIndices.emplace(HashMapStringKey{m_pRSNParser->GetShaderByIndex(ShaderID)->Desc.Name}, ShaderID);
+
+    m_RenderPassIndices.clear();
+    for (Uint32 RenderPassID = 0; RenderPassID < ParserInfo.RenderPassCount; ++RenderPassID)
+        m_RenderPassIndices.emplace(HashMapStringKey{m_pRSNParser->GetRenderPassByIndex(RenderPassID)->Name}, RenderPassID);
+
+    m_SignatureIndices.clear();
+    for (Uint32 SignatureID = 0; SignatureID < ParserInfo.ResourceSignatureCount; ++SignatureID)
+        m_SignatureIndices.emplace(HashMapStringKey{m_pRSNParser->GetResourceSignatureByIndex(SignatureID)->Name}, SignatureID);
+}
+
+RenderStatePackager::PipelineDependencies RenderStatePackager::GetPipelineDependencies(const PipelineStateNotation& DescRSN) const
+{
+    PipelineDependencies Deps;
+    ProcessPipelineReferences(DescRSN, [&](ARCHIVE_RESOURCE_TYPE Type, const char* Name) {
+        if (Name == nullptr)
+            return;
+
+        switch (Type)
+        {
+            case ARCHIVE_RESOURCE_TYPE_SHADER:
+            {
+                auto it = m_ShaderIndices.find(Name);
+                if (it != m_ShaderIndices.end() && std::find(Deps.Shaders.begin(), Deps.Shaders.end(), it->second) == Deps.Shaders.end())
+                    Deps.Shaders.push_back(it->second);
+                break;
+            }
+
+            case ARCHIVE_RESOURCE_TYPE_RESOURCE_SIGNATURE:
+            {
+                auto it = m_SignatureIndices.find(Name);
+                if (it != m_SignatureIndices.end())
+                    Deps.Signatures.push_back(it->second);
+                break;
+            }
+
+            case ARCHIVE_RESOURCE_TYPE_RENDER_PASS:
+            {
+                auto it = m_RenderPassIndices.find(Name);
+                if (it != m_RenderPassIndices.end())
+                    Deps.RenderPass = it->second;
+                break;
+            }
+
+            default:
+                UNEXPECTED("Unexpected resource type");
+        }
+    });
+    return Deps;
+}
+
+RenderStatePackager::BuildList RenderStatePackager::PrepareIncrementalBuild()
+{
+    const RenderStateNotationParserInfo& ParserInfo = m_pRSNParser->GetInfo();
+
+    BuildList Build;
+    Build.Shaders.resize(ParserInfo.ShaderCount, !m_IncrementalBuild);
+    Build.RenderPasses.resize(ParserInfo.RenderPassCount, !m_IncrementalBuild);
+    Build.Signatures.resize(ParserInfo.ResourceSignatureCount, !m_IncrementalBuild);
+    Build.Pipelines.resize(ParserInfo.PipelineStateCount, !m_IncrementalBuild);
+    Build.ArchivedSignatures.resize(ParserInfo.ResourceSignatureCount, false);
+
+    for (Uint32 SignatureID = 0; SignatureID < ParserInfo.ResourceSignatureCount; ++SignatureID)
+        Build.ArchivedSignatures[SignatureID] = !m_pRSNParser->IsSignatureIgnored(m_pRSNParser->GetResourceSignatureByIndex(SignatureID)->Name);
+
+    if (!m_IncrementalBuild)
+        return Build;
+
+    m_Manifest               = {};
+    m_Manifest.BuildSettings = m_BuildSettingsHash;
+    m_StaleResources.clear();
+    m_ReusePrevBuild = m_HasPrevManifest && m_PrevManifest.BuildSettings == m_BuildSettingsHash;
+
+    // Shader hashes cover the entire include closure, so hash them in parallel
+    std::vector<XXH128Hash> ShaderHashes(ParserInfo.ShaderCount);
+    for (Uint32 ShaderID = 0; ShaderID < ParserInfo.ShaderCount; ++ShaderID)
+    {
+        EnqueueAsyncWork(m_pThreadPool,
+                         [ShaderID, this, &ShaderHashes](Uint32 ThreadId) {
+                             ShaderCreateInfo ShaderCI           = *m_pRSNParser->GetShaderByIndex(ShaderID);
+                             ShaderCI.pShaderSourceStreamFactory = m_pShaderStreamFactory;
+
+                             XXH128State Hasher;
+                             Hasher.Update(ShaderCI);
+                             ShaderHashes[ShaderID] = Hasher.Digest();
+
+                             return ASYNC_TASK_STATUS_COMPLETE;
+                         });
+    }
+    m_pThreadPool->WaitForAllTasks();
+
+    std::vector<XXH128Hash> RenderPassHashes(ParserInfo.RenderPassCount);
+    for (Uint32 RenderPassID = 0; RenderPassID < ParserInfo.RenderPassCount; ++RenderPassID)
+    {
+        const RenderPassDesc& RPDesc = *m_pRSNParser->GetRenderPassByIndex(RenderPassID);
+
+        XXH128State Hasher;
+        UpdateName(Hasher, RPDesc.Name);
+        Hasher.Update(RPDesc);
+        RenderPassHashes[RenderPassID] = Hasher.Digest();
+    }
+
+    std::vector<XXH128Hash> SignatureHashes(ParserInfo.ResourceSignatureCount);
+    for (Uint32 SignatureID = 0; SignatureID < ParserInfo.ResourceSignatureCount; ++SignatureID)
+    {
+        const PipelineResourceSignatureDesc& SignDesc = *m_pRSNParser->GetResourceSignatureByIndex(SignatureID);
+
+        XXH128State Hasher;
+        UpdateName(Hasher, SignDesc.Name);
+        Hasher.Update(SignDesc);
+        SignatureHashes[SignatureID] = Hasher.Digest();
+    }
+
+    auto IsDirty = [this](const std::map<std::string, XXH128Hash>& PrevObjects, const char* Name, const XXH128Hash& Hash) {
+        if (!m_ReusePrevBuild)
+            return true;
+
+        auto it = PrevObjects.find(Name);
+        return it == PrevObjects.end() || !(it->second == Hash);
+    };
+
+    const bool PackSignatures = (m_PSOArchiveFlags & PSO_ARCHIVE_FLAG_DO_NOT_PACK_SIGNATURES) == 0;
+
+    Uint32 NumDirtyPipelines = 0;
+    for (Uint32 PipelineID = 0; PipelineID < ParserInfo.PipelineStateCount; ++PipelineID)
+    {
+        const PipelineStateNotation& DescRSN = *m_pRSNParser->GetPipelineStateByIndex(PipelineID);
+
+        const PipelineDependencies Deps = GetPipelineDependencies(DescRSN);
+
+        // The pipeline hash includes the hashes of all objects it references, so that
+        // the pipeline is rebuilt whenever any of them changes. Missing objects are hashed
+        // by name only, and will be reported when the pipeline is created.
+        XXH128State Hasher;
+        UpdateName(Hasher, DescRSN.PSODesc.Name);
+        Hasher.Update(DescRSN.PSODesc, DescRSN.Flags);
+
+        static_assert(PIPELINE_TYPE_COUNT == 5, "Did you add a new pipeline type? You may need to handle it here.");
+        switch (DescRSN.PSODesc.PipelineType)
+        {
+            case PIPELINE_TYPE_GRAPHICS:
+            case PIPELINE_TYPE_MESH:
+                Hasher.Update(static_cast<const GraphicsPipelineNotation&>(DescRSN).Desc);
+                break;
+
+            case PIPELINE_TYPE_COMPUTE:
+            case PIPELINE_TYPE_TILE:
+                break;
+
+            case PIPELINE_TYPE_RAY_TRACING:
+            {
+                const RayTracingPipelineNotation& PipelineRSN = static_cast<const RayTracingPipelineNotation&>(DescRSN);
+                Hasher.Update(PipelineRSN.RayTracingPipeline, PipelineRSN.MaxAttributeSize, PipelineRSN.MaxPayloadSize);
+                UpdateName(Hasher, PipelineRSN.pShaderRecordName);
+
+                Hasher.Update(PipelineRSN.GeneralShaderCount, PipelineRSN.TriangleHitShaderCount, PipelineRSN.ProceduralHitShaderCount);
+                for (Uint32 i = 0; i < PipelineRSN.GeneralShaderCount; ++i)
+                    UpdateName(Hasher, PipelineRSN.pGeneralShaders[i].Name);
+                for (Uint32 i = 0; i < PipelineRSN.TriangleHitShaderCount; ++i)
+                    UpdateName(Hasher, PipelineRSN.pTriangleHitShaders[i].Name);
+                for (Uint32 i = 0; i < PipelineRSN.ProceduralHitShaderCount; ++i)
+                    UpdateName(Hasher, PipelineRSN.pProceduralHitShaders[i].Name);
+                break;
+            }
+
+            default:
+                UNEXPECTED("Unexpected pipeline type");
+        }
+
+        ProcessPipelineReferences(DescRSN, [&Hasher](ARCHIVE_RESOURCE_TYPE Type, const char* Name) {
+            UpdateName(Hasher, Name);
+        });
+        for (Uint32 SignatureID : Deps.Signatures)
+            UpdateHash(Hasher, SignatureHashes[SignatureID]);
+        for (Uint32 ShaderID : Deps.Shaders)
+            UpdateHash(Hasher, ShaderHashes[ShaderID]);
+        if (Deps.RenderPass != InvalidObjectIndex)
+            UpdateHash(Hasher, RenderPassHashes[Deps.RenderPass]);
+
+        const XXH128Hash Hash = Hasher.Digest();
+        const char*      Name = DescRSN.PSODesc.Name;
+
+        // Render passes and packed signatures are added to the archive together with the pipelines
+        m_Manifest.Pipelines[Name] = Hash;
+        if (Deps.RenderPass != InvalidObjectIndex)
+            m_Manifest.RenderPasses[m_pRSNParser->GetRenderPassByIndex(Deps.RenderPass)->Name] = RenderPassHashes[Deps.RenderPass];
+        if (PackSignatures)
+        {
+            for (Uint32 SignatureID : Deps.Signatures)
+                m_Manifest.Signatures[m_pRSNParser->GetResourceSignatureByIndex(SignatureID)->Name] = SignatureHashes[SignatureID];
+        }
+
+        if (!IsDirty(m_PrevManifest.Pipelines, Name, Hash))
+            continue;
+
+        ++NumDirtyPipelines;
+        Build.Pipelines[PipelineID] = true;
+        m_StaleResources.emplace_back(ARCHIVE_RESOURCE_TYPE_PIPELINE_STATE, Name);
+
+        for (Uint32 ShaderID : Deps.Shaders)
+            Build.Shaders[ShaderID] = true;
+
+        for (Uint32 SignatureID : Deps.Signatures)
+        {
+            Build.Signatures[SignatureID] = true;
+            if (PackSignatures)
+                m_StaleResources.emplace_back(ARCHIVE_RESOURCE_TYPE_RESOURCE_SIGNATURE, m_pRSNParser->GetResourceSignatureByIndex(SignatureID)->Name);
+        }
+
+        if (Deps.RenderPass != InvalidObjectIndex)
+        {
+            Build.RenderPasses[Deps.RenderPass] = true;
+            m_StaleResources.emplace_back(ARCHIVE_RESOURCE_TYPE_RENDER_PASS, m_pRSNParser->GetRenderPassByIndex(Deps.RenderPass)->Name);
+        }
+    }
+
+    Uint32 NumDirtySignatures = 0;
+    for (Uint32 SignatureID = 0; SignatureID < ParserInfo.ResourceSignatureCount; ++SignatureID)
+    {
+        if (!Build.ArchivedSignatures[SignatureID])
+            continue;
+
+        const char* Name                      = m_pRSNParser->GetResourceSignatureByIndex(SignatureID)->Name;
+        m_Manifest.Signatures[Name]           = SignatureHashes[SignatureID];
+        const bool IsSignatureDirty           = IsDirty(m_PrevManifest.Signatures, Name, SignatureHashes[SignatureID]);
+        Build.ArchivedSignatures[SignatureID] = IsSignatureDirty;
+        if (IsSignatureDirty)
+        {
+            ++NumDirtySignatures;
+            Build.Signatures[SignatureID] = true;
+            m_StaleResources.emplace_back(ARCHIVE_RESOURCE_TYPE_RESOURCE_SIGNATURE, Name);
+        }
+    }
+
+    // Remove objects that are no longer produced by the build
+    auto RemoveDeletedObjects = [this](ARCHIVE_RESOURCE_TYPE Type, const std::map<std::string, XXH128Hash>& PrevObjects, const std::map<std::string, XXH128Hash>& Objects) {
+        for (const auto& it : PrevObjects)
+        {
+            if (Objects.find(it.first) == Objects.end())
+                m_StaleResources.emplace_back(Type, it.first);
+        }
+    };
+    if (m_ReusePrevBuild)
+    {
+        RemoveDeletedObjects(ARCHIVE_RESOURCE_TYPE_PIPELINE_STATE, m_PrevManifest.Pipelines, m_Manifest.Pipelines);
+        RemoveDeletedObjects(ARCHIVE_RESOURCE_TYPE_RENDER_PASS, m_PrevManifest.RenderPasses, m_Manifest.RenderPasses);
+        RemoveDeletedObjects(ARCHIVE_RESOURCE_TYPE_RESOURCE_SIGNATURE, m_PrevManifest.Signatures, m_Manifest.Signatures);
+    }
+
+    LOG_INFO_MESSAGE("Incremental build: ", NumDirtyPipelines, " of ", ParserInfo.PipelineStateCount, " pipeline(s) and ",
+                     NumDirtySignatures, " resource signature(s) need to be rebuilt.");
+
+    return Build;
+}
+
+bool RenderStatePackager::MergeWithPreviousBuild(IArchiverFactory* pArchiverFactory,
+                                                 const IDataBlob*  pPrevArchive,
+                                                 const IDataBlob*  pNewArchive,
+                                                 IDataBlob**       ppMergedArchive) const
+{
+    DEV_CHECK_ERR(pArchiverFactory != nullptr, "pArchiverFactory must not be null");
+    DEV_CHECK_ERR(pNewArchive != nullptr, "pNewArchive must not be null");
+    DEV_CHECK_ERR(ppMergedArchive != nullptr && *ppMergedArchive == nullptr, "ppMergedArchive must not be null and must point to null");
+    if (pArchiverFactory == nullptr || pNewArchive == nullptr || ppMergedArchive == nullptr)
+        return false;
+
+    if (!m_ReusePrevBuild || pPrevArchive == nullptr)
+    {
+        // All objects have been rebuilt
+        *ppMergedArchive = const_cast<IDataBlob*>(pNewArchive);
+        (*ppMergedArchive)->AddRef();
+        return true;
+    }
+
+    std::vector<ArchiveResourceInfo> StaleResources;
+    StaleResources.reserve(m_StaleResources.size());
+    for (const auto& Res : m_StaleResources)
+        StaleResources.emplace_back(Res.first, Res.second.c_str());
+
+    RefCntAutoPtr<IDataBlob> pReusedArchive;
+    if (!pArchiverFactory->RemoveResources(pPrevArchive, StaleResources.data(), static_cast<Uint32>(StaleResources.size()), &pReusedArchive))
+    {
+        LOG_ERROR_MESSAGE("Failed to remove stale objects from the previous archive");
+        return false;
+    }
+
+    const IDataBlob* ppArchives[] = {pNewArchive, pReusedArchive};
+    if (!pArchiverFactory->MergeArchives(ppArchives, _countof(ppArchives), ppMergedArchive))
+    {
+        LOG_ERROR_MESSAGE("Failed to merge the new archive with the previous one");
+        return false;
+    }
+
+    return true;
+}
+
 bool RenderStatePackager::Execute(IArchiver* pArchiver, const char* DumpPath)
 {
     DEV_CHECK_ERR(pArchiver != nullptr, "pArchive must not be null");
@@ -223,95 +773,137 @@ bool RenderStatePackager::Execute(IArchiver* pArchiver, const char* DumpPath)
     if (pArchiver == nullptr)
         return false;
 
+    m_ObjectTimings.clear();
+
     try
     {
         const RenderStateNotationParserInfo& ParserInfo = m_pRSNParser->GetInfo();
 
+        IndexObjects();
+
+        const BuildList Build = PrepareIncrementalBuild();
+
         std::vector<RefCntAutoPtr<IShader>>                    Shaders(ParserInfo.ShaderCount);
         std::vector<RefCntAutoPtr<IRenderPass>>                RenderPasses(ParserInfo.RenderPassCount);
         std::vector<RefCntAutoPtr<IPipelineResourceSignature>> ResourceSignatures(ParserInfo.ResourceSignatureCount);
         std::vector<RefCntAutoPtr<IPipelineState>>             Pipelines(ParserInfo.PipelineStateCount);
 
+        // The thread pool only keeps weak references to the prerequisites, so keep the tasks alive until all work is done
+        std::vector<RefCntAutoPtr<IAsyncTask>> ShaderTasks(ParserInfo.ShaderCount);
+        std::vector<RefCntAutoPtr<IAsyncTask>> RenderPassTasks(ParserInfo.RenderPassCount);
+        std::vector<RefCntAutoPtr<IAsyncTask>> SignatureTasks(ParserInfo.ResourceSignatureCount);
+
+        // Every object has its own timing slot, so that the tasks never write to the same memory
+        const Uint32 ShaderTimingOffset     = 0;
+        const Uint32 RenderPassTimingOffset = ShaderTimingOffset + ParserInfo.ShaderCount;
+        const Uint32 SignatureTimingOffset  = RenderPassTimingOffset + ParserInfo.RenderPassCount;
+        const Uint32 PipelineTimingOffset   = SignatureTimingOffset + ParserInfo.ResourceSignatureCount;
+        m_ObjectTimings.resize(PipelineTimingOffset + ParserInfo.PipelineStateCount);
+
+        const Timer ExecutionTimer;
+
         std::atomic<bool> Result{true};
 
         for (Uint32 ShaderID = 0; ShaderID < ParserInfo.ShaderCount; ++ShaderID)
         {
-            EnqueueAsyncWork(m_pThreadPool,
-                             [ShaderID, this, &Result, &Shaders](Uint32 ThreadId) {
-                                 ShaderCreateInfo ShaderCI           = *m_pRSNParser->GetShaderByIndex(ShaderID);
-                                 ShaderCI.pShaderSourceStreamFactory = m_pShaderStreamFactory;
+            if (!Build.Shaders[ShaderID])
+                continue;
 
-                                 RefCntAutoPtr<IShader>& pShader = Shaders[ShaderID];
-                                 m_pDevice->CreateShader(ShaderCI, ShaderArchiveInfo{m_DeviceFlags}, &pShader);
-                                 if (!pShader)
-                                 {
-                                     LOG_ERROR_MESSAGE("Failed to create shader from file '", ShaderCI.FilePath, "'.");
-                                     Result.store(false);
-                                 }
+            ShaderTasks[ShaderID] =
+                EnqueueAsyncWork(m_pThreadPool,
+                                 [&, ShaderID](Uint32 ThreadId) {
+                                     ObjectTiming& Timing = m_ObjectTimings[ShaderTimingOffset + ShaderID];
+                                     Timing.StartTime     = ExecutionTimer.GetElapsedTime();
 
-                                 return ASYNC_TASK_STATUS_COMPLETE;
-                             });
+                                     ShaderCreateInfo ShaderCI           = *m_pRSNParser->GetShaderByIndex(ShaderID);
+                                     ShaderCI.pShaderSourceStreamFactory = m_pShaderStreamFactory;
+
+                                     RefCntAutoPtr<IShader>& pShader = Shaders[ShaderID];
+                                     m_pDevice->CreateShader(ShaderCI, ShaderArchiveInfo{m_DeviceFlags}, &pShader);
+                                     if (!pShader)
+                                     {
+                                         LOG_ERROR_MESSAGE("Failed to create shader from file '", ShaderCI.FilePath, "'.");
+                                         Result.store(false);
+                                     }
+
+                                     Timing.Type    = ARCHIVE_RESOURCE_TYPE_SHADER;
+                                     Timing.Name    = ShaderCI.Desc.Name;
+                                     Timing.EndTime = ExecutionTimer.GetElapsedTime();
+                                     return ASYNC_TASK_STATUS_COMPLETE;
+                                 });
         }
 
         for (Uint32 RenderPassID = 0; RenderPassID < ParserInfo.RenderPassCount; ++RenderPassID)
         {
-            EnqueueAsyncWork(m_pThreadPool,
-                             [RenderPassID, this, &Result, &RenderPasses](Uint32 ThreadId) {
-                                 RenderPassDesc              RPDesc      = *m_pRSNParser->GetRenderPassByIndex(RenderPassID);
-                                 RefCntAutoPtr<IRenderPass>& pRenderPass = RenderPasses[RenderPassID];
-                                 m_pDevice->CreateRenderPass(RPDesc, &pRenderPass);
-                                 if (!pRenderPass)
-                                 {
-                                     LOG_ERROR_MESSAGE("Failed to create render pass '", RPDesc.Name, "'.");
-                                     Result.store(false);
-                                 }
+            if (!Build.RenderPasses[RenderPassID])
+                continue;
+
+            RenderPassTasks[RenderPassID] =
+                EnqueueAsyncWork(m_pThreadPool,
+                                 [&, RenderPassID](Uint32 ThreadId) {
+                                     ObjectTiming& Timing = m_ObjectTimings[RenderPassTimingOffset + RenderPassID];
+                                     Timing.StartTime     = ExecutionTimer.GetElapsedTime();
+
+                                     RenderPassDesc              RPDesc      = *m_pRSNParser->GetRenderPassByIndex(RenderPassID);
+                                     RefCntAutoPtr<IRenderPass>& pRenderPass = RenderPasses[RenderPassID];
+                                     m_pDevice->CreateRenderPass(RPDesc, &pRenderPass);
+                                     if (!pRenderPass)
+                                     {
+                                         LOG_ERROR_MESSAGE("Failed to create render pass '", RPDesc.Name, "'.");
+                                         Result.store(false);
+                                     }
 
-                                 return ASYNC_TASK_STATUS_COMPLETE;
-                             });
+                                     Timing.Type    = ARCHIVE_RESOURCE_TYPE_RENDER_PASS;
+                                     Timing.Name    = RPDesc.Name;
+                                     Timing.EndTime = ExecutionTimer.GetElapsedTime();
+                                     return ASYNC_TASK_STATUS_COMPLETE;
+                                 });
         }
 
         for (Uint32 SignatureID = 0; SignatureID < ParserInfo.ResourceSignatureCount; ++SignatureID)
         {
-            EnqueueAsyncWork(m_pThreadPool,
-                             [&, SignatureID](Uint32 ThreadId) {
-                                 PipelineResourceSignatureDesc              SignDesc   = *m_pRSNParser->GetResourceSignatureByIndex(SignatureID);
-                                 RefCntAutoPtr<IPipelineResourceSignature>& pSignature = ResourceSignatures[SignatureID];
-                                 m_pDevice->CreatePipelineResourceSignature(SignDesc, {m_DeviceFlags}, &pSignature);
-                                 if (!pSignature)
-                                 {
-                                     LOG_ERROR_MESSAGE("Failed to create resource signature '", SignDesc.Name, "'.");
-                                     Result.store(false);
-                                 }
+            if (!Build.Signatures[SignatureID])
+                continue;
+
+            SignatureTasks[SignatureID] =
+                EnqueueAsyncWork(m_pThreadPool,
+                                 [&, SignatureID](Uint32 ThreadId) {
+                                     ObjectTiming& Timing = m_ObjectTimings[SignatureTimingOffset + SignatureID];
+                                     Timing.StartTime     = ExecutionTimer.GetElapsedTime();
+
+                                     PipelineResourceSignatureDesc              SignDesc   = *m_pRSNParser->GetResourceSignatureByIndex(SignatureID);
+                                     RefCntAutoPtr<IPipelineResourceSignature>& pSignature = ResourceSignatures[SignatureID];
+                                     m_pDevice->CreatePipelineResourceSignature(SignDesc, {m_DeviceFlags}, &pSignature);
+                                     if (!pSignature)
+                                     {
+                                         LOG_ERROR_MESSAGE("Failed to create resource signature '", SignDesc.Name, "'.");
+                                         Result.store(false);
+                                     }
+                                     else if (Build.ArchivedSignatures[SignatureID] && !pArchiver->AddPipelineResourceSignature(pSignature))
+                                     {
+                                         LOG_ERROR_MESSAGE("Failed to archive resource signature '", SignDesc.Name, "'.");
+                                         Result.store(false);
+                                     }
 
-                                 return ASYNC_TASK_STATUS_COMPLETE;
-                             });
+                                     Timing.Type    = ARCHIVE_RESOURCE_TYPE_RESOURCE_SIGNATURE;
+                                     Timing.Name    = SignDesc.Name;
+                                     Timing.EndTime = ExecutionTimer.GetElapsedTime();
+                                     return ASYNC_TASK_STATUS_COMPLETE;
+                                 });
         }
 
-        m_pThreadPool->WaitForAllTasks();
-
-        if (!Result.load())
-            LOG_ERROR_AND_THROW("Failed to create state objects");
-
-        for (RefCntAutoPtr<IShader>& pResource : Shaders)
-            m_Shaders.emplace(HashMapStringKey{pResource->GetDesc().Name, false}, pResource);
-
-        for (RefCntAutoPtr<IRenderPass>& pResource : RenderPasses)
-            m_RenderPasses.emplace(HashMapStringKey{pResource->GetDesc().Name, false}, pResource);
-
-        for (RefCntAutoPtr<IPipelineResourceSignature>& pResource : ResourceSignatures)
-            m_ResourceSignatures.emplace(HashMapStringKey{pResource->GetDesc().Name, false}, pResource);
-
+        // Tasks may only access the objects that are listed in their dependencies
         auto FindShader = [&](const char* Name) -> IShader* //
         {
             if (Name == nullptr)
                 return nullptr;
 
-            auto Iter = m_Shaders.find(Name);
-            if (Iter == m_Shaders.end())
+            auto Iter = m_ShaderIndices.find(Name);
+            if (Iter == m_ShaderIndices.end())
             {
                 LOG_ERROR_AND_THROW("Unable to find shader '", Name, "'.");
             }
-            return Iter->second;
+            return Shaders[Iter->second];
         };
 
         auto FindRenderPass = [&](const char* Name) -> IRenderPass* //
@@ -319,12 +911,12 @@ bool RenderStatePackager::Execute(IArchiver* pArchiver, const char* DumpPath)
             if (Name == nullptr)
                 return nullptr;
 
-            auto Iter = m_RenderPasses.find(Name);
-            if (Iter == m_RenderPasses.end())
+            auto Iter = m_RenderPassIndices.find(Name);
+            if (Iter == m_RenderPassIndices.end())
             {
                 LOG_ERROR_AND_THROW("Unable to find render pass '", Name, "'.");
             }
-            return Iter->second;
+            return RenderPasses[Iter->second];
         };
 
         auto FindResourceSignature = [&](const char* Name) -> IPipelineResourceSignature* //
@@ -332,12 +924,12 @@ bool RenderStatePackager::Execute(IArchiver* pArchiver, const char* DumpPath)
             if (Name == nullptr)
                 return nullptr;
 
-            auto Iter = m_ResourceSignatures.find(Name);
-            if (Iter == m_ResourceSignatures.end())
+            auto Iter = m_SignatureIndices.find(Name);
+            if (Iter == m_SignatureIndices.end())
             {
                 LOG_ERROR_AND_THROW("Unable to find resource signature '", Name, "'.");
             }
-            return Iter->second;
+            return ResourceSignatures[Iter->second];
         };
 
         auto UnpackPipelineStateCreateInfo = [&](DynamicLinearAllocator& Allocator, PipelineStateNotation const& DescRSN, PipelineStateCreateInfo& PipelineCI) //
@@ -350,156 +942,273 @@ bool RenderStatePackager::Execute(IArchiver* pArchiver, const char* DumpPath)
                 PipelineCI.ppResourceSignatures[SignatureID] = FindResourceSignature(DescRSN.ppResourceSignatureNames[SignatureID]);
         };
 
+        std::vector<PipelineDependencies> PipelineDeps(ParserInfo.PipelineStateCount);
+
+        std::vector<IAsyncTask*> Prerequisites;
         for (Uint32 PipelineID = 0; PipelineID < ParserInfo.PipelineStateCount; ++PipelineID)
         {
-            EnqueueAsyncWork(m_pThreadPool,
+            if (!Build.Pipelines[PipelineID])
+                continue;
+
+            // Each pipeline only waits for the objects it references rather than for all objects
+            const PipelineDependencies& Deps = PipelineDeps[PipelineID] = GetPipelineDependencies(*m_pRSNParser->GetPipelineStateByIndex(PipelineID));
+
+            Prerequisites.clear();
+            for (Uint32 ShaderID : Deps.Shaders)
+                Prerequisites.push_back(ShaderTasks[ShaderID]);
+            for (Uint32 SignatureID : Deps.Signatures)
+                Prerequisites.push_back(SignatureTasks[SignatureID]);
+            if (Deps.RenderPass != InvalidObjectIndex)
+                Prerequisites.push_back(RenderPassTasks[Deps.RenderPass]);
+            VERIFY(std::find(Prerequisites.begin(), Prerequisites.end(), nullptr) == Prerequisites.end(),
+                   "All dependencies of the pipeline must be scheduled for creation");
+
+            EnqueueAsyncWork(m_pThreadPool, Prerequisites.data(), static_cast<Uint32>(Prerequisites.size()),
                              [&, PipelineID](Uint32 ThreadId) {
-                                 try
-                                 {
-                                     DynamicLinearAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
+                                 const PipelineStateNotation* pDescRSN = m_pRSNParser->GetPipelineStateByIndex(PipelineID);
 
-                                     const PipelineStateArchiveInfo ArchiveInfo{m_PSOArchiveFlags, m_DeviceFlags};
+                                 ObjectTiming& Timing = m_ObjectTimings[PipelineTimingOffset + PipelineID];
+                                 Timing.Type          = ARCHIVE_RESOURCE_TYPE_PIPELINE_STATE;
+                                 Timing.Name          = pDescRSN->PSODesc.Name;
+                                 Timing.StartTime     = ExecutionTimer.GetElapsedTime();
 
-                                     const PipelineStateNotation* pDescRSN = m_pRSNParser->GetPipelineStateByIndex(PipelineID);
+                                 // Dependencies that failed to be created have already been reported
+                                 const PipelineDependencies& Deps = PipelineDeps[PipelineID];
 
-                                     RefCntAutoPtr<IPipelineState>& pPipeline = Pipelines[PipelineID];
+                                 bool DependenciesCreated = Deps.RenderPass == InvalidObjectIndex || RenderPasses[Deps.RenderPass];
+                                 for (Uint32 ShaderID : Deps.Shaders)
+                                     DependenciesCreated = DependenciesCreated && Shaders[ShaderID];
+                                 for (Uint32 SignatureID : Deps.Signatures)
+                                     DependenciesCreated = DependenciesCreated && ResourceSignatures[SignatureID];
 
-                                     const PIPELINE_TYPE PipelineType = pDescRSN->PSODesc.PipelineType;
-                                     switch (PipelineType)
+                                 if (!DependenciesCreated)
+                                 {
+                                     Result.store(false);
+                                 }
+                                 else
+                                 {
+                                     try
                                      {
-                                         case PIPELINE_TYPE_GRAPHICS:
-                                         case PIPELINE_TYPE_MESH:
-                                         {
-                                             const GraphicsPipelineNotation* pPipelineDescRSN = static_cast<const GraphicsPipelineNotation*>(pDescRSN);
-                                             VERIFY_EXPR(pPipelineDescRSN != nullptr);
-
-                                             GraphicsPipelineStateCreateInfo PipelineCI{};
-                                             UnpackPipelineStateCreateInfo(Allocator, *pPipelineDescRSN, PipelineCI);
-                                             PipelineCI.GraphicsPipeline             = static_cast<GraphicsPipelineDesc>(pPipelineDescRSN->Desc);
-                                             PipelineCI.GraphicsPipeline.pRenderPass = FindRenderPass(pPipelineDescRSN->pRenderPassName);
-
-                                             PipelineCI.pVS = FindShader(pPipelineDescRSN->pVSName);
-                                             PipelineCI.pPS = FindShader(pPipelineDescRSN->pPSName);
-                                             PipelineCI.pDS = FindShader(pPipelineDescRSN->pDSName);
-                                             PipelineCI.pHS = FindShader(pPipelineDescRSN->pHSName);
-                                             PipelineCI.pGS = FindShader(pPipelineDescRSN->pGSName);
-                                             PipelineCI.pAS = FindShader(pPipelineDescRSN->pASName);
-                                             PipelineCI.pMS = FindShader(pPipelineDescRSN->pMSName);
-
-                                             m_pDevice->CreateGraphicsPipelineState(PipelineCI, ArchiveInfo, &pPipeline);
-                                             break;
-                                         }
-                                         case PIPELINE_TYPE_COMPUTE:
-                                         {
-                                             const ComputePipelineNotation* pPipelineDescRSN = static_cast<const ComputePipelineNotation*>(pDescRSN);
-
-                                             ComputePipelineStateCreateInfo PipelineCI{};
-                                             UnpackPipelineStateCreateInfo(Allocator, *pPipelineDescRSN, PipelineCI);
-                                             PipelineCI.pCS = FindShader(pPipelineDescRSN->pCSName);
+                                         DynamicLinearAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
 
-                                             m_pDevice->CreateComputePipelineState(PipelineCI, ArchiveInfo, &pPipeline);
-                                             break;
-                                         }
-                                         case PIPELINE_TYPE_TILE:
-                                         {
-                                             const TilePipelineNotation* pPipelineDescRSN = static_cast<const TilePipelineNotation*>(pDescRSN);
+                                         const PipelineStateArchiveInfo ArchiveInfo{m_PSOArchiveFlags, m_DeviceFlags};
 
-                                             TilePipelineStateCreateInfo PipelineCI{};
-                                             UnpackPipelineStateCreateInfo(Allocator, *pPipelineDescRSN, PipelineCI);
-                                             PipelineCI.pTS = FindShader(pPipelineDescRSN->pTSName);
+                                         RefCntAutoPtr<IPipelineState>& pPipeline = Pipelines[PipelineID];
 
-                                             m_pDevice->CreateTilePipelineState(PipelineCI, ArchiveInfo, &pPipeline);
-                                             break;
-                                         }
-                                         case PIPELINE_TYPE_RAY_TRACING:
+                                         const PIPELINE_TYPE PipelineType = pDescRSN->PSODesc.PipelineType;
+                                         switch (PipelineType)
                                          {
-                                             const RayTracingPipelineNotation* pPipelineDescRSN = static_cast<const RayTracingPipelineNotation*>(pDescRSN);
+                                             case PIPELINE_TYPE_GRAPHICS:
+                                             case PIPELINE_TYPE_MESH:
+                                             {
+                                                 const GraphicsPipelineNotation* pPipelineDescRSN = static_cast<const GraphicsPipelineNotation*>(pDescRSN);
+                                                 VERIFY_EXPR(pPipelineDescRSN != nullptr);
+
+                                                 GraphicsPipelineStateCreateInfo PipelineCI{};
+                                                 UnpackPipelineStateCreateInfo(Allocator, *pPipelineDescRSN, PipelineCI);
+                                                 PipelineCI.GraphicsPipeline             = static_cast<GraphicsPipelineDesc>(pPipelineDescRSN->Desc);
+                                                 PipelineCI.GraphicsPipeline.pRenderPass = FindRenderPass(pPipelineDescRSN->pRenderPassName);
+
+                                                 PipelineCI.pVS = FindShader(pPipelineDescRSN->pVSName);
+                                                 PipelineCI.pPS = FindShader(pPipelineDescRSN->pPSName);
+                                                 PipelineCI.pDS = FindShader(pPipelineDescRSN->pDSName);
+                                                 PipelineCI.pHS = FindShader(pPipelineDescRSN->pHSName);
+                                                 PipelineCI.pGS = FindShader(pPipelineDescRSN->pGSName);
+                                                 PipelineCI.pAS = FindShader(pPipelineDescRSN->pASName);
+                                                 PipelineCI.pMS = FindShader(pPipelineDescRSN->pMSName);
+
+                                                 m_pDevice->CreateGraphicsPipelineState(PipelineCI, ArchiveInfo, &pPipeline);
+                                                 break;
+                                             }
+                                             case PIPELINE_TYPE_COMPUTE:
+                                             {
+                                                 const ComputePipelineNotation* pPipelineDescRSN = static_cast<const ComputePipelineNotation*>(pDescRSN);
 
-                                             RayTracingPipelineStateCreateInfo PipelineCI{};
-                                             UnpackPipelineStateCreateInfo(Allocator, *pPipelineDescRSN, PipelineCI);
-                                             PipelineCI.RayTracingPipeline = pPipelineDescRSN->RayTracingPipeline;
-                                             PipelineCI.pShaderRecordName  = pPipelineDescRSN->pShaderRecordName;
-                                             PipelineCI.MaxAttributeSize   = pPipelineDescRSN->MaxAttributeSize;
-                                             PipelineCI.MaxPayloadSize     = pPipelineDescRSN->MaxPayloadSize;
+                                                 ComputePipelineStateCreateInfo PipelineCI{};
+                                                 UnpackPipelineStateCreateInfo(Allocator, *pPipelineDescRSN, PipelineCI);
+                                                 PipelineCI.pCS = FindShader(pPipelineDescRSN->pCSName);
 
+                                                 m_pDevice->CreateComputePipelineState(PipelineCI, ArchiveInfo, &pPipeline);
+                                                 break;
+                                             }
+                                             case PIPELINE_TYPE_TILE:
                                              {
-                                                 RayTracingGeneralShaderGroup* pData = Allocator.ConstructArray<RayTracingGeneralShaderGroup>(pPipelineDescRSN->GeneralShaderCount);
+                                                 const TilePipelineNotation* pPipelineDescRSN = static_cast<const TilePipelineNotation*>(pDescRSN);
 
-                                                 for (Uint32 ShaderID = 0; ShaderID < pPipelineDescRSN->GeneralShaderCount; ShaderID++)
-                                                 {
-                                                     pData[ShaderID].Name    = pPipelineDescRSN->pGeneralShaders[ShaderID].Name;
-                                                     pData[ShaderID].pShader = FindShader(pPipelineDescRSN->pGeneralShaders[ShaderID].pShaderName);
-                                                 }
+                                                 TilePipelineStateCreateInfo PipelineCI{};
+                                                 UnpackPipelineStateCreateInfo(Allocator, *pPipelineDescRSN, PipelineCI);
+                                                 PipelineCI.pTS = FindShader(pPipelineDescRSN->pTSName);
 
-                                                 PipelineCI.pGeneralShaders    = pData;
-                                                 PipelineCI.GeneralShaderCount = pPipelineDescRSN->GeneralShaderCount;
+                                                 m_pDevice->CreateTilePipelineState(PipelineCI, ArchiveInfo, &pPipeline);
+                                                 break;
                                              }
-
+                                             case PIPELINE_TYPE_RAY_TRACING:
                                              {
-                                                 RayTracingTriangleHitShaderGroup* pData = Allocator.ConstructArray<RayTracingTriangleHitShaderGroup>(pPipelineDescRSN->TriangleHitShaderCount);
+                                                 const RayTracingPipelineNotation* pPipelineDescRSN = static_cast<const RayTracingPipelineNotation*>(pDescRSN);
+
+                                                 RayTracingPipelineStateCreateInfo PipelineCI{};
+                                                 UnpackPipelineStateCreateInfo(Allocator, *pPipelineDescRSN, PipelineCI);
+                                                 PipelineCI.RayTracingPipeline = pPipelineDescRSN->RayTracingPipeline;
+                                                 PipelineCI.pShaderRecordName  = pPipelineDescRSN->pShaderRecordName;
+                                                 PipelineCI.MaxAttributeSize   = pPipelineDescRSN->MaxAttributeSize;
+                                                 PipelineCI.MaxPayloadSize     = pPipelineDescRSN->MaxPayloadSize;
 
-                                                 for (Uint32 ShaderID = 0; ShaderID < pPipelineDescRSN->TriangleHitShaderCount; ++ShaderID)
                                                  {
-                                                     pData[ShaderID].Name              = pPipelineDescRSN->pTriangleHitShaders[ShaderID].Name;
-                                                     pData[ShaderID].pAnyHitShader     = FindShader(pPipelineDescRSN->pTriangleHitShaders[ShaderID].pAnyHitShaderName);
-                                                     pData[ShaderID].pClosestHitShader = FindShader(pPipelineDescRSN->pTriangleHitShaders[ShaderID].pClosestHitShaderName);
+                                                     RayTracingGeneralShaderGroup* pData = Allocator.ConstructArray<RayTracingGeneralShaderGroup>(pPipelineDescRSN->GeneralShaderCount);
+
+                                                     for (Uint32 ShaderID = 0; ShaderID < pPipelineDescRSN->GeneralShaderCount; ShaderID++)
+                                                     {
+                                                         pData[ShaderID].Name    = pPipelineDescRSN->pGeneralShaders[ShaderID].Name;
+                                                         pData[ShaderID].pShader = FindShader(pPipelineDescRSN->pGeneralShaders[ShaderID].pShaderName);
+                                                     }
+
+                                                     PipelineCI.pGeneralShaders    = pData;
+                                                     PipelineCI.GeneralShaderCount = pPipelineDescRSN->GeneralShaderCount;
                                                  }
 
-                                                 PipelineCI.pTriangleHitShaders    = pData;
-                                                 PipelineCI.TriangleHitShaderCount = pPipelineDescRSN->TriangleHitShaderCount;
-                                             }
+                                                 {
+                                                     RayTracingTriangleHitShaderGroup* pData = Allocator.ConstructArray<RayTracingTriangleHitShaderGroup>(pPipelineDescRSN->TriangleHitShaderCount);
 
-                                             {
-                                                 RayTracingProceduralHitShaderGroup* pData = Allocator.ConstructArray<RayTracingProceduralHitShaderGroup>(pPipelineDescRSN->ProceduralHitShaderCount);
+                                                     for (Uint32 ShaderID = 0; ShaderID < pPipelineDescRSN->TriangleHitShaderCount; ++ShaderID)
+                                                     {
+                                                         pData[ShaderID].Name              = pPipelineDescRSN->pTriangleHitShaders[ShaderID].Name;
+                                                         pData[ShaderID].pAnyHitShader     = FindShader(pPipelineDescRSN->pTriangleHitShaders[ShaderID].pAnyHitShaderName);
+                                                         pData[ShaderID].pClosestHitShader = FindShader(pPipelineDescRSN->pTriangleHitShaders[ShaderID].pClosestHitShaderName);
+                                                     }
+
+                                                     PipelineCI.pTriangleHitShaders    = pData;
+                                                     PipelineCI.TriangleHitShaderCount = pPipelineDescRSN->TriangleHitShaderCount;
+                                                 }
 
-                                                 for (Uint32 ShaderID = 0; ShaderID < pPipelineDescRSN->ProceduralHitShaderCount; ++ShaderID)
                                                  {
-                                                     pData[ShaderID].Name                = pPipelineDescRSN->pProceduralHitShaders[ShaderID].Name;
-                                                     pData[ShaderID].pAnyHitShader       = FindShader(pPipelineDescRSN->pProceduralHitShaders[ShaderID].pAnyHitShaderName);
-                                                     pData[ShaderID].pIntersectionShader = FindShader(pPipelineDescRSN->pProceduralHitShaders[ShaderID].pClosestHitShaderName);
-                                                     pData[ShaderID].pClosestHitShader   = FindShader(pPipelineDescRSN->pProceduralHitShaders[ShaderID].pClosestHitShaderName);
+                                                     RayTracingProceduralHitShaderGroup* pData = Allocator.ConstructArray<RayTracingProceduralHitShaderGroup>(pPipelineDescRSN->ProceduralHitShaderCount);
+
+                                                     for (Uint32 ShaderID = 0; ShaderID < pPipelineDescRSN->ProceduralHitShaderCount; ++ShaderID)
+                                                     {
+                                                         pData[ShaderID].Name                = pPipelineDescRSN->pProceduralHitShaders[ShaderID].Name;
+                                                         pData[ShaderID].pAnyHitShader       = FindShader(pPipelineDescRSN->pProceduralHitShaders[ShaderID].pAnyHitShaderName);
+                                                         pData[ShaderID].pIntersectionShader = FindShader(pPipelineDescRSN->pProceduralHitShaders[ShaderID].pIntersectionShaderName);
+                                                         pData[ShaderID].pClosestHitShader   = FindShader(pPipelineDescRSN->pProceduralHitShaders[ShaderID].pClosestHitShaderName);
+                                                     }
+
+                                                     PipelineCI.pProceduralHitShaders    = pData;
+                                                     PipelineCI.ProceduralHitShaderCount = pPipelineDescRSN->ProceduralHitShaderCount;
                                                  }
 
-                                                 PipelineCI.pProceduralHitShaders    = pData;
-                                                 PipelineCI.ProceduralHitShaderCount = pPipelineDescRSN->ProceduralHitShaderCount;
+                                                 m_pDevice->CreateRayTracingPipelineState(PipelineCI, ArchiveInfo, &pPipeline);
+                                                 break;
                                              }
-
-                                             m_pDevice->CreateRayTracingPipelineState(PipelineCI, ArchiveInfo, &pPipeline);
-                                             break;
+                                             default:
+                                                 break;
                                          }
-                                         default:
-                                             break;
-                                     }
 
-                                     if (!pPipeline)
-                                         LOG_ERROR_AND_THROW("Failed to create pipeline '", pDescRSN->PSODesc.Name, "'.");
-                                 }
-                                 catch (...)
-                                 {
-                                     Result.store(false);
+                                         if (!pPipeline)
+                                             LOG_ERROR_AND_THROW("Failed to create pipeline '", pDescRSN->PSODesc.Name, "'.");
+
+                                         // Archive the pipeline while other objects are still being created
+                                         if (!pArchiver->AddPipelineState(pPipeline))
+                                             LOG_ERROR_AND_THROW("Failed to archive pipeline '", pDescRSN->PSODesc.Name, "'.");
+                                     }
+                                     catch (...)
+                                     {
+                                         Result.store(false);
+                                     }
                                  }
 
+                                 Timing.EndTime = ExecutionTimer.GetElapsedTime();
                                  return ASYNC_TASK_STATUS_COMPLETE;
                              });
         }
 
         m_pThreadPool->WaitForAllTasks();
-        if (!Result.load())
-            LOG_ERROR_AND_THROW("Failed to create state objects");
 
-        for (RefCntAutoPtr<IPipelineResourceSignature>& pSignature : ResourceSignatures)
+        const double TotalTime = ExecutionTimer.GetElapsedTime();
+
+        // Find the longest dependency chain before the timings of the objects that were not created are removed.
+        // Every pipeline waits for all of its shaders, resource signatures and render pass, so the length of
+        // the chain that ends with the pipeline is the pipeline duration plus the duration of its slowest
+        // dependency of any type. Objects reused from the previous build are not created and take no time.
+        auto GetDuration = [](const ObjectTiming& Timing) {
+            return Timing.Type != ARCHIVE_RESOURCE_TYPE_UNDEFINED ? Timing.EndTime - Timing.StartTime : 0.0;
+        };
+
+        const ObjectTiming* pCriticalPipeline   = nullptr;
+        const ObjectTiming* pCriticalDependency = nullptr;
+        double              CriticalPathTime    = 0;
+        for (Uint32 PipelineID = 0; PipelineID < ParserInfo.PipelineStateCount; ++PipelineID)
         {
-            const char* SignName = pSignature->GetDesc().Name;
-            if (!m_pRSNParser->IsSignatureIgnored(SignName))
+            if (!Build.Pipelines[PipelineID])
+                continue;
+
+            const PipelineDependencies& Deps = PipelineDeps[PipelineID];
+
+            const ObjectTiming* pDependency      = nullptr;
+            auto                UpdateDependency = [&](const ObjectTiming& DepTiming) {
+                if (DepTiming.Type != ARCHIVE_RESOURCE_TYPE_UNDEFINED && (pDependency == nullptr || GetDuration(DepTiming) > GetDuration(*pDependency)))
+                    pDependency = &DepTiming;
+            };
+            for (Uint32 ShaderID : Deps.Shaders)
+                UpdateDependency(m_ObjectTimings[ShaderTimingOffset + ShaderID]);
+            for (Uint32 SignatureID : Deps.Signatures)
+                UpdateDependency(m_ObjectTimings[SignatureTimingOffset + SignatureID]);
+            if (Deps.RenderPass != InvalidObjectIndex)
+                UpdateDependency(m_ObjectTimings[RenderPassTimingOffset + Deps.RenderPass]);
+
+            const ObjectTiming& Timing   = m_ObjectTimings[PipelineTimingOffset + PipelineID];
+            const double        PathTime = GetDuration(Timing) + (pDependency != nullptr ? GetDuration(*pDependency) : 0.0);
+            if (pCriticalPipeline == nullptr || PathTime > CriticalPathTime)
             {
-                if (!pArchiver->AddPipelineResourceSignature(pSignature))
-                    LOG_ERROR_AND_THROW("Failed to archive resource signature '", SignName, "'.");
+                pCriticalPipeline   = &Timing;
+                pCriticalDependency = pDependency;
+                CriticalPathTime    = PathTime;
             }
         }
 
-        for (RefCntAutoPtr<IPipelineState>& pPipeline : Pipelines)
-            if (!pArchiver->AddPipelineState(pPipeline))
-                LOG_ERROR_AND_THROW("Failed to archive pipeline '", pPipeline->GetDesc().Name, "'.");
+        if (pCriticalPipeline != nullptr)
+        {
+            std::stringstream Stream;
+            Stream << "Critical path (" << FormatTime(CriticalPathTime) << "): ";
+            if (pCriticalDependency != nullptr)
+            {
+                Stream << GetObjectTypeString(pCriticalDependency->Type) << " '" << pCriticalDependency->Name << "' ("
+                       << FormatTime(GetDuration(*pCriticalDependency)) << ") -> ";
+            }
+            Stream << "pipeline '" << pCriticalPipeline->Name << "' (" << FormatTime(GetDuration(*pCriticalPipeline)) << ")";
+            LOG_INFO_MESSAGE(Stream.str());
+        }
+
+        m_ObjectTimings.erase(std::remove_if(m_ObjectTimings.begin(), m_ObjectTimings.end(), [](const ObjectTiming& Timing) { return Timing.Type == ARCHIVE_RESOURCE_TYPE_UNDEFINED; }), m_ObjectTimings.end());
+
+        {
+            std::vector<const ObjectTiming*> SlowestObjects;
+            SlowestObjects.reserve(m_ObjectTimings.size());
+            for (const ObjectTiming& Timing : m_ObjectTimings)
+                SlowestObjects.push_back(&Timing);
+
+            constexpr size_t MaxReportedObjects = 5;
+
+            const size_t NumReportedObjects = std::min(SlowestObjects.size(), MaxReportedObjects);
+            std::partial_sort(SlowestObjects.begin(), SlowestObjects.begin() + NumReportedObjects, SlowestObjects.end(),
+                              [](const ObjectTiming* pLHS, const ObjectTiming* pRHS) {
+                                  return (pLHS->EndTime - pLHS->StartTime) > (pRHS->EndTime - pRHS->StartTime);
+                              });
+
+            std::stringstream Stream;
+            Stream << "Created " << m_ObjectTimings.size() << " object(s) in " << FormatTime(TotalTime) << '.';
+            for (size_t i = 0; i < NumReportedObjects; ++i)
+            {
+                const ObjectTiming& Timing = *SlowestObjects[i];
+                Stream << (i == 0 ? " Slowest: " : ", ") << GetObjectTypeString(Timing.Type) << " '" << Timing.Name << "' ("
+                       << FormatTime(Timing.EndTime - Timing.StartTime) << ')';
+            }
+            LOG_INFO_MESSAGE(Stream.str());
+        }
+
+        if (!Result.load())
+            LOG_ERROR_AND_THROW("Failed to create state objects");
+
+        // Skip pipelines that are reused from the previous build
+        Pipelines.erase(std::remove_if(Pipelines.begin(), Pipelines.end(), [](const RefCntAutoPtr<IPipelineState>& pPipeline) { return !pPipeline; }), Pipelines.end());
 
         if (DumpPath != nullptr && !BytecodeDumper::Execute(Pipelines, m_DeviceFlags, DumpPath))
             LOG_ERROR_MESSAGE("Failed to dump shader bytecode");
@@ -513,10 +1222,18 @@ bool RenderStatePackager::Execute(IArchiver* pArchiver, const char* DumpPath)
 
 void RenderStatePackager::Reset()
 {
+    m_ShaderIndices.clear();
+    m_RenderPassIndices.clear();
+    m_SignatureIndices.clear();
     m_pRSNParser.Release();
-    m_RenderPasses.clear();
-    m_Shaders.clear();
-    m_ResourceSignatures.clear();
+
+    m_IncrementalBuild = false;
+    m_HasPrevManifest  = false;
+    m_ReusePrevBuild   = false;
+    m_PrevManifest     = {};
+    m_Manifest         = {};
+    m_StaleResources.clear();
+    m_ObjectTimings.clear();
 }
 
 } // namespace Diligent
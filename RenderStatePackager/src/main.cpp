@@ -25,6 +25,8 @@
  */
 
 #include "FileWrapper.hpp"
+#include "FileSystem.hpp"
+#include "DataBlobImpl.hpp"
 #include "RenderStateNotationParser.h"
 #include "ParsingEnvironment.hpp"
 #include "args.hxx"
@@ -65,6 +67,7 @@ ParseStatus ParseCommandLine(int argc, char* argv[], ParsingEnvironmentCreateInf
     args::Group ArchiveDeviceFlags{Parser, "Archive Flags:", args::Group::Validators::DontCare};
     args::Flag  ArgumentArchiveFlagStrip{ArchiveDeviceFlags, "strip_reflection", "Strip shader reflection", {"strip_reflection"}};
     args::Flag  ArgumentArchiveFlagPrint{ArchiveDeviceFlags, "print_contents", "Print the archive contents", {"print_contents"}};
+    args::Flag  ArgumentIncremental{ArchiveDeviceFlags, "incremental", "Only rebuild objects that changed since the previous build", {"incremental"}};
 
     try
     {
@@ -115,6 +118,7 @@ ParseStatus ParseCommandLine(int argc, char* argv[], ParsingEnvironmentCreateInf
     CreateInfo.PSOArchiveFlags |= PSO_ARCHIVE_FLAG_DO_NOT_PACK_SIGNATURES;
 
     CreateInfo.PrintArchiveContents = args::get(ArgumentArchiveFlagPrint);
+    CreateInfo.IncrementalBuild     = args::get(ArgumentIncremental);
     CreateInfo.ShaderDirs           = args::get(ArgumentShaderDirs);
     CreateInfo.RenderStateDirs      = args::get(ArgumentRenderStateDirs);
     CreateInfo.ConfigFilePath       = args::get(ArgumentDeviceConfig);
@@ -127,6 +131,34 @@ ParseStatus ParseCommandLine(int argc, char* argv[], ParsingEnvironmentCreateInf
     return ParseStatus::Success;
 }
 
+RefCntAutoPtr<IDataBlob> ReadFile(const std::string& FilePath)
+{
+    if (!FileSystem::FileExists(FilePath.c_str()))
+        return {};
+
+    FileWrapper File{FilePath.c_str(), EFileAccessMode::Read};
+    if (!File)
+        return {};
+
+    RefCntAutoPtr<DataBlobImpl> pData = DataBlobImpl::Create();
+    if (!File->Read(pData))
+        return {};
+
+    return RefCntAutoPtr<IDataBlob>{pData};
+}
+
+bool WriteFile(const std::string& FilePath, const IDataBlob* pData)
+{
+    FileWrapper File{FilePath.c_str(), EFileAccessMode::Overwrite};
+    if (!File)
+    {
+        LOG_FATAL_ERROR("Failed to open file: '", FilePath, "'.");
+        return false;
+    }
+
+    return File->Write(pData->GetConstDataPtr(), pData->GetSize());
+}
+
 int main(int argc, char* argv[])
 {
     ParsingEnvironmentCreateInfo EnvironmentCI{};
@@ -168,6 +200,24 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
 
+    // The manifest of an incremental build is stored next to the archive
+    const std::string        ManifestFilePath = OutputFilePath + ".manifest";
+    RefCntAutoPtr<IDataBlob> pPrevArchive;
+    if (EnvironmentCI.IncrementalBuild)
+    {
+        pPrevArchive = ReadFile(OutputFilePath);
+
+        // Both the archive and its manifest are required to reuse the previous build.
+        // The manifest stores the archive hash, so it is ignored if the archive was replaced.
+        RefCntAutoPtr<IDataBlob> pPrevManifest = pPrevArchive ? ReadFile(ManifestFilePath) : RefCntAutoPtr<IDataBlob>{};
+        Packager.EnableIncrementalBuild(pPrevManifest, pPrevArchive);
+    }
+    else if (FileSystem::FileExists(ManifestFilePath.c_str()))
+    {
+        // The manifest left by a previous incremental build no longer describes the archive
+        FileSystem::DeleteFile(ManifestFilePath.c_str());
+    }
+
     if (!Packager.Execute(pArchiver, EnvironmentCI.DumpBytecodeDir.empty() ? nullptr : EnvironmentCI.DumpBytecodeDir.c_str()))
     {
         LOG_FATAL_ERROR("Failed to create the archive");
@@ -181,17 +231,26 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
 
+    if (EnvironmentCI.IncrementalBuild)
+    {
+        RefCntAutoPtr<IDataBlob> pMergedData;
+        if (!Packager.MergeWithPreviousBuild(pArchiveFactory, pPrevArchive, pData, &pMergedData))
+        {
+            LOG_FATAL_ERROR("Failed to merge the archive with the previous build");
+            return EXIT_FAILURE;
+        }
+        pData = std::move(pMergedData);
+    }
+
     if (EnvironmentCI.PrintArchiveContents)
     {
         pArchiveFactory->PrintArchiveContent(pData);
     }
 
-    FileWrapper File{OutputFilePath.c_str(), EFileAccessMode::Overwrite};
-    if (!File)
-    {
-        LOG_FATAL_ERROR("Failed to open file: '", OutputFilePath, "'.");
+    if (!WriteFile(OutputFilePath, pData))
         return EXIT_FAILURE;
-    }
 
-    File->Write(pData->GetDataPtr(), pData->GetSize());
+    // Write the manifest after the archive so that an interrupted build is never reused
+    if (EnvironmentCI.IncrementalBuild && !WriteFile(ManifestFilePath, Packager.GetBuildManifest(pData)))
+        return EXIT_FAILURE;
 }
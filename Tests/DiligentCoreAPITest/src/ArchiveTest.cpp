@@ -763,7 +763,9 @@ void RenderGraphicsPSOTestImage(IDeviceContext*         pContext,
     pContext->EndRenderPass();
 }
 
-void TestGraphicsPipeline(PSO_ARCHIVE_FLAGS ArchiveFlags, bool CompileAsync = false)
+void TestGraphicsPipeline(PSO_ARCHIVE_FLAGS          ArchiveFlags,
+                          bool                       CompileAsync = false,
+                          ARCHIVE_SHADER_COMPRESSION Compression  = ARCHIVE_SHADER_COMPRESSION_NONE)
 {
     GPUTestingEnvironment* pEnv             = GPUTestingEnvironment::GetInstance();
     IRenderDevice*         pDevice          = pEnv->GetDevice();
@@ -855,6 +857,8 @@ void TestGraphicsPipeline(PSO_ARCHIVE_FLAGS ArchiveFlags, bool CompileAsync = fa
         RefCntAutoPtr<IArchiver> pArchiver;
         pArchiverFactory->CreateArchiver(pSerializationDevice, &pArchiver);
         ASSERT_NE(pArchiver, nullptr);
+        // Use small blocks so that the shaders of one pipeline are stored in different blocks
+        pArchiver->SetShaderCompression(Compression, 256);
 
         ShaderCreateInfo VertexShaderCI;
         ShaderCreateInfo PixelShaderCI;
@@ -1211,6 +1215,16 @@ TEST(ArchiveTest, GraphicsPipeline_Async)
     TestGraphicsPipeline(PSO_ARCHIVE_FLAG_NONE, /*CompileAsync = */ true);
 }
 
+TEST(ArchiveTest, GraphicsPipeline_LZ4)
+{
+    TestGraphicsPipeline(PSO_ARCHIVE_FLAG_NONE, /*CompileAsync = */ false, ARCHIVE_SHADER_COMPRESSION_LZ4);
+}
+
+TEST(ArchiveTest, GraphicsPipeline_LZ4_Async)
+{
+    TestGraphicsPipeline(PSO_ARCHIVE_FLAG_NONE, /*CompileAsync = */ true, ARCHIVE_SHADER_COMPRESSION_LZ4);
+}
+
 void ArchiveGraphicsShaders(bool CompileAsync)
 {
     GPUTestingEnvironment* pEnv             = GPUTestingEnvironment::GetInstance();
@@ -1264,6 +1278,21 @@ void ArchiveGraphicsShaders(bool CompileAsync)
     ASSERT_NE(pArchive, nullptr);
     EXPECT_TRUE(pArchiverFactory->PrintArchiveContent(pArchive));
 
+    // The archive must not depend on the order in which the objects are added
+    {
+        RefCntAutoPtr<IArchiver> pArchiver2;
+        pArchiverFactory->CreateArchiver(pSerializationDevice, &pArchiver2);
+        ASSERT_NE(pArchiver2, nullptr);
+        EXPECT_TRUE(pArchiver2->AddShader(pSerializedPS2));
+        EXPECT_TRUE(pArchiver2->AddShader(pSerializedVS2));
+
+        RefCntAutoPtr<IDataBlob> pArchive2;
+        pArchiver2->SerializeToBlob(ContentVersion, &pArchive2);
+        ASSERT_NE(pArchive2, nullptr);
+        ASSERT_EQ(pArchive2->GetSize(), pArchive->GetSize());
+        EXPECT_EQ(memcmp(pArchive2->GetConstDataPtr(), pArchive->GetConstDataPtr(), pArchive->GetSize()), 0);
+    }
+
     pDearchiver->LoadArchive(pArchive, ContentVersion);
 
     auto UnpackShader = [](IRenderDevice* pDevice, IDearchiver* pDearchiver, const ShaderCreateInfo& CI) {
@@ -2769,6 +2798,30 @@ TEST(ArchiveTest, MergeArchives)
         ASSERT_NE(pUnpackedPSO, nullptr);
         EXPECT_EQ(pUnpackedPSO->GetDesc(), PSOCreateInfo.PSODesc);
     }
+
+    {
+        // Remove the pipeline, its render pass and the compute shader.
+        // Shaders that are only used by the pipeline must be released.
+        const ArchiveResourceInfo Resources[] =
+            {
+                {ARCHIVE_RESOURCE_TYPE_PIPELINE_STATE, PSOName},
+                {ARCHIVE_RESOURCE_TYPE_RENDER_PASS, RPName},
+                {ARCHIVE_RESOURCE_TYPE_SHADER, CsCI.Desc.Name},
+            };
+        RefCntAutoPtr<IDataBlob> pFilteredArchive;
+        EXPECT_TRUE(pArchiverFactory->RemoveResources(pArchive, Resources, _countof(Resources), &pFilteredArchive));
+        ASSERT_NE(pFilteredArchive, nullptr);
+        EXPECT_LT(pFilteredArchive->GetSize(), pArchive->GetSize());
+        EXPECT_TRUE(pArchiverFactory->PrintArchiveContent(pFilteredArchive));
+
+        RefCntAutoPtr<IDearchiver> pFilteredDearchiver;
+        pDevice->GetEngineFactory()->CreateDearchiver(DearchiverCI, &pFilteredDearchiver);
+        ASSERT_NE(pFilteredDearchiver, nullptr);
+        pFilteredDearchiver->LoadArchive(pFilteredArchive, ContentVersion);
+
+        UnpackShader(pDevice, pFilteredDearchiver, VsCI);
+        UnpackShader(pDevice, pFilteredDearchiver, PsCI);
+    }
 }
 
 } // namespace
@@ -35,6 +35,8 @@
 #include "MapHelper.hpp"
 #include "FastRand.hpp"
 #include "ThreadSignal.hpp"
+#include "ThreadPool.hpp"
+#include "ParallelCommandRecorder.hpp"
 
 #include "gtest/gtest.h"
 
@@ -2467,6 +2469,230 @@ TEST_F(DrawCommandTest, DeferredContexts)
     Present();
 }
 
+TEST_F(DrawCommandTest, ParallelCommandRecorder)
+{
+    auto* pEnv = GPUTestingEnvironment::GetInstance();
+    if (pEnv->GetNumDeferredContexts() == 0)
+    {
+        GTEST_SKIP() << "Deferred contexts are not supported by this device";
+    }
+    if (pEnv->GetDevice()->GetDeviceInfo().IsMetalDevice())
+    {
+        GTEST_SKIP() << "In Metal backend, FinishFrame must be called from the thread that recorded the commands";
+    }
+
+    auto* pSwapChain    = pEnv->GetSwapChain();
+    auto* pImmediateCtx = pEnv->GetDeviceContext();
+
+    const float ClearColor[] = {sm_Rnd(), sm_Rnd(), sm_Rnd(), sm_Rnd()};
+    RenderDrawCommandReference(pSwapChain, ClearColor);
+
+    const Uint32 Indices[] = {0, 1, 2, 3, 4, 5};
+    auto         pVB       = CreateVertexBuffer(Vert, sizeof(Vert));
+    auto         pIB       = CreateIndexBuffer(Indices, _countof(Indices));
+
+    StateTransitionDesc Barriers[] = //
+        {
+            {pVB, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE},
+            {pIB, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_INDEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE} //
+        };
+    pImmediateCtx->TransitionResourceStates(_countof(Barriers), Barriers);
+
+    ITextureView* pRTVs[] = {pSwapChain->GetCurrentBackBufferRTV()};
+    pImmediateCtx->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pImmediateCtx->ClearRenderTarget(pRTVs[0], ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    std::vector<IDeviceContext*> DeferredCtxs(pEnv->GetNumDeferredContexts());
+    for (Uint32 i = 0; i < DeferredCtxs.size(); ++i)
+        DeferredCtxs[i] = pEnv->GetDeferredContext(i);
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{2});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    ParallelCommandRecorder::CreateInfo RecorderCI;
+    RecorderCI.ppDeferredContexts  = DeferredCtxs.data();
+    RecorderCI.NumDeferredContexts = static_cast<Uint32>(DeferredCtxs.size());
+    RecorderCI.pThreadPool         = pThreadPool;
+    ParallelCommandRecorder Recorder{RecorderCI};
+
+    ParallelCommandRecorder::RecordAttribs Attribs;
+    Attribs.NumJobs    = 2;
+    Attribs.ChunkSize  = 1;
+    Attribs.BeginChunk = [&](IDeviceContext* pCtx) {
+        pCtx->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+        IBuffer*     pVBs[]    = {pVB};
+        const Uint64 Offsets[] = {0};
+        pCtx->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_VERIFY, SET_VERTEX_BUFFERS_FLAG_RESET);
+        pCtx->SetIndexBuffer(pIB, 0, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+        pCtx->SetPipelineState(sm_pDrawPSO);
+    };
+    Attribs.RecordJob = [](IDeviceContext* pCtx, Uint32 JobIndex) {
+        DrawIndexedAttribs drawAttrs{3, VT_UINT32, DRAW_FLAG_VERIFY_ALL};
+        drawAttrs.FirstIndexLocation = 3 * JobIndex;
+        pCtx->DrawIndexed(drawAttrs);
+    };
+
+    std::vector<RefCntAutoPtr<ICommandList>> CmdLists;
+    Recorder.Record(Attribs, CmdLists);
+    ASSERT_EQ(CmdLists.size(), size_t{2});
+
+    ParallelCommandRecorder::Execute(pImmediateCtx, CmdLists);
+    EXPECT_TRUE(CmdLists.empty());
+
+    Recorder.FinishFrame();
+
+    Present();
+}
+
+
+// Records many more jobs than there are threads and checks that the command lists are executed
+// in the order of the jobs: only the last clear job clears the render target to the reference color,
+// and the draw jobs must be executed after all clears.
+TEST_F(DrawCommandTest, ParallelCommandRecorder_JobOrder)
+{
+    auto* pEnv = GPUTestingEnvironment::GetInstance();
+    if (pEnv->GetNumDeferredContexts() == 0)
+    {
+        GTEST_SKIP() << "Deferred contexts are not supported by this device";
+    }
+    if (pEnv->GetDevice()->GetDeviceInfo().IsMetalDevice())
+    {
+        GTEST_SKIP() << "In Metal backend, FinishFrame must be called from the thread that recorded the commands";
+    }
+
+    auto* pSwapChain    = pEnv->GetSwapChain();
+    auto* pImmediateCtx = pEnv->GetDeviceContext();
+
+    const float ClearColor[] = {sm_Rnd(), sm_Rnd(), sm_Rnd(), sm_Rnd()};
+    RenderDrawCommandReference(pSwapChain, ClearColor);
+
+    const Uint32 Indices[] = {0, 1, 2, 3, 4, 5};
+    auto         pVB       = CreateVertexBuffer(Vert, sizeof(Vert));
+    auto         pIB       = CreateIndexBuffer(Indices, _countof(Indices));
+
+    ITextureView* pRTVs[] = {pSwapChain->GetCurrentBackBufferRTV()};
+
+    StateTransitionDesc Barriers[] = //
+        {
+            {pVB, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE},
+            {pIB, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_INDEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE},
+            {pRTVs[0]->GetTexture(), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_RENDER_TARGET, STATE_TRANSITION_FLAG_UPDATE_STATE} //
+        };
+    pImmediateCtx->TransitionResourceStates(_countof(Barriers), Barriers);
+
+    std::vector<IDeviceContext*> DeferredCtxs(pEnv->GetNumDeferredContexts());
+    for (Uint32 i = 0; i < DeferredCtxs.size(); ++i)
+        DeferredCtxs[i] = pEnv->GetDeferredContext(i);
+
+    constexpr Uint32 NumThreads = 2;
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{NumThreads});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    ParallelCommandRecorder::CreateInfo RecorderCI;
+    RecorderCI.ppDeferredContexts  = DeferredCtxs.data();
+    RecorderCI.NumDeferredContexts = static_cast<Uint32>(DeferredCtxs.size());
+    RecorderCI.pThreadPool         = pThreadPool;
+    ParallelCommandRecorder Recorder{RecorderCI};
+
+    constexpr Uint32 NumClearJobs = 62;
+    constexpr Uint32 NumDrawJobs  = 2;
+    constexpr Uint32 NumJobs      = NumClearJobs + NumDrawJobs;
+    static_assert(NumJobs > NumThreads + 1, "The test must record more jobs than there are threads");
+
+    std::array<std::atomic<Uint32>, NumJobs> JobRecordCount{};
+
+    ParallelCommandRecorder::RecordAttribs Attribs;
+    Attribs.NumJobs    = NumJobs;
+    Attribs.ChunkSize  = 1;
+    Attribs.BeginChunk = [&](IDeviceContext* pCtx) {
+        pCtx->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+        IBuffer*     pVBs[]    = {pVB};
+        const Uint64 Offsets[] = {0};
+        pCtx->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_VERIFY, SET_VERTEX_BUFFERS_FLAG_RESET);
+        pCtx->SetIndexBuffer(pIB, 0, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+        pCtx->SetPipelineState(sm_pDrawPSO);
+    };
+    Attribs.RecordJob = [&](IDeviceContext* pCtx, Uint32 JobIndex) {
+        JobRecordCount[JobIndex].fetch_add(1);
+        if (JobIndex < NumClearJobs)
+        {
+            const float JunkColor[] = {static_cast<float>(JobIndex) / NumClearJobs, 1.f, 0.f, 1.f};
+            pCtx->ClearRenderTarget(pRTVs[0], JobIndex == NumClearJobs - 1 ? ClearColor : JunkColor, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        }
+        else
+        {
+            DrawIndexedAttribs drawAttrs{3, VT_UINT32, DRAW_FLAG_VERIFY_ALL};
+            drawAttrs.FirstIndexLocation = 3 * (JobIndex - NumClearJobs);
+            pCtx->DrawIndexed(drawAttrs);
+        }
+    };
+
+    std::vector<RefCntAutoPtr<ICommandList>> CmdLists;
+    Recorder.Record(Attribs, CmdLists);
+    ASSERT_EQ(CmdLists.size(), size_t{NumJobs});
+    for (Uint32 i = 0; i < NumJobs; ++i)
+    {
+        EXPECT_NE(CmdLists[i], nullptr) << "Command list " << i << " has not been recorded";
+        EXPECT_EQ(JobRecordCount[i].load(), 1u) << "Job " << i << " has been recorded " << JobRecordCount[i].load() << " times";
+    }
+
+    ParallelCommandRecorder::Execute(pImmediateCtx, CmdLists);
+    EXPECT_TRUE(CmdLists.empty());
+
+    Recorder.FinishFrame();
+
+    Present();
+}
+
+TEST_F(DrawCommandTest, ParallelCommandRecorder_ZeroJobs)
+{
+    auto* pEnv = GPUTestingEnvironment::GetInstance();
+    if (pEnv->GetNumDeferredContexts() == 0)
+    {
+        GTEST_SKIP() << "Deferred contexts are not supported by this device";
+    }
+
+    std::vector<IDeviceContext*> DeferredCtxs(pEnv->GetNumDeferredContexts());
+    for (Uint32 i = 0; i < DeferredCtxs.size(); ++i)
+        DeferredCtxs[i] = pEnv->GetDeferredContext(i);
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{2});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    ParallelCommandRecorder::CreateInfo RecorderCI;
+    RecorderCI.ppDeferredContexts  = DeferredCtxs.data();
+    RecorderCI.NumDeferredContexts = static_cast<Uint32>(DeferredCtxs.size());
+    RecorderCI.pThreadPool         = pThreadPool;
+    ParallelCommandRecorder Recorder{RecorderCI};
+
+    bool CallbackInvoked = false;
+
+    ParallelCommandRecorder::RecordAttribs Attribs;
+    Attribs.NumJobs    = 0;
+    Attribs.BeginChunk = [&](IDeviceContext*) {
+        CallbackInvoked = true;
+    };
+    Attribs.RecordJob = [&](IDeviceContext*, Uint32) {
+        CallbackInvoked = true;
+    };
+    Attribs.EndChunk = [&](IDeviceContext*) {
+        CallbackInvoked = true;
+    };
+
+    std::vector<RefCntAutoPtr<ICommandList>> CmdLists;
+    Recorder.Record(Attribs, CmdLists);
+    EXPECT_TRUE(CmdLists.empty());
+    EXPECT_FALSE(CallbackInvoked);
+
+    // Executing an empty list and finishing a frame without recorded commands must be no-ops
+    ParallelCommandRecorder::Execute(pEnv->GetDeviceContext(), CmdLists);
+    Recorder.FinishFrame();
+}
 
 void DrawCommandTest::TestDynamicBufferUpdates(IShader*                      pVS,
                                                IShader*                      pPS,
@@ -549,4 +549,151 @@ TEST(DynamicTextureAtlas, AllocFreeRace)
     }
 }
 
+
+TEST(DynamicTextureAtlas, Defragment)
+{
+    auto* const pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* const pDevice  = pEnv->GetDevice();
+    auto* const pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    DynamicTextureAtlasCreateInfo CI;
+    CI.ExtraSliceCount = 1;
+    CI.MinAlignment    = 16;
+    CI.Packing         = DYNAMIC_TEXTURE_ATLAS_PACKING_SKYLINE;
+    CI.Desc.Format     = TEX_FORMAT_RGBA8_UNORM;
+    CI.Desc.Name       = "Dynamic Texture Atlas Defragment Test";
+    CI.Desc.Type       = RESOURCE_DIM_TEX_2D_ARRAY;
+    CI.Desc.BindFlags  = BIND_SHADER_RESOURCE;
+    CI.Desc.Width      = 256;
+    CI.Desc.Height     = 256;
+    CI.Desc.MipLevels  = 4;
+    CI.Desc.ArraySize  = 1;
+
+    RefCntAutoPtr<IDynamicTextureAtlas> pAtlas;
+    CreateDynamicTextureAtlas(pDevice, CI, &pAtlas);
+    ASSERT_TRUE(pAtlas);
+
+    FastRandInt rnd{0, 4, 48};
+
+    std::vector<RefCntAutoPtr<ITextureAtlasSuballocation>> Allocs(64);
+    for (auto& Alloc : Allocs)
+    {
+        pAtlas->Allocate(static_cast<Uint32>(rnd()), static_cast<Uint32>(rnd()), &Alloc);
+        ASSERT_TRUE(Alloc);
+    }
+    pAtlas->Update(pDevice, pContext);
+
+    // Release every other allocation to fragment the atlas
+    for (size_t i = 0; i < Allocs.size(); i += 2)
+        Allocs[i].Release();
+
+    constexpr Uint32            MaxMoves         = 8;
+    ITextureAtlasSuballocation* pMoved[MaxMoves] = {};
+    Uint32                      TotalMoves       = 0;
+    while (Uint32 NumMoves = pAtlas->Defragment(pDevice, pContext, MaxMoves, pMoved))
+    {
+        ASSERT_LE(NumMoves, MaxMoves);
+        for (Uint32 i = 0; i < NumMoves; ++i)
+        {
+            ASSERT_NE(pMoved[i], nullptr);
+            EXPECT_EQ(pMoved[i]->GetAtlas(), pAtlas.RawPtr());
+        }
+        TotalMoves += NumMoves;
+        ASSERT_LT(TotalMoves, 1024u);
+    }
+
+    // Moved suballocations must not overlap
+    for (size_t i = 0; i < Allocs.size(); ++i)
+    {
+        if (!Allocs[i])
+            continue;
+        const uint2 Origin0 = Allocs[i]->GetOrigin();
+        const uint2 Size0   = Allocs[i]->GetSize();
+        for (size_t j = i + 1; j < Allocs.size(); ++j)
+        {
+            if (!Allocs[j] || Allocs[j]->GetSlice() != Allocs[i]->GetSlice())
+                continue;
+            const uint2 Origin1 = Allocs[j]->GetOrigin();
+            const uint2 Size1   = Allocs[j]->GetSize();
+            EXPECT_FALSE(Origin0.x < Origin1.x + Size1.x && Origin1.x < Origin0.x + Size0.x &&
+                         Origin0.y < Origin1.y + Size1.y && Origin1.y < Origin0.y + Size0.y);
+        }
+    }
+}
+
+
+// Defragment() must not move any suballocation if the scratch texture can't be created
+TEST(DynamicTextureAtlas, DefragmentScratchTextureFailure)
+{
+    auto* const pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* const pDevice  = pEnv->GetDevice();
+    auto* const pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    DynamicTextureAtlasCreateInfo CI;
+    CI.ExtraSliceCount = 1;
+    CI.MinAlignment    = 16;
+    CI.Packing         = DYNAMIC_TEXTURE_ATLAS_PACKING_SKYLINE;
+    CI.Desc.Format     = TEX_FORMAT_RGBA8_UNORM;
+    CI.Desc.Name       = "Dynamic Texture Atlas Defragment Scratch Texture Failure Test";
+    CI.Desc.Type       = RESOURCE_DIM_TEX_2D_ARRAY;
+    CI.Desc.BindFlags  = BIND_SHADER_RESOURCE;
+    CI.Desc.Width      = 256;
+    CI.Desc.Height     = 256;
+    CI.Desc.MipLevels  = 4;
+    CI.Desc.ArraySize  = 1;
+
+    RefCntAutoPtr<IDynamicTextureAtlas> pAtlas;
+    CreateDynamicTextureAtlas(pDevice, CI, &pAtlas);
+    ASSERT_TRUE(pAtlas);
+
+    FastRandInt rnd{1, 4, 48};
+
+    std::vector<RefCntAutoPtr<ITextureAtlasSuballocation>> Allocs(64);
+    for (auto& Alloc : Allocs)
+    {
+        pAtlas->Allocate(static_cast<Uint32>(rnd()), static_cast<Uint32>(rnd()), &Alloc);
+        ASSERT_TRUE(Alloc);
+    }
+    pAtlas->Update(pDevice, pContext);
+
+    for (size_t i = 0; i < Allocs.size(); i += 2)
+        Allocs[i].Release();
+
+    std::vector<uint2> Origins(Allocs.size());
+    for (size_t i = 0; i < Allocs.size(); ++i)
+    {
+        if (Allocs[i])
+            Origins[i] = Allocs[i]->GetOrigin();
+    }
+
+    constexpr Uint32            MaxMoves         = 8;
+    ITextureAtlasSuballocation* pMoved[MaxMoves] = {};
+    {
+        // The scratch texture has not been created yet, and it can't be created without the device
+        TestingEnvironment::ErrorScope ExpectedErrors{"Render device must not be null"};
+        EXPECT_EQ(pAtlas->Defragment(nullptr, pContext, MaxMoves, pMoved), 0u);
+    }
+    for (size_t i = 0; i < Allocs.size(); ++i)
+    {
+        if (Allocs[i])
+        {
+            EXPECT_EQ(Allocs[i]->GetOrigin(), Origins[i]) << "Suballocation " << i << " was moved";
+        }
+    }
+
+    // The scratch texture is created for the largest suballocation and is reused by the next calls,
+    // so the device is no longer required
+    Uint32 TotalMoves = pAtlas->Defragment(pDevice, pContext, MaxMoves, pMoved);
+    EXPECT_GT(TotalMoves, 0u);
+    while (Uint32 NumMoves = pAtlas->Defragment(nullptr, pContext, MaxMoves, pMoved))
+    {
+        TotalMoves += NumMoves;
+        ASSERT_LT(TotalMoves, 1024u);
+    }
+}
+
 } // namespace
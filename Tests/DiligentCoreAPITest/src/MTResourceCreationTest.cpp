@@ -28,12 +28,20 @@
 #include <thread>
 #include <atomic>
 #include <algorithm>
+#include <chrono>
+#include <functional>
+#include <vector>
 
 #include "GPUTestingEnvironment.hpp"
 #include "ThreadSignal.hpp"
 #if D3D12_SUPPORTED
 #    include "D3D12/D3D12DebugLayerSetNameBugWorkaround.hpp"
 #endif
+#if VULKAN_SUPPORTED
+#    define VK_NO_PROTOTYPES
+#    include "vulkan/vulkan.h"
+#    include "RenderDeviceVk.h"
+#endif
 
 #include "gtest/gtest.h"
 
@@ -326,4 +334,225 @@ TEST_F(MultithreadedResourceCreationTest, CreateResources)
         t.join();
 }
 
+
+// Creates and releases SRBs in short-lived threads. In Vulkan, every thread that allocates descriptor
+// sets takes a pool from the shared list, and the pool must be returned when the thread exits.
+TEST(MultithreadedSRBCreationTest, ShortLivedThreads)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (pDevice->GetDeviceInfo().IsGLDevice())
+    {
+        GTEST_SKIP() << "Multithreading resource creation is not supported in OpenGL";
+    }
+
+    if (pDevice->GetDeviceInfo().IsWebGPUDevice())
+    {
+        GTEST_SKIP() << "Multithreading resource creation is not supported in WebGPU";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    RefCntAutoPtr<IPipelineResourceSignature> pPRS;
+    {
+        // clang-format off
+        const PipelineResourceDesc Resources[] =
+        {
+            {SHADER_TYPE_PIXEL, "cbMutable", 1, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+            {SHADER_TYPE_PIXEL, "g_Buffers", 4, SHADER_RESOURCE_TYPE_BUFFER_SRV,      SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+        };
+        // clang-format on
+
+        PipelineResourceSignatureDesc PRSDesc;
+        PRSDesc.Name         = "MT SRB creation test";
+        PRSDesc.Resources    = Resources;
+        PRSDesc.NumResources = _countof(Resources);
+        pDevice->CreatePipelineResourceSignature(PRSDesc, &pPRS);
+        ASSERT_NE(pPRS, nullptr);
+    }
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name      = "MT SRB creation test buffer";
+        BuffDesc.Usage     = USAGE_DEFAULT;
+        BuffDesc.BindFlags = BIND_UNIFORM_BUFFER;
+        BuffDesc.Size      = 256;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+        ASSERT_NE(pBuffer, nullptr);
+    }
+
+#ifdef DILIGENT_DEBUG
+    constexpr Uint32 NumWaves = 4;
+#else
+    constexpr Uint32 NumWaves      = 16;
+#endif
+    constexpr Uint32 NumSRBsPerThread = 256;
+
+    const Uint32 NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+
+    std::atomic<Uint32> NumFailures{0};
+
+    double Time = 0;
+    for (Uint32 wave = 0; wave < NumWaves; ++wave)
+    {
+        // SRBs kept alive after their creating threads exit
+        std::vector<std::vector<RefCntAutoPtr<IShaderResourceBinding>>> KeptSRBs(NumThreads);
+
+        const auto StartTime = std::chrono::high_resolution_clock::now();
+
+        std::vector<std::thread> Threads(NumThreads);
+        for (Uint32 t = 0; t < NumThreads; ++t)
+        {
+            Threads[t] = std::thread{
+                [&](std::vector<RefCntAutoPtr<IShaderResourceBinding>>& SRBs) {
+                    for (Uint32 i = 0; i < NumSRBsPerThread; ++i)
+                    {
+                        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+                        pPRS->CreateShaderResourceBinding(&pSRB);
+                        if (!pSRB)
+                        {
+                            NumFailures.fetch_add(1);
+                            continue;
+                        }
+                        pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "cbMutable")->Set(pBuffer);
+
+                        // Release every other SRB in the creating thread
+                        if (i % 2 == 0)
+                            SRBs.emplace_back(std::move(pSRB));
+                    }
+                },
+                std::ref(KeptSRBs[t]),
+            };
+        }
+        for (std::thread& Thread : Threads)
+            Thread.join();
+
+        const auto EndTime = std::chrono::high_resolution_clock::now();
+        Time += std::chrono::duration_cast<std::chrono::duration<double>>(EndTime - StartTime).count();
+
+        for (const std::vector<RefCntAutoPtr<IShaderResourceBinding>>& SRBs : KeptSRBs)
+            EXPECT_EQ(SRBs.size(), size_t{NumSRBsPerThread / 2});
+
+        // Release the remaining SRBs in the main thread after their creating threads have exited
+        KeptSRBs.clear();
+        pEnv->ReleaseResources();
+    }
+    EXPECT_EQ(NumFailures.load(), 0u);
+
+    const Uint32 NumSRBs = NumWaves * NumThreads * NumSRBsPerThread;
+    LOG_INFO_MESSAGE("Created ", NumSRBs, " SRBs in ", NumWaves, " waves of ", NumThreads, " short-lived threads in ",
+                     Time * 1000, " ms (", static_cast<double>(NumSRBs) / Time / 1e6, " M SRBs/s)");
+}
+
+
+#if VULKAN_SUPPORTED
+// Checks descriptor set allocation statistics of threads that create SRBs, and that the descriptor
+// pool of a thread that stops allocating is returned to the shared list after a number of frames.
+TEST(MultithreadedSRBCreationTest, DescriptorSetThreadStatsVk)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    RefCntAutoPtr<IRenderDeviceVk> pDeviceVk{pDevice, IID_RenderDeviceVk};
+    if (!pDeviceVk)
+    {
+        GTEST_SKIP() << "This test requires Vulkan device";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    RefCntAutoPtr<IPipelineResourceSignature> pPRS;
+    {
+        const PipelineResourceDesc Resources[] = {
+            {SHADER_TYPE_PIXEL, "cbMutable", 1, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+        };
+
+        PipelineResourceSignatureDesc PRSDesc;
+        PRSDesc.Name         = "Descriptor set thread stats test";
+        PRSDesc.Resources    = Resources;
+        PRSDesc.NumResources = _countof(Resources);
+        pDevice->CreatePipelineResourceSignature(PRSDesc, &pPRS);
+        ASSERT_NE(pPRS, nullptr);
+    }
+
+    auto GetThreadIdHash = []() {
+        return static_cast<Uint64>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    };
+
+    auto FindThreadStats = [&](Uint64 ThreadIdHash, DescriptorSetThreadStatsVk& Stats) {
+        std::vector<DescriptorSetThreadStatsVk> AllStats(pDeviceVk->GetDescriptorSetThreadStats(nullptr, 0));
+        const Uint32                            NumThreads = pDeviceVk->GetDescriptorSetThreadStats(AllStats.data(), static_cast<Uint32>(AllStats.size()));
+        AllStats.resize(std::min(AllStats.size(), size_t{NumThreads}));
+        for (const DescriptorSetThreadStatsVk& ThreadStats : AllStats)
+        {
+            if (ThreadStats.ThreadIdHash == ThreadIdHash)
+            {
+                Stats = ThreadStats;
+                return true;
+            }
+        }
+        return false;
+    };
+
+    constexpr Uint32 NumSRBs = 64;
+
+    Uint64                     WorkerIdHash     = 0;
+    bool                       WorkerStatsFound = false;
+    DescriptorSetThreadStatsVk WorkerStats;
+
+    std::thread Worker{
+        [&]() {
+            WorkerIdHash = GetThreadIdHash();
+
+            std::vector<RefCntAutoPtr<IShaderResourceBinding>> SRBs(NumSRBs);
+            for (RefCntAutoPtr<IShaderResourceBinding>& pSRB : SRBs)
+                pPRS->CreateShaderResourceBinding(&pSRB);
+
+            WorkerStatsFound = FindThreadStats(WorkerIdHash, WorkerStats);
+        },
+    };
+    Worker.join();
+
+    ASSERT_TRUE(WorkerStatsFound);
+    EXPECT_EQ(WorkerStats.NumAllocatedSets, Uint64{NumSRBs});
+    EXPECT_GE(WorkerStats.NumAcquiredPools, 1u);
+    EXPECT_TRUE(WorkerStats.OwnsPool);
+
+    // Statistics of a thread are removed when it exits
+    EXPECT_FALSE(FindThreadStats(WorkerIdHash, WorkerStats));
+
+    const Uint64 MainIdHash = GetThreadIdHash();
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPRS->CreateShaderResourceBinding(&pSRB);
+    ASSERT_NE(pSRB, nullptr);
+
+    DescriptorSetThreadStatsVk MainStats;
+    ASSERT_TRUE(FindThreadStats(MainIdHash, MainStats));
+    EXPECT_TRUE(MainStats.OwnsPool);
+    const Uint64 NumAllocatedSets = MainStats.NumAllocatedSets;
+    const Uint32 NumAcquiredPools = MainStats.NumAcquiredPools;
+
+    // Every call to ReleaseStaleResources() counts as a frame. The pool of the main
+    // thread, which does not allocate any more, must be returned to the shared list.
+    for (Uint32 frame = 0; frame < 64; ++frame)
+        pDevice->ReleaseStaleResources();
+
+    ASSERT_TRUE(FindThreadStats(MainIdHash, MainStats));
+    EXPECT_FALSE(MainStats.OwnsPool);
+    EXPECT_EQ(MainStats.NumAllocatedSets, NumAllocatedSets);
+
+    // The next allocation takes a pool from the shared list
+    pSRB.Release();
+    pPRS->CreateShaderResourceBinding(&pSRB);
+    ASSERT_NE(pSRB, nullptr);
+
+    ASSERT_TRUE(FindThreadStats(MainIdHash, MainStats));
+    EXPECT_TRUE(MainStats.OwnsPool);
+    EXPECT_EQ(MainStats.NumAllocatedSets, NumAllocatedSets + 1);
+    EXPECT_EQ(MainStats.NumAcquiredPools, NumAcquiredPools + 1);
+}
+#endif
+
 } // namespace
@@ -26,12 +26,16 @@
  */
 
 #include <array>
+#include <chrono>
 #include <vector>
 
 #include "GPUTestingEnvironment.hpp"
 #include "TestingSwapChainBase.hpp"
 #include "ShaderMacroHelper.hpp"
 #include "GraphicsAccessories.hpp"
+#include "DescriptorIndexAllocator.hpp"
+#include "GraphicsUtilities.h"
+#include "MapHelper.hpp"
 #include "ResourceLayoutTestCommon.hpp"
 
 #if VULKAN_SUPPORTED
@@ -2031,4 +2035,449 @@ TEST_F(PipelineResourceSignatureTest, UnusedNullResources)
     pSwapChain->Present();
 }
 
+
+// In Vulkan backend, static resources are written to the SRB descriptor set and dynamic resources are
+// written to the dynamic descriptor set with descriptor update templates.
+TEST_F(PipelineResourceSignatureTest, DescriptorUpdateTemplates)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    static constexpr char CSSource[] = R"(
+cbuffer cbStatic
+{
+    uint4 g_StaticData;
+}
+
+cbuffer cbDynamic
+{
+    uint4 g_DynamicData;
+}
+
+StructuredBuffer<uint4>   g_DynamicSB;
+RWStructuredBuffer<uint4> g_Output;
+
+[numthreads(1, 1, 1)]
+void main()
+{
+    g_Output[g_DynamicData.w] = g_StaticData + g_DynamicData + g_DynamicSB[0];
+}
+)";
+
+    RefCntAutoPtr<IShader> pCS;
+    {
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.Desc           = {"Descriptor update templates test - CS", SHADER_TYPE_COMPUTE, true};
+        ShaderCI.EntryPoint     = "main";
+        ShaderCI.Source         = CSSource;
+        pDevice->CreateShader(ShaderCI, &pCS);
+        ASSERT_NE(pCS, nullptr);
+    }
+
+    RefCntAutoPtr<IPipelineResourceSignature> pPRS;
+    {
+        // clang-format off
+        const PipelineResourceDesc Resources[] =
+        {
+            {SHADER_TYPE_COMPUTE, "cbStatic",    1, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_STATIC},
+            {SHADER_TYPE_COMPUTE, "cbDynamic",   1, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "g_DynamicSB", 1, SHADER_RESOURCE_TYPE_BUFFER_SRV,      SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "g_Output",    1, SHADER_RESOURCE_TYPE_BUFFER_UAV,      SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+        };
+        // clang-format on
+
+        PipelineResourceSignatureDesc PRSDesc;
+        PRSDesc.Name         = "Descriptor update templates test";
+        PRSDesc.Resources    = Resources;
+        PRSDesc.NumResources = _countof(Resources);
+        pDevice->CreatePipelineResourceSignature(PRSDesc, &pPRS);
+        ASSERT_NE(pPRS, nullptr);
+    }
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    {
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name         = "Descriptor update templates test";
+        PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+        PSOCreateInfo.pCS                  = pCS;
+
+        IPipelineResourceSignature* Signatures[] = {pPRS};
+        PSOCreateInfo.ppResourceSignatures       = Signatures;
+        PSOCreateInfo.ResourceSignaturesCount    = _countof(Signatures);
+        pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+        ASSERT_NE(pPSO, nullptr);
+    }
+
+    auto CreateBuffer = [&](const char* Name, BIND_FLAGS BindFlags, Uint32 NumElements, const Uint32* pData) {
+        BufferDesc BuffDesc;
+        BuffDesc.Name      = Name;
+        BuffDesc.Usage     = USAGE_DEFAULT;
+        BuffDesc.BindFlags = BindFlags;
+        BuffDesc.Size      = NumElements * sizeof(Uint32) * 4;
+        if (BindFlags != BIND_UNIFORM_BUFFER)
+        {
+            BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+            BuffDesc.ElementByteStride = sizeof(Uint32) * 4;
+        }
+
+        BufferData InitData{pData, BuffDesc.Size};
+
+        RefCntAutoPtr<IBuffer> pBuffer;
+        pDevice->CreateBuffer(BuffDesc, pData != nullptr ? &InitData : nullptr, &pBuffer);
+        return pBuffer;
+    };
+
+    static constexpr Uint32 NumDynamicCBs = 64;
+
+    const Uint32 StaticData[] = {1, 2, 3, 0};
+    const Uint32 SBData[]     = {1000, 2000, 3000, 0};
+
+    RefCntAutoPtr<IBuffer> pStaticCB = CreateBuffer("Static CB", BIND_UNIFORM_BUFFER, 1, StaticData);
+    RefCntAutoPtr<IBuffer> pSB       = CreateBuffer("Dynamic SB", BIND_SHADER_RESOURCE, 1, SBData);
+    RefCntAutoPtr<IBuffer> pOutput   = CreateBuffer("Output", BIND_UNORDERED_ACCESS, NumDynamicCBs, nullptr);
+    ASSERT_TRUE(pStaticCB && pSB && pOutput);
+
+    std::vector<RefCntAutoPtr<IBuffer>> pDynamicCBs(NumDynamicCBs);
+    for (Uint32 i = 0; i < NumDynamicCBs; ++i)
+    {
+        const Uint32 DynamicData[] = {i * 10, i * 20, i * 30, i};
+        pDynamicCBs[i]             = CreateBuffer("Dynamic CB", BIND_UNIFORM_BUFFER, 1, DynamicData);
+        ASSERT_NE(pDynamicCBs[i], nullptr);
+    }
+
+    pPRS->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "cbStatic")->Set(pStaticCB);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPRS->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+
+    IShaderResourceVariable* pDynamicCBVar = pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "cbDynamic");
+    ASSERT_NE(pDynamicCBVar, nullptr);
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_DynamicSB")->Set(pSB->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Output")->Set(pOutput->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+
+    pContext->SetPipelineState(pPSO);
+    for (Uint32 i = 0; i < NumDynamicCBs; ++i)
+    {
+        pDynamicCBVar->Set(pDynamicCBs[i]);
+        pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+    }
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name           = "Staging buffer";
+        BuffDesc.Usage          = USAGE_STAGING;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        BuffDesc.Size           = pOutput->GetDesc().Size;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+        ASSERT_NE(pStagingBuffer, nullptr);
+    }
+    pContext->CopyBuffer(pOutput, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStagingBuffer, 0, pOutput->GetDesc().Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    {
+        void* pData = nullptr;
+        pContext->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+        ASSERT_NE(pData, nullptr);
+        const Uint32* pOutData = static_cast<const Uint32*>(pData);
+        for (Uint32 i = 0; i < NumDynamicCBs; ++i)
+        {
+            const Uint32 Ref[] = {StaticData[0] + i * 10 + SBData[0], StaticData[1] + i * 20 + SBData[1], StaticData[2] + i * 30 + SBData[2], i};
+            for (Uint32 c = 0; c < 4; ++c)
+                EXPECT_EQ(pOutData[i * 4 + c], Ref[c]) << "Element " << i << ", component " << c;
+        }
+        pContext->UnmapBuffer(pStagingBuffer, MAP_READ);
+    }
+
+    // Measure the cost of writing the dynamic descriptor set
+    {
+        static constexpr Uint32 NumFrames          = 16;
+        static constexpr Uint32 NumCommitsPerFrame = 1024;
+
+        double Time = 0;
+        for (Uint32 frame = 0; frame < NumFrames; ++frame)
+        {
+            const auto StartTime = std::chrono::high_resolution_clock::now();
+            for (Uint32 i = 0; i < NumCommitsPerFrame; ++i)
+            {
+                pDynamicCBVar->Set(pDynamicCBs[i % NumDynamicCBs]);
+                pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            }
+            const auto EndTime = std::chrono::high_resolution_clock::now();
+            Time += std::chrono::duration_cast<std::chrono::duration<double>>(EndTime - StartTime).count();
+
+            pContext->Flush();
+            pContext->FinishFrame();
+        }
+
+        const Uint32 NumCommits = NumFrames * NumCommitsPerFrame;
+        LOG_INFO_MESSAGE("Committed SRB with 3 dynamic resources ", NumCommits, " times in ", Time * 1000, " ms (",
+                         static_cast<double>(NumCommits) / Time / 1e6, " M commits/s)");
+    }
+
+    // Measure the cost of creating SRBs with initialized static resources that are written with the static set template
+    {
+        static constexpr Uint32 NumFrames       = 16;
+        static constexpr Uint32 NumSRBsPerFrame = 256;
+
+        std::vector<RefCntAutoPtr<IShaderResourceBinding>> SRBs(NumSRBsPerFrame);
+
+        double Time = 0;
+        for (Uint32 frame = 0; frame < NumFrames; ++frame)
+        {
+            const auto StartTime = std::chrono::high_resolution_clock::now();
+            for (RefCntAutoPtr<IShaderResourceBinding>& pFrameSRB : SRBs)
+            {
+                pFrameSRB.Release();
+                pPRS->CreateShaderResourceBinding(&pFrameSRB, true);
+            }
+            const auto EndTime = std::chrono::high_resolution_clock::now();
+            Time += std::chrono::duration_cast<std::chrono::duration<double>>(EndTime - StartTime).count();
+            ASSERT_NE(SRBs.back(), nullptr);
+
+            pContext->Flush();
+            pContext->FinishFrame();
+        }
+
+        const Uint32 NumSRBs = NumFrames * NumSRBsPerFrame;
+        LOG_INFO_MESSAGE("Created ", NumSRBs, " SRBs with initialized static resources in ", Time * 1000, " ms (",
+                         static_cast<double>(NumSRBs) / Time / 1e3, " K SRBs/s)");
+    }
+}
+
+
+TEST_F(PipelineResourceSignatureTest, UpdateAfterBindHeap)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    const RenderDeviceInfo& DeviceInfo = pDevice->GetDeviceInfo();
+    if (!DeviceInfo.IsVulkanDevice())
+        GTEST_SKIP() << "Update-after-bind descriptor sets are only implemented in Vulkan";
+
+    if (!DeviceInfo.Features.ShaderResourceRuntimeArrays)
+        GTEST_SKIP() << "Shader Resource Runtime Arrays are not supported by this device";
+
+    if (!pEnv->HasDXCompiler())
+        GTEST_SKIP() << "Vulkan requires DXCompiler which is not found";
+
+#if VULKAN_SUPPORTED
+    if (static_cast<TestingEnvironmentVk*>(pEnv)->DescriptorIndexing.descriptorBindingStorageBufferUpdateAfterBind != VK_TRUE)
+        GTEST_SKIP() << "Update-after-bind storage buffers are not supported by this device";
+#endif
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    static constexpr char CSSource[] = R"(
+StructuredBuffer<uint4> g_Heap[];
+
+cbuffer cbIndices
+{
+    uint4 g_Indices; // x - heap index, y - output element
+}
+
+RWStructuredBuffer<uint4> g_Output;
+
+[numthreads(1, 1, 1)]
+void main()
+{
+    g_Output[g_Indices.y] = g_Heap[g_Indices.x][0];
+}
+)";
+
+    RefCntAutoPtr<IShader> pCS;
+    {
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler = SHADER_COMPILER_DXC;
+        ShaderCI.CompileFlags   = SHADER_COMPILE_FLAG_ENABLE_UNBOUNDED_ARRAYS;
+        ShaderCI.Desc           = {"Update-after-bind heap test - CS", SHADER_TYPE_COMPUTE, true};
+        ShaderCI.EntryPoint     = "main";
+        ShaderCI.Source         = CSSource;
+        pDevice->CreateShader(ShaderCI, &pCS);
+        ASSERT_NE(pCS, nullptr);
+    }
+
+    static constexpr Uint32 HeapSize = 8;
+
+    RefCntAutoPtr<IPipelineResourceSignature> pPRS;
+    {
+        constexpr PIPELINE_RESOURCE_FLAGS HeapFlags =
+            PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY | PIPELINE_RESOURCE_FLAG_UPDATE_AFTER_BIND | PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS;
+
+        // clang-format off
+        const PipelineResourceDesc Resources[] =
+        {
+            {SHADER_TYPE_COMPUTE, "g_Heap",    HeapSize, SHADER_RESOURCE_TYPE_BUFFER_SRV,      SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, HeapFlags},
+            {SHADER_TYPE_COMPUTE, "cbIndices", 1,        SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "g_Output",  1,        SHADER_RESOURCE_TYPE_BUFFER_UAV,      SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+        };
+        // clang-format on
+
+        PipelineResourceSignatureDesc PRSDesc;
+        PRSDesc.Name         = "Update-after-bind heap test";
+        PRSDesc.Resources    = Resources;
+        PRSDesc.NumResources = _countof(Resources);
+        pDevice->CreatePipelineResourceSignature(PRSDesc, &pPRS);
+        ASSERT_NE(pPRS, nullptr);
+    }
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    {
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name         = "Update-after-bind heap test";
+        PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+        PSOCreateInfo.pCS                  = pCS;
+
+        IPipelineResourceSignature* Signatures[] = {pPRS};
+        PSOCreateInfo.ppResourceSignatures       = Signatures;
+        PSOCreateInfo.ResourceSignaturesCount    = _countof(Signatures);
+        pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+        ASSERT_NE(pPSO, nullptr);
+    }
+
+    auto CreateStructBuffer = [&](const char* Name, BIND_FLAGS BindFlags, Uint32 NumElements, const Uint32* pData) {
+        BufferDesc BuffDesc;
+        BuffDesc.Name              = Name;
+        BuffDesc.Usage             = USAGE_DEFAULT;
+        BuffDesc.BindFlags         = BindFlags;
+        BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+        BuffDesc.ElementByteStride = sizeof(Uint32) * 4;
+        BuffDesc.Size              = NumElements * BuffDesc.ElementByteStride;
+
+        BufferData InitData{pData, BuffDesc.Size};
+
+        RefCntAutoPtr<IBuffer> pBuffer;
+        pDevice->CreateBuffer(BuffDesc, pData != nullptr ? &InitData : nullptr, &pBuffer);
+        return pBuffer;
+    };
+
+    // Every element is written twice: first to the indices handed out initially and then to the
+    // recycled ones, after the heap set has been bound.
+    static constexpr Uint32 NumElements = HeapSize * 2;
+
+    RefCntAutoPtr<IBuffer> pOutput = CreateStructBuffer("Output", BIND_UNORDERED_ACCESS, NumElements, nullptr);
+    ASSERT_NE(pOutput, nullptr);
+
+    RefCntAutoPtr<IBuffer> pIndicesCB;
+    CreateUniformBuffer(pDevice, sizeof(Uint32) * 4, "Indices CB", &pIndicesCB);
+    ASSERT_NE(pIndicesCB, nullptr);
+
+    RefCntAutoPtr<IFence> pFence;
+    {
+        FenceDesc Desc;
+        Desc.Name = "Update-after-bind heap test fence";
+        Desc.Type = FENCE_TYPE_CPU_WAIT_ONLY;
+        pDevice->CreateFence(Desc, &pFence);
+        ASSERT_NE(pFence, nullptr);
+    }
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPRS->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+
+    IShaderResourceVariable* pHeapVar = pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Heap");
+    ASSERT_NE(pHeapVar, nullptr);
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "cbIndices")->Set(pIndicesCB);
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Output")->Set(pOutput->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+
+    pContext->SetPipelineState(pPSO);
+    // The heap set is bound once, and its elements are written while it is in use
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    DescriptorIndexAllocator IdxAllocator{HeapSize};
+
+    std::vector<RefCntAutoPtr<IBuffer>> pElements(NumElements);
+    std::vector<Uint32>                 HeapIndices;
+
+    auto DrawElement = [&](Uint32 Element) {
+        const Uint32 HeapIdx = IdxAllocator.Allocate();
+        ASSERT_NE(HeapIdx, DescriptorIndexAllocator::InvalidIndex);
+        HeapIndices.push_back(HeapIdx);
+
+        const Uint32 Data[] = {Element, Element * 10, Element * 100, HeapIdx};
+        pElements[Element]  = CreateStructBuffer("Heap element", BIND_SHADER_RESOURCE, 1, Data);
+        ASSERT_NE(pElements[Element], nullptr);
+        // The heap set has already been committed, so the new element must be transitioned explicitly
+        StateTransitionDesc Barrier{pElements[Element], RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE};
+        pContext->TransitionResourceStates(1, &Barrier);
+
+        IDeviceObject* pView = pElements[Element]->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE);
+        pHeapVar->SetArray(&pView, HeapIdx, 1, SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE);
+
+        {
+            MapHelper<Uint32> Indices{pContext, pIndicesCB, MAP_WRITE, MAP_FLAG_DISCARD};
+            Indices[0] = HeapIdx;
+            Indices[1] = Element;
+        }
+        pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        pContext->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+    };
+
+    for (Uint32 i = 0; i < HeapSize; ++i)
+        DrawElement(i);
+    EXPECT_EQ(IdxAllocator.Allocate(), DescriptorIndexAllocator::InvalidIndex);
+
+    // Release all indices once the GPU is done with them and write new elements to the recycled indices
+    for (Uint32 HeapIdx : HeapIndices)
+        IdxAllocator.Release(HeapIdx, 1);
+    HeapIndices.clear();
+    pContext->EnqueueSignal(pFence, 1);
+    pContext->Flush();
+
+    pFence->Wait(1);
+    IdxAllocator.ReleaseCompleted(pFence->GetCompletedValue());
+    EXPECT_EQ(IdxAllocator.GetStaleCount(), 0u);
+
+    pContext->SetPipelineState(pPSO);
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    for (Uint32 i = HeapSize; i < NumElements; ++i)
+        DrawElement(i);
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name           = "Staging buffer";
+        BuffDesc.Usage          = USAGE_STAGING;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        BuffDesc.Size           = pOutput->GetDesc().Size;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+        ASSERT_NE(pStagingBuffer, nullptr);
+    }
+    pContext->CopyBuffer(pOutput, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStagingBuffer, 0, pOutput->GetDesc().Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    {
+        void* pData = nullptr;
+        pContext->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+        ASSERT_NE(pData, nullptr);
+        const Uint32* pOutData = static_cast<const Uint32*>(pData);
+        for (Uint32 i = 0; i < NumElements; ++i)
+        {
+            EXPECT_EQ(pOutData[i * 4 + 0], i) << "Element " << i;
+            EXPECT_EQ(pOutData[i * 4 + 1], i * 10) << "Element " << i;
+            EXPECT_EQ(pOutData[i * 4 + 2], i * 100) << "Element " << i;
+            EXPECT_LT(pOutData[i * 4 + 3], HeapSize) << "Element " << i;
+        }
+        pContext->UnmapBuffer(pStagingBuffer, MAP_READ);
+    }
+
+    for (Uint32 HeapIdx : HeapIndices)
+        IdxAllocator.Release(HeapIdx, 2);
+    IdxAllocator.ReleaseCompleted(2);
+}
+
 } // namespace Diligent
@@ -34,6 +34,7 @@
 #include "GraphicsTypesX.hpp"
 #include "CallbackWrapper.hpp"
 #include "ResourceLayoutTestCommon.hpp"
+#include "ThreadPool.hpp"
 
 #include "InlineShaders/RayTracingTestHLSL.h"
 #include "InlineShaders/DrawCommandTestHLSL.h"
@@ -1673,6 +1674,143 @@ TEST(RenderStateCacheTest, Reload_Signatures2)
     }
 }
 
+TEST(RenderStateCacheTest, Reload_ChangedShadersOnly)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+    {
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReset AutoReset;
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory("shaders/RenderStateCache", &pShaderSourceFactory);
+    ASSERT_TRUE(pShaderSourceFactory);
+
+    // Only PixelShader.psh is modified in the Reload2 folder
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderReloadFactory;
+    pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory("shaders/RenderStateCache/Reload2;shaders/RenderStateCache", &pShaderReloadFactory);
+    ASSERT_TRUE(pShaderReloadFactory);
+
+    for (Uint32 use_thread_pool = 0; use_thread_pool < 2; ++use_thread_pool)
+    {
+        RefCntAutoPtr<IThreadPool> pThreadPool;
+        if (use_thread_pool)
+        {
+            pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+            ASSERT_TRUE(pThreadPool);
+        }
+
+        RenderStateCacheCreateInfo CacheCI{
+            pDevice,
+            pEnv->GetArchiverFactory(),
+            RENDER_STATE_CACHE_LOG_LEVEL_VERBOSE,
+            RENDER_STATE_CACHE_FILE_HASH_MODE_BY_CONTENT,
+            true, // EnableHotReload
+        };
+        CacheCI.pReloadSource     = pShaderReloadFactory;
+        CacheCI.pReloadThreadPool = pThreadPool;
+
+        RefCntAutoPtr<IRenderStateCache> pCache;
+        CreateRenderStateCache(CacheCI, &pCache);
+        ASSERT_TRUE(pCache);
+
+        RefCntAutoPtr<IShader> pVS, pPS, pCS;
+        CreateGraphicsShaders(pCache, pShaderSourceFactory, SHADER_COMPILE_FLAG_NONE, pVS, pPS, false);
+        CreateComputeShader(pCache, pShaderSourceFactory, SHADER_COMPILE_FLAG_NONE, pCS, false);
+        ASSERT_TRUE(pCS);
+
+        RefCntAutoPtr<IPipelineState> pGraphicsPSO, pComputePSO;
+        CreateGraphicsPSO(pCache, false, pVS, pPS, false, false, &pGraphicsPSO);
+        ASSERT_TRUE(pGraphicsPSO);
+        CreateComputePSO(pCache, false, pCS, false, false, &pComputePSO);
+        ASSERT_TRUE(pComputePSO);
+
+        // The pixel shader and the graphics pipeline must be reloaded
+        RenderStateCacheReloadStats Stats;
+        EXPECT_EQ(pCache->Reload(nullptr, nullptr, &Stats), 2u);
+        EXPECT_EQ(Stats.NumShadersReloaded, 1u);
+        EXPECT_EQ(Stats.NumShadersSkipped, 2u);
+        EXPECT_EQ(Stats.NumPipelinesReloaded, 1u);
+        EXPECT_EQ(Stats.NumPipelinesSkipped, 1u);
+
+        // Nothing has changed since the last reload
+        EXPECT_EQ(pCache->Reload(nullptr, nullptr, &Stats), 0u);
+        EXPECT_EQ(Stats.NumShadersReloaded, 0u);
+        EXPECT_EQ(Stats.NumShadersSkipped, 3u);
+        EXPECT_EQ(Stats.NumPipelinesReloaded, 0u);
+        EXPECT_EQ(Stats.NumPipelinesSkipped, 2u);
+
+        EXPECT_EQ(pGraphicsPSO->GetStatus(true), PIPELINE_STATE_STATUS_READY);
+        EXPECT_EQ(pComputePSO->GetStatus(true), PIPELINE_STATE_STATUS_READY);
+    }
+}
+
+// The callback may change pipelines whose shaders have not changed, so all pipelines must be reloaded
+TEST(RenderStateCacheTest, Reload_CallbackWithUnchangedShaders)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReset AutoReset;
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory("shaders/RenderStateCache", &pShaderSourceFactory);
+    ASSERT_TRUE(pShaderSourceFactory);
+
+    RenderStateCacheCreateInfo CacheCI{
+        pDevice,
+        pEnv->GetArchiverFactory(),
+        RENDER_STATE_CACHE_LOG_LEVEL_VERBOSE,
+        RENDER_STATE_CACHE_FILE_HASH_MODE_BY_CONTENT,
+        true, // EnableHotReload
+    };
+    // Shaders are reloaded from the same files, so they never change
+    CacheCI.pReloadSource = pShaderSourceFactory;
+
+    RefCntAutoPtr<IRenderStateCache> pCache;
+    CreateRenderStateCache(CacheCI, &pCache);
+    ASSERT_TRUE(pCache);
+
+    RefCntAutoPtr<IShader> pVS, pPS;
+    CreateGraphicsShaders(pCache, pShaderSourceFactory, SHADER_COMPILE_FLAG_NONE, pVS, pPS, false);
+    ASSERT_TRUE(pVS);
+    ASSERT_TRUE(pPS);
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    CreateGraphicsPSO(pCache, false, pVS, pPS, false, false, &pPSO);
+    ASSERT_TRUE(pPSO);
+    EXPECT_EQ(pPSO->GetGraphicsPipelineDesc().PrimitiveTopology, PRIMITIVE_TOPOLOGY_TRIANGLE_LIST);
+
+    // Without the callback, nothing needs to be reloaded
+    RenderStateCacheReloadStats Stats;
+    EXPECT_EQ(pCache->Reload(nullptr, nullptr, &Stats), 0u);
+    EXPECT_EQ(Stats.NumShadersReloaded, 0u);
+    EXPECT_EQ(Stats.NumPipelinesReloaded, 0u);
+    EXPECT_EQ(Stats.NumPipelinesSkipped, 1u);
+
+    Uint32 NumCallbackCalls = 0;
+    auto   ModifyPSO        = MakeCallback(
+        [&](const char* PipelineName, GraphicsPipelineDesc& GraphicsPipeline) {
+            EXPECT_STREQ(PipelineName, "Render State Cache Test");
+            GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_POINT_LIST;
+            ++NumCallbackCalls;
+        });
+
+    // The new pipeline is not in the cache
+    EXPECT_EQ(pCache->Reload(ModifyPSO, ModifyPSO, &Stats), 1u);
+    EXPECT_EQ(NumCallbackCalls, 1u);
+    EXPECT_EQ(Stats.NumShadersReloaded, 0u);
+    EXPECT_EQ(Stats.NumShadersSkipped, 2u);
+    EXPECT_EQ(Stats.NumPipelinesReloaded, 1u);
+    EXPECT_EQ(Stats.NumPipelinesSkipped, 0u);
+
+    ASSERT_EQ(pPSO->GetStatus(), PIPELINE_STATE_STATUS_READY);
+    EXPECT_EQ(pPSO->GetGraphicsPipelineDesc().PrimitiveTopology, PRIMITIVE_TOPOLOGY_POINT_LIST);
+}
+
 TEST(RenderStateCacheTest, GLExtensions)
 {
     auto*       pEnv       = GPUTestingEnvironment::GetInstance();
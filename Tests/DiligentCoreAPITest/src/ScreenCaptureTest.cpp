@@ -0,0 +1,265 @@
+/*
+ *  Copyright 2019-2025 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ScreenCapture.hpp"
+#include "GPUTestingEnvironment.hpp"
+#include "ThreadPool.hpp"
+#include "GraphicsAccessories.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// Clears the back buffer with the color whose red channel encodes the frame id
+// and captures it
+void CaptureFrame(ScreenCapture& Capture, Uint32 FrameId)
+{
+    GPUTestingEnvironment* pEnv       = GPUTestingEnvironment::GetInstance();
+    IDeviceContext*        pContext   = pEnv->GetDeviceContext();
+    ISwapChain*            pSwapChain = pEnv->GetSwapChain();
+
+    ITextureView* pRTV          = pSwapChain->GetCurrentBackBufferRTV();
+    const float   ClearColor[4] = {static_cast<float>(FrameId) / 255.f, 0, 0, 1};
+    pContext->SetRenderTargets(1, &pRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->ClearRenderTarget(pRTV, ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    Capture.Capture(pSwapChain, pContext, FrameId);
+}
+
+// Returns the red channel of the first pixel, or -1 if the format is not an 8-bit UNORM format
+int GetFirstPixelRed(const ScreenCapture::CapturedPixels& Pixels)
+{
+    const Uint8* pData = static_cast<const Uint8*>(Pixels.pData);
+    switch (Pixels.Format)
+    {
+        case TEX_FORMAT_RGBA8_UNORM: return pData[0];
+        case TEX_FORMAT_BGRA8_UNORM: return pData[2];
+        default: return -1;
+    }
+}
+
+size_t GetFrameSize()
+{
+    const SwapChainDesc&        SCDesc     = GPUTestingEnvironment::GetInstance()->GetSwapChain()->GetDesc();
+    const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(SCDesc.ColorBufferFormat);
+    return size_t{SCDesc.Width} * SCDesc.Height * FmtAttribs.ComponentSize * FmtAttribs.NumComponents;
+}
+
+TEST(ScreenCaptureTest, AsyncInOrder)
+{
+    GPUTestingEnvironment* pEnv     = GPUTestingEnvironment::GetInstance();
+    IDeviceContext*        pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset AutoReset;
+
+    constexpr Uint32 NumFrames = 6;
+
+    // With a single thread, the handlers run in the order the frames were handed over
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{1});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    std::mutex          FramesMtx;
+    std::vector<Uint32> FrameIds;
+    std::vector<int>    FrameReds;
+
+    ScreenCapture::AsyncModeAttribs Attribs;
+    Attribs.pThreadPool        = pThreadPool;
+    Attribs.MaxPendingCaptures = NumFrames;
+    Attribs.Handler            = [&](const ScreenCapture::CapturedPixels& Pixels) {
+        std::lock_guard<std::mutex> Lock{FramesMtx};
+        FrameIds.push_back(Pixels.Id);
+        FrameReds.push_back(GetFirstPixelRed(Pixels));
+    };
+
+    {
+        ScreenCapture Capture{pEnv->GetDevice(), Attribs};
+        for (Uint32 frame = 0; frame < NumFrames; ++frame)
+        {
+            CaptureFrame(Capture, frame);
+            Capture.ProcessCaptures(pContext);
+        }
+        Capture.Flush(pContext);
+
+        const ScreenCapture::AsyncStats Stats = Capture.GetAsyncStats();
+        EXPECT_EQ(Stats.NumProcessedFrames, NumFrames);
+        EXPECT_EQ(Stats.NumDroppedFrames, 0u);
+        EXPECT_EQ(Stats.NumFramesInFlight, 0u);
+        EXPECT_EQ(Capture.GetNumPendingCaptures(), size_t{0});
+    }
+
+    ASSERT_EQ(FrameIds.size(), size_t{NumFrames});
+    for (Uint32 frame = 0; frame < NumFrames; ++frame)
+    {
+        EXPECT_EQ(FrameIds[frame], frame);
+        if (FrameReds[frame] >= 0)
+        {
+            EXPECT_EQ(FrameReds[frame], static_cast<int>(frame));
+        }
+    }
+}
+
+TEST(ScreenCaptureTest, AsyncBufferReuse)
+{
+    GPUTestingEnvironment* pEnv     = GPUTestingEnvironment::GetInstance();
+    IDeviceContext*        pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset AutoReset;
+
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{2});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    std::atomic<Uint32> NumHandlerCalls{0};
+
+    ScreenCapture::AsyncModeAttribs Attribs;
+    Attribs.pThreadPool = pThreadPool;
+    Attribs.Handler     = [&](const ScreenCapture::CapturedPixels& Pixels) {
+        EXPECT_NE(Pixels.pData, nullptr);
+        NumHandlerCalls.fetch_add(1);
+    };
+
+    ScreenCapture Capture{pEnv->GetDevice(), Attribs};
+
+    const size_t FrameSize = GetFrameSize();
+    for (Uint32 frame = 0; frame < 4; ++frame)
+    {
+        CaptureFrame(Capture, frame);
+        Capture.Flush(pContext);
+
+        // Flush returns the buffer to the pool, so every frame reuses the buffer of the first one
+        const ScreenCapture::AsyncStats Stats = Capture.GetAsyncStats();
+        EXPECT_EQ(Stats.PixelBuffersSize, FrameSize) << "Frame " << frame;
+        EXPECT_EQ(Stats.NumProcessedFrames, frame + 1);
+        EXPECT_EQ(Stats.NumFramesInFlight, 0u);
+    }
+    EXPECT_EQ(NumHandlerCalls.load(), 4u);
+    EXPECT_EQ(Capture.GetAsyncStats().NumDroppedFrames, 0u);
+}
+
+TEST(ScreenCaptureTest, AsyncPoolExhaustion)
+{
+    GPUTestingEnvironment* pEnv     = GPUTestingEnvironment::GetInstance();
+    IDeviceContext*        pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset AutoReset;
+
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{1});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    // The handler holds the only pixel buffer until it is released
+    std::mutex              ReleaseMtx;
+    std::condition_variable ReleaseCV;
+    bool                    Release = false;
+
+    ScreenCapture::AsyncModeAttribs Attribs;
+    Attribs.pThreadPool       = pThreadPool;
+    Attribs.MaxInFlightMemory = GetFrameSize();
+    Attribs.Handler           = [&](const ScreenCapture::CapturedPixels&) {
+        std::unique_lock<std::mutex> Lock{ReleaseMtx};
+        ReleaseCV.wait(Lock, [&]() { return Release; });
+    };
+
+    ScreenCapture Capture{pEnv->GetDevice(), Attribs};
+
+    for (Uint32 frame = 0; frame < 3; ++frame)
+        CaptureFrame(Capture, frame);
+    pContext->WaitForIdle();
+
+    // The first frame takes the only buffer, the other two are dropped
+    Capture.ProcessCaptures(pContext);
+    ScreenCapture::AsyncStats Stats = Capture.GetAsyncStats();
+    EXPECT_EQ(Stats.NumFramesInFlight, 1u);
+    EXPECT_EQ(Stats.NumDroppedFrames, 2u);
+    EXPECT_EQ(Stats.NumProcessedFrames, 0u);
+    EXPECT_EQ(Stats.PixelBuffersSize, Attribs.MaxInFlightMemory);
+    EXPECT_EQ(Capture.GetNumPendingCaptures(), size_t{0});
+
+    {
+        std::lock_guard<std::mutex> Lock{ReleaseMtx};
+        Release = true;
+    }
+    ReleaseCV.notify_all();
+    Capture.Flush(pContext);
+
+    // The buffer is available again
+    CaptureFrame(Capture, 3);
+    Capture.Flush(pContext);
+
+    Stats = Capture.GetAsyncStats();
+    EXPECT_EQ(Stats.NumFramesInFlight, 0u);
+    EXPECT_EQ(Stats.NumDroppedFrames, 2u);
+    EXPECT_EQ(Stats.NumProcessedFrames, 2u);
+    EXPECT_EQ(Stats.PixelBuffersSize, Attribs.MaxInFlightMemory);
+}
+
+TEST(ScreenCaptureTest, AsyncMaxPendingCaptures)
+{
+    GPUTestingEnvironment* pEnv     = GPUTestingEnvironment::GetInstance();
+    IDeviceContext*        pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset AutoReset;
+
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{1});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    std::vector<Uint32> FrameIds;
+
+    ScreenCapture::AsyncModeAttribs Attribs;
+    Attribs.pThreadPool        = pThreadPool;
+    Attribs.MaxPendingCaptures = 2;
+    Attribs.Handler            = [&](const ScreenCapture::CapturedPixels& Pixels) {
+        // Only one thread runs the handlers
+        FrameIds.push_back(Pixels.Id);
+    };
+
+    ScreenCapture Capture{pEnv->GetDevice(), Attribs};
+
+    // Captures that exceed the limit are dropped without creating staging textures
+    for (Uint32 frame = 0; frame < 4; ++frame)
+        CaptureFrame(Capture, frame);
+    EXPECT_EQ(Capture.GetNumPendingCaptures(), size_t{2});
+    EXPECT_EQ(Capture.GetAsyncStats().NumDroppedFrames, 2u);
+
+    Capture.Flush(pContext);
+
+    const ScreenCapture::AsyncStats Stats = Capture.GetAsyncStats();
+    EXPECT_EQ(Stats.NumProcessedFrames, 2u);
+    EXPECT_EQ(Stats.NumDroppedFrames, 2u);
+    EXPECT_EQ(Capture.GetNumPendingCaptures(), size_t{0});
+    EXPECT_EQ(FrameIds, (std::vector<Uint32>{0, 1}));
+}
+
+} // namespace
@@ -89,7 +89,7 @@ Uint32 WriteOrVerifyRGBAData(MappedTextureSubresource& MappedData,
     return NumInvalidPixels;
 }
 
-void TextureUploaderTest(bool IsRenderThread)
+void TextureUploaderTest(bool IsRenderThread, bool UseTransferQueue = false)
 {
     auto* pEnv     = GPUTestingEnvironment::GetInstance();
     auto* pDevice  = pEnv->GetDevice();
@@ -100,9 +100,36 @@ void TextureUploaderTest(bool IsRenderThread)
         GTEST_SKIP() << "Texture uploader is not currently implemented in Metal";
     }
 
+    IDeviceContext* pTransferCtx = nullptr;
+    if (UseTransferQueue)
+    {
+        if (pDevice->GetDeviceInfo().Type != RENDER_DEVICE_TYPE_D3D12 && !pDevice->GetDeviceInfo().IsVulkanDevice())
+        {
+            GTEST_SKIP() << "Transfer queue uploads are only supported in Direct3D12 and Vulkan";
+        }
+        if (!pDevice->GetDeviceInfo().Features.NativeFence)
+        {
+            GTEST_SKIP() << "Transfer queue uploads require NativeFence feature";
+        }
+
+        constexpr auto QueueTypeMask = COMMAND_QUEUE_TYPE_GRAPHICS | COMMAND_QUEUE_TYPE_COMPUTE | COMMAND_QUEUE_TYPE_TRANSFER;
+        for (Uint32 CtxInd = 0; CtxInd < pEnv->GetNumImmediateContexts() && pTransferCtx == nullptr; ++CtxInd)
+        {
+            IDeviceContext* pCtx = pEnv->GetDeviceContext(CtxInd);
+            if ((pCtx->GetDesc().QueueType & QueueTypeMask) == COMMAND_QUEUE_TYPE_TRANSFER)
+                pTransferCtx = pCtx;
+        }
+        if (pTransferCtx == nullptr)
+        {
+            GTEST_SKIP() << "Transfer queue is not available";
+        }
+    }
+
     GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
 
-    TextureUploaderDesc             UploaderDesc;
+    TextureUploaderDesc UploaderDesc;
+    UploaderDesc.pTransferContext = pTransferCtx;
+
     RefCntAutoPtr<ITextureUploader> pTexUploader;
     CreateTextureUploader(pDevice, UploaderDesc, &pTexUploader);
     ASSERT_TRUE(pTexUploader);
@@ -116,6 +143,8 @@ void TextureUploaderTest(bool IsRenderThread)
     TexDesc.ArraySize = 8;
     TexDesc.BindFlags = BIND_SHADER_RESOURCE;
     TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    if (pTransferCtx != nullptr)
+        TexDesc.ImmediateContextMask = (Uint64{1} << pContext->GetDesc().ContextId) | (Uint64{1} << pTransferCtx->GetDesc().ContextId);
     RefCntAutoPtr<ITexture> pDstTexture;
     pDevice->CreateTexture(TexDesc, nullptr, &pDstTexture);
 
@@ -124,6 +153,8 @@ void TextureUploaderTest(bool IsRenderThread)
     TexDesc.Usage          = USAGE_STAGING;
     TexDesc.CPUAccessFlags = CPU_ACCESS_READ;
     TexDesc.BindFlags      = BIND_NONE;
+
+    TexDesc.ImmediateContextMask = Uint64{1} << pContext->GetDesc().ContextId;
     RefCntAutoPtr<ITexture> pStagingTexture;
     pDevice->CreateTexture(TexDesc, nullptr, &pStagingTexture);
 
@@ -220,4 +251,14 @@ TEST(TextureUploaderTest, WorkerThread)
     TextureUploaderTest(false);
 }
 
+TEST(TextureUploaderTest, TransferQueueRenderThread)
+{
+    TextureUploaderTest(true, true);
+}
+
+TEST(TextureUploaderTest, TransferQueueWorkerThread)
+{
+    TextureUploaderTest(false, true);
+}
+
 } // namespace
@@ -27,10 +27,15 @@
 #include "ImageTools.h"
 
 #include <cmath>
+#include <algorithm>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include <array>
 
+#include "ThreadPool.hpp"
+#include "FastRand.hpp"
+
 using namespace Diligent;
 
 namespace
@@ -243,4 +248,145 @@ TEST(Common_ImageTools, ComputeImageDifference)
     }
 }
 
+
+TEST(Common_ImageTools, ComputeImageDifferenceRegionMaskThreads)
+{
+    constexpr Uint32 Width  = 259;
+    constexpr Uint32 Height = 517;
+
+    FastRandInt Rnd{0, 0, 255};
+
+    std::vector<Uint8> Image1(Width * Height * 4);
+    std::vector<Uint8> Image2(Width * Height * 4);
+    std::vector<Uint8> Mask(Width * Height);
+    for (size_t i = 0; i < Image1.size(); ++i)
+    {
+        Image1[i] = static_cast<Uint8>(Rnd());
+        // Make most of the pixels equal or nearly equal
+        const int Delta = Rnd() < 64 ? Rnd() - 128 : (Rnd() < 128 ? 0 : 1);
+        Image2[i]       = static_cast<Uint8>(std::min(std::max(Image1[i] + Delta, 0), 255));
+    }
+    for (Uint8& m : Mask)
+        m = Rnd() < 32 ? 0 : 255;
+    // Fully masked rows
+    std::fill(Mask.begin() + Width * 100, Mask.begin() + Width * 200, Uint8{0});
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    auto TestDifference = [&](Uint32 NumChannels1, Uint32 NumChannels2, Uint32 NumDiffChannels, float Scale, bool UseMask,
+                              Uint32 RegionX, Uint32 RegionY, Uint32 RegionWidth, Uint32 RegionHeight) {
+        const Uint32 NumSrcChannels = std::min(NumChannels1, NumChannels2);
+        const Uint32 RegionEndX     = RegionWidth != 0 ? RegionX + RegionWidth : Width;
+        const Uint32 RegionEndY     = RegionHeight != 0 ? RegionY + RegionHeight : Height;
+
+        // Reference implementation
+        ImageDiffInfo      RefDiff;
+        std::vector<Uint8> RefDiffImage(Width * Height * NumDiffChannels);
+        double             SumDiff   = 0;
+        double             SumSqDiff = 0;
+        for (Uint32 row = 0; row < Height; ++row)
+        {
+            for (Uint32 col = 0; col < Width; ++col)
+            {
+                const bool Ignored = col < RegionX || col >= RegionEndX || row < RegionY || row >= RegionEndY ||
+                    (UseMask && Mask[col + row * Width] == 0);
+
+                Uint32 PixelDiff = 0;
+                for (Uint32 ch = 0; ch < NumDiffChannels; ++ch)
+                {
+                    Uint8 DiffVal = ch == 3 ? 255 : 0;
+                    if (ch < NumSrcChannels)
+                    {
+                        const Uint32 ChannelDiff = Ignored ? 0 :
+                                                             static_cast<Uint32>(std::abs(static_cast<int>(Image1[(col + row * Width) * NumChannels1 + ch]) -
+                                                                                          static_cast<int>(Image2[(col + row * Width) * NumChannels2 + ch])));
+                        DiffVal = static_cast<Uint8>(std::min(ChannelDiff * Scale, 255.f));
+                    }
+                    RefDiffImage[(col + row * Width) * NumDiffChannels + ch] = DiffVal;
+                }
+                for (Uint32 ch = 0; ch < NumSrcChannels && !Ignored; ++ch)
+                {
+                    PixelDiff = std::max(PixelDiff, static_cast<Uint32>(std::abs(static_cast<int>(Image1[(col + row * Width) * NumChannels1 + ch]) - static_cast<int>(Image2[(col + row * Width) * NumChannels2 + ch]))));
+                }
+
+                if (PixelDiff != 0)
+                {
+                    ++RefDiff.NumDiffPixels;
+                    if (PixelDiff > 16)
+                        ++RefDiff.NumDiffPixelsAboveThreshold;
+                    RefDiff.MaxDiff = std::max(RefDiff.MaxDiff, PixelDiff);
+                    SumDiff += PixelDiff;
+                    SumSqDiff += PixelDiff * PixelDiff;
+                }
+            }
+        }
+        if (RefDiff.NumDiffPixels > 0)
+        {
+            RefDiff.AvgDiff = static_cast<float>(SumDiff / RefDiff.NumDiffPixels);
+            RefDiff.RmsDiff = static_cast<float>(std::sqrt(SumSqDiff / RefDiff.NumDiffPixels));
+        }
+
+        for (IThreadPool* pPool : {static_cast<IThreadPool*>(nullptr), pThreadPool.RawPtr()})
+        {
+            std::vector<Uint8> DiffImage(Width * Height * NumDiffChannels, 0xCD);
+
+            ComputeImageDifferenceAttribs Attribs;
+            Attribs.Width           = Width;
+            Attribs.Height          = Height;
+            Attribs.pImage1         = Image1.data();
+            Attribs.NumChannels1    = NumChannels1;
+            Attribs.Stride1         = Width * NumChannels1;
+            Attribs.pImage2         = Image2.data();
+            Attribs.NumChannels2    = NumChannels2;
+            Attribs.Stride2         = Width * NumChannels2;
+            Attribs.Threshold       = 16;
+            Attribs.pDiffImage      = DiffImage.data();
+            Attribs.DiffStride      = Width * NumDiffChannels;
+            Attribs.NumDiffChannels = NumDiffChannels;
+            Attribs.Scale           = Scale;
+            Attribs.RegionX         = RegionX;
+            Attribs.RegionY         = RegionY;
+            Attribs.RegionWidth     = RegionWidth;
+            Attribs.RegionHeight    = RegionHeight;
+            Attribs.pMask           = UseMask ? Mask.data() : nullptr;
+            Attribs.MaskStride      = Width;
+            Attribs.pThreadPool     = pPool;
+
+            ImageDiffInfo Diff;
+            ComputeImageDifference(Attribs, Diff);
+            EXPECT_EQ(Diff.NumDiffPixels, RefDiff.NumDiffPixels);
+            EXPECT_EQ(Diff.NumDiffPixelsAboveThreshold, RefDiff.NumDiffPixelsAboveThreshold);
+            EXPECT_EQ(Diff.MaxDiff, RefDiff.MaxDiff);
+            EXPECT_FLOAT_EQ(Diff.AvgDiff, RefDiff.AvgDiff);
+            EXPECT_FLOAT_EQ(Diff.RmsDiff, RefDiff.RmsDiff);
+            EXPECT_EQ(DiffImage, RefDiffImage);
+
+            // Statistics only
+            ImageDiffInfo Diff2;
+            Attribs.pDiffImage = nullptr;
+            ComputeImageDifference(Attribs, Diff2);
+            EXPECT_EQ(Diff2.NumDiffPixels, RefDiff.NumDiffPixels);
+            EXPECT_EQ(Diff2.NumDiffPixelsAboveThreshold, RefDiff.NumDiffPixelsAboveThreshold);
+            EXPECT_EQ(Diff2.MaxDiff, RefDiff.MaxDiff);
+            EXPECT_FLOAT_EQ(Diff2.AvgDiff, RefDiff.AvgDiff);
+            EXPECT_FLOAT_EQ(Diff2.RmsDiff, RefDiff.RmsDiff);
+        }
+    };
+
+    for (bool UseMask : {false, true})
+    {
+        TestDifference(4, 4, 4, 1.f, UseMask, 0, 0, 0, 0);
+        TestDifference(4, 4, 4, 4.f, UseMask, 0, 0, 0, 0);
+        TestDifference(4, 4, 3, 1.f, UseMask, 0, 0, 0, 0);
+        TestDifference(3, 3, 3, 1.f, UseMask, 0, 0, 0, 0);
+        TestDifference(3, 3, 4, 2.f, UseMask, 0, 0, 0, 0);
+        TestDifference(4, 3, 4, 1.f, UseMask, 0, 0, 0, 0);
+        TestDifference(1, 1, 1, 1.f, UseMask, 0, 0, 0, 0);
+        TestDifference(4, 4, 4, 1.f, UseMask, 17, 33, 101, 250);
+        TestDifference(3, 4, 4, 1.f, UseMask, 3, 450, 0, 0);
+        TestDifference(4, 4, 4, 1.f, UseMask, Width, Height, 0, 0);
+    }
+}
+
 } // namespace
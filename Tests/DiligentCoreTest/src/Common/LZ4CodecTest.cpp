@@ -0,0 +1,152 @@
+/*
+ *  Copyright 2019-2025 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <string>
+
+#include "LZ4Codec.hpp"
+#include "BasicTypes.h"
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+std::vector<Uint8> Compress(const std::vector<Uint8>& Src)
+{
+    std::vector<Uint8> Compressed(LZ4CompressBound(Src.size()));
+
+    const size_t CompressedSize = LZ4CompressBlock(Src.data(), Src.size(), Compressed.data(), Compressed.size());
+    EXPECT_GT(CompressedSize, size_t{0});
+    Compressed.resize(CompressedSize);
+    return Compressed;
+}
+
+void TestRoundTrip(const std::vector<Uint8>& Src)
+{
+    const std::vector<Uint8> Compressed = Compress(Src);
+
+    std::vector<Uint8> Decompressed(Src.size());
+    EXPECT_TRUE(LZ4DecompressBlock(Compressed.data(), Compressed.size(), Decompressed.data(), Decompressed.size()));
+    EXPECT_EQ(Decompressed, Src);
+}
+
+TEST(Common_LZ4Codec, RoundTrip)
+{
+    TestRoundTrip({});
+
+    for (size_t Size : {1, 5, 12, 13, 16, 100})
+        TestRoundTrip(std::vector<Uint8>(Size, Uint8{42}));
+
+    // Repeating text
+    {
+        std::string Text;
+        for (int i = 0; i < 1000; ++i)
+            Text += "OpCapability Shader; OpMemoryModel Logical GLSL450; %" + std::to_string(i) + " = OpTypeFloat 32\n";
+        const std::vector<Uint8> Src{Text.begin(), Text.end()};
+        TestRoundTrip(Src);
+        EXPECT_LT(Compress(Src).size(), Src.size() / 4);
+    }
+
+    // Random data that does not compress
+    {
+        FastRandInt        Rnd{0, 0, 255};
+        std::vector<Uint8> Src(100000);
+        for (Uint8& Byte : Src)
+            Byte = static_cast<Uint8>(Rnd());
+        TestRoundTrip(Src);
+        EXPECT_LE(Compress(Src).size(), LZ4CompressBound(Src.size()));
+    }
+
+    // Random data with long matches at various distances
+    {
+        FastRandInt        Rnd{1, 0, 255};
+        std::vector<Uint8> Src;
+        while (Src.size() < 300000)
+        {
+            const int Mode = Rnd() % 3;
+            if (Mode == 0 || Src.size() < 16)
+            {
+                for (int i = Rnd() % 64; i >= 0; --i)
+                    Src.push_back(static_cast<Uint8>(Rnd()));
+            }
+            else
+            {
+                const size_t Dist = 1 + static_cast<size_t>(Rnd() * 257 + Rnd()) % std::min(Src.size(), size_t{70000});
+                const size_t Len  = 4 + static_cast<size_t>(Rnd()) * (Mode == 1 ? 1 : 8);
+                for (size_t i = 0; i < Len; ++i)
+                    Src.push_back(Src[Src.size() - Dist]);
+            }
+        }
+        TestRoundTrip(Src);
+    }
+}
+
+TEST(Common_LZ4Codec, InsufficientCapacity)
+{
+    FastRandInt        Rnd{3, 0, 255};
+    std::vector<Uint8> Src(1000);
+    for (Uint8& Byte : Src)
+        Byte = static_cast<Uint8>(Rnd());
+
+    std::vector<Uint8> Dst(Src.size() / 2);
+    EXPECT_EQ(LZ4CompressBlock(Src.data(), Src.size(), Dst.data(), Dst.size()), size_t{0});
+}
+
+TEST(Common_LZ4Codec, MalformedInput)
+{
+    std::string Text;
+    for (int i = 0; i < 200; ++i)
+        Text += "layout(location = " + std::to_string(i % 8) + ") in vec4 Attrib;\n";
+    const std::vector<Uint8> Src{Text.begin(), Text.end()};
+    const std::vector<Uint8> Compressed = Compress(Src);
+
+    std::vector<Uint8> Dst(Src.size());
+
+    // Wrong decompressed size
+    EXPECT_FALSE(LZ4DecompressBlock(Compressed.data(), Compressed.size(), Dst.data(), Dst.size() - 1));
+    Dst.resize(Src.size() + 1);
+    EXPECT_FALSE(LZ4DecompressBlock(Compressed.data(), Compressed.size(), Dst.data(), Dst.size()));
+    Dst.resize(Src.size());
+
+    // Truncated data
+    for (size_t Size = 0; Size < Compressed.size(); ++Size)
+        EXPECT_FALSE(LZ4DecompressBlock(Compressed.data(), Size, Dst.data(), Dst.size()));
+
+    // Corrupted data must never cause out-of-bounds access
+    FastRandInt Rnd{2, 0, 255};
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::vector<Uint8> Corrupted        = Compressed;
+        Corrupted[Rnd() % Corrupted.size()] = static_cast<Uint8>(Rnd());
+        LZ4DecompressBlock(Corrupted.data(), Corrupted.size(), Dst.data(), Dst.size());
+    }
+}
+
+} // namespace
@@ -30,6 +30,8 @@
 
 #include "BasicMath.hpp"
 #include "AdvancedMath.hpp"
+#include "FastRand.hpp"
+#include "ThreadPool.hpp"
 
 #include "gtest/gtest.h"
 
@@ -2904,6 +2906,148 @@ TEST(Common_AdvancedMath, GetOrientedBoxVisibilityAgainstPlane)
     }
 }
 
+namespace
+{
+
+struct BoxesVisibilityTestData
+{
+    explicit BoxesVisibilityTestData(size_t NumBoxes)
+    {
+        ExtractViewFrustumPlanesFromMatrix(float4x4::RotationY(0.5f) * float4x4::Translation(1, 2, 20) * float4x4::Projection(PI_F / 3.f, 1.5f, 1.f, 50.f, false), Frustum, false);
+
+        FastRandFloat Rnd{0, -40.f, 40.f};
+        FastRandFloat RndSize{1, 0.f, 8.f};
+        FastRandFloat RndAngle{2, -PI_F, PI_F};
+
+        AABBs.resize(NumBoxes);
+        OBBs.resize(NumBoxes);
+        for (size_t i = 0; i < NumBoxes; ++i)
+        {
+            const float3 Center{Rnd(), Rnd(), Rnd()};
+            const float3 HalfSize{RndSize(), RndSize(), RndSize()};
+
+            AABBs[i] = BoundBox{Center - HalfSize, Center + HalfSize};
+
+            const float3x3 Rotation = float3x3::RotationX(RndAngle()) * float3x3::RotationY(RndAngle());
+
+            OBBs[i].Center = Center;
+            for (Uint32 a = 0; a < 3; ++a)
+            {
+                OBBs[i].Axes[a]        = float3{Rotation[a][0], Rotation[a][1], Rotation[a][2]};
+                OBBs[i].HalfExtents[a] = HalfSize[a];
+            }
+        }
+
+        Data.resize(NumBoxes * 21);
+        float* pData = Data.data();
+        auto   Next  = [&]() {
+            float* pArray = pData;
+            pData += NumBoxes;
+            return pArray;
+        };
+
+        // 21 arrays: min, max, center, 3 axes and half extents
+        float* pMin[3]         = {Next(), Next(), Next()};
+        float* pMax[3]         = {Next(), Next(), Next()};
+        float* pCenter[3]      = {Next(), Next(), Next()};
+        float* pAxes[3][3]     = {{Next(), Next(), Next()}, {Next(), Next(), Next()}, {Next(), Next(), Next()}};
+        float* pHalfExtents[3] = {Next(), Next(), Next()};
+        for (size_t i = 0; i < NumBoxes; ++i)
+        {
+            for (Uint32 c = 0; c < 3; ++c)
+            {
+                pMin[c][i]         = AABBs[i].Min[c];
+                pMax[c][i]         = AABBs[i].Max[c];
+                pCenter[c][i]      = OBBs[i].Center[c];
+                pHalfExtents[c][i] = OBBs[i].HalfExtents[c];
+                for (Uint32 a = 0; a < 3; ++a)
+                    pAxes[a][c][i] = OBBs[i].Axes[a][c];
+            }
+        }
+
+        AABBsSoA.MinX = pMin[0];
+        AABBsSoA.MinY = pMin[1];
+        AABBsSoA.MinZ = pMin[2];
+        AABBsSoA.MaxX = pMax[0];
+        AABBsSoA.MaxY = pMax[1];
+        AABBsSoA.MaxZ = pMax[2];
+
+        OBBsSoA.CenterX = pCenter[0];
+        OBBsSoA.CenterY = pCenter[1];
+        OBBsSoA.CenterZ = pCenter[2];
+        for (Uint32 a = 0; a < 3; ++a)
+        {
+            OBBsSoA.AxisX[a]       = pAxes[a][0];
+            OBBsSoA.AxisY[a]       = pAxes[a][1];
+            OBBsSoA.AxisZ[a]       = pAxes[a][2];
+            OBBsSoA.HalfExtents[a] = pHalfExtents[a];
+        }
+    }
+
+    template <typename BoxType, typename BoxesSoAType>
+    void Verify(const std::vector<BoxType>& Boxes, const BoxesSoAType& BoxesSoA, IThreadPool* pThreadPool) const
+    {
+        const size_t NumBoxes = Boxes.size();
+        for (FRUSTUM_PLANE_FLAGS PlaneFlags : {FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, FRUSTUM_PLANE_FLAG_OPEN_NEAR, FRUSTUM_PLANE_FLAG_LEFT_PLANE, FRUSTUM_PLANE_FLAG_NONE})
+        {
+            std::vector<BoxVisibility> Visibility(NumBoxes);
+            std::vector<Uint32>        VisibleMask((NumBoxes + 31) / 32, ~0u);
+            if (pThreadPool != nullptr)
+                GetBoxesVisibilityParallel(pThreadPool, Frustum, BoxesSoA, NumBoxes, Visibility.data(), VisibleMask.data(), PlaneFlags, 256);
+            else
+                GetBoxesVisibility(Frustum, BoxesSoA, NumBoxes, Visibility.data(), VisibleMask.data(), PlaneFlags);
+
+            size_t NumVisible = 0;
+            for (size_t i = 0; i < NumBoxes; ++i)
+            {
+                const BoxVisibility RefVisibility = GetBoxVisibility(Frustum, Boxes[i], PlaneFlags);
+                EXPECT_EQ(Visibility[i], RefVisibility) << "Box " << i;
+                const bool IsVisible = (VisibleMask[i / 32] & (1u << (i % 32))) != 0;
+                EXPECT_EQ(IsVisible, RefVisibility != BoxVisibility::Invisible) << "Box " << i;
+                NumVisible += IsVisible ? 1 : 0;
+            }
+            if (PlaneFlags != FRUSTUM_PLANE_FLAG_NONE && NumBoxes > 100)
+            {
+                // Make sure that the test data is not degenerate
+                EXPECT_GT(NumVisible, size_t{0});
+                EXPECT_LT(NumVisible, NumBoxes);
+            }
+            // Unused bits of the last mask word must be zero
+            if (NumBoxes % 32 != 0)
+                EXPECT_EQ(VisibleMask.back() >> (NumBoxes % 32), 0u);
+        }
+    }
+
+    ViewFrustum                      Frustum;
+    std::vector<BoundBox>            AABBs;
+    std::vector<OrientedBoundingBox> OBBs;
+    BoundBoxesSoA                    AABBsSoA;
+    OrientedBoundingBoxesSoA         OBBsSoA;
+    std::vector<float>               Data;
+};
+
+} // namespace
+
+TEST(Common_AdvancedMath, GetBoxesVisibility)
+{
+    for (size_t NumBoxes : {1, 7, 32, 1003})
+    {
+        BoxesVisibilityTestData TestData{NumBoxes};
+        TestData.Verify(TestData.AABBs, TestData.AABBsSoA, nullptr);
+        TestData.Verify(TestData.OBBs, TestData.OBBsSoA, nullptr);
+    }
+}
+
+TEST(Common_AdvancedMath, GetBoxesVisibilityParallel)
+{
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    BoxesVisibilityTestData TestData{10001};
+    TestData.Verify(TestData.AABBs, TestData.AABBsSoA, pThreadPool);
+    TestData.Verify(TestData.OBBs, TestData.OBBsSoA, pThreadPool);
+}
+
 TEST(Common_AdvancedMath, GetPointToBoxDistance)
 {
     BoundBox Box{float3{1, 2, 3}, float3{4, 5, 6}};
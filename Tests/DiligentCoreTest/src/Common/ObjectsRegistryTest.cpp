@@ -30,6 +30,9 @@
 
 #include <thread>
 #include <functional>
+#include <chrono>
+#include <vector>
+#include <algorithm>
 
 #include "ObjectBase.hpp"
 #include "ThreadSignal.hpp"
@@ -244,4 +247,129 @@ TEST(Common_ObjectsRegistry, Exceptions_RefCntAutoPtr)
     TestObjectRegistryExceptions<RefCntAutoPtr, RegistryDataObj>();
 }
 
+
+template <template <typename T> class StrongPtrType, typename DataType>
+void TestObjectRegistryPurge()
+{
+    // Check all buckets of a shard on every other addition
+    ObjectsRegistry<int, StrongPtrType<DataType>> Registry{2, 4};
+
+    constexpr int                        NumKeys = 1024;
+    std::vector<StrongPtrType<DataType>> Data(NumKeys);
+    for (int i = 0; i < NumKeys; ++i)
+    {
+        auto pData = Registry.Get(i, std::bind(DataType::Create, static_cast<Uint32>(i)));
+        ASSERT_NE(pData, nullptr);
+        // Keep every third object alive
+        if (i % 3 == 0)
+            Data[i] = pData;
+    }
+
+    for (int i = 0; i < NumKeys; ++i)
+    {
+        auto pData = Registry.Get(i);
+        if (i % 3 == 0)
+            EXPECT_EQ(pData, Data[i]);
+        else
+            EXPECT_EQ(pData, nullptr);
+    }
+
+    int NumElements = 0;
+    Registry.ProcessElements([&](int Key, const DataType& Obj) {
+        EXPECT_EQ(Key % 3, 0);
+        EXPECT_EQ(Obj.Value, static_cast<Uint32>(Key));
+        ++NumElements;
+    });
+    EXPECT_EQ(NumElements, (NumKeys + 2) / 3);
+
+    Registry.Purge();
+    for (int i = 0; i < NumKeys; i += 3)
+        EXPECT_EQ(Registry.Get(i), Data[i]);
+
+    // Expired objects are recreated
+    for (int i = 1; i < NumKeys; i += 3)
+    {
+        auto pData = Registry.Get(i, std::bind(DataType::Create, static_cast<Uint32>(i + NumKeys)));
+        ASSERT_NE(pData, nullptr);
+        EXPECT_EQ(pData->Value, static_cast<Uint32>(i + NumKeys));
+    }
+
+    Registry.Clear();
+    EXPECT_EQ(Registry.Get(0), nullptr);
+}
+
+TEST(Common_ObjectsRegistry, Purge_SharedPtr)
+{
+    TestObjectRegistryPurge<std::shared_ptr, RegistryData>();
+}
+
+TEST(Common_ObjectsRegistry, Purge_RefCntAutoPtr)
+{
+    TestObjectRegistryPurge<RefCntAutoPtr, RegistryDataObj>();
+}
+
+
+template <template <typename T> class StrongPtrType, typename DataType>
+void TestObjectRegistryContention()
+{
+#ifdef DILIGENT_DEBUG
+    constexpr Uint32 NumIterations = 20000;
+#else
+    constexpr Uint32 NumIterations = 200000;
+#endif
+    constexpr Uint32 NumKeys    = 64;
+    const Uint32     NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+
+    ObjectsRegistry<Uint32, StrongPtrType<DataType>> Registry;
+
+    // Keep half of the objects alive so that the other half is constantly recreated
+    std::vector<StrongPtrType<DataType>> Data(NumKeys / 2);
+    for (Uint32 i = 0; i < Data.size(); ++i)
+        Data[i] = Registry.Get(i * 2, std::bind(DataType::Create, i * 2));
+
+    std::vector<std::thread> Threads(NumThreads);
+    Threading::Signal        StartSignal;
+    for (Uint32 i = 0; i < NumThreads; ++i)
+    {
+        Threads[i] = std::thread(
+            [&](Uint32 ThreadId) {
+                StartSignal.Wait();
+                for (Uint32 j = 0; j < NumIterations; ++j)
+                {
+                    const Uint32 Key = (j * 7 + ThreadId) % NumKeys;
+
+                    auto pData = (j % 4 == 0) ?
+                        Registry.Get(Key) :
+                        Registry.Get(Key, std::bind(DataType::Create, Key));
+                    if (pData)
+                        EXPECT_EQ(pData->Value, Key);
+                    else
+                        EXPECT_TRUE(j % 4 == 0 && Key % 2 == 1);
+                }
+            },
+            i);
+    }
+
+    const auto StartTime = std::chrono::high_resolution_clock::now();
+    StartSignal.Trigger(true);
+    for (auto& T : Threads)
+        T.join();
+    const auto   EndTime = std::chrono::high_resolution_clock::now();
+    const double Time    = std::chrono::duration_cast<std::chrono::duration<double>>(EndTime - StartTime).count();
+
+    const double NumRequests = static_cast<double>(NumThreads) * NumIterations;
+    LOG_INFO_MESSAGE("Performed ", NumThreads * NumIterations, " registry requests on ", NumThreads, " threads in ",
+                     Time * 1000, " ms (", NumRequests / Time / 1e6, " M requests/s)");
+}
+
+TEST(Common_ObjectsRegistry, Contention_SharedPtr)
+{
+    TestObjectRegistryContention<std::shared_ptr, RegistryData>();
+}
+
+TEST(Common_ObjectsRegistry, Contention_RefCntAutoPtr)
+{
+    TestObjectRegistryContention<RefCntAutoPtr, RegistryDataObj>();
+}
+
 } // namespace
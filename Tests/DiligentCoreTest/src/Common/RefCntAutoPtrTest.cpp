@@ -30,6 +30,8 @@
 #include <mutex>
 #include <condition_variable>
 #include <algorithm>
+#include <chrono>
+#include <vector>
 
 #include "DefaultRawMemoryAllocator.hpp"
 #include "RefCntAutoPtr.hpp"
@@ -753,46 +755,22 @@ void RefCntAutoPtrThreadingTest::WorkerThreadFunc(RefCntAutoPtrThreadingTest* Th
             }
 
             {
-                // Test interferences of ReleaseStrongRef() and QueryObject()
+                // Test interferences of ReleaseStrongRef() and weak-to-strong promotion.
 
-                // Goal: catch scenario when QueryObject() runs between
-                // AtomicDecrement() and acquiring the lock in ReleaseStrongRef():
+                // Goal: catch the scenario when RefCntWeakPtr::Lock() runs concurrently
+                // with the release of the last strong reference:
 
-                //                       m_lNumStrongReferences == 1
+                //                       m_NumStrongReferences == 1
                 //
-
-                //                                   Scenario I
-                //
-                //             Thread 1                 |                  Thread 2             |            Thread 3
-                //                                      |                                       |
-                //                                      |                                       |
-                //                                      |                                       |
-                //                                      |   1. Acquire the lock                 |
-                //                                      |   2. Increment m_lNumStrongReferences |
-                // 1. Decrement m_lNumStrongReferences  |   3. Read StrongRefCnt > 1            |
-                // 2. Test RefCount!=0                  |   4. Return the reference to object   |
-                // 3. DO NOT destroy the object         |                                       |
-                // 4. Wait for the lock                 |                                       |
-
-
-                //                                   Scenario I
+                //             Thread 1                 |                  Thread 2
+                //                                      |
+                // 1. Decrement m_NumStrongReferences   |
+                // 2. Test RefCount==0                  |   1. Read m_NumStrongReferences == 0
+                // 3. Destroy the object                |   2. DO NOT increment the counter
+                //                                      |   3. Return null
                 //
-                //             Thread 1                 |                  Thread 2             |            Thread 3
-                //                                      |                                       |
-                //                                      |                                       |
-                // 1. Decrement m_lNumStrongReferences  |                                       |
-                //                                      |   1. Acquire the lock                 |
-                // 2. Test RefCount==0                  |   2. Increment m_lNumStrongReferences |
-                // 3. Start destroying the object       |   3. Read StrongRefCnt == 1           |
-                // 4. Wait for the lock                 |   4. DO NOT create the object         |
-                //                                      |   5. Decrement m_lNumStrongReferences |
-                //                                      |                                       | 1. Acquire the lock
-                //                                      |                                       | 2. Increment m_lNumStrongReferences
-                //                                      |                                       | 3. Read StrongRefCnt == 1
-                //                                      |                                       | 4. DO NOT create the object
-                //                                      |                                       | 5. Decrement m_lNumStrongReferences
-                // 5. Acquire the lock                  |
-                // 6. DESTROY the object                |
+                // If Thread 2 increments the counter first, Thread 1 reads RefCount > 0
+                // and the object is destroyed when Thread 2 releases its reference.
 
                 This->m_WorkerThreadSignal[0].Wait(true, NumThreads);
                 auto* pObject = This->m_pSharedObject;
@@ -904,4 +882,114 @@ TEST(Common_RefCntAutoPtr, Threading)
     ThreadingTest.RunConcurrencyTest();
 }
 
+TEST(Common_RefCntWeakPtr, LockContention)
+{
+#ifdef DILIGENT_DEBUG
+    static const int NumLockIterations    = 10000;
+    static const int NumReleaseIterations = 100;
+#else
+    static const int NumLockIterations    = 100000;
+    static const int NumReleaseIterations = 1000;
+#endif
+    const size_t NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+
+    class TrackedObject : public Object
+    {
+    public:
+        TrackedObject(IReferenceCounters* pRefCounters, std::atomic_int& NumDestroyed) :
+            Object{pRefCounters},
+            m_NumDestroyed{NumDestroyed}
+        {}
+
+        ~TrackedObject()
+        {
+            m_NumDestroyed.fetch_add(1);
+        }
+
+    private:
+        std::atomic_int& m_NumDestroyed;
+    };
+
+    // All threads promote the same weak pointer while the object is alive
+    {
+        std::atomic_int NumDestroyed{0};
+        SmartPtr        spObj{MakeNewRCObj<TrackedObject>{}(NumDestroyed)};
+        WeakPtr         wpObj{spObj};
+
+        std::atomic_int NumFailed{0};
+
+        const auto StartTime = std::chrono::high_resolution_clock::now();
+
+        std::vector<std::thread> Threads(NumThreads);
+        for (auto& t : Threads)
+        {
+            t = std::thread{[&]() {
+                for (int i = 0; i < NumLockIterations; ++i)
+                {
+                    if (!wpObj.Lock())
+                        NumFailed.fetch_add(1);
+                }
+            }};
+        }
+        for (auto& t : Threads)
+            t.join();
+
+        const auto   EndTime = std::chrono::high_resolution_clock::now();
+        const double Time    = std::chrono::duration_cast<std::chrono::duration<double>>(EndTime - StartTime).count();
+
+        EXPECT_EQ(NumFailed, 0);
+        EXPECT_EQ(spObj->GetReferenceCounters()->GetNumStrongRefs(), 1);
+        EXPECT_EQ(spObj->GetReferenceCounters()->GetNumWeakRefs(), 1);
+
+        LOG_INFO_MESSAGE("Performed ", NumThreads * NumLockIterations, " weak pointer locks on ", NumThreads, " threads in ",
+                         Time * 1000, " ms (", static_cast<double>(NumThreads * NumLockIterations) / Time / 1e6, " M locks/s)");
+
+        spObj.Release();
+        EXPECT_EQ(NumDestroyed, 1);
+        EXPECT_FALSE(wpObj.IsValid());
+        EXPECT_FALSE(wpObj.Lock());
+    }
+
+    // The last strong reference is released while other threads are promoting weak pointers
+    {
+        std::atomic_int NumDestroyed{0};
+        for (int i = 0; i < NumReleaseIterations; ++i)
+        {
+            SmartPtr spObj{MakeNewRCObj<TrackedObject>{}(NumDestroyed)};
+
+            std::atomic_int          NumReady{0};
+            std::vector<std::thread> Threads(NumThreads);
+            for (auto& t : Threads)
+            {
+                t = std::thread{[&](WeakPtr wpObj) {
+                                    NumReady.fetch_add(1);
+                                    while (NumReady.load() < static_cast<int>(NumThreads) + 1)
+                                        std::this_thread::yield();
+
+                                    for (int j = 0; j < 100; ++j)
+                                    {
+                                        auto spLocked = wpObj.Lock();
+                                        if (!spLocked)
+                                            break;
+                                        // The object must remain alive while we hold the strong reference
+                                        EXPECT_EQ(NumDestroyed.load(), i);
+                                        spLocked->m_Value++;
+                                    }
+                                },
+                                WeakPtr{spObj}};
+            }
+
+            NumReady.fetch_add(1);
+            while (NumReady.load() < static_cast<int>(NumThreads) + 1)
+                std::this_thread::yield();
+            spObj.Release();
+
+            for (auto& t : Threads)
+                t.join();
+
+            ASSERT_EQ(NumDestroyed, i + 1);
+        }
+    }
+}
+
 } // namespace
@@ -30,6 +30,7 @@
 
 #include <array>
 #include <cmath>
+#include <vector>
 
 #include "ThreadSignal.hpp"
 
@@ -442,4 +443,37 @@ TEST(Common_ThreadPool, ReRunTasks)
         EXPECT_EQ(ReRunCounters[i], 0) << i;
 }
 
+
+TEST(Common_ThreadPool, ProcessRangeInParallel)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    auto TestRange = [](IThreadPool* pPool, Uint32 NumItems, Uint32 MinItemsPerTask) {
+        std::vector<std::atomic<Uint32>> Counters(NumItems);
+        for (std::atomic<Uint32>& Counter : Counters)
+            Counter.store(0);
+
+        ProcessRangeInParallel(pPool, NumItems, MinItemsPerTask,
+                               [&Counters](Uint32 Start, Uint32 End) {
+                                   EXPECT_LE(Start, End);
+                                   for (Uint32 i = Start; i < End; ++i)
+                                       Counters[i].fetch_add(1);
+                               });
+
+        for (Uint32 i = 0; i < NumItems; ++i)
+            EXPECT_EQ(Counters[i].load(), 1u) << "NumItems=" << NumItems << " MinItemsPerTask=" << MinItemsPerTask << " i=" << i;
+    };
+
+    for (IThreadPool* pPool : {static_cast<IThreadPool*>(nullptr), pThreadPool.RawPtr()})
+    {
+        TestRange(pPool, 0, 1);
+        TestRange(pPool, 1, 1);
+        TestRange(pPool, 7, 0);
+        TestRange(pPool, 100, 3);
+        TestRange(pPool, 1000, 1);
+        TestRange(pPool, 1025, 16);
+    }
+}
+
 } // namespace
@@ -0,0 +1,142 @@
+/*
+ *  Copyright 2019-2025 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "DescriptorIndexAllocator.hpp"
+#include "TestingEnvironment.hpp"
+
+#include <thread>
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(GraphicsAccessories_DescriptorIndexAllocator, AllocateRelease)
+{
+    DescriptorIndexAllocator Allocator{4};
+    EXPECT_EQ(Allocator.GetCapacity(), 4u);
+
+    for (Uint32 i = 0; i < 4; ++i)
+        EXPECT_EQ(Allocator.Allocate(), i);
+    EXPECT_EQ(Allocator.Allocate(), DescriptorIndexAllocator::InvalidIndex);
+    EXPECT_EQ(Allocator.GetAllocatedCount(), 4u);
+
+    Allocator.Release(1, 10);
+    Allocator.Release(3, 11);
+    EXPECT_EQ(Allocator.GetAllocatedCount(), 2u);
+    EXPECT_EQ(Allocator.GetStaleCount(), 2u);
+
+    // Released indices must not be reused until the fence is completed
+    EXPECT_EQ(Allocator.Allocate(), DescriptorIndexAllocator::InvalidIndex);
+
+    Allocator.ReleaseCompleted(9);
+    EXPECT_EQ(Allocator.GetStaleCount(), 2u);
+    EXPECT_EQ(Allocator.Allocate(), DescriptorIndexAllocator::InvalidIndex);
+
+    Allocator.ReleaseCompleted(10);
+    EXPECT_EQ(Allocator.GetStaleCount(), 1u);
+    EXPECT_EQ(Allocator.Allocate(), 1u);
+    EXPECT_EQ(Allocator.Allocate(), DescriptorIndexAllocator::InvalidIndex);
+
+    Allocator.ReleaseCompleted(100);
+    EXPECT_EQ(Allocator.GetStaleCount(), 0u);
+    EXPECT_EQ(Allocator.Allocate(), 3u);
+    EXPECT_EQ(Allocator.GetAllocatedCount(), 4u);
+
+    for (Uint32 i = 0; i < 4; ++i)
+        Allocator.Release(i, 101);
+    EXPECT_EQ(Allocator.GetAllocatedCount(), 0u);
+}
+
+TEST(GraphicsAccessories_DescriptorIndexAllocator, DoubleRelease)
+{
+    DescriptorIndexAllocator Allocator{2};
+    EXPECT_EQ(Allocator.Allocate(), 0u);
+    EXPECT_EQ(Allocator.Allocate(), 1u);
+
+    Allocator.Release(0, 1);
+#ifdef DILIGENT_DEBUG
+    {
+        TestingEnvironment::ErrorScope ExpectedErrors{"has already been released"};
+        Allocator.Release(0, 1);
+    }
+#endif
+    // The second release must not affect the allocator state
+    EXPECT_EQ(Allocator.GetAllocatedCount(), 1u);
+    EXPECT_EQ(Allocator.GetStaleCount(), 1u);
+
+    Allocator.ReleaseCompleted(1);
+    EXPECT_EQ(Allocator.Allocate(), 0u);
+    EXPECT_EQ(Allocator.Allocate(), DescriptorIndexAllocator::InvalidIndex);
+
+    Allocator.Release(0, 2);
+    Allocator.Release(1, 2);
+    Allocator.ReleaseCompleted(2);
+}
+
+TEST(GraphicsAccessories_DescriptorIndexAllocator, MultithreadedAllocation)
+{
+    constexpr Uint32 NumThreads          = 8;
+    constexpr Uint32 NumIndicesPerThread = 256;
+
+    DescriptorIndexAllocator Allocator{NumThreads * NumIndicesPerThread};
+
+    std::vector<std::vector<Uint32>> ThreadIndices(NumThreads);
+    std::vector<std::thread>         Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back(
+            [&Allocator, &Indices = ThreadIndices[t]]() {
+                for (Uint32 i = 0; i < NumIndicesPerThread; ++i)
+                    Indices.push_back(Allocator.Allocate());
+            });
+    }
+    for (std::thread& Thread : Threads)
+        Thread.join();
+
+    std::vector<Uint32> AllIndices;
+    for (const std::vector<Uint32>& Indices : ThreadIndices)
+        AllIndices.insert(AllIndices.end(), Indices.begin(), Indices.end());
+    std::sort(AllIndices.begin(), AllIndices.end());
+    ASSERT_EQ(AllIndices.size(), size_t{NumThreads * NumIndicesPerThread});
+    for (Uint32 i = 0; i < AllIndices.size(); ++i)
+        EXPECT_EQ(AllIndices[i], i);
+
+    EXPECT_EQ(Allocator.Allocate(), DescriptorIndexAllocator::InvalidIndex);
+
+    for (Uint32 Idx : AllIndices)
+        Allocator.Release(Idx, 1);
+    Allocator.ReleaseCompleted(1);
+    EXPECT_EQ(Allocator.GetAllocatedCount(), 0u);
+    EXPECT_EQ(Allocator.GetStaleCount(), 0u);
+}
+
+} // namespace
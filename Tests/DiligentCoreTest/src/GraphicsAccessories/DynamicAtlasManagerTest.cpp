@@ -465,4 +465,216 @@ TEST(GraphicsAccessories_DynamicAtlasManager, AllocateRandom)
     }
 }
 
+TEST(GraphicsAccessories_DynamicAtlasManager, AllocateSkyline)
+{
+    constexpr auto Skyline = DynamicAtlasManager::PackingMode::Skyline;
+    {
+        DynamicAtlasManager Mgr{16, 8, Skyline};
+        EXPECT_TRUE(Mgr.IsEmpty());
+        EXPECT_EQ(Mgr.GetFreeRegionCount(), 1U);
+
+        auto R = Mgr.Allocate(16, 8);
+        EXPECT_EQ(R, Region(0, 0, 16, 8));
+        EXPECT_FALSE(Mgr.IsEmpty());
+        EXPECT_EQ(Mgr.GetFreeRegionCount(), 0U);
+        EXPECT_TRUE(Mgr.Allocate(1, 1).IsEmpty());
+        Mgr.Free(std::move(R));
+        EXPECT_TRUE(Mgr.IsEmpty());
+        EXPECT_EQ(Mgr.GetFreeRegionCount(), 1U);
+    }
+
+    {
+        DynamicAtlasManager Mgr{64, 64, Skyline};
+
+        auto R0 = Mgr.Allocate(32, 16);
+        auto R1 = Mgr.Allocate(16, 8);
+        auto R2 = Mgr.Allocate(16, 24);
+        auto R3 = Mgr.Allocate(16, 8);
+        //  ________________________________
+        // |                                |
+        // |                        ________|
+        // |                       |        |
+        // |_______________ _______|   R2   |
+        // |               |  R3   |        |
+        // |      R0       |_______|        |
+        // |               |  R1   |        |
+        // |_______________|_______|________|
+        EXPECT_EQ(R0, Region(0, 0, 32, 16));
+        EXPECT_EQ(R1, Region(32, 0, 16, 8));
+        EXPECT_EQ(R2, Region(48, 0, 16, 24));
+        EXPECT_EQ(R3, Region(32, 8, 16, 8));
+        EXPECT_EQ(Mgr.GetFreeRegionCount(), 2U);
+
+        // R3 lies on top of R1, so freeing R1 does not change the skyline
+        Mgr.Free(std::move(R1));
+        auto R4 = Mgr.Allocate(16, 8);
+        EXPECT_EQ(R4, Region(0, 16, 16, 8));
+
+        // Freeing R3 reclaims the space previously occupied by R1
+        Mgr.Free(std::move(R3));
+        auto R5 = Mgr.Allocate(16, 16);
+        EXPECT_EQ(R5, Region(32, 0, 16, 16));
+
+        Mgr.Free(std::move(R0));
+        Mgr.Free(std::move(R2));
+        Mgr.Free(std::move(R4));
+        Mgr.Free(std::move(R5));
+        EXPECT_TRUE(Mgr.IsEmpty());
+        EXPECT_EQ(Mgr.GetFreeRegionCount(), 1U);
+    }
+}
+
+static void VerifyNoOverlap(const std::vector<Region>& Regions)
+{
+    for (size_t i = 0; i < Regions.size(); ++i)
+    {
+        const Region& R0 = Regions[i];
+        if (R0.IsEmpty())
+            continue;
+        for (size_t j = i + 1; j < Regions.size(); ++j)
+        {
+            const Region& R1 = Regions[j];
+            if (R1.IsEmpty())
+                continue;
+            const bool Overlap = R0.x < R1.x + R1.width && R1.x < R0.x + R0.width && R0.y < R1.y + R1.height && R1.y < R0.y + R0.height;
+            EXPECT_FALSE(Overlap) << R0 << " overlaps " << R1;
+        }
+    }
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, AllocateRandomSkyline)
+{
+    DynamicAtlasManager Mgr{256, 256, DynamicAtlasManager::PackingMode::Skyline};
+    const Uint32        NumIterations = 10;
+    for (Uint32 i = 0; i < NumIterations; ++i)
+    {
+        FastRandInt         rnd{static_cast<unsigned int>(i), 1, 16};
+        std::vector<Region> Regions(i * 32);
+        for (auto& R : Regions)
+        {
+            R = Mgr.Allocate(rnd(), rnd());
+        }
+        VerifyNoOverlap(Regions);
+
+        // Free every other region and fill the space again
+        for (size_t r = 0; r < Regions.size(); r += 2)
+        {
+            if (!Regions[r].IsEmpty())
+                Mgr.Free(std::move(Regions[r]));
+            Regions[r] = Mgr.Allocate(rnd(), rnd());
+        }
+        VerifyNoOverlap(Regions);
+
+        for (auto& R : Regions)
+        {
+            if (!R.IsEmpty())
+                Mgr.Free(std::move(R));
+        }
+        EXPECT_TRUE(Mgr.IsEmpty());
+    }
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, Defragment)
+{
+    for (auto Mode : {DynamicAtlasManager::PackingMode::Tree, DynamicAtlasManager::PackingMode::Skyline})
+    {
+        DynamicAtlasManager Mgr{128, 128, Mode};
+
+        FastRandInt         rnd{0, 1, 16};
+        std::vector<Region> Regions(256);
+        for (auto& R : Regions)
+            R = Mgr.Allocate(rnd(), rnd());
+
+        // Free every other region to fragment the atlas
+        for (size_t r = 0; r < Regions.size(); r += 2)
+        {
+            if (!Regions[r].IsEmpty())
+                Mgr.Free(std::move(Regions[r]));
+        }
+
+        auto GetMaxTop = [](const std::vector<Region>& Regions) {
+            Uint32 MaxTop = 0;
+            for (const Region& R : Regions)
+                MaxTop = std::max(MaxTop, R.IsEmpty() ? 0 : R.y + R.height);
+            return MaxTop;
+        };
+        const Uint32 MaxTop = GetMaxTop(Regions);
+
+        std::vector<DynamicAtlasManager::RegionMove> Moves;
+        Uint32                                       TotalMoves = 0;
+        while (Uint32 NumMoves = Mgr.Defragment(4, Moves))
+        {
+            EXPECT_LE(NumMoves, 4U);
+            TotalMoves += NumMoves;
+            ASSERT_LT(TotalMoves, 1024U) << "Defragmentation does not converge";
+        }
+        EXPECT_EQ(Moves.size(), TotalMoves);
+
+        // Apply the moves in order
+        for (const auto& Move : Moves)
+        {
+            EXPECT_LT(Move.Dst.y + Move.Dst.height, Move.Src.y + Move.Src.height);
+            auto it = std::find(Regions.begin(), Regions.end(), Move.Src);
+            ASSERT_NE(it, Regions.end()) << "Source region " << Move.Src << " is not allocated";
+            // The destination may only overlap the source of the same move
+            for (const Region& R : Regions)
+            {
+                if (&R == &*it || R.IsEmpty())
+                    continue;
+                const bool Overlap =
+                    Move.Dst.x < R.x + R.width && R.x < Move.Dst.x + Move.Dst.width &&
+                    Move.Dst.y < R.y + R.height && R.y < Move.Dst.y + Move.Dst.height;
+                EXPECT_FALSE(Overlap) << "Destination " << Move.Dst << " overlaps live region " << R;
+            }
+            *it = Move.Dst;
+        }
+        VerifyNoOverlap(Regions);
+        EXPECT_LE(GetMaxTop(Regions), MaxTop);
+        if (Mode == DynamicAtlasManager::PackingMode::Skyline)
+        {
+            EXPECT_GT(TotalMoves, 0U);
+            EXPECT_LT(GetMaxTop(Regions), MaxTop);
+        }
+
+        for (auto& R : Regions)
+        {
+            if (!R.IsEmpty())
+                Mgr.Free(std::move(R));
+        }
+        EXPECT_TRUE(Mgr.IsEmpty());
+    }
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, DefragmentSkylineHole)
+{
+    DynamicAtlasManager Mgr{16, 16, DynamicAtlasManager::PackingMode::Skyline};
+
+    Region A = Mgr.Allocate(16, 8);
+    Region B = Mgr.Allocate(16, 8);
+    EXPECT_EQ(A, Region(0, 0, 16, 8));
+    EXPECT_EQ(B, Region(0, 8, 16, 8));
+
+    // The hole under B can't be allocated until B is moved down
+    Mgr.Free(std::move(A));
+    EXPECT_TRUE(Mgr.Allocate(16, 8).IsEmpty());
+
+    std::vector<DynamicAtlasManager::RegionMove> Moves;
+    EXPECT_EQ(Mgr.Defragment(4, Moves), 1U);
+    ASSERT_EQ(Moves.size(), size_t{1});
+    EXPECT_EQ(Moves[0].Src, Region(0, 8, 16, 8));
+    EXPECT_EQ(Moves[0].Dst, Region(0, 0, 16, 8));
+    B = Moves[0].Dst;
+
+    // Nothing else can be moved
+    EXPECT_EQ(Mgr.Defragment(4, Moves), 0U);
+    EXPECT_EQ(Moves.size(), size_t{1});
+
+    Region C = Mgr.Allocate(16, 8);
+    EXPECT_EQ(C, Region(0, 8, 16, 8));
+
+    Mgr.Free(std::move(B));
+    Mgr.Free(std::move(C));
+    EXPECT_TRUE(Mgr.IsEmpty());
+}
+
 } // namespace
@@ -705,7 +705,7 @@ TEST(GraphicsAccessories_GraphicsAccessories, PipelineTypeFromShaderStages)
 
 TEST(GraphicsAccessories_GraphicsAccessories, GetPipelineResourceFlagsString)
 {
-    static_assert(PIPELINE_RESOURCE_FLAG_LAST == (1u << 4), "Please add a test for the new flag here");
+    static_assert(PIPELINE_RESOURCE_FLAG_LAST == (1u << 5), "Please add a test for the new flag here");
 
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_NONE, true).c_str(), "PIPELINE_RESOURCE_FLAG_NONE");
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_NONE).c_str(), "UNKNOWN");
@@ -734,6 +734,11 @@ TEST(GraphicsAccessories_GraphicsAccessories, GetPipelineResourceFlagsString)
 
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY, true).c_str(), "PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY");
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY).c_str(), "RUNTIME_ARRAY");
+
+    EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_UPDATE_AFTER_BIND, true).c_str(), "PIPELINE_RESOURCE_FLAG_UPDATE_AFTER_BIND");
+    EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_UPDATE_AFTER_BIND).c_str(), "UPDATE_AFTER_BIND");
+    EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS | PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY | PIPELINE_RESOURCE_FLAG_UPDATE_AFTER_BIND).c_str(),
+                 "NO_DYNAMIC_BUFFERS|RUNTIME_ARRAY|UPDATE_AFTER_BIND");
 }
 
 TEST(GraphicsAccessories_GraphicsAccessories, GetPipelineShadingRateFlagsString)
@@ -0,0 +1,148 @@
+/*
+ *  Copyright 2019-2025 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "../../../../Graphics/GraphicsEngine/include/DeviceObjectArchive.hpp"
+
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "DataBlobImpl.hpp"
+#include "TestingEnvironment.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr DeviceObjectArchive::DeviceType TestDeviceType = DeviceObjectArchive::DeviceType::Vulkan;
+constexpr Uint32                          NumTestShaders = 5;
+
+std::vector<std::vector<Uint8>> CreateTestShaders()
+{
+    std::vector<std::vector<Uint8>> Shaders(NumTestShaders);
+    for (Uint32 i = 0; i < NumTestShaders; ++i)
+    {
+        Shaders[i].resize(64 + i * 32);
+        for (size_t j = 0; j < Shaders[i].size(); ++j)
+            Shaders[i][j] = static_cast<Uint8>((j / 8) * (i + 1));
+    }
+    return Shaders;
+}
+
+// Serializes an archive that stores the shaders compressed, one shader per block
+RefCntAutoPtr<IDataBlob> CreateCompressedArchive(const std::vector<std::vector<Uint8>>& Shaders)
+{
+    DeviceObjectArchive Archive;
+
+    std::vector<SerializedData>& DeviceShaders = Archive.GetDeviceShaders(TestDeviceType);
+    for (const std::vector<Uint8>& Shader : Shaders)
+        DeviceShaders.emplace_back(const_cast<Uint8*>(Shader.data()), Shader.size());
+
+    DeviceObjectArchive::SerializeAttribs Attribs;
+    Attribs.Compression     = DeviceObjectArchive::ShaderCompression::LZ4;
+    Attribs.ShaderBlockSize = 0;
+
+    RefCntAutoPtr<IDataBlob> pData;
+    Archive.Serialize(&pData, Attribs);
+    return pData;
+}
+
+// Returns the offset of the compression type, the number of shaders and the number of blocks
+// of the compressed test device shaders.
+size_t FindCompressedShaderCounts(const IDataBlob* pData)
+{
+    const Uint32 Pattern[] = {static_cast<Uint32>(DeviceObjectArchive::ShaderCompression::LZ4), NumTestShaders, NumTestShaders};
+
+    const Uint8* pBytes = pData->GetConstDataPtr<Uint8>();
+    for (size_t Offset = 0; Offset + sizeof(Pattern) <= pData->GetSize(); ++Offset)
+    {
+        if (memcmp(pBytes + Offset, Pattern, sizeof(Pattern)) == 0)
+            return Offset;
+    }
+    return ~size_t{0};
+}
+
+TEST(DeviceObjectArchiveTest, CompressedShaders)
+{
+    const std::vector<std::vector<Uint8>> Shaders = CreateTestShaders();
+
+    RefCntAutoPtr<IDataBlob> pData = CreateCompressedArchive(Shaders);
+    ASSERT_NE(pData, nullptr);
+
+    DeviceObjectArchive::CreateInfo CI;
+    CI.pData = pData;
+    DeviceObjectArchive Archive{CI};
+    EXPECT_EQ(Archive.GetShaderCompression(), DeviceObjectArchive::ShaderCompression::LZ4);
+
+    for (Uint32 i = 0; i < NumTestShaders; ++i)
+    {
+        const SerializedData& Shader = Archive.GetSerializedShader(TestDeviceType, i);
+        ASSERT_EQ(Shader.Size(), Shaders[i].size());
+        EXPECT_EQ(memcmp(Shader.Ptr(), Shaders[i].data(), Shaders[i].size()), 0);
+    }
+
+    // Decompressed shaders can be modified once the compressed data is released
+    Archive.ReleaseCompressedShaders();
+    std::vector<SerializedData>& DeviceShaders = Archive.GetDeviceShaders(TestDeviceType);
+    ASSERT_EQ(DeviceShaders.size(), size_t{NumTestShaders});
+    EXPECT_EQ(memcmp(DeviceShaders.back().Ptr(), Shaders.back().data(), Shaders.back().size()), 0);
+}
+
+TEST(DeviceObjectArchiveTest, InvalidCompressedShaderCounts)
+{
+    const std::vector<std::vector<Uint8>> Shaders = CreateTestShaders();
+
+    RefCntAutoPtr<IDataBlob> pData = CreateCompressedArchive(Shaders);
+    ASSERT_NE(pData, nullptr);
+
+    const size_t CountsOffset = FindCompressedShaderCounts(pData);
+    ASSERT_NE(CountsOffset, ~size_t{0});
+
+    // Counts that do not fit into the archive must be rejected without allocating memory for them
+    const Uint32 InvalidCounts[][2] = {
+        {0xFFFFFFFFu, NumTestShaders},
+        {NumTestShaders, 0xFFFFFFFFu},
+        {0x10000000u, 0x10000000u},
+    };
+    for (const auto& Counts : InvalidCounts)
+    {
+        RefCntAutoPtr<DataBlobImpl> pCorrupted = DataBlobImpl::MakeCopy(pData);
+        memcpy(pCorrupted->GetDataPtr<Uint8>(CountsOffset + sizeof(Uint32)), Counts, sizeof(Counts));
+
+        DeviceObjectArchive::CreateInfo CI;
+        CI.pData = pCorrupted;
+
+        TestingEnvironment::ErrorScope ExpectedErrors{"exceeds the remaining archive data size"};
+
+        DeviceObjectArchive Archive;
+        EXPECT_FALSE(Archive.Deserialize(CI)) << "NumShaders: " << Counts[0] << ", NumBlocks: " << Counts[1];
+    }
+}
+
+} // namespace
@@ -0,0 +1,1080 @@
+/*
+ *  Copyright 2019-2025 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "BCTools.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "ThreadPool.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+constexpr Uint16 Partitions2[] =
+    {
+        0xCCCC,
+        0x8888,
+        0xEEEE,
+        0xECC8,
+        0xC880,
+        0xFEEC,
+        0xFEC8,
+        0xEC80,
+        0xC800,
+        0xFFEC,
+        0xFE80,
+        0xE800,
+        0xFFE8,
+        0xFF00,
+        0xFFF0,
+        0xF000,
+        0xF710,
+        0x008E,
+        0x7100,
+        0x08CE,
+        0x008C,
+        0x7310,
+        0x3100,
+        0x8CCE,
+        0x088C,
+        0x3110,
+        0x6666,
+        0x366C,
+        0x17E8,
+        0x0FF0,
+        0x718E,
+        0x399C,
+        0xAAAA,
+        0xF0F0,
+        0x5A5A,
+        0x33CC,
+        0x3C3C,
+        0x55AA,
+        0x9696,
+        0xA55A,
+        0x73CE,
+        0x13C8,
+        0x324C,
+        0x3BDC,
+        0x6996,
+        0xC33C,
+        0x9966,
+        0x0660,
+        0x0272,
+        0x04E4,
+        0x4E40,
+        0x2720,
+        0xC936,
+        0x936C,
+        0x39C6,
+        0x639C,
+        0x9336,
+        0x9CC6,
+        0x817E,
+        0xE718,
+        0xCCF0,
+        0x0FCC,
+        0x7744,
+        0xEE22,
+};
+
+// Returns the BC7 mode of the block, or 8 for the reserved mode
+Uint32 GetBC7Mode(const Uint8* Bits)
+{
+    Uint32 Mode = 0;
+    while (Mode < 8 && ((Bits[0] >> Mode) & 1u) == 0)
+        ++Mode;
+    return Mode;
+}
+
+// Decodes the block produced by the encoder and checks that it does not use the reserved mode
+void DecodeBC7(const Uint8* Bits, Uint8* RGBA)
+{
+    const Uint32 Mode = GetBC7Mode(Bits);
+    EXPECT_LT(Mode, 8u) << "Reserved BC7 mode";
+    DecompressBC7Block(Bits, RGBA);
+}
+
+// Returns the BC6H mode (1-14) of the block, or 0 for reserved modes
+Uint32 GetBC6HMode(const Uint8* Bits)
+{
+    if ((Bits[0] & 0x2u) == 0)
+        return (Bits[0] & 0x1u) + 1;
+
+    // 5-bit mode values 0x02, 0x06, ..., 0x1E map to modes 3-10, 0x03, 0x07, 0x0B and 0x0F to modes 11-14
+    const Uint32 ModeBits = Bits[0] & 0x1Fu;
+    return (ModeBits & 0x1u) == 0 ?
+        (ModeBits >> 2) + 3 :
+        (ModeBits < 0x10 ? (ModeBits >> 2) + 11 : 0);
+}
+
+// Decodes the BC6H_UF16 block produced by the encoder to half-precision bit patterns and checks
+// that it does not use a reserved mode
+void DecodeBC6H(const Uint8* Bits, Uint16* RGB)
+{
+    EXPECT_NE(GetBC6HMode(Bits), 0u) << "Reserved BC6H mode bits " << (Bits[0] & 0x1Fu);
+    DecompressBC6HBlockHalf(Bits, RGB, 3);
+}
+
+float HalfToFloat(Uint16 Half)
+{
+    const Uint32 Exponent = (Half >> 10) & 0x1F;
+    const Uint32 Mantissa = Half & 0x3FF;
+    const float  Value    = Exponent == 0 ?
+        std::ldexp(static_cast<float>(Mantissa), -24) :
+        std::ldexp(static_cast<float>(Mantissa | 0x400), static_cast<int>(Exponent) - 25);
+    return (Half & 0x8000) != 0 ? -Value : Value;
+}
+
+// Generates a block with a random linear gradient and noise
+void GenerateBlock(std::mt19937& Rnd, float Noise, float Block[16][4])
+{
+    std::uniform_real_distribution<float> Dist{0.f, 1.f};
+
+    float Base[4], Delta[4];
+    for (Uint32 c = 0; c < 4; ++c)
+    {
+        Base[c]  = Dist(Rnd);
+        Delta[c] = (Dist(Rnd) - 0.5f) * 0.5f;
+    }
+    const float Angle = Dist(Rnd) * 6.2832f;
+    for (Uint32 y = 0; y < 4; ++y)
+    {
+        for (Uint32 x = 0; x < 4; ++x)
+        {
+            const float t = (static_cast<float>(x) - 1.5f) * std::cos(Angle) / 3.f + (static_cast<float>(y) - 1.5f) * std::sin(Angle) / 3.f;
+            for (Uint32 c = 0; c < 4; ++c)
+            {
+                const float Value   = Base[c] + Delta[c] * t + (Dist(Rnd) - 0.5f) * Noise;
+                Block[y * 4 + x][c] = std::min(std::max(Value, 0.f), 1.f);
+            }
+        }
+    }
+}
+
+// Returns the mean squared error in 8-bit units. If ModeCounts is not null, it receives the number
+// of blocks encoded with each mode.
+double TestBC7(BC_COMPRESSION_QUALITY Quality, bool Opaque, float Noise, Uint32* ModeCounts = nullptr)
+{
+    std::mt19937 Rnd{123};
+
+    double TotalError = 0;
+    for (Uint32 b = 0; b < 1000; ++b)
+    {
+        float Block[16][4];
+        GenerateBlock(Rnd, Noise, Block);
+
+        Uint8 Src[64];
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            for (Uint32 c = 0; c < 4; ++c)
+                Src[i * 4 + c] = static_cast<Uint8>(Block[i][c] * 255.f + 0.5f);
+            if (Opaque)
+                Src[i * 4 + 3] = 255;
+        }
+
+        Uint8 Bits[16];
+        CompressBC7Block(Src, Bits, Quality);
+        if (ModeCounts != nullptr)
+            ++ModeCounts[GetBC7Mode(Bits)];
+
+        Uint8 Decoded[64];
+        DecodeBC7(Bits, Decoded);
+        for (Uint32 i = 0; i < 64; ++i)
+        {
+            const double d = static_cast<double>(Decoded[i]) - static_cast<double>(Src[i]);
+            TotalError += d * d;
+        }
+        if (Opaque)
+        {
+            for (Uint32 i = 0; i < 16; ++i)
+                EXPECT_EQ(Decoded[i * 4 + 3], 255);
+        }
+    }
+    return TotalError / (1000 * 64);
+}
+
+// Encodes gradient blocks of half-precision values in [0.125, 32] and returns the mean squared error
+// of the decoded half-precision bit patterns. If ModeCounts is not null, it receives the number
+// of blocks encoded with each mode.
+double TestBC6H(BC_COMPRESSION_QUALITY Quality, float Noise, Uint32* ModeCounts = nullptr)
+{
+    std::mt19937 Rnd{4};
+
+    double TotalError = 0;
+    for (Uint32 b = 0; b < 1000; ++b)
+    {
+        float Block[16][4];
+        GenerateBlock(Rnd, Noise, Block);
+
+        // Half bit patterns are roughly logarithmic, so this is an exponential gradient
+        Uint16 Src[16 * 3];
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            for (Uint32 c = 0; c < 3; ++c)
+                Src[i * 3 + c] = static_cast<Uint16>(0x3000 + Block[i][c] * 0x2000);
+        }
+
+        Uint8 Bits[16];
+        CompressBC6HBlockHalf(Src, Bits, 3, Quality);
+        if (ModeCounts != nullptr)
+            ++ModeCounts[GetBC6HMode(Bits)];
+
+        Uint16 Decoded[16 * 3];
+        DecodeBC6H(Bits, Decoded);
+        for (Uint32 i = 0; i < 16 * 3; ++i)
+        {
+            const double d = static_cast<double>(Decoded[i]) - static_cast<double>(Src[i]);
+            TotalError += d * d;
+        }
+    }
+    return TotalError / (1000 * 16 * 3);
+}
+
+double GetPSNR(double MSE, double Peak)
+{
+    return 10.0 * std::log10(Peak * Peak / std::max(MSE, 1e-10));
+}
+
+class BitWriter
+{
+public:
+    explicit BitWriter(Uint8* Bits) :
+        m_Bits{Bits}
+    {
+        std::memset(m_Bits, 0, 16);
+    }
+
+    void Write(Uint32 Value, Uint32 NumBits)
+    {
+        for (Uint32 i = 0; i < NumBits; ++i, ++m_Pos)
+            m_Bits[m_Pos >> 3] |= static_cast<Uint8>(((Value >> i) & 1u) << (m_Pos & 7));
+    }
+
+    Uint32 GetPosition() const { return m_Pos; }
+
+private:
+    Uint8* m_Bits;
+    Uint32 m_Pos = 0;
+};
+
+// Packs 16 3-bit BC4 indices
+void WriteBC4Indices(const Uint32 Indices[16], Uint8* Bits)
+{
+    Uint64 Packed = 0;
+    for (Uint32 i = 0; i < 16; ++i)
+        Packed |= Uint64{Indices[i]} << (i * 3);
+    for (Uint32 i = 0; i < 6; ++i)
+        Bits[i] = static_cast<Uint8>(Packed >> (i * 8));
+}
+
+} // namespace
+
+TEST(Tools_BCTools, CompressBC7SolidColor)
+{
+    std::mt19937 Rnd{0};
+    for (BC_COMPRESSION_QUALITY Quality : {BC_COMPRESSION_QUALITY_FAST, BC_COMPRESSION_QUALITY_NORMAL, BC_COMPRESSION_QUALITY_HIGH})
+    {
+        for (Uint32 test = 0; test < 256; ++test)
+        {
+            Uint8 Color[4];
+            for (Uint32 c = 0; c < 4; ++c)
+                Color[c] = static_cast<Uint8>(Rnd() & 0xFF);
+            if (test % 2 == 0)
+                Color[3] = 255;
+
+            Uint8 Src[64];
+            for (Uint32 i = 0; i < 16; ++i)
+                std::memcpy(&Src[i * 4], Color, 4);
+
+            Uint8 Bits[16];
+            CompressBC7Block(Src, Bits, Quality);
+
+            Uint8 Decoded[64];
+            DecodeBC7(Bits, Decoded);
+            for (Uint32 i = 0; i < 64; ++i)
+                EXPECT_LE(std::abs(int{Decoded[i]} - int{Src[i]}), 1);
+            if (Color[3] == 255)
+            {
+                for (Uint32 i = 0; i < 16; ++i)
+                    EXPECT_EQ(Decoded[i * 4 + 3], 255);
+            }
+        }
+    }
+}
+
+TEST(Tools_BCTools, CompressBC7TwoColors)
+{
+    // Two flat colors separated by a partition boundary can be represented
+    // almost exactly by the two-subset modes.
+    std::mt19937 Rnd{1};
+    for (Uint32 Partition = 0; Partition < 64; ++Partition)
+    {
+        Uint8 Colors[2][4];
+        for (Uint32 s = 0; s < 2; ++s)
+        {
+            for (Uint32 c = 0; c < 3; ++c)
+                Colors[s][c] = static_cast<Uint8>(Rnd() & 0xFF);
+            Colors[s][3] = 255;
+        }
+
+        Uint8 Src[64];
+        for (Uint32 i = 0; i < 16; ++i)
+            std::memcpy(&Src[i * 4], Colors[(Partitions2[Partition] >> i) & 1], 4);
+
+        Uint8 Bits[16];
+        CompressBC7Block(Src, Bits, BC_COMPRESSION_QUALITY_HIGH);
+
+        Uint8 Decoded[64];
+        DecodeBC7(Bits, Decoded);
+        for (Uint32 i = 0; i < 64; ++i)
+            EXPECT_LE(std::abs(int{Decoded[i]} - int{Src[i]}), 2) << "Partition " << Partition;
+    }
+}
+
+TEST(Tools_BCTools, CompressBC7Quality)
+{
+    for (bool Opaque : {true, false})
+    {
+        for (float Noise : {0.f, 0.05f, 0.2f})
+        {
+            const double FastMSE   = TestBC7(BC_COMPRESSION_QUALITY_FAST, Opaque, Noise);
+            const double NormalMSE = TestBC7(BC_COMPRESSION_QUALITY_NORMAL, Opaque, Noise);
+            const double HighMSE   = TestBC7(BC_COMPRESSION_QUALITY_HIGH, Opaque, Noise);
+
+            EXPECT_LE(NormalMSE, FastMSE * 1.01) << "Opaque: " << Opaque << ", Noise: " << Noise;
+            EXPECT_LE(HighMSE, NormalMSE * 1.01) << "Opaque: " << Opaque << ", Noise: " << Noise;
+
+            // Uniform noise with the amplitude of 0.2 has the variance of about 217 in 8-bit units
+            const double MaxMSE = Noise == 0 ? 3.0 : (Noise < 0.1f ? 15.0 : 150.0);
+            EXPECT_LT(FastMSE, MaxMSE) << "Opaque: " << Opaque << ", Noise: " << Noise;
+        }
+    }
+}
+
+TEST(Tools_BCTools, CompressBC6H)
+{
+    double FastRelError = 0;
+    for (BC_COMPRESSION_QUALITY Quality : {BC_COMPRESSION_QUALITY_FAST, BC_COMPRESSION_QUALITY_NORMAL, BC_COMPRESSION_QUALITY_HIGH})
+    {
+        std::mt19937 Rnd{2};
+
+        double MaxRelError = 0;
+        double SumRelError = 0;
+        for (Uint32 b = 0; b < 1000; ++b)
+        {
+            // Smooth HDR gradient that may cross several exponents
+            float Block[16][4];
+            GenerateBlock(Rnd, 0.f, Block);
+
+            const float Scale = std::ldexp(1.f, static_cast<int>(Rnd() % 16) - 4);
+
+            float Src[16 * 4];
+            for (Uint32 i = 0; i < 16; ++i)
+            {
+                for (Uint32 c = 0; c < 4; ++c)
+                    Src[i * 4 + c] = (Block[i][c] + 0.1f) * Scale;
+            }
+
+            Uint8 Bits[16];
+            CompressBC6HBlock(Src, Bits, 4, Quality);
+
+            Uint16 Decoded[16 * 3];
+            DecodeBC6H(Bits, Decoded);
+            for (Uint32 i = 0; i < 16; ++i)
+            {
+                for (Uint32 c = 0; c < 3; ++c)
+                {
+                    const double Expected = Src[i * 4 + c];
+                    const double RelError = std::abs(HalfToFloat(Decoded[i * 3 + c]) - Expected) / Expected;
+                    MaxRelError           = std::max(MaxRelError, RelError);
+                    SumRelError += RelError;
+                }
+            }
+        }
+
+        const double MeanRelError = SumRelError / (1000 * 16 * 3);
+        EXPECT_LT(MeanRelError, 0.015) << "Quality: " << Quality;
+        // BC6H interpolates the half-precision bit patterns, so gradients that cross
+        // exponent boundaries can't be represented exactly.
+        EXPECT_LT(MaxRelError, 0.3) << "Quality: " << Quality;
+        if (Quality == BC_COMPRESSION_QUALITY_FAST)
+            FastRelError = MeanRelError;
+        else
+            EXPECT_LE(MeanRelError, FastRelError) << "Quality: " << Quality;
+    }
+}
+
+TEST(Tools_BCTools, CompressBC7PSNR)
+{
+    struct TestCase
+    {
+        bool  Opaque;
+        float Noise;
+        // Minimum PSNR in dB for the fast, normal and high presets
+        double MinPSNR[3];
+    };
+    // clang-format off
+    constexpr TestCase TestCases[] =
+    {
+        {true,  0.00f, {45.4, 49.0, 49.5}},
+        {true,  0.05f, {39.1, 40.9, 41.0}},
+        {true,  0.20f, {28.5, 31.0, 32.3}},
+        {false, 0.00f, {43.8, 45.0, 45.2}},
+        {false, 0.05f, {37.4, 37.8, 38.0}},
+        {false, 0.20f, {26.7, 28.3, 28.7}},
+    };
+    // clang-format on
+
+    for (const TestCase& Test : TestCases)
+    {
+        for (BC_COMPRESSION_QUALITY Quality : {BC_COMPRESSION_QUALITY_FAST, BC_COMPRESSION_QUALITY_NORMAL, BC_COMPRESSION_QUALITY_HIGH})
+        {
+            const double PSNR = GetPSNR(TestBC7(Quality, Test.Opaque, Test.Noise), 255);
+            EXPECT_GE(PSNR, Test.MinPSNR[Quality]) << "Quality: " << Quality << ", Opaque: " << Test.Opaque << ", Noise: " << Test.Noise;
+        }
+    }
+}
+
+TEST(Tools_BCTools, CompressBC7HighModes)
+{
+    // The high preset should use every mode for some of the test blocks
+    Uint32 ModeCounts[9] = {};
+    for (bool Opaque : {true, false})
+    {
+        for (float Noise : {0.f, 0.05f, 0.2f})
+            TestBC7(BC_COMPRESSION_QUALITY_HIGH, Opaque, Noise, ModeCounts);
+    }
+    for (Uint32 Mode = 0; Mode < 8; ++Mode)
+        EXPECT_GT(ModeCounts[Mode], 0u) << "Mode " << Mode;
+    EXPECT_EQ(ModeCounts[8], 0u);
+}
+
+TEST(Tools_BCTools, CompressBC6HPSNR)
+{
+    // PSNR of the half-precision bit patterns
+    constexpr double Peak = 0x7BFF;
+
+    struct TestCase
+    {
+        float Noise;
+        // Minimum PSNR in dB for the fast, normal and high presets
+        double MinPSNR[3];
+    };
+    // clang-format off
+    constexpr TestCase TestCases[] =
+    {
+        {0.00f, {57.8, 58.1, 60.4}},
+        {0.05f, {50.0, 50.1, 51.2}},
+        {0.20f, {39.0, 40.7, 41.2}},
+    };
+    // clang-format on
+
+    for (const TestCase& Test : TestCases)
+    {
+        for (BC_COMPRESSION_QUALITY Quality : {BC_COMPRESSION_QUALITY_FAST, BC_COMPRESSION_QUALITY_NORMAL, BC_COMPRESSION_QUALITY_HIGH})
+        {
+            const double PSNR = GetPSNR(TestBC6H(Quality, Test.Noise), Peak);
+            EXPECT_GE(PSNR, Test.MinPSNR[Quality]) << "Quality: " << Quality << ", Noise: " << Test.Noise;
+        }
+    }
+}
+
+TEST(Tools_BCTools, CompressBC6HHighModes)
+{
+    // Mode 0 counts blocks with reserved modes
+    Uint32 ModeCounts[15] = {};
+    for (float Noise : {0.f, 0.05f, 0.2f})
+        TestBC6H(BC_COMPRESSION_QUALITY_HIGH, Noise, ModeCounts);
+    EXPECT_EQ(ModeCounts[0], 0u);
+
+    // The high preset should use two-region modes other than mode 10
+    // and one-region modes with delta-encoded endpoints
+    Uint32 NumTwoRegionDelta = 0;
+    for (Uint32 Mode = 1; Mode <= 9; ++Mode)
+        NumTwoRegionDelta += ModeCounts[Mode];
+    EXPECT_GT(NumTwoRegionDelta, 0u);
+    EXPECT_GT(ModeCounts[13] + ModeCounts[14], 0u);
+}
+
+TEST(Tools_BCTools, CompressBC6HSolidColor)
+{
+    std::mt19937 Rnd{3};
+    for (Uint32 test = 0; test < 256; ++test)
+    {
+        // Random positive normalized half value
+        Uint16 Color[3];
+        for (Uint32 c = 0; c < 3; ++c)
+            Color[c] = static_cast<Uint16>(0x0400 + Rnd() % (0x7BFF - 0x0400));
+
+        Uint16 Src[16 * 3];
+        for (Uint32 i = 0; i < 16; ++i)
+            std::memcpy(&Src[i * 3], Color, sizeof(Color));
+
+        for (BC_COMPRESSION_QUALITY Quality : {BC_COMPRESSION_QUALITY_FAST, BC_COMPRESSION_QUALITY_HIGH})
+        {
+            Uint8 Bits[16];
+            CompressBC6HBlockHalf(Src, Bits, 3, Quality);
+
+            Uint16 Decoded[16 * 3];
+            DecodeBC6H(Bits, Decoded);
+            for (Uint32 i = 0; i < 16 * 3; ++i)
+            {
+                // 10-bit endpoints quantize the half bit pattern with the step of about 32
+                const Uint32 MaxError = Quality == BC_COMPRESSION_QUALITY_FAST ? 32 : 16;
+                EXPECT_LE(std::abs(int{Decoded[i]} - int{Src[i]}), static_cast<int>(MaxError)) << std::hex << Src[i];
+            }
+        }
+    }
+
+    // Negative values are clamped to zero
+    float Src[16 * 3];
+    std::fill(std::begin(Src), std::end(Src), -1.f);
+    Uint8 Bits[16];
+    CompressBC6HBlock(Src, Bits, 3);
+    Uint16 Decoded[16 * 3];
+    DecodeBC6H(Bits, Decoded);
+    for (Uint16 Value : Decoded)
+        EXPECT_EQ(Value, 0);
+}
+
+TEST(Tools_BCTools, DecompressBC1)
+{
+    // Red and blue endpoints, pixel i uses index i % 4
+    const Uint8 Block[8] = {0x00, 0xF8, 0x1F, 0x00, 0xE4, 0xE4, 0xE4, 0xE4};
+
+    const Uint8 Expected[4][4] = {
+        {255, 0, 0, 255},
+        {0, 0, 255, 255},
+        {170, 0, 85, 255},
+        {85, 0, 170, 255},
+    };
+
+    Uint8 RGBA[16 * 4];
+    DecompressBC1Block(Block, RGBA, 4);
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        for (Uint32 c = 0; c < 4; ++c)
+            EXPECT_EQ(RGBA[i * 4 + c], Expected[i % 4][c]) << "i=" << i << " c=" << c;
+    }
+
+    // Three-color mode: the third color is the average, the fourth one is transparent black
+    const Uint8 Block3[8] = {0x1F, 0x00, 0x00, 0xF8, 0xE4, 0xE4, 0xE4, 0xE4};
+
+    const Uint8 Expected3[4][4] = {
+        {0, 0, 255, 255},
+        {255, 0, 0, 255},
+        {128, 0, 128, 255},
+        {0, 0, 0, 0},
+    };
+
+    Uint8 RGB[16 * 3];
+    DecompressBC1Block(Block3, RGBA, 4);
+    DecompressBC1Block(Block3, RGB, 3);
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        for (Uint32 c = 0; c < 4; ++c)
+            EXPECT_EQ(RGBA[i * 4 + c], Expected3[i % 4][c]) << "i=" << i << " c=" << c;
+        for (Uint32 c = 0; c < 3; ++c)
+            EXPECT_EQ(RGB[i * 3 + c], Expected3[i % 4][c]) << "i=" << i << " c=" << c;
+    }
+
+    // Endpoints are expanded to 8 bits by replicating the high bits
+    const Uint8 BlockMid[8] = {0x10, 0x84, 0x10, 0x84, 0, 0, 0, 0};
+    DecompressBC1Block(BlockMid, RGBA, 4);
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        EXPECT_EQ(RGBA[i * 4 + 0], 132);
+        EXPECT_EQ(RGBA[i * 4 + 1], 130);
+        EXPECT_EQ(RGBA[i * 4 + 2], 132);
+        EXPECT_EQ(RGBA[i * 4 + 3], 255);
+    }
+}
+
+TEST(Tools_BCTools, DecompressBC2BC3)
+{
+    Uint32 Indices[16];
+    for (Uint32 i = 0; i < 16; ++i)
+        Indices[i] = i % 8;
+
+    // Color block with c0 < c1 that must still be decoded in four-color mode
+    const Uint8 ColorBlock[8] = {0x1F, 0x00, 0x00, 0xF8, 0xFF, 0xFF, 0xFF, 0xFF};
+
+    {
+        Uint8 BC2Block[16];
+        for (Uint32 i = 0; i < 8; ++i)
+            BC2Block[i] = static_cast<Uint8>((i * 2) | ((i * 2 + 1) << 4));
+        std::memcpy(BC2Block + 8, ColorBlock, 8);
+
+        Uint8 RGBA[16 * 4];
+        DecompressBC2Block(BC2Block, RGBA);
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            EXPECT_EQ(RGBA[i * 4 + 0], 170);
+            EXPECT_EQ(RGBA[i * 4 + 1], 0);
+            EXPECT_EQ(RGBA[i * 4 + 2], 85);
+            EXPECT_EQ(RGBA[i * 4 + 3], i * 17);
+        }
+    }
+
+    {
+        // Eight-value alpha block
+        Uint8 BC3Block[16] = {70, 0};
+        WriteBC4Indices(Indices, BC3Block + 2);
+        std::memcpy(BC3Block + 8, ColorBlock, 8);
+
+        const Uint8 ExpectedAlpha[8] = {70, 0, 60, 50, 40, 30, 20, 10};
+
+        Uint8 RGBA[16 * 4];
+        DecompressBC3Block(BC3Block, RGBA);
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            EXPECT_EQ(RGBA[i * 4 + 0], 170);
+            EXPECT_EQ(RGBA[i * 4 + 1], 0);
+            EXPECT_EQ(RGBA[i * 4 + 2], 85);
+            EXPECT_EQ(RGBA[i * 4 + 3], ExpectedAlpha[i % 8]) << "i=" << i;
+        }
+    }
+}
+
+TEST(Tools_BCTools, DecompressBC4BC5)
+{
+    Uint32 Indices[16];
+    for (Uint32 i = 0; i < 16; ++i)
+        Indices[i] = i % 8;
+
+    Uint8 Block[16] = {0, 100};
+    WriteBC4Indices(Indices, Block + 2);
+    Block[8] = 70;
+    Block[9] = 0;
+    WriteBC4Indices(Indices, Block + 10);
+
+    // Six-value and eight-value modes
+    const Uint8 ExpectedR[8] = {0, 100, 20, 40, 60, 80, 0, 255};
+    const Uint8 ExpectedG[8] = {70, 0, 60, 50, 40, 30, 20, 10};
+
+    Uint8 R[16];
+    DecompressBC4Block(Block, R, 1);
+    Uint8 RG[16 * 2];
+    DecompressBC5Block(Block, RG, 2);
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        EXPECT_EQ(R[i], ExpectedR[i % 8]) << "i=" << i;
+        EXPECT_EQ(RG[i * 2 + 0], ExpectedR[i % 8]) << "i=" << i;
+        EXPECT_EQ(RG[i * 2 + 1], ExpectedG[i % 8]) << "i=" << i;
+    }
+
+    // Signed blocks
+    Uint8 SignedBlock[16] = {static_cast<Uint8>(-70), 70};
+    WriteBC4Indices(Indices, SignedBlock + 2);
+    SignedBlock[8] = 70;
+    SignedBlock[9] = static_cast<Uint8>(-128); // Same as -127
+    WriteBC4Indices(Indices, SignedBlock + 10);
+
+    const int ExpectedSignedR[8] = {-70, 70, -42, -14, 14, 42, -127, 127};
+    const int ExpectedSignedG[8] = {70, -127, 42, 14, -14, -43, -71, -99};
+
+    DecompressBCSurfaceAttribs Attribs;
+    Attribs.Format    = TEX_FORMAT_BC5_SNORM;
+    Attribs.Width     = 4;
+    Attribs.Height    = 4;
+    Attribs.pSrcData  = SignedBlock;
+    Attribs.SrcStride = 16;
+    Attribs.pDstData  = RG;
+    Attribs.DstStride = 8;
+    EXPECT_TRUE(DecompressBCSurface(Attribs));
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        EXPECT_EQ(static_cast<Int8>(RG[i * 2 + 0]), ExpectedSignedR[i % 8]) << "i=" << i;
+        EXPECT_EQ(static_cast<Int8>(RG[i * 2 + 1]), ExpectedSignedG[i % 8]) << "i=" << i;
+    }
+}
+
+TEST(Tools_BCTools, DecompressBC7)
+{
+    std::mt19937 Rnd{4};
+
+    // Solid color blocks in every mode with random indices
+    struct ModeInfo
+    {
+        Uint32 NumSubsets;
+        Uint32 PartitionBits;
+        Uint32 RotationBits;
+        Uint32 IndexSelectionBits;
+        Uint32 ColorBits;
+        Uint32 AlphaBits;
+        Uint32 NumPBits;
+        Uint32 IndexBits;
+    };
+    constexpr ModeInfo Modes[] = {
+        {3, 4, 0, 0, 4, 0, 6, 45},
+        {2, 6, 0, 0, 6, 0, 2, 46},
+        {3, 6, 0, 0, 5, 0, 0, 29},
+        {2, 6, 0, 0, 7, 0, 4, 30},
+        {1, 0, 2, 1, 5, 6, 0, 31 + 47},
+        {1, 0, 2, 0, 7, 8, 0, 31 + 31},
+        {1, 0, 0, 0, 7, 7, 2, 63},
+        {2, 6, 0, 0, 5, 5, 4, 30},
+    };
+    for (Uint32 Mode = 0; Mode < 8; ++Mode)
+    {
+        const ModeInfo& Info = Modes[Mode];
+        for (Uint32 test = 0; test < 16; ++test)
+        {
+            Uint32 Color[4];
+            for (Uint32 c = 0; c < 4; ++c)
+                Color[c] = Rnd() % (1u << (c < 3 ? Info.ColorBits : std::max(Info.AlphaBits, 1u)));
+            const Uint32 PBit      = Rnd() % 2;
+            const Uint32 Rotation  = Info.RotationBits > 0 ? Rnd() % 4 : 0;
+            const Uint32 Partition = Rnd() % (1u << Info.PartitionBits);
+
+            Uint8     Bits[16];
+            BitWriter Writer{Bits};
+            Writer.Write(1u << Mode, Mode + 1);
+            Writer.Write(Partition, Info.PartitionBits);
+            Writer.Write(Rotation, Info.RotationBits);
+            Writer.Write(Rnd(), Info.IndexSelectionBits);
+            for (Uint32 c = 0; c < 4; ++c)
+            {
+                for (Uint32 e = 0; e < Info.NumSubsets * 2; ++e)
+                    Writer.Write(Color[c], c < 3 ? Info.ColorBits : Info.AlphaBits);
+            }
+            for (Uint32 p = 0; p < Info.NumPBits; ++p)
+                Writer.Write(PBit, 1);
+            // Indices do not matter as all endpoints are the same
+            for (Uint32 i = 0; i < Info.IndexBits; i += 16)
+                Writer.Write(Rnd(), std::min(Info.IndexBits - i, 16u));
+            ASSERT_EQ(Writer.GetPosition(), 128u) << "Mode " << Mode;
+
+            Uint8 Expected[4];
+            for (Uint32 c = 0; c < 4; ++c)
+            {
+                Uint32 Value   = Color[c];
+                Uint32 NumBits = c < 3 ? Info.ColorBits : Info.AlphaBits;
+                if (NumBits == 0)
+                {
+                    Expected[c] = 255;
+                    continue;
+                }
+                if (Info.NumPBits > 0)
+                {
+                    Value = (Value << 1) | PBit;
+                    ++NumBits;
+                }
+                Value       = Value << (8 - NumBits);
+                Expected[c] = static_cast<Uint8>(Value | (Value >> NumBits));
+            }
+            if (Rotation != 0)
+                std::swap(Expected[3], Expected[Rotation - 1]);
+
+            Uint8 Decoded[64];
+            DecompressBC7Block(Bits, Decoded);
+            for (Uint32 i = 0; i < 16; ++i)
+            {
+                for (Uint32 c = 0; c < 4; ++c)
+                    ASSERT_EQ(Decoded[i * 4 + c], Expected[c]) << "Mode " << Mode << ", pixel " << i << ", channel " << c;
+            }
+        }
+    }
+
+    // Reserved mode
+    Uint8 Bits[16] = {};
+    Bits[5]        = 0xFF;
+    Uint8 Decoded[64];
+    DecompressBC7Block(Bits, Decoded);
+    for (Uint8 Value : Decoded)
+        EXPECT_EQ(Value, 0);
+}
+
+TEST(Tools_BCTools, DecompressBC6H)
+{
+    // Float and half-precision outputs must be consistent for all blocks produced by the encoder
+    std::mt19937 Rnd{5};
+    for (BC_COMPRESSION_QUALITY Quality : {BC_COMPRESSION_QUALITY_FAST, BC_COMPRESSION_QUALITY_NORMAL})
+    {
+        for (Uint32 b = 0; b < 256; ++b)
+        {
+            float Block[16][4];
+            GenerateBlock(Rnd, 0.05f, Block);
+            const float Scale = std::ldexp(1.f, static_cast<int>(Rnd() % 16) - 4);
+
+            float Src[16 * 4];
+            for (Uint32 i = 0; i < 64; ++i)
+                Src[i] = Block[i / 4][i % 4] * Scale;
+
+            Uint8 Bits[16];
+            CompressBC6HBlock(Src, Bits, 4, Quality);
+
+            Uint16 DecodedHalf[16 * 3];
+            DecompressBC6HBlockHalf(Bits, DecodedHalf, 3);
+
+            float DecodedFloat[16 * 4];
+            DecompressBC6HBlock(Bits, DecodedFloat, 4);
+            for (Uint32 i = 0; i < 16; ++i)
+            {
+                for (Uint32 c = 0; c < 3; ++c)
+                    EXPECT_EQ(DecodedFloat[i * 4 + c], HalfToFloat(DecodedHalf[i * 3 + c]));
+                EXPECT_EQ(DecodedFloat[i * 4 + 3], 1.f);
+            }
+        }
+    }
+
+    // Random blocks cover all modes, negative values and denormals
+    for (Uint32 b = 0; b < 1024; ++b)
+    {
+        Uint8 Bits[16];
+        for (Uint8& Byte : Bits)
+            Byte = static_cast<Uint8>(Rnd());
+
+        for (bool IsSigned : {false, true})
+        {
+            Uint16 DecodedHalf[16 * 4];
+            DecompressBC6HBlockHalf(Bits, DecodedHalf, 4, IsSigned);
+
+            float DecodedFloat[16 * 4];
+            DecompressBC6HBlock(Bits, DecodedFloat, 4, IsSigned);
+            for (Uint32 i = 0; i < 16 * 4; ++i)
+            {
+                // Compare bit patterns to distinguish negative zero
+                Uint32      ExpectedBits, DecodedBits;
+                const float Expected = HalfToFloat(DecodedHalf[i]);
+                std::memcpy(&ExpectedBits, &Expected, sizeof(Expected));
+                std::memcpy(&DecodedBits, &DecodedFloat[i], sizeof(DecodedFloat[i]));
+                ASSERT_EQ(DecodedBits, ExpectedBits) << "Half value " << DecodedHalf[i];
+            }
+        }
+    }
+
+    auto Unquantize = [](int Value, int Bits, bool IsSigned) {
+        if (!IsSigned)
+        {
+            if (Bits >= 15 || Value == 0)
+                return Value;
+            return Value == (1 << Bits) - 1 ? 0xFFFF : ((Value << 16) + 0x8000) >> Bits;
+        }
+        if (Bits >= 16 || Value == 0)
+            return Value;
+        const int Magnitude = std::abs(Value);
+        const int Result    = Magnitude >= (1 << (Bits - 1)) - 1 ? 0x7FFF : ((Magnitude << 15) + 0x4000) >> (Bits - 1);
+        return Value < 0 ? -Result : Result;
+    };
+    auto FinishUnquantize = [](int Value, bool IsSigned) {
+        if (!IsSigned)
+            return static_cast<Uint16>((Value * 31) >> 6);
+        return Value < 0 ?
+            static_cast<Uint16>(0x8000 | ((-Value * 31) >> 5)) :
+            static_cast<Uint16>((Value * 31) >> 5);
+    };
+
+    // Solid color blocks in one-region modes with random indices
+    for (Uint32 ModeBits : {0x03u, 0x0Bu, 0x0Fu})
+    {
+        for (bool IsSigned : {false, true})
+        {
+            const int EndpointBits = ModeBits == 0x03 ? 10 : (ModeBits == 0x0B ? 12 : 16);
+            for (Uint32 test = 0; test < 64; ++test)
+            {
+                Uint32 Color[3];
+                for (Uint32 c = 0; c < 3; ++c)
+                    Color[c] = Rnd() % (1u << EndpointBits);
+
+                Uint8     Bits[16];
+                BitWriter Writer{Bits};
+                Writer.Write(ModeBits, 5);
+                for (Uint32 c = 0; c < 3; ++c)
+                    Writer.Write(Color[c], 10);
+                for (Uint32 c = 0; c < 3; ++c)
+                {
+                    if (ModeBits == 0x03)
+                    {
+                        // Untransformed second endpoint
+                        Writer.Write(Color[c], 10);
+                    }
+                    else
+                    {
+                        // Zero delta and the high bits of the first endpoint in reversed order
+                        Writer.Write(0, 16 - EndpointBits + 4);
+                        for (int b = EndpointBits - 1; b >= 10; --b)
+                            Writer.Write(Color[c] >> b, 1);
+                    }
+                }
+                Writer.Write(Rnd(), 31);
+                Writer.Write(Rnd(), 32);
+                ASSERT_EQ(Writer.GetPosition(), 128u);
+
+                Uint16 Decoded[16 * 4];
+                DecompressBC6HBlockHalf(Bits, Decoded, 4, IsSigned);
+                for (Uint32 c = 0; c < 3; ++c)
+                {
+                    int Value = static_cast<int>(Color[c]);
+                    if (IsSigned && (Value & (1 << (EndpointBits - 1))) != 0)
+                        Value -= 1 << EndpointBits;
+                    const Uint16 Expected = FinishUnquantize(Unquantize(Value, EndpointBits, IsSigned), IsSigned);
+                    for (Uint32 i = 0; i < 16; ++i)
+                        ASSERT_EQ(Decoded[i * 4 + c], Expected) << "Mode bits " << ModeBits << ", pixel " << i << ", channel " << c;
+                }
+                for (Uint32 i = 0; i < 16; ++i)
+                    EXPECT_EQ(Decoded[i * 4 + 3], 0x3C00);
+            }
+        }
+    }
+
+    // Reserved mode
+    Uint8 Bits[16] = {0x13, 0xFF, 0xFF};
+    float Decoded[16 * 3];
+    DecompressBC6HBlock(Bits, Decoded, 3);
+    for (float Value : Decoded)
+        EXPECT_EQ(Value, 0.f);
+}
+
+TEST(Tools_BCTools, DecompressBCSurface)
+{
+    constexpr TEXTURE_FORMAT Formats[] = {
+        TEX_FORMAT_BC1_UNORM,
+        TEX_FORMAT_BC2_UNORM_SRGB,
+        TEX_FORMAT_BC3_UNORM,
+        TEX_FORMAT_BC4_UNORM,
+        TEX_FORMAT_BC4_SNORM,
+        TEX_FORMAT_BC5_UNORM,
+        TEX_FORMAT_BC5_SNORM,
+        TEX_FORMAT_BC6H_UF16,
+        TEX_FORMAT_BC6H_SF16,
+        TEX_FORMAT_BC7_UNORM_SRGB,
+    };
+
+    EXPECT_EQ(GetBCDecompressedFormat(TEX_FORMAT_BC1_UNORM_SRGB), TEX_FORMAT_RGBA8_UNORM_SRGB);
+    EXPECT_EQ(GetBCDecompressedFormat(TEX_FORMAT_BC4_SNORM), TEX_FORMAT_R8_SNORM);
+    EXPECT_EQ(GetBCDecompressedFormat(TEX_FORMAT_BC5_UNORM), TEX_FORMAT_RG8_UNORM);
+    EXPECT_EQ(GetBCDecompressedFormat(TEX_FORMAT_BC6H_SF16), TEX_FORMAT_RGBA16_FLOAT);
+    EXPECT_EQ(GetBCDecompressedFormat(TEX_FORMAT_RGBA8_UNORM), TEX_FORMAT_UNKNOWN);
+    {
+        DecompressBCSurfaceAttribs Attribs;
+        Attribs.Format = TEX_FORMAT_RGBA8_UNORM;
+        EXPECT_FALSE(DecompressBCSurface(Attribs));
+    }
+
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+
+    std::mt19937 Rnd{6};
+    for (TEXTURE_FORMAT Format : Formats)
+    {
+        const TEXTURE_FORMAT DstFormat = GetBCDecompressedFormat(Format);
+        ASSERT_NE(DstFormat, TEX_FORMAT_UNKNOWN);
+
+        const bool   IsBC6H    = Format == TEX_FORMAT_BC6H_UF16 || Format == TEX_FORMAT_BC6H_SF16;
+        const Uint32 BlockSize = (Format == TEX_FORMAT_BC1_UNORM || Format == TEX_FORMAT_BC4_UNORM || Format == TEX_FORMAT_BC4_SNORM) ? 8 : 16;
+        const Uint32 PixelSize = DstFormat == TEX_FORMAT_R8_UNORM || DstFormat == TEX_FORMAT_R8_SNORM ?
+            1 :
+            (DstFormat == TEX_FORMAT_RG8_UNORM || DstFormat == TEX_FORMAT_RG8_SNORM ? 2 : (IsBC6H ? 8 : 4));
+
+        // The surface size is not a multiple of the block size and is large enough for several tasks
+        constexpr Uint32 Width          = 1030;
+        constexpr Uint32 Height         = 517;
+        constexpr Uint32 NumBlocksInRow = (Width + 3) / 4;
+        constexpr Uint32 NumBlockRows   = (Height + 3) / 4;
+
+        const size_t SrcStride = NumBlocksInRow * BlockSize + 7;
+        const size_t DstStride = Width * PixelSize + 5;
+
+        std::vector<Uint8> Src(SrcStride * NumBlockRows);
+        for (Uint8& Byte : Src)
+            Byte = static_cast<Uint8>(Rnd());
+
+        DecompressBCSurfaceAttribs Attribs;
+        Attribs.Format    = Format;
+        Attribs.Width     = Width;
+        Attribs.Height    = Height;
+        Attribs.pSrcData  = Src.data();
+        Attribs.SrcStride = SrcStride;
+        Attribs.DstStride = DstStride;
+
+        constexpr Uint8    Sentinel = 0xCD;
+        std::vector<Uint8> Serial(DstStride * Height, Sentinel);
+        Attribs.pDstData = Serial.data();
+        EXPECT_TRUE(DecompressBCSurface(Attribs));
+
+        std::vector<Uint8> Parallel(DstStride * Height, Sentinel);
+        Attribs.pDstData    = Parallel.data();
+        Attribs.pThreadPool = pThreadPool;
+        EXPECT_TRUE(DecompressBCSurface(Attribs));
+        EXPECT_EQ(Serial, Parallel) << "Format " << Uint32{Format};
+
+        // Compare with the block functions
+        for (Uint32 by = 0; by < NumBlockRows; by += 13)
+        {
+            for (Uint32 bx = 0; bx < NumBlocksInRow; bx += 7)
+            {
+                const Uint8* Bits = &Src[by * SrcStride + bx * BlockSize];
+
+                Uint8 Expected[16 * 8] = {};
+                switch (Format)
+                {
+                    case TEX_FORMAT_BC1_UNORM: DecompressBC1Block(Bits, Expected, 4); break;
+                    case TEX_FORMAT_BC2_UNORM_SRGB: DecompressBC2Block(Bits, Expected); break;
+                    case TEX_FORMAT_BC3_UNORM: DecompressBC3Block(Bits, Expected); break;
+                    case TEX_FORMAT_BC4_UNORM: DecompressBC4Block(Bits, Expected, 1); break;
+                    case TEX_FORMAT_BC5_UNORM: DecompressBC5Block(Bits, Expected, 2); break;
+                    case TEX_FORMAT_BC7_UNORM_SRGB: DecompressBC7Block(Bits, Expected); break;
+                    case TEX_FORMAT_BC6H_UF16:
+                    case TEX_FORMAT_BC6H_SF16:
+                    {
+                        Uint16 Half[16 * 4];
+                        DecompressBC6HBlockHalf(Bits, Half, 4, Format == TEX_FORMAT_BC6H_SF16);
+                        std::memcpy(Expected, Half, sizeof(Half));
+                        break;
+                    }
+                    default:
+                        // Signed BC4 and BC5 are tested separately
+                        continue;
+                }
+
+                for (Uint32 y = 0; y < 4 && by * 4 + y < Height; ++y)
+                {
+                    const Uint32 NumCols = std::min(Width - bx * 4, 4u);
+                    EXPECT_EQ(std::memcmp(&Serial[(by * 4 + y) * DstStride + bx * 4 * PixelSize], &Expected[y * 4 * PixelSize], NumCols * PixelSize), 0)
+                        << "Format " << Uint32{Format} << " block " << bx << "x" << by;
+                }
+            }
+        }
+
+        // Padding at the end of every row must not be touched
+        for (Uint32 y = 0; y < Height; ++y)
+        {
+            for (size_t i = Width * PixelSize; i < DstStride; ++i)
+                ASSERT_EQ(Serial[y * DstStride + i], Sentinel) << "Format " << Uint32{Format} << " row " << y;
+        }
+    }
+}
@@ -0,0 +1,142 @@
+/*
+ *  Copyright 2019-2025 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ImGuiDiligentRenderer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Texture views are only compared by the batching function and are never dereferenced
+ITextureView* const pTexture0 = reinterpret_cast<ITextureView*>(uintptr_t{0x100});
+ITextureView* const pTexture1 = reinterpret_cast<ITextureView*>(uintptr_t{0x200});
+
+const Rect Scissor0{0, 0, 256, 256};
+const Rect Scissor1{0, 0, 128, 256};
+
+ImGuiDrawCommand MakeCommand(ITextureView* pTextureView, const Rect& Scissor, Uint32 FirstIndex, Uint32 NumIndices, Uint32 BaseVertex = 0, Uint64 VtxOffset = 0)
+{
+    ImGuiDrawCommand Cmd;
+    Cmd.pTextureView = pTextureView;
+    Cmd.Scissor      = Scissor;
+    Cmd.VtxOffset    = VtxOffset;
+    Cmd.NumIndices   = NumIndices;
+    Cmd.FirstIndex   = FirstIndex;
+    Cmd.BaseVertex   = BaseVertex;
+    return Cmd;
+}
+
+void CheckItem(const MultiDrawIndexedItem& Item, Uint32 FirstIndex, Uint32 NumIndices, Uint32 BaseVertex)
+{
+    EXPECT_EQ(Item.FirstIndexLocation, FirstIndex);
+    EXPECT_EQ(Item.NumIndices, NumIndices);
+    EXPECT_EQ(Item.BaseVertex, BaseVertex);
+}
+
+TEST(Tools_ImGuiDrawBatching, Empty)
+{
+    std::vector<ImGuiDrawBatch>       Batches(1);
+    std::vector<MultiDrawIndexedItem> Items(1);
+    BatchImGuiDrawCommands({}, Batches, Items);
+    EXPECT_TRUE(Batches.empty());
+    EXPECT_TRUE(Items.empty());
+}
+
+TEST(Tools_ImGuiDrawBatching, SameState)
+{
+    // Contiguous index ranges with the same base vertex are merged into one item
+    const std::vector<ImGuiDrawCommand> Commands = {
+        MakeCommand(pTexture0, Scissor0, 0, 6),
+        MakeCommand(pTexture0, Scissor0, 6, 12),
+        MakeCommand(pTexture0, Scissor0, 18, 3),
+        // Gap in the index range
+        MakeCommand(pTexture0, Scissor0, 30, 6),
+        // Different base vertex
+        MakeCommand(pTexture0, Scissor0, 36, 6, 100),
+    };
+
+    std::vector<ImGuiDrawBatch>       Batches;
+    std::vector<MultiDrawIndexedItem> Items;
+    BatchImGuiDrawCommands(Commands, Batches, Items);
+
+    ASSERT_EQ(Batches.size(), size_t{1});
+    EXPECT_EQ(Batches[0].pTextureView, pTexture0);
+    EXPECT_EQ(Batches[0].Scissor, Scissor0);
+    EXPECT_EQ(Batches[0].FirstItem, 0u);
+    EXPECT_EQ(Batches[0].NumItems, 3u);
+
+    ASSERT_EQ(Items.size(), size_t{3});
+    CheckItem(Items[0], 0, 21, 0);
+    CheckItem(Items[1], 30, 6, 0);
+    CheckItem(Items[2], 36, 6, 100);
+}
+
+TEST(Tools_ImGuiDrawBatching, StateChanges)
+{
+    const std::vector<ImGuiDrawCommand> Commands = {
+        MakeCommand(pTexture0, Scissor0, 0, 6),
+        // Different texture
+        MakeCommand(pTexture1, Scissor0, 6, 6),
+        // Different scissor rect
+        MakeCommand(pTexture1, Scissor1, 12, 6),
+        // Different vertex buffer offset
+        MakeCommand(pTexture1, Scissor1, 18, 6, 0, 1024),
+        // Same state as the first command, but not adjacent to it
+        MakeCommand(pTexture0, Scissor0, 24, 6),
+        MakeCommand(pTexture0, Scissor0, 30, 6),
+    };
+
+    std::vector<ImGuiDrawBatch>       Batches;
+    std::vector<MultiDrawIndexedItem> Items;
+    BatchImGuiDrawCommands(Commands, Batches, Items);
+
+    ASSERT_EQ(Batches.size(), size_t{5});
+    ASSERT_EQ(Items.size(), size_t{5});
+
+    const ITextureView* ExpectedTextures[]   = {pTexture0, pTexture1, pTexture1, pTexture1, pTexture0};
+    const Rect          ExpectedScissors[]   = {Scissor0, Scissor0, Scissor1, Scissor1, Scissor0};
+    const Uint64        ExpectedVtxOffsets[] = {0, 0, 0, 1024, 0};
+    for (Uint32 i = 0; i < Batches.size(); ++i)
+    {
+        EXPECT_EQ(Batches[i].pTextureView, ExpectedTextures[i]) << "Batch " << i;
+        EXPECT_EQ(Batches[i].Scissor, ExpectedScissors[i]) << "Batch " << i;
+        EXPECT_EQ(Batches[i].VtxOffset, ExpectedVtxOffsets[i]) << "Batch " << i;
+        EXPECT_EQ(Batches[i].FirstItem, i) << "Batch " << i;
+        EXPECT_EQ(Batches[i].NumItems, 1u) << "Batch " << i;
+    }
+
+    // Items are never merged across batches, even if their index ranges are contiguous
+    CheckItem(Items[0], 0, 6, 0);
+    CheckItem(Items[1], 6, 6, 0);
+    CheckItem(Items[2], 12, 6, 0);
+    CheckItem(Items[3], 18, 6, 0);
+    CheckItem(Items[4], 24, 12, 0);
+}
+
+} // namespace
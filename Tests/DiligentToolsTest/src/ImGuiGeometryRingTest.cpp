@@ -0,0 +1,162 @@
+/*
+ *  Copyright 2019-2025 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ImGuiDiligentRenderer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Tools_ImGuiGeometryRing, Allocate)
+{
+    ImGuiGeometryRing Ring;
+
+    // The ring has no space before it is reset
+    Uint32 Offset = ~0u;
+    EXPECT_FALSE(Ring.Allocate(1, Offset));
+
+    Ring.Reset(16);
+    EXPECT_EQ(Ring.GetCapacity(), 16u);
+
+    EXPECT_TRUE(Ring.Allocate(4, Offset));
+    EXPECT_EQ(Offset, 0u);
+    EXPECT_TRUE(Ring.Allocate(8, Offset));
+    EXPECT_EQ(Offset, 4u);
+    EXPECT_EQ(Ring.GetUsedSize(), 12u);
+
+    // The region can never be larger than the ring
+    EXPECT_FALSE(Ring.Allocate(17, Offset));
+    EXPECT_EQ(Ring.GetUsedSize(), 12u);
+}
+
+TEST(Tools_ImGuiGeometryRing, Wrap)
+{
+    ImGuiGeometryRing Ring;
+    Ring.Reset(16);
+
+    Uint32 Offset = ~0u;
+    EXPECT_TRUE(Ring.Allocate(10, Offset));
+    EXPECT_EQ(Offset, 0u);
+    Ring.FinishFrame(1);
+    Ring.Reclaim(1);
+    EXPECT_EQ(Ring.GetUsedSize(), 0u);
+
+    // 6 elements remain at the end of the ring, which is not enough for a contiguous region
+    // of 10 elements, so the region wraps to the beginning of the ring
+    EXPECT_TRUE(Ring.Allocate(10, Offset));
+    EXPECT_EQ(Offset, 0u);
+    // The skipped elements are only released together with the frame
+    EXPECT_EQ(Ring.GetUsedSize(), 16u);
+    Ring.FinishFrame(2);
+
+    EXPECT_FALSE(Ring.Allocate(1, Offset));
+
+    Ring.Reclaim(2);
+    EXPECT_EQ(Ring.GetUsedSize(), 0u);
+
+    // A region that ends exactly at the end of the ring does not wrap
+    EXPECT_TRUE(Ring.Allocate(6, Offset));
+    EXPECT_EQ(Offset, 10u);
+    EXPECT_TRUE(Ring.Allocate(3, Offset));
+    EXPECT_EQ(Offset, 0u);
+}
+
+TEST(Tools_ImGuiGeometryRing, FenceWait)
+{
+    ImGuiGeometryRing Ring;
+    Ring.Reset(16);
+
+    // Three frames in flight
+    Uint32 Offset = ~0u;
+    for (Uint64 Frame = 1; Frame <= 3; ++Frame)
+    {
+        EXPECT_TRUE(Ring.Allocate(5, Offset));
+        EXPECT_EQ(Offset, (Frame - 1) * 5);
+        Ring.FinishFrame(Frame);
+    }
+
+    // The space is used by the frames the GPU has not finished yet
+    EXPECT_FALSE(Ring.Allocate(5, Offset));
+    Ring.Reclaim(0);
+    EXPECT_FALSE(Ring.Allocate(5, Offset));
+
+    // Once the GPU finishes the first frame, its region can be reused
+    Ring.Reclaim(1);
+    EXPECT_EQ(Ring.GetUsedSize(), 10u);
+    EXPECT_TRUE(Ring.Allocate(5, Offset));
+    EXPECT_EQ(Offset, 0u);
+    Ring.FinishFrame(4);
+
+    EXPECT_FALSE(Ring.Allocate(5, Offset));
+
+    // Completing a later fence value releases all earlier frames. The fourth frame
+    // still holds its region and the element it skipped at the end of the ring.
+    Ring.Reclaim(3);
+    EXPECT_EQ(Ring.GetUsedSize(), 6u);
+    EXPECT_TRUE(Ring.Allocate(10, Offset));
+    EXPECT_EQ(Offset, 5u);
+    Ring.FinishFrame(5);
+
+    Ring.Reclaim(5);
+    EXPECT_EQ(Ring.GetUsedSize(), 0u);
+}
+
+TEST(Tools_ImGuiGeometryRing, Growth)
+{
+    ImGuiGeometryRing Ring;
+    Ring.Reset(16);
+
+    Uint32 Offset = ~0u;
+    EXPECT_TRUE(Ring.Allocate(12, Offset));
+    Ring.FinishFrame(1);
+    EXPECT_FALSE(Ring.Allocate(8, Offset));
+
+    // The full ring is replaced with a ring that is at least twice as large
+    EXPECT_EQ(Ring.GetGrownCapacity(8), 32u);
+    EXPECT_EQ(Ring.GetGrownCapacity(32), 32u);
+    EXPECT_EQ(Ring.GetGrownCapacity(33), 64u);
+    EXPECT_EQ(Ring.GetGrownCapacity(100), 128u);
+
+    // The new ring starts empty, and the first region is at its beginning
+    Ring.Reset(Ring.GetGrownCapacity(8));
+    EXPECT_EQ(Ring.GetCapacity(), 32u);
+    EXPECT_EQ(Ring.GetUsedSize(), 0u);
+    EXPECT_TRUE(Ring.Allocate(8, Offset));
+    EXPECT_EQ(Offset, 0u);
+
+    // Fence values of the frames that used the old ring have no effect on the new one
+    Ring.Reclaim(1);
+    EXPECT_EQ(Ring.GetUsedSize(), 8u);
+
+    // An empty ring grows to fit the request
+    ImGuiGeometryRing EmptyRing;
+    EXPECT_EQ(EmptyRing.GetGrownCapacity(5), 8u);
+}
+
+} // namespace
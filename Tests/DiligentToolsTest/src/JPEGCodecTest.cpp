@@ -32,6 +32,7 @@
 #include "DataBlobImpl.hpp"
 
 #include <cmath>
+#include <cstring>
 
 using namespace Diligent;
 
@@ -97,6 +98,40 @@ TEST(Tools_TextureLoader, JPEGCodec)
                 }
             }
         }
+
+        // Row decoding must produce the same pixels
+        struct RowDecodingData
+        {
+            const Uint8* pRefPixels = nullptr;
+            Uint32       RefStride  = 0;
+            Uint32       RowSize    = 0;
+            Uint32       NumRows    = 0;
+            Uint32       MaxRows    = ~0u;
+        };
+        ImageRowHandlerType RowHandler = [](void* pUserData, Uint32 Row, const void* pRowData) {
+            RowDecodingData& Data = *static_cast<RowDecodingData*>(pUserData);
+            EXPECT_EQ(Row, Data.NumRows);
+            EXPECT_EQ(memcmp(pRowData, Data.pRefPixels + size_t{Data.RefStride} * Row, Data.RowSize), 0) << "row " << Row;
+            return ++Data.NumRows < Data.MaxRows;
+        };
+
+        RowDecodingData Data;
+        Data.pRefPixels = pTestPixels;
+        Data.RefStride  = DecodedImgDesc.RowStride;
+        Data.RowSize    = TestImgWidth * NumComponents;
+
+        ImageDesc RowsImgDesc;
+        EXPECT_EQ(DecodeJpegRows(pJpgData->GetConstDataPtr(), pJpgData->GetSize(), RowHandler, &Data, &RowsImgDesc), DECODE_JPEG_RESULT_OK);
+        EXPECT_EQ(Data.NumRows, TestImgHeight);
+        EXPECT_EQ(RowsImgDesc.Width, TestImgWidth);
+        EXPECT_EQ(RowsImgDesc.Height, TestImgHeight);
+        EXPECT_EQ(RowsImgDesc.NumComponents, NumComponents);
+        EXPECT_EQ(RowsImgDesc.RowStride, TestImgWidth * NumComponents);
+
+        Data.NumRows = 0;
+        Data.MaxRows = 10;
+        EXPECT_EQ(DecodeJpegRows(pJpgData->GetConstDataPtr(), pJpgData->GetSize(), RowHandler, &Data, &RowsImgDesc), DECODE_JPEG_RESULT_ABORTED);
+        EXPECT_EQ(Data.NumRows, 10u);
     }
 }
 
@@ -30,9 +30,11 @@
 
 #include "gtest/gtest.h"
 
+#include <cstring>
 #include <vector>
 
 #include "DataBlobImpl.hpp"
+#include "MemoryFileStream.hpp"
 
 using namespace Diligent;
 
@@ -105,6 +107,65 @@ TEST(Tools_TextureLoader, PNGCodec)
                 }
             }
         }
+
+        {
+            struct RowDecodingData
+            {
+                const Uint8* pRefPixels = nullptr;
+                Uint32       RowSize    = 0;
+                Uint32       NumRows    = 0;
+                Uint32       MaxRows    = ~0u;
+            };
+            ImageRowHandlerType RowHandler = [](void* pUserData, Uint32 Row, const void* pRowData) {
+                RowDecodingData& Data = *static_cast<RowDecodingData*>(pUserData);
+                EXPECT_EQ(Row, Data.NumRows);
+                EXPECT_EQ(memcmp(pRowData, Data.pRefPixels + size_t{Data.RowSize} * Row, Data.RowSize), 0) << "row " << Row;
+                return ++Data.NumRows < Data.MaxRows;
+            };
+
+            RowDecodingData Data;
+            Data.pRefPixels = RefPixels.data();
+            Data.RowSize    = TestImgWidth * NumComponents;
+
+            ImageDesc DecodedImgDesc;
+            EXPECT_EQ(DecodePngRows(pPngData->GetConstDataPtr(), pPngData->GetSize(), RowHandler, &Data, &DecodedImgDesc), DECODE_PNG_RESULT_OK);
+            EXPECT_EQ(Data.NumRows, TestImgHeight);
+            EXPECT_EQ(DecodedImgDesc.Width, TestImgWidth);
+            EXPECT_EQ(DecodedImgDesc.Height, TestImgHeight);
+            EXPECT_EQ(DecodedImgDesc.NumComponents, NumComponents);
+            EXPECT_EQ(DecodedImgDesc.RowStride, TestImgWidth * NumComponents);
+
+            Data.NumRows = 0;
+            Data.MaxRows = 10;
+            EXPECT_EQ(DecodePngRows(pPngData->GetConstDataPtr(), pPngData->GetSize(), RowHandler, &Data, &DecodedImgDesc), DECODE_PNG_RESULT_ABORTED);
+            EXPECT_EQ(Data.NumRows, 10u);
+        }
+
+        for (int CompressionLevel : {-1, 0, 1, 9})
+        {
+            RefCntAutoPtr<IDataBlob>        pStreamData = DataBlobImpl::Create();
+            RefCntAutoPtr<MemoryFileStream> pStream     = MemoryFileStream::Create(pStreamData);
+
+            Res = EncodePngToStream(RefPixels.data(), TestImgWidth, TestImgHeight, TestImgWidth * NumComponents,
+                                    EncodeAlpha ? PNG_COLOR_TYPE_RGBA : PNG_COLOR_TYPE_RGB,
+                                    CompressionLevel, pStream);
+            ASSERT_EQ(Res, ENCODE_PNG_RESULT_OK) << "level " << CompressionLevel;
+
+            RefCntAutoPtr<IDataBlob> pDecodedPixelsBlob = DataBlobImpl::Create();
+
+            ImageDesc DecodedImgDesc;
+            ASSERT_EQ(DecodePng(pStreamData->GetConstDataPtr(), pStreamData->GetSize(), pDecodedPixelsBlob, &DecodedImgDesc), DECODE_PNG_RESULT_OK);
+            ASSERT_EQ(DecodedImgDesc.Width, TestImgWidth);
+            ASSERT_EQ(DecodedImgDesc.Height, TestImgHeight);
+            ASSERT_EQ(DecodedImgDesc.NumComponents, NumComponents);
+
+            const Uint8* pTestPixels = pDecodedPixelsBlob->GetConstDataPtr<Uint8>();
+            for (Uint32 y = 0; y < TestImgHeight; ++y)
+            {
+                EXPECT_EQ(memcmp(pTestPixels + y * DecodedImgDesc.RowStride, &RefPixels[y * TestImgWidth * NumComponents], TestImgWidth * NumComponents), 0)
+                    << "level " << CompressionLevel << " row " << y;
+            }
+        }
     }
 }
 
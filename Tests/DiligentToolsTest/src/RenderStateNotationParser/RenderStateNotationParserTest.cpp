@@ -594,6 +594,177 @@ TEST(Tools_RenderStateNotationParser, RenderStateNotationParserTest)
     });
 }
 
+TEST(Tools_RenderStateNotationParser, CompileBinary)
+{
+    RefCntAutoPtr<IRenderStateNotationParser> pParser = LoadFromFile("RenderStatesLibrary.json");
+    ASSERT_NE(pParser, nullptr);
+
+    RefCntAutoPtr<IDataBlob> pBinary;
+    ASSERT_TRUE(pParser->CompileBinary(&pBinary));
+    ASSERT_NE(pBinary, nullptr);
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pStreamFactory;
+    CreateDefaultShaderSourceStreamFactory("RenderStates/RenderStateNotationParser", &pStreamFactory);
+    ASSERT_TRUE(pStreamFactory);
+
+    RefCntAutoPtr<IRenderStateNotationParser> pBinaryParser;
+    CreateRenderStateNotationParser({}, &pBinaryParser);
+    ASSERT_NE(pBinaryParser, nullptr);
+    ASSERT_TRUE(pBinaryParser->ParseBinary(pBinary->GetConstDataPtr(), pBinary->GetSize(), pStreamFactory));
+
+    const auto& ParserInfo = pParser->GetInfo();
+    EXPECT_EQ(pBinaryParser->GetInfo().ShaderCount, ParserInfo.ShaderCount);
+    EXPECT_EQ(pBinaryParser->GetInfo().RenderPassCount, ParserInfo.RenderPassCount);
+    EXPECT_EQ(pBinaryParser->GetInfo().ResourceSignatureCount, ParserInfo.ResourceSignatureCount);
+    EXPECT_EQ(pBinaryParser->GetInfo().PipelineStateCount, ParserInfo.PipelineStateCount);
+
+    for (Uint32 i = 0; i < ParserInfo.ShaderCount; ++i)
+    {
+        const auto* pRef  = pParser->GetShaderByIndex(i);
+        const auto* pDesc = pBinaryParser->GetShaderByIndex(i);
+        ASSERT_NE(pDesc, nullptr);
+        EXPECT_EQ(pDesc->Desc, pRef->Desc);
+        EXPECT_STREQ(pDesc->FilePath, pRef->FilePath);
+        EXPECT_STREQ(pDesc->EntryPoint, pRef->EntryPoint);
+        EXPECT_EQ(pDesc->Macros, pRef->Macros);
+        EXPECT_EQ(pDesc->SourceLanguage, pRef->SourceLanguage);
+        EXPECT_EQ(pBinaryParser->GetShaderByName(pRef->Desc.Name), pDesc);
+    }
+
+    for (Uint32 i = 0; i < ParserInfo.RenderPassCount; ++i)
+    {
+        const auto* pRef  = pParser->GetRenderPassByIndex(i);
+        const auto* pDesc = pBinaryParser->GetRenderPassByIndex(i);
+        ASSERT_NE(pDesc, nullptr);
+        EXPECT_EQ(*pDesc, *pRef);
+        EXPECT_EQ(pBinaryParser->GetRenderPassByName(pRef->Name), pDesc);
+    }
+
+    for (Uint32 i = 0; i < ParserInfo.ResourceSignatureCount; ++i)
+    {
+        const auto* pRef  = pParser->GetResourceSignatureByIndex(i);
+        const auto* pDesc = pBinaryParser->GetResourceSignatureByIndex(i);
+        ASSERT_NE(pDesc, nullptr);
+        EXPECT_EQ(*pDesc, *pRef);
+        EXPECT_EQ(pBinaryParser->GetResourceSignatureByName(pRef->Name), pDesc);
+        EXPECT_EQ(pBinaryParser->IsSignatureIgnored(pRef->Name), pParser->IsSignatureIgnored(pRef->Name));
+    }
+
+    for (Uint32 i = 0; i < ParserInfo.PipelineStateCount; ++i)
+    {
+        const auto* pRef  = pParser->GetPipelineStateByIndex(i);
+        const auto* pDesc = pBinaryParser->GetPipelineStateByIndex(i);
+        ASSERT_NE(pDesc, nullptr);
+        ASSERT_EQ(pDesc->PSODesc.PipelineType, pRef->PSODesc.PipelineType);
+        switch (pRef->PSODesc.PipelineType)
+        {
+            case PIPELINE_TYPE_GRAPHICS:
+            case PIPELINE_TYPE_MESH:
+                EXPECT_EQ(*static_cast<const GraphicsPipelineNotation*>(pDesc), *static_cast<const GraphicsPipelineNotation*>(pRef));
+                break;
+
+            case PIPELINE_TYPE_COMPUTE:
+                EXPECT_EQ(*static_cast<const ComputePipelineNotation*>(pDesc), *static_cast<const ComputePipelineNotation*>(pRef));
+                break;
+
+            case PIPELINE_TYPE_RAY_TRACING:
+                EXPECT_EQ(*static_cast<const RayTracingPipelineNotation*>(pDesc), *static_cast<const RayTracingPipelineNotation*>(pRef));
+                break;
+
+            case PIPELINE_TYPE_TILE:
+                EXPECT_EQ(*static_cast<const TilePipelineNotation*>(pDesc), *static_cast<const TilePipelineNotation*>(pRef));
+                break;
+
+            default:
+                ADD_FAILURE() << "Unexpected pipeline type";
+        }
+        EXPECT_EQ(pBinaryParser->GetPipelineStateByName(pRef->PSODesc.Name, pRef->PSODesc.PipelineType), pDesc);
+    }
+}
+
+TEST(Tools_RenderStateNotationParser, OutdatedBinary)
+{
+    RefCntAutoPtr<IRenderStateNotationParser> pParser = LoadFromFile("GraphicsPipelineNotation.json");
+    ASSERT_NE(pParser, nullptr);
+
+    RefCntAutoPtr<IDataBlob> pBinary;
+    ASSERT_TRUE(pParser->CompileBinary(&pBinary));
+    ASSERT_NE(pBinary, nullptr);
+
+    // The file in the Reload folder has different content
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pModifiedFactory;
+    CreateDefaultShaderSourceStreamFactory("RenderStates/RenderStateNotationParser/Reload", &pModifiedFactory);
+    ASSERT_TRUE(pModifiedFactory);
+
+    RefCntAutoPtr<IRenderStateNotationParser> pBinaryParser;
+    CreateRenderStateNotationParser({}, &pBinaryParser);
+    ASSERT_NE(pBinaryParser, nullptr);
+    EXPECT_FALSE(pBinaryParser->ParseBinary(pBinary->GetConstDataPtr(), pBinary->GetSize(), pModifiedFactory));
+
+    // Without the factory, the binary is not validated against the source files
+    EXPECT_TRUE(pBinaryParser->ParseBinary(pBinary->GetConstDataPtr(), pBinary->GetSize(), nullptr));
+    EXPECT_NE(pBinaryParser->GetPipelineStateByName("TestName"), nullptr);
+
+    // Corrupted binary
+    std::vector<Uint8> Data{pBinary->GetConstDataPtr<Uint8>(), pBinary->GetConstDataPtr<Uint8>() + pBinary->GetSize()};
+    Data[0] ^= 0xFF;
+    pBinaryParser->Reset();
+    EXPECT_FALSE(pBinaryParser->ParseBinary(Data.data(), Data.size(), nullptr));
+}
+
+TEST(Tools_RenderStateNotationParser, CorruptedBinary)
+{
+    RefCntAutoPtr<IRenderStateNotationParser> pParser = LoadFromFile("RenderStatesLibrary.json");
+    ASSERT_NE(pParser, nullptr);
+
+    RefCntAutoPtr<IDataBlob> pBinary;
+    ASSERT_TRUE(pParser->CompileBinary(&pBinary));
+    ASSERT_NE(pBinary, nullptr);
+
+    const std::vector<Uint8> Data{pBinary->GetConstDataPtr<Uint8>(), pBinary->GetConstDataPtr<Uint8>() + pBinary->GetSize()};
+
+    RefCntAutoPtr<IRenderStateNotationParser> pBinaryParser;
+    CreateRenderStateNotationParser({}, &pBinaryParser);
+    ASSERT_NE(pBinaryParser, nullptr);
+    ASSERT_TRUE(pBinaryParser->ParseBinary(Data.data(), Data.size(), nullptr));
+
+    // Corrupt the payload at the beginning, in the middle and at the end
+    for (size_t Offset : {Data.size() / 4, Data.size() / 2, Data.size() - 1})
+    {
+        std::vector<Uint8> CorruptedData = Data;
+        CorruptedData[Offset] ^= 0x5A;
+
+        pBinaryParser->Reset();
+        EXPECT_FALSE(pBinaryParser->ParseBinary(CorruptedData.data(), CorruptedData.size(), nullptr)) << "Offset: " << Offset;
+        EXPECT_EQ(pBinaryParser->GetInfo().PipelineStateCount, 0u);
+    }
+}
+
+TEST(Tools_RenderStateNotationParser, TruncatedBinary)
+{
+    RefCntAutoPtr<IRenderStateNotationParser> pParser = LoadFromFile("RenderStatesLibrary.json");
+    ASSERT_NE(pParser, nullptr);
+
+    RefCntAutoPtr<IDataBlob> pBinary;
+    ASSERT_TRUE(pParser->CompileBinary(&pBinary));
+    ASSERT_NE(pBinary, nullptr);
+
+    RefCntAutoPtr<IRenderStateNotationParser> pBinaryParser;
+    CreateRenderStateNotationParser({}, &pBinaryParser);
+    ASSERT_NE(pBinaryParser, nullptr);
+
+    const Uint8* pData = pBinary->GetConstDataPtr<Uint8>();
+    for (size_t Size : {size_t{1}, size_t{16}, pBinary->GetSize() / 2, pBinary->GetSize() - 1})
+    {
+        // Copy the data so that reading past the end can be detected by memory checkers
+        const std::vector<Uint8> TruncatedData{pData, pData + Size};
+
+        pBinaryParser->Reset();
+        EXPECT_FALSE(pBinaryParser->ParseBinary(TruncatedData.data(), TruncatedData.size(), nullptr)) << "Size: " << Size;
+        EXPECT_EQ(pBinaryParser->GetInfo().PipelineStateCount, 0u);
+    }
+}
+
 TEST(Tools_RenderStateNotationParser, DuplicationResorcesTest)
 {
     RefCntAutoPtr<IRenderStateNotationParser> pParser = LoadFromFile("DuplicationResources.json");
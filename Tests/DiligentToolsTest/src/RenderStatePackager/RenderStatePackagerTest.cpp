@@ -27,12 +27,15 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <set>
 
 #include "gtest/gtest.h"
 #include "RenderStatePackager.hpp"
 #include "ParsingEnvironment.hpp"
 #include "TestingEnvironment.hpp"
 #include "FileSystem.hpp"
+#include "FileWrapper.hpp"
+#include "DataBlobImpl.hpp"
 #include "BasicMath.hpp"
 #include "GraphicsAccessories.hpp"
 
@@ -98,6 +101,51 @@ TEST(Tools_RenderStatePackager, BasicTest)
     ASSERT_TRUE(pArchiver->SerializeToBlob(ContentVersion, &pData));
 }
 
+TEST(Tools_RenderStatePackager, DeterministicPacking)
+{
+    // Objects are created and archived in the order the tasks complete,
+    // which must not affect the contents of the archive
+    auto Pack = [](Uint32 ThreadCount, RefCntAutoPtr<IDataBlob>& pData) {
+        ParsingEnvironmentCreateInfo EnvironmentCI{};
+        EnvironmentCI.DeviceFlags = GetDeviceFlags();
+#if PLATFORM_MACOS
+        // Compute shader are not supported in OpenGL on MacOS
+        EnvironmentCI.DeviceFlags &= ~(ARCHIVE_DEVICE_DATA_FLAG_GL | ARCHIVE_DEVICE_DATA_FLAG_GLES);
+#endif
+        EnvironmentCI.RenderStateDirs = {"RenderStates/RenderStatePackager"};
+        EnvironmentCI.ShaderDirs      = {"Shaders"};
+        EnvironmentCI.ThreadCount     = ThreadCount;
+
+        auto pEnvironment = std::make_unique<ParsingEnvironment>(EnvironmentCI);
+        ASSERT_TRUE(pEnvironment->Initialize());
+
+        auto  pArchiverFactory = pEnvironment->GetArchiverFactory();
+        auto& Packager         = pEnvironment->GetPackager();
+
+        std::vector<std::string> InputFilePaths{"RenderStatesLibrary.json"};
+        ASSERT_TRUE(Packager.ParseFiles(InputFilePaths));
+
+        RefCntAutoPtr<IArchiver> pArchiver;
+        pArchiverFactory->CreateArchiver(pEnvironment->GetSerializationDevice(), &pArchiver);
+        ASSERT_TRUE(Packager.Execute(pArchiver));
+        ASSERT_TRUE(pArchiver->SerializeToBlob(ContentVersion, &pData));
+        ASSERT_NE(pData, nullptr);
+    };
+
+    RefCntAutoPtr<IDataBlob> pReference;
+    Pack(1, pReference);
+    ASSERT_NE(pReference, nullptr);
+
+    for (Uint32 ThreadCount : {2u, 4u, 8u})
+    {
+        RefCntAutoPtr<IDataBlob> pData;
+        Pack(ThreadCount, pData);
+        ASSERT_NE(pData, nullptr);
+        ASSERT_EQ(pData->GetSize(), pReference->GetSize()) << "Thread count: " << ThreadCount;
+        EXPECT_EQ(memcmp(pData->GetConstDataPtr(), pReference->GetConstDataPtr(), pData->GetSize()), 0) << "Thread count: " << ThreadCount;
+    }
+}
+
 TEST(Tools_RenderStatePackager, ResourceSignatureTest)
 {
     ParsingEnvironmentCreateInfo EnvironmentCI{};
@@ -390,4 +438,130 @@ TEST(Tools_RenderStatePackager, IgnoredSignatures)
     ASSERT_TRUE(pArchiver->SerializeToBlob(ContentVersion, &pData));
 }
 
+TEST(Tools_RenderStatePackager, IncrementalBuild)
+{
+    // Shaders in this folder override the ones in the Shaders folder
+    constexpr const char* TempFolder = "PackagerIncrementalTemp";
+    FileSystem::DeleteDirectory(TempFolder);
+    ASSERT_TRUE(FileSystem::CreateDirectory(TempFolder));
+
+    ParsingEnvironmentCreateInfo EnvironmentCI{};
+    EnvironmentCI.DeviceFlags = GetDeviceFlags();
+#if PLATFORM_MACOS
+    // Compute shader are not supported in OpenGL on MacOS
+    EnvironmentCI.DeviceFlags &= ~(ARCHIVE_DEVICE_DATA_FLAG_GL | ARCHIVE_DEVICE_DATA_FLAG_GLES);
+#endif
+    EnvironmentCI.RenderStateDirs = {"RenderStates/RenderStatePackager"};
+    EnvironmentCI.ShaderDirs      = {TempFolder, "Shaders"};
+
+    auto pEnvironment = std::make_unique<ParsingEnvironment>(EnvironmentCI);
+    ASSERT_TRUE(pEnvironment->Initialize());
+
+    auto  pArchiverFactory = pEnvironment->GetArchiverFactory();
+    auto& Packager         = pEnvironment->GetPackager();
+
+    std::vector<std::string> InputFilePaths{"RenderStatesLibrary.json"};
+    ASSERT_TRUE(Packager.ParseFiles(InputFilePaths));
+
+    auto Build = [&](const IDataBlob* pPrevManifest, const IDataBlob* pPrevArchive, RefCntAutoPtr<IDataBlob>& pArchive, RefCntAutoPtr<IDataBlob>& pManifest) {
+        EXPECT_TRUE(Packager.EnableIncrementalBuild(pPrevManifest, pPrevArchive));
+
+        RefCntAutoPtr<IArchiver> pArchiver;
+        pArchiverFactory->CreateArchiver(pEnvironment->GetSerializationDevice(), &pArchiver);
+        ASSERT_TRUE(Packager.Execute(pArchiver));
+
+        RefCntAutoPtr<IDataBlob> pNewData;
+        ASSERT_TRUE(pArchiver->SerializeToBlob(ContentVersion, &pNewData));
+        ASSERT_TRUE(Packager.MergeWithPreviousBuild(pArchiverFactory, pPrevArchive, pNewData, &pArchive));
+        ASSERT_NE(pArchive, nullptr);
+
+        pManifest = Packager.GetBuildManifest(pArchive);
+        ASSERT_NE(pManifest, nullptr);
+    };
+
+    // Returns the names of the objects of the given type created by the last build
+    auto GetCreatedObjects = [&](ARCHIVE_RESOURCE_TYPE Type) {
+        std::set<std::string> Names;
+        for (const RenderStatePackager::ObjectTiming& Timing : Packager.GetObjectTimings())
+        {
+            if (Timing.Type == Type)
+                Names.insert(Timing.Name);
+        }
+        return Names;
+    };
+
+    const Uint32 PipelineCount = Packager.GetParser()->GetInfo().PipelineStateCount;
+
+    // The first build has no manifest, so all objects are rebuilt
+    RefCntAutoPtr<IDataBlob> pArchive1;
+    RefCntAutoPtr<IDataBlob> pManifest1;
+    Build(nullptr, nullptr, pArchive1, pManifest1);
+    ASSERT_NE(pArchive1, nullptr);
+    ASSERT_NE(pManifest1, nullptr);
+    EXPECT_EQ(GetCreatedObjects(ARCHIVE_RESOURCE_TYPE_PIPELINE_STATE).size(), size_t{PipelineCount});
+
+    // Nothing has changed, so all objects are reused from the previous archive
+    RefCntAutoPtr<IDataBlob> pArchive2;
+    RefCntAutoPtr<IDataBlob> pManifest2;
+    Build(pManifest1, pArchive1, pArchive2, pManifest2);
+    ASSERT_NE(pArchive2, nullptr);
+    ASSERT_NE(pManifest2, nullptr);
+    EXPECT_TRUE(GetCreatedObjects(ARCHIVE_RESOURCE_TYPE_PIPELINE_STATE).empty());
+    EXPECT_TRUE(GetCreatedObjects(ARCHIVE_RESOURCE_TYPE_SHADER).empty());
+
+    EXPECT_EQ(pArchive1->GetSize(), pArchive2->GetSize());
+    EXPECT_TRUE(pArchiverFactory->PrintArchiveContent(pArchive2));
+
+    ASSERT_EQ(pManifest1->GetSize(), pManifest2->GetSize());
+    EXPECT_EQ(memcmp(pManifest1->GetConstDataPtr(), pManifest2->GetConstDataPtr(), pManifest1->GetSize()), 0);
+
+    // The manifest must be rejected if the archive it describes was replaced
+    {
+        RefCntAutoPtr<DataBlobImpl> pModifiedArchive = DataBlobImpl::Create(pArchive2->GetSize(), pArchive2->GetConstDataPtr());
+        pModifiedArchive->GetDataPtr<Uint8>()[pModifiedArchive->GetSize() - 1] ^= 0xFF;
+        EXPECT_FALSE(Packager.EnableIncrementalBuild(pManifest2, pModifiedArchive));
+    }
+
+    // Change the source of the blit shaders only, so that only the blit pipeline is rebuilt
+    {
+        FileWrapper SrcFile{"Shaders/GraphicsPrimitives.hlsl", EFileAccessMode::Read};
+        ASSERT_TRUE(SrcFile);
+        RefCntAutoPtr<DataBlobImpl> pSource = DataBlobImpl::Create();
+        ASSERT_TRUE(SrcFile->Read(pSource));
+
+        const std::string ModifiedSource = std::string{pSource->GetConstDataPtr<char>(), pSource->GetSize()} + "\n// Modified\n";
+
+        const std::string DstPath = std::string{TempFolder} + FileSystem::SlashSymbol + "GraphicsPrimitives.hlsl";
+        FileWrapper       DstFile{DstPath.c_str(), EFileAccessMode::Overwrite};
+        ASSERT_TRUE(DstFile);
+        ASSERT_TRUE(DstFile->Write(ModifiedSource.data(), ModifiedSource.size()));
+    }
+
+    RefCntAutoPtr<IDataBlob> pArchive3;
+    RefCntAutoPtr<IDataBlob> pManifest3;
+    Build(pManifest2, pArchive2, pArchive3, pManifest3);
+    ASSERT_NE(pArchive3, nullptr);
+    ASSERT_NE(pManifest3, nullptr);
+    EXPECT_EQ(GetCreatedObjects(ARCHIVE_RESOURCE_TYPE_PIPELINE_STATE), (std::set<std::string>{"BlitTexture"}));
+    EXPECT_EQ(GetCreatedObjects(ARCHIVE_RESOURCE_TYPE_SHADER), (std::set<std::string>{"BlitTexture-VS", "BlitTexture-PS"}));
+    EXPECT_TRUE(pArchiverFactory->PrintArchiveContent(pArchive3));
+
+    // The pipelines that were not rebuilt are taken from the previous archive
+    {
+        RefCntAutoPtr<IDataBlob>  pReusedArchive;
+        const ArchiveResourceInfo RebuiltResources[] = {{ARCHIVE_RESOURCE_TYPE_PIPELINE_STATE, "BlitTexture"}};
+        ASSERT_TRUE(pArchiverFactory->RemoveResources(pArchive3, RebuiltResources, _countof(RebuiltResources), &pReusedArchive));
+        ASSERT_NE(pReusedArchive, nullptr);
+        EXPECT_LT(pReusedArchive->GetSize(), pArchive3->GetSize());
+    }
+
+    // Nothing has changed since the last build
+    RefCntAutoPtr<IDataBlob> pArchive4;
+    RefCntAutoPtr<IDataBlob> pManifest4;
+    Build(pManifest3, pArchive3, pArchive4, pManifest4);
+    EXPECT_TRUE(GetCreatedObjects(ARCHIVE_RESOURCE_TYPE_PIPELINE_STATE).empty());
+
+    FileSystem::DeleteDirectory(TempFolder);
+}
+
 } // namespace
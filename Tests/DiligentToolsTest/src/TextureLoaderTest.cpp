@@ -0,0 +1,475 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "TextureLoader.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "ThreadPool.hpp"
+#include "BCTools.h"
+#include "Image.h"
+#include "GraphicsAccessories.hpp"
+#include "DataBlobImpl.hpp"
+#include "MemoryFileStream.hpp"
+#include "PNGCodec.h"
+#include "png.h"
+
+#include "zlib.h"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+constexpr Uint32 VK_FORMAT_R8G8B8A8_UNORM = 37;
+
+constexpr Uint32 KTX20_SUPERCOMPRESSION_NONE = 0;
+constexpr Uint32 KTX20_SUPERCOMPRESSION_ZLIB = 3;
+
+template <typename T>
+void Append(std::vector<Uint8>& Data, const T& Value)
+{
+    const Uint8* pBytes = reinterpret_cast<const Uint8*>(&Value);
+    Data.insert(Data.end(), pBytes, pBytes + sizeof(Value));
+}
+
+// Returns the data of the 2D array RGBA8 texture. Every byte encodes the level, layer and offset.
+std::vector<std::vector<Uint8>> GetRefLevelData(Uint32 Width, Uint32 Height, Uint32 NumLayers, Uint32 NumLevels)
+{
+    std::vector<std::vector<Uint8>> Levels(NumLevels);
+    for (Uint32 level = 0; level < NumLevels; ++level)
+    {
+        const size_t LayerSize = size_t{std::max(Width >> level, 1u)} * std::max(Height >> level, 1u) * 4;
+        Levels[level].resize(LayerSize * NumLayers);
+        for (size_t i = 0; i < Levels[level].size(); ++i)
+            Levels[level][i] = static_cast<Uint8>(level * 64 + (i / LayerSize) * 32 + i % 31);
+    }
+    return Levels;
+}
+
+std::vector<Uint8> CreateKTX2(Uint32 Width, Uint32 Height, Uint32 NumLayers, const std::vector<std::vector<Uint8>>& Levels, Uint32 Scheme)
+{
+    static constexpr Uint8 KTX20FileIdentifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+    const Uint32 NumLevels = static_cast<Uint32>(Levels.size());
+
+    std::vector<Uint8> Data{std::begin(KTX20FileIdentifier), std::end(KTX20FileIdentifier)};
+    for (Uint32 Value : {VK_FORMAT_R8G8B8A8_UNORM, 1u, Width, Height, 0u, NumLayers, 1u, NumLevels, Scheme})
+        Append(Data, Value);
+    // Data format descriptor, key/value data and supercompression global data are not used
+    for (Uint32 Value : {0u, 0u, 0u, 0u})
+        Append(Data, Value);
+    for (Uint64 Value : {Uint64{0}, Uint64{0}})
+        Append(Data, Value);
+
+    // Compress the levels and write them starting with the smallest one, as the KTX2 specification requires
+    std::vector<std::vector<Uint8>> LevelData(NumLevels);
+    for (Uint32 level = 0; level < NumLevels; ++level)
+    {
+        if (Scheme == KTX20_SUPERCOMPRESSION_ZLIB)
+        {
+            uLongf CompressedSize = compressBound(static_cast<uLong>(Levels[level].size()));
+            LevelData[level].resize(CompressedSize);
+            EXPECT_EQ(compress(LevelData[level].data(), &CompressedSize, Levels[level].data(), static_cast<uLong>(Levels[level].size())), Z_OK);
+            LevelData[level].resize(CompressedSize);
+        }
+        else
+        {
+            LevelData[level] = Levels[level];
+        }
+    }
+
+    size_t Offset = Data.size() + sizeof(Uint64) * 3 * NumLevels;
+
+    std::vector<Uint64> LevelOffsets(NumLevels);
+    for (Uint32 level = NumLevels; level-- > 0;)
+    {
+        Offset              = (Offset + 3) & ~size_t{3};
+        LevelOffsets[level] = Offset;
+        Offset += LevelData[level].size();
+    }
+
+    for (Uint32 level = 0; level < NumLevels; ++level)
+    {
+        Append(Data, LevelOffsets[level]);
+        Append(Data, Uint64{LevelData[level].size()});
+        Append(Data, Uint64{Levels[level].size()});
+    }
+
+    Data.resize(Offset);
+    for (Uint32 level = 0; level < NumLevels; ++level)
+        memcpy(&Data[static_cast<size_t>(LevelOffsets[level])], LevelData[level].data(), LevelData[level].size());
+
+    return Data;
+}
+
+RefCntAutoPtr<IDataBlob> CreateDDS(Uint32 Width, Uint32 Height, Uint32 NumLayers, const std::vector<std::vector<Uint8>>& Levels)
+{
+    TextureDesc Desc;
+    Desc.Type      = NumLayers > 1 ? RESOURCE_DIM_TEX_2D_ARRAY : RESOURCE_DIM_TEX_2D;
+    Desc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    Desc.Width     = Width;
+    Desc.Height    = Height;
+    Desc.ArraySize = NumLayers;
+    Desc.MipLevels = static_cast<Uint32>(Levels.size());
+
+    std::vector<TextureSubResData> SubResources;
+    for (Uint32 layer = 0; layer < NumLayers; ++layer)
+    {
+        for (Uint32 level = 0; level < Desc.MipLevels; ++level)
+        {
+            const Uint32 LevelWidth = std::max(Width >> level, 1u);
+            const size_t LayerSize  = Levels[level].size() / NumLayers;
+            SubResources.emplace_back(&Levels[level][LayerSize * layer], LevelWidth * 4);
+        }
+    }
+
+    RefCntAutoPtr<DataBlobImpl>     pFileData   = DataBlobImpl::Create();
+    RefCntAutoPtr<MemoryFileStream> pFileStream = MemoryFileStream::Create(pFileData);
+    EXPECT_TRUE(WriteDDSToStream(pFileStream, Desc, TextureData{SubResources.data(), static_cast<Uint32>(SubResources.size())}));
+    return pFileData;
+}
+
+void VerifyTextureLoader(ITextureLoader* pLoader, const TextureLoadInfo& LoadInfo, const std::vector<std::vector<Uint8>>& RefLevels, Uint32 Width, Uint32 Height, Uint32 NumLayers)
+{
+    ASSERT_NE(pLoader, nullptr);
+
+    const Uint32 FirstMip  = LoadInfo.FirstMipLevel;
+    const Uint32 NumLevels = static_cast<Uint32>(RefLevels.size());
+    const Uint32 NumMips   = LoadInfo.MipLevels > 0 ? std::min(LoadInfo.MipLevels, NumLevels - FirstMip) : NumLevels - FirstMip;
+    const Uint32 MipWidth  = std::max(Width >> FirstMip, 1u);
+    const Uint32 MipHeight = std::max(Height >> FirstMip, 1u);
+
+    const TextureDesc& Desc = pLoader->GetTextureDesc();
+    EXPECT_EQ(Desc.Type, NumLayers > 1 ? RESOURCE_DIM_TEX_2D_ARRAY : RESOURCE_DIM_TEX_2D);
+    EXPECT_EQ(Desc.Format, TEX_FORMAT_RGBA8_UNORM);
+    EXPECT_EQ(Desc.Width, MipWidth);
+    EXPECT_EQ(Desc.Height, MipHeight);
+    EXPECT_EQ(Desc.ArraySize, NumLayers);
+    EXPECT_EQ(Desc.MipLevels, NumMips);
+
+    for (Uint32 mip = 0; mip < NumMips; ++mip)
+    {
+        const size_t LayerSize = size_t{std::max(MipWidth >> mip, 1u)} * std::max(MipHeight >> mip, 1u) * 4;
+        for (Uint32 layer = 0; layer < NumLayers; ++layer)
+        {
+            const TextureSubResData& SubRes = pLoader->GetSubresourceData(mip, layer);
+            EXPECT_EQ(SubRes.Stride, std::max(MipWidth >> mip, 1u) * 4);
+            ASSERT_NE(SubRes.pData, nullptr);
+            EXPECT_EQ(memcmp(SubRes.pData, &RefLevels[FirstMip + mip][LayerSize * layer], LayerSize), 0) << "mip " << mip << " layer " << layer;
+        }
+    }
+}
+
+void VerifyKTX2Loader(const std::vector<Uint8>& FileData, const TextureLoadInfo& LoadInfo, const std::vector<std::vector<Uint8>>& RefLevels, Uint32 Width, Uint32 Height, Uint32 NumLayers)
+{
+    RefCntAutoPtr<ITextureLoader> pLoader;
+    CreateTextureLoaderFromMemory(FileData.data(), FileData.size(), false, LoadInfo, &pLoader);
+    VerifyTextureLoader(pLoader, LoadInfo, RefLevels, Width, Height, NumLayers);
+
+    const Uint32 FirstMip  = LoadInfo.FirstMipLevel;
+    const Uint32 NumLevels = static_cast<Uint32>(RefLevels.size());
+    const Uint32 NumMips   = LoadInfo.MipLevels > 0 ? std::min(LoadInfo.MipLevels, NumLevels - FirstMip) : NumLevels - FirstMip;
+
+    std::vector<Uint64> MipLevelSizes(NumMips + 1);
+    EXPECT_EQ(GetTextureLoaderMipLevelSizes(FileData.data(), FileData.size(), LoadInfo, MipLevelSizes.data(), static_cast<Uint32>(MipLevelSizes.size())), NumMips);
+    for (Uint32 mip = 0; mip < NumMips; ++mip)
+        EXPECT_EQ(MipLevelSizes[mip], RefLevels[FirstMip + mip].size());
+}
+
+TEST(Tools_TextureLoader, KTX2)
+{
+    constexpr Uint32 Width     = 16;
+    constexpr Uint32 Height    = 8;
+    constexpr Uint32 NumLayers = 2;
+
+    const std::vector<std::vector<Uint8>> RefLevels = GetRefLevelData(Width, Height, NumLayers, 5);
+    const std::vector<Uint8>              FileData  = CreateKTX2(Width, Height, NumLayers, RefLevels, KTX20_SUPERCOMPRESSION_NONE);
+
+    TextureLoadInfo LoadInfo;
+    VerifyKTX2Loader(FileData, LoadInfo, RefLevels, Width, Height, NumLayers);
+    EXPECT_EQ(GetTextureLoaderMemoryRequirement(FileData.data(), FileData.size(), LoadInfo), size_t{0});
+}
+
+TEST(Tools_TextureLoader, KTX2Zlib)
+{
+    constexpr Uint32 Width     = 64;
+    constexpr Uint32 Height    = 32;
+    constexpr Uint32 NumLayers = 3;
+
+    const std::vector<std::vector<Uint8>> RefLevels = GetRefLevelData(Width, Height, NumLayers, 7);
+    const std::vector<Uint8>              FileData  = CreateKTX2(Width, Height, NumLayers, RefLevels, KTX20_SUPERCOMPRESSION_ZLIB);
+
+    size_t TotalSize = 0;
+    for (const std::vector<Uint8>& Level : RefLevels)
+        TotalSize += Level.size();
+
+    TextureLoadInfo LoadInfo;
+    VerifyKTX2Loader(FileData, LoadInfo, RefLevels, Width, Height, NumLayers);
+    EXPECT_EQ(GetTextureLoaderMemoryRequirement(FileData.data(), FileData.size(), LoadInfo), TotalSize);
+
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    LoadInfo.pThreadPool                   = pThreadPool;
+    VerifyKTX2Loader(FileData, LoadInfo, RefLevels, Width, Height, NumLayers);
+}
+
+TEST(Tools_TextureLoader, KTX2MipRange)
+{
+    constexpr Uint32 Width     = 32;
+    constexpr Uint32 Height    = 16;
+    constexpr Uint32 NumLayers = 1;
+
+    const std::vector<std::vector<Uint8>> RefLevels = GetRefLevelData(Width, Height, NumLayers, 6);
+    for (Uint32 Scheme : {KTX20_SUPERCOMPRESSION_NONE, KTX20_SUPERCOMPRESSION_ZLIB})
+    {
+        const std::vector<Uint8> FileData = CreateKTX2(Width, Height, NumLayers, RefLevels, Scheme);
+
+        // Coarse levels first
+        TextureLoadInfo LoadInfo;
+        LoadInfo.FirstMipLevel = 3;
+        VerifyKTX2Loader(FileData, LoadInfo, RefLevels, Width, Height, NumLayers);
+        EXPECT_EQ(GetTextureLoaderMemoryRequirement(FileData.data(), FileData.size(), LoadInfo),
+                  Scheme == KTX20_SUPERCOMPRESSION_ZLIB ? RefLevels[3].size() + RefLevels[4].size() + RefLevels[5].size() : size_t{0});
+
+        // Then the finer levels
+        LoadInfo.FirstMipLevel = 1;
+        LoadInfo.MipLevels     = 2;
+        VerifyKTX2Loader(FileData, LoadInfo, RefLevels, Width, Height, NumLayers);
+        EXPECT_EQ(GetTextureLoaderMemoryRequirement(FileData.data(), FileData.size(), LoadInfo),
+                  Scheme == KTX20_SUPERCOMPRESSION_ZLIB ? RefLevels[1].size() + RefLevels[2].size() : size_t{0});
+    }
+}
+
+TEST(Tools_TextureLoader, DDSMipRange)
+{
+    constexpr Uint32 Width     = 32;
+    constexpr Uint32 Height    = 16;
+    constexpr Uint32 NumLayers = 3;
+
+    const std::vector<std::vector<Uint8>> RefLevels = GetRefLevelData(Width, Height, NumLayers, 6);
+    RefCntAutoPtr<IDataBlob>              pFileData = CreateDDS(Width, Height, NumLayers, RefLevels);
+    ASSERT_NE(pFileData, nullptr);
+
+    const Uint8* pData    = pFileData->GetConstDataPtr<Uint8>();
+    const size_t DataSize = pFileData->GetSize();
+
+    TextureLoadInfo LoadInfo;
+    for (Uint32 FirstMip : {0u, 2u, 5u})
+    {
+        for (Uint32 MipLevels : {0u, 1u, 2u})
+        {
+            LoadInfo.FirstMipLevel = FirstMip;
+            LoadInfo.MipLevels     = MipLevels;
+
+            RefCntAutoPtr<ITextureLoader> pMemLoader;
+            CreateTextureLoaderFromMemory(pData, DataSize, false, LoadInfo, &pMemLoader);
+            VerifyTextureLoader(pMemLoader, LoadInfo, RefLevels, Width, Height, NumLayers);
+
+            // The stream loader only reads the requested mip levels
+            RefCntAutoPtr<ITextureLoader> pStreamLoader;
+            CreateTextureLoaderFromStream(MemoryFileStream::Create(pFileData), LoadInfo, &pStreamLoader);
+            VerifyTextureLoader(pStreamLoader, LoadInfo, RefLevels, Width, Height, NumLayers);
+
+            const Uint32        NumMips = MipLevels > 0 ? std::min(MipLevels, 6 - FirstMip) : 6 - FirstMip;
+            std::vector<Uint64> MipLevelSizes(6);
+            ASSERT_EQ(GetTextureLoaderMipLevelSizes(pData, DataSize, LoadInfo, MipLevelSizes.data(), 6), NumMips);
+            for (Uint32 mip = 0; mip < NumMips; ++mip)
+                EXPECT_EQ(MipLevelSizes[mip], RefLevels[FirstMip + mip].size());
+        }
+    }
+}
+
+void CompareTextureLoaders(ITextureLoader* pLoader, ITextureLoader* pRefLoader)
+{
+    ASSERT_NE(pLoader, nullptr);
+    ASSERT_NE(pRefLoader, nullptr);
+
+    const TextureDesc& Desc    = pLoader->GetTextureDesc();
+    const TextureDesc& RefDesc = pRefLoader->GetTextureDesc();
+    ASSERT_EQ(Desc.Format, RefDesc.Format);
+    ASSERT_EQ(Desc.Width, RefDesc.Width);
+    ASSERT_EQ(Desc.Height, RefDesc.Height);
+    ASSERT_EQ(Desc.MipLevels, RefDesc.MipLevels);
+
+    for (Uint32 mip = 0; mip < Desc.MipLevels; ++mip)
+    {
+        const MipLevelProperties MipProps = GetMipLevelProperties(Desc, mip);
+        const TextureSubResData& SubRes   = pLoader->GetSubresourceData(mip, 0);
+        const TextureSubResData& RefRes   = pRefLoader->GetSubresourceData(mip, 0);
+        for (Uint32 row = 0; row < MipProps.LogicalHeight; ++row)
+        {
+            const Uint8* pRow    = static_cast<const Uint8*>(SubRes.pData) + SubRes.Stride * row;
+            const Uint8* pRefRow = static_cast<const Uint8*>(RefRes.pData) + RefRes.Stride * row;
+            ASSERT_EQ(memcmp(pRow, pRefRow, static_cast<size_t>(MipProps.RowSize)), 0) << "mip " << mip << " row " << row;
+        }
+    }
+}
+
+TEST(Tools_TextureLoader, PNGRowDecoding)
+{
+    constexpr Uint32 Width  = 75;
+    constexpr Uint32 Height = 43;
+
+    for (int PngColorType : {PNG_COLOR_TYPE_RGB, PNG_COLOR_TYPE_RGBA})
+    {
+        const Uint32 NumComponents = PngColorType == PNG_COLOR_TYPE_RGBA ? 4 : 3;
+
+        // Use few distinct values to exercise the most-frequent filter
+        std::vector<Uint8> Pixels(size_t{Width} * Height * NumComponents);
+        for (size_t i = 0; i < Pixels.size(); ++i)
+            Pixels[i] = static_cast<Uint8>(((i * 7919) % 13) * 19);
+
+        RefCntAutoPtr<IDataBlob> pPngData = DataBlobImpl::Create();
+        ASSERT_EQ(EncodePng(Pixels.data(), Width, Height, Width * NumComponents, PngColorType, pPngData), ENCODE_PNG_RESULT_OK);
+
+        for (TEXTURE_LOAD_MIP_FILTER MipFilter : {TEXTURE_LOAD_MIP_FILTER_BOX_AVERAGE, TEXTURE_LOAD_MIP_FILTER_MOST_FREQUENT})
+        {
+            for (bool FlipVertically : {false, true})
+            {
+                TextureLoadInfo LoadInfo;
+                LoadInfo.MipFilter        = MipFilter;
+                LoadInfo.FlipVertically   = FlipVertically;
+                LoadInfo.PermultiplyAlpha = NumComponents == 4;
+                LoadInfo.AlphaCutoff      = 0.5f;
+
+                RefCntAutoPtr<ITextureLoader> pLoader;
+                CreateTextureLoaderFromMemory(pPngData->GetConstDataPtr(), pPngData->GetSize(), false, LoadInfo, &pLoader);
+
+                // Non-zero uniform image clip dimension makes the loader decode the entire image first
+                LoadInfo.UniformImageClipDim = 1;
+
+                RefCntAutoPtr<ITextureLoader> pRefLoader;
+                CreateTextureLoaderFromMemory(pPngData->GetConstDataPtr(), pPngData->GetSize(), false, LoadInfo, &pRefLoader);
+
+                CompareTextureLoaders(pLoader, pRefLoader);
+                EXPECT_EQ(pLoader->GetTextureDesc().MipLevels, 7u);
+            }
+        }
+    }
+}
+
+
+RefCntAutoPtr<ITextureLoader> CreateLoaderFromPixels(VALUE_TYPE ComponentType, Uint32 NumComponents, Uint32 Width, Uint32 Height, const void* pPixels, TEXTURE_LOAD_COMPRESS_MODE CompressMode)
+{
+    ImageDesc ImgDesc;
+    ImgDesc.Width         = Width;
+    ImgDesc.Height        = Height;
+    ImgDesc.ComponentType = ComponentType;
+    ImgDesc.NumComponents = NumComponents;
+    ImgDesc.RowStride     = Width * NumComponents * GetValueSize(ComponentType);
+
+    RefCntAutoPtr<Image> pImage;
+    Image::CreateFromPixels(ImgDesc, DataBlobImpl::Create(size_t{ImgDesc.RowStride} * Height, pPixels), &pImage);
+
+    TextureLoadInfo LoadInfo;
+    LoadInfo.MipLevels    = 1;
+    LoadInfo.CompressMode = CompressMode;
+
+    RefCntAutoPtr<ITextureLoader> pLoader;
+    CreateTextureLoaderFromImage(pImage, LoadInfo, &pLoader);
+    return pLoader;
+}
+
+TEST(Tools_TextureLoader, CompressedFormats)
+{
+    constexpr Uint32 Width  = 16;
+    constexpr Uint32 Height = 8;
+
+    // 16-bit UNORM images are converted to 8 bits and compressed in all BC modes
+    for (Uint32 NumComponents : {1u, 2u, 4u})
+    {
+        std::vector<Uint16> Pixels(size_t{Width} * Height * NumComponents);
+        for (Uint32 y = 0; y < Height; ++y)
+        {
+            for (Uint32 x = 0; x < Width; ++x)
+            {
+                for (Uint32 c = 0; c < NumComponents; ++c)
+                    Pixels[(x + y * Width) * NumComponents + c] = static_cast<Uint16>(x * 1024 + y * 512 + c * 8192);
+            }
+        }
+
+        for (TEXTURE_LOAD_COMPRESS_MODE CompressMode : {TEXTURE_LOAD_COMPRESS_MODE_BC, TEXTURE_LOAD_COMPRESS_MODE_BC7})
+        {
+            RefCntAutoPtr<ITextureLoader> pLoader = CreateLoaderFromPixels(VT_UINT16, NumComponents, Width, Height, Pixels.data(), CompressMode);
+            ASSERT_NE(pLoader, nullptr);
+
+            const TextureDesc& Desc = pLoader->GetTextureDesc();
+
+            const TEXTURE_FORMAT ExpectedFormat = NumComponents == 1 ? TEX_FORMAT_BC4_UNORM :
+                                                                       (NumComponents == 2 ? TEX_FORMAT_BC5_UNORM :
+                                                                                             (CompressMode == TEXTURE_LOAD_COMPRESS_MODE_BC7 ? TEX_FORMAT_BC7_UNORM : TEX_FORMAT_BC3_UNORM));
+            ASSERT_EQ(Desc.Format, ExpectedFormat) << "NumComponents: " << NumComponents << ", CompressMode: " << Uint32{CompressMode};
+
+            const TEXTURE_FORMAT       DecompressedFormat = GetBCDecompressedFormat(Desc.Format);
+            const TextureFormatAttribs DstFmtAttribs      = GetTextureFormatAttribs(DecompressedFormat);
+            const Uint32               DstNumComponents   = DstFmtAttribs.NumComponents;
+
+            std::vector<Uint8> Decompressed(size_t{Width} * Height * DstNumComponents);
+
+            const TextureSubResData&   SubRes = pLoader->GetSubresourceData(0, 0);
+            DecompressBCSurfaceAttribs Attribs;
+            Attribs.Format    = Desc.Format;
+            Attribs.Width     = Width;
+            Attribs.Height    = Height;
+            Attribs.pSrcData  = SubRes.pData;
+            Attribs.SrcStride = SubRes.Stride;
+            Attribs.pDstData  = Decompressed.data();
+            Attribs.DstStride = Width * DstNumComponents;
+            ASSERT_TRUE(DecompressBCSurface(Attribs));
+
+            for (Uint32 i = 0; i < Width * Height; ++i)
+            {
+                for (Uint32 c = 0; c < NumComponents; ++c)
+                {
+                    const int Expected = Pixels[i * NumComponents + c] >> 8;
+                    const int Actual   = Decompressed[i * DstNumComponents + c];
+                    EXPECT_LE(std::abs(Actual - Expected), 8) << "Pixel " << i << ", component " << c;
+                }
+            }
+        }
+    }
+
+    // Float RGB images are only compressed to BC6H in BC7 modes
+    {
+        std::vector<float> Pixels(size_t{Width} * Height * 3, 0.5f);
+
+        RefCntAutoPtr<ITextureLoader> pLoader = CreateLoaderFromPixels(VT_FLOAT32, 3, Width, Height, Pixels.data(), TEXTURE_LOAD_COMPRESS_MODE_BC);
+        ASSERT_NE(pLoader, nullptr);
+        EXPECT_EQ(pLoader->GetTextureDesc().Format, TEX_FORMAT_RGBA32_FLOAT);
+
+        pLoader = CreateLoaderFromPixels(VT_FLOAT32, 3, Width, Height, Pixels.data(), TEXTURE_LOAD_COMPRESS_MODE_BC7_FAST);
+        ASSERT_NE(pLoader, nullptr);
+        EXPECT_EQ(pLoader->GetTextureDesc().Format, TEX_FORMAT_BC6H_UF16);
+    }
+}
+
+} // namespace
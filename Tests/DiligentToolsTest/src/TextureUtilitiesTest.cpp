@@ -25,8 +25,11 @@
  */
 
 #include "../interface/TextureUtilities.h"
+#include "../include/TextureUtilitiesSIMD.hpp"
 
 #include <limits>
+#include <algorithm>
+#include <cstring>
 
 #include "gtest/gtest.h"
 
@@ -380,6 +383,164 @@ TEST(Tools_TextureUtilities, CopyPixels32)
     TestCopyPixels<Uint32>();
 }
 
+// Disables the SIMD paths of the texture utilities to test the scalar fallback
+class ScalarPathScope
+{
+public:
+    ScalarPathScope() :
+        m_WasEnabled{IsTextureUtilitiesSIMDEnabled()}
+    {
+        SetTextureUtilitiesSIMDEnabled(false);
+    }
+    ~ScalarPathScope()
+    {
+        SetTextureUtilitiesSIMDEnabled(m_WasEnabled);
+    }
+
+private:
+    const bool m_WasEnabled;
+};
+
+// Straightforward per-component implementation of CopyPixels that is used to verify the optimized paths
+void CopyPixelsReference(const CopyPixelsAttribs& Attribs)
+{
+    auto ReadComponent = [](const Uint8* pSrc, Uint32 Size) {
+        Uint32 Val = 0;
+        memcpy(&Val, pSrc, Size);
+        return Val;
+    };
+
+    auto GetSrcComponent = [&Attribs](TEXTURE_COMPONENT_SWIZZLE Swizzle, Uint32 c) -> int {
+        int Comp = -1;
+        switch (Swizzle)
+        {
+            case TEXTURE_COMPONENT_SWIZZLE_IDENTITY: Comp = static_cast<int>(c); break;
+            case TEXTURE_COMPONENT_SWIZZLE_ZERO: return -1;
+            case TEXTURE_COMPONENT_SWIZZLE_ONE: return -2;
+            case TEXTURE_COMPONENT_SWIZZLE_R: Comp = 0; break;
+            case TEXTURE_COMPONENT_SWIZZLE_G: Comp = 1; break;
+            case TEXTURE_COMPONENT_SWIZZLE_B: Comp = 2; break;
+            case TEXTURE_COMPONENT_SWIZZLE_A: Comp = 3; break;
+            default: UNEXPECTED("Unexpected swizzle");
+        }
+        return Comp < static_cast<int>(Attribs.SrcCompCount) ? Comp : -1;
+    };
+
+    const TEXTURE_COMPONENT_SWIZZLE Swizzles[] = {Attribs.Swizzle.R, Attribs.Swizzle.G, Attribs.Swizzle.B, Attribs.Swizzle.A};
+
+    const Uint32 MaxDstVal = Attribs.DstComponentSize == 4 ? ~0u : (1u << (Attribs.DstComponentSize * 8)) - 1;
+    for (Uint32 y = 0; y < Attribs.Height; ++y)
+    {
+        const Uint32 src_y   = Attribs.FlipVertically ? Attribs.Height - y - 1 : y;
+        const Uint8* pSrcRow = static_cast<const Uint8*>(Attribs.pSrcPixels) + src_y * Attribs.SrcStride;
+        Uint8*       pDstRow = static_cast<Uint8*>(Attribs.pDstPixels) + y * Attribs.DstStride;
+        for (Uint32 x = 0; x < Attribs.Width; ++x)
+        {
+            for (Uint32 c = 0; c < Attribs.DstCompCount; ++c)
+            {
+                const int SrcComp = GetSrcComponent(Swizzles[c], c);
+
+                Uint32 Val = 0;
+                if (SrcComp >= 0)
+                {
+                    Val = ReadComponent(pSrcRow + (x * Attribs.SrcCompCount + SrcComp) * Attribs.SrcComponentSize, Attribs.SrcComponentSize);
+                    if (Attribs.DstComponentSize > Attribs.SrcComponentSize)
+                        Val <<= (Attribs.DstComponentSize - Attribs.SrcComponentSize) * 8;
+                    else
+                        Val >>= (Attribs.SrcComponentSize - Attribs.DstComponentSize) * 8;
+                }
+                else if (SrcComp == -2)
+                {
+                    Val = MaxDstVal;
+                }
+                memcpy(pDstRow + (x * Attribs.DstCompCount + c) * Attribs.DstComponentSize, &Val, Attribs.DstComponentSize);
+            }
+        }
+    }
+}
+
+void TestCopyPixelsAgainstReference()
+{
+    const TextureComponentMapping Swizzles[] = {
+        TextureComponentMapping::Identity(),
+        {TEXTURE_COMPONENT_SWIZZLE_B, TEXTURE_COMPONENT_SWIZZLE_G, TEXTURE_COMPONENT_SWIZZLE_R, TEXTURE_COMPONENT_SWIZZLE_A},
+        {TEXTURE_COMPONENT_SWIZZLE_R, TEXTURE_COMPONENT_SWIZZLE_R, TEXTURE_COMPONENT_SWIZZLE_R, TEXTURE_COMPONENT_SWIZZLE_ONE},
+        {TEXTURE_COMPONENT_SWIZZLE_ZERO, TEXTURE_COMPONENT_SWIZZLE_A, TEXTURE_COMPONENT_SWIZZLE_ONE, TEXTURE_COMPONENT_SWIZZLE_G},
+    };
+
+    Uint32 Seed = 0;
+    for (Uint32 SrcCompSize : {1, 2, 4})
+    {
+        for (Uint32 DstCompSize : {1, 2, 4})
+        {
+            for (Uint32 SrcCompCount = 1; SrcCompCount <= 4; ++SrcCompCount)
+            {
+                for (Uint32 DstCompCount = 1; DstCompCount <= 4; ++DstCompCount)
+                {
+                    for (const TextureComponentMapping& Swizzle : Swizzles)
+                    {
+                        // Widths that exercise the SIMD loop and the scalar tail
+                        for (Uint32 Width : {1, 5, 16, 67})
+                        {
+                            for (bool FlipVertically : {false, true})
+                            {
+                                constexpr Uint32 Height = 3;
+
+                                CopyPixelsAttribs Attribs;
+                                Attribs.Width            = Width;
+                                Attribs.Height           = Height;
+                                Attribs.SrcComponentSize = SrcCompSize;
+                                Attribs.SrcCompCount     = SrcCompCount;
+                                Attribs.SrcStride        = Width * SrcCompSize * SrcCompCount + 4;
+                                Attribs.DstComponentSize = DstCompSize;
+                                Attribs.DstCompCount     = DstCompCount;
+                                Attribs.DstStride        = Width * DstCompSize * DstCompCount + 8;
+                                Attribs.FlipVertically   = FlipVertically;
+                                Attribs.Swizzle          = Swizzle;
+
+                                std::vector<Uint8> SrcData(size_t{Attribs.SrcStride} * Height);
+                                for (Uint8& Val : SrcData)
+                                    Val = static_cast<Uint8>((++Seed * 2654435761u) >> 24u);
+                                Attribs.pSrcPixels = SrcData.data();
+
+                                std::vector<Uint8> TestData(size_t{Attribs.DstStride} * Height);
+                                Attribs.pDstPixels = TestData.data();
+                                CopyPixels(Attribs);
+
+                                std::vector<Uint8> RefData(TestData.size());
+                                Attribs.pDstPixels = RefData.data();
+                                CopyPixelsReference(Attribs);
+
+                                const Uint32 DstRowSize = Width * DstCompSize * DstCompCount;
+                                for (Uint32 y = 0; y < Height; ++y)
+                                {
+                                    const Uint8* pTestRow = &TestData[y * Attribs.DstStride];
+                                    const Uint8* pRefRow  = &RefData[y * Attribs.DstStride];
+                                    EXPECT_TRUE(std::equal(pTestRow, pTestRow + DstRowSize, pRefRow))
+                                        << "SrcCompSize=" << SrcCompSize << " DstCompSize=" << DstCompSize
+                                        << " SrcCompCount=" << SrcCompCount << " DstCompCount=" << DstCompCount
+                                        << " Width=" << Width << " row=" << y;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(Tools_TextureUtilities, CopyPixelsReference)
+{
+    TestCopyPixelsAgainstReference();
+}
+
+TEST(Tools_TextureUtilities, CopyPixelsReferenceScalar)
+{
+    ScalarPathScope Scalar;
+    TestCopyPixelsAgainstReference();
+}
+
 
 
 template <typename DataType>
@@ -675,4 +836,57 @@ TEST(Tools_TextureUtilities, PremultiplyAlphaFloat)
     TestPremultiplyAlpha<float>(VT_FLOAT32);
 }
 
+void TestPremultiplyAlpha8AllValues()
+{
+    // Every row contains all color values premultiplied with the same alpha.
+    // Odd width exercises both the SIMD loop and the scalar tail.
+    constexpr Uint32 Width  = 257;
+    constexpr Uint32 Height = 256;
+
+    std::vector<Uint8> Data(size_t{Width} * Height * 4);
+    for (Uint32 y = 0; y < Height; ++y)
+    {
+        for (Uint32 x = 0; x < Width; ++x)
+        {
+            Uint8* pPixel = &Data[(size_t{y} * Width + x) * 4];
+            pPixel[0]     = static_cast<Uint8>(x);
+            pPixel[1]     = static_cast<Uint8>(255 - x);
+            pPixel[2]     = static_cast<Uint8>(x * 7);
+            pPixel[3]     = static_cast<Uint8>(y);
+        }
+    }
+    const std::vector<Uint8> SrcData = Data;
+
+    PremultiplyAlphaAttribs Attribs;
+    Attribs.Width          = Width;
+    Attribs.Height         = Height;
+    Attribs.ComponentType  = VT_UINT8;
+    Attribs.ComponentCount = 4;
+    Attribs.Stride         = Width * 4;
+    Attribs.pPixels        = Data.data();
+    PremultiplyAlpha(Attribs);
+
+    for (size_t i = 0; i < Data.size(); i += 4)
+    {
+        const Uint32 A = SrcData[i + 3];
+        for (size_t c = 0; c < 3; ++c)
+        {
+            const Uint32 RefVal = (SrcData[i + c] * A + 127) / 255;
+            ASSERT_EQ(Data[i + c], RefVal) << "C=" << Uint32{SrcData[i + c]} << " A=" << A;
+        }
+        ASSERT_EQ(Data[i + 3], SrcData[i + 3]);
+    }
+}
+
+TEST(Tools_TextureUtilities, PremultiplyAlpha8AllValues)
+{
+    TestPremultiplyAlpha8AllValues();
+}
+
+TEST(Tools_TextureUtilities, PremultiplyAlpha8AllValuesScalar)
+{
+    ScalarPathScope Scalar;
+    TestPremultiplyAlpha8AllValues();
+}
+
 } // namespace
@@ -39,4 +39,5 @@ void TestArchiver_CInterface(IArchiver* pArchiver)
     (void)pPSO;
     IPipelineResourceSignature* pPRS = IArchiver_GetPipelineResourceSignature(pArchiver, "Name");
     (void)pPRS;
+    IArchiver_SetShaderCompression(pArchiver, ARCHIVE_SHADER_COMPRESSION_LZ4, 0);
 }
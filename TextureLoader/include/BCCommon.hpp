@@ -0,0 +1,344 @@
+/*
+ *  Copyright 2019-2025 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "BasicTypes.h"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+// Interpolation weights shared by BC6H and BC7
+constexpr Uint32 BCWeights2[] = {0, 21, 43, 64};
+constexpr Uint32 BCWeights3[] = {0, 9, 18, 27, 37, 46, 55, 64};
+constexpr Uint32 BCWeights4[] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+inline const Uint32* GetInterpolationWeights(Uint32 IndexBits)
+{
+    switch (IndexBits)
+    {
+        case 2: return BCWeights2;
+        case 3: return BCWeights3;
+        case 4: return BCWeights4;
+
+        default:
+            UNEXPECTED("Unexpected number of index bits: ", IndexBits);
+            return BCWeights2;
+    }
+}
+
+// Two-subset partitions shared by BC7 and BC6H (which only uses the first 32 entries).
+// Bit i is set if pixel i belongs to the second subset.
+constexpr Uint16 BCPartitions2[64] =
+    {
+        0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+        0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+        0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+        0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+        0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+        0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+        0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+        0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+    };
+
+// Anchor pixel of the second subset for every two-subset partition
+constexpr Uint8 BCAnchors2[64] =
+    {
+        15, 15, 15, 15, 15, 15, 15, 15,
+        15, 15, 15, 15, 15, 15, 15, 15,
+        15,  2,  8,  2,  2,  8,  8, 15,
+         2,  8,  2,  2,  8,  8,  2,  2,
+        15, 15,  6,  8,  2,  8, 15, 15,
+         2,  8,  2,  2,  2, 15, 15,  6,
+         6,  2,  6,  8, 15, 15,  2,  2,
+        15, 15, 15, 15, 15,  2,  2, 15,
+    };
+
+// Three-subset BC7 partitions. Bits 2*i..2*i+1 contain the subset of pixel i.
+constexpr Uint32 BCPartitions3[64] =
+    {
+        0xAA685050, 0x6A5A5040, 0x5A5A4200, 0x5450A0A8, 0xA5A50000, 0xA0A05050, 0x5555A0A0, 0x5A5A5050,
+        0xAA550000, 0xAA555500, 0xAAAA5500, 0x90909090, 0x94949494, 0xA4A4A4A4, 0xA9A59450, 0x2A0A4250,
+        0xA5945040, 0x0A425054, 0xA5A5A500, 0x55A0A0A0, 0xA8A85454, 0x6A6A4040, 0xA4A45000, 0x1A1A0500,
+        0x0050A4A4, 0xAAA59090, 0x14696914, 0x69691400, 0xA08585A0, 0xAA821414, 0x50A4A450, 0x6A5A0200,
+        0xA9A58000, 0x5090A0A8, 0xA8A09050, 0x24242424, 0x00AA5500, 0x24924924, 0x24499224, 0x50A50A50,
+        0x500AA550, 0xAAAA4444, 0x66660000, 0xA5A0A5A0, 0x50A050A0, 0x69286928, 0x44AAAA44, 0x66666600,
+        0xAA444444, 0x54A854A8, 0x95809580, 0x96969600, 0xA85454A8, 0x80959580, 0xAA141414, 0x96960000,
+        0xAAAA1414, 0xA05050A0, 0xA0A5A5A0, 0x96000000, 0x40804080, 0xA9A8A9A8, 0xAAAAAA44, 0x2A4A5254,
+    };
+
+// Anchor pixels of the second and third subsets for every three-subset partition
+constexpr Uint8 BCAnchors3[2][64] =
+    {
+        {
+             3,  3, 15, 15,  8,  3, 15, 15,
+             8,  8,  6,  6,  6,  5,  3,  3,
+             3,  3,  8, 15,  3,  3,  6, 10,
+             5,  8,  8,  6,  8,  5, 15, 15,
+             8, 15,  3,  5,  6, 10,  8, 15,
+            15,  3, 15,  5, 15, 15, 15, 15,
+             3, 15,  5,  5,  5,  8,  5, 10,
+             5, 10,  8, 13, 15, 12,  3,  3,
+        },
+        {
+            15,  8,  8,  3, 15, 15,  3,  8,
+            15, 15, 15, 15, 15, 15, 15,  8,
+            15,  8, 15,  3, 15,  8, 15,  8,
+             3, 15,  6, 10, 15, 15, 10,  8,
+            15,  3, 15, 10, 10,  8,  9, 10,
+             6, 15,  8, 15,  3,  6,  6,  8,
+            15,  3, 15, 15, 15, 15, 15, 15,
+            15, 15, 15, 15,  3, 15, 15,  8,
+        },
+    };
+
+// Returns the subset that pixel i belongs to
+inline Uint32 GetBCPixelSubset(Uint32 NumSubsets, Uint32 Partition, Uint32 i)
+{
+    switch (NumSubsets)
+    {
+        case 1: return 0;
+        case 2: return (BCPartitions2[Partition] >> i) & 0x01u;
+        case 3: return (BCPartitions3[Partition] >> (i * 2)) & 0x03u;
+
+        default:
+            UNEXPECTED("Unexpected number of subsets: ", NumSubsets);
+            return 0;
+    }
+}
+
+// Returns true if pixel i is the anchor pixel of its subset
+inline bool IsBCAnchorPixel(Uint32 NumSubsets, Uint32 Partition, Uint32 i)
+{
+    if (i == 0)
+        return true;
+
+    switch (NumSubsets)
+    {
+        case 1: return false;
+        case 2: return i == BCAnchors2[Partition];
+        case 3: return i == BCAnchors3[0][Partition] || i == BCAnchors3[1][Partition];
+
+        default:
+            UNEXPECTED("Unexpected number of subsets: ", NumSubsets);
+            return false;
+    }
+}
+
+// Returns the anchor pixel of the subset
+inline Uint32 GetBCAnchorPixel(Uint32 NumSubsets, Uint32 Partition, Uint32 Subset)
+{
+    if (Subset == 0)
+        return 0;
+
+    switch (NumSubsets)
+    {
+        case 2: return BCAnchors2[Partition];
+        case 3: return BCAnchors3[Subset - 1][Partition];
+
+        default:
+            UNEXPECTED("Unexpected number of subsets: ", NumSubsets);
+            return 0;
+    }
+}
+
+
+// BC7
+
+struct BC7ModeDesc
+{
+    Uint8 NumSubsets;
+    Uint8 PartitionBits;
+    Uint8 RotationBits;
+    Uint8 IndexSelectionBits;
+    Uint8 ColorBits;
+    Uint8 AlphaBits;
+    Uint8 EndpointPBits; // 1 if every endpoint has a unique p-bit
+    Uint8 SharedPBits;   // 1 if both endpoints of a subset share the p-bit
+    Uint8 IndexBits;
+    Uint8 Index2Bits; // Secondary index bits, 0 if the mode only has one index set
+};
+
+// clang-format off
+constexpr BC7ModeDesc BC7Modes[8] =
+{
+    // NS  PB  RB  ISB  CB  AB  EPB  SPB  IB  IB2
+    {  3,  4,  0,  0,   4,  0,  1,   0,   3,  0},
+    {  2,  6,  0,  0,   6,  0,  0,   1,   3,  0},
+    {  3,  6,  0,  0,   5,  0,  0,   0,   2,  0},
+    {  2,  6,  0,  0,   7,  0,  1,   0,   2,  0},
+    {  1,  0,  2,  1,   5,  6,  0,   0,   2,  3},
+    {  1,  0,  2,  0,   7,  8,  0,   0,   2,  2},
+    {  1,  0,  0,  0,   7,  7,  1,   0,   4,  0},
+    {  2,  6,  0,  0,   5,  5,  1,   0,   2,  0},
+};
+// clang-format on
+
+// Expands the endpoint component with an optional p-bit to 8 bits
+inline Uint32 UnquantizeBC7(Uint32 Value, Uint32 Bits, Uint32 PBit, bool HasPBit)
+{
+    if (HasPBit)
+    {
+        Value = (Value << 1u) | PBit;
+        ++Bits;
+    }
+    Value <<= 8u - Bits;
+    return Value | (Value >> Bits);
+}
+
+
+// BC6H
+
+// Endpoint fields. Region 0 endpoints are W and X, region 1 endpoints are Y and Z.
+enum BC6H_FIELD : Uint8
+{
+    RW, RX, RY, RZ,
+    GW, GX, GY, GZ,
+    BW, BX, BY, BZ,
+    D,
+    BC6H_FIELD_COUNT
+};
+
+// Bits Field[Last:First] as written in the BC6H specification: bit First is stored first
+// and bit Last is stored last. If First > Last, the bits are stored in reversed order.
+struct BC6HFieldBits
+{
+    BC6H_FIELD Field;
+    Uint8      Last;
+    Uint8      First;
+};
+
+struct BC6HModeDesc
+{
+    Uint8                ModeBits;
+    Uint8                NumModeBits;
+    Uint8                NumRegions;
+    bool                 Transformed;
+    Uint8                EndpointBits;
+    Uint8                DeltaBits[3];
+    const BC6HFieldBits* Layout;
+    Uint32               LayoutSize;
+};
+
+// clang-format off
+constexpr BC6HFieldBits BC6HMode1Layout[] =
+{
+    {GY, 4, 4}, {BY, 4, 4}, {BZ, 4, 4}, {RW, 9, 0}, {GW, 9, 0}, {BW, 9, 0}, {RX, 4, 0}, {GZ, 4, 4}, {GY, 3, 0}, {GX, 4, 0},
+    {BZ, 0, 0}, {GZ, 3, 0}, {BX, 4, 0}, {BZ, 1, 1}, {BY, 3, 0}, {RY, 4, 0}, {BZ, 2, 2}, {RZ, 4, 0}, {BZ, 3, 3}, {D,  4, 0},
+};
+constexpr BC6HFieldBits BC6HMode2Layout[] =
+{
+    {GY, 5, 5}, {GZ, 4, 4}, {GZ, 5, 5}, {RW, 6, 0}, {BZ, 0, 0}, {BZ, 1, 1}, {BY, 4, 4}, {GW, 6, 0}, {BY, 5, 5}, {BZ, 2, 2},
+    {GY, 4, 4}, {BW, 6, 0}, {BZ, 3, 3}, {BZ, 5, 5}, {BZ, 4, 4}, {RX, 5, 0}, {GY, 3, 0}, {GX, 5, 0}, {GZ, 3, 0}, {BX, 5, 0},
+    {BY, 3, 0}, {RY, 5, 0}, {RZ, 5, 0}, {D,  4, 0},
+};
+constexpr BC6HFieldBits BC6HMode3Layout[] =
+{
+    {RW, 9, 0}, {GW, 9, 0}, {BW, 9, 0}, {RX, 4, 0}, {RW,10,10}, {GY, 3, 0}, {GX, 3, 0}, {GW,10,10}, {GZ, 3, 0}, {BX, 3, 0},
+    {BW,10,10}, {BZ, 0, 0}, {BY, 3, 0}, {RY, 4, 0}, {BZ, 1, 1}, {BZ, 2, 2}, {RZ, 4, 0}, {BZ, 3, 3}, {D,  4, 0},
+};
+constexpr BC6HFieldBits BC6HMode4Layout[] =
+{
+    {RW, 9, 0}, {GW, 9, 0}, {BW, 9, 0}, {RX, 3, 0}, {RW,10,10}, {GZ, 4, 4}, {GY, 3, 0}, {GX, 4, 0}, {GW,10,10}, {GZ, 3, 0},
+    {BX, 3, 0}, {BW,10,10}, {BZ, 1, 1}, {BY, 3, 0}, {RY, 3, 0}, {BZ, 0, 0}, {BZ, 2, 2}, {RZ, 3, 0}, {GY, 4, 4}, {BZ, 3, 3},
+    {D,  4, 0},
+};
+constexpr BC6HFieldBits BC6HMode5Layout[] =
+{
+    {RW, 9, 0}, {GW, 9, 0}, {BW, 9, 0}, {RX, 3, 0}, {RW,10,10}, {BY, 4, 4}, {GY, 3, 0}, {GX, 3, 0}, {GW,10,10}, {BZ, 0, 0},
+    {GZ, 3, 0}, {BX, 4, 0}, {BW,10,10}, {BY, 3, 0}, {RY, 3, 0}, {BZ, 1, 1}, {BZ, 2, 2}, {RZ, 3, 0}, {BZ, 4, 4}, {BZ, 3, 3},
+    {D,  4, 0},
+};
+constexpr BC6HFieldBits BC6HMode6Layout[] =
+{
+    {RW, 8, 0}, {BY, 4, 4}, {GW, 8, 0}, {GY, 4, 4}, {BW, 8, 0}, {BZ, 4, 4}, {RX, 4, 0}, {GZ, 4, 4}, {GY, 3, 0}, {GX, 4, 0},
+    {BZ, 0, 0}, {GZ, 3, 0}, {BX, 4, 0}, {BZ, 1, 1}, {BY, 3, 0}, {RY, 4, 0}, {BZ, 2, 2}, {RZ, 4, 0}, {BZ, 3, 3}, {D,  4, 0},
+};
+constexpr BC6HFieldBits BC6HMode7Layout[] =
+{
+    {RW, 7, 0}, {GZ, 4, 4}, {BY, 4, 4}, {GW, 7, 0}, {BZ, 2, 2}, {GY, 4, 4}, {BW, 7, 0}, {BZ, 3, 3}, {BZ, 4, 4}, {RX, 5, 0},
+    {GY, 3, 0}, {GX, 4, 0}, {BZ, 0, 0}, {GZ, 3, 0}, {BX, 4, 0}, {BZ, 1, 1}, {BY, 3, 0}, {RY, 5, 0}, {RZ, 5, 0}, {D,  4, 0},
+};
+constexpr BC6HFieldBits BC6HMode8Layout[] =
+{
+    {RW, 7, 0}, {BZ, 0, 0}, {BY, 4, 4}, {GW, 7, 0}, {GY, 5, 5}, {GY, 4, 4}, {BW, 7, 0}, {GZ, 5, 5}, {BZ, 4, 4}, {RX, 4, 0},
+    {GZ, 4, 4}, {GY, 3, 0}, {GX, 5, 0}, {GZ, 3, 0}, {BX, 4, 0}, {BZ, 1, 1}, {BY, 3, 0}, {RY, 4, 0}, {BZ, 2, 2}, {RZ, 4, 0},
+    {BZ, 3, 3}, {D,  4, 0},
+};
+constexpr BC6HFieldBits BC6HMode9Layout[] =
+{
+    {RW, 7, 0}, {BZ, 1, 1}, {BY, 4, 4}, {GW, 7, 0}, {BY, 5, 5}, {GY, 4, 4}, {BW, 7, 0}, {BZ, 5, 5}, {BZ, 4, 4}, {RX, 4, 0},
+    {GZ, 4, 4}, {GY, 3, 0}, {GX, 4, 0}, {BZ, 0, 0}, {GZ, 3, 0}, {BX, 5, 0}, {BY, 3, 0}, {RY, 4, 0}, {BZ, 2, 2}, {RZ, 4, 0},
+    {BZ, 3, 3}, {D,  4, 0},
+};
+constexpr BC6HFieldBits BC6HMode10Layout[] =
+{
+    {RW, 5, 0}, {GZ, 4, 4}, {BZ, 0, 0}, {BZ, 1, 1}, {BZ, 4, 4}, {GW, 5, 0}, {GY, 5, 5}, {GZ, 5, 5}, {BZ, 2, 2}, {GY, 4, 4},
+    {BW, 5, 0}, {BY, 5, 5}, {BZ, 3, 3}, {BZ, 5, 5}, {BY, 4, 4}, {RX, 5, 0}, {GY, 3, 0}, {GX, 5, 0}, {GZ, 3, 0}, {BX, 5, 0},
+    {BY, 3, 0}, {RY, 5, 0}, {RZ, 5, 0}, {D,  4, 0},
+};
+constexpr BC6HFieldBits BC6HMode11Layout[] =
+{
+    {RW, 9, 0}, {GW, 9, 0}, {BW, 9, 0}, {RX, 9, 0}, {GX, 9, 0}, {BX, 9, 0},
+};
+constexpr BC6HFieldBits BC6HMode12Layout[] =
+{
+    {RW, 9, 0}, {GW, 9, 0}, {BW, 9, 0}, {RX, 8, 0}, {RW,10,10}, {GX, 8, 0}, {GW,10,10}, {BX, 8, 0}, {BW,10,10},
+};
+constexpr BC6HFieldBits BC6HMode13Layout[] =
+{
+    {RW, 9, 0}, {GW, 9, 0}, {BW, 9, 0}, {RX, 7, 0}, {RW,10,11}, {GX, 7, 0}, {GW,10,11}, {BX, 7, 0}, {BW,10,11},
+};
+constexpr BC6HFieldBits BC6HMode14Layout[] =
+{
+    {RW, 9, 0}, {GW, 9, 0}, {BW, 9, 0}, {RX, 3, 0}, {RW,10,15}, {GX, 3, 0}, {GW,10,15}, {BX, 3, 0}, {BW,10,15},
+};
+
+#define BC6H_LAYOUT(Layout) Layout, _countof(Layout)
+constexpr BC6HModeDesc BC6HModes[] =
+{
+    // Mode bits, number of mode bits, regions, transformed, endpoint bits, delta bits
+    {0x00, 2, 2, true,  10, { 5, 5, 5}, BC6H_LAYOUT(BC6HMode1Layout) },
+    {0x01, 2, 2, true,   7, { 6, 6, 6}, BC6H_LAYOUT(BC6HMode2Layout) },
+    {0x02, 5, 2, true,  11, { 5, 4, 4}, BC6H_LAYOUT(BC6HMode3Layout) },
+    {0x06, 5, 2, true,  11, { 4, 5, 4}, BC6H_LAYOUT(BC6HMode4Layout) },
+    {0x0A, 5, 2, true,  11, { 4, 4, 5}, BC6H_LAYOUT(BC6HMode5Layout) },
+    {0x0E, 5, 2, true,   9, { 5, 5, 5}, BC6H_LAYOUT(BC6HMode6Layout) },
+    {0x12, 5, 2, true,   8, { 6, 5, 5}, BC6H_LAYOUT(BC6HMode7Layout) },
+    {0x16, 5, 2, true,   8, { 5, 6, 5}, BC6H_LAYOUT(BC6HMode8Layout) },
+    {0x1A, 5, 2, true,   8, { 5, 5, 6}, BC6H_LAYOUT(BC6HMode9Layout) },
+    {0x1E, 5, 2, false,  6, { 6, 6, 6}, BC6H_LAYOUT(BC6HMode10Layout)},
+    {0x03, 5, 1, false, 10, {10,10,10}, BC6H_LAYOUT(BC6HMode11Layout)},
+    {0x07, 5, 1, true,  11, { 9, 9, 9}, BC6H_LAYOUT(BC6HMode12Layout)},
+    {0x0B, 5, 1, true,  12, { 8, 8, 8}, BC6H_LAYOUT(BC6HMode13Layout)},
+    {0x0F, 5, 1, true,  16, { 4, 4, 4}, BC6H_LAYOUT(BC6HMode14Layout)},
+};
+#undef BC6H_LAYOUT
+// clang-format on
+
+} // namespace Diligent
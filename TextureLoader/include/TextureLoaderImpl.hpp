@@ -27,6 +27,7 @@
 #include <vector>
 
 #include "TextureLoader.h"
+#include "ThreadPool.h"
 #include "RefCntAutoPtr.hpp"
 #include "ObjectBase.hpp"
 
@@ -49,6 +50,10 @@ public:
                       const TextureLoadInfo& TexLoadInfo,
                       RefCntAutoPtr<Image>   pImage);
 
+    TextureLoaderImpl(IReferenceCounters*    pRefCounters,
+                      const TextureLoadInfo& TexLoadInfo,
+                      IFileStream*           pDDSFileStream);
+
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_TextureLoader, TBase)
 
     virtual void DILIGENT_CALL_TYPE CreateTexture(IRenderDevice* pDevice,
@@ -74,9 +79,14 @@ public:
 
 private:
     void LoadFromImage(RefCntAutoPtr<Image> pImage, const TextureLoadInfo& TexLoadInfo);
+    void LoadFromImageRows(IMAGE_FILE_FORMAT FileFormat, const Uint8* pData, size_t DataSize, const TextureLoadInfo& TexLoadInfo);
+    void AllocateImageMips(Uint32 FirstMip, const TextureLoadInfo& TexLoadInfo);
     void LoadFromKTX(const TextureLoadInfo& TexLoadInfo, const Uint8* pData, size_t DataSize);
+    void LoadFromKTX20(const TextureLoadInfo& TexLoadInfo, const Uint8* pData, size_t DataSize);
     void LoadFromDDS(const TextureLoadInfo& TexLoadInfo, const Uint8* pData, size_t DataSize);
+    void LoadFromDDS(const TextureLoadInfo& TexLoadInfo, IFileStream* pFileStream);
     void CompressSubresources(Uint32 NumComponents, Uint32 NumSrcComponents, const TextureLoadInfo& TexLoadInfo);
+    void CreateDecompressedTexture(IRenderDevice* pDevice, ITexture** ppTexture);
 
 private:
     RefCntAutoPtr<IDataBlob> m_pDataBlob;
@@ -85,8 +95,22 @@ private:
     const std::string m_Name;
     TextureDesc       m_TexDesc;
 
+    const bool                 m_DecompressUnsupportedBC;
+    RefCntAutoPtr<IThreadPool> m_pThreadPool;
+
     std::vector<TextureSubResData>        m_SubResources;
     std::vector<RefCntAutoPtr<IDataBlob>> m_Mips;
 };
 
+/// Selects the range of mip levels requested by TexLoadInfo.FirstMipLevel and TexLoadInfo.MipLevels.
+
+/// TexDesc must describe all mip levels of the source texture. On return, it describes
+/// the loaded mip range. The function returns the index of the first source mip level.
+Uint32 SelectMipRange(TextureDesc& TexDesc, const TextureLoadInfo& TexLoadInfo);
+
+/// Reads the description of the texture stored in KTX or KTX2 data without loading the texture.
+
+/// Returns the size of the memory that the loader needs to decompress the supercompressed levels.
+size_t ReadKTXTextureDesc(const Uint8* pData, size_t DataSize, const TextureLoadInfo& TexLoadInfo, TextureDesc& TexDesc);
+
 } // namespace Diligent
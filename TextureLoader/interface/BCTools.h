@@ -27,12 +27,17 @@
 #pragma once
 
 /// \file
-/// BC texture decompression functions.
+/// BC texture compression and decompression functions.
 
 #include "../../../DiligentCore/Primitives/interface/BasicTypes.h"
+#include "../../../DiligentCore/Graphics/GraphicsEngine/interface/GraphicsTypes.h"
 
 DILIGENT_BEGIN_NAMESPACE(Diligent)
 
+#include "../../../DiligentCore/Primitives/interface/DefineRefMacro.h"
+
+struct IThreadPool;
+
 // clang-format off
 
 /// Decompresses BC1 block (4x4 RGB).
@@ -41,11 +46,22 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 /// \param[out] DstBuffer   - Pointer to the output 4x4 RGB or RGBA buffer.
 /// \param[in]  DstChannels - The number of components in the output buffer.
 ///                           Must be 3 (RGB) or 4 (RGBA).
+///
+/// \remarks In 3-color mode, pixels with index 3 are black and, if DstChannels is 4,
+///          fully transparent. All other pixels are opaque.
 void DecompressBC1Block(const Uint8* Bits,
                         Uint8*       DstBuffer,
                         Uint32       DstChannels DEFAULT_VALUE(4));
 
 
+/// Decompresses BC2 block (4x4 RGB + explicit 4-bit A).
+
+/// \param[in]  Bits      - Compressed block bits.
+/// \param[out] DstBuffer - Pointer to the output 4x4 RGBA buffer.
+void DecompressBC2Block(const Uint8* Bits,
+                        Uint8*       DstBuffer);
+
+
 /// Decompresses BC3 block (4x4 RGB+A).
 
 /// \param[in]  Bits      - Compressed block bits.
@@ -69,11 +85,157 @@ void DecompressBC4Block(const Uint8* Bits,
 /// \param[in]  Bits        - Compressed block bits.
 /// \param[out] DstBuffer   - Pointer to the output 4x4 pixel buffer.
 /// \param[in]  DstChannels - The number of components in the output buffer.
-///                           Must be greater than 2.
+///                           Must be at least 2.
 void DecompressBC5Block(const Uint8* Bits,
                         Uint8*       DstBuffer,
                         Uint32       DstChannels DEFAULT_VALUE(2));
 
+
+/// Decompresses BC6H block (4x4 RGB half-precision float).
+
+/// \param[in]  Bits        - Compressed block bits.
+/// \param[out] DstBuffer   - Pointer to the output 4x4 float buffer.
+/// \param[in]  DstChannels - The number of components in the output buffer.
+///                           Must be 3 (RGB) or 4 (RGBA). Alpha is set to 1.
+/// \param[in]  IsSigned    - Whether the block uses BC6H_SF16 (true) or BC6H_UF16 (false) format.
+///
+/// \remarks Blocks that use reserved modes are decompressed to zero.
+void DecompressBC6HBlock(const Uint8* Bits,
+                         float*       DstBuffer,
+                         Uint32       DstChannels DEFAULT_VALUE(4),
+                         Bool         IsSigned    DEFAULT_VALUE(False));
+
+
+/// Decompresses BC6H block to half-precision float values.
+
+/// This function is similar to DecompressBC6HBlock, but writes the output
+/// pixels as 16-bit floating-point values. The result is exact since
+/// BC6H interpolation produces half-precision bit patterns.
+void DecompressBC6HBlockHalf(const Uint8* Bits,
+                             Uint16*      DstBuffer,
+                             Uint32       DstChannels DEFAULT_VALUE(4),
+                             Bool         IsSigned    DEFAULT_VALUE(False));
+
+
+/// Decompresses BC7 block (4x4 RGBA).
+
+/// \param[in]  Bits      - Compressed block bits.
+/// \param[out] DstBuffer - Pointer to the output 4x4 RGBA buffer.
+///
+/// \remarks Blocks that use the reserved mode are decompressed to transparent black.
+void DecompressBC7Block(const Uint8* Bits,
+                        Uint8*       DstBuffer);
+
+
+/// Returns the uncompressed format that the surface of the given BC format is decompressed to
+/// by DecompressBCSurface:
+/// - BC1, BC2, BC3, BC7 -> RGBA8_UNORM or RGBA8_UNORM_SRGB;
+/// - BC4 -> R8_UNORM or R8_SNORM;
+/// - BC5 -> RG8_UNORM or RG8_SNORM;
+/// - BC6H -> RGBA16_FLOAT.
+///
+/// If the format is not a BC format, returns TEX_FORMAT_UNKNOWN.
+TEXTURE_FORMAT GetBCDecompressedFormat(TEXTURE_FORMAT Format);
+
+
+/// Parameters of the DecompressBCSurface function.
+struct DecompressBCSurfaceAttribs
+{
+    /// Compressed surface format, must be one of the BC formats.
+    TEXTURE_FORMAT Format DEFAULT_INITIALIZER(TEX_FORMAT_UNKNOWN);
+
+    /// Surface width in pixels. Does not need to be a multiple of 4.
+    Uint32 Width DEFAULT_INITIALIZER(0);
+
+    /// Surface height in pixels. Does not need to be a multiple of 4.
+    Uint32 Height DEFAULT_INITIALIZER(0);
+
+    /// A pointer to the compressed blocks.
+    const void* pSrcData DEFAULT_INITIALIZER(nullptr);
+
+    /// Stride between the rows of 4x4 blocks, in bytes.
+    Uint64 SrcStride DEFAULT_INITIALIZER(0);
+
+    /// A pointer to the destination pixels in the format returned by GetBCDecompressedFormat.
+    void* pDstData DEFAULT_INITIALIZER(nullptr);
+
+    /// Stride between the rows of destination pixels, in bytes.
+    Uint64 DstStride DEFAULT_INITIALIZER(0);
+
+    /// An optional thread pool to decompress block rows in parallel.
+    struct IThreadPool* pThreadPool DEFAULT_INITIALIZER(nullptr);
+};
+typedef struct DecompressBCSurfaceAttribs DecompressBCSurfaceAttribs;
+
+/// Decompresses the entire BC surface.
+
+/// Only the pixels within [0, Width) x [0, Height) are written to the destination.
+/// Returns false if the format is not a BC format.
+Bool DecompressBCSurface(const DecompressBCSurfaceAttribs REF Attribs);
+
+
+/// BC7 and BC6H compression quality.
+DILIGENT_TYPED_ENUM(BC_COMPRESSION_QUALITY, Uint8)
+{
+    /// Only use single-subset modes (BC7 mode 6, BC6H mode 11).
+    BC_COMPRESSION_QUALITY_FAST = 0,
+
+    /// Additionally try two-subset modes for a few best candidate partitions
+    /// and refine the endpoints more.
+    BC_COMPRESSION_QUALITY_NORMAL,
+
+    /// Try all BC7 modes and all BC6H modes, search more partitions and run
+    /// more endpoint refinement iterations.
+    /// This is typically 4-15 times slower than BC_COMPRESSION_QUALITY_NORMAL.
+    BC_COMPRESSION_QUALITY_HIGH
+};
+
+
+/// Compresses 4x4 RGBA block to BC7.
+
+/// \param[in]  Src     - Pointer to the 4x4 RGBA8 source pixels (64 bytes, row-major).
+/// \param[out] Bits    - Pointer to the 16-byte compressed block.
+/// \param[in]  Quality - Compression quality, see Diligent::BC_COMPRESSION_QUALITY.
+///
+/// \remarks The fast preset only uses mode 6. The normal preset additionally tries mode 1
+///          (opaque blocks) or mode 7 for a few best two-subset partitions. The high preset
+///          also tries modes 4 and 5 with all channel rotations and, for opaque blocks, mode 3
+///          and the three-subset modes 0 and 2.
+void CompressBC7Block(const Uint8*           Src,
+                      Uint8*                 Bits,
+                      BC_COMPRESSION_QUALITY Quality DEFAULT_VALUE(BC_COMPRESSION_QUALITY_NORMAL));
+
+
+/// Compresses 4x4 RGB float block to BC6H_UF16.
+
+/// \param[in]  Src         - Pointer to the 4x4 float source pixels (row-major).
+/// \param[out] Bits        - Pointer to the 16-byte compressed block.
+/// \param[in]  SrcChannels - The number of components in the source buffer.
+///                           Must be at least 3. Alpha channel is ignored.
+/// \param[in]  Quality     - Compression quality, see Diligent::BC_COMPRESSION_QUALITY.
+///
+/// \remarks Negative values are clamped to zero.
+///          The fast preset only uses mode 11 (one region, 10-bit endpoints). The normal preset
+///          additionally tries mode 12 (one region, 11-bit base and 9-bit delta) and mode 10
+///          (two regions, 6-bit endpoints) for a few best partitions. The high preset tries all
+///          one-region modes (11-14) and all two-region modes (1-10).
+void CompressBC6HBlock(const float*           Src,
+                       Uint8*                 Bits,
+                       Uint32                 SrcChannels DEFAULT_VALUE(4),
+                       BC_COMPRESSION_QUALITY Quality     DEFAULT_VALUE(BC_COMPRESSION_QUALITY_NORMAL));
+
+
+/// Compresses 4x4 RGB half-precision float block to BC6H_UF16.
+
+/// This function is similar to CompressBC6HBlock, but takes
+/// the source pixels as 16-bit floating-point values.
+void CompressBC6HBlockHalf(const Uint16*          Src,
+                           Uint8*                 Bits,
+                           Uint32                 SrcChannels DEFAULT_VALUE(4),
+                           BC_COMPRESSION_QUALITY Quality     DEFAULT_VALUE(BC_COMPRESSION_QUALITY_NORMAL));
+
 // clang-format on
 
+#include "../../../DiligentCore/Primitives/interface/UndefRefMacro.h"
+
 DILIGENT_END_NAMESPACE // namespace Diligent
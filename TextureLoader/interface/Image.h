@@ -113,6 +113,15 @@ struct ImageDesc
 };
 typedef struct ImageDesc ImageDesc;
 
+/// Image row handler called by the row decoding functions (e.g. DecodePngRows).
+
+/// \param [in] pUserData - User data pointer passed to the decoding function.
+/// \param [in] Row       - Index of the decoded row. Rows are decoded from top to bottom.
+/// \param [in] pRowData  - Decoded row data. The components are tightly packed.
+///                         The pointer is only valid for the duration of the call.
+/// \return     true to continue decoding, and false to abort it.
+typedef bool (*ImageRowHandlerType)(void* pUserData, Uint32 Row, const void* pRowData);
+
 
 
 #if DILIGENT_CPP_INTERFACE
@@ -150,9 +159,16 @@ struct Image : public ObjectBase<IObject>
         IMAGE_FILE_FORMAT        FileFormat  = IMAGE_FILE_FORMAT_JPEG;
         int                      JpegQuality = 95;
         struct IMemoryAllocator* pAllocator  = nullptr;
+
+        /// PNG compression level from 0 to 9, or -1 to use the default level.
+        int PngCompressionLevel = -1;
     };
     static void Encode(const EncodeInfo& Info, IDataBlob** ppEncodedData);
 
+    /// Encodes the image and writes it to the file stream.
+    /// Returns false if encoding or writing failed.
+    static bool Encode(const EncodeInfo& Info, IFileStream* pDstStream);
+
     /// Returns image description
     const ImageDesc& GetDesc() const { return m_Desc; }
 
@@ -176,6 +192,25 @@ struct Image : public ObjectBase<IObject>
 
     static ImageDesc GetDesc(IMAGE_FILE_FORMAT FileFormat, const void* pSrcData, size_t SrcDataSize);
 
+    /// Returns true if images of the given format can be decoded row by row, see DecodeRows().
+    static bool IsRowDecodingSupported(IMAGE_FILE_FORMAT Format);
+
+    /// Decodes the image row by row without allocating the buffer for the entire image.
+
+    /// \param [in]  FileFormat  - Image file format. Must be PNG, JPEG or TIFF.
+    /// \param [in]  pSrcData    - Encoded image data.
+    /// \param [in]  SrcDataSize - Size of the encoded image data, in bytes.
+    /// \param [in]  RowHandler  - Handler that is called for every decoded row.
+    /// \param [in]  pUserData   - User data pointer that is passed to the row handler.
+    /// \param [out] Desc        - Image description. RowStride is the size of one decoded row.
+    /// \return      true if the image has been decoded successfully, and false otherwise.
+    static bool DecodeRows(IMAGE_FILE_FORMAT   FileFormat,
+                           const void*         pSrcData,
+                           size_t              SrcDataSize,
+                           ImageRowHandlerType RowHandler,
+                           void*               pUserData,
+                           ImageDesc&          Desc);
+
     /// Returns true if the image is uniform, i.e. all pixels have the same value
     bool IsUniform() const;
 
@@ -195,7 +230,7 @@ private:
     static bool Load(IMAGE_FILE_FORMAT FileFormat, const void* pSrcData, size_t SrcDataSize, IDataBlob* pDstPixels, ImageDesc& Desc);
 
 
-    static void LoadTiffFile(const void* pData, size_t Size, IDataBlob* pDstPixels, ImageDesc& Desc);
+    static void LoadTiffFile(const void* pData, size_t Size, IDataBlob* pDstPixels, ImageDesc& Desc, ImageRowHandlerType RowHandler = nullptr, void* pUserData = nullptr);
 
     ImageDesc                m_Desc;
     RefCntAutoPtr<IDataBlob> m_pData;
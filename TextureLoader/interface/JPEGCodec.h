@@ -49,7 +49,10 @@ DILIGENT_TYPED_ENUM(DECODE_JPEG_RESULT, Uint32)
     DECODE_JPEG_RESULT_INITIALIZATION_FAILED,
 
     /// An unexpected error occurred while decoding the file.
-    DECODE_JPEG_RESULT_DECODING_ERROR
+    DECODE_JPEG_RESULT_DECODING_ERROR,
+
+    /// Decoding was aborted by the row handler.
+    DECODE_JPEG_RESULT_ABORTED
 };
 
 /// JPEG image encoding result.
@@ -82,6 +85,20 @@ DECODE_JPEG_RESULT DILIGENT_GLOBAL_FUNCTION(DecodeJpeg)(const void* pSrcJpegBits
                                                         IDataBlob*  pDstPixels,
                                                         ImageDesc*  pDstImgDesc);
 
+/// Decodes jpeg image row by row without allocating the buffer for the entire image.
+
+/// \param [in]  pSrcJpegBits - JPEG image encoded bits.
+/// \param [in]  JpegDataSize - Size of the encoded JPEG image data.
+/// \param [in]  RowHandler   - Handler that is called for every decoded row, see Diligent::ImageRowHandlerType.
+/// \param [in]  pUserData    - User data pointer that is passed to the row handler.
+/// \param [out] pDstImgDesc  - Decoded image description. The description is written before the
+///                             first row is decoded. RowStride is the size of one decoded row.
+/// \return                     Decoding result, see Diligent::DECODE_JPEG_RESULT.
+DECODE_JPEG_RESULT DILIGENT_GLOBAL_FUNCTION(DecodeJpegRows)(const void*         pSrcJpegBits,
+                                                            size_t              JpegDataSize,
+                                                            ImageRowHandlerType RowHandler,
+                                                            void*               pUserData,
+                                                            ImageDesc*          pDstImgDesc);
 
 /// Encodes an image jpeg PNG format.
 
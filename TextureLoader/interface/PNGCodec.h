@@ -55,7 +55,10 @@ DILIGENT_TYPED_ENUM(DECODE_PNG_RESULT, Uint32)
     DECODE_PNG_RESULT_INVALID_BIT_DEPTH,
 
     /// An unexpected error occurred while decoding the file.
-    DECODE_PNG_RESULT_DECODING_ERROR
+    DECODE_PNG_RESULT_DECODING_ERROR,
+
+    /// Decoding was aborted by the row handler.
+    DECODE_PNG_RESULT_ABORTED
 };
 
 /// PNG encoding result
@@ -68,7 +71,10 @@ DILIGENT_TYPED_ENUM(ENCODE_PNG_RESULT, Uint32)
     ENCODE_PNG_RESULT_INVALID_ARGUMENTS,
 
     /// Failed to initialize the encoder.
-    ENCODE_PNG_RESULT_INITIALIZATION_FAILED
+    ENCODE_PNG_RESULT_INITIALIZATION_FAILED,
+
+    /// Failed to write the encoded data to the stream.
+    ENCODE_PNG_RESULT_WRITE_FAILED
 };
 // clang-format on
 
@@ -88,6 +94,24 @@ DECODE_PNG_RESULT DILIGENT_GLOBAL_FUNCTION(DecodePng)(const void* pSrcPngBits,
                                                       IDataBlob*  pDstPixels,
                                                       ImageDesc*  pDstImgDesc);
 
+/// Decodes png image row by row without allocating the buffer for the entire image.
+
+/// \param [in]  pSrcPngBits - PNG image encoded bits.
+/// \param [in]  PngDataSize - Size of the PNG image data, in bytes.
+/// \param [in]  RowHandler  - Handler that is called for every decoded row, see Diligent::ImageRowHandlerType.
+/// \param [in]  pUserData   - User data pointer that is passed to the row handler.
+/// \param [out] pDstImgDesc - Decoded image description. The description is written before the
+///                            first row is decoded. RowStride is the size of one decoded row.
+/// \return                    Decoding result, see Diligent::DECODE_PNG_RESULT.
+///
+/// \remarks    Interlaced images are decoded in several passes that update all rows,
+///             so for such images the function has to decode the entire image first.
+DECODE_PNG_RESULT DILIGENT_GLOBAL_FUNCTION(DecodePngRows)(const void*         pSrcPngBits,
+                                                          size_t              PngDataSize,
+                                                          ImageRowHandlerType RowHandler,
+                                                          void*               pUserData,
+                                                          ImageDesc*          pDstImgDesc);
+
 /// Encodes an image into PNG format.
 
 /// \param [in] pSrcPixels    - Source pixels. The pixels must be tightly packed
@@ -108,4 +132,24 @@ ENCODE_PNG_RESULT DILIGENT_GLOBAL_FUNCTION(EncodePng)(const Uint8* pSrcPixels,
                                                       int          PngColorType,
                                                       IDataBlob*   pDstPngBits);
 
+/// Encodes an image into PNG format and writes it to a file stream.
+
+/// \param [in] pSrcPixels       - Source pixels, see Diligent::EncodePng.
+/// \param [in] Width            - Image width.
+/// \param [in] Height           - Image height.
+/// \param [in] StrideInBytes    - Image data stride, in bytes.
+/// \param [in] PngColorType     - PNG color type (`PNG_COLOR_TYPE_RGB`, `PNG_COLOR_TYPE_RGBA`, etc.).
+/// \param [in] CompressionLevel - zlib compression level from 0 (no compression) to 9 (best compression),
+///                                or -1 to use the default level. Level 1 is considerably faster than
+///                                the default one and is a good choice for real-time capture.
+/// \param [in] pDstStream       - Stream to write the encoded image to.
+/// \return                        Encoding result, see Diligent::ENCODE_PNG_RESULT.
+ENCODE_PNG_RESULT DILIGENT_GLOBAL_FUNCTION(EncodePngToStream)(const Uint8* pSrcPixels,
+                                                              Uint32       Width,
+                                                              Uint32       Height,
+                                                              Uint32       StrideInBytes,
+                                                              int          PngColorType,
+                                                              int          CompressionLevel,
+                                                              IFileStream* pDstStream);
+
 DILIGENT_END_NAMESPACE // namespace Diligent
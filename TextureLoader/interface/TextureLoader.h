@@ -43,6 +43,7 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 
 struct Image;
 struct IMemoryAllocator;
+struct IThreadPool;
 
 // clang-format off
 
@@ -76,6 +77,11 @@ DILIGENT_TYPED_ENUM(TEXTURE_LOAD_COMPRESS_MODE, Uint8)
     ///   * `RG8   -> BC5_UNORM`
     ///   * `RGB8  -> BC1_UNORM / BC1_UNORM_SRGB`
     ///   * `RGBA8 -> BC3_UNORM / BC3_UNORM_SRGB`
+    ///
+    /// 16-bit UNORM images are converted to 8 bits and compressed the same way.
+    /// Floating-point images are not compressed in this mode; use one of the
+    /// BC7 modes to compress RGB float images to BC6H.
+    /// Images that can't be compressed are loaded uncompressed, and a warning is logged.
     TEXTURE_LOAD_COMPRESS_MODE_BC,
 
     /// Compress the texture using high-quality BC compression.
@@ -84,6 +90,35 @@ DILIGENT_TYPED_ENUM(TEXTURE_LOAD_COMPRESS_MODE, Uint8)
     /// quality settings that result in better image quality at the cost of
     /// 30%-40% longer compression time.
     TEXTURE_LOAD_COMPRESS_MODE_BC_HIGH_QUAL,
+
+    /// Compress the texture using BC7 compression with fast quality settings.
+    ///
+    /// The BC texture format is selected based on the number of channels in the
+    /// source image:
+    ///   * `R8    -> BC4_UNORM`
+    ///   * `RG8   -> BC5_UNORM`
+    ///   * `RGB8  -> BC7_UNORM / BC7_UNORM_SRGB`
+    ///   * `RGBA8 -> BC7_UNORM / BC7_UNORM_SRGB`
+    ///   * `RGB16F/RGB32F -> BC6H_UF16`
+    ///
+    /// 16-bit UNORM images are converted to 8 bits and compressed the same way.
+    /// Floating-point images with alpha channel are not compressed.
+    ///
+    /// \remarks   BC7 and BC6H compression is considerably slower than BC1/BC3.
+    ///            Use TextureLoadInfo::pThreadPool to compress the texture
+    ///            using multiple threads.
+    TEXTURE_LOAD_COMPRESS_MODE_BC7_FAST,
+
+    /// Compress the texture using BC7 compression with normal quality settings.
+    ///
+    /// The texture format is selected the same way as for TEXTURE_LOAD_COMPRESS_MODE_BC7_FAST.
+    TEXTURE_LOAD_COMPRESS_MODE_BC7,
+
+    /// Compress the texture using BC7 compression with high quality settings.
+    ///
+    /// The texture format is selected the same way as for TEXTURE_LOAD_COMPRESS_MODE_BC7_FAST.
+    /// This mode is typically 3-5 times slower than TEXTURE_LOAD_COMPRESS_MODE_BC7.
+    TEXTURE_LOAD_COMPRESS_MODE_BC7_HIGH_QUAL,
 };
 
 /// Texture loading information
@@ -101,6 +136,18 @@ struct TextureLoadInfo
     /// Number of mip levels
     Uint32 MipLevels                    DEFAULT_INITIALIZER(0);
 
+    /// Index of the first mip level of the source texture to load.
+
+    /// Together with MipLevels, this member defines the range of source mip levels
+    /// [FirstMipLevel, FirstMipLevel + MipLevels) that the loader reads. The loaded texture
+    /// has the dimensions of the source mip level FirstMipLevel, so that the coarse mip levels
+    /// can be loaded first and the finer levels can be streamed in later.
+    ///
+    /// \note  This member is only supported for DDS, KTX and KTX2 files and is ignored for other formats.
+    ///        Use CreateTextureLoaderFromStream or CreateTextureLoaderFromFile to only read the
+    ///        requested mip levels of a DDS file.
+    Uint32 FirstMipLevel                DEFAULT_INITIALIZER(0);
+
     /// CPU access flags
     CPU_ACCESS_FLAGS CPUAccessFlags     DEFAULT_INITIALIZER(CPU_ACCESS_NONE);
 
@@ -134,6 +181,17 @@ struct TextureLoadInfo
     /// Texture compression mode, see Diligent::TEXTURE_LOAD_COMPRESS_MODE.
     TEXTURE_LOAD_COMPRESS_MODE CompressMode DEFAULT_INITIALIZER(TEXTURE_LOAD_COMPRESS_MODE_NONE);
 
+    /// Flag indicating that BC-compressed texture data should be decompressed
+    /// on the CPU if the device does not support the texture format.
+
+    /// When this flag is set, ITextureLoader::CreateTexture checks if the device
+    /// supports the BC format of the loaded texture (e.g. a DDS or KTX file).
+    /// If it does not, all subresources are decompressed and the texture is created
+    /// in the format returned by Diligent::GetBCDecompressedFormat (e.g. RGBA8_UNORM for BC7).
+    /// The loaded data and the description returned by ITextureLoader::GetTextureDesc
+    /// are not modified.
+    Bool DecompressUnsupportedBC DEFAULT_INITIALIZER(False);
+
     /// Texture component swizzle.
     
     /// When the number of channels in the source image is less than
@@ -149,11 +207,22 @@ struct TextureLoadInfo
     /// When this parameter is non-zero, the loader will check if all pixels
     /// in the image have the same value. If this is the case, the image will
     /// be clipped to the specified dimension.
+    ///
+    /// \note  PNG, JPEG and TIFF images are normally decoded row by row directly into
+    ///        the texture data. Checking if the image is uniform requires the entire
+    ///        decoded image, so a non-zero value disables row decoding.
     Uint32 UniformImageClipDim DEFAULT_INITIALIZER(0);
 
     /// An optional memory allocator to allocate memory for the texture.
     struct IMemoryAllocator* pAllocator DEFAULT_INITIALIZER(nullptr);
 
+    /// An optional thread pool to compress or decompress the texture blocks in parallel.
+
+    /// When this parameter is not null, the loader splits the block rows of large
+    /// mip levels between the worker threads and waits for them to complete.
+    /// The loader keeps a reference to the thread pool when DecompressUnsupportedBC is true.
+    struct IThreadPool* pThreadPool DEFAULT_INITIALIZER(nullptr);
+
 #if DILIGENT_CPP_INTERFACE
     explicit TextureLoadInfo(const Char*         _Name,
                              USAGE               _Usage             = TextureLoadInfo{}.Usage,
@@ -251,6 +320,20 @@ void DILIGENT_GLOBAL_FUNCTION(CreateTextureLoaderFromFile)(const char*
                                                            const TextureLoadInfo REF TexLoadInfo,
                                                            ITextureLoader**          ppLoader);
 
+/// Creates a texture loader from a file stream.
+
+/// \param [in]  pFileStream - File stream to read the texture from.
+/// \param [in]  TexLoadInfo - Texture loading information, see Diligent::TextureLoadInfo.
+/// \param [out] ppLoader    - Memory location where a pointer to the created texture loader will be written.
+///
+/// \remarks    For DDS files, the loader reads the header and then only the surfaces of the
+///             mip levels selected by TextureLoadInfo::FirstMipLevel and TextureLoadInfo::MipLevels,
+///             seeking over the rest of the file. For other formats, the entire stream is read.
+///             The loader does not keep a reference to the stream.
+void DILIGENT_GLOBAL_FUNCTION(CreateTextureLoaderFromStream)(IFileStream*              pFileStream,
+                                                             const TextureLoadInfo REF TexLoadInfo,
+                                                             ITextureLoader**          ppLoader);
+
 /// Creates a texture loader from memory.
 
 /// \param [in]  pData       - Pointer to the texture data.
@@ -297,11 +380,33 @@ void CreateTextureLoaderFromDataBlob(RefCntAutoPtr<IDataBlob> pDataBlob,
 /// intermediate data structures used by the loader. It does not include the size of
 /// the source image data.
 /// The actual memory used by the loader may be slightly different.
+/// Use GetTextureLoaderMipLevelSizes to get the data sizes of individual mip levels.
 size_t DILIGENT_GLOBAL_FUNCTION(GetTextureLoaderMemoryRequirement)(const void*               pData,
                                                                    size_t                    Size,
                                                                    const TextureLoadInfo REF TexLoadInfo);
 
 
+/// Returns the data sizes of the mip levels of the texture that the loader creates.
+///
+/// \param [in]  pData          - Pointer to the source image data.
+/// \param [in]  Size           - The data size.
+/// \param [in]  TexLoadInfo    - Texture loading information, see Diligent::TextureLoadInfo.
+/// \param [out] pMipLevelSizes - Array that receives the data size of every mip level, in bytes,
+///                               including all array slices. This parameter may be null.
+/// \param [in]  MaxMipLevels   - The number of elements in the pMipLevelSizes array.
+/// \return     The number of mip levels in the texture, or 0 if the data could not be parsed.
+///
+/// Mip level 0 corresponds to the source mip level TextureLoadInfo::FirstMipLevel.
+/// For KTX and KTX2 files, the function only reads the file headers and does not
+/// decompress the data. Together with TextureLoadInfo::FirstMipLevel, the sizes
+/// can be used to budget the memory when streaming mip levels.
+Uint32 DILIGENT_GLOBAL_FUNCTION(GetTextureLoaderMipLevelSizes)(const void*               pData,
+                                                               size_t                    Size,
+                                                               const TextureLoadInfo REF TexLoadInfo,
+                                                               Uint64*                   pMipLevelSizes,
+                                                               Uint32                    MaxMipLevels);
+
+
 /// Writes texture data as DDS file.
 
 /// \param [in]  FilePath - DDS file path.
@@ -0,0 +1,458 @@
+/*
+ *  Copyright 2019-2025 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "BCTools.h"
+
+#include <cstring>
+
+#include "DebugUtilities.hpp"
+#include "Intrinsics.hpp"
+#include "BCCommon.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Reads bits from a 128-bit block, least significant bit first
+class BlockBitReader
+{
+public:
+    explicit BlockBitReader(const Uint8* pBits)
+    {
+        for (Uint32 i = 0; i < 8; ++i)
+        {
+            m_Lo |= Uint64{pBits[i]} << (i * 8u);
+            m_Hi |= Uint64{pBits[i + 8]} << (i * 8u);
+        }
+    }
+
+    Uint32 Read(Uint32 NumBits)
+    {
+        VERIFY_EXPR(NumBits <= 32 && m_Pos + NumBits <= 128);
+        if (NumBits == 0)
+            return 0;
+
+        Uint64 Value = 0;
+        if (m_Pos == 0)
+            Value = m_Lo;
+        else if (m_Pos < 64)
+            Value = (m_Lo >> m_Pos) | (m_Hi << (64u - m_Pos));
+        else
+            Value = m_Hi >> (m_Pos - 64u);
+        m_Pos += NumBits;
+
+        return static_cast<Uint32>(Value & ((Uint64{1} << NumBits) - 1u));
+    }
+
+    void Skip(Uint32 NumBits)
+    {
+        m_Pos += NumBits;
+    }
+
+    Uint32 GetPosition() const { return m_Pos; }
+
+private:
+    Uint64 m_Lo  = 0;
+    Uint64 m_Hi  = 0;
+    Uint32 m_Pos = 0;
+};
+
+inline Uint32 InterpolateBC(Uint32 E0, Uint32 E1, Uint32 Weight)
+{
+    return ((64u - Weight) * E0 + Weight * E1 + 32u) >> 6u;
+}
+
+inline int InterpolateBC(int E0, int E1, Uint32 Weight)
+{
+    return ((64 - static_cast<int>(Weight)) * E0 + static_cast<int>(Weight) * E1 + 32) >> 6;
+}
+
+// Reads the indices of all pixels. The most significant bit of every anchor index is implicitly zero.
+void ReadIndices(BlockBitReader& Reader, Uint32 IndexBits, Uint32 NumSubsets, Uint32 Partition, Uint8* Indices)
+{
+    for (Uint32 i = 0; i < 16; ++i)
+        Indices[i] = static_cast<Uint8>(Reader.Read(IsBCAnchorPixel(NumSubsets, Partition, i) ? IndexBits - 1 : IndexBits));
+}
+
+
+// BC7
+
+void DecompressBC7(const Uint8* Bits, Uint8* Dst)
+{
+    Uint32 Mode = 0;
+    while (Mode < 8 && (Bits[0] & (1u << Mode)) == 0)
+        ++Mode;
+    if (Mode == 8)
+    {
+        // Reserved mode
+        std::memset(Dst, 0, 64);
+        return;
+    }
+
+    const BC7ModeDesc& Desc = BC7Modes[Mode];
+
+    BlockBitReader Reader{Bits};
+    Reader.Skip(Mode + 1);
+
+    const Uint32 Partition      = Reader.Read(Desc.PartitionBits);
+    const Uint32 Rotation       = Reader.Read(Desc.RotationBits);
+    const Uint32 IndexSelection = Reader.Read(Desc.IndexSelectionBits);
+
+    // [subset][endpoint][channel]
+    Uint32 Endpoints[3][2][4] = {};
+    for (Uint32 c = 0; c < 4; ++c)
+    {
+        const Uint32 ChannelBits = c < 3 ? Desc.ColorBits : Desc.AlphaBits;
+        for (Uint32 s = 0; s < Desc.NumSubsets; ++s)
+        {
+            for (Uint32 e = 0; e < 2; ++e)
+                Endpoints[s][e][c] = Reader.Read(ChannelBits);
+        }
+    }
+
+    Uint32 PBits[3][2] = {};
+    for (Uint32 s = 0; s < Desc.NumSubsets; ++s)
+    {
+        if (Desc.EndpointPBits)
+        {
+            PBits[s][0] = Reader.Read(1);
+            PBits[s][1] = Reader.Read(1);
+        }
+        else if (Desc.SharedPBits)
+        {
+            PBits[s][0] = PBits[s][1] = Reader.Read(1);
+        }
+    }
+
+    const bool HasPBits = Desc.EndpointPBits != 0 || Desc.SharedPBits != 0;
+    for (Uint32 s = 0; s < Desc.NumSubsets; ++s)
+    {
+        for (Uint32 e = 0; e < 2; ++e)
+        {
+            for (Uint32 c = 0; c < 4; ++c)
+            {
+                const Uint32 ChannelBits = c < 3 ? Desc.ColorBits : Desc.AlphaBits;
+                Endpoints[s][e][c]       = ChannelBits > 0 ?
+                    UnquantizeBC7(Endpoints[s][e][c], ChannelBits, PBits[s][e], HasPBits) :
+                    255u;
+            }
+        }
+    }
+
+    Uint8 Indices[16];
+    ReadIndices(Reader, Desc.IndexBits, Desc.NumSubsets, Partition, Indices);
+
+    Uint8 Indices2[16] = {};
+    if (Desc.Index2Bits > 0)
+        ReadIndices(Reader, Desc.Index2Bits, 1, 0, Indices2);
+    VERIFY_EXPR(Reader.GetPosition() == 128);
+
+    // Modes 4 and 5 use separate index sets for color and alpha.
+    // In mode 4, the index selection bit swaps them.
+    const Uint8* ColorIndices = Indices;
+    const Uint8* AlphaIndices = Desc.Index2Bits > 0 ? Indices2 : Indices;
+    Uint32       ColorBits    = Desc.IndexBits;
+    Uint32       AlphaBits    = Desc.Index2Bits > 0 ? Desc.Index2Bits : Desc.IndexBits;
+    if (IndexSelection != 0)
+    {
+        std::swap(ColorIndices, AlphaIndices);
+        std::swap(ColorBits, AlphaBits);
+    }
+    const Uint32* ColorWeights = GetInterpolationWeights(ColorBits);
+    const Uint32* AlphaWeights = GetInterpolationWeights(AlphaBits);
+
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        const Uint32 s = GetBCPixelSubset(Desc.NumSubsets, Partition, i);
+
+        Uint8* Pixel = Dst + i * 4;
+        for (Uint32 c = 0; c < 3; ++c)
+            Pixel[c] = static_cast<Uint8>(InterpolateBC(Endpoints[s][0][c], Endpoints[s][1][c], ColorWeights[ColorIndices[i]]));
+        Pixel[3] = static_cast<Uint8>(InterpolateBC(Endpoints[s][0][3], Endpoints[s][1][3], AlphaWeights[AlphaIndices[i]]));
+
+        // Rotation swaps alpha with one of the color channels
+        if (Rotation != 0)
+            std::swap(Pixel[3], Pixel[Rotation - 1]);
+    }
+}
+
+
+// BC6H
+
+const BC6HModeDesc* FindBC6HMode(BlockBitReader& Reader)
+{
+    Uint32 ModeBits = Reader.Read(2);
+    if (ModeBits >= 2)
+        ModeBits |= Reader.Read(3) << 2u;
+
+    for (const BC6HModeDesc& Desc : BC6HModes)
+    {
+        if (Desc.ModeBits == ModeBits && (Desc.NumModeBits == 2) == (ModeBits < 2))
+            return &Desc;
+    }
+
+    // Reserved mode
+    return nullptr;
+}
+
+inline int SignExtend(Uint32 Value, Uint32 Bits)
+{
+    const Uint32 SignBit = 1u << (Bits - 1u);
+    return static_cast<int>((Value & (SignBit | (SignBit - 1u))) ^ SignBit) - static_cast<int>(SignBit);
+}
+
+inline int UnquantizeBC6H(int Value, Uint32 Bits, bool IsSigned)
+{
+    if (!IsSigned)
+    {
+        if (Bits >= 15 || Value == 0)
+            return Value;
+        if (Value == (1 << Bits) - 1)
+            return 0xFFFF;
+        return ((Value << 16) + 0x8000) >> Bits;
+    }
+    else
+    {
+        if (Bits >= 16 || Value == 0)
+            return Value;
+
+        const bool IsNegative = Value < 0;
+        const int  Magnitude  = IsNegative ? -Value : Value;
+        const int  Result     = Magnitude >= (1 << (Bits - 1)) - 1 ?
+            0x7FFF :
+            ((Magnitude << 15) + 0x4000) >> (Bits - 1);
+        return IsNegative ? -Result : Result;
+    }
+}
+
+// Scales the interpolated value to the half-precision float bit pattern
+inline Uint16 FinishUnquantizeBC6H(int Value, bool IsSigned)
+{
+    if (!IsSigned)
+        return static_cast<Uint16>((Value * 31) >> 6);
+
+    return Value < 0 ?
+        static_cast<Uint16>(0x8000 | (((-Value) * 31) >> 5)) :
+        static_cast<Uint16>((Value * 31) >> 5);
+}
+
+void DecompressBC6H(const Uint8* Bits, Uint16* Dst, Uint32 DstChannels, bool IsSigned)
+{
+    VERIFY_EXPR(DstChannels == 3 || DstChannels == 4);
+
+    constexpr Uint16 HalfOne = 0x3C00;
+
+    BlockBitReader      Reader{Bits};
+    const BC6HModeDesc* pDesc = FindBC6HMode(Reader);
+    if (pDesc == nullptr)
+    {
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            for (Uint32 c = 0; c < DstChannels; ++c)
+                Dst[i * DstChannels + c] = c < 3 ? 0 : HalfOne;
+        }
+        return;
+    }
+    const BC6HModeDesc& Desc = *pDesc;
+
+    Uint32 Fields[BC6H_FIELD_COUNT] = {};
+    for (Uint32 f = 0; f < Desc.LayoutSize; ++f)
+    {
+        const BC6HFieldBits& Item = Desc.Layout[f];
+        if (Item.Last >= Item.First)
+        {
+            Fields[Item.Field] |= Reader.Read(Item.Last - Item.First + 1u) << Item.First;
+        }
+        else
+        {
+            for (Uint32 b = Item.First + 1u; b-- > Item.Last;)
+                Fields[Item.Field] |= Reader.Read(1) << b;
+        }
+    }
+
+    const Uint32 Partition    = Fields[D];
+    const Uint32 NumEndpoints = Desc.NumRegions * 2u;
+    const Uint32 EndpointMask = (1u << Desc.EndpointBits) - 1u;
+
+    // [endpoint][channel], endpoints are in W, X, Y, Z order
+    int Endpoints[4][3] = {};
+    for (Uint32 c = 0; c < 3; ++c)
+    {
+        const Uint32 W = Fields[c * 4];
+        for (Uint32 e = 0; e < NumEndpoints; ++e)
+        {
+            Uint32 Value = Fields[c * 4 + e];
+            if (Desc.Transformed && e > 0)
+            {
+                // Endpoints are stored as signed deltas from W
+                Value = (W + static_cast<Uint32>(SignExtend(Value, Desc.DeltaBits[c]))) & EndpointMask;
+            }
+
+            const int Endpoint = IsSigned ? SignExtend(Value, Desc.EndpointBits) : static_cast<int>(Value);
+            Endpoints[e][c]    = UnquantizeBC6H(Endpoint, Desc.EndpointBits, IsSigned);
+        }
+    }
+
+    const Uint32 IndexBits = Desc.NumRegions == 2 ? 3 : 4;
+
+    Uint8 Indices[16];
+    ReadIndices(Reader, IndexBits, Desc.NumRegions, Partition, Indices);
+    VERIFY_EXPR(Reader.GetPosition() == 128);
+
+    const Uint32* Weights = GetInterpolationWeights(IndexBits);
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        const Uint32 Region = GetBCPixelSubset(Desc.NumRegions, Partition, i);
+        const int*   E0     = Endpoints[Region * 2];
+        const int*   E1     = Endpoints[Region * 2 + 1];
+        for (Uint32 c = 0; c < 3; ++c)
+            Dst[i * DstChannels + c] = FinishUnquantizeBC6H(InterpolateBC(E0[c], E1[c], Weights[Indices[i]]), IsSigned);
+        if (DstChannels == 4)
+            Dst[i * DstChannels + 3] = HalfOne;
+    }
+}
+
+float HalfToFloat(Uint32 Half)
+{
+    const Uint32 Sign     = (Half & 0x8000u) << 16u;
+    Uint32       Exponent = (Half >> 10u) & 0x1Fu;
+    Uint32       Mantissa = Half & 0x3FFu;
+
+    Uint32 Bits = Sign;
+    if (Exponent == 0x1Fu)
+    {
+        // Infinity or NaN
+        Bits |= 0x7F800000u | (Mantissa << 13u);
+    }
+    else if (Exponent != 0)
+    {
+        Bits |= ((Exponent + 112u) << 23u) | (Mantissa << 13u);
+    }
+    else if (Mantissa != 0)
+    {
+        // Normalize the denormalized half
+        Exponent = 113;
+        while ((Mantissa & 0x400u) == 0)
+        {
+            Mantissa <<= 1u;
+            --Exponent;
+        }
+        Bits |= (Exponent << 23u) | ((Mantissa & 0x3FFu) << 13u);
+    }
+
+    float Value;
+    std::memcpy(&Value, &Bits, sizeof(Value));
+    return Value;
+}
+
+// Converts an array of half-precision values to single precision. Four values at a time are converted
+// with integer arithmetic: the half exponent and mantissa are shifted into place and rebiased, infinities
+// and NaNs get the maximum exponent, and denormals are normalized by a floating-point subtraction.
+void HalfToFloat(const Uint16* Src, float* Dst, Uint32 Count)
+{
+    Uint32 i = 0;
+#if DILIGENT_SSE2_SUPPORTED
+    const __m128i ShiftedExp = _mm_set1_epi32(0x7C00 << 13);
+    const __m128i ExpAdjust  = _mm_set1_epi32((127 - 15) << 23);
+    const __m128i DenormBias = _mm_set1_epi32(1 << 23);
+    const __m128  Magic      = _mm_castsi128_ps(_mm_set1_epi32(113 << 23));
+    for (; i + 4 <= Count; i += 4)
+    {
+        const __m128i Half = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(Src + i)), _mm_setzero_si128());
+        const __m128i Sign = _mm_slli_epi32(_mm_and_si128(Half, _mm_set1_epi32(0x8000)), 16);
+
+        __m128i       Bits = _mm_slli_epi32(_mm_and_si128(Half, _mm_set1_epi32(0x7FFF)), 13);
+        const __m128i Exp  = _mm_and_si128(Bits, ShiftedExp);
+        Bits               = _mm_add_epi32(Bits, ExpAdjust);
+
+        // Infinity or NaN
+        const __m128i IsInfNaN = _mm_cmpeq_epi32(Exp, ShiftedExp);
+        Bits                   = _mm_add_epi32(Bits, _mm_and_si128(IsInfNaN, ExpAdjust));
+
+        // Zero or denormal
+        const __m128i IsDenorm   = _mm_cmpeq_epi32(Exp, _mm_setzero_si128());
+        const __m128i Normalized = _mm_castps_si128(_mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(Bits, DenormBias)), Magic));
+        Bits                     = _mm_or_si128(_mm_and_si128(IsDenorm, Normalized), _mm_andnot_si128(IsDenorm, Bits));
+
+        _mm_storeu_ps(Dst + i, _mm_castsi128_ps(_mm_or_si128(Bits, Sign)));
+    }
+#elif DILIGENT_NEON_SUPPORTED
+    const uint32x4_t  ShiftedExp = vdupq_n_u32(0x7C00 << 13);
+    const uint32x4_t  ExpAdjust  = vdupq_n_u32((127 - 15) << 23);
+    const uint32x4_t  DenormBias = vdupq_n_u32(1 << 23);
+    const float32x4_t Magic      = vreinterpretq_f32_u32(vdupq_n_u32(113 << 23));
+    for (; i + 4 <= Count; i += 4)
+    {
+        const uint32x4_t Half = vmovl_u16(vld1_u16(Src + i));
+        const uint32x4_t Sign = vshlq_n_u32(vandq_u32(Half, vdupq_n_u32(0x8000)), 16);
+
+        uint32x4_t       Bits = vshlq_n_u32(vandq_u32(Half, vdupq_n_u32(0x7FFF)), 13);
+        const uint32x4_t Exp  = vandq_u32(Bits, ShiftedExp);
+        Bits                  = vaddq_u32(Bits, ExpAdjust);
+
+        // Infinity or NaN
+        Bits = vaddq_u32(Bits, vandq_u32(vceqq_u32(Exp, ShiftedExp), ExpAdjust));
+
+        // Zero or denormal
+        const uint32x4_t Normalized = vreinterpretq_u32_f32(vsubq_f32(vreinterpretq_f32_u32(vaddq_u32(Bits, DenormBias)), Magic));
+        Bits                        = vbslq_u32(vceqq_u32(Exp, vdupq_n_u32(0)), Normalized, Bits);
+
+        vst1q_f32(Dst + i, vreinterpretq_f32_u32(vorrq_u32(Bits, Sign)));
+    }
+#endif
+    for (; i < Count; ++i)
+        Dst[i] = HalfToFloat(Src[i]);
+}
+
+} // namespace
+
+void DecompressBC6HBlockHalf(const Uint8* Bits, Uint16* DstBuffer, Uint32 DstChannels, Bool IsSigned)
+{
+    VERIFY_EXPR(Bits != nullptr && DstBuffer != nullptr);
+    DEV_CHECK_ERR(DstChannels == 3 || DstChannels == 4, "The number of destination channels (", DstChannels, ") must be 3 or 4");
+    DecompressBC6H(Bits, DstBuffer, DstChannels, IsSigned);
+}
+
+void DecompressBC6HBlock(const Uint8* Bits, float* DstBuffer, Uint32 DstChannels, Bool IsSigned)
+{
+    VERIFY_EXPR(Bits != nullptr && DstBuffer != nullptr);
+    DEV_CHECK_ERR(DstChannels == 3 || DstChannels == 4, "The number of destination channels (", DstChannels, ") must be 3 or 4");
+
+    Uint16 Half[16 * 4];
+    DecompressBC6H(Bits, Half, DstChannels, IsSigned);
+    HalfToFloat(Half, DstBuffer, 16 * DstChannels);
+}
+
+void DecompressBC7Block(const Uint8* Bits, Uint8* DstBuffer)
+{
+    VERIFY_EXPR(Bits != nullptr && DstBuffer != nullptr);
+    DecompressBC7(Bits, DstBuffer);
+}
+
+} // namespace Diligent
@@ -0,0 +1,1212 @@
+/*
+ *  Copyright 2019-2025 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "BCTools.h"
+#include "BCCommon.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#include "DebugUtilities.hpp"
+#include "Intrinsics.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// 4x4 block pixels in SoA layout
+struct BlockPixels
+{
+    alignas(16) float Channels[4][16];
+};
+
+// Per-pixel subset mask: 1 if the pixel belongs to the subset, 0 otherwise
+struct SubsetMask
+{
+    alignas(16) float Weights[16];
+
+    SubsetMask(Uint32 NumSubsets, Uint32 Partition, Uint32 Subset)
+    {
+        for (Uint32 i = 0; i < 16; ++i)
+            Weights[i] = GetBCPixelSubset(NumSubsets, Partition, i) == Subset ? 1.f : 0.f;
+    }
+};
+
+// Palette of interpolated colors for one subset
+struct BlockPalette
+{
+    float  Colors[16][4];
+    Uint32 Size = 0;
+};
+
+// Selects the closest palette entry for every pixel that belongs to the subset
+// and returns the total squared error of the subset.
+float FindBestIndices(const BlockPixels&  Pixels,
+                      const SubsetMask&   Mask,
+                      const BlockPalette& Palette,
+                      Uint8*              Indices)
+{
+    float TotalError = 0;
+#if DILIGENT_SSE2_SUPPORTED
+    for (Uint32 i = 0; i < 16; i += 4)
+    {
+        const __m128 R = _mm_load_ps(&Pixels.Channels[0][i]);
+        const __m128 G = _mm_load_ps(&Pixels.Channels[1][i]);
+        const __m128 B = _mm_load_ps(&Pixels.Channels[2][i]);
+        const __m128 A = _mm_load_ps(&Pixels.Channels[3][i]);
+
+        __m128 BestError = _mm_set1_ps(FLT_MAX);
+        __m128 BestIndex = _mm_setzero_ps();
+        for (Uint32 e = 0; e < Palette.Size; ++e)
+        {
+            const float* Color = Palette.Colors[e];
+
+            const __m128 dR = _mm_sub_ps(R, _mm_set1_ps(Color[0]));
+            const __m128 dG = _mm_sub_ps(G, _mm_set1_ps(Color[1]));
+            const __m128 dB = _mm_sub_ps(B, _mm_set1_ps(Color[2]));
+            const __m128 dA = _mm_sub_ps(A, _mm_set1_ps(Color[3]));
+
+            const __m128 Error = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dR, dR), _mm_mul_ps(dG, dG)),
+                                            _mm_add_ps(_mm_mul_ps(dB, dB), _mm_mul_ps(dA, dA)));
+
+            const __m128 IsBetter = _mm_cmplt_ps(Error, BestError);
+            BestError             = _mm_min_ps(Error, BestError);
+            BestIndex             = _mm_or_ps(_mm_and_ps(IsBetter, _mm_set1_ps(static_cast<float>(e))), _mm_andnot_ps(IsBetter, BestIndex));
+        }
+
+        alignas(16) float Errors[4];
+        alignas(16) float BestIndices[4];
+        _mm_store_ps(Errors, _mm_mul_ps(BestError, _mm_load_ps(&Mask.Weights[i])));
+        _mm_store_ps(BestIndices, BestIndex);
+        for (Uint32 j = 0; j < 4; ++j)
+        {
+            if (Mask.Weights[i + j] != 0)
+                Indices[i + j] = static_cast<Uint8>(BestIndices[j]);
+            TotalError += Errors[j];
+        }
+    }
+#elif DILIGENT_NEON_SUPPORTED
+    for (Uint32 i = 0; i < 16; i += 4)
+    {
+        const float32x4_t R = vld1q_f32(&Pixels.Channels[0][i]);
+        const float32x4_t G = vld1q_f32(&Pixels.Channels[1][i]);
+        const float32x4_t B = vld1q_f32(&Pixels.Channels[2][i]);
+        const float32x4_t A = vld1q_f32(&Pixels.Channels[3][i]);
+
+        float32x4_t BestError = vdupq_n_f32(FLT_MAX);
+        uint32x4_t  BestIndex = vdupq_n_u32(0);
+        for (Uint32 e = 0; e < Palette.Size; ++e)
+        {
+            const float* Color = Palette.Colors[e];
+
+            const float32x4_t dR = vsubq_f32(R, vdupq_n_f32(Color[0]));
+            const float32x4_t dG = vsubq_f32(G, vdupq_n_f32(Color[1]));
+            const float32x4_t dB = vsubq_f32(B, vdupq_n_f32(Color[2]));
+            const float32x4_t dA = vsubq_f32(A, vdupq_n_f32(Color[3]));
+
+            float32x4_t Error = vmulq_f32(dR, dR);
+            Error             = vmlaq_f32(Error, dG, dG);
+            Error             = vmlaq_f32(Error, dB, dB);
+            Error             = vmlaq_f32(Error, dA, dA);
+
+            const uint32x4_t IsBetter = vcltq_f32(Error, BestError);
+            BestError                 = vminq_f32(Error, BestError);
+            BestIndex                 = vbslq_u32(IsBetter, vdupq_n_u32(e), BestIndex);
+        }
+
+        float  Errors[4];
+        Uint32 BestIndices[4];
+        vst1q_f32(Errors, vmulq_f32(BestError, vld1q_f32(&Mask.Weights[i])));
+        vst1q_u32(BestIndices, BestIndex);
+        for (Uint32 j = 0; j < 4; ++j)
+        {
+            if (Mask.Weights[i + j] != 0)
+                Indices[i + j] = static_cast<Uint8>(BestIndices[j]);
+            TotalError += Errors[j];
+        }
+    }
+#else
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        if (Mask.Weights[i] == 0)
+            continue;
+
+        float BestError = FLT_MAX;
+        Uint8 BestIndex = 0;
+        for (Uint32 e = 0; e < Palette.Size; ++e)
+        {
+            float Error = 0;
+            for (Uint32 c = 0; c < 4; ++c)
+            {
+                const float d = Pixels.Channels[c][i] - Palette.Colors[e][c];
+                Error += d * d;
+            }
+            if (Error < BestError)
+            {
+                BestError = Error;
+                BestIndex = static_cast<Uint8>(e);
+            }
+        }
+        Indices[i] = BestIndex;
+        TotalError += BestError;
+    }
+#endif
+    return TotalError;
+}
+
+// Line that best fits the pixels of a subset
+struct LineFit
+{
+    float Mean[4] = {};
+    float Axis[4] = {};
+
+    LineFit(const BlockPixels& Pixels, const SubsetMask& Mask)
+    {
+        float Count = 0;
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            Count += Mask.Weights[i];
+            for (Uint32 c = 0; c < 4; ++c)
+                Mean[c] += Pixels.Channels[c][i] * Mask.Weights[i];
+        }
+        if (Count == 0)
+            return;
+        for (Uint32 c = 0; c < 4; ++c)
+            Mean[c] /= Count;
+
+        float Cov[4][4]     = {};
+        float TotalVariance = 0;
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            if (Mask.Weights[i] == 0)
+                continue;
+
+            float d[4];
+            for (Uint32 c = 0; c < 4; ++c)
+                d[c] = Pixels.Channels[c][i] - Mean[c];
+            for (Uint32 r = 0; r < 4; ++r)
+            {
+                for (Uint32 c = r; c < 4; ++c)
+                    Cov[r][c] += d[r] * d[c];
+            }
+        }
+        for (Uint32 r = 0; r < 4; ++r)
+        {
+            TotalVariance += Cov[r][r];
+            for (Uint32 c = 0; c < r; ++c)
+                Cov[r][c] = Cov[c][r];
+        }
+        if (TotalVariance <= 0)
+            return;
+
+        // Start power iteration from the covariance matrix row with the largest variance
+        Uint32 MaxRow = 0;
+        for (Uint32 r = 1; r < 4; ++r)
+        {
+            if (Cov[r][r] > Cov[MaxRow][MaxRow])
+                MaxRow = r;
+        }
+        float v[4] = {Cov[MaxRow][0], Cov[MaxRow][1], Cov[MaxRow][2], Cov[MaxRow][3]};
+        for (Uint32 iter = 0; iter < 8; ++iter)
+        {
+            float w[4];
+            float MaxComp = 0;
+            for (Uint32 r = 0; r < 4; ++r)
+            {
+                w[r]    = Cov[r][0] * v[0] + Cov[r][1] * v[1] + Cov[r][2] * v[2] + Cov[r][3] * v[3];
+                MaxComp = std::max(MaxComp, std::abs(w[r]));
+            }
+            if (MaxComp == 0)
+                break;
+            for (Uint32 r = 0; r < 4; ++r)
+                v[r] = w[r] / MaxComp;
+        }
+
+        const float Len = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + v[3] * v[3]);
+        if (Len == 0)
+            return;
+        for (Uint32 c = 0; c < 4; ++c)
+            Axis[c] = v[c] / Len;
+    }
+
+    // Computes the endpoints that enclose the projections of all subset pixels onto the line
+    void GetEndpoints(const BlockPixels& Pixels, const SubsetMask& Mask, float MaxValue, float Endpoints[2][4]) const
+    {
+        float MinT = FLT_MAX;
+        float MaxT = -FLT_MAX;
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            if (Mask.Weights[i] == 0)
+                continue;
+
+            float t = 0;
+            for (Uint32 c = 0; c < 4; ++c)
+                t += (Pixels.Channels[c][i] - Mean[c]) * Axis[c];
+            MinT = std::min(MinT, t);
+            MaxT = std::max(MaxT, t);
+        }
+        if (MinT > MaxT)
+            MinT = MaxT = 0;
+
+        for (Uint32 c = 0; c < 4; ++c)
+        {
+            Endpoints[0][c] = std::min(std::max(Mean[c] + Axis[c] * MinT, 0.f), MaxValue);
+            Endpoints[1][c] = std::min(std::max(Mean[c] + Axis[c] * MaxT, 0.f), MaxValue);
+        }
+    }
+};
+
+// Computes the endpoints that minimize the squared error for the given indices.
+// Returns false if the system is degenerate (e.g. all pixels use the same index).
+bool RefineEndpoints(const BlockPixels& Pixels,
+                     const SubsetMask&  Mask,
+                     const Uint8*       Indices,
+                     Uint32             IndexBits,
+                     float              MaxValue,
+                     float              Endpoints[2][4])
+{
+    const Uint32* Weights = GetInterpolationWeights(IndexBits);
+
+    float AA = 0, AB = 0, BB = 0;
+    float AX[4] = {};
+    float BX[4] = {};
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        if (Mask.Weights[i] == 0)
+            continue;
+
+        const float b = static_cast<float>(Weights[Indices[i]]) / 64.f;
+        const float a = 1.f - b;
+        AA += a * a;
+        AB += a * b;
+        BB += b * b;
+        for (Uint32 c = 0; c < 4; ++c)
+        {
+            AX[c] += a * Pixels.Channels[c][i];
+            BX[c] += b * Pixels.Channels[c][i];
+        }
+    }
+
+    const float Det = AA * BB - AB * AB;
+    if (std::abs(Det) < 1e-6f)
+        return false;
+
+    const float InvDet = 1.f / Det;
+    for (Uint32 c = 0; c < 4; ++c)
+    {
+        Endpoints[0][c] = std::min(std::max((BB * AX[c] - AB * BX[c]) * InvDet, 0.f), MaxValue);
+        Endpoints[1][c] = std::min(std::max((AA * BX[c] - AB * AX[c]) * InvDet, 0.f), MaxValue);
+    }
+    return true;
+}
+
+// Estimates the sum of squared distances from the subset pixels to their best-fit line
+// using the subset moments: the pixel count, the sum of pixel values and the sum of their
+// pairwise products (upper triangle of the 4x4 matrix).
+float EstimateLineResidual(float Count, const float Sum[4], const float SumSq[10])
+{
+    if (Count == 0)
+        return 0;
+
+    float Cov[4][4];
+    for (Uint32 r = 0, k = 0; r < 4; ++r)
+    {
+        for (Uint32 c = r; c < 4; ++c, ++k)
+            Cov[r][c] = Cov[c][r] = SumSq[k] - Sum[r] * Sum[c] / Count;
+    }
+
+    const float Trace = Cov[0][0] + Cov[1][1] + Cov[2][2] + Cov[3][3];
+    if (Trace <= 0)
+        return 0;
+
+    Uint32 MaxRow = 0;
+    for (Uint32 r = 1; r < 4; ++r)
+    {
+        if (Cov[r][r] > Cov[MaxRow][MaxRow])
+            MaxRow = r;
+    }
+    float v[4] = {Cov[MaxRow][0], Cov[MaxRow][1], Cov[MaxRow][2], Cov[MaxRow][3]};
+    float w[4] = {};
+    for (Uint32 iter = 0; iter < 4; ++iter)
+    {
+        for (Uint32 r = 0; r < 4; ++r)
+            w[r] = Cov[r][0] * v[0] + Cov[r][1] * v[1] + Cov[r][2] * v[2] + Cov[r][3] * v[3];
+        const float Norm = std::max(std::max(std::abs(w[0]), std::abs(w[1])), std::max(std::abs(w[2]), std::abs(w[3])));
+        if (Norm == 0)
+            return Trace;
+        for (Uint32 r = 0; r < 4; ++r)
+            v[r] = w[r] / Norm;
+    }
+
+    // Rayleigh quotient gives the variance along the axis
+    float vCv = 0, vv = 0;
+    for (Uint32 r = 0; r < 4; ++r)
+    {
+        vCv += v[r] * (Cov[r][0] * v[0] + Cov[r][1] * v[1] + Cov[r][2] * v[2] + Cov[r][3] * v[3]);
+        vv += v[r] * v[r];
+    }
+    return std::max(Trace - vCv / vv, 0.f);
+}
+
+// Returns the partitions with the smallest total line-fit residuals of their subsets
+Uint32 SelectBestPartitions(const BlockPixels& Pixels, Uint32 NumSubsets, Uint32 NumPartitions, Uint32 MaxCount, Uint32* BestPartitions)
+{
+    VERIFY_EXPR(NumSubsets == 2 || NumSubsets == 3);
+
+    // Center the pixels to reduce the precision loss when computing the covariance from the moments
+    float Centered[4][16];
+    for (Uint32 c = 0; c < 4; ++c)
+    {
+        float Mean = 0;
+        for (Uint32 i = 0; i < 16; ++i)
+            Mean += Pixels.Channels[c][i];
+        Mean /= 16.f;
+        for (Uint32 i = 0; i < 16; ++i)
+            Centered[c][i] = Pixels.Channels[c][i] - Mean;
+    }
+
+    // Per-pixel products, so that the moments of any subset are the sums over its pixels
+    float PixelSq[16][10];
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        for (Uint32 r = 0, k = 0; r < 4; ++r)
+        {
+            for (Uint32 c = r; c < 4; ++c, ++k)
+                PixelSq[i][k] = Centered[r][i] * Centered[c][i];
+        }
+    }
+
+    float  Residuals[64];
+    Uint32 Partitions[64];
+    for (Uint32 p = 0; p < NumPartitions; ++p)
+    {
+        float Count[3]     = {};
+        float Sum[3][4]    = {};
+        float SumSq[3][10] = {};
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            const Uint32 s = GetBCPixelSubset(NumSubsets, p, i);
+
+            Count[s] += 1;
+            for (Uint32 c = 0; c < 4; ++c)
+                Sum[s][c] += Centered[c][i];
+            for (Uint32 k = 0; k < 10; ++k)
+                SumSq[s][k] += PixelSq[i][k];
+        }
+
+        Residuals[p] = 0;
+        for (Uint32 s = 0; s < NumSubsets; ++s)
+            Residuals[p] += EstimateLineResidual(Count[s], Sum[s], SumSq[s]);
+        Partitions[p] = p;
+    }
+
+    const Uint32 Count = std::min(MaxCount, NumPartitions);
+    std::partial_sort(Partitions, Partitions + Count, Partitions + NumPartitions,
+                      [&Residuals](Uint32 p0, Uint32 p1) {
+                          return Residuals[p0] < Residuals[p1];
+                      });
+    std::copy(Partitions, Partitions + Count, BestPartitions);
+    return Count;
+}
+
+// Writes bits into a 128-bit block, least significant bit first
+class BlockBitWriter
+{
+public:
+    explicit BlockBitWriter(Uint8* pBits) :
+        m_pBits{pBits}
+    {
+        std::memset(m_pBits, 0, 16);
+    }
+
+    void Write(Uint32 Value, Uint32 NumBits)
+    {
+        for (Uint32 i = 0; i < NumBits; ++i, ++m_Pos)
+        {
+            VERIFY_EXPR(m_Pos < 128);
+            m_pBits[m_Pos >> 3u] |= static_cast<Uint8>(((Value >> i) & 1u) << (m_Pos & 7u));
+        }
+    }
+
+    Uint32 GetPosition() const { return m_Pos; }
+
+private:
+    Uint8* const m_pBits;
+    Uint32       m_Pos = 0;
+};
+
+// Writes the indices of all pixels. The most significant bit of every anchor index is implicitly zero.
+void WriteIndices(BlockBitWriter& Writer, const Uint8* Indices, Uint32 IndexBits, Uint32 NumSubsets, Uint32 Partition)
+{
+    for (Uint32 i = 0; i < 16; ++i)
+        Writer.Write(Indices[i], IsBCAnchorPixel(NumSubsets, Partition, i) ? IndexBits - 1 : IndexBits);
+}
+
+template <typename EndpointsType>
+void FixAnchorIndices(Uint32 NumSubsets, Uint32 Partition, Uint32 IndexBits, EndpointsType* Endpoints, Uint8* Indices)
+{
+    const Uint32 MaxIndex = (1u << IndexBits) - 1u;
+    for (Uint32 s = 0; s < NumSubsets; ++s)
+    {
+        const Uint32 AnchorPixel = GetBCAnchorPixel(NumSubsets, Partition, s);
+        if (Indices[AnchorPixel] <= MaxIndex / 2)
+            continue;
+
+        // Swap the endpoints so that the anchor index fits into IndexBits - 1 bits
+        Endpoints[s].Swap();
+        const SubsetMask Mask{NumSubsets, Partition, s};
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            if (Mask.Weights[i] != 0)
+                Indices[i] = static_cast<Uint8>(MaxIndex - Indices[i]);
+        }
+    }
+}
+
+
+// BC7
+
+inline Uint32 QuantizeBC7(float Value, Uint32 Bits, Uint32 PBit, bool HasPBit)
+{
+    const Uint32 TotalBits = Bits + (HasPBit ? 1u : 0u);
+    float        Scaled    = Value * static_cast<float>((1u << TotalBits) - 1u) / 255.f;
+    if (HasPBit)
+        Scaled = (Scaled - static_cast<float>(PBit)) * 0.5f;
+
+    const int MaxQ    = (1 << Bits) - 1;
+    const int Q0      = static_cast<int>(Scaled + 0.5f);
+    Uint32    BestQ   = 0;
+    float     BestErr = FLT_MAX;
+    for (int q = std::max(Q0 - 1, 0); q <= std::min(Q0 + 1, MaxQ); ++q)
+    {
+        const float Err = std::abs(static_cast<float>(UnquantizeBC7(static_cast<Uint32>(q), Bits, PBit, HasPBit)) - Value);
+        if (Err < BestErr)
+        {
+            BestErr = Err;
+            BestQ   = static_cast<Uint32>(q);
+        }
+    }
+    return BestQ;
+}
+
+struct BC7Endpoints
+{
+    Uint8 Values[2][4] = {};
+    Uint8 PBits[2]     = {};
+
+    void Swap()
+    {
+        std::swap(Values[0], Values[1]);
+        std::swap(PBits[0], PBits[1]);
+    }
+};
+
+// Quantizes the endpoint channels [FirstChannel, FirstChannel + NumChannels) and builds the palette
+// of the interpolated values. Palette entries of other channels are set to zero.
+void QuantizeBC7Endpoints(const BC7ModeDesc& Desc,
+                          const float        Endpoints[2][4],
+                          const Uint32       PBits[2],
+                          Uint32             FirstChannel,
+                          Uint32             NumChannels,
+                          Uint32             IndexBits,
+                          BC7Endpoints&      Quantized,
+                          BlockPalette&      Palette)
+{
+    const bool HasPBit = Desc.EndpointPBits != 0 || Desc.SharedPBits != 0;
+
+    Uint32 Unquantized[2][4] = {};
+    for (Uint32 e = 0; e < 2; ++e)
+    {
+        Quantized.PBits[e] = static_cast<Uint8>(PBits[e]);
+        for (Uint32 c = FirstChannel; c < FirstChannel + NumChannels; ++c)
+        {
+            const Uint32 Bits = c < 3 ? Desc.ColorBits : Desc.AlphaBits;
+            if (Bits == 0)
+            {
+                // Opaque mode
+                Quantized.Values[e][c] = 0;
+                Unquantized[e][c]      = 255;
+                continue;
+            }
+            const Uint32 q         = QuantizeBC7(Endpoints[e][c], Bits, PBits[e], HasPBit);
+            Quantized.Values[e][c] = static_cast<Uint8>(q);
+            Unquantized[e][c]      = UnquantizeBC7(q, Bits, PBits[e], HasPBit);
+        }
+    }
+
+    const Uint32* Weights = GetInterpolationWeights(IndexBits);
+    Palette.Size          = 1u << IndexBits;
+    for (Uint32 i = 0; i < Palette.Size; ++i)
+    {
+        for (Uint32 c = 0; c < 4; ++c)
+            Palette.Colors[i][c] = static_cast<float>(((64u - Weights[i]) * Unquantized[0][c] + Weights[i] * Unquantized[1][c] + 32u) >> 6u);
+    }
+}
+
+struct BC7Encoding
+{
+    Uint32       Mode           = 6;
+    Uint32       Partition      = 0;
+    Uint32       Rotation       = 0;
+    Uint32       IndexSelection = 0;
+    BC7Endpoints Endpoints[3];
+    Uint8        Indices[16]  = {}; // Primary index set
+    Uint8        Indices2[16] = {}; // Secondary index set of modes 4 and 5
+    float        Error        = FLT_MAX;
+};
+
+// Encodes the channels [FirstChannel, FirstChannel + NumChannels) of the subset pixels.
+// The pixels must have zero values in all other channels.
+float EncodeBC7Subset(const BC7ModeDesc& Desc,
+                      const BlockPixels& Pixels,
+                      const SubsetMask&  Mask,
+                      Uint32             FirstChannel,
+                      Uint32             NumChannels,
+                      Uint32             IndexBits,
+                      bool               IsOpaque,
+                      Uint32             NumIterations,
+                      BC7Endpoints&      BestEndpoints,
+                      Uint8*             BestIndices)
+{
+    float Endpoints[2][4];
+    LineFit{Pixels, Mask}.GetEndpoints(Pixels, Mask, 255.f, Endpoints);
+
+    const Uint32 NumPBitCombinations = Desc.EndpointPBits != 0 ? 4 : (Desc.SharedPBits != 0 ? 2 : 1);
+    // Alpha value of 255 can only be represented when both p-bits are set.
+    // Keep opaque blocks exactly opaque even if this slightly increases the color error.
+    const Uint32 FirstPBitCombination = (IsOpaque && Desc.AlphaBits > 0) ? NumPBitCombinations - 1 : 0;
+
+    float BestError = FLT_MAX;
+    for (Uint32 iter = 0;; ++iter)
+    {
+        for (Uint32 pc = FirstPBitCombination; pc < NumPBitCombinations; ++pc)
+        {
+            const Uint32 PBits[2] = {pc & 1u, Desc.SharedPBits != 0 ? pc & 1u : pc >> 1u};
+
+            BC7Endpoints Quantized;
+            BlockPalette Palette;
+            QuantizeBC7Endpoints(Desc, Endpoints, PBits, FirstChannel, NumChannels, IndexBits, Quantized, Palette);
+
+            Uint8       Indices[16];
+            const float Error = FindBestIndices(Pixels, Mask, Palette, Indices);
+            if (Error < BestError)
+            {
+                BestError     = Error;
+                BestEndpoints = Quantized;
+                for (Uint32 i = 0; i < 16; ++i)
+                {
+                    if (Mask.Weights[i] != 0)
+                        BestIndices[i] = Indices[i];
+                }
+            }
+        }
+
+        if (iter >= NumIterations || BestError == 0 || !RefineEndpoints(Pixels, Mask, BestIndices, IndexBits, 255.f, Endpoints))
+            break;
+    }
+
+    return BestError;
+}
+
+// Encodes the block with one of the modes that have a single index set (0, 1, 2, 3, 6 and 7)
+void EncodeBC7Mode(Uint32 Mode, Uint32 Partition, const BlockPixels& Pixels, bool IsOpaque, Uint32 NumIterations, BC7Encoding& Best)
+{
+    const BC7ModeDesc& Desc = BC7Modes[Mode];
+    VERIFY_EXPR(Desc.Index2Bits == 0);
+
+    BC7Encoding Enc;
+    Enc.Mode      = Mode;
+    Enc.Partition = Partition;
+    Enc.Error     = 0;
+    for (Uint32 s = 0; s < Desc.NumSubsets && Enc.Error < Best.Error; ++s)
+    {
+        const SubsetMask Mask{Desc.NumSubsets, Partition, s};
+        Enc.Error += EncodeBC7Subset(Desc, Pixels, Mask, 0, 4, Desc.IndexBits, IsOpaque, NumIterations, Enc.Endpoints[s], Enc.Indices);
+    }
+    if (Enc.Error >= Best.Error)
+        return;
+
+    FixAnchorIndices(Desc.NumSubsets, Partition, Desc.IndexBits, Enc.Endpoints, Enc.Indices);
+    Best = Enc;
+}
+
+// Swaps the endpoints of the channels and inverts the indices if the index of the anchor pixel
+// does not fit into IndexBits - 1 bits.
+void FixAnchorIndex(Uint32 FirstChannel, Uint32 NumChannels, Uint32 IndexBits, BC7Endpoints& Endpoints, Uint8* Indices)
+{
+    const Uint32 MaxIndex = (1u << IndexBits) - 1u;
+    if (Indices[0] <= MaxIndex / 2)
+        return;
+
+    for (Uint32 c = FirstChannel; c < FirstChannel + NumChannels; ++c)
+        std::swap(Endpoints.Values[0][c], Endpoints.Values[1][c]);
+    for (Uint32 i = 0; i < 16; ++i)
+        Indices[i] = static_cast<Uint8>(MaxIndex - Indices[i]);
+}
+
+// Encodes the block with mode 4 or 5 that encode color and alpha with separate index sets.
+// Rotation swaps the alpha channel with one of the color channels, so that the channel
+// that correlates least with the others gets its own indices.
+void EncodeBC7RotationMode(Uint32 Mode, Uint32 Rotation, Uint32 IndexSelection, const BlockPixels& Pixels, bool IsOpaque, Uint32 NumIterations, BC7Encoding& Best)
+{
+    const BC7ModeDesc& Desc = BC7Modes[Mode];
+    VERIFY_EXPR(Desc.Index2Bits != 0 && Rotation < 4 && IndexSelection < (1u << Desc.IndexSelectionBits));
+
+    BlockPixels ColorPixels = Pixels;
+    if (Rotation != 0)
+        std::swap(ColorPixels.Channels[Rotation - 1], ColorPixels.Channels[3]);
+
+    BlockPixels AlphaPixels = {};
+    std::swap(AlphaPixels.Channels[3], ColorPixels.Channels[3]);
+
+    // With index selection bit set, color uses the secondary index set and alpha uses the primary one
+    const Uint32 ColorIndexBits = IndexSelection != 0 ? Desc.Index2Bits : Desc.IndexBits;
+    const Uint32 AlphaIndexBits = IndexSelection != 0 ? Desc.IndexBits : Desc.Index2Bits;
+
+    BC7Encoding Enc;
+    Enc.Mode           = Mode;
+    Enc.Rotation       = Rotation;
+    Enc.IndexSelection = IndexSelection;
+
+    Uint8* const ColorIndices = IndexSelection != 0 ? Enc.Indices2 : Enc.Indices;
+    Uint8* const AlphaIndices = IndexSelection != 0 ? Enc.Indices : Enc.Indices2;
+
+    const SubsetMask Mask{1, 0, 0};
+    BC7Endpoints     ColorEndpoints;
+    BC7Endpoints     AlphaEndpoints;
+    Enc.Error = EncodeBC7Subset(Desc, ColorPixels, Mask, 0, 3, ColorIndexBits, IsOpaque, NumIterations, ColorEndpoints, ColorIndices);
+    if (Enc.Error >= Best.Error)
+        return;
+    Enc.Error += EncodeBC7Subset(Desc, AlphaPixels, Mask, 3, 1, AlphaIndexBits, IsOpaque, NumIterations, AlphaEndpoints, AlphaIndices);
+    if (Enc.Error >= Best.Error)
+        return;
+
+    for (Uint32 e = 0; e < 2; ++e)
+    {
+        for (Uint32 c = 0; c < 3; ++c)
+            Enc.Endpoints[0].Values[e][c] = ColorEndpoints.Values[e][c];
+        Enc.Endpoints[0].Values[e][3] = AlphaEndpoints.Values[e][3];
+    }
+    FixAnchorIndex(0, 3, ColorIndexBits, Enc.Endpoints[0], ColorIndices);
+    FixAnchorIndex(3, 1, AlphaIndexBits, Enc.Endpoints[0], AlphaIndices);
+
+    Best = Enc;
+}
+
+void WriteBC7Block(const BC7Encoding& Enc, Uint8* Bits)
+{
+    const BC7ModeDesc& Desc = BC7Modes[Enc.Mode];
+
+    BlockBitWriter Writer{Bits};
+    Writer.Write(1u << Enc.Mode, Enc.Mode + 1u);
+    Writer.Write(Enc.Partition, Desc.PartitionBits);
+    Writer.Write(Enc.Rotation, Desc.RotationBits);
+    Writer.Write(Enc.IndexSelection, Desc.IndexSelectionBits);
+
+    for (Uint32 c = 0; c < 4; ++c)
+    {
+        const Uint32 NumBits = c < 3 ? Desc.ColorBits : Desc.AlphaBits;
+        for (Uint32 s = 0; s < Desc.NumSubsets; ++s)
+        {
+            for (Uint32 e = 0; e < 2; ++e)
+                Writer.Write(Enc.Endpoints[s].Values[e][c], NumBits);
+        }
+    }
+
+    for (Uint32 s = 0; s < Desc.NumSubsets; ++s)
+    {
+        if (Desc.EndpointPBits != 0)
+        {
+            Writer.Write(Enc.Endpoints[s].PBits[0], 1);
+            Writer.Write(Enc.Endpoints[s].PBits[1], 1);
+        }
+        else if (Desc.SharedPBits != 0)
+        {
+            Writer.Write(Enc.Endpoints[s].PBits[0], 1);
+        }
+    }
+
+    WriteIndices(Writer, Enc.Indices, Desc.IndexBits, Desc.NumSubsets, Enc.Partition);
+    if (Desc.Index2Bits != 0)
+        WriteIndices(Writer, Enc.Indices2, Desc.Index2Bits, 1, 0);
+    VERIFY_EXPR(Writer.GetPosition() == 128);
+}
+
+
+// BC6H
+
+// The encoder only produces unsigned (BC6H_UF16) blocks
+
+// Returns the description of BC6H mode 1-14
+inline const BC6HModeDesc& GetBC6HMode(Uint32 Mode)
+{
+    VERIFY_EXPR(Mode >= 1 && Mode <= _countof(BC6HModes));
+    return BC6HModes[Mode - 1];
+}
+
+inline Uint32 GetBC6HIndexBits(const BC6HModeDesc& Desc)
+{
+    return Desc.NumRegions == 2 ? 3 : 4;
+}
+
+// Largest finite half-precision value (65504)
+constexpr float BC6HMaxValue = 31743.f;
+
+inline Uint32 UnquantizeBC6H(Uint32 Value, Uint32 Bits)
+{
+    if (Value == 0)
+        return 0;
+    if (Value == (1u << Bits) - 1u)
+        return 0xFFFFu;
+    return ((Value << 16u) + 0x8000u) >> Bits;
+}
+
+// Scales unquantized value to the half-precision float bit pattern
+inline Uint32 FinishUnquantizeBC6H(Uint32 Value)
+{
+    return (Value * 31u) >> 6u;
+}
+
+inline Uint32 QuantizeBC6H(float Value, Uint32 Bits)
+{
+    const int MaxQ = (1 << Bits) - 1;
+    const int Q0   = static_cast<int>(Value * (64.f / 31.f) * static_cast<float>(1u << Bits) / 65536.f);
+
+    Uint32 BestQ   = 0;
+    float  BestErr = FLT_MAX;
+    for (int q = std::max(Q0 - 1, 0); q <= std::min(Q0 + 1, MaxQ); ++q)
+    {
+        const float Err = std::abs(static_cast<float>(FinishUnquantizeBC6H(UnquantizeBC6H(static_cast<Uint32>(q), Bits))) - Value);
+        if (Err < BestErr)
+        {
+            BestErr = Err;
+            BestQ   = static_cast<Uint32>(q);
+        }
+    }
+    return BestQ;
+}
+
+struct BC6HEndpoints
+{
+    Uint32 Values[2][3] = {};
+
+    void Swap()
+    {
+        std::swap(Values[0], Values[1]);
+    }
+};
+
+// Builds the palette of the interpolated values for the quantized endpoints of one region
+void BuildBC6HPalette(const BC6HModeDesc& Desc, const BC6HEndpoints& Endpoints, BlockPalette& Palette)
+{
+    Uint32 Unquantized[2][3];
+    for (Uint32 e = 0; e < 2; ++e)
+    {
+        for (Uint32 c = 0; c < 3; ++c)
+            Unquantized[e][c] = UnquantizeBC6H(Endpoints.Values[e][c], Desc.EndpointBits);
+    }
+
+    const Uint32  IndexBits = GetBC6HIndexBits(Desc);
+    const Uint32* Weights   = GetInterpolationWeights(IndexBits);
+    Palette.Size            = 1u << IndexBits;
+    for (Uint32 i = 0; i < Palette.Size; ++i)
+    {
+        for (Uint32 c = 0; c < 3; ++c)
+        {
+            const Uint32 Value   = ((64u - Weights[i]) * Unquantized[0][c] + Weights[i] * Unquantized[1][c] + 32u) >> 6u;
+            Palette.Colors[i][c] = static_cast<float>(FinishUnquantizeBC6H(Value));
+        }
+        Palette.Colors[i][3] = 0;
+    }
+}
+
+void QuantizeBC6HEndpoints(const BC6HModeDesc& Desc,
+                           const float         Endpoints[2][4],
+                           BC6HEndpoints&      Quantized,
+                           BlockPalette&       Palette)
+{
+    for (Uint32 e = 0; e < 2; ++e)
+    {
+        for (Uint32 c = 0; c < 3; ++c)
+            Quantized.Values[e][c] = QuantizeBC6H(Endpoints[e][c], Desc.EndpointBits);
+    }
+    BuildBC6HPalette(Desc, Quantized, Palette);
+}
+
+struct BC6HEncoding
+{
+    const BC6HModeDesc* pDesc     = nullptr;
+    Uint32              Partition = 0;
+    BC6HEndpoints       Endpoints[2];
+    Uint8               Indices[16] = {};
+    float               Error       = FLT_MAX;
+};
+
+float EncodeBC6HRegion(const BC6HModeDesc& Desc,
+                       const BlockPixels&  Pixels,
+                       const SubsetMask&   Mask,
+                       Uint32              NumIterations,
+                       BC6HEndpoints&      BestEndpoints,
+                       Uint8*              BestIndices)
+{
+    float Endpoints[2][4];
+    LineFit{Pixels, Mask}.GetEndpoints(Pixels, Mask, BC6HMaxValue, Endpoints);
+
+    float BestError = FLT_MAX;
+    for (Uint32 iter = 0;; ++iter)
+    {
+        BC6HEndpoints Quantized;
+        BlockPalette  Palette;
+        QuantizeBC6HEndpoints(Desc, Endpoints, Quantized, Palette);
+
+        Uint8       Indices[16];
+        const float Error = FindBestIndices(Pixels, Mask, Palette, Indices);
+        if (Error < BestError)
+        {
+            BestError     = Error;
+            BestEndpoints = Quantized;
+            for (Uint32 i = 0; i < 16; ++i)
+            {
+                if (Mask.Weights[i] != 0)
+                    BestIndices[i] = Indices[i];
+            }
+        }
+
+        if (iter >= NumIterations || BestError == 0 || !RefineEndpoints(Pixels, Mask, BestIndices, GetBC6HIndexBits(Desc), BC6HMaxValue, Endpoints))
+            break;
+    }
+
+    return BestError;
+}
+
+// Checks that all endpoints of a transformed mode can be stored as signed deltas from the first endpoint.
+// If Clamp is true, the endpoints whose deltas are out of range are moved towards the first endpoint.
+bool FitBC6HDeltas(const BC6HModeDesc& Desc, BC6HEndpoints* Endpoints, bool Clamp)
+{
+    VERIFY_EXPR(Desc.Transformed);
+
+    const int MaxValue = (1 << Desc.EndpointBits) - 1;
+
+    bool Fits = true;
+    for (Uint32 c = 0; c < 3; ++c)
+    {
+        const int MinDelta = -(1 << (Desc.DeltaBits[c] - 1));
+        const int MaxDelta = (1 << (Desc.DeltaBits[c] - 1)) - 1;
+        const int W        = static_cast<int>(Endpoints[0].Values[0][c]);
+        for (Uint32 e = 1; e < Desc.NumRegions * 2u; ++e)
+        {
+            Uint32&   Value = Endpoints[e / 2].Values[e % 2][c];
+            const int Delta = static_cast<int>(Value) - W;
+            if (Delta >= MinDelta && Delta <= MaxDelta)
+                continue;
+
+            Fits = false;
+            if (Clamp)
+                Value = static_cast<Uint32>(std::min(std::max(W + std::min(std::max(Delta, MinDelta), MaxDelta), 0), MaxValue));
+        }
+    }
+    return Fits;
+}
+
+void EncodeBC6HMode(const BC6HModeDesc& Desc, Uint32 Partition, const BlockPixels& Pixels, Uint32 NumIterations, BC6HEncoding& Best)
+{
+    const Uint32 IndexBits = GetBC6HIndexBits(Desc);
+
+    BC6HEncoding Enc;
+    Enc.pDesc     = &Desc;
+    Enc.Partition = Partition;
+    Enc.Error     = 0;
+    for (Uint32 r = 0; r < Desc.NumRegions && Enc.Error < Best.Error; ++r)
+    {
+        Enc.Error += EncodeBC6HRegion(Desc, Pixels, SubsetMask{Desc.NumRegions, Partition, r}, NumIterations, Enc.Endpoints[r], Enc.Indices);
+    }
+    if (Enc.Error >= Best.Error)
+        return;
+
+    FixAnchorIndices(Desc.NumRegions, Partition, IndexBits, Enc.Endpoints, Enc.Indices);
+    if (Desc.Transformed && !FitBC6HDeltas(Desc, Enc.Endpoints, /*Clamp = */ true))
+    {
+        // Select the indices for the clamped endpoints
+        Enc.Error = 0;
+        for (Uint32 r = 0; r < Desc.NumRegions; ++r)
+        {
+            BlockPalette Palette;
+            BuildBC6HPalette(Desc, Enc.Endpoints[r], Palette);
+            Enc.Error += FindBestIndices(Pixels, SubsetMask{Desc.NumRegions, Partition, r}, Palette, Enc.Indices);
+        }
+        if (Enc.Error >= Best.Error)
+            return;
+
+        // Swapping the endpoints of the first region changes the base endpoint, so the deltas need to be checked again
+        FixAnchorIndices(Desc.NumRegions, Partition, IndexBits, Enc.Endpoints, Enc.Indices);
+        if (!FitBC6HDeltas(Desc, Enc.Endpoints, /*Clamp = */ false))
+            return;
+    }
+
+    Best = Enc;
+}
+
+void WriteBC6HBlock(const BC6HEncoding& Enc, Uint8* Bits)
+{
+    const BC6HModeDesc&  Desc = *Enc.pDesc;
+    const BC6HEndpoints* EP   = Enc.Endpoints;
+
+    // Endpoints are stored in W, X, Y, Z order. Transformed modes store X, Y and Z as deltas from W.
+    Uint32 Fields[BC6H_FIELD_COUNT] = {};
+    for (Uint32 c = 0; c < 3; ++c)
+    {
+        const Uint32 W = EP[0].Values[0][c];
+        for (Uint32 e = 0; e < Desc.NumRegions * 2u; ++e)
+        {
+            Uint32 Value = EP[e / 2].Values[e % 2][c];
+            if (Desc.Transformed && e > 0)
+                Value = (Value - W) & ((1u << Desc.DeltaBits[c]) - 1u);
+            Fields[c * 4 + e] = Value;
+        }
+    }
+    Fields[D] = Enc.Partition;
+
+    BlockBitWriter Writer{Bits};
+    Writer.Write(Desc.ModeBits, Desc.NumModeBits);
+    for (Uint32 f = 0; f < Desc.LayoutSize; ++f)
+    {
+        const BC6HFieldBits& Item = Desc.Layout[f];
+        if (Item.Last >= Item.First)
+        {
+            Writer.Write(Fields[Item.Field] >> Item.First, Item.Last - Item.First + 1u);
+        }
+        else
+        {
+            for (Uint32 b = Item.First + 1u; b-- > Item.Last;)
+                Writer.Write(Fields[Item.Field] >> b, 1);
+        }
+    }
+
+    WriteIndices(Writer, Enc.Indices, GetBC6HIndexBits(Desc), Desc.NumRegions, Enc.Partition);
+    VERIFY_EXPR(Writer.GetPosition() == 128);
+}
+
+// Converts a float value to the unsigned half-precision bit pattern, clamping
+// negative values to zero and large values to the largest finite half.
+Uint32 FloatToUF16(float Value)
+{
+    if (!(Value > 0))
+        return 0; // Negative values, zero and NaN
+    if (Value >= 65504.f)
+        return 0x7BFF;
+
+    Uint32 Bits;
+    std::memcpy(&Bits, &Value, sizeof(Bits));
+
+    const int Exponent = static_cast<int>(Bits >> 23u) - 127 + 15;
+    if (Exponent <= 0)
+    {
+        // Denormalized half
+        if (Exponent < -10)
+            return 0;
+        const Uint32 Mantissa = (Bits & 0x7FFFFFu) | 0x800000u;
+        const Uint32 Shift    = static_cast<Uint32>(14 - Exponent);
+        return (Mantissa + (1u << (Shift - 1u))) >> Shift;
+    }
+
+    const Uint32 Half = (static_cast<Uint32>(Exponent) << 10u) | ((Bits >> 13u) & 0x3FFu);
+    // Round to nearest; the carry correctly propagates into the exponent
+    return std::min(Half + ((Bits >> 12u) & 1u), 0x7BFFu);
+}
+
+} // namespace
+
+void CompressBC7Block(const Uint8* Src, Uint8* Bits, BC_COMPRESSION_QUALITY Quality)
+{
+    VERIFY_EXPR(Src != nullptr && Bits != nullptr);
+
+    BlockPixels Pixels;
+    bool        IsOpaque = true;
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        for (Uint32 c = 0; c < 4; ++c)
+            Pixels.Channels[c][i] = static_cast<float>(Src[i * 4 + c]);
+        IsOpaque = IsOpaque && Src[i * 4 + 3] == 255;
+    }
+
+    Uint32 NumIterations  = 1;
+    Uint32 NumPartitions  = 0; // The number of two-subset partitions to try
+    Uint32 NumPartitions3 = 0; // The number of three-subset partitions to try
+    bool   UseAllModes    = false;
+    switch (Quality)
+    {
+        case BC_COMPRESSION_QUALITY_FAST:
+            break;
+
+        case BC_COMPRESSION_QUALITY_NORMAL:
+            NumIterations = 2;
+            NumPartitions = 4;
+            break;
+
+        case BC_COMPRESSION_QUALITY_HIGH:
+            NumIterations  = 4;
+            NumPartitions  = 16;
+            NumPartitions3 = 8;
+            UseAllModes    = true;
+            break;
+
+        default:
+            UNEXPECTED("Unexpected compression quality");
+    }
+
+    BC7Encoding Best;
+    EncodeBC7Mode(6, 0, Pixels, IsOpaque, NumIterations, Best);
+
+    if (UseAllModes)
+    {
+        // Modes 4 and 5 encode alpha with separate indices. Rotations let any channel use the separate indices.
+        for (Uint32 Rotation = 0; Rotation < 4 && Best.Error > 0; ++Rotation)
+        {
+            EncodeBC7RotationMode(5, Rotation, 0, Pixels, IsOpaque, NumIterations, Best);
+            for (Uint32 IndexSelection = 0; IndexSelection < 2 && Best.Error > 0; ++IndexSelection)
+                EncodeBC7RotationMode(4, Rotation, IndexSelection, Pixels, IsOpaque, NumIterations, Best);
+        }
+    }
+
+    if (NumPartitions > 0 && Best.Error > 0)
+    {
+        Uint32       Partitions[64];
+        const Uint32 Count = SelectBestPartitions(Pixels, 2, 64, NumPartitions, Partitions);
+        for (Uint32 p = 0; p < Count && Best.Error > 0; ++p)
+        {
+            if (IsOpaque)
+            {
+                // Opaque blocks use mode 1 as it has higher endpoint and index precision than mode 7
+                EncodeBC7Mode(1, Partitions[p], Pixels, IsOpaque, NumIterations, Best);
+                // Mode 3 has higher endpoint precision than mode 1, but 2-bit indices
+                if (UseAllModes)
+                    EncodeBC7Mode(3, Partitions[p], Pixels, IsOpaque, NumIterations, Best);
+            }
+            else
+            {
+                EncodeBC7Mode(7, Partitions[p], Pixels, IsOpaque, NumIterations, Best);
+            }
+        }
+    }
+
+    if (NumPartitions3 > 0 && IsOpaque && Best.Error > 0)
+    {
+        // Mode 0 can only use the first 16 three-subset partitions
+        Uint32 Partitions[64];
+        Uint32 Count = SelectBestPartitions(Pixels, 3, 16, NumPartitions3, Partitions);
+        for (Uint32 p = 0; p < Count && Best.Error > 0; ++p)
+            EncodeBC7Mode(0, Partitions[p], Pixels, IsOpaque, NumIterations, Best);
+
+        Count = SelectBestPartitions(Pixels, 3, 64, NumPartitions3, Partitions);
+        for (Uint32 p = 0; p < Count && Best.Error > 0; ++p)
+            EncodeBC7Mode(2, Partitions[p], Pixels, IsOpaque, NumIterations, Best);
+    }
+
+    WriteBC7Block(Best, Bits);
+}
+
+void CompressBC6HBlock(const float* Src, Uint8* Bits, Uint32 SrcChannels, BC_COMPRESSION_QUALITY Quality)
+{
+    VERIFY_EXPR(Src != nullptr && Bits != nullptr);
+    VERIFY(SrcChannels >= 3, "At least 3 source channels are expected");
+
+    Uint16 HalfData[16 * 3];
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        for (Uint32 c = 0; c < 3; ++c)
+            HalfData[i * 3 + c] = static_cast<Uint16>(FloatToUF16(Src[i * SrcChannels + c]));
+    }
+    CompressBC6HBlockHalf(HalfData, Bits, 3, Quality);
+}
+
+void CompressBC6HBlockHalf(const Uint16* Src, Uint8* Bits, Uint32 SrcChannels, BC_COMPRESSION_QUALITY Quality)
+{
+    VERIFY_EXPR(Src != nullptr && Bits != nullptr);
+    VERIFY(SrcChannels >= 3, "At least 3 source channels are expected");
+
+    // BC6H interpolates the half-precision bit patterns, so the encoder works in the same space.
+    BlockPixels Pixels;
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        for (Uint32 c = 0; c < 3; ++c)
+        {
+            const Uint32 Value    = Src[i * SrcChannels + c];
+            Pixels.Channels[c][i] = (Value & 0x8000u) != 0 ? 0.f : std::min(static_cast<float>(Value), BC6HMaxValue);
+        }
+        Pixels.Channels[3][i] = 0;
+    }
+
+    // Modes 11-14 have one region, modes 1-10 have two regions
+    Uint32 NumIterations      = 1;
+    Uint32 NumPartitions      = 0;
+    Uint32 LastOneRegionMode  = 11;
+    Uint32 FirstTwoRegionMode = 10;
+    switch (Quality)
+    {
+        case BC_COMPRESSION_QUALITY_FAST:
+            break;
+
+        case BC_COMPRESSION_QUALITY_NORMAL:
+            NumIterations     = 2;
+            NumPartitions     = 4;
+            LastOneRegionMode = 12;
+            break;
+
+        case BC_COMPRESSION_QUALITY_HIGH:
+            NumIterations      = 4;
+            NumPartitions      = 8;
+            LastOneRegionMode  = 14;
+            FirstTwoRegionMode = 1;
+            break;
+
+        default:
+            UNEXPECTED("Unexpected compression quality");
+    }
+
+    BC6HEncoding Best;
+    for (Uint32 Mode = 11; Mode <= LastOneRegionMode && Best.Error > 0; ++Mode)
+        EncodeBC6HMode(GetBC6HMode(Mode), 0, Pixels, NumIterations, Best);
+
+    if (NumPartitions > 0 && Best.Error > 0)
+    {
+        Uint32       Partitions[32];
+        const Uint32 Count = SelectBestPartitions(Pixels, 2, 32, NumPartitions, Partitions);
+        for (Uint32 p = 0; p < Count && Best.Error > 0; ++p)
+        {
+            for (Uint32 Mode = FirstTwoRegionMode; Mode <= 10 && Best.Error > 0; ++Mode)
+                EncodeBC6HMode(GetBC6HMode(Mode), Partitions[p], Pixels, NumIterations, Best);
+        }
+    }
+
+    WriteBC6HBlock(Best, Bits);
+}
+
+} // namespace Diligent
@@ -25,110 +25,426 @@
  */
 
 #include "BCTools.h"
+
+#include <algorithm>
+#include <cstring>
+
 #include "DebugUtilities.hpp"
+#include "GraphicsAccessories.hpp"
+#include "Intrinsics.hpp"
+#include "ThreadPool.hpp"
 
 namespace Diligent
 {
 
-inline void DecompressColorBlock(const Uint8* Bits,
-                                 Uint8*       DstBuffer,
-                                 Uint32       DstChannels)
+namespace
 {
-    VERIFY_EXPR(DstChannels >= 3);
-    const Uint32 RGB[2] =
-        {
-            Uint32{Bits[0]} | ((Uint32{Bits[1]}) << 8),
-            Uint32{Bits[2]} | ((Uint32{Bits[3]}) << 8) //
-        };
 
-    static constexpr Uint32 ROffset = 11;
-    static constexpr Uint32 GOffset = 5;
-    static constexpr Uint32 BOffset = 0;
+inline Uint32 Expand5To8(Uint32 Value)
+{
+    return (Value << 3u) | (Value >> 2u);
+}
+
+inline Uint32 Expand6To8(Uint32 Value)
+{
+    return (Value << 2u) | (Value >> 4u);
+}
+
+inline Uint32 PackRGBA8(Uint32 R, Uint32 G, Uint32 B, Uint32 A)
+{
+    return R | (G << 8u) | (B << 16u) | (A << 24u);
+}
 
-    static constexpr Uint32 RMask = (1 << 5) - 1;
-    static constexpr Uint32 GMask = (1 << 6) - 1;
-    static constexpr Uint32 BMask = (1 << 5) - 1;
+// Computes the four RGBA8 colors of a BC1-BC3 color block.
+// BC2 and BC3 always use the four-color mode.
+void GetColorPalette(const Uint8* Bits, bool AllowThreeColorMode, Uint32 Palette[4])
+{
+    const Uint32 C0 = Uint32{Bits[0]} | (Uint32{Bits[1]} << 8u);
+    const Uint32 C1 = Uint32{Bits[2]} | (Uint32{Bits[3]} << 8u);
 
-    Uint32 R[4] = {(RGB[0] >> ROffset) & RMask, (RGB[1] >> ROffset) & RMask, 0, 0};
-    Uint32 G[4] = {(RGB[0] >> GOffset) & GMask, (RGB[1] >> GOffset) & GMask, 0, 0};
-    Uint32 B[4] = {(RGB[0] >> BOffset) & BMask, (RGB[1] >> BOffset) & BMask, 0, 0};
+    const Uint32 R[2] = {Expand5To8(C0 >> 11u), Expand5To8(C1 >> 11u)};
+    const Uint32 G[2] = {Expand6To8((C0 >> 5u) & 0x3Fu), Expand6To8((C1 >> 5u) & 0x3Fu)};
+    const Uint32 B[2] = {Expand5To8(C0 & 0x1Fu), Expand5To8(C1 & 0x1Fu)};
 
-    if (RGB[0] > RGB[1])
+    Palette[0] = PackRGBA8(R[0], G[0], B[0], 255);
+    Palette[1] = PackRGBA8(R[1], G[1], B[1], 255);
+    if (C0 > C1 || !AllowThreeColorMode)
     {
-        R[2] = (2 * R[0] + 1 * R[1]) / 3;
-        G[2] = (2 * G[0] + 1 * G[1]) / 3;
-        B[2] = (2 * B[0] + 1 * B[1]) / 3;
-
-        R[3] = (1 * R[0] + 2 * R[1]) / 3;
-        G[3] = (1 * G[0] + 2 * G[1]) / 3;
-        B[3] = (1 * B[0] + 2 * B[1]) / 3;
+        Palette[2] = PackRGBA8((2 * R[0] + R[1] + 1) / 3, (2 * G[0] + G[1] + 1) / 3, (2 * B[0] + B[1] + 1) / 3, 255);
+        Palette[3] = PackRGBA8((R[0] + 2 * R[1] + 1) / 3, (G[0] + 2 * G[1] + 1) / 3, (B[0] + 2 * B[1] + 1) / 3, 255);
     }
     else
     {
-        R[2] = (2 * R[0] + 1 * R[1]) / 2;
-        G[2] = (2 * G[0] + 1 * G[1]) / 2;
-        B[2] = (2 * B[0] + 1 * B[1]) / 2;
+        Palette[2] = PackRGBA8((R[0] + R[1] + 1) / 2, (G[0] + G[1] + 1) / 2, (B[0] + B[1] + 1) / 2, 255);
+        // Transparent black
+        Palette[3] = 0;
     }
+}
 
-    const Uint8* Palette = Bits + 4;
-    for (Uint32 i = 0; i < 16; ++i)
+// Decompresses BC1-BC3 color block into 4x4 RGBA8 pixels.
+// If Alpha is not null, it contains the alpha values of all 16 pixels that replace the palette alpha.
+void DecompressColorBlock(const Uint8* Bits,
+                          bool         AllowThreeColorMode,
+                          const Uint8* Alpha,
+                          Uint8*       Dst,
+                          size_t       DstStride)
+{
+    Uint32 Palette[4];
+    GetColorPalette(Bits, AllowThreeColorMode, Palette);
+
+    const Uint32 Indices = Uint32{Bits[4]} | (Uint32{Bits[5]} << 8u) | (Uint32{Bits[6]} << 16u) | (Uint32{Bits[7]} << 24u);
+
+#if DILIGENT_SSE2_SUPPORTED
+    const __m128i Zero     = _mm_setzero_si128();
+    const __m128i Colors[] = {
+        _mm_set1_epi32(static_cast<int>(Palette[0])),
+        _mm_set1_epi32(static_cast<int>(Palette[1])),
+        _mm_set1_epi32(static_cast<int>(Palette[2])),
+        _mm_set1_epi32(static_cast<int>(Palette[3])),
+    };
+    const __m128i AllIndices = _mm_set1_epi32(static_cast<int>(Indices));
+
+    // Selects A where Mask is set and B otherwise
+    auto Select = [](__m128i Mask, __m128i A, __m128i B) {
+        return _mm_or_si128(_mm_and_si128(Mask, A), _mm_andnot_si128(Mask, B));
+    };
+
+    // Low index bits of the four pixels in the row
+    __m128i LoBit = _mm_setr_epi32(1 << 0, 1 << 2, 1 << 4, 1 << 6);
+    for (Uint32 row = 0; row < 4; ++row)
     {
-        const Uint32 Idx = (Palette[i / 4u] >> ((i % 4u) * 2u)) & 0x03u;
+        const __m128i HiBit     = _mm_slli_epi32(LoBit, 1);
+        const __m128i IsLoClear = _mm_cmpeq_epi32(_mm_and_si128(AllIndices, LoBit), Zero);
+        const __m128i IsHiClear = _mm_cmpeq_epi32(_mm_and_si128(AllIndices, HiBit), Zero);
 
-        DstBuffer[i * DstChannels + 0] = (R[Idx] << 3u) & 0xFFu;
-        DstBuffer[i * DstChannels + 1] = (G[Idx] << 2u) & 0xFFu;
-        DstBuffer[i * DstChannels + 2] = (B[Idx] << 3u) & 0xFFu;
+        __m128i Row = Select(IsHiClear,
+                             Select(IsLoClear, Colors[0], Colors[1]),
+                             Select(IsLoClear, Colors[2], Colors[3]));
+        if (Alpha != nullptr)
+        {
+            Uint32 RowAlpha;
+            std::memcpy(&RowAlpha, Alpha + row * 4, sizeof(RowAlpha));
+            // Move alpha values to the most significant bytes of 32-bit lanes
+            __m128i A = _mm_cvtsi32_si128(static_cast<int>(RowAlpha));
+            A         = _mm_unpacklo_epi8(Zero, A);
+            A         = _mm_unpacklo_epi16(Zero, A);
+            Row       = _mm_or_si128(_mm_and_si128(Row, _mm_set1_epi32(0x00FFFFFF)), A);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Dst + row * DstStride), Row);
+
+        LoBit = _mm_slli_epi32(LoBit, 8);
     }
+#elif DILIGENT_NEON_SUPPORTED
+    const uint32x4_t Colors[] = {
+        vdupq_n_u32(Palette[0]),
+        vdupq_n_u32(Palette[1]),
+        vdupq_n_u32(Palette[2]),
+        vdupq_n_u32(Palette[3]),
+    };
+    const uint32x4_t AllIndices = vdupq_n_u32(Indices);
+
+    // Low index bits of the four pixels in the row
+    static constexpr Uint32 FirstRowLoBits[] = {1u << 0u, 1u << 2u, 1u << 4u, 1u << 6u};
+
+    uint32x4_t LoBit = vld1q_u32(FirstRowLoBits);
+    for (Uint32 row = 0; row < 4; ++row)
+    {
+        const uint32x4_t HiBit   = vshlq_n_u32(LoBit, 1);
+        const uint32x4_t IsLoSet = vtstq_u32(AllIndices, LoBit);
+
+        uint32x4_t Row = vbslq_u32(vtstq_u32(AllIndices, HiBit),
+                                   vbslq_u32(IsLoSet, Colors[3], Colors[2]),
+                                   vbslq_u32(IsLoSet, Colors[1], Colors[0]));
+        if (Alpha != nullptr)
+        {
+            Uint32 RowAlpha;
+            std::memcpy(&RowAlpha, Alpha + row * 4, sizeof(RowAlpha));
+            // Move alpha values to the most significant bytes of 32-bit lanes
+            const uint16x8_t A16 = vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(RowAlpha)));
+            const uint32x4_t A   = vshlq_n_u32(vmovl_u16(vget_low_u16(A16)), 24);
+            Row                  = vbslq_u32(vdupq_n_u32(0xFF000000u), A, Row);
+        }
+        vst1q_u8(Dst + row * DstStride, vreinterpretq_u8_u32(Row));
+
+        LoBit = vshlq_n_u32(LoBit, 8);
+    }
+#else
+    for (Uint32 row = 0; row < 4; ++row)
+    {
+        for (Uint32 col = 0; col < 4; ++col)
+        {
+            const Uint32 i     = row * 4 + col;
+            Uint32       Color = Palette[(Indices >> (i * 2u)) & 0x03u];
+            if (Alpha != nullptr)
+                Color = (Color & 0x00FFFFFFu) | (Uint32{Alpha[i]} << 24u);
+            std::memcpy(Dst + row * DstStride + col * 4, &Color, sizeof(Color));
+        }
+    }
+#endif
 }
 
-inline void DecompressAlphaBlock(const Uint8* Bits,
-                                 Uint8*       DstBuffer,
-                                 Uint32       DstChannels)
+// Computes the eight values of a BC3 alpha block or a BC4 block.
+// For signed blocks, the values are stored as two's complement bytes.
+void GetAlphaPalette(const Uint8* Bits, bool IsSigned, Uint8 Palette[8])
 {
-    Uint32 Alpha[8] = {Bits[0], Bits[1]};
-    if (Alpha[0] > Alpha[1])
+    if (!IsSigned)
     {
-        for (Uint32 i = 2; i < 8; ++i)
+        const Uint32 A0 = Bits[0];
+        const Uint32 A1 = Bits[1];
+
+        Palette[0] = static_cast<Uint8>(A0);
+        Palette[1] = static_cast<Uint8>(A1);
+        if (A0 > A1)
         {
-            Alpha[i] = ((8 - i) * Alpha[0] + (i - 1) * Alpha[1]) / 7;
+            for (Uint32 i = 1; i < 7; ++i)
+                Palette[i + 1] = static_cast<Uint8>(((7 - i) * A0 + i * A1 + 3) / 7);
+        }
+        else
+        {
+            for (Uint32 i = 1; i < 5; ++i)
+                Palette[i + 1] = static_cast<Uint8>(((5 - i) * A0 + i * A1 + 2) / 5);
+            Palette[6] = 0;
+            Palette[7] = 255;
         }
     }
     else
     {
-        for (Uint32 i = 2; i < 6; ++i)
+        // -128 is treated as -127
+        const int A0 = std::max(static_cast<int>(static_cast<Int8>(Bits[0])), -127);
+        const int A1 = std::max(static_cast<int>(static_cast<Int8>(Bits[1])), -127);
+
+        // Rounds the interpolated value to the nearest integer, half away from zero
+        auto Interpolate = [A0, A1](int W0, int W1, int Denom) {
+            const int Value = W0 * A0 + W1 * A1;
+            return static_cast<Uint8>(static_cast<Int8>((Value >= 0 ? Value + Denom / 2 : Value - Denom / 2) / Denom));
+        };
+
+        Palette[0] = static_cast<Uint8>(static_cast<Int8>(A0));
+        Palette[1] = static_cast<Uint8>(static_cast<Int8>(A1));
+        if (A0 > A1)
+        {
+            for (int i = 1; i < 7; ++i)
+                Palette[i + 1] = Interpolate(7 - i, i, 7);
+        }
+        else
         {
-            Alpha[i] = ((6 - i) * Alpha[0] + (i - 1) * Alpha[1]) / 5;
+            for (int i = 1; i < 5; ++i)
+                Palette[i + 1] = Interpolate(5 - i, i, 5);
+            Palette[6] = static_cast<Uint8>(static_cast<Int8>(-127));
+            Palette[7] = 127;
         }
-        Alpha[6] = 0;
-        Alpha[7] = 255;
     }
+}
+
+// Decompresses the 16 values of a BC3 alpha block or a BC4 block
+void DecompressAlphaBlock(const Uint8* Bits, bool IsSigned, Uint8 Values[16])
+{
+    alignas(16) Uint8 Palette[16] = {};
+    GetAlphaPalette(Bits, IsSigned, Palette);
+
+    Uint64 PackedIndices = 0;
+    for (Uint32 i = 0; i < 6; ++i)
+        PackedIndices |= Uint64{Bits[2 + i]} << (i * 8u);
+
+    alignas(16) Uint8 Indices[16];
+    for (Uint32 i = 0; i < 16; ++i)
+        Indices[i] = static_cast<Uint8>((PackedIndices >> (i * 3u)) & 0x07u);
+
+#if DILIGENT_SSSE3_ENABLED
+    const __m128i PaletteSSE = _mm_load_si128(reinterpret_cast<const __m128i*>(Palette));
+    const __m128i IndicesSSE = _mm_load_si128(reinterpret_cast<const __m128i*>(Indices));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(Values), _mm_shuffle_epi8(PaletteSSE, IndicesSSE));
+#elif DILIGENT_NEON_SUPPORTED
+    const uint8x8_t PaletteNEON = vld1_u8(Palette);
+    vst1q_u8(Values, vcombine_u8(vtbl1_u8(PaletteNEON, vld1_u8(Indices)),
+                                 vtbl1_u8(PaletteNEON, vld1_u8(Indices + 8))));
+#else
+    for (Uint32 i = 0; i < 16; ++i)
+        Values[i] = Palette[Indices[i]];
+#endif
+}
 
-    for (size_t p = 0; p < 2; ++p)
+// Writes 4x4 single-channel values
+void WriteBlockR8(const Uint8 R[16], Uint8* Dst, size_t DstStride)
+{
+    for (Uint32 row = 0; row < 4; ++row)
+        std::memcpy(Dst + row * DstStride, R + row * 4, 4);
+}
+
+// Interleaves 4x4 values of two channels
+void WriteBlockRG8(const Uint8 R[16], const Uint8 G[16], Uint8* Dst, size_t DstStride)
+{
+#if DILIGENT_SSE2_SUPPORTED
+    const __m128i RR = _mm_loadu_si128(reinterpret_cast<const __m128i*>(R));
+    const __m128i GG = _mm_loadu_si128(reinterpret_cast<const __m128i*>(G));
+    // Rows 0-1 and 2-3
+    const __m128i Lo = _mm_unpacklo_epi8(RR, GG);
+    const __m128i Hi = _mm_unpackhi_epi8(RR, GG);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(Dst + 0 * DstStride), Lo);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(Dst + 1 * DstStride), _mm_unpackhi_epi64(Lo, Lo));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(Dst + 2 * DstStride), Hi);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(Dst + 3 * DstStride), _mm_unpackhi_epi64(Hi, Hi));
+#elif DILIGENT_NEON_SUPPORTED
+    // Rows 0-1 and 2-3
+    const uint8x16x2_t RG = vzipq_u8(vld1q_u8(R), vld1q_u8(G));
+    vst1_u8(Dst + 0 * DstStride, vget_low_u8(RG.val[0]));
+    vst1_u8(Dst + 1 * DstStride, vget_high_u8(RG.val[0]));
+    vst1_u8(Dst + 2 * DstStride, vget_low_u8(RG.val[1]));
+    vst1_u8(Dst + 3 * DstStride, vget_high_u8(RG.val[1]));
+#else
+    for (Uint32 row = 0; row < 4; ++row)
     {
-        const Uint8* PaletteBits = Bits + 2 + p * 3;
-        const Uint32 Palette0    = Uint32{PaletteBits[0]} | (Uint32{PaletteBits[1]} << 8) | (Uint32{PaletteBits[2]} << 16);
-        for (Uint32 i = 0; i < 8; ++i)
+        for (Uint32 col = 0; col < 4; ++col)
         {
-            Uint32 Idx = (Palette0 >> (i * 3)) & 0x07;
-
-            DstBuffer[(p * 8 + i) * DstChannels] = Alpha[Idx] & 0xFFu;
+            Dst[row * DstStride + col * 2 + 0] = R[row * 4 + col];
+            Dst[row * DstStride + col * 2 + 1] = G[row * 4 + col];
         }
     }
+#endif
+}
+
+// Block decompression functions that write 4x4 pixels of the format
+// returned by GetBCDecompressedFormat with the given row stride.
+
+void DecompressBC1RGBA8(const Uint8* Bits, Uint8* Dst, size_t DstStride)
+{
+    DecompressColorBlock(Bits, /*AllowThreeColorMode = */ true, nullptr, Dst, DstStride);
+}
+
+void DecompressBC2RGBA8(const Uint8* Bits, Uint8* Dst, size_t DstStride)
+{
+    Uint8 Alpha[16];
+    for (Uint32 i = 0; i < 16; ++i)
+        Alpha[i] = static_cast<Uint8>(((Bits[i / 2] >> ((i % 2) * 4u)) & 0x0Fu) * 17u);
+    DecompressColorBlock(Bits + 8, /*AllowThreeColorMode = */ false, Alpha, Dst, DstStride);
+}
+
+void DecompressBC3RGBA8(const Uint8* Bits, Uint8* Dst, size_t DstStride)
+{
+    Uint8 Alpha[16];
+    DecompressAlphaBlock(Bits, /*IsSigned = */ false, Alpha);
+    DecompressColorBlock(Bits + 8, /*AllowThreeColorMode = */ false, Alpha, Dst, DstStride);
+}
+
+template <bool IsSigned>
+void DecompressBC4R8(const Uint8* Bits, Uint8* Dst, size_t DstStride)
+{
+    Uint8 R[16];
+    DecompressAlphaBlock(Bits, IsSigned, R);
+    WriteBlockR8(R, Dst, DstStride);
+}
+
+template <bool IsSigned>
+void DecompressBC5RG8(const Uint8* Bits, Uint8* Dst, size_t DstStride)
+{
+    Uint8 R[16];
+    Uint8 G[16];
+    DecompressAlphaBlock(Bits, IsSigned, R);
+    DecompressAlphaBlock(Bits + 8, IsSigned, G);
+    WriteBlockRG8(R, G, Dst, DstStride);
+}
+
+template <bool IsSigned>
+void DecompressBC6HRGBA16F(const Uint8* Bits, Uint8* Dst, size_t DstStride)
+{
+    Uint16 Pixels[16 * 4];
+    DecompressBC6HBlockHalf(Bits, Pixels, 4, IsSigned);
+    for (Uint32 row = 0; row < 4; ++row)
+        std::memcpy(Dst + row * DstStride, Pixels + row * 16, 16 * sizeof(Uint16));
+}
+
+void DecompressBC7RGBA8(const Uint8* Bits, Uint8* Dst, size_t DstStride)
+{
+    Uint8 Pixels[16 * 4];
+    DecompressBC7Block(Bits, Pixels);
+    for (Uint32 row = 0; row < 4; ++row)
+        std::memcpy(Dst + row * DstStride, Pixels + row * 16, 16);
+}
+
+using DecompressBlockFuncType = void (*)(const Uint8* Bits, Uint8* Dst, size_t DstStride);
+
+DecompressBlockFuncType GetDecompressBlockFunc(TEXTURE_FORMAT Format)
+{
+    switch (Format)
+    {
+        case TEX_FORMAT_BC1_TYPELESS:
+        case TEX_FORMAT_BC1_UNORM:
+        case TEX_FORMAT_BC1_UNORM_SRGB:
+            return DecompressBC1RGBA8;
+
+        case TEX_FORMAT_BC2_TYPELESS:
+        case TEX_FORMAT_BC2_UNORM:
+        case TEX_FORMAT_BC2_UNORM_SRGB:
+            return DecompressBC2RGBA8;
+
+        case TEX_FORMAT_BC3_TYPELESS:
+        case TEX_FORMAT_BC3_UNORM:
+        case TEX_FORMAT_BC3_UNORM_SRGB:
+            return DecompressBC3RGBA8;
+
+        case TEX_FORMAT_BC4_TYPELESS:
+        case TEX_FORMAT_BC4_UNORM:
+            return DecompressBC4R8<false>;
+
+        case TEX_FORMAT_BC4_SNORM:
+            return DecompressBC4R8<true>;
+
+        case TEX_FORMAT_BC5_TYPELESS:
+        case TEX_FORMAT_BC5_UNORM:
+            return DecompressBC5RG8<false>;
+
+        case TEX_FORMAT_BC5_SNORM:
+            return DecompressBC5RG8<true>;
+
+        case TEX_FORMAT_BC6H_TYPELESS:
+        case TEX_FORMAT_BC6H_UF16:
+            return DecompressBC6HRGBA16F<false>;
+
+        case TEX_FORMAT_BC6H_SF16:
+            return DecompressBC6HRGBA16F<true>;
+
+        case TEX_FORMAT_BC7_TYPELESS:
+        case TEX_FORMAT_BC7_UNORM:
+        case TEX_FORMAT_BC7_UNORM_SRGB:
+            return DecompressBC7RGBA8;
+
+        default:
+            return nullptr;
+    }
 }
 
+} // namespace
+
 void DecompressBC1Block(const Uint8* Bits,
                         Uint8*       DstBuffer,
                         Uint32       DstChannels)
 {
-    VERIFY_EXPR(DstChannels >= 3);
-    DecompressColorBlock(Bits, DstBuffer, DstChannels);
+    VERIFY_EXPR(DstChannels == 3 || DstChannels == 4);
+    if (DstChannels == 4)
+    {
+        DecompressBC1RGBA8(Bits, DstBuffer, 16);
+        return;
+    }
+
+    Uint8 RGBA[16 * 4];
+    DecompressBC1RGBA8(Bits, RGBA, 16);
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        for (Uint32 c = 0; c < DstChannels; ++c)
+            DstBuffer[i * DstChannels + c] = RGBA[i * 4 + c];
+    }
+}
+
+void DecompressBC2Block(const Uint8* Bits,
+                        Uint8*       DstBuffer)
+{
+    DecompressBC2RGBA8(Bits, DstBuffer, 16);
 }
 
 void DecompressBC3Block(const Uint8* Bits,
                         Uint8*       DstBuffer)
 {
-    DecompressColorBlock(Bits + 8, DstBuffer, 4);
-    DecompressAlphaBlock(Bits, DstBuffer + 3, 4);
+    DecompressBC3RGBA8(Bits, DstBuffer, 16);
 }
 
 void DecompressBC4Block(const Uint8* Bits,
@@ -136,16 +452,132 @@ void DecompressBC4Block(const Uint8* Bits,
                         Uint32       DstChannels)
 {
     VERIFY_EXPR(DstChannels >= 1);
-    DecompressAlphaBlock(Bits, DstBuffer, DstChannels);
+    Uint8 R[16];
+    DecompressAlphaBlock(Bits, /*IsSigned = */ false, R);
+    for (Uint32 i = 0; i < 16; ++i)
+        DstBuffer[i * DstChannels] = R[i];
 }
 
-void DecompressBC5lock(const Uint8* Bits,
-                       Uint8*       DstBuffer,
-                       Uint32       DstChannels)
+void DecompressBC5Block(const Uint8* Bits,
+                        Uint8*       DstBuffer,
+                        Uint32       DstChannels)
 {
     VERIFY_EXPR(DstChannels >= 2);
-    DecompressAlphaBlock(Bits, DstBuffer, DstChannels);
-    DecompressAlphaBlock(Bits + 8, DstBuffer + 1, DstChannels);
+    Uint8 R[16];
+    Uint8 G[16];
+    DecompressAlphaBlock(Bits, /*IsSigned = */ false, R);
+    DecompressAlphaBlock(Bits + 8, /*IsSigned = */ false, G);
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        DstBuffer[i * DstChannels + 0] = R[i];
+        DstBuffer[i * DstChannels + 1] = G[i];
+    }
+}
+
+TEXTURE_FORMAT GetBCDecompressedFormat(TEXTURE_FORMAT Format)
+{
+    switch (Format)
+    {
+        case TEX_FORMAT_BC1_TYPELESS:
+        case TEX_FORMAT_BC1_UNORM:
+        case TEX_FORMAT_BC2_TYPELESS:
+        case TEX_FORMAT_BC2_UNORM:
+        case TEX_FORMAT_BC3_TYPELESS:
+        case TEX_FORMAT_BC3_UNORM:
+        case TEX_FORMAT_BC7_TYPELESS:
+        case TEX_FORMAT_BC7_UNORM:
+            return TEX_FORMAT_RGBA8_UNORM;
+
+        case TEX_FORMAT_BC1_UNORM_SRGB:
+        case TEX_FORMAT_BC2_UNORM_SRGB:
+        case TEX_FORMAT_BC3_UNORM_SRGB:
+        case TEX_FORMAT_BC7_UNORM_SRGB:
+            return TEX_FORMAT_RGBA8_UNORM_SRGB;
+
+        case TEX_FORMAT_BC4_TYPELESS:
+        case TEX_FORMAT_BC4_UNORM:
+            return TEX_FORMAT_R8_UNORM;
+
+        case TEX_FORMAT_BC4_SNORM:
+            return TEX_FORMAT_R8_SNORM;
+
+        case TEX_FORMAT_BC5_TYPELESS:
+        case TEX_FORMAT_BC5_UNORM:
+            return TEX_FORMAT_RG8_UNORM;
+
+        case TEX_FORMAT_BC5_SNORM:
+            return TEX_FORMAT_RG8_SNORM;
+
+        case TEX_FORMAT_BC6H_TYPELESS:
+        case TEX_FORMAT_BC6H_UF16:
+        case TEX_FORMAT_BC6H_SF16:
+            return TEX_FORMAT_RGBA16_FLOAT;
+
+        default:
+            return TEX_FORMAT_UNKNOWN;
+    }
+}
+
+Bool DecompressBCSurface(const DecompressBCSurfaceAttribs& Attribs)
+{
+    const DecompressBlockFuncType DecompressBlock = GetDecompressBlockFunc(Attribs.Format);
+    if (DecompressBlock == nullptr)
+        return false;
+
+    const TextureFormatAttribs& SrcFmtAttribs = GetTextureFormatAttribs(Attribs.Format);
+    const TextureFormatAttribs& DstFmtAttribs = GetTextureFormatAttribs(GetBCDecompressedFormat(Attribs.Format));
+
+    const Uint32 BlockSize      = SrcFmtAttribs.ComponentSize;
+    const Uint32 DstPixelSize   = DstFmtAttribs.GetElementSize();
+    const Uint32 NumBlocksInRow = (Attribs.Width + 3) / 4;
+    const Uint32 NumBlockRows   = (Attribs.Height + 3) / 4;
+    if (NumBlocksInRow == 0 || NumBlockRows == 0)
+        return true;
+
+    DEV_CHECK_ERR(Attribs.pSrcData != nullptr, "Source data must not be null");
+    DEV_CHECK_ERR(Attribs.pDstData != nullptr, "Destination data must not be null");
+    DEV_CHECK_ERR(Attribs.SrcStride >= Uint64{NumBlocksInRow} * BlockSize, "Source stride (", Attribs.SrcStride, ") is too small");
+    DEV_CHECK_ERR(Attribs.DstStride >= Uint64{Attribs.Width} * DstPixelSize, "Destination stride (", Attribs.DstStride, ") is too small");
+
+    const Uint8* const pSrc      = static_cast<const Uint8*>(Attribs.pSrcData);
+    Uint8* const       pDst      = static_cast<Uint8*>(Attribs.pDstData);
+    const size_t       SrcStride = static_cast<size_t>(Attribs.SrcStride);
+    const size_t       DstStride = static_cast<size_t>(Attribs.DstStride);
+
+    auto DecompressBlockRows = [&](Uint32 StartRow, Uint32 EndRow) {
+        for (Uint32 by = StartRow; by < EndRow; ++by)
+        {
+            const Uint8* pSrcRow     = pSrc + by * SrcStride;
+            Uint8*       pDstRow     = pDst + by * 4 * DstStride;
+            const Uint32 RowsInBlock = std::min(Attribs.Height - by * 4, 4u);
+            for (Uint32 bx = 0; bx < NumBlocksInRow; ++bx)
+            {
+                const Uint8* pSrcBlock   = pSrcRow + bx * BlockSize;
+                Uint8*       pDstBlock   = pDstRow + bx * 4 * DstPixelSize;
+                const Uint32 ColsInBlock = std::min(Attribs.Width - bx * 4, 4u);
+                if (RowsInBlock == 4 && ColsInBlock == 4)
+                {
+                    DecompressBlock(pSrcBlock, pDstBlock, DstStride);
+                }
+                else
+                {
+                    // Partial block at the right or bottom edge of the surface
+                    Uint8        Pixels[4 * 4 * 8];
+                    const size_t PixelsStride = 4 * DstPixelSize;
+                    VERIFY_EXPR(PixelsStride * 4 <= sizeof(Pixels));
+                    DecompressBlock(pSrcBlock, Pixels, PixelsStride);
+                    for (Uint32 row = 0; row < RowsInBlock; ++row)
+                        std::memcpy(pDstBlock + row * DstStride, Pixels + row * PixelsStride, ColsInBlock * DstPixelSize);
+                }
+            }
+        }
+    };
+
+    // Make sure that every task decompresses enough blocks to amortize the scheduling overhead
+    constexpr Uint32 MinBlocksPerTask = 4096;
+    ProcessRangeInParallel(Attribs.pThreadPool, NumBlockRows, MinBlocksPerTask / NumBlocksInRow, DecompressBlockRows);
+
+    return true;
 }
 
 } // namespace Diligent
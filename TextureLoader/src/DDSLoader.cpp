@@ -49,6 +49,7 @@
 
 #include "TextureLoaderImpl.hpp"
 #include "BasicFileStream.hpp"
+#include "DataBlobImpl.hpp"
 #include "GraphicsAccessories.hpp"
 
 #include "dxgiformat.h"
@@ -830,58 +831,80 @@ static DXGI_FORMAT GetDXGIFormat(const DDS_PIXELFORMAT& ddpf)
 // clang-format on
 
 //--------------------------------------------------------------------------------------
-static void FillInitData(
-    _In_ Uint32      width,
-    _In_ Uint32      height,
-    _In_ Uint32      depth,
-    _In_ Uint32      srcMipCount,
-    _In_ Uint32      dstMipCount,
-    _In_ Uint32      arraySize,
-    _In_ DXGI_FORMAT format,
-    _In_ size_t      bitSize,
-    _In_ const Uint8* bitData,
-    _Out_ TextureSubResData* initData)
+struct DDSSurface
 {
-    VERIFY_EXPR(bitData != nullptr && initData != nullptr);
+    // Offset of the surface from the start of the surface data
+    size_t Offset      = 0;
+    size_t Size        = 0;
+    Uint32 Stride      = 0;
+    Uint32 DepthStride = 0;
+};
 
-    const Uint8* pSrcBits = bitData;
-    const Uint8* pEndBits = bitData + bitSize;
+struct DDSFileInfo
+{
+    DXGI_FORMAT Format      = DXGI_FORMAT_UNKNOWN;
+    Uint32      Width       = 0;
+    Uint32      Height      = 0;
+    Uint32      Depth       = 1;
+    Uint32      SrcMipCount = 1;
+    Uint32      ArraySize   = 1;
+
+    // Offset of the surface data from the start of the file
+    size_t DataOffset = 0;
+};
 
-    size_t index = 0;
-    for (size_t slice = 0; slice < arraySize; slice++)
+//--------------------------------------------------------------------------------------
+// Returns the surfaces of mip levels [firstMip, firstMip + mipCount) of every array slice.
+// The surfaces are arranged by array slices first, in the same order as the texture subresources.
+static std::vector<DDSSurface> GetDDSSurfaces(
+    _In_ const DDSFileInfo& info,
+    _In_ Uint32             firstMip,
+    _In_ Uint32             mipCount,
+    _In_ size_t             bitSize)
+{
+    VERIFY_EXPR(firstMip + mipCount <= info.SrcMipCount);
+
+    std::vector<DDSSurface> surfaces;
+    surfaces.reserve(size_t{info.ArraySize} * size_t{mipCount});
+
+    size_t offset = 0;
+    for (size_t slice = 0; slice < info.ArraySize; slice++)
     {
-        for (size_t mip = 0; mip < srcMipCount; mip++)
+        for (Uint32 mip = 0; mip < info.SrcMipCount; mip++)
         {
-            const Uint32 w = std::max(width >> mip, 1u);
-            const Uint32 h = std::max(height >> mip, 1u);
-            const Uint32 d = std::max(depth >> mip, 1u);
+            const Uint32 w = std::max(info.Width >> mip, 1u);
+            const Uint32 h = std::max(info.Height >> mip, 1u);
+            const Uint32 d = std::max(info.Depth >> mip, 1u);
 
             size_t NumBytes = 0;
             size_t RowBytes = 0;
             size_t NumRows  = 0;
-            GetSurfaceInfo(w, h, format, &NumBytes, &RowBytes, &NumRows);
+            GetSurfaceInfo(w, h, info.Format, &NumBytes, &RowBytes, &NumRows);
 
-            if (mip < dstMipCount)
+            if (mip >= firstMip && mip < firstMip + mipCount)
             {
-                VERIFY_EXPR(index < size_t{dstMipCount} * size_t{arraySize});
-                initData[index].pData       = reinterpret_cast<const void*>(pSrcBits);
-                initData[index].Stride      = static_cast<Uint32>(RowBytes);
-                initData[index].DepthStride = static_cast<Uint32>(NumBytes);
-                ++index;
+                DDSSurface surface;
+                surface.Offset      = offset;
+                surface.Size        = NumBytes * d;
+                surface.Stride      = static_cast<Uint32>(RowBytes);
+                surface.DepthStride = static_cast<Uint32>(NumBytes);
+                surfaces.push_back(surface);
             }
 
-            pSrcBits += NumBytes * d;
-            if (pSrcBits > pEndBits)
+            offset += NumBytes * d;
+            if (offset > bitSize)
             {
                 LOG_ERROR_AND_THROW("Out of bounds");
             }
         }
     }
 
-    if (!index)
+    if (surfaces.empty())
     {
         LOG_ERROR_AND_THROW("Unknown error");
     }
+
+    return surfaces;
 }
 
 
@@ -926,9 +949,10 @@ static D2D1_ALPHA_MODE GetAlphaMode(_In_ const DDS_HEADER* header)
 namespace Diligent
 {
 
-void TextureLoaderImpl::LoadFromDDS(const TextureLoadInfo& TexLoadInfo, const Uint8* pData, size_t DataSize)
+// Reads the DDS header and initializes the description of the texture with all mip levels
+static DDSFileInfo ReadDDSHeader(const Uint8* pData, size_t DataSize, TextureDesc& TexDesc)
 {
-    // Validate DDS file in memory
+    // Validate DDS header
     if (DataSize < (sizeof(Uint32) + sizeof(DDS_HEADER)))
     {
         LOG_ERROR_AND_THROW("DDS data size (", DataSize, ") is too small");
@@ -963,8 +987,8 @@ void TextureLoaderImpl::LoadFromDDS(const TextureLoadInfo& TexLoadInfo, const Ui
         bDXT10Header = true;
     }
 
-    m_TexDesc.Width  = header->width;
-    m_TexDesc.Height = header->height;
+    TexDesc.Width  = header->width;
+    TexDesc.Height = header->height;
     Uint32 Depth     = header->depth;
     Uint32 ArraySize = 1;
 
@@ -975,9 +999,7 @@ void TextureLoaderImpl::LoadFromDDS(const TextureLoadInfo& TexLoadInfo, const Ui
     DXGI_FORMAT dxgiFormat  = DXGI_FORMAT_UNKNOWN;
 
     const Uint32 SrcMipCount = std::max(header->mipMapCount, 1u);
-    m_TexDesc.MipLevels      = SrcMipCount;
-    if (TexLoadInfo.MipLevels > 0)
-        m_TexDesc.MipLevels = std::min(m_TexDesc.MipLevels, TexLoadInfo.MipLevels);
+    TexDesc.MipLevels        = SrcMipCount;
 
     if ((header->ddspf.flags & DDS_FOURCC) &&
         (MAKEFOURCC('D', 'X', '1', '0') == header->ddspf.fourCC))
@@ -1002,9 +1024,9 @@ void TextureLoaderImpl::LoadFromDDS(const TextureLoadInfo& TexLoadInfo, const Ui
             case D3D11_RESOURCE_DIMENSION_TEXTURE1D:
             {
                 // D3DX writes 1D textures with a fixed Height of 1
-                if ((header->flags & DDS_HEIGHT) && m_TexDesc.Height != 1)
+                if ((header->flags & DDS_HEIGHT) && TexDesc.Height != 1)
                 {
-                    LOG_ERROR_AND_THROW("Unexpected height (", m_TexDesc.Height, ") for texture 1D");
+                    LOG_ERROR_AND_THROW("Unexpected height (", TexDesc.Height, ") for texture 1D");
                 }
             }
             break;
@@ -1067,64 +1089,132 @@ void TextureLoaderImpl::LoadFromDDS(const TextureLoadInfo& TexLoadInfo, const Ui
     }
 
     // Bound sizes (for security purposes we don't trust DDS file metadata larger than the D3D 11.x hardware requirements)
-    if (m_TexDesc.MipLevels > D3D11_REQ_MIP_LEVELS)
+    if (TexDesc.MipLevels > D3D11_REQ_MIP_LEVELS)
     {
-        LOG_ERROR_AND_THROW("Too many mip levels specified (", m_TexDesc.MipLevels, ")");
+        LOG_ERROR_AND_THROW("Too many mip levels specified (", TexDesc.MipLevels, ")");
     }
 
     switch (d3d11ResDim)
     {
         case D3D11_RESOURCE_DIMENSION_TEXTURE1D:
         {
-            m_TexDesc.ArraySize = ArraySize; // ArraySize is aliased with Depth
-            if ((m_TexDesc.ArraySize > D3D11_REQ_TEXTURE1D_ARRAY_AXIS_DIMENSION) ||
-                (m_TexDesc.Width > D3D11_REQ_TEXTURE1D_U_DIMENSION))
+            TexDesc.ArraySize = ArraySize; // ArraySize is aliased with Depth
+            if ((TexDesc.ArraySize > D3D11_REQ_TEXTURE1D_ARRAY_AXIS_DIMENSION) ||
+                (TexDesc.Width > D3D11_REQ_TEXTURE1D_U_DIMENSION))
             {
                 LOG_ERROR_AND_THROW("Texture1D dimensions are out of bounds");
             }
 
-            m_TexDesc.Height = 1;
-            m_TexDesc.Type   = m_TexDesc.ArraySize > 1 ? RESOURCE_DIM_TEX_1D_ARRAY : RESOURCE_DIM_TEX_1D;
+            TexDesc.Height = 1;
+            TexDesc.Type   = TexDesc.ArraySize > 1 ? RESOURCE_DIM_TEX_1D_ARRAY : RESOURCE_DIM_TEX_1D;
         }
         break;
 
         case D3D11_RESOURCE_DIMENSION_TEXTURE2D:
         {
-            m_TexDesc.ArraySize = ArraySize; // ArraySize is aliased with Depth
-            if ((m_TexDesc.ArraySize > D3D11_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION) ||
-                (m_TexDesc.Width > D3D11_REQ_TEXTURECUBE_DIMENSION) ||
-                (m_TexDesc.Height > D3D11_REQ_TEXTURECUBE_DIMENSION))
+            TexDesc.ArraySize = ArraySize; // ArraySize is aliased with Depth
+            if ((TexDesc.ArraySize > D3D11_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION) ||
+                (TexDesc.Width > D3D11_REQ_TEXTURECUBE_DIMENSION) ||
+                (TexDesc.Height > D3D11_REQ_TEXTURECUBE_DIMENSION))
             {
                 LOG_ERROR_AND_THROW((IsCubeMap ? "TextureCube" : "Texture2D"), " dimensions are out of bounds");
             }
 
-            m_TexDesc.Type = IsCubeMap ?
-                (m_TexDesc.ArraySize > 6 ? RESOURCE_DIM_TEX_CUBE_ARRAY : RESOURCE_DIM_TEX_CUBE) :
-                (m_TexDesc.ArraySize > 1 ? RESOURCE_DIM_TEX_2D_ARRAY : RESOURCE_DIM_TEX_2D);
+            TexDesc.Type = IsCubeMap ?
+                (TexDesc.ArraySize > 6 ? RESOURCE_DIM_TEX_CUBE_ARRAY : RESOURCE_DIM_TEX_CUBE) :
+                (TexDesc.ArraySize > 1 ? RESOURCE_DIM_TEX_2D_ARRAY : RESOURCE_DIM_TEX_2D);
         }
         break;
 
         case D3D11_RESOURCE_DIMENSION_TEXTURE3D:
         {
-            m_TexDesc.Depth = Depth; // Depth is aliased with ArraySize
-            if ((m_TexDesc.Width > D3D11_REQ_TEXTURE3D_U_V_OR_W_DIMENSION) ||
-                (m_TexDesc.Height > D3D11_REQ_TEXTURE3D_U_V_OR_W_DIMENSION) ||
-                (m_TexDesc.Depth > D3D11_REQ_TEXTURE3D_U_V_OR_W_DIMENSION))
+            TexDesc.Depth = Depth; // Depth is aliased with ArraySize
+            if ((TexDesc.Width > D3D11_REQ_TEXTURE3D_U_V_OR_W_DIMENSION) ||
+                (TexDesc.Height > D3D11_REQ_TEXTURE3D_U_V_OR_W_DIMENSION) ||
+                (TexDesc.Depth > D3D11_REQ_TEXTURE3D_U_V_OR_W_DIMENSION))
             {
                 LOG_ERROR_AND_THROW("Texture3D dimensions are out of bounds");
             }
 
-            m_TexDesc.Type = RESOURCE_DIM_TEX_3D;
+            TexDesc.Type = RESOURCE_DIM_TEX_3D;
         }
         break;
     }
-    m_TexDesc.Format = DXGIFormatToTexFormat(dxgiFormat);
+    TexDesc.Format = DXGIFormatToTexFormat(dxgiFormat);
+
+    DDSFileInfo Info;
+    Info.Format      = dxgiFormat;
+    Info.Width       = TexDesc.Width;
+    Info.Height      = TexDesc.Height;
+    Info.Depth       = std::max(Depth, 1u);
+    Info.SrcMipCount = SrcMipCount;
+    Info.ArraySize   = ArraySize;
+    Info.DataOffset  = static_cast<size_t>(SubResDataOffset);
+    return Info;
+}
+
+void TextureLoaderImpl::LoadFromDDS(const TextureLoadInfo& TexLoadInfo, const Uint8* pData, size_t DataSize)
+{
+    const DDSFileInfo Info     = ReadDDSHeader(pData, DataSize, m_TexDesc);
+    const Uint32      FirstMip = SelectMipRange(m_TexDesc, TexLoadInfo);
 
-    m_SubResources.resize(size_t{ArraySize} * size_t{m_TexDesc.MipLevels});
-    FillInitData(m_TexDesc.Width, m_TexDesc.Height, Depth, SrcMipCount, m_TexDesc.MipLevels, ArraySize, dxgiFormat,
-                 DataSize - SubResDataOffset, pData + SubResDataOffset, m_SubResources.data());
+    const std::vector<DDSSurface> Surfaces = GetDDSSurfaces(Info, FirstMip, m_TexDesc.MipLevels, DataSize - Info.DataOffset);
+
+    m_SubResources.resize(Surfaces.size());
+    for (size_t i = 0; i < Surfaces.size(); ++i)
+    {
+        const DDSSurface& Surface = Surfaces[i];
+        m_SubResources[i]         = TextureSubResData{pData + Info.DataOffset + Surface.Offset, Surface.Stride, Surface.DepthStride};
+    }
 }
 
+void TextureLoaderImpl::LoadFromDDS(const TextureLoadInfo& TexLoadInfo, IFileStream* pFileStream)
+{
+    VERIFY_EXPR(pFileStream != nullptr);
+
+    const size_t FileSize = pFileStream->GetSize();
+
+    Uint8        HeaderData[sizeof(Uint32) + sizeof(DDS_HEADER) + sizeof(DDS_HEADER_DXT10)] = {};
+    const size_t HeaderDataSize = std::min(FileSize, sizeof(HeaderData));
+    if (!pFileStream->SetPos(0, static_cast<int>(FilePosOrigin::Start)) || !pFileStream->Read(HeaderData, HeaderDataSize))
+    {
+        LOG_ERROR_AND_THROW("Failed to read DDS header");
+    }
+
+    const DDSFileInfo Info     = ReadDDSHeader(HeaderData, HeaderDataSize, m_TexDesc);
+    const Uint32      FirstMip = SelectMipRange(m_TexDesc, TexLoadInfo);
+
+    const std::vector<DDSSurface> Surfaces = GetDDSSurfaces(Info, FirstMip, m_TexDesc.MipLevels, FileSize - Info.DataOffset);
+
+    size_t TotalSize = 0;
+    for (const DDSSurface& Surface : Surfaces)
+        TotalSize += Surface.Size;
+
+    m_pDataBlob = DataBlobImpl::Create(TexLoadInfo.pAllocator, TotalSize);
+    m_SubResources.resize(Surfaces.size());
+
+    // The requested mip levels of one array slice are stored contiguously,
+    // so read them with a single request and skip the rest of the slice.
+    Uint8* pDstData = m_pDataBlob->GetDataPtr<Uint8>();
+    for (size_t FirstSurf = 0; FirstSurf < Surfaces.size(); FirstSurf += m_TexDesc.MipLevels)
+    {
+        const DDSSurface& First     = Surfaces[FirstSurf];
+        const DDSSurface& Last      = Surfaces[FirstSurf + m_TexDesc.MipLevels - 1];
+        const size_t      SliceSize = Last.Offset + Last.Size - First.Offset;
+        if (!pFileStream->SetPos(Info.DataOffset + First.Offset, static_cast<int>(FilePosOrigin::Start)) ||
+            !pFileStream->Read(pDstData, SliceSize))
+        {
+            LOG_ERROR_AND_THROW("Failed to read DDS surface data");
+        }
+
+        for (size_t i = FirstSurf; i < FirstSurf + m_TexDesc.MipLevels; ++i)
+        {
+            const DDSSurface& Surface = Surfaces[i];
+            m_SubResources[i]         = TextureSubResData{pDstData + (Surface.Offset - First.Offset), Surface.Stride, Surface.DepthStride};
+        }
+        pDstData += SliceSize;
+    }
+}
 
 bool WriteDDSToStream(IFileStream*       pFileStream,
                       const TextureDesc& Desc,
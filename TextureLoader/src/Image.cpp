@@ -46,6 +46,7 @@
 #include "Align.hpp"
 #include "GraphicsAccessories.hpp"
 #include "BasicFileStream.hpp"
+#include "MemoryFileStream.hpp"
 #include "StringTools.hpp"
 #include "TextureUtilities.h"
 
@@ -152,7 +153,7 @@ private:
     IDataBlob*  m_pDstBlob = nullptr;
 };
 
-void Image::LoadTiffFile(const void* pData, size_t Size, IDataBlob* pDstPixels, ImageDesc& Desc)
+void Image::LoadTiffFile(const void* pData, size_t Size, IDataBlob* pDstPixels, ImageDesc& Desc, ImageRowHandlerType RowHandler, void* pUserData)
 {
     TIFFClientOpenWrapper TiffClientOpenWrpr{pData, Size};
 
@@ -230,31 +231,47 @@ void Image::LoadTiffFile(const void* pData, size_t Size, IDataBlob* pDstPixels,
             LOG_ERROR_AND_THROW("Unknown sample format: ", Uint32{SampleFormat});
     }
 
-    if (pDstPixels != nullptr)
+    bool Aborted = false;
+    if (pDstPixels != nullptr || RowHandler != nullptr)
     {
         size_t ScanlineSize = TIFFScanlineSize(TiffFile);
-        Desc.RowStride      = AlignUp(Desc.Width * Desc.NumComponents * (BitsPerSample / 8), 4u);
-        pDstPixels->Resize(size_t{Desc.Height} * size_t{Desc.RowStride});
+        Desc.RowStride      = Desc.Width * Desc.NumComponents * (BitsPerSample / 8);
+
+        // When the rows are passed to the handler, only one row is kept in memory
+        std::vector<Uint8> RowData;
+        if (RowHandler != nullptr)
+        {
+            RowData.resize(std::max(size_t{Desc.RowStride}, ScanlineSize));
+        }
+        else
+        {
+            Desc.RowStride = AlignUp(Desc.RowStride, 4u);
+            pDstPixels->Resize(size_t{Desc.Height} * size_t{Desc.RowStride});
+        }
+        auto GetDstRow = [&](Uint32 row) {
+            return RowHandler != nullptr ? RowData.data() : pDstPixels->GetDataPtr<Uint8>() + size_t{Desc.RowStride} * row;
+        };
 
         Uint16 PlanarConfig = 0;
         TIFFGetField(TiffFile, TIFFTAG_PLANARCONFIG, &PlanarConfig);
         if (PlanarConfig == PLANARCONFIG_CONTIG || Desc.NumComponents == 1)
         {
-            VERIFY_EXPR(Desc.RowStride >= ScanlineSize);
-            Uint8* pDataPtr = pDstPixels->GetDataPtr<Uint8>();
-            for (Uint32 row = 0; row < Desc.Height; row++, pDataPtr += Desc.RowStride)
+            VERIFY_EXPR(RowHandler != nullptr || Desc.RowStride >= ScanlineSize);
+            for (Uint32 row = 0; row < Desc.Height && !Aborted; row++)
             {
-                TIFFReadScanline(TiffFile, pDataPtr, row);
+                TIFFReadScanline(TiffFile, GetDstRow(row), row);
+                if (RowHandler != nullptr)
+                    Aborted = !RowHandler(pUserData, row, RowData.data());
             }
         }
         else if (PlanarConfig == PLANARCONFIG_SEPARATE)
         {
             std::vector<Uint8> ScanlineData(ScanlineSize);
-            for (Uint32 row = 0; row < Desc.Height; ++row)
+            for (Uint32 row = 0; row < Desc.Height && !Aborted; ++row)
             {
                 for (Uint16 comp = 0; comp < Desc.NumComponents; ++comp)
                 {
-                    Uint8* const pDstRow = pDstPixels->GetDataPtr<Uint8>() + Desc.RowStride * row + comp;
+                    Uint8* const pDstRow = GetDstRow(row) + comp * (BitsPerSample / 8);
 
                     TIFFReadScanline(TiffFile, ScanlineData.data(), row, comp);
 
@@ -283,6 +300,9 @@ void Image::LoadTiffFile(const void* pData, size_t Size, IDataBlob* pDstPixels,
                             UNEXPECTED("Unexpected component bit depth (", BitsPerSample, ").");
                     }
                 }
+
+                if (RowHandler != nullptr)
+                    Aborted = !RowHandler(pUserData, row, RowData.data());
             }
         }
         else
@@ -292,6 +312,9 @@ void Image::LoadTiffFile(const void* pData, size_t Size, IDataBlob* pDstPixels,
     }
 
     TIFFClose(TiffFile);
+
+    if (Aborted)
+        LOG_ERROR_AND_THROW("TIFF decoding was aborted by the row handler");
 }
 
 
@@ -440,6 +463,63 @@ ImageDesc Image::GetDesc(IMAGE_FILE_FORMAT FileFormat, const void* pSrcData, siz
     return Desc;
 }
 
+bool Image::IsRowDecodingSupported(IMAGE_FILE_FORMAT Format)
+{
+    return (Format == IMAGE_FILE_FORMAT_PNG ||
+            Format == IMAGE_FILE_FORMAT_JPEG ||
+            Format == IMAGE_FILE_FORMAT_TIFF);
+}
+
+bool Image::DecodeRows(IMAGE_FILE_FORMAT   FileFormat,
+                       const void*         pSrcData,
+                       size_t              SrcDataSize,
+                       ImageRowHandlerType RowHandler,
+                       void*               pUserData,
+                       ImageDesc&          Desc)
+{
+    DEV_CHECK_ERR(RowHandler != nullptr, "Row handler must not be null");
+
+    bool Result = false;
+    switch (FileFormat)
+    {
+        case IMAGE_FILE_FORMAT_TIFF:
+            try
+            {
+                LoadTiffFile(pSrcData, SrcDataSize, nullptr, Desc, RowHandler, pUserData);
+                Result = true;
+            }
+            catch (...)
+            {
+                LOG_ERROR_MESSAGE("Failed to decode TIFF image");
+                Result = false;
+            }
+            break;
+
+        case IMAGE_FILE_FORMAT_PNG:
+            Result = DecodePngRows(pSrcData, SrcDataSize, RowHandler, pUserData, &Desc) == DECODE_PNG_RESULT_OK;
+            if (!Result)
+            {
+                LOG_ERROR_MESSAGE("Failed to decode png image");
+            }
+            break;
+
+        case IMAGE_FILE_FORMAT_JPEG:
+            Result = DecodeJpegRows(pSrcData, SrcDataSize, RowHandler, pUserData, &Desc) == DECODE_JPEG_RESULT_OK;
+            if (!Result)
+            {
+                LOG_ERROR_MESSAGE("Failed to decode jpeg image");
+            }
+            break;
+
+        default:
+            Result = false;
+            LOG_ERROR_MESSAGE("Row decoding is not supported for this image format.");
+            break;
+    }
+
+    return Result;
+}
+
 Image::Image(IReferenceCounters*  pRefCounters,
              const void*          pSrcData,
              size_t               SrcDataSize,
@@ -547,6 +627,27 @@ std::vector<Uint8> Image::ConvertImageData(Uint32         Width,
 }
 
 
+static bool EncodePngImage(const Image::EncodeInfo& Info, IFileStream* pDstStream)
+{
+    const Uint8*       pData  = reinterpret_cast<const Uint8*>(Info.pData);
+    Uint32             Stride = Info.Stride;
+    std::vector<Uint8> ConvertedData;
+    if (!((Info.TexFormat == TEX_FORMAT_RGBA8_UNORM || Info.TexFormat == TEX_FORMAT_RGBA8_UNORM_SRGB) && Info.KeepAlpha && !Info.FlipY))
+    {
+        ConvertedData = Image::ConvertImageData(Info.Width, Info.Height, reinterpret_cast<const Uint8*>(Info.pData), Info.Stride, Info.TexFormat, TEX_FORMAT_RGBA8_UNORM, Info.KeepAlpha, Info.FlipY);
+        pData         = ConvertedData.data();
+        Stride        = Info.Width * (Info.KeepAlpha ? 4 : 3);
+    }
+
+    ENCODE_PNG_RESULT Res = EncodePngToStream(pData, Info.Width, Info.Height, Stride, Info.KeepAlpha ? PNG_COLOR_TYPE_RGBA : PNG_COLOR_TYPE_RGB, Info.PngCompressionLevel, pDstStream);
+    if (Res != ENCODE_PNG_RESULT_OK)
+    {
+        LOG_ERROR_MESSAGE("Failed to encode png file");
+        return false;
+    }
+    return true;
+}
+
 void Image::Encode(const EncodeInfo& Info, IDataBlob** ppEncodedData)
 {
     RefCntAutoPtr<DataBlobImpl> pEncodedData = DataBlobImpl::Create(Info.pAllocator);
@@ -560,19 +661,7 @@ void Image::Encode(const EncodeInfo& Info, IDataBlob** ppEncodedData)
     }
     else if (Info.FileFormat == IMAGE_FILE_FORMAT_PNG)
     {
-        const Uint8*       pData  = reinterpret_cast<const Uint8*>(Info.pData);
-        Uint32             Stride = Info.Stride;
-        std::vector<Uint8> ConvertedData;
-        if (!((Info.TexFormat == TEX_FORMAT_RGBA8_UNORM || Info.TexFormat == TEX_FORMAT_RGBA8_UNORM_SRGB) && Info.KeepAlpha && !Info.FlipY))
-        {
-            ConvertedData = ConvertImageData(Info.Width, Info.Height, reinterpret_cast<const Uint8*>(Info.pData), Info.Stride, Info.TexFormat, TEX_FORMAT_RGBA8_UNORM, Info.KeepAlpha, Info.FlipY);
-            pData         = ConvertedData.data();
-            Stride        = Info.Width * (Info.KeepAlpha ? 4 : 3);
-        }
-
-        ENCODE_PNG_RESULT Res = EncodePng(pData, Info.Width, Info.Height, Stride, Info.KeepAlpha ? PNG_COLOR_TYPE_RGBA : PNG_COLOR_TYPE_RGB, pEncodedData);
-        if (Res != ENCODE_PNG_RESULT_OK)
-            LOG_ERROR_MESSAGE("Failed to encode png file");
+        EncodePngImage(Info, MemoryFileStream::Create(pEncodedData));
     }
     else
     {
@@ -581,6 +670,28 @@ void Image::Encode(const EncodeInfo& Info, IDataBlob** ppEncodedData)
     pEncodedData->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppEncodedData));
 }
 
+bool Image::Encode(const EncodeInfo& Info, IFileStream* pDstStream)
+{
+    if (pDstStream == nullptr)
+    {
+        UNEXPECTED("Destination stream must not be null");
+        return false;
+    }
+
+    if (Info.FileFormat == IMAGE_FILE_FORMAT_PNG)
+    {
+        // Write PNG data directly to the stream without intermediate copies
+        return EncodePngImage(Info, pDstStream);
+    }
+
+    RefCntAutoPtr<IDataBlob> pEncodedData;
+    Encode(Info, &pEncodedData);
+    if (!pEncodedData || pEncodedData->GetSize() == 0)
+        return false;
+
+    return pDstStream->Write(pEncodedData->GetConstDataPtr(), pEncodedData->GetSize());
+}
+
 IMAGE_FILE_FORMAT Image::GetFileFormat(const Uint8* pData, size_t Size, const char* FilePath)
 {
     if (pData != nullptr)
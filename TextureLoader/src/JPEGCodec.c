@@ -58,10 +58,12 @@ my_error_exit(j_common_ptr cinfo)
     longjmp(myerr->setjmp_buffer, 1);
 }
 
-DECODE_JPEG_RESULT Diligent_DecodeJpeg(const void* pSrcJpegBits,
-                                       size_t      JpegDataSize,
-                                       IDataBlob*  pDstPixels,
-                                       ImageDesc*  pDstImgDesc)
+static DECODE_JPEG_RESULT DecodeJpegInternal(const void*         pSrcJpegBits,
+                                             size_t              JpegDataSize,
+                                             IDataBlob*          pDstPixels,
+                                             ImageRowHandlerType RowHandler,
+                                             void*               pUserData,
+                                             ImageDesc*          pDstImgDesc)
 {
     if (!pSrcJpegBits || !pDstImgDesc)
         return DECODE_JPEG_RESULT_INVALID_ARGUMENTS;
@@ -106,7 +108,8 @@ DECODE_JPEG_RESULT Diligent_DecodeJpeg(const void* pSrcJpegBits,
     //   (b) we passed TRUE to reject a tables-only JPEG file as an error.
     // See libjpeg.txt for more info.
 
-    if (pDstPixels != NULL)
+    DECODE_JPEG_RESULT Result = DECODE_JPEG_RESULT_OK;
+    if (pDstPixels != NULL || RowHandler != NULL)
     {
         // Step 4: set parameters for decompression
 
@@ -130,30 +133,51 @@ DECODE_JPEG_RESULT Diligent_DecodeJpeg(const void* pSrcJpegBits,
         pDstImgDesc->ComponentType = VT_UINT8;
         pDstImgDesc->NumComponents = cinfo.output_components;
         pDstImgDesc->RowStride     = pDstImgDesc->Width * pDstImgDesc->NumComponents;
-        pDstImgDesc->RowStride     = (pDstImgDesc->RowStride + 3u) & ~3u;
-
-        IDataBlob_Resize(pDstPixels, (size_t)pDstImgDesc->RowStride * pDstImgDesc->Height);
-        // Step 6: while (scan lines remain to be read)
-        //           jpeg_read_scanlines(...);
 
-        // Here we use the library's state variable cinfo.output_scanline as the
-        // loop counter, so that we don't have to keep track ourselves.
-        while (cinfo.output_scanline < cinfo.output_height)
+        if (RowHandler != NULL)
         {
-            // jpeg_read_scanlines expects an array of pointers to scanlines.
-            // Here the array is only one element long, but you could ask for
-            // more than one scanline at a time if that's more convenient.
-
-            Uint8*   pScanline0   = IDataBlob_GetDataPtr(pDstPixels, 0);
-            Uint8*   pDstScanline = pScanline0 + cinfo.output_scanline * (size_t)pDstImgDesc->RowStride;
-            JSAMPROW RowPtrs[1];
-            RowPtrs[0] = (JSAMPROW)pDstScanline;
-            jpeg_read_scanlines(&cinfo, RowPtrs, 1);
+            // The row buffer is allocated from the image pool that is released by the library,
+            // including when an error occurs.
+            JSAMPARRAY RowBuffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, pDstImgDesc->RowStride, 1);
+            while (cinfo.output_scanline < cinfo.output_height)
+            {
+                const Uint32 Row = cinfo.output_scanline;
+                jpeg_read_scanlines(&cinfo, RowBuffer, 1);
+                if (!RowHandler(pUserData, Row, RowBuffer[0]))
+                {
+                    Result = DECODE_JPEG_RESULT_ABORTED;
+                    break;
+                }
+            }
+        }
+        else
+        {
+            pDstImgDesc->RowStride = (pDstImgDesc->RowStride + 3u) & ~3u;
+
+            IDataBlob_Resize(pDstPixels, (size_t)pDstImgDesc->RowStride * pDstImgDesc->Height);
+            // Step 6: while (scan lines remain to be read)
+            //           jpeg_read_scanlines(...);
+
+            // Here we use the library's state variable cinfo.output_scanline as the
+            // loop counter, so that we don't have to keep track ourselves.
+            while (cinfo.output_scanline < cinfo.output_height)
+            {
+                // jpeg_read_scanlines expects an array of pointers to scanlines.
+                // Here the array is only one element long, but you could ask for
+                // more than one scanline at a time if that's more convenient.
+
+                Uint8*   pScanline0   = IDataBlob_GetDataPtr(pDstPixels, 0);
+                Uint8*   pDstScanline = pScanline0 + cinfo.output_scanline * (size_t)pDstImgDesc->RowStride;
+                JSAMPROW RowPtrs[1];
+                RowPtrs[0] = (JSAMPROW)pDstScanline;
+                jpeg_read_scanlines(&cinfo, RowPtrs, 1);
+            }
         }
 
         // Step 7: Finish decompression
 
-        jpeg_finish_decompress(&cinfo);
+        if (Result == DECODE_JPEG_RESULT_OK)
+            jpeg_finish_decompress(&cinfo);
         // We can ignore the return value since suspension is not possible
         // with the stdio data source.
     }
@@ -173,7 +197,27 @@ DECODE_JPEG_RESULT Diligent_DecodeJpeg(const void* pSrcJpegBits,
     // At this point you may want to check to see whether any corrupt-data
     // warnings occurred (test whether jerr.pub.num_warnings is nonzero).
 
-    return DECODE_JPEG_RESULT_OK;
+    return Result;
+}
+
+DECODE_JPEG_RESULT Diligent_DecodeJpeg(const void* pSrcJpegBits,
+                                       size_t      JpegDataSize,
+                                       IDataBlob*  pDstPixels,
+                                       ImageDesc*  pDstImgDesc)
+{
+    return DecodeJpegInternal(pSrcJpegBits, JpegDataSize, pDstPixels, NULL, NULL, pDstImgDesc);
+}
+
+DECODE_JPEG_RESULT Diligent_DecodeJpegRows(const void*         pSrcJpegBits,
+                                           size_t              JpegDataSize,
+                                           ImageRowHandlerType RowHandler,
+                                           void*               pUserData,
+                                           ImageDesc*          pDstImgDesc)
+{
+    if (!RowHandler)
+        return DECODE_JPEG_RESULT_INVALID_ARGUMENTS;
+
+    return DecodeJpegInternal(pSrcJpegBits, JpegDataSize, NULL, RowHandler, pUserData, pDstImgDesc);
 }
 
 
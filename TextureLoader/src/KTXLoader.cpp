@@ -27,11 +27,21 @@
 
 #include <algorithm>
 #include <vector>
+#include <atomic>
+#include <cstring>
 
 #include "TextureLoaderImpl.hpp"
 #include "GraphicsAccessories.hpp"
+#include "DataBlobImpl.hpp"
+#include "ThreadPool.hpp"
 #include "Align.hpp"
 
+#include "zlib.h"
+
+#ifdef DILIGENT_ZSTD_SUPPORTED
+#    include "zstd.h"
+#endif
+
 #define GL_RGBA32F            0x8814
 #define GL_RGBA32UI           0x8D70
 #define GL_RGBA32I            0x8D82
@@ -98,6 +108,73 @@
 #define GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT    0x8E8E
 #define GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT  0x8E8F
 
+#define VK_FORMAT_R8_UNORM                 9
+#define VK_FORMAT_R8_SNORM                 10
+#define VK_FORMAT_R8_UINT                  13
+#define VK_FORMAT_R8_SINT                  14
+#define VK_FORMAT_R8G8_UNORM               16
+#define VK_FORMAT_R8G8_SNORM               17
+#define VK_FORMAT_R8G8_UINT                20
+#define VK_FORMAT_R8G8_SINT                21
+#define VK_FORMAT_R8G8B8A8_UNORM           37
+#define VK_FORMAT_R8G8B8A8_SNORM           38
+#define VK_FORMAT_R8G8B8A8_UINT            41
+#define VK_FORMAT_R8G8B8A8_SINT            42
+#define VK_FORMAT_R8G8B8A8_SRGB            43
+#define VK_FORMAT_B8G8R8A8_UNORM           44
+#define VK_FORMAT_B8G8R8A8_SRGB            50
+#define VK_FORMAT_A2B10G10R10_UNORM_PACK32 64
+#define VK_FORMAT_A2B10G10R10_UINT_PACK32  68
+#define VK_FORMAT_R16_UNORM                70
+#define VK_FORMAT_R16_SNORM                71
+#define VK_FORMAT_R16_UINT                 74
+#define VK_FORMAT_R16_SINT                 75
+#define VK_FORMAT_R16_SFLOAT               76
+#define VK_FORMAT_R16G16_UNORM             77
+#define VK_FORMAT_R16G16_SNORM             78
+#define VK_FORMAT_R16G16_UINT              81
+#define VK_FORMAT_R16G16_SINT              82
+#define VK_FORMAT_R16G16_SFLOAT            83
+#define VK_FORMAT_R16G16B16A16_UNORM       91
+#define VK_FORMAT_R16G16B16A16_SNORM       92
+#define VK_FORMAT_R16G16B16A16_UINT        95
+#define VK_FORMAT_R16G16B16A16_SINT        96
+#define VK_FORMAT_R16G16B16A16_SFLOAT      97
+#define VK_FORMAT_R32_UINT                 98
+#define VK_FORMAT_R32_SINT                 99
+#define VK_FORMAT_R32_SFLOAT               100
+#define VK_FORMAT_R32G32_UINT              101
+#define VK_FORMAT_R32G32_SINT              102
+#define VK_FORMAT_R32G32_SFLOAT            103
+#define VK_FORMAT_R32G32B32_UINT           104
+#define VK_FORMAT_R32G32B32_SINT           105
+#define VK_FORMAT_R32G32B32_SFLOAT         106
+#define VK_FORMAT_R32G32B32A32_UINT        107
+#define VK_FORMAT_R32G32B32A32_SINT        108
+#define VK_FORMAT_R32G32B32A32_SFLOAT      109
+#define VK_FORMAT_B10G11R11_UFLOAT_PACK32  122
+#define VK_FORMAT_E5B9G9R9_UFLOAT_PACK32   123
+#define VK_FORMAT_D16_UNORM                124
+#define VK_FORMAT_D32_SFLOAT               126
+#define VK_FORMAT_D24_UNORM_S8_UINT        129
+#define VK_FORMAT_D32_SFLOAT_S8_UINT       130
+#define VK_FORMAT_BC1_RGB_UNORM_BLOCK      131
+#define VK_FORMAT_BC1_RGB_SRGB_BLOCK       132
+#define VK_FORMAT_BC1_RGBA_UNORM_BLOCK     133
+#define VK_FORMAT_BC1_RGBA_SRGB_BLOCK      134
+#define VK_FORMAT_BC2_UNORM_BLOCK          135
+#define VK_FORMAT_BC2_SRGB_BLOCK           136
+#define VK_FORMAT_BC3_UNORM_BLOCK          137
+#define VK_FORMAT_BC3_SRGB_BLOCK           138
+#define VK_FORMAT_BC4_UNORM_BLOCK          139
+#define VK_FORMAT_BC4_SNORM_BLOCK          140
+#define VK_FORMAT_BC5_UNORM_BLOCK          141
+#define VK_FORMAT_BC5_SNORM_BLOCK          142
+#define VK_FORMAT_BC6H_UFLOAT_BLOCK        143
+#define VK_FORMAT_BC6H_SFLOAT_BLOCK        144
+#define VK_FORMAT_BC7_UNORM_BLOCK          145
+#define VK_FORMAT_BC7_SRGB_BLOCK           146
+
 namespace Diligent
 {
 
@@ -192,6 +269,96 @@ TEXTURE_FORMAT FindDiligentTextureFormat(std::uint32_t GLInternalFormat)
     }
 }
 
+TEXTURE_FORMAT VkFormatToDiligentTextureFormat(std::uint32_t VkFormat)
+{
+    switch (VkFormat)
+    {
+        // clang-format off
+        case VK_FORMAT_R8_UNORM:                 return TEX_FORMAT_R8_UNORM;
+        case VK_FORMAT_R8_SNORM:                 return TEX_FORMAT_R8_SNORM;
+        case VK_FORMAT_R8_UINT:                  return TEX_FORMAT_R8_UINT;
+        case VK_FORMAT_R8_SINT:                  return TEX_FORMAT_R8_SINT;
+
+        case VK_FORMAT_R8G8_UNORM:               return TEX_FORMAT_RG8_UNORM;
+        case VK_FORMAT_R8G8_SNORM:               return TEX_FORMAT_RG8_SNORM;
+        case VK_FORMAT_R8G8_UINT:                return TEX_FORMAT_RG8_UINT;
+        case VK_FORMAT_R8G8_SINT:                return TEX_FORMAT_RG8_SINT;
+
+        case VK_FORMAT_R8G8B8A8_UNORM:           return TEX_FORMAT_RGBA8_UNORM;
+        case VK_FORMAT_R8G8B8A8_SNORM:           return TEX_FORMAT_RGBA8_SNORM;
+        case VK_FORMAT_R8G8B8A8_UINT:            return TEX_FORMAT_RGBA8_UINT;
+        case VK_FORMAT_R8G8B8A8_SINT:            return TEX_FORMAT_RGBA8_SINT;
+        case VK_FORMAT_R8G8B8A8_SRGB:            return TEX_FORMAT_RGBA8_UNORM_SRGB;
+        case VK_FORMAT_B8G8R8A8_UNORM:           return TEX_FORMAT_BGRA8_UNORM;
+        case VK_FORMAT_B8G8R8A8_SRGB:            return TEX_FORMAT_BGRA8_UNORM_SRGB;
+
+        case VK_FORMAT_A2B10G10R10_UNORM_PACK32: return TEX_FORMAT_RGB10A2_UNORM;
+        case VK_FORMAT_A2B10G10R10_UINT_PACK32:  return TEX_FORMAT_RGB10A2_UINT;
+
+        case VK_FORMAT_R16_UNORM:                return TEX_FORMAT_R16_UNORM;
+        case VK_FORMAT_R16_SNORM:                return TEX_FORMAT_R16_SNORM;
+        case VK_FORMAT_R16_UINT:                 return TEX_FORMAT_R16_UINT;
+        case VK_FORMAT_R16_SINT:                 return TEX_FORMAT_R16_SINT;
+        case VK_FORMAT_R16_SFLOAT:               return TEX_FORMAT_R16_FLOAT;
+
+        case VK_FORMAT_R16G16_UNORM:             return TEX_FORMAT_RG16_UNORM;
+        case VK_FORMAT_R16G16_SNORM:             return TEX_FORMAT_RG16_SNORM;
+        case VK_FORMAT_R16G16_UINT:              return TEX_FORMAT_RG16_UINT;
+        case VK_FORMAT_R16G16_SINT:              return TEX_FORMAT_RG16_SINT;
+        case VK_FORMAT_R16G16_SFLOAT:            return TEX_FORMAT_RG16_FLOAT;
+
+        case VK_FORMAT_R16G16B16A16_UNORM:       return TEX_FORMAT_RGBA16_UNORM;
+        case VK_FORMAT_R16G16B16A16_SNORM:       return TEX_FORMAT_RGBA16_SNORM;
+        case VK_FORMAT_R16G16B16A16_UINT:        return TEX_FORMAT_RGBA16_UINT;
+        case VK_FORMAT_R16G16B16A16_SINT:        return TEX_FORMAT_RGBA16_SINT;
+        case VK_FORMAT_R16G16B16A16_SFLOAT:      return TEX_FORMAT_RGBA16_FLOAT;
+
+        case VK_FORMAT_R32_UINT:                 return TEX_FORMAT_R32_UINT;
+        case VK_FORMAT_R32_SINT:                 return TEX_FORMAT_R32_SINT;
+        case VK_FORMAT_R32_SFLOAT:               return TEX_FORMAT_R32_FLOAT;
+
+        case VK_FORMAT_R32G32_UINT:              return TEX_FORMAT_RG32_UINT;
+        case VK_FORMAT_R32G32_SINT:              return TEX_FORMAT_RG32_SINT;
+        case VK_FORMAT_R32G32_SFLOAT:            return TEX_FORMAT_RG32_FLOAT;
+
+        case VK_FORMAT_R32G32B32_UINT:           return TEX_FORMAT_RGB32_UINT;
+        case VK_FORMAT_R32G32B32_SINT:           return TEX_FORMAT_RGB32_SINT;
+        case VK_FORMAT_R32G32B32_SFLOAT:         return TEX_FORMAT_RGB32_FLOAT;
+
+        case VK_FORMAT_R32G32B32A32_UINT:        return TEX_FORMAT_RGBA32_UINT;
+        case VK_FORMAT_R32G32B32A32_SINT:        return TEX_FORMAT_RGBA32_SINT;
+        case VK_FORMAT_R32G32B32A32_SFLOAT:      return TEX_FORMAT_RGBA32_FLOAT;
+
+        case VK_FORMAT_B10G11R11_UFLOAT_PACK32:  return TEX_FORMAT_R11G11B10_FLOAT;
+        case VK_FORMAT_E5B9G9R9_UFLOAT_PACK32:   return TEX_FORMAT_RGB9E5_SHAREDEXP;
+
+        case VK_FORMAT_D16_UNORM:                return TEX_FORMAT_D16_UNORM;
+        case VK_FORMAT_D32_SFLOAT:               return TEX_FORMAT_D32_FLOAT;
+        case VK_FORMAT_D24_UNORM_S8_UINT:        return TEX_FORMAT_D24_UNORM_S8_UINT;
+        case VK_FORMAT_D32_SFLOAT_S8_UINT:       return TEX_FORMAT_D32_FLOAT_S8X24_UINT;
+
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:      return TEX_FORMAT_BC1_UNORM;
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:       return TEX_FORMAT_BC1_UNORM_SRGB;
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:     return TEX_FORMAT_BC1_UNORM;
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:      return TEX_FORMAT_BC1_UNORM_SRGB;
+        case VK_FORMAT_BC2_UNORM_BLOCK:          return TEX_FORMAT_BC2_UNORM;
+        case VK_FORMAT_BC2_SRGB_BLOCK:           return TEX_FORMAT_BC2_UNORM_SRGB;
+        case VK_FORMAT_BC3_UNORM_BLOCK:          return TEX_FORMAT_BC3_UNORM;
+        case VK_FORMAT_BC3_SRGB_BLOCK:           return TEX_FORMAT_BC3_UNORM_SRGB;
+        case VK_FORMAT_BC4_UNORM_BLOCK:          return TEX_FORMAT_BC4_UNORM;
+        case VK_FORMAT_BC4_SNORM_BLOCK:          return TEX_FORMAT_BC4_SNORM;
+        case VK_FORMAT_BC5_UNORM_BLOCK:          return TEX_FORMAT_BC5_UNORM;
+        case VK_FORMAT_BC5_SNORM_BLOCK:          return TEX_FORMAT_BC5_SNORM;
+        case VK_FORMAT_BC6H_UFLOAT_BLOCK:        return TEX_FORMAT_BC6H_UF16;
+        case VK_FORMAT_BC6H_SFLOAT_BLOCK:        return TEX_FORMAT_BC6H_SF16;
+        case VK_FORMAT_BC7_UNORM_BLOCK:          return TEX_FORMAT_BC7_UNORM;
+        case VK_FORMAT_BC7_SRGB_BLOCK:           return TEX_FORMAT_BC7_UNORM_SRGB;
+        // clang-format on
+        default:
+            return TEX_FORMAT_UNKNOWN;
+    }
+}
+
 } // namespace
 
 
@@ -212,12 +379,223 @@ struct KTX10Header
     std::uint32_t BytesOfKeyValueData;
 };
 
+static constexpr Uint8 KTX10FileIdentifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+static constexpr Uint8 KTX20FileIdentifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+static void ReadKTX10Desc(const KTX10Header& Header, TextureDesc& TexDesc)
+{
+    TexDesc.Format = FindDiligentTextureFormat(Header.GLInternalFormat);
+    if (TexDesc.Format == TEX_FORMAT_UNKNOWN)
+        LOG_ERROR_AND_THROW("Failed to find appropriate Diligent format for internal gl format ", Header.GLInternalFormat);
+
+    TexDesc.Width = Header.Width;
+    if (TexDesc.Width == 0)
+        LOG_ERROR_AND_THROW("Texture width is zero");
+
+    TexDesc.Height    = std::max(Header.Height, 1u);
+    TexDesc.MipLevels = std::max(Header.NumberOfMipmapLevels, 1u);
+
+    const uint32_t NumFaces  = std::max(Header.NumberOfFaces, 1u);
+    const uint32_t ArraySize = std::max(Header.NumberOfArrayElements, 1u) * NumFaces;
+    if (NumFaces == 1)
+    {
+        if (Header.Depth >= 1)
+        {
+            TexDesc.Type  = RESOURCE_DIM_TEX_3D;
+            TexDesc.Depth = Header.Depth; // Depth is in union with ArraySize
+        }
+        else
+        {
+            TexDesc.Type      = ArraySize > 1 ? RESOURCE_DIM_TEX_2D_ARRAY : RESOURCE_DIM_TEX_2D;
+            TexDesc.ArraySize = ArraySize;
+        }
+    }
+    else if (NumFaces == 6)
+    {
+        TexDesc.Type      = ArraySize > 6 ? RESOURCE_DIM_TEX_CUBE_ARRAY : RESOURCE_DIM_TEX_CUBE;
+        TexDesc.ArraySize = ArraySize;
+    }
+    else
+    {
+        LOG_ERROR_AND_THROW("Unsupported number of faces (", NumFaces, ")");
+    }
+}
+
+
+struct KTX20Header
+{
+    std::uint32_t VkFormat;
+    std::uint32_t TypeSize;
+    std::uint32_t PixelWidth;
+    std::uint32_t PixelHeight;
+    std::uint32_t PixelDepth;
+    std::uint32_t LayerCount;
+    std::uint32_t FaceCount;
+    std::uint32_t LevelCount;
+    std::uint32_t SupercompressionScheme;
+};
+
+struct KTX20Index
+{
+    std::uint32_t DfdByteOffset;
+    std::uint32_t DfdByteLength;
+    std::uint32_t KvdByteOffset;
+    std::uint32_t KvdByteLength;
+    std::uint64_t SgdByteOffset;
+    std::uint64_t SgdByteLength;
+};
+
+struct KTX20LevelIndex
+{
+    std::uint64_t ByteOffset;
+    std::uint64_t ByteLength;
+    std::uint64_t UncompressedByteLength;
+};
+
+enum KTX20_SUPERCOMPRESSION_SCHEME : std::uint32_t
+{
+    KTX20_SUPERCOMPRESSION_NONE     = 0,
+    KTX20_SUPERCOMPRESSION_BASIS_LZ = 1,
+    KTX20_SUPERCOMPRESSION_ZSTD     = 2,
+    KTX20_SUPERCOMPRESSION_ZLIB     = 3,
+};
+
+struct KTX20File
+{
+    KTX20Header Header;
+    KTX20Index  Index;
+
+    // Level 0 is the base level. Note that in the file, the level data
+    // is stored in the reverse order, starting with the smallest level.
+    std::vector<KTX20LevelIndex> Levels;
+};
+
+static KTX20File ReadKTX20File(const Uint8* pData, size_t DataSize)
+{
+    constexpr size_t HeaderOffset     = sizeof(KTX20FileIdentifier);
+    constexpr size_t IndexOffset      = HeaderOffset + sizeof(KTX20Header);
+    constexpr size_t LevelIndexOffset = IndexOffset + sizeof(KTX20Index);
+    static_assert(LevelIndexOffset == 80, "Unexpected KTX2 level index offset");
+
+    if (DataSize < LevelIndexOffset)
+        LOG_ERROR_AND_THROW("KTX2 data size (", DataSize, ") is too small");
+
+    // The header fields are not necessarily aligned in memory, so copy them
+    KTX20File File;
+    memcpy(&File.Header, pData + HeaderOffset, sizeof(File.Header));
+    memcpy(&File.Index, pData + IndexOffset, sizeof(File.Index));
+
+    const Uint32 NumLevels = std::max(File.Header.LevelCount, 1u);
+    if (DataSize < LevelIndexOffset + sizeof(KTX20LevelIndex) * NumLevels)
+        LOG_ERROR_AND_THROW("KTX2 data size (", DataSize, ") is too small to contain the index of ", NumLevels, " levels");
+
+    File.Levels.resize(NumLevels);
+    memcpy(File.Levels.data(), pData + LevelIndexOffset, sizeof(KTX20LevelIndex) * NumLevels);
+
+    return File;
+}
+
+static void ReadKTX20Desc(const KTX20Header& Header, TextureDesc& TexDesc)
+{
+    if (Header.VkFormat == 0)
+        LOG_ERROR_AND_THROW("KTX2 textures with undefined format (e.g. Basis Universal) are not supported");
+
+    TexDesc.Format = VkFormatToDiligentTextureFormat(Header.VkFormat);
+    if (TexDesc.Format == TEX_FORMAT_UNKNOWN)
+        LOG_ERROR_AND_THROW("Failed to find appropriate Diligent format for Vulkan format ", Header.VkFormat);
+
+    switch (Header.SupercompressionScheme)
+    {
+        case KTX20_SUPERCOMPRESSION_NONE:
+        case KTX20_SUPERCOMPRESSION_ZLIB:
+            break;
+
+        case KTX20_SUPERCOMPRESSION_ZSTD:
+#ifndef DILIGENT_ZSTD_SUPPORTED
+            LOG_ERROR_AND_THROW("Zstandard supercompression is not supported. Enable DILIGENT_ENABLE_ZSTD CMake option to load this texture.");
+#endif
+            break;
+
+        case KTX20_SUPERCOMPRESSION_BASIS_LZ:
+            LOG_ERROR_AND_THROW("BasisLZ supercompression is not supported");
+
+        default:
+            LOG_ERROR_AND_THROW("Unknown supercompression scheme (", Header.SupercompressionScheme, ")");
+    }
+
+    TexDesc.Width = Header.PixelWidth;
+    if (TexDesc.Width == 0)
+        LOG_ERROR_AND_THROW("Texture width is zero");
+
+    TexDesc.Height    = std::max(Header.PixelHeight, 1u);
+    TexDesc.MipLevels = std::max(Header.LevelCount, 1u);
+
+    const Uint32 NumFaces  = std::max(Header.FaceCount, 1u);
+    const Uint32 ArraySize = std::max(Header.LayerCount, 1u) * NumFaces;
+    if (NumFaces == 6)
+    {
+        TexDesc.Type      = ArraySize > 6 ? RESOURCE_DIM_TEX_CUBE_ARRAY : RESOURCE_DIM_TEX_CUBE;
+        TexDesc.ArraySize = ArraySize;
+    }
+    else if (NumFaces != 1)
+    {
+        LOG_ERROR_AND_THROW("Unsupported number of faces (", NumFaces, ")");
+    }
+    else if (Header.PixelDepth > 0)
+    {
+        if (ArraySize > 1)
+            LOG_ERROR_AND_THROW("3D texture arrays are not supported");
+
+        TexDesc.Type  = RESOURCE_DIM_TEX_3D;
+        TexDesc.Depth = Header.PixelDepth;
+    }
+    else if (Header.PixelHeight == 0)
+    {
+        TexDesc.Type      = ArraySize > 1 ? RESOURCE_DIM_TEX_1D_ARRAY : RESOURCE_DIM_TEX_1D;
+        TexDesc.ArraySize = ArraySize;
+    }
+    else
+    {
+        TexDesc.Type      = ArraySize > 1 ? RESOURCE_DIM_TEX_2D_ARRAY : RESOURCE_DIM_TEX_2D;
+        TexDesc.ArraySize = ArraySize;
+    }
+}
+
+static bool DecompressKTX20Level(std::uint32_t Scheme, const Uint8* pSrc, size_t SrcSize, Uint8* pDst, size_t DstSize)
+{
+    switch (Scheme)
+    {
+        case KTX20_SUPERCOMPRESSION_ZLIB:
+        {
+            uLongf DecompressedSize = static_cast<uLongf>(DstSize);
+            return uncompress(pDst, &DecompressedSize, pSrc, static_cast<uLong>(SrcSize)) == Z_OK && DecompressedSize == DstSize;
+        }
+
+#ifdef DILIGENT_ZSTD_SUPPORTED
+        case KTX20_SUPERCOMPRESSION_ZSTD:
+        {
+            const size_t DecompressedSize = ZSTD_decompress(pDst, DstSize, pSrc, SrcSize);
+            return !ZSTD_isError(DecompressedSize) && DecompressedSize == DstSize;
+        }
+#endif
+
+        default:
+            UNEXPECTED("Unexpected supercompression scheme");
+            return false;
+    }
+}
+
 void TextureLoaderImpl::LoadFromKTX(const TextureLoadInfo& TexLoadInfo, const Uint8* pData, size_t DataSize)
 {
+    if (DataSize >= 12 && memcmp(pData, KTX20FileIdentifier, sizeof(KTX20FileIdentifier)) == 0)
+    {
+        LoadFromKTX20(TexLoadInfo, pData, DataSize);
+        return;
+    }
+
 #ifdef DILIGENT_DEBUG
     const Uint8* pOrigDataPtr = pData;
 #endif
-    static constexpr Uint8 KTX10FileIdentifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
     if (DataSize >= 12 && memcmp(pData, KTX10FileIdentifier, sizeof(KTX10FileIdentifier)) == 0)
     {
         pData += sizeof(KTX10FileIdentifier);
@@ -226,59 +604,25 @@ void TextureLoaderImpl::LoadFromKTX(const TextureLoadInfo& TexLoadInfo, const Ui
         // Skip key value data
         pData += Header.BytesOfKeyValueData;
 
-        m_TexDesc.Format = FindDiligentTextureFormat(Header.GLInternalFormat);
-        if (m_TexDesc.Format == TEX_FORMAT_UNKNOWN)
-            LOG_ERROR_AND_THROW("Failed to find appropriate Diligent format for internal gl format ", Header.GLInternalFormat);
-
-        m_TexDesc.Width = Header.Width;
-        if (m_TexDesc.Width == 0)
-            LOG_ERROR_AND_THROW("Texture width is zero");
-
-        m_TexDesc.Height = std::max(Header.Height, 1u);
-
-        const uint32_t SrcMipLevels = std::max(Header.NumberOfMipmapLevels, 1u);
-        m_TexDesc.MipLevels         = SrcMipLevels;
-        if (TexLoadInfo.MipLevels > 0)
-            m_TexDesc.MipLevels = std::min(m_TexDesc.MipLevels, TexLoadInfo.MipLevels);
-
-        const uint32_t NumFaces  = std::max(Header.NumberOfFaces, 1u);
-        const uint32_t ArraySize = std::max(Header.NumberOfArrayElements, 1u) * NumFaces;
-        if (NumFaces == 1)
-        {
-            if (Header.Depth >= 1)
-            {
-                m_TexDesc.Type  = RESOURCE_DIM_TEX_3D;
-                m_TexDesc.Depth = m_TexDesc.Depth; // Depth is in union with ArraySize
-            }
-            else
-            {
-                m_TexDesc.Type      = ArraySize > 1 ? RESOURCE_DIM_TEX_2D_ARRAY : RESOURCE_DIM_TEX_2D;
-                m_TexDesc.ArraySize = ArraySize;
-            }
-        }
-        else if (NumFaces == 6)
-        {
-            m_TexDesc.Type      = ArraySize > 6 ? RESOURCE_DIM_TEX_CUBE_ARRAY : RESOURCE_DIM_TEX_CUBE;
-            m_TexDesc.ArraySize = ArraySize;
-        }
-        else
-        {
-            LOG_ERROR_AND_THROW("Unsupported number of faces (", NumFaces, ")");
-        }
+        ReadKTX10Desc(Header, m_TexDesc);
+        const TextureDesc SrcDesc  = m_TexDesc;
+        const Uint32      FirstMip = SelectMipRange(m_TexDesc, TexLoadInfo);
+        const Uint32      EndMip   = FirstMip + m_TexDesc.MipLevels;
 
+        const uint32_t ArraySize = std::max(Header.NumberOfArrayElements, 1u) * std::max(Header.NumberOfFaces, 1u);
         m_SubResources.resize(size_t{m_TexDesc.MipLevels} * size_t{ArraySize});
 
         // NB: unlike DDS, subresource in KTX are arranged by mip levels first.
-        for (Uint32 mip = 0; mip < SrcMipLevels; ++mip)
+        for (Uint32 mip = 0; mip < SrcDesc.MipLevels; ++mip)
         {
             pData += sizeof(std::uint32_t);
-            MipLevelProperties MipInfo = GetMipLevelProperties(m_TexDesc, mip);
+            MipLevelProperties MipInfo = GetMipLevelProperties(SrcDesc, mip);
 
             for (Uint32 layer = 0; layer < ArraySize; ++layer)
             {
-                if (mip < m_TexDesc.MipLevels)
+                if (mip >= FirstMip && mip < EndMip)
                 {
-                    m_SubResources[mip + size_t{layer} * size_t{m_TexDesc.MipLevels}] =
+                    m_SubResources[(mip - FirstMip) + size_t{layer} * size_t{m_TexDesc.MipLevels}] =
                         TextureSubResData{pData, MipInfo.RowSize, MipInfo.DepthSliceSize};
                 }
                 pData += AlignUp(MipInfo.MipSize, 4u);
@@ -288,7 +632,103 @@ void TextureLoaderImpl::LoadFromKTX(const TextureLoadInfo& TexLoadInfo, const Ui
     }
     else
     {
-        LOG_ERROR_AND_THROW("ktx2.0 is not currently supported");
+        LOG_ERROR_AND_THROW("Invalid KTX file identifier");
+    }
+}
+
+void TextureLoaderImpl::LoadFromKTX20(const TextureLoadInfo& TexLoadInfo, const Uint8* pData, size_t DataSize)
+{
+    const KTX20File File = ReadKTX20File(pData, DataSize);
+    ReadKTX20Desc(File.Header, m_TexDesc);
+
+    const Uint32        FirstMip  = SelectMipRange(m_TexDesc, TexLoadInfo);
+    const Uint32        ArraySize = m_TexDesc.GetArraySize();
+    const std::uint32_t Scheme    = File.Header.SupercompressionScheme;
+
+    m_SubResources.resize(size_t{m_TexDesc.MipLevels} * size_t{ArraySize});
+    if (Scheme != KTX20_SUPERCOMPRESSION_NONE)
+        m_Mips.resize(m_TexDesc.MipLevels);
+
+    for (Uint32 mip = 0; mip < m_TexDesc.MipLevels; ++mip)
+    {
+        const KTX20LevelIndex&   Level      = File.Levels[FirstMip + mip];
+        const MipLevelProperties MipInfo    = GetMipLevelProperties(m_TexDesc, mip);
+        const Uint64             SubResSize = MipInfo.MipSize;
+        const Uint64             LevelSize  = SubResSize * ArraySize;
+
+        if (Level.ByteOffset > DataSize || Level.ByteLength > DataSize - Level.ByteOffset)
+            LOG_ERROR_AND_THROW("Data of level ", FirstMip + mip, " is out of bounds");
+
+        const Uint8* pLevelData = nullptr;
+        if (Scheme == KTX20_SUPERCOMPRESSION_NONE)
+        {
+            if (Level.ByteLength < LevelSize)
+                LOG_ERROR_AND_THROW("Data size of level ", FirstMip + mip, " (", Level.ByteLength, ") is smaller than the expected size (", LevelSize, ")");
+            pLevelData = pData + Level.ByteOffset;
+        }
+        else
+        {
+            if (Level.UncompressedByteLength != LevelSize)
+                LOG_ERROR_AND_THROW("Uncompressed size of level ", FirstMip + mip, " (", Level.UncompressedByteLength, ") does not match the expected size (", LevelSize, ")");
+            m_Mips[mip] = DataBlobImpl::Create(TexLoadInfo.pAllocator, StaticCast<size_t>(LevelSize));
+            pLevelData  = m_Mips[mip]->GetConstDataPtr<Uint8>();
+        }
+
+        // Unlike KTX1, all layers and faces of a level are stored contiguously
+        for (Uint32 layer = 0; layer < ArraySize; ++layer)
+        {
+            m_SubResources[mip + size_t{layer} * size_t{m_TexDesc.MipLevels}] =
+                TextureSubResData{pLevelData + SubResSize * layer, MipInfo.RowSize, MipInfo.DepthSliceSize};
+        }
+    }
+
+    if (Scheme != KTX20_SUPERCOMPRESSION_NONE)
+    {
+        // Every level is compressed independently, so the levels can be decompressed in parallel.
+        std::atomic<bool> Failed{false};
+        ProcessRangeInParallel(TexLoadInfo.pThreadPool, m_TexDesc.MipLevels, 1,
+                               [&](Uint32 StartMip, Uint32 EndMip) {
+                                   for (Uint32 mip = StartMip; mip < EndMip; ++mip)
+                                   {
+                                       const KTX20LevelIndex& Level = File.Levels[FirstMip + mip];
+                                       if (!DecompressKTX20Level(Scheme, pData + Level.ByteOffset, StaticCast<size_t>(Level.ByteLength),
+                                                                 m_Mips[mip]->GetDataPtr<Uint8>(), m_Mips[mip]->GetSize()))
+                                       {
+                                           Failed.store(true);
+                                       }
+                                   }
+                               });
+        if (Failed.load())
+            LOG_ERROR_AND_THROW("Failed to decompress KTX2 level data");
+    }
+}
+
+size_t ReadKTXTextureDesc(const Uint8* pData, size_t DataSize, const TextureLoadInfo& TexLoadInfo, TextureDesc& TexDesc)
+{
+    if (DataSize >= 12 && memcmp(pData, KTX20FileIdentifier, sizeof(KTX20FileIdentifier)) == 0)
+    {
+        const KTX20File File = ReadKTX20File(pData, DataSize);
+        ReadKTX20Desc(File.Header, TexDesc);
+        const Uint32 FirstMip = SelectMipRange(TexDesc, TexLoadInfo);
+
+        // The loader references the source data directly unless it needs to decompress the levels
+        size_t RequiredMemory = 0;
+        if (File.Header.SupercompressionScheme != KTX20_SUPERCOMPRESSION_NONE)
+        {
+            for (Uint32 mip = 0; mip < TexDesc.MipLevels; ++mip)
+                RequiredMemory += StaticCast<size_t>(File.Levels[FirstMip + mip].UncompressedByteLength);
+        }
+        return RequiredMemory;
+    }
+    else if (DataSize >= sizeof(KTX10FileIdentifier) + sizeof(KTX10Header) && memcmp(pData, KTX10FileIdentifier, sizeof(KTX10FileIdentifier)) == 0)
+    {
+        ReadKTX10Desc(*reinterpret_cast<const KTX10Header*>(pData + sizeof(KTX10FileIdentifier)), TexDesc);
+        SelectMipRange(TexDesc, TexLoadInfo);
+        return 0;
+    }
+    else
+    {
+        LOG_ERROR_AND_THROW("Invalid KTX file identifier");
     }
 }
 
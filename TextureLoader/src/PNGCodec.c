@@ -48,10 +48,12 @@ static void PngReadCallback(png_structp pngPtr, png_bytep data, png_size_t lengt
     pState->Offset += length;
 }
 
-DECODE_PNG_RESULT Diligent_DecodePng(const void* pSrcPngBits,
-                                     size_t      PngDataSize,
-                                     IDataBlob*  pDstPixels,
-                                     ImageDesc*  pDstImgDesc)
+static DECODE_PNG_RESULT DecodePngInternal(const void*         pSrcPngBits,
+                                           size_t              PngDataSize,
+                                           IDataBlob*          pDstPixels,
+                                           ImageRowHandlerType RowHandler,
+                                           void*               pUserData,
+                                           ImageDesc*          pDstImgDesc)
 {
     if (!pSrcPngBits || !pDstImgDesc)
         return DECODE_PNG_RESULT_INVALID_ARGUMENTS;
@@ -82,15 +84,20 @@ DECODE_PNG_RESULT Diligent_DecodePng(const void* pSrcPngBits,
     }
 
     png_bytep* rowPtrs = NULL;
+    png_bytep  pPixels = NULL;
     if (setjmp(png_jmpbuf(png)))
     {
         if (rowPtrs)
             free(rowPtrs);
+        if (pPixels)
+            free(pPixels);
         // When an error occurs during parsing, libPNG will jump to here
         png_destroy_read_struct(&png, &info, (png_infopp)0);
         return DECODE_PNG_RESULT_DECODING_ERROR;
     }
 
+    DECODE_PNG_RESULT Result = DECODE_PNG_RESULT_OK;
+
     PNGReadFnState ReadState;
     ReadState.pPngBits = pSrcPngBits;
     ReadState.Offset   = 0;
@@ -142,6 +149,12 @@ DECODE_PNG_RESULT Diligent_DecodePng(const void* pSrcPngBits,
     if (color_type == PNG_COLOR_TYPE_GRAY_ALPHA)
         png_set_gray_to_rgb(png);
 
+    // Interlaced images are decoded in several passes that update all rows,
+    // so the entire image must be decoded before the rows can be handled.
+    int NumPasses = 1;
+    if (RowHandler != NULL)
+        NumPasses = png_set_interlace_handling(png);
+
     png_read_update_info(png, info);
 
     bit_depth                  = png_get_bit_depth(png, info);
@@ -160,7 +173,42 @@ DECODE_PNG_RESULT Diligent_DecodePng(const void* pSrcPngBits,
         }
     }
 
-    if (pDstPixels != NULL)
+    if (RowHandler != NULL)
+    {
+        const size_t RowSize = png_get_rowbytes(png, info);
+        const Uint32 NumRows = NumPasses > 1 ? pDstImgDesc->Height : 1;
+
+        pDstImgDesc->RowStride = (Uint32)RowSize;
+
+        pPixels = malloc(RowSize * NumRows);
+        if (NumRows > 1)
+        {
+            rowPtrs = malloc(sizeof(png_bytep) * NumRows);
+            for (size_t i = 0; i < NumRows; i++)
+                rowPtrs[i] = pPixels + i * RowSize;
+            png_read_image(png, rowPtrs);
+        }
+
+        for (Uint32 row = 0; row < pDstImgDesc->Height; ++row)
+        {
+            png_bytep pRow = pPixels;
+            if (NumRows > 1)
+                pRow = rowPtrs[row];
+            else
+                png_read_row(png, pRow, NULL);
+
+            if (!RowHandler(pUserData, row, pRow))
+            {
+                Result = DECODE_PNG_RESULT_ABORTED;
+                break;
+            }
+        }
+
+        if (rowPtrs)
+            free(rowPtrs);
+        free(pPixels);
+    }
+    else if (pDstPixels != NULL)
     {
         //Array of row pointers. One for every row.
         rowPtrs = malloc(sizeof(png_bytep) * pDstImgDesc->Height);
@@ -184,7 +232,27 @@ DECODE_PNG_RESULT Diligent_DecodePng(const void* pSrcPngBits,
 
     png_destroy_read_struct(&png, &info, (png_infopp)0);
 
-    return DECODE_PNG_RESULT_OK;
+    return Result;
+}
+
+DECODE_PNG_RESULT Diligent_DecodePng(const void* pSrcPngBits,
+                                     size_t      PngDataSize,
+                                     IDataBlob*  pDstPixels,
+                                     ImageDesc*  pDstImgDesc)
+{
+    return DecodePngInternal(pSrcPngBits, PngDataSize, pDstPixels, NULL, NULL, pDstImgDesc);
+}
+
+DECODE_PNG_RESULT Diligent_DecodePngRows(const void*         pSrcPngBits,
+                                         size_t              PngDataSize,
+                                         ImageRowHandlerType RowHandler,
+                                         void*               pUserData,
+                                         ImageDesc*          pDstImgDesc)
+{
+    if (!RowHandler)
+        return DECODE_PNG_RESULT_INVALID_ARGUMENTS;
+
+    return DecodePngInternal(pSrcPngBits, PngDataSize, NULL, RowHandler, pUserData, pDstImgDesc);
 }
 
 static void PngWriteCallback(png_structp png_ptr, png_bytep data, png_size_t length)
@@ -196,14 +264,23 @@ static void PngWriteCallback(png_structp png_ptr, png_bytep data, png_size_t len
     memcpy(pBytes + PrevSize, data, length);
 }
 
-ENCODE_PNG_RESULT Diligent_EncodePng(const Uint8* pSrcPixels,
-                                     Uint32       Width,
-                                     Uint32       Height,
-                                     Uint32       StrideInBytes,
-                                     int          PngColorType,
-                                     IDataBlob*   pDstPngBits)
+static void PngStreamWriteCallback(png_structp png_ptr, png_bytep data, png_size_t length)
+{
+    IFileStream* pStream = (IFileStream*)png_get_io_ptr(png_ptr);
+    if (!IFileStream_Write(pStream, data, length))
+        png_error(png_ptr, "Failed to write to the stream");
+}
+
+static ENCODE_PNG_RESULT EncodePngInternal(const Uint8* pSrcPixels,
+                                           Uint32       Width,
+                                           Uint32       Height,
+                                           Uint32       StrideInBytes,
+                                           int          PngColorType,
+                                           int          CompressionLevel,
+                                           png_rw_ptr   WriteFn,
+                                           void*        pIoPtr)
 {
-    if (!pSrcPixels || !pDstPngBits || Width == 0 || Height == 0 || StrideInBytes == 0)
+    if (!pSrcPixels || !pIoPtr || Width == 0 || Height == 0 || StrideInBytes == 0)
         return ENCODE_PNG_RESULT_INVALID_ARGUMENTS;
 
     png_struct* strct = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
@@ -220,12 +297,14 @@ ENCODE_PNG_RESULT Diligent_EncodePng(const Uint8* pSrcPixels,
     }
 
     png_bytep* rowPtrs = NULL;
+    // The flag is volatile as it is modified between setjmp and longjmp
+    volatile int WriteStarted = 0;
     if (setjmp(png_jmpbuf(strct)) != 0)
     {
         if (rowPtrs)
             free(rowPtrs);
         png_destroy_write_struct(&strct, &info);
-        return ENCODE_PNG_RESULT_INITIALIZATION_FAILED;
+        return WriteStarted ? ENCODE_PNG_RESULT_WRITE_FAILED : ENCODE_PNG_RESULT_INITIALIZATION_FAILED;
     }
 
     png_set_IHDR(strct, info, Width, Height, 8,
@@ -234,14 +313,22 @@ ENCODE_PNG_RESULT Diligent_EncodePng(const Uint8* pSrcPixels,
                  PNG_COMPRESSION_TYPE_DEFAULT,
                  PNG_FILTER_TYPE_DEFAULT);
 
-    //png_set_compression_level(p, 1);
+    if (CompressionLevel >= 0)
+    {
+        png_set_compression_level(strct, CompressionLevel < 9 ? CompressionLevel : 9);
+        // Filter selection heuristics cost more than they save at fast compression levels
+        if (CompressionLevel <= 2)
+            png_set_filter(strct, PNG_FILTER_TYPE_BASE, PNG_FILTER_SUB);
+    }
+
     rowPtrs = malloc(sizeof(png_bytep) * Height);
     for (size_t y = 0; y < Height; ++y)
         rowPtrs[y] = (Uint8*)pSrcPixels + y * StrideInBytes;
 
     png_set_rows(strct, info, rowPtrs);
 
-    png_set_write_fn(strct, pDstPngBits, PngWriteCallback, NULL);
+    png_set_write_fn(strct, pIoPtr, WriteFn, NULL);
+    WriteStarted = 1;
     png_write_png(strct, info, PNG_TRANSFORM_IDENTITY, NULL);
 
     free(rowPtrs);
@@ -250,3 +337,24 @@ ENCODE_PNG_RESULT Diligent_EncodePng(const Uint8* pSrcPixels,
 
     return ENCODE_PNG_RESULT_OK;
 }
+
+ENCODE_PNG_RESULT Diligent_EncodePng(const Uint8* pSrcPixels,
+                                     Uint32       Width,
+                                     Uint32       Height,
+                                     Uint32       StrideInBytes,
+                                     int          PngColorType,
+                                     IDataBlob*   pDstPngBits)
+{
+    return EncodePngInternal(pSrcPixels, Width, Height, StrideInBytes, PngColorType, -1, PngWriteCallback, pDstPngBits);
+}
+
+ENCODE_PNG_RESULT Diligent_EncodePngToStream(const Uint8* pSrcPixels,
+                                             Uint32       Width,
+                                             Uint32       Height,
+                                             Uint32       StrideInBytes,
+                                             int          PngColorType,
+                                             int          CompressionLevel,
+                                             IFileStream* pDstStream)
+{
+    return EncodePngInternal(pSrcPixels, Width, Height, StrideInBytes, PngColorType, CompressionLevel, PngStreamWriteCallback, pDstStream);
+}
@@ -40,9 +40,11 @@
 #include "JPEGCodec.h"
 #include "ColorConversion.h"
 #include "Image.h"
-#include "FileWrapper.hpp"
+#include "BasicFileStream.hpp"
 #include "DataBlobImpl.hpp"
 #include "Align.hpp"
+#include "BCTools.h"
+#include "ThreadPool.hpp"
 
 #define STB_DXT_STATIC
 #define STB_DXT_IMPLEMENTATION
@@ -55,6 +57,12 @@ extern "C"
                                                    Diligent::IDataBlob* pDstPixels,
                                                    Diligent::ImageDesc* pDstImgDesc);
 
+    Diligent::DECODE_PNG_RESULT Diligent_DecodePngRows(const void*                   pSrcPngBits,
+                                                       size_t                        PngDataSize,
+                                                       Diligent::ImageRowHandlerType RowHandler,
+                                                       void*                         pUserData,
+                                                       Diligent::ImageDesc*          pDstImgDesc);
+
     Diligent::ENCODE_PNG_RESULT Diligent_EncodePng(const Diligent::Uint8* pSrcPixels,
                                                    Diligent::Uint32       Width,
                                                    Diligent::Uint32       Height,
@@ -62,11 +70,25 @@ extern "C"
                                                    int                    PngColorType,
                                                    Diligent::IDataBlob*   pDstPngBits);
 
+    Diligent::ENCODE_PNG_RESULT Diligent_EncodePngToStream(const Diligent::Uint8* pSrcPixels,
+                                                           Diligent::Uint32       Width,
+                                                           Diligent::Uint32       Height,
+                                                           Diligent::Uint32       StrideInBytes,
+                                                           int                    PngColorType,
+                                                           int                    CompressionLevel,
+                                                           Diligent::IFileStream* pDstStream);
+
     Diligent::DECODE_JPEG_RESULT Diligent_DecodeJpeg(const void*          pSrcJpegBits,
                                                      size_t               JpegDataSize,
                                                      Diligent::IDataBlob* pDstPixels,
                                                      Diligent::ImageDesc* pDstImgDesc);
 
+    Diligent::DECODE_JPEG_RESULT Diligent_DecodeJpegRows(const void*                   pSrcJpegBits,
+                                                         size_t                        JpegDataSize,
+                                                         Diligent::ImageRowHandlerType RowHandler,
+                                                         void*                         pUserData,
+                                                         Diligent::ImageDesc*          pDstImgDesc);
+
     Diligent::ENCODE_JPEG_RESULT Diligent_EncodeJpeg(Diligent::Uint8*     pSrcRGBData,
                                                      Diligent::Uint32     Width,
                                                      Diligent::Uint32     Height,
@@ -89,6 +111,15 @@ DECODE_PNG_RESULT DecodePng(const void* pSrcPngBits,
     return Diligent_DecodePng(pSrcPngBits, PngDataSize, pDstPixels, pDstImgDesc);
 }
 
+DECODE_PNG_RESULT DecodePngRows(const void*         pSrcPngBits,
+                                size_t              PngDataSize,
+                                ImageRowHandlerType RowHandler,
+                                void*               pUserData,
+                                ImageDesc*          pDstImgDesc)
+{
+    return Diligent_DecodePngRows(pSrcPngBits, PngDataSize, RowHandler, pUserData, pDstImgDesc);
+}
+
 ENCODE_PNG_RESULT EncodePng(const Uint8* pSrcPixels,
                             Uint32       Width,
                             Uint32       Height,
@@ -99,6 +130,17 @@ ENCODE_PNG_RESULT EncodePng(const Uint8* pSrcPixels,
     return Diligent_EncodePng(pSrcPixels, Width, Height, StrideInBytes, PngColorType, pDstPngBits);
 }
 
+ENCODE_PNG_RESULT EncodePngToStream(const Uint8* pSrcPixels,
+                                    Uint32       Width,
+                                    Uint32       Height,
+                                    Uint32       StrideInBytes,
+                                    int          PngColorType,
+                                    int          CompressionLevel,
+                                    IFileStream* pDstStream)
+{
+    return Diligent_EncodePngToStream(pSrcPixels, Width, Height, StrideInBytes, PngColorType, CompressionLevel, pDstStream);
+}
+
 
 DECODE_JPEG_RESULT DecodeJpeg(const void* pSrcJpegBits,
                               size_t      JpegDataSize,
@@ -108,6 +150,15 @@ DECODE_JPEG_RESULT DecodeJpeg(const void* pSrcJpegBits,
     return Diligent_DecodeJpeg(pSrcJpegBits, JpegDataSize, pDstPixels, pDstImgDesc);
 }
 
+DECODE_JPEG_RESULT DecodeJpegRows(const void*         pSrcJpegBits,
+                                  size_t              JpegDataSize,
+                                  ImageRowHandlerType RowHandler,
+                                  void*               pUserData,
+                                  ImageDesc*          pDstImgDesc)
+{
+    return Diligent_DecodeJpegRows(pSrcJpegBits, JpegDataSize, RowHandler, pUserData, pDstImgDesc);
+}
+
 ENCODE_JPEG_RESULT EncodeJpeg(Uint8*     pSrcRGBPixels,
                               Uint32     Width,
                               Uint32     Height,
@@ -128,6 +179,13 @@ static TextureDesc TexDescFromTexLoadInfo(const TextureLoadInfo& TexLoadInfo, co
     return TexDesc;
 }
 
+// Images are decoded row by row directly into the texture data unless the loader
+// needs the entire image to check if it is uniform.
+inline bool UseImageRowDecoding(IMAGE_FILE_FORMAT FileFormat, const TextureLoadInfo& TexLoadInfo)
+{
+    return Image::IsRowDecodingSupported(FileFormat) && TexLoadInfo.UniformImageClipDim == 0;
+}
+
 TextureLoaderImpl::TextureLoaderImpl(IReferenceCounters*      pRefCounters,
                                      const TextureLoadInfo&   TexLoadInfo,
                                      const Uint8*             pData,
@@ -136,7 +194,9 @@ TextureLoaderImpl::TextureLoaderImpl(IReferenceCounters*      pRefCounters,
     TBase{pRefCounters},
     m_pDataBlob{std::move(pDataBlob)},
     m_Name{TexLoadInfo.Name != nullptr ? TexLoadInfo.Name : ""},
-    m_TexDesc{TexDescFromTexLoadInfo(TexLoadInfo, m_Name)}
+    m_TexDesc{TexDescFromTexLoadInfo(TexLoadInfo, m_Name)},
+    m_DecompressUnsupportedBC{TexLoadInfo.DecompressUnsupportedBC},
+    m_pThreadPool{TexLoadInfo.DecompressUnsupportedBC ? TexLoadInfo.pThreadPool : nullptr}
 {
     const IMAGE_FILE_FORMAT ImgFileFormat = Image::GetFileFormat(pData, DataSize);
     if (ImgFileFormat == IMAGE_FILE_FORMAT_UNKNOWN)
@@ -144,7 +204,11 @@ TextureLoaderImpl::TextureLoaderImpl(IReferenceCounters*      pRefCounters,
         LOG_ERROR_AND_THROW("Unable to derive image format.");
     }
 
-    if (Image::IsSupportedFileFormat(ImgFileFormat))
+    if (UseImageRowDecoding(ImgFileFormat, TexLoadInfo))
+    {
+        LoadFromImageRows(ImgFileFormat, pData, DataSize, TexLoadInfo);
+    }
+    else if (Image::IsSupportedFileFormat(ImgFileFormat))
     {
         ImageLoadInfo ImgLoadInfo;
         ImgLoadInfo.Format           = ImgFileFormat;
@@ -175,18 +239,113 @@ TextureLoaderImpl::TextureLoaderImpl(IReferenceCounters*    pRefCounters,
                                      RefCntAutoPtr<Image>   pImage) :
     TBase{pRefCounters},
     m_Name{TexLoadInfo.Name != nullptr ? TexLoadInfo.Name : ""},
-    m_TexDesc{TexDescFromTexLoadInfo(TexLoadInfo, m_Name)}
+    m_TexDesc{TexDescFromTexLoadInfo(TexLoadInfo, m_Name)},
+    m_DecompressUnsupportedBC{TexLoadInfo.DecompressUnsupportedBC},
+    m_pThreadPool{TexLoadInfo.DecompressUnsupportedBC ? TexLoadInfo.pThreadPool : nullptr}
 {
     LoadFromImage(std::move(pImage), TexLoadInfo);
 }
 
+TextureLoaderImpl::TextureLoaderImpl(IReferenceCounters*    pRefCounters,
+                                     const TextureLoadInfo& TexLoadInfo,
+                                     IFileStream*           pDDSFileStream) :
+    TBase{pRefCounters},
+    m_Name{TexLoadInfo.Name != nullptr ? TexLoadInfo.Name : ""},
+    m_TexDesc{TexDescFromTexLoadInfo(TexLoadInfo, m_Name)},
+    m_DecompressUnsupportedBC{TexLoadInfo.DecompressUnsupportedBC},
+    m_pThreadPool{TexLoadInfo.DecompressUnsupportedBC ? TexLoadInfo.pThreadPool : nullptr}
+{
+    LoadFromDDS(TexLoadInfo, pDDSFileStream);
+
+    if (TexLoadInfo.IsSRGB)
+    {
+        m_TexDesc.Format = UnormFormatToSRGB(m_TexDesc.Format);
+    }
+}
+
 void TextureLoaderImpl::CreateTexture(IRenderDevice* pDevice,
                                       ITexture**     ppTexture)
 {
+    if (m_DecompressUnsupportedBC &&
+        GetBCDecompressedFormat(m_TexDesc.Format) != TEX_FORMAT_UNKNOWN &&
+        !pDevice->GetTextureFormatInfo(m_TexDesc.Format).Supported)
+    {
+        CreateDecompressedTexture(pDevice, ppTexture);
+        return;
+    }
+
     TextureData InitData = GetTextureData();
     pDevice->CreateTexture(m_TexDesc, &InitData, ppTexture);
 }
 
+void TextureLoaderImpl::CreateDecompressedTexture(IRenderDevice* pDevice,
+                                                  ITexture**     ppTexture)
+{
+    TextureDesc TexDesc = m_TexDesc;
+    TexDesc.Format      = GetBCDecompressedFormat(m_TexDesc.Format);
+    LOG_INFO_MESSAGE("Format ", GetTextureFormatAttribs(m_TexDesc.Format).Name, " of texture '", m_Name,
+                     "' is not supported by the device. The texture will be decompressed to ", GetTextureFormatAttribs(TexDesc.Format).Name, '.');
+
+    std::vector<TextureSubResData>        SubResources(m_SubResources.size());
+    std::vector<RefCntAutoPtr<IDataBlob>> Mips(m_SubResources.size());
+    for (Uint32 slice = 0; slice < TexDesc.GetArraySize(); ++slice)
+    {
+        for (Uint32 mip = 0; mip < TexDesc.MipLevels; ++mip)
+        {
+            const Uint32             SubResIndex = slice * TexDesc.MipLevels + mip;
+            const TextureSubResData& SrcSubRes   = m_SubResources[SubResIndex];
+            const MipLevelProperties MipProps    = GetMipLevelProperties(TexDesc, mip);
+
+            Mips[SubResIndex] = DataBlobImpl::Create(StaticCast<size_t>(MipProps.MipSize));
+
+            TextureSubResData& DstSubRes = SubResources[SubResIndex];
+            DstSubRes.pData              = Mips[SubResIndex]->GetDataPtr();
+            DstSubRes.Stride             = MipProps.RowSize;
+            DstSubRes.DepthStride        = MipProps.DepthSliceSize;
+
+            for (Uint32 z = 0; z < MipProps.Depth; ++z)
+            {
+                DecompressBCSurfaceAttribs DecompressAttribs;
+                DecompressAttribs.Format      = m_TexDesc.Format;
+                DecompressAttribs.Width       = MipProps.LogicalWidth;
+                DecompressAttribs.Height      = MipProps.LogicalHeight;
+                DecompressAttribs.pSrcData    = static_cast<const Uint8*>(SrcSubRes.pData) + z * SrcSubRes.DepthStride;
+                DecompressAttribs.SrcStride   = SrcSubRes.Stride;
+                DecompressAttribs.pDstData    = Mips[SubResIndex]->GetDataPtr<Uint8>() + z * MipProps.DepthSliceSize;
+                DecompressAttribs.DstStride   = MipProps.RowSize;
+                DecompressAttribs.pThreadPool = m_pThreadPool;
+                VERIFY_EXPR(DecompressAttribs.pSrcData != nullptr);
+                DecompressBCSurface(DecompressAttribs);
+            }
+        }
+    }
+
+    TextureData InitData{SubResources.data(), static_cast<Uint32>(SubResources.size())};
+    pDevice->CreateTexture(TexDesc, &InitData, ppTexture);
+}
+
+Uint32 SelectMipRange(TextureDesc& TexDesc, const TextureLoadInfo& TexLoadInfo)
+{
+    const Uint32 SrcMipLevels = TexDesc.MipLevels;
+    const Uint32 FirstMip     = TexLoadInfo.FirstMipLevel;
+    if (FirstMip >= SrcMipLevels)
+        LOG_ERROR_AND_THROW("First mip level (", FirstMip, ") is out of range: the texture only has ", SrcMipLevels, " mip levels");
+
+    TexDesc.MipLevels = SrcMipLevels - FirstMip;
+    if (TexLoadInfo.MipLevels > 0)
+        TexDesc.MipLevels = std::min(TexDesc.MipLevels, TexLoadInfo.MipLevels);
+
+    if (FirstMip > 0)
+    {
+        TexDesc.Width  = std::max(TexDesc.Width >> FirstMip, 1u);
+        TexDesc.Height = std::max(TexDesc.Height >> FirstMip, 1u);
+        if (TexDesc.Is3D())
+            TexDesc.Depth = std::max(TexDesc.Depth >> FirstMip, 1u);
+    }
+
+    return FirstMip;
+}
+
 static void TexDescFromImageDesc(const ImageDesc& ImgDesc, const TextureLoadInfo& TexLoadInfo, TextureDesc& TexDesc)
 {
     TexDesc.Type      = RESOURCE_DIM_TEX_2D;
@@ -226,6 +385,154 @@ inline bool GetSwizzleRequired(Uint32 NumComponents, const TextureComponentMappi
             (NumComponents >= 4 && Swizzle.A != TEXTURE_COMPONENT_SWIZZLE_IDENTITY && Swizzle.A != TEXTURE_COMPONENT_SWIZZLE_A));
 }
 
+// Returns the attributes that copy image pixels to the top mip level of the texture
+// expanding the number of components and applying the swizzle.
+static CopyPixelsAttribs GetImageCopyAttribs(const ImageDesc& ImgDesc, const TextureFormatAttribs& TexFmtDesc, const TextureLoadInfo& TexLoadInfo)
+{
+    CopyPixelsAttribs CopyAttribs;
+    CopyAttribs.Width            = ImgDesc.Width;
+    CopyAttribs.Height           = ImgDesc.Height;
+    CopyAttribs.SrcComponentSize = GetValueSize(ImgDesc.ComponentType);
+    CopyAttribs.SrcStride        = ImgDesc.RowStride;
+    CopyAttribs.SrcCompCount     = ImgDesc.NumComponents;
+    CopyAttribs.DstComponentSize = TexFmtDesc.ComponentSize;
+    CopyAttribs.DstCompCount     = TexFmtDesc.NumComponents;
+    CopyAttribs.FlipVertically   = TexLoadInfo.FlipVertically;
+
+    if (CopyAttribs.SrcCompCount < 4)
+    {
+        // Always set alpha to 1 (except for float formats)
+        CopyAttribs.Swizzle.A = TexFmtDesc.ComponentType != COMPONENT_TYPE_FLOAT ?
+            TEXTURE_COMPONENT_SWIZZLE_ONE :
+            TEXTURE_COMPONENT_SWIZZLE_ZERO;
+        if (CopyAttribs.SrcCompCount == 1)
+        {
+            // Expand R to RGB
+            CopyAttribs.Swizzle.R = TEXTURE_COMPONENT_SWIZZLE_R;
+            CopyAttribs.Swizzle.G = TEXTURE_COMPONENT_SWIZZLE_R;
+            CopyAttribs.Swizzle.B = TEXTURE_COMPONENT_SWIZZLE_R;
+        }
+        else if (CopyAttribs.SrcCompCount == 2)
+        {
+            // RG -> RG01
+            CopyAttribs.Swizzle.B = TEXTURE_COMPONENT_SWIZZLE_ZERO;
+        }
+        else
+        {
+            VERIFY(CopyAttribs.SrcCompCount == 3, "Unexpected number of components");
+        }
+    }
+
+    // Combine swizzles
+    if (GetSwizzleRequired(TexFmtDesc.NumComponents, TexLoadInfo.Swizzle))
+    {
+        CopyAttribs.Swizzle *= TexLoadInfo.Swizzle;
+    }
+
+    return CopyAttribs;
+}
+
+// Number of coarse mip rows that ImageMipGenerator computes at once.
+constexpr Uint32 MipGeneratorStripHeight = 4;
+
+// Computes the coarse mip levels of an image texture from the finer levels.
+//
+// The coarse rows are computed as soon as the rows of the finer level they depend on
+// are available, so that the mip chain is generated while the top level is being decoded
+// and the fine rows are still in cache. Every strip of coarse rows starts at a multiple of
+// MipGeneratorStripHeight, which makes the result identical to filtering the entire level
+// (the most-frequent filter uses the row index to break ties).
+class ImageMipGenerator
+{
+public:
+    ImageMipGenerator(const TextureDesc&                           TexDesc,
+                      const std::vector<TextureSubResData>&        SubResources,
+                      const std::vector<RefCntAutoPtr<IDataBlob>>& Mips,
+                      const TextureLoadInfo&                       TexLoadInfo) :
+        m_TexDesc{TexDesc},
+        m_SubResources{SubResources},
+        m_Mips{Mips},
+        m_FilterType{static_cast<MIP_FILTER_TYPE>(TexLoadInfo.MipFilter)},
+        m_AlphaCutoff{TexLoadInfo.AlphaCutoff},
+        m_ReadyRows(TexDesc.MipLevels)
+    {
+        static_assert(MIP_FILTER_TYPE_DEFAULT == static_cast<MIP_FILTER_TYPE>(TEXTURE_LOAD_MIP_FILTER_DEFAULT), "Inconsistent enum values");
+        static_assert(MIP_FILTER_TYPE_BOX_AVERAGE == static_cast<MIP_FILTER_TYPE>(TEXTURE_LOAD_MIP_FILTER_BOX_AVERAGE), "Inconsistent enum values");
+        static_assert(MIP_FILTER_TYPE_MOST_FREQUENT == static_cast<MIP_FILTER_TYPE>(TEXTURE_LOAD_MIP_FILTER_MOST_FREQUENT), "Inconsistent enum values");
+    }
+
+    // Computes all coarse rows that depend on the first NumTopRows rows of the top mip level.
+    void Update(Uint32 NumTopRows)
+    {
+        m_ReadyRows[0] = NumTopRows;
+        for (Uint32 m = 1; m < m_TexDesc.MipLevels; ++m)
+        {
+            const MipLevelProperties FineMipProps    = GetMipLevelProperties(m_TexDesc, m - 1);
+            const Uint32             FineMipHeight   = FineMipProps.LogicalHeight;
+            const Uint32             CoarseMipHeight = std::max(FineMipHeight / 2, 1u);
+
+            Uint32& CoarseRows = m_ReadyRows[m];
+            while (CoarseRows < CoarseMipHeight)
+            {
+                const Uint32 NumCoarseRows = std::min(CoarseMipHeight - CoarseRows, MipGeneratorStripHeight);
+                const Uint32 NumFineRows   = FineMipHeight > 1 ? NumCoarseRows * 2 : 1;
+                if (CoarseRows * 2 + NumFineRows > m_ReadyRows[m - 1])
+                    break;
+
+                ComputeMipLevelAttribs Attribs;
+                Attribs.Format          = m_TexDesc.Format;
+                Attribs.FineMipWidth    = FineMipProps.LogicalWidth;
+                Attribs.FineMipHeight   = NumFineRows;
+                Attribs.FineMipStride   = StaticCast<size_t>(m_SubResources[m - 1].Stride);
+                Attribs.pFineMipData    = static_cast<const Uint8*>(m_SubResources[m - 1].pData) + Attribs.FineMipStride * CoarseRows * 2;
+                Attribs.CoarseMipStride = StaticCast<size_t>(m_SubResources[m].Stride);
+                Attribs.pCoarseMipData  = m_Mips[m]->GetDataPtr<Uint8>() + Attribs.CoarseMipStride * CoarseRows;
+                Attribs.FilterType      = m_FilterType;
+                Attribs.AlphaCutoff     = m_AlphaCutoff;
+                ComputeMipLevel(Attribs);
+
+                CoarseRows += NumCoarseRows;
+            }
+        }
+    }
+
+    // Computes all remaining coarse rows.
+    void Finish()
+    {
+        Update(m_TexDesc.Height);
+    }
+
+private:
+    const TextureDesc&                           m_TexDesc;
+    const std::vector<TextureSubResData>&        m_SubResources;
+    const std::vector<RefCntAutoPtr<IDataBlob>>& m_Mips;
+
+    const MIP_FILTER_TYPE m_FilterType;
+    const float           m_AlphaCutoff;
+
+    // The number of rows of each mip level that have been computed
+    std::vector<Uint32> m_ReadyRows;
+};
+
+void TextureLoaderImpl::AllocateImageMips(Uint32 FirstMip, const TextureLoadInfo& TexLoadInfo)
+{
+    for (Uint32 m = FirstMip; m < m_TexDesc.MipLevels; ++m)
+    {
+        const MipLevelProperties MipLevelProps = GetMipLevelProperties(m_TexDesc, m);
+
+        Uint64 MipSize = MipLevelProps.MipSize;
+        Uint64 RowSize = MipLevelProps.RowSize;
+        if ((RowSize % 4) != 0)
+        {
+            RowSize = AlignUp(RowSize, Uint64{4});
+            MipSize = RowSize * MipLevelProps.LogicalHeight;
+        }
+        m_Mips[m]                = DataBlobImpl::Create(TexLoadInfo.pAllocator, StaticCast<size_t>(MipSize));
+        m_SubResources[m].pData  = m_Mips[m]->GetDataPtr();
+        m_SubResources[m].Stride = RowSize;
+    }
+}
+
 void TextureLoaderImpl::LoadFromImage(RefCntAutoPtr<Image> pImage, const TextureLoadInfo& TexLoadInfo)
 {
     VERIFY_EXPR(pImage != nullptr);
@@ -252,55 +559,12 @@ void TextureLoaderImpl::LoadFromImage(RefCntAutoPtr<Image> pImage, const Texture
         TexLoadInfo.FlipVertically ||
         SwizzleRequired)
     {
-        Uint32 DstStride         = ImgDesc.Width * NumComponents * TexFmtDesc.ComponentSize;
-        DstStride                = AlignUp(DstStride, Uint32{4});
-        m_Mips[0]                = DataBlobImpl::Create(TexLoadInfo.pAllocator, size_t{DstStride} * size_t{ImgDesc.Height});
-        m_SubResources[0].pData  = m_Mips[0]->GetDataPtr();
-        m_SubResources[0].Stride = DstStride;
-
-        CopyPixelsAttribs CopyAttribs;
-        CopyAttribs.Width            = ImgDesc.Width;
-        CopyAttribs.Height           = ImgDesc.Height;
-        CopyAttribs.SrcComponentSize = SrcCompSize;
-        CopyAttribs.pSrcPixels       = pImage->GetData()->GetConstDataPtr();
-        CopyAttribs.SrcStride        = ImgDesc.RowStride;
-        CopyAttribs.SrcCompCount     = ImgDesc.NumComponents;
-        CopyAttribs.pDstPixels       = m_Mips[0]->GetDataPtr();
-        CopyAttribs.DstComponentSize = TexFmtDesc.ComponentSize;
-        CopyAttribs.DstStride        = DstStride;
-        CopyAttribs.DstCompCount     = NumComponents;
-        CopyAttribs.FlipVertically   = TexLoadInfo.FlipVertically;
-
-        if (CopyAttribs.SrcCompCount < 4)
-        {
-            // Always set alpha to 1 (except for float formats)
-            CopyAttribs.Swizzle.A = TexFmtDesc.ComponentType != COMPONENT_TYPE_FLOAT ?
-                TEXTURE_COMPONENT_SWIZZLE_ONE :
-                TEXTURE_COMPONENT_SWIZZLE_ZERO;
-            if (CopyAttribs.SrcCompCount == 1)
-            {
-                // Expand R to RGB
-                CopyAttribs.Swizzle.R = TEXTURE_COMPONENT_SWIZZLE_R;
-                CopyAttribs.Swizzle.G = TEXTURE_COMPONENT_SWIZZLE_R;
-                CopyAttribs.Swizzle.B = TEXTURE_COMPONENT_SWIZZLE_R;
-            }
-            else if (CopyAttribs.SrcCompCount == 2)
-            {
-                // RG -> RG01
-                CopyAttribs.Swizzle.B = TEXTURE_COMPONENT_SWIZZLE_ZERO;
-            }
-            else
-            {
-                VERIFY(CopyAttribs.SrcCompCount == 3, "Unexpected number of components");
-            }
-        }
-
-        // Combine swizzles
-        if (SwizzleRequired)
-        {
-            CopyAttribs.Swizzle *= TexLoadInfo.Swizzle;
-        }
+        AllocateImageMips(0, TexLoadInfo);
 
+        CopyPixelsAttribs CopyAttribs = GetImageCopyAttribs(ImgDesc, TexFmtDesc, TexLoadInfo);
+        CopyAttribs.pSrcPixels        = pImage->GetData()->GetConstDataPtr();
+        CopyAttribs.pDstPixels        = m_Mips[0]->GetDataPtr();
+        CopyAttribs.DstStride         = StaticCast<Uint32>(m_SubResources[0].Stride);
         CopyPixels(CopyAttribs);
         // Release original image
         pImage.Release();
@@ -312,55 +576,170 @@ void TextureLoaderImpl::LoadFromImage(RefCntAutoPtr<Image> pImage, const Texture
         m_pImage                 = std::move(pImage);
         m_SubResources[0].pData  = m_pImage->GetData()->GetConstDataPtr();
         m_SubResources[0].Stride = ImgDesc.RowStride;
+
+        AllocateImageMips(1, TexLoadInfo);
     }
 
-    for (Uint32 m = 1; m < m_TexDesc.MipLevels; ++m)
+    if (TexLoadInfo.GenerateMips)
     {
-        const MipLevelProperties MipLevelProps = GetMipLevelProperties(m_TexDesc, m);
+        ImageMipGenerator{m_TexDesc, m_SubResources, m_Mips, TexLoadInfo}.Finish();
+    }
 
-        Uint64 MipSize = MipLevelProps.MipSize;
-        Uint64 RowSize = MipLevelProps.RowSize;
-        if ((RowSize % 4) != 0)
-        {
-            RowSize = AlignUp(RowSize, Uint64{4});
-            MipSize = RowSize * MipLevelProps.LogicalHeight;
-        }
-        m_Mips[m]                = DataBlobImpl::Create(TexLoadInfo.pAllocator, StaticCast<size_t>(MipSize));
-        m_SubResources[m].pData  = m_Mips[m]->GetDataPtr();
-        m_SubResources[m].Stride = RowSize;
+    if (TexLoadInfo.CompressMode != TEXTURE_LOAD_COMPRESS_MODE_NONE)
+    {
+        CompressSubresources(NumComponents, ImgDesc.NumComponents, TexLoadInfo);
+    }
+}
+
+void TextureLoaderImpl::LoadFromImageRows(IMAGE_FILE_FORMAT FileFormat, const Uint8* pData, size_t DataSize, const TextureLoadInfo& TexLoadInfo)
+{
+    // Only decodes the image header
+    const ImageDesc ImgDesc = Image::GetDesc(FileFormat, pData, DataSize);
+    if (ImgDesc.Width == 0 || ImgDesc.Height == 0 || ImgDesc.NumComponents == 0)
+    {
+        LOG_ERROR_AND_THROW("Failed to decode image description.");
+    }
+
+    // Note: do not override Name field in m_TexDesc
+    TexDescFromImageDesc(ImgDesc, TexLoadInfo, m_TexDesc);
+
+    const TextureFormatAttribs& TexFmtDesc = GetTextureFormatAttribs(m_TexDesc.Format);
+
+    m_SubResources.resize(m_TexDesc.MipLevels);
+    m_Mips.resize(m_TexDesc.MipLevels);
+    AllocateImageMips(0, TexLoadInfo);
 
-        if (TexLoadInfo.GenerateMips)
+    ImageMipGenerator MipGenerator{m_TexDesc, m_SubResources, m_Mips, TexLoadInfo};
+
+    // Decoded rows are converted to the texture format one by one, so that the
+    // full-resolution decoded image is never kept in memory.
+    struct RowHandlerData
+    {
+        CopyPixelsAttribs       CopyAttribs;
+        PremultiplyAlphaAttribs PremultAttribs;
+        std::vector<Uint8>      PremultRow;
+        Uint8*                  pDstData       = nullptr;
+        size_t                  DstStride      = 0;
+        Uint32                  Height         = 0;
+        bool                    FlipVertically = false;
+        ImageMipGenerator*      pMipGenerator  = nullptr;
+    };
+
+    RowHandlerData HandlerData;
+    HandlerData.CopyAttribs                = GetImageCopyAttribs(ImgDesc, TexFmtDesc, TexLoadInfo);
+    HandlerData.CopyAttribs.Height         = 1;
+    HandlerData.CopyAttribs.FlipVertically = false;
+    HandlerData.CopyAttribs.DstStride      = StaticCast<Uint32>(m_SubResources[0].Stride);
+    HandlerData.pDstData                   = m_Mips[0]->GetDataPtr<Uint8>();
+    HandlerData.DstStride                  = StaticCast<size_t>(m_SubResources[0].Stride);
+    HandlerData.Height                     = ImgDesc.Height;
+    HandlerData.FlipVertically             = TexLoadInfo.FlipVertically;
+    if (TexLoadInfo.GenerateMips && !TexLoadInfo.FlipVertically)
+    {
+        // When the image is flipped, the rows are written from the bottom up,
+        // so the mip levels are generated after the entire image is decoded.
+        HandlerData.pMipGenerator = &MipGenerator;
+    }
+    if (TexLoadInfo.PermultiplyAlpha && ImgDesc.NumComponents == 4)
+    {
+        HandlerData.PremultRow.resize(size_t{ImgDesc.Width} * ImgDesc.NumComponents * GetValueSize(ImgDesc.ComponentType));
+        HandlerData.PremultAttribs.Width          = ImgDesc.Width;
+        HandlerData.PremultAttribs.Height         = 1;
+        HandlerData.PremultAttribs.ComponentType  = ImgDesc.ComponentType;
+        HandlerData.PremultAttribs.ComponentCount = ImgDesc.NumComponents;
+        HandlerData.PremultAttribs.Stride         = static_cast<Uint32>(HandlerData.PremultRow.size());
+        HandlerData.PremultAttribs.pPixels        = HandlerData.PremultRow.data();
+        HandlerData.PremultAttribs.IsSRGB         = TexLoadInfo.IsSRGB;
+    }
+
+    ImageRowHandlerType RowHandler = [](void* pUserData, Uint32 Row, const void* pRowData) {
+        RowHandlerData& Data = *static_cast<RowHandlerData*>(pUserData);
+        if (Row >= Data.Height)
+            return false;
+
+        if (!Data.PremultRow.empty())
         {
-            MipLevelProperties FinerMipProps = GetMipLevelProperties(m_TexDesc, m - 1);
-            if (TexLoadInfo.GenerateMips)
-            {
-                ComputeMipLevelAttribs Attribs;
-                Attribs.Format          = m_TexDesc.Format;
-                Attribs.FineMipWidth    = FinerMipProps.LogicalWidth;
-                Attribs.FineMipHeight   = FinerMipProps.LogicalHeight;
-                Attribs.pFineMipData    = m_SubResources[m - 1].pData;
-                Attribs.FineMipStride   = StaticCast<size_t>(m_SubResources[m - 1].Stride);
-                Attribs.pCoarseMipData  = m_Mips[m]->GetDataPtr();
-                Attribs.CoarseMipStride = StaticCast<size_t>(m_SubResources[m].Stride);
-                Attribs.AlphaCutoff     = TexLoadInfo.AlphaCutoff;
-                static_assert(MIP_FILTER_TYPE_DEFAULT == static_cast<MIP_FILTER_TYPE>(TEXTURE_LOAD_MIP_FILTER_DEFAULT), "Inconsistent enum values");
-                static_assert(MIP_FILTER_TYPE_BOX_AVERAGE == static_cast<MIP_FILTER_TYPE>(TEXTURE_LOAD_MIP_FILTER_BOX_AVERAGE), "Inconsistent enum values");
-                static_assert(MIP_FILTER_TYPE_MOST_FREQUENT == static_cast<MIP_FILTER_TYPE>(TEXTURE_LOAD_MIP_FILTER_MOST_FREQUENT), "Inconsistent enum values");
-                Attribs.FilterType = static_cast<MIP_FILTER_TYPE>(TexLoadInfo.MipFilter);
-                ComputeMipLevel(Attribs);
-            }
+            memcpy(Data.PremultRow.data(), pRowData, Data.PremultRow.size());
+            PremultiplyAlpha(Data.PremultAttribs);
+            pRowData = Data.PremultRow.data();
         }
+
+        const Uint32 DstRow = Data.FlipVertically ? Data.Height - 1 - Row : Row;
+
+        Data.CopyAttribs.pSrcPixels = pRowData;
+        Data.CopyAttribs.pDstPixels = Data.pDstData + Data.DstStride * DstRow;
+        CopyPixels(Data.CopyAttribs);
+
+        if (Data.pMipGenerator != nullptr)
+            Data.pMipGenerator->Update(Row + 1);
+
+        return true;
+    };
+
+    ImageDesc DecodedDesc;
+    if (!Image::DecodeRows(FileFormat, pData, DataSize, RowHandler, &HandlerData, DecodedDesc))
+    {
+        LOG_ERROR_AND_THROW("Failed to decode image.");
+    }
+    if (DecodedDesc.Width != ImgDesc.Width ||
+        DecodedDesc.Height != ImgDesc.Height ||
+        DecodedDesc.NumComponents != ImgDesc.NumComponents ||
+        DecodedDesc.ComponentType != ImgDesc.ComponentType)
+    {
+        LOG_ERROR_AND_THROW("Decoded image description does not match the image header.");
+    }
+
+    if (TexLoadInfo.GenerateMips)
+    {
+        MipGenerator.Finish();
     }
 
     if (TexLoadInfo.CompressMode != TEXTURE_LOAD_COMPRESS_MODE_NONE)
     {
-        CompressSubresources(NumComponents, ImgDesc.NumComponents, TexLoadInfo);
+        CompressSubresources(TexFmtDesc.NumComponents, ImgDesc.NumComponents, TexLoadInfo);
     }
 }
 
-inline TEXTURE_FORMAT GetCompressedTextureFormat(Uint32 NumComponents, Uint32 NumSrcComponents, bool IsSRGB)
+inline bool IsBC7CompressMode(TEXTURE_LOAD_COMPRESS_MODE CompressMode)
 {
-    switch (NumComponents)
+    return (CompressMode == TEXTURE_LOAD_COMPRESS_MODE_BC7_FAST ||
+            CompressMode == TEXTURE_LOAD_COMPRESS_MODE_BC7 ||
+            CompressMode == TEXTURE_LOAD_COMPRESS_MODE_BC7_HIGH_QUAL);
+}
+
+inline BC_COMPRESSION_QUALITY GetBCCompressionQuality(TEXTURE_LOAD_COMPRESS_MODE CompressMode)
+{
+    switch (CompressMode)
+    {
+        case TEXTURE_LOAD_COMPRESS_MODE_BC7_FAST:
+            return BC_COMPRESSION_QUALITY_FAST;
+
+        case TEXTURE_LOAD_COMPRESS_MODE_BC_HIGH_QUAL:
+        case TEXTURE_LOAD_COMPRESS_MODE_BC7_HIGH_QUAL:
+            return BC_COMPRESSION_QUALITY_HIGH;
+
+        default:
+            return BC_COMPRESSION_QUALITY_NORMAL;
+    }
+}
+
+inline TEXTURE_FORMAT GetCompressedTextureFormat(const TextureFormatAttribs& FmtAttribs, Uint32 NumSrcComponents, const TextureLoadInfo& TexLoadInfo)
+{
+    if (FmtAttribs.ComponentType == COMPONENT_TYPE_FLOAT)
+    {
+        // Float textures are only compressed to BC6H in BC7 modes.
+        // BC6H does not store alpha, so only RGB images can be compressed.
+        return (IsBC7CompressMode(TexLoadInfo.CompressMode) && FmtAttribs.NumComponents == 4 && NumSrcComponents == 3 && FmtAttribs.ComponentSize >= 2) ?
+            TEX_FORMAT_BC6H_UF16 :
+            TEX_FORMAT_UNKNOWN;
+    }
+
+    // 16-bit UNORM components are converted to 8 bits before compression
+    if (FmtAttribs.ComponentSize != 1 && !(FmtAttribs.ComponentSize == 2 && FmtAttribs.ComponentType == COMPONENT_TYPE_UNORM))
+        return TEX_FORMAT_UNKNOWN;
+
+    const bool IsSRGB = TexLoadInfo.IsSRGB;
+    switch (FmtAttribs.NumComponents)
     {
         case 1:
             return TEX_FORMAT_BC4_UNORM;
@@ -369,27 +748,37 @@ inline TEXTURE_FORMAT GetCompressedTextureFormat(Uint32 NumComponents, Uint32 Nu
             return TEX_FORMAT_BC5_UNORM;
 
         case 4:
-            if (NumSrcComponents == 4)
+            if (IsBC7CompressMode(TexLoadInfo.CompressMode))
+                return IsSRGB ? TEX_FORMAT_BC7_UNORM_SRGB : TEX_FORMAT_BC7_UNORM;
+            else if (NumSrcComponents == 4)
                 return IsSRGB ? TEX_FORMAT_BC3_UNORM_SRGB : TEX_FORMAT_BC3_UNORM;
             else
                 return IsSRGB ? TEX_FORMAT_BC1_UNORM_SRGB : TEX_FORMAT_BC1_UNORM;
             break;
 
         default:
-            UNEXPECTED("Unexpected number of components ", NumComponents);
+            UNEXPECTED("Unexpected number of components ", FmtAttribs.NumComponents);
             return TEX_FORMAT_UNKNOWN;
     }
 }
 
 void TextureLoaderImpl::CompressSubresources(Uint32 NumComponents, Uint32 NumSrcComponents, const TextureLoadInfo& TexLoadInfo)
 {
-    const TEXTURE_FORMAT CompressedFormat = GetCompressedTextureFormat(NumComponents, NumSrcComponents, TexLoadInfo.IsSRGB);
+    const TextureFormatAttribs& SrcFmtAttribs    = GetTextureFormatAttribs(m_TexDesc.Format);
+    const TEXTURE_FORMAT        CompressedFormat = GetCompressedTextureFormat(SrcFmtAttribs, NumSrcComponents, TexLoadInfo);
     if (CompressedFormat == TEX_FORMAT_UNKNOWN)
+    {
+        LOG_WARNING_MESSAGE("Texture '", (m_TexDesc.Name != nullptr ? m_TexDesc.Name : ""), "' can't be compressed: no suitable BC format for ",
+                            SrcFmtAttribs.Name, " texture with ", NumSrcComponents, "-component source. The texture will not be compressed.");
         return;
+    }
+    VERIFY_EXPR(NumComponents == SrcFmtAttribs.NumComponents);
 
     m_TexDesc.Format                       = CompressedFormat;
     const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(CompressedFormat);
 
+    const BC_COMPRESSION_QUALITY Quality = GetBCCompressionQuality(TexLoadInfo.CompressMode);
+
     std::vector<RefCntAutoPtr<IDataBlob>> CompressedMips(m_SubResources.size());
     for (Uint32 slice = 0; slice < m_TexDesc.GetArraySize(); ++slice)
     {
@@ -405,61 +794,116 @@ void TextureLoaderImpl::CompressSubresources(Uint32 NumComponents, Uint32 NumSrc
             const size_t             CompressedStride   = static_cast<size_t>(CompressedMipProps.RowSize);
             CompressedMip                               = DataBlobImpl::Create(TexLoadInfo.pAllocator, CompressedStride * CompressedMipProps.StorageHeight);
 
-            for (Uint32 row = 0; row < CompressedMipProps.StorageHeight; row += FmtAttribs.BlockHeight)
-            {
-                const Uint32 row0 = row;
-                const Uint32 row1 = std::min(row + 1, MaxRow);
-                const Uint32 row2 = std::min(row + 2, MaxRow);
-                const Uint32 row3 = std::min(row + 3, MaxRow);
-
-                for (Uint32 col = 0; col < CompressedMipProps.StorageWidth; col += FmtAttribs.BlockWidth)
+            auto CompressBlockRows = [&](Uint32 FirstBlockRow, Uint32 EndBlockRow) {
+                for (Uint32 row = FirstBlockRow * FmtAttribs.BlockHeight; row < EndBlockRow * FmtAttribs.BlockHeight; row += FmtAttribs.BlockHeight)
                 {
-                    const Uint32 col0 = col;
-                    const Uint32 col1 = std::min(col + 1, MaxCol);
-                    const Uint32 col2 = std::min(col + 2, MaxCol);
-                    const Uint32 col3 = std::min(col + 3, MaxCol);
-
-                    auto ReadBlockData = [&](auto& BlockData) {
-                        using T = typename std::decay_t<decltype(BlockData)>::value_type;
-
-                        const T*     SrcPtr    = static_cast<const T*>(SubResData.pData);
-                        const size_t SrcStride = static_cast<size_t>(SubResData.Stride) / sizeof(T);
-                        // clang-format off
-                        BlockData =
-                        {
-                            SrcPtr[col0 + SrcStride * row0], SrcPtr[col1 + SrcStride * row0], SrcPtr[col2 + SrcStride * row0], SrcPtr[col3 + SrcStride * row0],
-                            SrcPtr[col0 + SrcStride * row1], SrcPtr[col1 + SrcStride * row1], SrcPtr[col2 + SrcStride * row1], SrcPtr[col3 + SrcStride * row1],
-                            SrcPtr[col0 + SrcStride * row2], SrcPtr[col1 + SrcStride * row2], SrcPtr[col2 + SrcStride * row2], SrcPtr[col3 + SrcStride * row2],
-                            SrcPtr[col0 + SrcStride * row3], SrcPtr[col1 + SrcStride * row3], SrcPtr[col2 + SrcStride * row3], SrcPtr[col3 + SrcStride * row3]
-                        };
-                        // clang-format on
-                        return reinterpret_cast<const unsigned char*>(BlockData.data());
-                    };
+                    const Uint32 row0 = row;
+                    const Uint32 row1 = std::min(row + 1, MaxRow);
+                    const Uint32 row2 = std::min(row + 2, MaxRow);
+                    const Uint32 row3 = std::min(row + 3, MaxRow);
 
-                    Uint8* pDst = CompressedMip->GetDataPtr<Uint8>() + (col / FmtAttribs.BlockWidth) * FmtAttribs.ComponentSize + CompressedStride * (row / FmtAttribs.BlockHeight);
-                    if (NumComponents == 1)
-                    {
-                        std::array<Uint8, 16> BlockData8;
-                        stb_compress_bc4_block(pDst, ReadBlockData(BlockData8));
-                    }
-                    else if (NumComponents == 2)
-                    {
-                        std::array<Uint16, 16> BlockData16;
-                        stb_compress_bc5_block(pDst, ReadBlockData(BlockData16));
-                    }
-                    else if (NumComponents == 4)
-                    {
-                        std::array<Uint32, 16> BlockData32;
-                        const int              StbDxtMode = (TexLoadInfo.CompressMode == TEXTURE_LOAD_COMPRESS_MODE_BC_HIGH_QUAL) ? STB_DXT_HIGHQUAL : STB_DXT_NORMAL;
-                        const int              StoreAlpha = NumSrcComponents == 4 ? 1 : 0;
-                        stb_compress_dxt_block(pDst, ReadBlockData(BlockData32), StoreAlpha, StbDxtMode);
-                    }
-                    else
+                    for (Uint32 col = 0; col < CompressedMipProps.StorageWidth; col += FmtAttribs.BlockWidth)
                     {
-                        UNEXPECTED("Unexpected number of components");
+                        const Uint32 col0 = col;
+                        const Uint32 col1 = std::min(col + 1, MaxCol);
+                        const Uint32 col2 = std::min(col + 2, MaxCol);
+                        const Uint32 col3 = std::min(col + 3, MaxCol);
+
+                        auto ReadBlockData = [&](auto& BlockData) {
+                            using T = typename std::decay_t<decltype(BlockData)>::value_type;
+
+                            const T*     SrcPtr    = static_cast<const T*>(SubResData.pData);
+                            const size_t SrcStride = static_cast<size_t>(SubResData.Stride) / sizeof(T);
+                            // clang-format off
+                            BlockData =
+                            {
+                                SrcPtr[col0 + SrcStride * row0], SrcPtr[col1 + SrcStride * row0], SrcPtr[col2 + SrcStride * row0], SrcPtr[col3 + SrcStride * row0],
+                                SrcPtr[col0 + SrcStride * row1], SrcPtr[col1 + SrcStride * row1], SrcPtr[col2 + SrcStride * row1], SrcPtr[col3 + SrcStride * row1],
+                                SrcPtr[col0 + SrcStride * row2], SrcPtr[col1 + SrcStride * row2], SrcPtr[col2 + SrcStride * row2], SrcPtr[col3 + SrcStride * row2],
+                                SrcPtr[col0 + SrcStride * row3], SrcPtr[col1 + SrcStride * row3], SrcPtr[col2 + SrcStride * row3], SrcPtr[col3 + SrcStride * row3]
+                            };
+                            // clang-format on
+                            return reinterpret_cast<const unsigned char*>(BlockData.data());
+                        };
+
+                        // Reads the block of 8-bit texels, converting 16-bit UNORM source components to 8 bits
+                        auto ReadBlockData8 = [&](auto& BlockData) {
+                            if (SrcFmtAttribs.ComponentSize == 1)
+                                return ReadBlockData(BlockData);
+
+                            using T                        = typename std::decay_t<decltype(BlockData)>::value_type;
+                            constexpr size_t NumTexelComps = sizeof(T);
+                            VERIFY_EXPR(NumTexelComps == NumComponents);
+
+                            const Uint16* SrcPtr    = static_cast<const Uint16*>(SubResData.pData);
+                            const size_t  SrcStride = static_cast<size_t>(SubResData.Stride) / sizeof(Uint16);
+                            const Uint32  Rows[]    = {row0, row1, row2, row3};
+                            const Uint32  Cols[]    = {col0, col1, col2, col3};
+
+                            Uint8* pDst8 = reinterpret_cast<Uint8*>(BlockData.data());
+                            for (Uint32 y = 0; y < 4; ++y)
+                            {
+                                for (Uint32 x = 0; x < 4; ++x)
+                                {
+                                    const Uint16* pSrcTexel = SrcPtr + Cols[x] * NumTexelComps + SrcStride * Rows[y];
+                                    for (size_t c = 0; c < NumTexelComps; ++c)
+                                        *(pDst8++) = static_cast<Uint8>((Uint32{pSrcTexel[c]} * 255u + 32767u) / 65535u);
+                                }
+                            }
+                            return reinterpret_cast<const unsigned char*>(BlockData.data());
+                        };
+
+                        Uint8* pDst = CompressedMip->GetDataPtr<Uint8>() + (col / FmtAttribs.BlockWidth) * FmtAttribs.ComponentSize + CompressedStride * (row / FmtAttribs.BlockHeight);
+                        if (CompressedFormat == TEX_FORMAT_BC6H_UF16)
+                        {
+                            if (SrcFmtAttribs.ComponentSize == 4)
+                            {
+                                std::array<std::array<float, 4>, 16> BlockDataF32;
+                                CompressBC6HBlock(reinterpret_cast<const float*>(ReadBlockData(BlockDataF32)), pDst, 4, Quality);
+                            }
+                            else
+                            {
+                                std::array<std::array<Uint16, 4>, 16> BlockDataF16;
+                                CompressBC6HBlockHalf(reinterpret_cast<const Uint16*>(ReadBlockData(BlockDataF16)), pDst, 4, Quality);
+                            }
+                        }
+                        else if (NumComponents == 1)
+                        {
+                            std::array<Uint8, 16> BlockData8;
+                            stb_compress_bc4_block(pDst, ReadBlockData8(BlockData8));
+                        }
+                        else if (NumComponents == 2)
+                        {
+                            std::array<Uint16, 16> BlockData16;
+                            stb_compress_bc5_block(pDst, ReadBlockData8(BlockData16));
+                        }
+                        else if (NumComponents == 4)
+                        {
+                            std::array<Uint32, 16> BlockData32;
+                            if (CompressedFormat == TEX_FORMAT_BC7_UNORM || CompressedFormat == TEX_FORMAT_BC7_UNORM_SRGB)
+                            {
+                                CompressBC7Block(ReadBlockData8(BlockData32), pDst, Quality);
+                            }
+                            else
+                            {
+                                const int StbDxtMode = (TexLoadInfo.CompressMode == TEXTURE_LOAD_COMPRESS_MODE_BC_HIGH_QUAL) ? STB_DXT_HIGHQUAL : STB_DXT_NORMAL;
+                                const int StoreAlpha = NumSrcComponents == 4 ? 1 : 0;
+                                stb_compress_dxt_block(pDst, ReadBlockData8(BlockData32), StoreAlpha, StbDxtMode);
+                            }
+                        }
+                        else
+                        {
+                            UNEXPECTED("Unexpected number of components");
+                        }
                     }
                 }
-            }
+            };
+
+            const Uint32 NumBlocksInRow = CompressedMipProps.StorageWidth / FmtAttribs.BlockWidth;
+            const Uint32 NumBlockRows   = CompressedMipProps.StorageHeight / FmtAttribs.BlockHeight;
+            // Make sure that every task compresses enough blocks to amortize the scheduling overhead
+            constexpr Uint32 MinBlocksPerTask = 1024;
+            ProcessRangeInParallel(TexLoadInfo.pThreadPool, NumBlockRows, MinBlocksPerTask / NumBlocksInRow, CompressBlockRows);
 
             SubResData.pData  = CompressedMip->GetDataPtr();
             SubResData.Stride = CompressedStride;
@@ -482,24 +926,55 @@ void CreateTextureLoaderFromFile(const char*            FilePath,
                                  const TextureLoadInfo& TexLoadInfo,
                                  ITextureLoader**       ppLoader)
 {
+    RefCntAutoPtr<BasicFileStream> pFileStream = BasicFileStream::Create(FilePath, EFileAccessMode::Read);
+    if (!pFileStream || !pFileStream->IsValid())
+    {
+        LOG_ERROR("Failed to create texture loader from file: failed to open file '", FilePath, "'.");
+        return;
+    }
+
+    CreateTextureLoaderFromStream(pFileStream, TexLoadInfo, ppLoader);
+}
+
+void CreateTextureLoaderFromStream(IFileStream*           pFileStream,
+                                   const TextureLoadInfo& TexLoadInfo,
+                                   ITextureLoader**       ppLoader)
+{
+    DEV_CHECK_ERR(pFileStream != nullptr, "File stream must not be null");
     try
     {
-        FileWrapper File{FilePath, EFileAccessMode::Read};
-        if (!File)
-            LOG_ERROR_AND_THROW("Failed to open file '", FilePath, "'.");
+        if (!pFileStream->IsValid())
+            LOG_ERROR_AND_THROW("File stream is not valid.");
+
+        const size_t StreamSize = pFileStream->GetSize();
+
+        // The longest signature that Image::GetFileFormat checks is 12 bytes long
+        Uint8        Signature[16] = {};
+        const size_t SignatureSize = std::min(StreamSize, sizeof(Signature));
+        if (!pFileStream->SetPos(0, static_cast<int>(FilePosOrigin::Start)) || !pFileStream->Read(Signature, SignatureSize))
+            LOG_ERROR_AND_THROW("Failed to read file signature.");
+
+        RefCntAutoPtr<ITextureLoader> pTexLoader;
+        if (Image::GetFileFormat(Signature, SignatureSize) == IMAGE_FILE_FORMAT_DDS)
+        {
+            // DDS loader only reads the surfaces of the requested mip levels
+            pTexLoader = MakeNewRCObj<TextureLoaderImpl>()(TexLoadInfo, pFileStream);
+        }
+        else
+        {
+            RefCntAutoPtr<DataBlobImpl> pFileData = DataBlobImpl::Create(TexLoadInfo.pAllocator, StreamSize);
+            if (!pFileStream->SetPos(0, static_cast<int>(FilePosOrigin::Start)) || !pFileStream->Read(pFileData->GetDataPtr(), StreamSize))
+                LOG_ERROR_AND_THROW("Failed to read file data.");
 
-        RefCntAutoPtr<DataBlobImpl> pFileData = DataBlobImpl::Create(TexLoadInfo.pAllocator);
-        File->Read(pFileData);
+            pTexLoader = MakeNewRCObj<TextureLoaderImpl>()(TexLoadInfo, pFileData->GetConstDataPtr<Uint8>(), pFileData->GetSize(), std::move(pFileData));
+        }
 
-        RefCntAutoPtr<TextureLoaderImpl> pTexLoader{
-            MakeNewRCObj<TextureLoaderImpl>()(TexLoadInfo, pFileData->GetConstDataPtr<Uint8>(), pFileData->GetSize(), std::move(pFileData)),
-        };
         if (pTexLoader)
             pTexLoader->QueryInterface(IID_TextureLoader, reinterpret_cast<IObject**>(ppLoader));
     }
     catch (std::runtime_error& err)
     {
-        LOG_ERROR("Failed to create texture loader from file: ", err.what());
+        LOG_ERROR("Failed to create texture loader from stream: ", err.what());
     }
 }
 
@@ -591,31 +1066,42 @@ size_t GetTextureLoaderMemoryRequirement(const void*            pData,
         const TextureFormatAttribs& TexFmtDesc      = GetTextureFormatAttribs(TexDesc.Format);
         const bool                  SwizzleRequired = GetSwizzleRequired(TexFmtDesc.NumComponents, TexLoadInfo.Swizzle);
 
-        const size_t SrcImageDataSize = size_t{ImgDesc.Width} * ImgDesc.Height * ImgDesc.NumComponents * ImgCompSize;
-
-        // Step 1 - decode image data
-        size_t RequiredMemory = SrcImageDataSize;
+        const size_t TextureDataSize = static_cast<size_t>(GetStagingTextureDataSize(TexDesc));
 
-        // Step 2 - convert image data if needed
-        if (ImgDesc.NumComponents != TexFmtDesc.NumComponents ||
-            TexFmtDesc.ComponentSize != ImgCompSize ||
-            TexLoadInfo.FlipVertically ||
-            SwizzleRequired)
+        size_t RequiredMemory = 0;
+        if (UseImageRowDecoding(ImgFileFormat, TexLoadInfo))
         {
-            const size_t ConvertedImageDataSize = size_t{TexDesc.Width} * TexDesc.Height * TexFmtDesc.NumComponents * TexFmtDesc.ComponentSize;
-            // Original and converted data exist simultaneously
-            RequiredMemory += ConvertedImageDataSize;
-            // After conversion is done, original data is released
+            // Rows are decoded and converted directly into mip level 0, and
+            // coarser mip levels are generated while the image is being decoded.
+            RequiredMemory = TextureDataSize;
         }
+        else
+        {
+            const size_t SrcImageDataSize = size_t{ImgDesc.Width} * ImgDesc.Height * ImgDesc.NumComponents * ImgCompSize;
 
-        // Step 3 - generate mip levels
-        // Mip level 0 uses either the original image data or converted data
-        const size_t TextureDataSize = static_cast<size_t>(GetStagingTextureDataSize(TexDesc));
-        RequiredMemory               = std::max(RequiredMemory, TextureDataSize);
+            // Step 1 - decode image data
+            RequiredMemory = SrcImageDataSize;
+
+            // Step 2 - convert image data if needed
+            if (ImgDesc.NumComponents != TexFmtDesc.NumComponents ||
+                TexFmtDesc.ComponentSize != ImgCompSize ||
+                TexLoadInfo.FlipVertically ||
+                SwizzleRequired)
+            {
+                const size_t ConvertedImageDataSize = size_t{TexDesc.Width} * TexDesc.Height * TexFmtDesc.NumComponents * TexFmtDesc.ComponentSize;
+                // Original and converted data exist simultaneously
+                RequiredMemory += ConvertedImageDataSize;
+                // After conversion is done, original data is released
+            }
+
+            // Step 3 - generate mip levels
+            // Mip level 0 uses either the original image data or converted data
+            RequiredMemory = std::max(RequiredMemory, TextureDataSize);
+        }
 
         if (TexLoadInfo.CompressMode != TEXTURE_LOAD_COMPRESS_MODE_NONE)
         {
-            TexDesc.Format = GetCompressedTextureFormat(TexFmtDesc.NumComponents, ImgDesc.NumComponents, TexLoadInfo.IsSRGB);
+            TexDesc.Format = GetCompressedTextureFormat(TexFmtDesc, ImgDesc.NumComponents, TexLoadInfo);
             if (TexDesc.Format != TEX_FORMAT_UNKNOWN)
             {
                 const size_t CompressedTextureDataSize = static_cast<size_t>(GetStagingTextureDataSize(TexDesc));
@@ -626,16 +1112,82 @@ size_t GetTextureLoaderMemoryRequirement(const void*            pData,
 
         return RequiredMemory;
     }
-    else if (ImgFileFormat == IMAGE_FILE_FORMAT_DDS ||
-             ImgFileFormat == IMAGE_FILE_FORMAT_KTX)
+    else if (ImgFileFormat == IMAGE_FILE_FORMAT_DDS)
     {
         // The loader does not require any memory as the source data is used directly
         return 0;
     }
+    else if (ImgFileFormat == IMAGE_FILE_FORMAT_KTX)
+    {
+        // The source data is used directly unless KTX2 levels are supercompressed
+        try
+        {
+            TextureDesc TexDesc;
+            return ReadKTXTextureDesc(static_cast<const Uint8*>(pData), Size, TexLoadInfo, TexDesc);
+        }
+        catch (std::runtime_error&)
+        {
+            return 0;
+        }
+    }
 
     return 0;
 }
 
+Uint32 GetTextureLoaderMipLevelSizes(const void*            pData,
+                                     size_t                 Size,
+                                     const TextureLoadInfo& TexLoadInfo,
+                                     Uint64*                pMipLevelSizes,
+                                     Uint32                 MaxMipLevels)
+{
+    TextureDesc TexDesc;
+    try
+    {
+        const IMAGE_FILE_FORMAT ImgFileFormat = Image::GetFileFormat(static_cast<const Uint8*>(pData), Size);
+        if (Image::IsSupportedFileFormat(ImgFileFormat))
+        {
+            const ImageDesc ImgDesc = Image::GetDesc(ImgFileFormat, pData, Size);
+            TexDescFromImageDesc(ImgDesc, TexLoadInfo, TexDesc);
+            if (TexLoadInfo.CompressMode != TEXTURE_LOAD_COMPRESS_MODE_NONE)
+            {
+                const TEXTURE_FORMAT CompressedFormat = GetCompressedTextureFormat(GetTextureFormatAttribs(TexDesc.Format), ImgDesc.NumComponents, TexLoadInfo);
+                if (CompressedFormat != TEX_FORMAT_UNKNOWN)
+                    TexDesc.Format = CompressedFormat;
+            }
+        }
+        else if (ImgFileFormat == IMAGE_FILE_FORMAT_KTX)
+        {
+            ReadKTXTextureDesc(static_cast<const Uint8*>(pData), Size, TexLoadInfo, TexDesc);
+        }
+        else if (ImgFileFormat == IMAGE_FILE_FORMAT_DDS)
+        {
+            // DDS loader references the source data, so creating it is cheap
+            RefCntAutoPtr<TextureLoaderImpl> pTexLoader{MakeNewRCObj<TextureLoaderImpl>()(TexLoadInfo, static_cast<const Uint8*>(pData), Size, RefCntAutoPtr<IDataBlob>{})};
+            TexDesc = pTexLoader->GetTextureDesc();
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    catch (std::runtime_error& err)
+    {
+        LOG_ERROR("Failed to read texture description: ", err.what());
+        return 0;
+    }
+
+    if (pMipLevelSizes != nullptr)
+    {
+        for (Uint32 mip = 0; mip < std::min(TexDesc.MipLevels, MaxMipLevels); ++mip)
+        {
+            const MipLevelProperties MipProps = GetMipLevelProperties(TexDesc, mip);
+            pMipLevelSizes[mip]               = MipProps.MipSize * TexDesc.GetArraySize();
+        }
+    }
+
+    return TexDesc.MipLevels;
+}
+
 } // namespace Diligent
 
 extern "C"
@@ -648,6 +1200,13 @@ extern "C"
         Diligent::CreateTextureLoaderFromFile(FilePath, FileFormat, TexLoadInfo, ppLoader);
     }
 
+    void Diligent_CreateTextureLoaderFromStream(Diligent::IFileStream*           pFileStream,
+                                                const Diligent::TextureLoadInfo& TexLoadInfo,
+                                                Diligent::ITextureLoader**       ppLoader)
+    {
+        Diligent::CreateTextureLoaderFromStream(pFileStream, TexLoadInfo, ppLoader);
+    }
+
     void Diligent_CreateTextureLoaderFromMemory(const void*                      pData,
                                                 size_t                           Size,
                                                 bool                             MakeCopy,
@@ -671,4 +1230,13 @@ extern "C"
     {
         return Diligent::GetTextureLoaderMemoryRequirement(pData, Size, TexLoadInfo);
     }
+
+    Diligent::Uint32 Diligent_GetTextureLoaderMipLevelSizes(const void*                      pData,
+                                                            size_t                           Size,
+                                                            const Diligent::TextureLoadInfo& TexLoadInfo,
+                                                            Diligent::Uint64*                pMipLevelSizes,
+                                                            Diligent::Uint32                 MaxMipLevels)
+    {
+        return Diligent::GetTextureLoaderMipLevelSizes(pData, Size, TexLoadInfo, pMipLevelSizes, MaxMipLevels);
+    }
 }
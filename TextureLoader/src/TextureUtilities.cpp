@@ -28,13 +28,17 @@
 #include "TextureUtilities.h"
 
 #include <algorithm>
+#include <atomic>
 #include <vector>
 #include <limits>
+#include <type_traits>
 
 #include "TextureLoader.h"
 #include "RefCntAutoPtr.hpp"
 #include "ColorConversion.h"
 #include "GraphicsAccessories.hpp"
+#include "Intrinsics.hpp"
+#include "TextureUtilitiesSIMD.hpp"
 
 namespace Diligent
 {
@@ -78,6 +82,205 @@ Uint16 ConvertChannel<Uint32, Uint16>(Uint32 Val)
     return static_cast<Uint16>(Val >> 16u);
 }
 
+namespace
+{
+
+std::atomic<bool> g_SIMDEnabled{true};
+
+// Source component offsets for each destination component.
+struct SrcComponentOffsets
+{
+    // Special offsets that indicate that the destination component is set to zero or one
+    static constexpr int Zero = -1;
+    static constexpr int One  = -2;
+
+    explicit SrcComponentOffsets(const CopyPixelsAttribs& Attribs) :
+        Offsets{
+            Get(Attribs.Swizzle.R, 0, Attribs.SrcCompCount),
+            Get(Attribs.Swizzle.G, 1, Attribs.SrcCompCount),
+            Get(Attribs.Swizzle.B, 2, Attribs.SrcCompCount),
+            Get(Attribs.Swizzle.A, 3, Attribs.SrcCompCount),
+        }
+    {}
+
+    int operator[](size_t c) const
+    {
+        VERIFY_EXPR(c < 4);
+        return Offsets[c];
+    }
+
+private:
+    static int Get(TEXTURE_COMPONENT_SWIZZLE Swizzle, int IdentityOffset, Uint32 SrcCompCount)
+    {
+        int SrcCompOffset = Zero;
+        switch (Swizzle)
+        {
+            // clang-format off
+            case TEXTURE_COMPONENT_SWIZZLE_IDENTITY: SrcCompOffset = IdentityOffset; break;
+            case TEXTURE_COMPONENT_SWIZZLE_ZERO:     SrcCompOffset = Zero;           break;
+            case TEXTURE_COMPONENT_SWIZZLE_ONE:      SrcCompOffset = One;            break;
+            case TEXTURE_COMPONENT_SWIZZLE_R:        SrcCompOffset = 0;              break;
+            case TEXTURE_COMPONENT_SWIZZLE_G:        SrcCompOffset = 1;              break;
+            case TEXTURE_COMPONENT_SWIZZLE_B:        SrcCompOffset = 2;              break;
+            case TEXTURE_COMPONENT_SWIZZLE_A:        SrcCompOffset = 3;              break;
+            // clang-format on
+            default:
+                UNEXPECTED("Unexpected swizzle value");
+        }
+        if (SrcCompOffset >= static_cast<int>(SrcCompCount))
+            SrcCompOffset = Zero;
+        return SrcCompOffset;
+    }
+
+    const int Offsets[4];
+};
+
+#if DILIGENT_SSSE3_ENABLED || DILIGENT_NEON_A64_SUPPORTED
+// Byte shuffle that converts a block of pixels that fits into a 16-byte register.
+//
+// Every destination byte is either a source byte (ConvertChannel() only shifts
+// the value, so on little-endian platforms it selects the most significant
+// bytes of the source component) or a constant zero or 0xFF.
+struct PixelByteShuffle
+{
+    static constexpr Uint8 ZeroIdx = 0x80;
+
+    Uint32 SrcPixelSize = 0;
+    Uint32 DstPixelSize = 0;
+    Uint32 NumPixels    = 0; // The number of pixels in one block
+
+    // Source byte index for every destination byte, or ZeroIdx
+    alignas(16) Uint8 Indices[16] = {};
+    // 0xFF for the bytes of the components that are set to one
+    alignas(16) Uint8 OrMask[16] = {};
+
+    // Returns false if less than two pixels fit into the block
+    bool Init(const CopyPixelsAttribs& Attribs)
+    {
+        SrcPixelSize = Attribs.SrcComponentSize * Attribs.SrcCompCount;
+        DstPixelSize = Attribs.DstComponentSize * Attribs.DstCompCount;
+        if (Attribs.SrcCompCount > 4 || Attribs.DstCompCount > 4 || SrcPixelSize > 8 || DstPixelSize > 8)
+            return false;
+
+        NumPixels = 16 / std::max(SrcPixelSize, DstPixelSize);
+
+        const SrcComponentOffsets SrcCompOffsets{Attribs};
+
+        const int SrcCompSize = static_cast<int>(Attribs.SrcComponentSize);
+        const int DstCompSize = static_cast<int>(Attribs.DstComponentSize);
+        memset(Indices, ZeroIdx, sizeof(Indices));
+        for (Uint32 p = 0; p < NumPixels; ++p)
+        {
+            for (Uint32 c = 0; c < Attribs.DstCompCount; ++c)
+            {
+                const int SrcCompOffset = SrcCompOffsets[c];
+                for (int b = 0; b < DstCompSize; ++b)
+                {
+                    const size_t DstIdx = p * DstPixelSize + c * DstCompSize + b;
+                    if (SrcCompOffset >= 0)
+                    {
+                        // Source byte that ends up in destination byte b after the shift
+                        const int SrcByte = b + SrcCompSize - DstCompSize;
+                        if (SrcByte >= 0)
+                            Indices[DstIdx] = static_cast<Uint8>(p * SrcPixelSize + SrcCompOffset * SrcCompSize + SrcByte);
+                    }
+                    else if (SrcCompOffset == SrcComponentOffsets::One)
+                    {
+                        OrMask[DstIdx] = 0xFF;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // Converts a single pixel using the shuffle table
+    void ConvertPixel(const Uint8* pSrc, Uint8* pDst) const
+    {
+        for (Uint32 b = 0; b < DstPixelSize; ++b)
+            pDst[b] = (Indices[b] != ZeroIdx ? pSrc[Indices[b]] : Uint8{0}) | OrMask[b];
+    }
+};
+#endif
+
+// Converts pixels using SIMD byte shuffles (SSSE3 pshufb, AVX2 vpshufb or NEON tbl).
+// Returns false if the conversion is not supported by the SIMD path.
+bool CopyPixelsWithByteShuffle(const CopyPixelsAttribs& Attribs)
+{
+#if DILIGENT_SSSE3_ENABLED || DILIGENT_NEON_A64_SUPPORTED
+    if (!g_SIMDEnabled.load(std::memory_order_relaxed))
+        return false;
+
+    PixelByteShuffle Shuffle;
+    if (!Shuffle.Init(Attribs))
+        return false;
+
+    const size_t SrcBlockSize = size_t{Shuffle.NumPixels} * Shuffle.SrcPixelSize;
+    const size_t DstBlockSize = size_t{Shuffle.NumPixels} * Shuffle.DstPixelSize;
+    const size_t SrcRowSize   = size_t{Attribs.Width} * Shuffle.SrcPixelSize;
+    const size_t DstRowSize   = size_t{Attribs.Width} * Shuffle.DstPixelSize;
+
+#    if DILIGENT_SSSE3_ENABLED
+    const __m128i mmIndices = _mm_load_si128(reinterpret_cast<const __m128i*>(Shuffle.Indices));
+    const __m128i mmOrMask  = _mm_load_si128(reinterpret_cast<const __m128i*>(Shuffle.OrMask));
+#        if DILIGENT_AVX2_ENABLED
+    // When both blocks are 16 bytes (e.g. RGBA8 swizzles), two blocks are processed at once
+    const bool    UseAVX2    = SrcBlockSize == 16 && DstBlockSize == 16;
+    const __m256i mmIndices2 = _mm256_broadcastsi128_si256(mmIndices);
+    const __m256i mmOrMask2  = _mm256_broadcastsi128_si256(mmOrMask);
+#        endif
+#    else
+    const uint8x16_t vIndices = vld1q_u8(Shuffle.Indices);
+    const uint8x16_t vOrMask  = vld1q_u8(Shuffle.OrMask);
+#    endif
+
+    for (size_t row = 0; row < size_t{Attribs.Height}; ++row)
+    {
+        const size_t src_row = Attribs.FlipVertically ? size_t{Attribs.Height} - row - 1 : row;
+        const Uint8* pSrcRow = static_cast<const Uint8*>(Attribs.pSrcPixels) + size_t{Attribs.SrcStride} * src_row;
+        Uint8*       pDstRow = static_cast<Uint8*>(Attribs.pDstPixels) + size_t{Attribs.DstStride} * row;
+
+        // Every iteration reads and writes 16 bytes, but only advances by the block size,
+        // so stop when there are less than 16 bytes left in the source or destination row.
+        size_t SrcOffset = 0;
+        size_t DstOffset = 0;
+#    if DILIGENT_AVX2_ENABLED
+        if (UseAVX2)
+        {
+            for (; SrcOffset + 32 <= SrcRowSize && DstOffset + 32 <= DstRowSize; SrcOffset += 32, DstOffset += 32)
+            {
+                __m256i mmPixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrcRow + SrcOffset));
+                mmPixels         = _mm256_or_si256(_mm256_shuffle_epi8(mmPixels, mmIndices2), mmOrMask2);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(pDstRow + DstOffset), mmPixels);
+            }
+        }
+#    endif
+        for (; SrcOffset + 16 <= SrcRowSize && DstOffset + 16 <= DstRowSize; SrcOffset += SrcBlockSize, DstOffset += DstBlockSize)
+        {
+#    if DILIGENT_SSSE3_ENABLED
+            __m128i mmPixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrcRow + SrcOffset));
+            mmPixels         = _mm_or_si128(_mm_shuffle_epi8(mmPixels, mmIndices), mmOrMask);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDstRow + DstOffset), mmPixels);
+#    else
+            const uint8x16_t vPixels = vld1q_u8(pSrcRow + SrcOffset);
+            vst1q_u8(pDstRow + DstOffset, vorrq_u8(vqtbl1q_u8(vPixels, vIndices), vOrMask));
+#    endif
+        }
+
+        for (; SrcOffset < SrcRowSize; SrcOffset += Shuffle.SrcPixelSize, DstOffset += Shuffle.DstPixelSize)
+            Shuffle.ConvertPixel(pSrcRow + SrcOffset, pDstRow + DstOffset);
+    }
+
+    return true;
+#else
+    (void)Attribs;
+    return false;
+#endif
+}
+
+} // namespace
+
 template <typename SrcChannelType, typename DstChannelType>
 void CopyPixelsImpl(const CopyPixelsAttribs& Attribs)
 {
@@ -104,7 +307,7 @@ void CopyPixelsImpl(const CopyPixelsAttribs& Attribs)
 
     const Uint32 SrcRowSize = Attribs.Width * Attribs.SrcComponentSize * Attribs.SrcCompCount;
     const Uint32 DstRowSize = Attribs.Width * Attribs.DstComponentSize * Attribs.DstCompCount;
-    if (SrcRowSize == DstRowSize && !SwizzleRequired)
+    if (Attribs.SrcComponentSize == Attribs.DstComponentSize && SrcRowSize == DstRowSize && !SwizzleRequired)
     {
         if (SrcRowSize == Attribs.SrcStride &&
             DstRowSize == Attribs.DstStride &&
@@ -119,6 +322,10 @@ void CopyPixelsImpl(const CopyPixelsAttribs& Attribs)
             });
         }
     }
+    else if (CopyPixelsWithByteShuffle(Attribs))
+    {
+        // Pixels have been converted by the SIMD kernel
+    }
     else if (Attribs.DstCompCount < Attribs.SrcCompCount && !SwizzleRequired)
     {
         ProcessRows([&Attribs](auto* pSrcRow, auto* pDstRow) {
@@ -133,35 +340,7 @@ void CopyPixelsImpl(const CopyPixelsAttribs& Attribs)
     }
     else
     {
-        static constexpr int SrcCompOffset_ZERO = -1;
-        static constexpr int SrcCompOffset_ONE  = -2;
-
-        auto GetSrcCompOffset = [&Attribs](TEXTURE_COMPONENT_SWIZZLE Swizzle, int IdentityOffset) {
-            int SrcCompOffset = SrcCompOffset_ZERO;
-            switch (Swizzle)
-            {
-                // clang-format off
-                case TEXTURE_COMPONENT_SWIZZLE_IDENTITY: SrcCompOffset = IdentityOffset;     break;
-                case TEXTURE_COMPONENT_SWIZZLE_ZERO:     SrcCompOffset = SrcCompOffset_ZERO; break;
-                case TEXTURE_COMPONENT_SWIZZLE_ONE:      SrcCompOffset = SrcCompOffset_ONE;  break;
-                case TEXTURE_COMPONENT_SWIZZLE_R:        SrcCompOffset = 0;                  break;
-                case TEXTURE_COMPONENT_SWIZZLE_G:        SrcCompOffset = 1;                  break;
-                case TEXTURE_COMPONENT_SWIZZLE_B:        SrcCompOffset = 2;                  break;
-                case TEXTURE_COMPONENT_SWIZZLE_A:        SrcCompOffset = 3;                  break;
-                // clang-format on
-                default:
-                    UNEXPECTED("Unexpected swizzle value");
-            }
-            if (SrcCompOffset >= static_cast<int>(Attribs.SrcCompCount))
-                SrcCompOffset = SrcCompOffset_ZERO;
-            return SrcCompOffset;
-        };
-
-        const int SrcCompOffsets[4] = {
-            GetSrcCompOffset(Attribs.Swizzle.R, 0),
-            GetSrcCompOffset(Attribs.Swizzle.G, 1),
-            GetSrcCompOffset(Attribs.Swizzle.B, 2),
-            GetSrcCompOffset(Attribs.Swizzle.A, 3)};
+        const SrcComponentOffsets SrcCompOffsets{Attribs};
 
         ProcessRows([&Attribs, &SrcCompOffsets](auto* pSrcRow, auto* pDstRow) {
             for (size_t col = 0; col < size_t{Attribs.Width}; ++col)
@@ -175,7 +354,7 @@ void CopyPixelsImpl(const CopyPixelsAttribs& Attribs)
 
                     pDst[c] = (SrcCompOffset >= 0) ?
                         ConvertChannel<SrcChannelType, DstChannelType>(pSrc[SrcCompOffset]) :
-                        (SrcCompOffset == SrcCompOffset_ZERO ? 0 : std::numeric_limits<DstChannelType>::max());
+                        (SrcCompOffset == SrcComponentOffsets::Zero ? 0 : std::numeric_limits<DstChannelType>::max());
                 }
             }
         });
@@ -244,11 +423,19 @@ void ExpandPixels(const ExpandPixelsAttribs& Attribs)
         const Uint8* pSrcRow = reinterpret_cast<const Uint8*>(Attribs.pSrcPixels) + row * size_t{Attribs.SrcStride};
         memcpy(pDstRow, pSrcRow, size_t{NumColsToCopy} * size_t{Attribs.ComponentSize} * size_t{Attribs.ComponentCount});
 
-        // Expand the row by repeating the last pixel
-        const Uint8* pLastPixel = pSrcRow + size_t{NumColsToCopy - 1u} * size_t{Attribs.ComponentSize} * size_t{Attribs.ComponentCount};
-        for (size_t col = NumColsToCopy; col < Attribs.DstWidth; ++col)
+        // Expand the row by repeating the last pixel.
+        // Copy blocks of doubling size to avoid a memcpy call per pixel.
+        const size_t PixelSize     = size_t{Attribs.ComponentSize} * size_t{Attribs.ComponentCount};
+        const size_t DstRowSize    = size_t{Attribs.DstWidth} * PixelSize;
+        Uint8* const pLastPixel    = pDstRow + size_t{NumColsToCopy - 1u} * PixelSize;
+        size_t       ExpandedSize  = PixelSize;
+        size_t       CurrRowOffset = size_t{NumColsToCopy} * PixelSize;
+        while (CurrRowOffset < DstRowSize)
         {
-            memcpy(pDstRow + col * Attribs.ComponentSize * Attribs.ComponentCount, pLastPixel, size_t{Attribs.ComponentSize} * size_t{Attribs.ComponentCount});
+            const size_t CopySize = std::min(ExpandedSize, DstRowSize - CurrRowOffset);
+            memcpy(pDstRow + CurrRowOffset, pLastPixel, CopySize);
+            CurrRowOffset += CopySize;
+            ExpandedSize += CopySize;
         }
     };
 
@@ -309,13 +496,80 @@ struct PremultiplyAlphaImplHelper<Int32>
     using IntermediateType = Int64;
 };
 
+namespace
+{
+
+// Premultiplies RGBA8 pixels with SIMD instructions and returns the number of processed pixels in the row.
+// The result is computed as round(C * A / 255) using the exact integer identity
+//     (x + 127) / 255 == (x + 128 + ((x + 128) >> 8)) >> 8,  x in [0, 255 * 255]
+// and matches the scalar path.
+size_t PremultiplyAlphaRGBA8SIMD(void* pRowData, size_t Width)
+{
+    Uint8* const pRow = static_cast<Uint8*>(pRowData);
+
+    size_t col = 0;
+#if DILIGENT_SSE2_SUPPORTED
+    const __m128i mmAlphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    const __m128i mmZero      = _mm_setzero_si128();
+    const __m128i mm128       = _mm_set1_epi16(128);
+
+    auto Premultiply = [&](__m128i mmPixels) {
+        // Broadcast alpha of each pixel to all its components
+        __m128i mmAlpha = _mm_shufflelo_epi16(mmPixels, _MM_SHUFFLE(3, 3, 3, 3));
+        mmAlpha         = _mm_shufflehi_epi16(mmAlpha, _MM_SHUFFLE(3, 3, 3, 3));
+
+        __m128i x = _mm_add_epi16(_mm_mullo_epi16(mmPixels, mmAlpha), mm128);
+        return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    };
+
+    for (; col + 4 <= Width; col += 4)
+    {
+        Uint8* const  pPixels  = pRow + col * 4;
+        const __m128i mmPixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pPixels));
+
+        const __m128i mmLo = Premultiply(_mm_unpacklo_epi8(mmPixels, mmZero));
+        const __m128i mmHi = Premultiply(_mm_unpackhi_epi8(mmPixels, mmZero));
+
+        // Keep the original alpha
+        __m128i mmResult = _mm_packus_epi16(mmLo, mmHi);
+        mmResult         = _mm_or_si128(_mm_andnot_si128(mmAlphaMask, mmResult), _mm_and_si128(mmAlphaMask, mmPixels));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pPixels), mmResult);
+    }
+#elif DILIGENT_NEON_SUPPORTED
+    for (; col + 8 <= Width; col += 8)
+    {
+        Uint8* const pPixels = pRow + col * 4;
+        uint8x8x4_t  Pixels  = vld4_u8(pPixels);
+        for (size_t c = 0; c < 3; ++c)
+        {
+            // (x + ((x + 128) >> 8) + 128) >> 8
+            const uint16x8_t x = vmull_u8(Pixels.val[c], Pixels.val[3]);
+            Pixels.val[c]      = vrshrn_n_u16(vrsraq_n_u16(x, x, 8), 8);
+        }
+        vst4_u8(pPixels, Pixels);
+    }
+#else
+    (void)pRow;
+    (void)Width;
+#endif
+    return col;
+}
+
+} // namespace
+
+// Optional function that premultiplies the leading pixels of a row with SIMD instructions.
+// Returns the number of processed pixels.
+using PremultiplyRowSIMDType = size_t (*)(void* pRow, size_t Width);
+
 template <typename Type, typename PremultiplyComponentType>
-void PremultiplyComponents(const PremultiplyAlphaAttribs& Attribs, PremultiplyComponentType&& PremultiplyComponent)
+void PremultiplyComponents(const PremultiplyAlphaAttribs& Attribs, PremultiplyComponentType&& PremultiplyComponent, PremultiplyRowSIMDType PremultiplyRowSIMD = nullptr)
 {
     for (Uint32 row = 0; row < Attribs.Height; ++row)
     {
         Type* pRow = reinterpret_cast<Type*>(reinterpret_cast<Uint8*>(Attribs.pPixels) + row * Attribs.Stride);
-        for (Uint32 col = 0; col < Attribs.Width; ++col)
+
+        const size_t FirstCol = PremultiplyRowSIMD != nullptr ? PremultiplyRowSIMD(pRow, Attribs.Width) : 0;
+        for (size_t col = FirstCol; col < Attribs.Width; ++col)
         {
             Type* pPixel = pRow + col * Attribs.ComponentCount;
             Type  A      = pPixel[Attribs.ComponentCount - 1];
@@ -352,7 +606,8 @@ void PremultiplyAlphaImpl(const PremultiplyAlphaAttribs& Attribs)
                 constexpr IntermediateType MaxValue = static_cast<IntermediateType>(std::numeric_limits<Type>::max());
 
                 C = static_cast<Type>((static_cast<IntermediateType>(C) * A + MaxValue / 2) / MaxValue);
-            });
+            },
+            std::is_same<Type, Uint8>::value && Attribs.ComponentCount == 4 && g_SIMDEnabled.load(std::memory_order_relaxed) ? PremultiplyAlphaRGBA8SIMD : nullptr);
     }
 }
 
@@ -408,6 +663,16 @@ void PremultiplyAlpha(const PremultiplyAlphaAttribs& Attribs)
     }
 }
 
+void SetTextureUtilitiesSIMDEnabled(bool Enabled)
+{
+    g_SIMDEnabled.store(Enabled, std::memory_order_relaxed);
+}
+
+bool IsTextureUtilitiesSIMDEnabled()
+{
+    return g_SIMDEnabled.load(std::memory_order_relaxed);
+}
+
 void CreateTextureFromFile(const Char*            FilePath,
                            const TextureLoadInfo& TexLoadInfo,
                            IRenderDevice*         pDevice,